@@ -27,6 +27,7 @@ struct Settings {
     std::string graphVizPrefix;                         // prefix for GraphViz file names
     PathSelection graphVizOutput;                       // which paths to dump to GraphViz files
     size_t maxPaths;                                    // max number of paths to find (0==unlimited)
+    size_t maxPrefixStates;                             // max number of path prefix states saved by single-dfs search
     SearchMode searchMode;                              // path finding mode
     size_t maxExprDepth;                                // max depth when printing expressions
     bool showExprWidth;                                 // show expression widths in bits?
@@ -37,7 +38,8 @@ struct Settings {
     Settings()
         : beginVertex("_start"), maxRecursionDepth(4), maxCallDepth(100), maxPathLength(1600), vertexVisitLimit(1),
           showInstructions(true), showConstraints(false), showFinalState(false), showFunctionSubgraphs(true),
-          graphVizPrefix("path-"), graphVizOutput(NO_PATHS), maxPaths(1), searchMode(SEARCH_SINGLE_BFS), maxExprDepth(4),
+          graphVizPrefix("path-"), graphVizOutput(NO_PATHS), maxPaths(1), maxPrefixStates(256),
+          searchMode(SEARCH_SINGLE_BFS), maxExprDepth(4),
           showExprWidth(false), debugSmtSolver(false), nThreads(1) {}
 };
 
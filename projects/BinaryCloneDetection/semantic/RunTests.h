@@ -20,7 +20,7 @@ struct Switches {
     Switches()
         : verbosity(SILENT), progress(false), pointers(false), interactive(false), trace_events(0), dry_run(false),
           save_coverage(false), save_callgraph(false), save_consumed_inputs(false), nprocs(1),
-          path_syntactic(PATH_SYNTACTIC_NONE) {
+          fork_server(false), batch_size(25), path_syntactic(PATH_SYNTACTIC_NONE) {
         checkpoint = 300 + LinearCongruentialGenerator()()%600;
     }
     Verbosity verbosity;                        // semantic policy has a separate verbosity
@@ -36,6 +36,8 @@ struct Switches {
     bool save_consumed_inputs;
     PolicyParams params;                                // parameters controlling instruction semantics
     size_t nprocs;                                      // number of parallel processes to fork
+    bool fork_server;                                   // fork testing processes once per specimen instead of per batch
+    size_t batch_size;                                  // number of tests handed to a testing process at a time
     std::vector<std::string> signature_components;      /**< How should the signature vectors be computed */
     PathSyntactic path_syntactic;                       /**< How to compute path sensistive syntactic signature */
 };
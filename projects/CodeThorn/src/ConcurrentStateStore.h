@@ -0,0 +1,436 @@
+#ifndef CONCURRENT_STATE_STORE_H
+#define CONCURRENT_STATE_STORE_H
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <stdint.h>
+
+/*!
+  * \brief Concurrent store of pointers to states, with dense ids.
+  *
+  * An open-addressing hash set of KeyType* that threads may search and insert
+  * into concurrently without locks. Each key gets the next id when it is
+  * inserted; ids are dense and never change, so the id of a key and the key
+  * of an id are both found in constant time, and iteration visits the keys in
+  * the order of their ids.
+  *
+  * The set is split into shards by hash value, each with its own table, so
+  * that threads mostly work on different cache lines and a table that has to
+  * grow only holds up the threads inserting into that shard. A slot is
+  * claimed with a compare-and-swap; a growing table is migrated by all the
+  * threads that run into it, which may have to wait for a concurrent
+  * insertion to publish the id of its key. Tables that have been migrated are
+  * kept until the store is cleared or destroyed, because other threads may
+  * still be reading them.
+  *
+  * Erasing, clearing, copying and assigning must not run concurrently with
+  * any other operation. Erased keys keep their ids; their ids are skipped by
+  * iteration and not reused.
+  *
+  * HashFun and EqualToPred take KeyType* arguments, like the ones for a
+  * set of pointers. The keys themselves are not owned by the store.
+ */
+template<typename KeyType,typename HashFun, typename EqualToPred>
+class ConcurrentStateStore {
+ private:
+  struct Table {
+    size_t capacity;                    // power of two
+    KeyType* volatile* slots;
+    volatile size_t* ids;               // id of the key in each slot, or NO_ID until published
+    volatile size_t used;               // claimed slots, including erased ones
+    Table* volatile next;               // table this one is migrated to
+    volatile size_t claimed;            // slots handed out for migration
+    volatile size_t migrated;           // slots done migrating
+    Table* retired;                     // older table of the same shard
+
+    Table(size_t capacity): capacity(capacity), used(0), next(0), claimed(0), migrated(0), retired(0) {
+      slots=new KeyType* volatile[capacity];
+      ids=new volatile size_t[capacity];
+      for(size_t i=0;i<capacity;++i) {
+        slots[i]=0;
+        ids[i]=NO_ID;
+      }
+    }
+    ~Table() {
+      delete[] slots;
+      delete[] ids;
+    }
+  };
+
+  // a shard gets its own cache line
+  struct Shard {
+    Table* volatile current;
+    char padding[64-sizeof(Table*)];
+  };
+
+ public:
+  static const size_t NO_ID=(size_t)(-1);
+
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef KeyType* value_type;
+    typedef ptrdiff_t difference_type;
+    typedef KeyType* const* pointer;
+    typedef KeyType* reference;
+    const_iterator():_store(0),_id(0) {}
+    reference operator*() const { return _store->entry(_id); }
+    const_iterator& operator++() { _id=_store->nextId(_id+1); return *this; }
+    const_iterator operator++(int) { const_iterator old=*this; ++*this; return old; }
+    bool operator==(const const_iterator& other) const { return _id==other._id; }
+    bool operator!=(const const_iterator& other) const { return _id!=other._id; }
+    //! id of the key the iterator refers to
+    size_t id() const { return _id; }
+  private:
+    friend class ConcurrentStateStore;
+    const_iterator(const ConcurrentStateStore* store, size_t id):_store(store),_id(id) {}
+    const ConcurrentStateStore* _store;
+    size_t _id;
+  };
+  // keys cannot be changed in place through a set iterator either
+  typedef const_iterator iterator;
+
+  ConcurrentStateStore() { init(); }
+  ConcurrentStateStore(const ConcurrentStateStore& other) {
+    init();
+    insertAll(other);
+  }
+  ConcurrentStateStore& operator=(const ConcurrentStateStore& other) {
+    if(this!=&other) {
+      clear();
+      _maxLoadFactor=other._maxLoadFactor;
+      insertAll(other);
+    }
+    return *this;
+  }
+  ~ConcurrentStateStore() {
+    freeTables();
+    for(size_t c=0;c<NUM_CHUNKS;++c)
+      delete[] _chunks[c];
+  }
+
+  //! finds the key equal to *key, inserting key if there is none. Returns true if key was inserted.
+  std::pair<iterator,bool> insert(KeyType* key) {
+    std::pair<size_t,bool> res=insertOrFind(key,NO_ID);
+    return std::make_pair(iterator(this,res.first),res.second);
+  }
+
+  iterator find(KeyType* key) const {
+    size_t id=findId(key);
+    return id==NO_ID?end():iterator(this,id);
+  }
+
+  //! id of the key equal to *key, or NO_ID if there is none
+  size_t findId(KeyType* key) const {
+    size_t h=mix(_hashFun(key));
+    Shard& shard=const_cast<Shard&>(_shards[h&(NUM_SHARDS-1)]);
+    Table* t=shard.current;
+    for(;;) {
+      size_t mask=t->capacity-1;
+      size_t i=(h>>SHARD_BITS)&mask;
+      size_t probes=0;
+      for(;probes<t->capacity;++probes,i=(i+1)&mask) {
+        KeyType* s=t->slots[i];
+        if(s==EMPTY)
+          return NO_ID;
+        if(s==MOVED)
+          break;
+        if(s!=ERASED && (s==key || _equalTo(s,key)))
+          return publishedId(t,i);
+      }
+      if(probes==t->capacity)
+        return NO_ID;
+      // the key may not have been migrated yet, so help finishing the migration before looking in the new table
+      t=const_cast<ConcurrentStateStore*>(this)->migrate(shard,t);
+    }
+  }
+
+  //! the key with the given id, or 0 if it has been erased or its insertion is not finished yet
+  KeyType* keyOf(size_t id) const {
+    return id<_nextId?entry(id):0;
+  }
+
+  size_t erase(KeyType* key) {
+    size_t h=mix(_hashFun(key));
+    Table* t=_shards[h&(NUM_SHARDS-1)].current;
+    size_t mask=t->capacity-1;
+    size_t i=(h>>SHARD_BITS)&mask;
+    for(size_t probes=0;probes<t->capacity;++probes,i=(i+1)&mask) {
+      KeyType* s=t->slots[i];
+      if(s==EMPTY)
+        return 0;
+      if(s!=ERASED && _equalTo(s,key)) {
+        t->slots[i]=ERASED;
+        entry(t->ids[i])=0;
+        --_size;
+        return 1;
+      }
+    }
+    return 0;
+  }
+  void erase(iterator pos) {
+    erase(*pos);
+  }
+
+  void clear() {
+    freeTables();
+    for(size_t c=0;c<NUM_CHUNKS;++c) {
+      delete[] _chunks[c];
+      _chunks[c]=0;
+    }
+    initTables();
+  }
+
+  iterator begin() const { return iterator(this,nextId(0)); }
+  iterator end() const { return iterator(this,endId()); }
+
+  //! number of keys, which is exact when no insertion is running
+  size_t size() const { return _size; }
+  bool empty() const { return size()==0; }
+
+  float max_load_factor() const { return _maxLoadFactor; }
+  void max_load_factor(float f) { _maxLoadFactor=(f>0.1f && f<0.95f)?f:DEFAULT_MAX_LOAD_FACTOR; }
+  float load_factor() const {
+    size_t capacity=0;
+    for(size_t s=0;s<NUM_SHARDS;++s)
+      capacity+=_shards[s].current->capacity;
+    return (float)size()/capacity;
+  }
+  //! longest probe sequence any insertion needed
+  size_t max_probes() const { return _maxProbes; }
+
+ private:
+  enum { SHARD_BITS=6, NUM_SHARDS=1<<SHARD_BITS, INITIAL_CAPACITY=64, MIGRATION_CHUNK=256,
+         CHUNK_BITS=10, NUM_CHUNKS=48 };
+  static const float DEFAULT_MAX_LOAD_FACTOR;
+  static KeyType* const EMPTY;
+  static KeyType* const MOVED;
+  static KeyType* const ERASED;
+
+  Shard _shards[NUM_SHARDS];
+  // key of each id; chunk c holds ids 2^(c+CHUNK_BITS)-2^CHUNK_BITS to 2^(c+1+CHUNK_BITS)-2^CHUNK_BITS-1
+  mutable KeyType* volatile* volatile _chunks[NUM_CHUNKS];
+  volatile size_t _nextId;
+  volatile size_t _size;
+  volatile size_t _maxProbes;
+  float _maxLoadFactor;
+  HashFun _hashFun;
+  EqualToPred _equalTo;
+
+  void init() {
+    for(size_t c=0;c<NUM_CHUNKS;++c)
+      _chunks[c]=0;
+    _maxLoadFactor=DEFAULT_MAX_LOAD_FACTOR;
+    initTables();
+  }
+  void initTables() {
+    for(size_t s=0;s<NUM_SHARDS;++s)
+      _shards[s].current=new Table(INITIAL_CAPACITY);
+    _nextId=0;
+    _size=0;
+    _maxProbes=0;
+  }
+  void freeTables() {
+    for(size_t s=0;s<NUM_SHARDS;++s) {
+      Table* t=_shards[s].current;
+      while(t) {
+        Table* older=t->retired;
+        delete t;
+        t=older;
+      }
+    }
+  }
+  void insertAll(const ConcurrentStateStore& other) {
+    for(const_iterator i=other.begin();i!=other.end();++i)
+      insert(*i);
+  }
+
+  // spreads the bits of a hash value, since the shard and the first slot are taken from its low bits
+  static size_t mix(long hash) {
+    uint64_t h=(uint64_t)hash;
+    h^=h>>33;
+    h*=0xff51afd7ed558ccdULL;
+    h^=h>>33;
+    h*=0xc4ceb9fe1a85ec53ULL;
+    h^=h>>33;
+    return (size_t)h;
+  }
+
+  static size_t chunkOf(size_t id, size_t& offset) {
+    size_t n=(id>>CHUNK_BITS)+1;
+    size_t c=0;
+    while(n>>=1)
+      ++c;
+    offset=id+((size_t)1<<CHUNK_BITS)-((size_t)1<<(c+CHUNK_BITS));
+    return c;
+  }
+  KeyType* volatile& entry(size_t id) const {
+    size_t offset;
+    size_t c=chunkOf(id,offset);
+    if(!_chunks[c]) {
+      size_t n=(size_t)1<<(c+CHUNK_BITS);
+      KeyType* volatile* chunk=new KeyType* volatile[n];
+      for(size_t i=0;i<n;++i)
+        chunk[i]=0;
+      if(!__sync_bool_compare_and_swap(&_chunks[c],(KeyType* volatile*)0,chunk))
+        delete[] chunk;
+    }
+    return _chunks[c][offset];
+  }
+  // the first id from id on whose key is present
+  size_t nextId(size_t id) const {
+    size_t end=endId();
+    while(id<end && !entry(id))
+      ++id;
+    return id;
+  }
+  size_t endId() const { return _nextId; }
+
+  size_t publishedId(Table* t, size_t i) const {
+    size_t id;
+    while((id=t->ids[i])==NO_ID)
+      ;                                 // the inserting thread is between claiming the slot and publishing its id
+    return id;
+  }
+
+  // Finds the key equal to *key in the shard, or inserts key with the given id, or the next id if that is NO_ID.
+  // Returns the id of the key found or inserted and whether it was inserted.
+  std::pair<size_t,bool> insertOrFind(KeyType* key, size_t id) {
+    size_t h=mix(_hashFun(key));
+    Shard& shard=_shards[h&(NUM_SHARDS-1)];
+    Table* t=shard.current;
+    for(;;) {
+      size_t mask=t->capacity-1;
+      size_t i=(h>>SHARD_BITS)&mask;
+      size_t probes=0;
+      bool grow=false;
+      while(probes<t->capacity) {
+        KeyType* s=t->slots[i];
+        if(s==EMPTY) {
+          if(t->used>=t->capacity*_maxLoadFactor) {
+            grow=true;
+            break;
+          }
+          if(!__sync_bool_compare_and_swap(&t->slots[i],EMPTY,key))
+            continue;                   // somebody else claimed the slot, look at it again
+          __sync_add_and_fetch(&t->used,1);
+          if(id==NO_ID) {
+            id=__sync_fetch_and_add(&_nextId,1);
+            entry(id)=key;
+            __sync_add_and_fetch(&_size,1);
+          }
+          t->ids[i]=id;
+          __sync_synchronize();
+          noteProbes(probes);
+          return std::make_pair(id,true);
+        }
+        if(s==MOVED) {
+          grow=true;
+          break;
+        }
+        if(s!=ERASED && (s==key || _equalTo(s,key)))
+          return std::make_pair(publishedId(t,i),false);
+        ++probes;
+        i=(i+1)&mask;
+      }
+      if(!grow && probes>=t->capacity)
+        grow=true;
+      t=migrate(shard,t);
+    }
+  }
+
+  void noteProbes(size_t probes) {
+    size_t max;
+    while(probes>(max=_maxProbes) && !__sync_bool_compare_and_swap(&_maxProbes,max,probes))
+      ;
+  }
+
+  // Moves the keys of a full table to a table twice its size, together with
+  // all the other threads that find it full. Returns the new table.
+  Table* migrate(Shard& shard, Table* t) {
+    if(!t->next) {
+      Table* bigger=new Table(t->capacity*2);
+      if(!__sync_bool_compare_and_swap(&t->next,(Table*)0,bigger))
+        delete bigger;
+    }
+    Table* next=t->next;
+    for(;;) {
+      size_t begin=__sync_fetch_and_add(&t->claimed,(size_t)MIGRATION_CHUNK);
+      if(begin>=t->capacity)
+        break;
+      size_t end=begin+MIGRATION_CHUNK<t->capacity?begin+MIGRATION_CHUNK:t->capacity;
+      for(size_t i=begin;i<end;++i)
+        migrateSlot(t,next,i);
+      __sync_add_and_fetch(&t->migrated,end-begin);
+    }
+    if(t->migrated<t->capacity) {
+      // some chunks are still being migrated by other threads; migrating a slot twice does no harm
+      for(size_t i=0;i<t->capacity;++i)
+        migrateSlot(t,next,i);
+    }
+    next->retired=t;
+    __sync_bool_compare_and_swap(&shard.current,t,next);
+    return next;
+  }
+
+  void migrateSlot(Table* t, Table* next, size_t i) {
+    for(;;) {
+      KeyType* s=t->slots[i];
+      if(s==MOVED)
+        return;
+      if(s==EMPTY) {
+        if(__sync_bool_compare_and_swap(&t->slots[i],EMPTY,MOVED))
+          return;
+        continue;
+      }
+      if(s!=ERASED)
+        insertOrFindIn(next,s,publishedId(t,i));
+      t->slots[i]=MOVED;
+      __sync_synchronize();
+      return;
+    }
+  }
+
+  // inserts a key that is being migrated into the table it is migrated to, or a newer one
+  void insertOrFindIn(Table* t, KeyType* key, size_t id) {
+    size_t h=mix(_hashFun(key));
+    Shard& shard=_shards[h&(NUM_SHARDS-1)];
+    for(;;) {
+      size_t mask=t->capacity-1;
+      size_t i=(h>>SHARD_BITS)&mask;
+      size_t probes=0;
+      while(probes<t->capacity) {
+        KeyType* s=t->slots[i];
+        if(s==EMPTY) {
+          if(!__sync_bool_compare_and_swap(&t->slots[i],EMPTY,key))
+            continue;
+          __sync_add_and_fetch(&t->used,1);
+          t->ids[i]=id;
+          __sync_synchronize();
+          return;
+        }
+        if(s==MOVED)
+          break;
+        if(s==key)
+          return;                       // migrated by another thread already
+        ++probes;
+        i=(i+1)&mask;
+      }
+      t=migrate(shard,t);
+    }
+  }
+};
+
+template<typename KeyType,typename HashFun, typename EqualToPred>
+const float ConcurrentStateStore<KeyType,HashFun,EqualToPred>::DEFAULT_MAX_LOAD_FACTOR=0.7f;
+template<typename KeyType,typename HashFun, typename EqualToPred>
+const size_t ConcurrentStateStore<KeyType,HashFun,EqualToPred>::NO_ID;
+template<typename KeyType,typename HashFun, typename EqualToPred>
+KeyType* const ConcurrentStateStore<KeyType,HashFun,EqualToPred>::EMPTY=0;
+template<typename KeyType,typename HashFun, typename EqualToPred>
+KeyType* const ConcurrentStateStore<KeyType,HashFun,EqualToPred>::MOVED=reinterpret_cast<KeyType*>(1);
+template<typename KeyType,typename HashFun, typename EqualToPred>
+KeyType* const ConcurrentStateStore<KeyType,HashFun,EqualToPred>::ERASED=reinterpret_cast<KeyType*>(2);
+
+#endif
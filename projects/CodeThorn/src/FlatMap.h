@@ -0,0 +1,101 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/*!
+  * \brief Map kept as a sorted array of (key,value) pairs.
+  *
+  * Provides the part of the std::map interface used for program states.
+  * The elements are stored contiguously, so a map of n elements takes one
+  * allocation of n pairs instead of n tree nodes, copying it is a single
+  * copy of the array, and comparing two maps walks two arrays. Lookup is a
+  * binary search; inserting or erasing a key moves the elements after it,
+  * which is cheap for the small maps with few insertions this is meant for.
+  *
+  * Unlike std::map, inserting or erasing an element invalidates all the
+  * iterators into the map, and the key of an element can be modified through
+  * an iterator (it must not be).
+ */
+template<typename Key, typename Value, typename Compare=std::less<Key> >
+class FlatMap {
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<Key,Value> value_type;
+  typedef Compare key_compare;
+  typedef typename std::vector<value_type>::iterator iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+  typedef typename std::vector<value_type>::size_type size_type;
+
+  FlatMap() {}
+
+  iterator begin() { return _elements.begin(); }
+  iterator end() { return _elements.end(); }
+  const_iterator begin() const { return _elements.begin(); }
+  const_iterator end() const { return _elements.end(); }
+  size_type size() const { return _elements.size(); }
+  bool empty() const { return _elements.empty(); }
+  void clear() { _elements.clear(); }
+  void swap(FlatMap& other) { _elements.swap(other._elements); }
+  //! number of elements the array can hold without reallocation
+  size_type capacity() const { return _elements.capacity(); }
+  //! releases the array space not occupied by elements
+  void shrinkToFit() {
+    if(_elements.capacity()!=_elements.size())
+      std::vector<value_type>(_elements).swap(_elements);
+  }
+
+  iterator lower_bound(const Key& key) {
+    return std::lower_bound(_elements.begin(),_elements.end(),key,KeyLess());
+  }
+  const_iterator lower_bound(const Key& key) const {
+    return std::lower_bound(_elements.begin(),_elements.end(),key,KeyLess());
+  }
+  iterator find(const Key& key) {
+    iterator i=lower_bound(key);
+    return (i!=end() && !Compare()(key,(*i).first))?i:end();
+  }
+  const_iterator find(const Key& key) const {
+    const_iterator i=lower_bound(key);
+    return (i!=end() && !Compare()(key,(*i).first))?i:end();
+  }
+  size_type count(const Key& key) const { return find(key)!=end()?1:0; }
+
+  std::pair<iterator,bool> insert(const value_type& element) {
+    iterator i=lower_bound(element.first);
+    if(i!=end() && !Compare()(element.first,(*i).first))
+      return std::make_pair(i,false);
+    return std::make_pair(_elements.insert(i,element),true);
+  }
+  Value& operator[](const Key& key) {
+    iterator i=lower_bound(key);
+    if(i==end() || Compare()(key,(*i).first))
+      i=_elements.insert(i,value_type(key,Value()));
+    return (*i).second;
+  }
+
+  void erase(iterator i) { _elements.erase(i); }
+  size_type erase(const Key& key) {
+    iterator i=find(key);
+    if(i==end())
+      return 0;
+    _elements.erase(i);
+    return 1;
+  }
+
+  bool operator==(const FlatMap& other) const { return _elements==other._elements; }
+  bool operator!=(const FlatMap& other) const { return _elements!=other._elements; }
+  bool operator<(const FlatMap& other) const { return _elements<other._elements; }
+
+ private:
+  struct KeyLess {
+    bool operator()(const value_type& element, const Key& key) const { return Compare()(element.first,key); }
+  };
+  std::vector<value_type> _elements;
+};
+
+#endif
@@ -6,126 +6,47 @@
  * Author   : Markus Schordan                                *
  * License  : see file LICENSE in the CodeThorn distribution *
  *************************************************************/
-//#define USE_CUSTOM_HSET
-#ifdef USE_CUSTOM_HSET
-#include "HSet.h"
-using namespace br_stl;
-#else
-#include <boost/unordered_set.hpp>
-#endif
-
-//#include "/usr/include/valgrind/memcheck.h"
-//#define HSET_MAINTAINER_DEBUG_MODE
+#include "ConcurrentStateStore.h"
 
-/*! 
+/*!
   * \author Markus Schordan
   * \date 2012.
+  * \brief Maintains unique copies of states. All operations except erasing,
+  * clearing and assignment are thread safe without locking (see ConcurrentStateStore).
  */
 template<typename KeyType,typename HashFun, typename EqualToPred>
-class HSetMaintainer 
-#ifdef USE_CUSTOM_HSET
-  : public HSet<KeyType*,HashFun,EqualToPred>
-#else
-  : public boost::unordered_set<KeyType*,HashFun,EqualToPred>
-#endif
+class HSetMaintainer
+  : public ConcurrentStateStore<KeyType,HashFun,EqualToPred>
   {
 public:
+  typedef ConcurrentStateStore<KeyType,HashFun,EqualToPred> StateStore;
   typedef pair<bool,const KeyType*> ProcessingResult;
-  bool exists(KeyType& s) { 
+  bool exists(KeyType& s) {
     return determine(s)!=0;
   }
 
+  //! id of the maintained copy of s, assigned when it was inserted. Takes constant time.
   size_t id(const KeyType& s) {
-#ifdef USE_CUSTOM_HSET
-    typename HSet<KeyType*,HashFun,EqualToPred>::const_iterator i;
-#else
-    typename boost::unordered_set<KeyType*,HashFun,EqualToPred>::const_iterator i;
-#endif
-    i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(s);
-    if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-      // in lack of operator '-' we compute the distance
-      size_t pos=0;
-#ifdef USE_CUSTOM_HSET
-      typename HSet<KeyType*,HashFun,EqualToPred>::const_iterator b;
-#else
-      typename boost::unordered_set<KeyType*,HashFun,EqualToPred>::const_iterator b;
-#endif
-      b=HSetMaintainer<KeyType,HashFun,EqualToPred>::begin();
-      while(b!=i) {
-        pos++;
-        ++b;
-      }
-      return pos;
-    }
+    size_t id=StateStore::findId(const_cast<KeyType*>(&s));
+    if(id!=StateStore::NO_ID)
+      return id;
     else
       throw "Error: unknown value. Maintainer cannot determine an id.";
   }
 
-  typename HSetMaintainer<KeyType,HashFun,EqualToPred>::iterator i;
-
-  KeyType* determine(KeyType& s) { 
-    KeyType* ret=0;
-    typename HSetMaintainer<KeyType,HashFun,EqualToPred>::iterator i;
-#pragma omp critical(HASHSET)
-    {
-#ifdef USE_CUSTOM_HSET
-      i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(s);
-      if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-        ret=const_cast<KeyType*>(&(*i));
-      } else {
-        ret=0;
-      }
-#else
-      i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(&s);
-      if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-        ret=const_cast<KeyType*>(*i);
-      } else {
-        ret=0;
-      }
-#endif
-    }
-    return ret;
+  KeyType* determine(KeyType& s) {
+    size_t id=StateStore::findId(&s);
+    return id!=StateStore::NO_ID?StateStore::keyOf(id):0;
   }
 
-  const KeyType* determine(const KeyType& s) { 
-    const KeyType* ret=0;
-    typename HSetMaintainer<KeyType,HashFun,EqualToPred>::iterator i;
-#pragma omp critical(HASHSET)
-    {
-#ifdef USE_CUSTOM_HSET
-      i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(s);
-      if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-        ret=&(*i);
-      } else {
-        ret=0;
-      }
-#else
-      i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(const_cast<KeyType*>(&s));
-      if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-        ret=const_cast<KeyType*>(*i);
-      } else {
-        ret=0;
-      }
-#endif
-    }
-    return ret;
+  const KeyType* determine(const KeyType& s) {
+    size_t id=StateStore::findId(const_cast<KeyType*>(&s));
+    return id!=StateStore::NO_ID?StateStore::keyOf(id):0;
   }
 
   ProcessingResult process(const KeyType* key) {
-    ProcessingResult res2;
-#pragma omp critical(HASHSET)
-    {
-      std::pair<typename HSetMaintainer::iterator, bool> res;
-      typename HSetMaintainer::iterator iter=this->find(const_cast<KeyType*>(key)); // TODO: eliminate const_cast
-      if(iter!=this->end()) {
-        // found it!
-        res=make_pair(iter,false);
-      } else {
-        res=this->insert(const_cast<KeyType*>(key)); // TODO: eliminate const_cast
-      }
-      res2=make_pair(res.second,*res.first);
-    }
-    return res2;
+    std::pair<typename HSetMaintainer::iterator, bool> res=this->insert(const_cast<KeyType*>(key)); // TODO: eliminate const_cast
+    return make_pair(res.second,*res.first);
   }
   const KeyType* processNewOrExisting(const KeyType* s) {
     ProcessingResult res=process(s);
@@ -135,42 +56,20 @@ public:
   //! <true,const KeyType> if new element was inserted
   //! <false,const KeyType> if element already existed
   ProcessingResult process(KeyType key) {
-    ProcessingResult res2;
-#pragma omp critical(HASHSET)
-    {
-    std::pair<typename HSetMaintainer::iterator, bool> res;
-    typename HSetMaintainer::iterator iter=this->find(&key);
-    if(iter!=this->end()) {
-      // found it!
-      res=make_pair(iter,false);
-    } else {
-      // converting the stack allocated object to heap allocated
-      // this copies the entire object
-      // TODO: this can be avoided by providing a process function with a pointer arg
-      //       this requires a more detailed result: pointer exists, alternate pointer with equal object exists, does not exist
-      KeyType* keyPtr=new KeyType();
-      *keyPtr=key;
-      res=this->insert(keyPtr);
-    }
-#ifdef HSET_MAINTAINER_DEBUG_MODE
-    std::pair<typename HSetMaintainer::iterator, bool> res1;
-    res1=this->insert(key);
-    std::pair<typename HSetMaintainer::iterator, bool> res2;
-    res2=this->insert(key);
-    if(!(res1==res2)) {
-      cerr<< "Error: HsetMaintainer failed:"<<endl;
-      cerr<< "res1:"<<(*res1.first).toString()<<":"<<res1.second<<endl;
-      cerr<< "res2:"<<(*res2.first).toString()<<":"<<res2.second<<endl;
-      exit(1);
+    if(const KeyType* existing=determine(key))
+      return make_pair(false,existing);
+    // converting the stack allocated object to heap allocated
+    // this copies the entire object
+    KeyType* keyPtr=new KeyType();
+    *keyPtr=key;
+    std::pair<typename HSetMaintainer::iterator, bool> res=this->insert(keyPtr);
+    if(!res.second) {
+      // another thread inserted an equal object in the meantime
+      delete keyPtr;
     }
-    cerr << "HSET insert OK"<<endl;
-#endif
-    res2=make_pair(res.second,*res.first);
-    }
-    return res2;
+    return make_pair(res.second,*res.first);
   }
   const KeyType* processNew(KeyType& s) {
-    //std::pair<typename HSetMaintainer::iterator, bool> res=process(s);
     ProcessingResult res=process(s);
     if(res.first!=true) {
       cerr<< "Error: HsetMaintainer::processNew failed:"<<endl;
@@ -185,32 +84,22 @@ public:
     ProcessingResult res=process(s);
     return res.second;
   }
-  long numberOf() { return HSetMaintainer<KeyType,HashFun,EqualToPred>::size(); }
+  long numberOf() { return StateStore::size(); }
 
+  //! length of the longest probe sequence of an insertion
   long maxCollisions() {
-#ifdef USE_CUSTOM_HSET
-    return HSetMaintainer<KeyType,HashFun,EqualToPred>::max_collisions();
-#else
-    //MS:2012
-    size_t max=0;
-    for(size_t i=0; i<HSetMaintainer<KeyType,HashFun,EqualToPred>::bucket_count();++i) {
-      if(HSetMaintainer<KeyType,HashFun,EqualToPred>::bucket_size(i)>max) {
-        max=HSetMaintainer<KeyType,HashFun,EqualToPred>::bucket_size(i);
-      }
-    }
-    return max;
-#endif
+    return StateStore::max_probes();
   }
 
   double loadFactor() {
-    return HSetMaintainer<KeyType,HashFun,EqualToPred>::load_factor();
+    return StateStore::load_factor();
   }
 
   long memorySize() const {
     long mem=0;
     for(typename HSetMaintainer<KeyType,HashFun,EqualToPred>::const_iterator i
-          =HSetMaintainer<KeyType,HashFun,EqualToPred>::begin();
-        i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end();
+          =StateStore::begin();
+        i!=StateStore::end();
         ++i) {
       mem+=(*i)->memorySize();
     }
@@ -65,9 +65,9 @@ namespace CodeThorn {
   // an interface used to test LTL formulas on CodeThorns TransitionGraphs
   class SpotConnection {
     public:
-      SpotConnection() {};
+      SpotConnection():ltlResults(0),modeLTLDriven(false),numberOfProcesses(1) {};
       //constructor with automatic initialization
-      SpotConnection(std::string ltl_formulae_file) {init(ltl_formulae_file);};
+      SpotConnection(std::string ltl_formulae_file):ltlResults(0),modeLTLDriven(false),numberOfProcesses(1) {init(ltl_formulae_file);};
       //an initilaization that reads in a text file with ltl formulae (RERS 2014 format). Extracts the behaviorProperties
       // and creates an ltlResults table of the respective size (all results initialized to be "unknown").
       void init(std::string ltl_formulae_file);
@@ -101,6 +101,10 @@ namespace CodeThorn {
       // and 'o' for "maxIntVal" to 26 (RERS format)
       std::string int2PropName(int ioVal, int maxInVal);
       void setModeLTLDriven(bool ltlDriven);
+      // number of processes "checkLtlProperties" distributes the properties over (default: 1). SPOT is not thread safe,
+      // therefore separate processes are used, each with its own copy of the (then read-only) STG.
+      // Not used in LTL-driven mode, where the STG is computed while the properties are checked.
+      void setNumberOfProcesses(int n);
     private:
       //Removes every "WU" in a string with 'W". Necessary because only accepts this syntax.
       string& parseWeakUntil(std::string& ltl_string);
@@ -118,6 +122,13 @@ namespace CodeThorn {
       // check a single LTL property and update the results table
       void checkAndUpdateResults(LtlProperty property, SpotTgba* ct_tgba, TransitionGraph& stg, 
                                                      bool withCounterexample, bool spuriousNoAnswers);
+      // update the results table with SPOT's result for a property ("pCounterExample" may be 0)
+      void updateResults(int propertyNumber, bool verified, std::string* pCounterExample, TransitionGraph& stg,
+                                                     bool withCounterexample, bool spuriousNoAnswers);
+      // check the properties in "numberOfProcesses" child processes that report each result over a pipe as soon as
+      // it is known. Properties whose results are not reported (e.g. because fork failed) are checked in this process.
+      void checkPropertiesInProcesses(std::list<LtlProperty>& properties, SpotTgba* ct_tgba, TransitionGraph& stg,
+                                                     bool withCounterexample, bool spuriousNoAnswers);
       //returns true if the given model_tgba satisfies the ltl formula ltl_string. returns false otherwise. 
       // The dict parameter is the model_tgba's dictionary of atomic propsitions. ce_ptr is an out parameter 
       // for a counter-example in case one is found by SPOT.
@@ -143,6 +154,7 @@ namespace CodeThorn {
       //a container for the results of the LTL property evaluation
       PropertyValueTable* ltlResults;
       bool modeLTLDriven;
+      int numberOfProcesses;
   };
 };
 #endif
@@ -13,6 +13,7 @@
 #include <set>
 #include <map>
 #include <utility>
+#include <stdint.h>
 #include "Labeler.h"
 #include "CFAnalysis.h"
 #include "AType.h"
@@ -26,6 +27,7 @@ typedef int EStateId;
 
 #include "HashFun.h"
 #include "HSetMaintainer.h"
+#include "FlatMap.h"
 
 using CodeThorn::AValue;
 using CodeThorn::ConstraintSet;
@@ -41,8 +43,9 @@ namespace CodeThorn {
 /*! 
   * \author Markus Schordan
   * \date 2012.
+  * \brief Values of variables, kept sorted by variable id in one array (see FlatMap).
  */
-class PState : public map<VariableId,CodeThorn::AValue> {
+class PState : public FlatMap<VariableId,CodeThorn::AValue> {
  public:
     PState() {
     }
@@ -66,8 +69,14 @@ class PState : public map<VariableId,CodeThorn::AValue> {
   void topifyState();
   bool isTopifiedState() const;
   VariableIdSet getVariableIds() const;
+  //! 64-bit hash of the variables and their values
+  uint64_t fingerprint() const;
   static void setActiveGlobalTopify(bool val);
   static void setVariableValueMonitor(VariableValueMonitor* vvm);
+  /*! with hash compaction, states with equal fingerprints are considered equal;
+      saves the comparison of the variables, at the risk of dropping a state on a collision */
+  static void setHashCompaction(bool val);
+  static bool _hashCompaction;
   static bool _activeGlobalTopify;
   static VariableValueMonitor* _variableValueMonitor;
   static Analyzer* _analyzer;
@@ -98,11 +107,7 @@ class PStateHashFun {
    public:
     PStateHashFun() {}
     long operator()(PState* s) const {
-      unsigned int hash=1;
-      for(PState::iterator i=s->begin();i!=s->end();++i) {
-        hash=((hash<<8)+((long)(*i).second.hash()))^hash;
-      }
-      return long(hash);
+      return long(s->fingerprint());
     }
    private:
 };
@@ -111,7 +116,9 @@ class PStateEqualToPred {
    public:
     PStateEqualToPred() {}
     bool operator()(PState* s1, PState* s2) const {
-      if(s1->size()!=s2->size()) {
+      if(PState::_hashCompaction) {
+        return s1->fingerprint()==s2->fingerprint();
+      } else if(s1->size()!=s2->size()) {
         return false;
       } else {
         for(PState::iterator i1=s1->begin(), i2=s2->begin();i1!=s1->end();(++i1,++i2)) {
@@ -74,6 +74,16 @@ class Dependency {
 		 */
 		size_t getTo() const;
 		
+		/**
+		 * \return the position of the access in the dependent statement.
+		 */
+		size_t getFromPos() const;
+		
+		/**
+		 * \return the position of the access in the statement it depends on.
+		 */
+		size_t getToPos() const;
+		
 		/**
 		 * \return the type of the dependency (RaR, RaW, WaR, WaW).
 		 */
@@ -444,6 +444,12 @@ size_t Dependency<Function, Expression, VariableLBL>::getFrom() const { return p
 template <class Function, class Expression, class VariableLBL>
 size_t Dependency<Function, Expression, VariableLBL>::getTo() const { return p_to; }
 
+template <class Function, class Expression, class VariableLBL>
+size_t Dependency<Function, Expression, VariableLBL>::getFromPos() const { return p_from_pos; }
+
+template <class Function, class Expression, class VariableLBL>
+size_t Dependency<Function, Expression, VariableLBL>::getToPos() const { return p_to_pos; }
+
 template <class Function, class Expression, class VariableLBL>
 DependencyType Dependency<Function, Expression, VariableLBL>::getType() const { return p_type; }
 
@@ -0,0 +1,89 @@
+/**
+ * \file src/rose/ScopCache.cpp
+ * \brief Implementation of the structural hash of loop nests and of the dependencies cache.
+ * \author Tristan Vanderbruggen
+ * \version 0.1
+ */
+
+#include "rose/ScopCache.hpp"
+
+#include <cstdio>
+
+namespace PolyhedricAnnotation {
+
+/* structuralHash */
+
+/**
+ * \brief FNV-1a hash of the pre-order traversal of a sub-tree (the post-order visit marks the end of a node).
+ */
+class StructuralHash : public AstPrePostProcessing {
+	protected:
+		uint64_t p_hash;
+
+		void add(const std::string & str) {
+			for (size_t i = 0; i < str.size(); i++) {
+				p_hash ^= (unsigned char)str[i];
+				p_hash *= 0x100000001b3ULL;
+			}
+			// separator, "ab" "c" and "a" "bc" have different hashes
+			p_hash ^= 0xff;
+			p_hash *= 0x100000001b3ULL;
+		}
+
+		void add(uint64_t value) {
+			for (size_t i = 0; i < sizeof(value); i++) {
+				p_hash ^= (value >> (8 * i)) & 0xff;
+				p_hash *= 0x100000001b3ULL;
+			}
+		}
+
+		virtual void preOrderVisit(SgNode * node) {
+			add((uint64_t)node->variantT());
+
+			if (SgVarRefExp * var_ref = isSgVarRefExp(node))
+				add(var_ref->get_symbol()->get_name().getString());
+			else if (SgFunctionRefExp * func_ref = isSgFunctionRefExp(node))
+				add(func_ref->get_symbol()->get_name().getString());
+			else if (SgInitializedName * init_name = isSgInitializedName(node)) {
+				add(init_name->get_name().getString());
+				add(init_name->get_type()->unparseToString());
+			}
+			else if (SgCastExp * cast = isSgCastExp(node))
+				add(cast->get_type()->unparseToString());
+			else if (isSgValueExp(node))
+				add(node->unparseToString());
+			else if (SgPragma * pragma = isSgPragma(node))
+				add(pragma->get_pragma());
+		}
+
+		virtual void postOrderVisit(SgNode * node) {
+			add((uint64_t)V_SgNumVariants);
+		}
+
+	public:
+		StructuralHash() :
+			p_hash(0xcbf29ce484222325ULL)
+		{}
+
+		uint64_t getHash() const { return p_hash; }
+};
+
+uint64_t structuralHash(SgNode * loop_nest) {
+	StructuralHash hash;
+	hash.traverse(loop_nest);
+	return hash.getHash();
+}
+
+/* DependencyCache */
+
+DependencyCache::DependencyCache(const std::string & directory) :
+	p_directory(directory)
+{}
+
+std::string DependencyCache::fileName(uint64_t key) const {
+	char name[17];
+	std::sprintf(name, "%016llx", (unsigned long long)key);
+	return p_directory + "/" + name + ".deps";
+}
+
+}
@@ -0,0 +1,107 @@
+/**
+ * \file include/rose/ScopCache.hpp
+ * \brief Cache of the dependencies of SCoPs (keyed by a structural hash of their loop nest) and
+ *        computation of the dependencies of independent SCoPs on several threads.
+ * \author Tristan Vanderbruggen
+ * \version 0.1
+ */
+
+#ifndef _SCOP_CACHE_HPP_
+#define _SCOP_CACHE_HPP_
+
+#include "rose/rose-utils.hpp"
+#include "common/PolyhedricContainer.hpp"
+#include "common/PolyhedricDependency.hpp"
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+namespace PolyhedricAnnotation {
+
+/**
+ * \brief Hash of the structure of a loop nest.
+ *
+ * Combines, in pre-order, the variants of the nodes of the sub-tree, the names of the referenced
+ * variables and functions, the types of the declared variables and the values of the constants.
+ * Two loop nests with the same hash give the same polyhedral modelisation (up to hash collisions):
+ * same statements, same iterators, same variables in the same order.
+ */
+uint64_t structuralHash(SgNode * loop_nest);
+
+/**
+ * \brief Store the dependencies of SCoPs in a directory, one file by loop nest.
+ *
+ * An entry is only reused if the SCoP it is loaded for has the same numbers of statements,
+ * variables and globals than the one it was computed for.
+ */
+class DependencyCache {
+	protected:
+		std::string p_directory;
+
+		std::string fileName(uint64_t key) const;
+
+	public:
+		/**
+		 * \param directory where the entries are stored (has to exist).
+		 */
+		DependencyCache(const std::string & directory);
+
+		/**
+		 * \return the dependencies of 'polyhedral_program' stored for 'key', NULL if there is no valid entry.
+		 */
+		template <class TplStatement>
+		std::vector<PolyhedricDependency::Dependency<TplStatement, SgExprStatement, RoseVariable> *> * load(
+			uint64_t key,
+			const PolyhedralProgram<TplStatement, SgExprStatement, RoseVariable> & polyhedral_program
+		) const;
+
+		/**
+		 * \brief Store the dependencies of 'polyhedral_program' for 'key' (replace a previous entry).
+		 */
+		template <class TplStatement>
+		void store(
+			uint64_t key,
+			const PolyhedralProgram<TplStatement, SgExprStatement, RoseVariable> & polyhedral_program,
+			const std::vector<PolyhedricDependency::Dependency<TplStatement, SgExprStatement, RoseVariable> *> & dependencies
+		) const;
+};
+
+/**
+ * \brief A SCoP for which the dependencies are needed.
+ */
+template <class TplStatement>
+struct ScopDependencies {
+	PolyhedralProgram<TplStatement, SgExprStatement, RoseVariable> * polyhedral_program;
+	SgNode * loop_nest; //!< hashed to access the cache
+
+	//! Set by ComputeDependencies, NULL if the computation failed.
+	std::vector<PolyhedricDependency::Dependency<TplStatement, SgExprStatement, RoseVariable> *> * dependencies;
+
+	ScopDependencies(PolyhedralProgram<TplStatement, SgExprStatement, RoseVariable> * polyhedral_program_, SgNode * loop_nest_);
+};
+
+/**
+ * \brief Compute the dependencies of a set of SCoPs.
+ *
+ * SCoPs found in 'cache' are not analysed. The others are analysed independently by 'nbr_threads'
+ * threads (as the dependencies of one SCoP do not depend on the other ones) and stored in 'cache'.
+ * The exception of a failed SCoP is printed on std::cerr and its dependencies are left NULL.
+ *
+ * \bug PPL is only thread-safe when it is configured with --enable-thread-safe: with other builds
+ *      the SCoPs are analysed one after the other, whatever 'nbr_threads'.
+ */
+template <class TplStatement>
+void ComputeDependencies(
+	std::vector<ScopDependencies<TplStatement> > & scops,
+	const DependencyCache * cache = NULL,
+	size_t nbr_threads = 1,
+	bool precise = true
+);
+
+}
+
+#include "rose/ScopCache.tpp"
+
+#endif /* _SCOP_CACHE_HPP_ */
@@ -0,0 +1,224 @@
+/**
+ * \file src/rose/ScopCache.tpp
+ * \brief Implementation of the dependencies cache and of the multi-threaded dependencies computation (template).
+ * \author Tristan Vanderbruggen
+ * \version 0.1
+ */
+
+#include <boost/thread.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+#define SCOP_CACHE_MAGIC "ROSE_SCOP_DEPENDENCIES"
+#define SCOP_CACHE_VERSION 1
+
+namespace PolyhedricAnnotation {
+
+/* DependencyCache */
+
+template <class TplStatement>
+std::vector<PolyhedricDependency::Dependency<TplStatement, SgExprStatement, RoseVariable> *> * DependencyCache::load(
+	uint64_t key,
+	const PolyhedralProgram<TplStatement, SgExprStatement, RoseVariable> & polyhedral_program
+) const {
+	typedef PolyhedricDependency::Dependency<TplStatement, SgExprStatement, RoseVariable> Dependency;
+
+	std::ifstream in(fileName(key).c_str());
+	if (!in) return NULL;
+
+	std::string magic;
+	int version;
+	size_t nbr_statements, nbr_variables, nbr_globals, nbr_dependencies;
+	if (!(in >> magic >> version >> nbr_statements >> nbr_variables >> nbr_globals >> nbr_dependencies))
+		return NULL;
+	if (magic != SCOP_CACHE_MAGIC || version != SCOP_CACHE_VERSION)
+		return NULL;
+	if (
+		nbr_statements != polyhedral_program.getNumberOfStatement() ||
+		nbr_variables  != polyhedral_program.getNumberOfVariables() ||
+		nbr_globals    != polyhedral_program.getNumberOfGlobals()
+	) return NULL;
+
+	std::vector<Dependency *> * res = new std::vector<Dependency *>();
+	for (size_t i = 0; i < nbr_dependencies; i++) {
+		int type;
+		size_t from, to, from_pos, to_pos, variable;
+		Polyhedron dependency(0);
+		if (
+			!(in >> type >> from >> to >> from_pos >> to_pos >> variable) ||
+			type < PolyhedricDependency::RaR || type > PolyhedricDependency::WaW ||
+			from >= nbr_statements || to >= nbr_statements || variable >= nbr_variables ||
+			!dependency.ascii_load(in)
+		) {
+			typename std::vector<Dependency *>::iterator it;
+			for (it = res->begin(); it != res->end(); it++)
+				delete *it;
+			delete res;
+			return NULL;
+		}
+		res->push_back(new Dependency(
+			polyhedral_program, from, to, from_pos, to_pos, (PolyhedricDependency::DependencyType)type, variable, dependency
+		));
+	}
+
+	return res;
+}
+
+template <class TplStatement>
+void DependencyCache::store(
+	uint64_t key,
+	const PolyhedralProgram<TplStatement, SgExprStatement, RoseVariable> & polyhedral_program,
+	const std::vector<PolyhedricDependency::Dependency<TplStatement, SgExprStatement, RoseVariable> *> & dependencies
+) const {
+	typedef PolyhedricDependency::Dependency<TplStatement, SgExprStatement, RoseVariable> Dependency;
+
+	// Written in a temporary file first: a concurrent process never loads a partial entry
+	std::ostringstream tmp_name;
+	tmp_name << fileName(key) << ".tmp" << getpid();
+
+	std::ofstream out(tmp_name.str().c_str());
+	if (!out) return;
+
+	out << SCOP_CACHE_MAGIC << " " << SCOP_CACHE_VERSION << std::endl;
+	out << polyhedral_program.getNumberOfStatement() << " " << polyhedral_program.getNumberOfVariables() << " "
+	    << polyhedral_program.getNumberOfGlobals() << std::endl;
+	out << dependencies.size() << std::endl;
+
+	typename std::vector<Dependency *>::const_iterator it;
+	for (it = dependencies.begin(); it != dependencies.end(); it++) {
+		out << (int)(*it)->getType() << " " << (*it)->getFrom() << " " << (*it)->getTo() << " "
+		    << (*it)->getFromPos() << " " << (*it)->getToPos() << " " << (*it)->getVariable() << std::endl;
+		(*it)->getPolyhedron().ascii_dump(out);
+	}
+
+	out.close();
+	if (!out || std::rename(tmp_name.str().c_str(), fileName(key).c_str()) != 0)
+		std::remove(tmp_name.str().c_str());
+}
+
+/* ScopDependencies */
+
+template <class TplStatement>
+ScopDependencies<TplStatement>::ScopDependencies(
+	PolyhedralProgram<TplStatement, SgExprStatement, RoseVariable> * polyhedral_program_,
+	SgNode * loop_nest_
+) :
+	polyhedral_program(polyhedral_program_),
+	loop_nest(loop_nest_),
+	dependencies(NULL)
+{}
+
+/* ComputeDependencies */
+
+/**
+ * \brief Analyse the SCoPs of a queue until it is empty (one by thread).
+ */
+template <class TplStatement>
+class DependencyWorker {
+	protected:
+		const std::vector<std::pair<ScopDependencies<TplStatement> *, uint64_t> > & p_queue;
+		size_t & p_next;
+		boost::mutex & p_mutex;
+		const DependencyCache * p_cache;
+		bool p_precise;
+
+	public:
+		DependencyWorker(
+			const std::vector<std::pair<ScopDependencies<TplStatement> *, uint64_t> > & queue,
+			size_t & next,
+			boost::mutex & mutex,
+			const DependencyCache * cache,
+			bool precise
+		) :
+			p_queue(queue),
+			p_next(next),
+			p_mutex(mutex),
+			p_cache(cache),
+			p_precise(precise)
+		{}
+
+		void operator () () {
+#ifdef PPL_THREAD_SAFE
+			Parma_Polyhedra_Library::Thread_Init ppl_thread_init;
+#endif
+			while (true) {
+				std::pair<ScopDependencies<TplStatement> *, uint64_t> job;
+				{
+					boost::mutex::scoped_lock lock(p_mutex);
+					if (p_next == p_queue.size()) return;
+					job = p_queue[p_next++];
+				}
+
+				std::vector<PolyhedricDependency::Dependency<TplStatement, SgExprStatement, RoseVariable> *> * dependencies = NULL;
+				try {
+					dependencies = PolyhedricDependency::ComputeDependencies<TplStatement, SgExprStatement, RoseVariable>(
+						*job.first->polyhedral_program, p_precise
+					);
+				}
+				catch (Exception::ExceptionBase & e) {
+					boost::mutex::scoped_lock lock(p_mutex);
+					e.print(std::cerr);
+				}
+
+				job.first->dependencies = dependencies;
+
+				if (dependencies != NULL && p_cache != NULL) {
+					// Two SCoPs of the queue can have the same key
+					boost::mutex::scoped_lock lock(p_mutex);
+					p_cache->store<TplStatement>(job.second, *job.first->polyhedral_program, *dependencies);
+				}
+			}
+		}
+};
+
+template <class TplStatement>
+void ComputeDependencies(
+	std::vector<ScopDependencies<TplStatement> > & scops,
+	const DependencyCache * cache,
+	size_t nbr_threads,
+	bool precise
+) {
+	std::vector<std::pair<ScopDependencies<TplStatement> *, uint64_t> > queue;
+
+	typename std::vector<ScopDependencies<TplStatement> >::iterator it;
+	for (it = scops.begin(); it != scops.end(); it++) {
+		it->dependencies = NULL;
+
+		// Different precision, different entry
+		uint64_t key = structuralHash(it->loop_nest) ^ (precise ? 0 : 0x9e3779b97f4a7c15ULL);
+
+		if (cache != NULL)
+			it->dependencies = cache->load<TplStatement>(key, *it->polyhedral_program);
+
+		if (it->dependencies == NULL) {
+			// Modify the domains, done before sharing them with the threads
+			it->polyhedral_program->finalize();
+			queue.push_back(std::pair<ScopDependencies<TplStatement> *, uint64_t>(&(*it), key));
+		}
+	}
+
+#ifndef PPL_THREAD_SAFE
+	nbr_threads = 1;
+#endif
+	if (nbr_threads > queue.size()) nbr_threads = queue.size();
+
+	size_t next = 0;
+	boost::mutex mutex;
+	DependencyWorker<TplStatement> worker(queue, next, mutex, cache, precise);
+
+	if (nbr_threads <= 1) {
+		worker();
+		return;
+	}
+
+	boost::thread_group threads;
+	for (size_t i = 0; i < nbr_threads; i++)
+		threads.create_thread(worker);
+	threads.join_all();
+}
+
+}
@@ -78,12 +78,16 @@ void RuntimeSystem::readConfigFile()
         lineStream >> value_name;
         ViolationPolicy::Type value = getPolicyFromString( value_name );
 
+        const bool enabled = (  value_name == "1"
+                             || value_name == "yes"
+                             || value_name == "on"
+                             || value_name == "true"
+                             );
+
         if (key == "qtDebugger")
-            qtDebugger = (  value_name == "1"
-                         || value_name == "yes"
-                         || value_name == "on"
-                         || value_name == "true"
-                         );
+            qtDebugger = enabled;
+        else if (key == "shadowMemory")
+            memManager.setShadowMemoryEnabled(enabled);
         else
         {
             RuntimeViolation::Type t = RuntimeViolation::getViolationByString(key);
@@ -397,7 +401,7 @@ void RuntimeSystem::createObject(Address address, const RsClassType* type)
         {
           // Same address, larger size.  We assume that a base type was
           // registered, and now the derived's constructor has been called
-          mt->resize( szObj );
+          memManager.resizeMemory( *mt, szObj );
 
           // \note address == mt->beginAddress(), thus ofs of forceRegisterType is always 0
           mt->forceRegisterMemType( type );
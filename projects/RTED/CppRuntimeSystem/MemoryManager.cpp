@@ -196,31 +196,13 @@ bool MemoryType::operator< (const MemoryType& other) const
 bool MemoryType::isInitialized(Location addr, size_t len) const
 {
     const size_t           offset = byte_offset(startAddress, addr, blockSize(), 0);
-    const size_t           limit = offset + len;
 
-    for (size_t i = offset; i < limit; ++i)
-    {
-        if ( !byteInitialized(i) ) return false;
-    }
-
-    return true;
+    return initdata.allSet(offset, len);
 }
 
 bool MemoryType::initialize(size_t offset, size_t len)
 {
-    const size_t limit = offset + len;
-    bool         statuschange = false;
-
-    for (size_t i = offset; i < limit; ++i)
-    {
-      if (!initdata[i])
-      {
-        statuschange = true;
-        initdata[i] = true;
-      }
-    }
-
-    return statuschange;
+    return initdata.set(offset, len);
 }
 
 static inline
@@ -562,25 +544,10 @@ MemoryType::InitStatus initializationStatus(const MemoryType::InitData& initdata
 {
   assert(initdata.size() > 0);
 
-  bool         allset   = true;
-  bool         allunset = true;
-  const size_t last = initdata.size();
-  size_t       i = 0;
-
-  while (i < last && (allset || allunset))
-  {
-    const bool isset = initdata[i];
+  const size_t numset = initdata.count();
 
-    allset   = allset && isset;
-    allunset = allunset && !isset;
-
-    ++i;
-  }
-
-  assert(!(allset && allunset));
-
-  if (allset)   return MemoryType::all;
-  if (allunset) return MemoryType::none;
+  if (numset == initdata.size()) return MemoryType::all;
+  if (numset == 0)               return MemoryType::none;
   return MemoryType::some;
 }
 
@@ -694,9 +661,56 @@ MemType* validateMembership(MemType* mt, Address addr, size_t size)
   return (mt && mt->containsMemArea(addr,size)) ?  mt  : NULL;
 }
 
+bool MemoryManager::shadowIndexable(const MemoryType& mt) const
+{
+    // distributed (UPC) allocations are not contiguous in the local address space
+    return (  !mt.isDistributed()
+           && rted_isLocal(mt.beginAddress())
+           && ShadowMemory::indexable(mt.beginAddress().local, mt.getSize())
+           );
+}
+
+bool MemoryManager::shadowLookup(Location addr, MemoryType*& res) const
+{
+    if (!shadowEnabled || !rted_isLocal(addr)) return false;
+
+    MemoryType* owner = shadow.owner(addr.local);
+
+    if (owner == ShadowMemory::ambiguous()) return false;
+
+    // no owner is only conclusive when all allocations are indexed
+    if (owner == NULL && unindexedAllocations != 0) return false;
+
+    res = owner;
+    return true;
+}
+
+void MemoryManager::setShadowMemoryEnabled(bool enabled)
+{
+    shadow.clear();
+    unindexedAllocations = 0;
+    shadowEnabled = enabled;
+
+    if (!shadowEnabled) return;
+
+    for (MemoryTypeSet::iterator i = mem.begin(); i != mem.end(); ++i)
+    {
+      MemoryType& mt = i->second;
+
+      if (shadowIndexable(mt))
+        shadow.insert(mt.beginAddress().local, mt.getSize(), &mt);
+      else
+        ++unindexedAllocations;
+    }
+}
+
 MemoryType* MemoryManager::findContainingMem(Location addr, size_t size)
 {
-    MemoryType* res = memtypecache.findContainingMem(addr, size);
+    MemoryType* res = NULL;
+
+    if (shadowLookup(addr, res)) return ::validateMembership(res, addr, size);
+
+    res = memtypecache.findContainingMem(addr, size);
 
     if (!res)
     {
@@ -711,6 +725,10 @@ MemoryType* MemoryManager::findContainingMem(Location addr, size_t size)
 const MemoryType*
 MemoryManager::findContainingMem(Location addr, size_t size) const
 {
+    MemoryType* res = NULL;
+
+    if (shadowLookup(addr, res)) return ::validateMembership(res, addr, size);
+
     return ::validateMembership(findPossibleMemMatch(addr), addr, size);
 }
 
@@ -747,6 +765,14 @@ MemoryType* MemoryManager::allocateMemory(Location adrObj, size_t szObj, MemoryT
     MemoryTypeSet::value_type v(adrObj, tmp);
     MemoryType&               res = mem.insert(v).first->second;
 
+    if (shadowEnabled)
+    {
+      if (shadowIndexable(res))
+        shadow.insert(adrObj.local, szObj, &res);
+      else
+        ++unindexedAllocations;
+    }
+
     memtypecache.store(res);
     return &res;
 }
@@ -883,6 +909,14 @@ void MemoryManager::freeMemory(MemoryType* m, MemoryType::AllocKind freekind)
     // remove entry from cache
     memtypecache.clear(*m);
 
+    if (shadowEnabled)
+    {
+      if (shadowIndexable(*m))
+        shadow.erase(m->beginAddress().local, m->getSize(), m);
+      else
+        --unindexedAllocations;
+    }
+
     // successful free, erase allocation info from map
     mem.erase(m->beginAddress());
 
@@ -913,6 +947,16 @@ void MemoryManager::freeStackMemory(Location addr)
     freeMemory( mt, mt->howCreated() );
 }
 
+void MemoryManager::resizeMemory(MemoryType& mt, size_t size)
+{
+    const bool indexed = shadowEnabled && shadowIndexable(mt);
+
+    mt.resize(size);
+
+    // the granules of the old size are mapped to mt again
+    if (indexed) shadow.insert(mt.beginAddress().local, mt.getSize(), &mt);
+}
+
 template <class MemManager>
 static
 typename ConstLike<MemManager, MemoryType>::type*
@@ -1293,6 +1337,8 @@ void MemoryManager::clearStatus()
 {
   mem.clear();
   memtypecache.clear();
+  shadow.clear();
+  unindexedAllocations = 0;
 }
 
 
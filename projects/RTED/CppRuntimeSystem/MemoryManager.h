@@ -12,6 +12,7 @@
 #include <iomanip>
 
 #include "CStdLibManager.h"
+#include "ShadowMemory.h"
 #include "Util.h"
 
 #include "ptrops.h"
@@ -36,7 +37,7 @@ struct MemoryType
         typedef rted_AllocKind                  AllocKind;
 
         typedef const char*                     LocalPtr;
-        typedef std::vector<bool>               InitData;
+        typedef InitBitmap                      InitData;
         typedef std::map<size_t, const RsType*> TypeData;
         typedef TypeData::iterator              TiIter;
 
@@ -200,9 +201,15 @@ struct MemoryManager
         typedef std::map<Location, MemoryType> MemoryTypeSet;
 
         MemoryManager()
-        : mem()
+        : mem(), shadow(), shadowEnabled(false), unindexedAllocations(0)
         {}
 
+        /// \brief Turns the shadow memory index on or off (@see ShadowMemory).
+        ///        When it is on, the allocations containing an address are found in
+        ///        constant time (set with "shadowMemory yes" in RTED.cfg).
+        void setShadowMemoryEnabled(bool enabled);
+        bool isShadowMemoryEnabled() const { return shadowEnabled; }
+
         /// \brief  Create a new allocation based on the parameters
         /// \return a pointer to the actual stored object (NULL in case something went wrong)
         MemoryType* allocateMemory(Location addr, size_t size, MemoryType::AllocKind kind, long blocksize, const SourceInfo& pos);
@@ -213,6 +220,9 @@ struct MemoryManager
         /// tracks deallocations related to scope exits
         void freeStackMemory(Location addr);
 
+        /// grows an allocation (e.g. when a derived class' constructor is called)
+        void resizeMemory(MemoryType& mt, size_t size);
+
         /// Prints information about all currently allocated memory areas
         void print(std::ostream & os) const;
 
@@ -301,7 +311,17 @@ struct MemoryManager
         /// Frees allocated memory, throws error when no allocation is managed at this addr
         void freeMemory(MemoryType* m, MemoryType::AllocKind);
 
+        /// Returns true if mt is (to be) indexed by the shadow memory
+        bool shadowIndexable(const MemoryType& mt) const;
+
+        /// \brief  Looks addr up in the shadow memory
+        /// \return true, iff the shadow memory gives the answer (res, possibly NULL)
+        bool shadowLookup(Location addr, MemoryType*& res) const;
+
         MemoryTypeSet mem;
+        ShadowMemory  shadow;
+        bool          shadowEnabled;
+        size_t        unindexedAllocations; ///< number of allocations not in the shadow memory
 
         friend class CStdLibManager;
 };
@@ -0,0 +1,194 @@
+#include <cassert>
+#include <algorithm>
+
+#include "ShadowMemory.h"
+
+// -----------------------    InitBitmap  --------------------------------------
+
+const size_t InitBitmap::WORDBITS;
+
+/// \brief returns the mask of the bits [from, to) of a word (to <= WORDBITS)
+static inline
+InitBitmap::Word bitMask(size_t from, size_t to)
+{
+  const InitBitmap::Word all = ~InitBitmap::Word(0);
+  const InitBitmap::Word upper = (to == InitBitmap::WORDBITS) ? all : ((InitBitmap::Word(1) << to) - 1);
+
+  return upper & (all << from);
+}
+
+void InitBitmap::resize(size_t sz)
+{
+  // bits past len are always clear, a bitmap only grows
+  assert(sz >= len);
+
+  bits.resize(numWords(sz), 0);
+  len = sz;
+}
+
+bool InitBitmap::allSet(size_t ofs, size_t n) const
+{
+  assert(ofs + n <= len);
+
+  size_t       i = ofs;
+  const size_t limit = ofs + n;
+
+  while (i < limit)
+  {
+    const size_t word = i / WORDBITS;
+    const size_t from = i % WORDBITS;
+    const size_t to = std::min(WORDBITS, from + (limit - i));
+    const Word   mask = bitMask(from, to);
+
+    if ((bits[word] & mask) != mask) return false;
+
+    i += to - from;
+  }
+
+  return true;
+}
+
+bool InitBitmap::set(size_t ofs, size_t n)
+{
+  assert(ofs + n <= len);
+
+  bool         statuschange = false;
+  size_t       i = ofs;
+  const size_t limit = ofs + n;
+
+  while (i < limit)
+  {
+    const size_t word = i / WORDBITS;
+    const size_t from = i % WORDBITS;
+    const size_t to = std::min(WORDBITS, from + (limit - i));
+    const Word   mask = bitMask(from, to);
+
+    statuschange = statuschange || ((bits[word] & mask) != mask);
+    bits[word] |= mask;
+
+    i += to - from;
+  }
+
+  return statuschange;
+}
+
+size_t InitBitmap::count() const
+{
+  size_t res = 0;
+
+  for (size_t i = 0; i < bits.size(); ++i)
+  {
+    for (Word w = bits[i]; w != 0; w &= w - 1)
+      ++res;
+  }
+
+  return res;
+}
+
+// -----------------------    ShadowMemory  --------------------------------------
+
+static inline
+size_t granuleOf(ShadowMemory::LocalPtr addr, size_t granuleBits)
+{
+  return reinterpret_cast<size_t>(addr) >> granuleBits;
+}
+
+bool ShadowMemory::indexable(LocalPtr addr, size_t size)
+{
+  const size_t last = reinterpret_cast<size_t>(addr) + size - 1;
+
+  // the tables cover the lower 2^48 bytes of the address space
+  return (  size > 0
+         && last >= reinterpret_cast<size_t>(addr)
+         && ((last >> (GRANULE_BITS + LEAF_BITS)) >> MID_BITS) < (size_t(1) << ROOT_BITS)
+         );
+}
+
+MemoryType*& ShadowMemory::entry(size_t granule)
+{
+  if (root.empty()) root.resize(size_t(1) << ROOT_BITS, NULL);
+
+  const size_t ri = granule >> (MID_BITS + LEAF_BITS);
+  const size_t mi = (granule >> LEAF_BITS) & ((size_t(1) << MID_BITS) - 1);
+  const size_t li = granule & ((size_t(1) << LEAF_BITS) - 1);
+
+  Mid*& mid = root[ri];
+
+  // value initialization clears the tables
+  if (!mid) mid = new Mid();
+
+  Leaf*& leaf = mid->leaves[mi];
+
+  if (!leaf) leaf = new Leaf();
+
+  return leaf->owners[li];
+}
+
+void ShadowMemory::insert(LocalPtr addr, size_t size, MemoryType* mt)
+{
+  assert(indexable(addr, size) && mt != NULL);
+
+  const size_t first = granuleOf(addr, GRANULE_BITS);
+  const size_t last = granuleOf(addr + size - 1, GRANULE_BITS);
+
+  for (size_t g = first; g <= last; ++g)
+  {
+    MemoryType*& e = entry(g);
+
+    // only the first and last granules can be shared with other allocations
+    if ((g == first || g == last) && e != NULL && e != mt)
+      e = ambiguous();
+    else
+      e = mt;
+  }
+}
+
+void ShadowMemory::erase(LocalPtr addr, size_t size, const MemoryType* mt)
+{
+  assert(indexable(addr, size));
+
+  const size_t first = granuleOf(addr, GRANULE_BITS);
+  const size_t last = granuleOf(addr + size - 1, GRANULE_BITS);
+
+  // ambiguous granules stay ambiguous, as another allocation may still use them
+  for (size_t g = first; g <= last; ++g)
+  {
+    MemoryType*& e = entry(g);
+
+    if (e == mt) e = NULL;
+  }
+}
+
+MemoryType* ShadowMemory::owner(LocalPtr addr) const
+{
+  if (!indexable(addr, 1)) return ambiguous();
+  if (root.empty()) return NULL;
+
+  const size_t granule = granuleOf(addr, GRANULE_BITS);
+  const Mid*   mid = root[granule >> (MID_BITS + LEAF_BITS)];
+
+  if (!mid) return NULL;
+
+  const Leaf*  leaf = mid->leaves[(granule >> LEAF_BITS) & ((size_t(1) << MID_BITS) - 1)];
+
+  if (!leaf) return NULL;
+
+  return leaf->owners[granule & ((size_t(1) << LEAF_BITS) - 1)];
+}
+
+void ShadowMemory::clear()
+{
+  for (size_t i = 0; i < root.size(); ++i)
+  {
+    Mid* mid = root[i];
+
+    if (!mid) continue;
+
+    for (size_t j = 0; j < (size_t(1) << MID_BITS); ++j)
+      delete mid->leaves[j];
+
+    delete mid;
+  }
+
+  root.clear();
+}
@@ -0,0 +1,115 @@
+// vim:et sta sw=4 ts=4
+#ifndef SHADOWMEMORY_H
+#define SHADOWMEMORY_H
+
+#include <vector>
+#include <climits>
+#include <cstddef>
+
+struct MemoryType;
+
+/**
+ * \class InitBitmap
+ * \brief One bit per byte of an allocation, set when the byte is initialized.
+ *
+ * Ranges are tested and set a word at a time, instead of one byte after the
+ * other as with std::vector<bool>.
+ */
+struct InitBitmap
+{
+        typedef unsigned long Word;
+
+        static const size_t WORDBITS = sizeof(Word) * CHAR_BIT;
+
+        explicit
+        InitBitmap(size_t sz = 0)
+        : bits(numWords(sz), 0), len(sz)
+        {}
+
+        size_t size() const { return len; }
+
+        /// Bits past the old size are not initialized
+        void resize(size_t sz);
+
+        bool operator[](size_t ofs) const
+        {
+          return (bits[ofs / WORDBITS] >> (ofs % WORDBITS)) & 1;
+        }
+
+        /// Tests if all bytes of [ofs, ofs+n) are initialized
+        bool allSet(size_t ofs, size_t n) const;
+
+        /// Marks [ofs, ofs+n) as initialized
+        /// returns true, iff some of the bytes were not initialized before
+        bool set(size_t ofs, size_t n);
+
+        /// Returns the number of initialized bytes
+        size_t count() const;
+
+    private:
+        static size_t numWords(size_t sz) { return (sz + WORDBITS - 1) / WORDBITS; }
+
+        std::vector<Word> bits;
+        size_t            len;
+};
+
+
+/**
+ * \class ShadowMemory
+ * \brief Direct-mapped index from local addresses to the allocations which contain them.
+ *
+ * Each 16-byte granule of the address space is mapped to the allocation it belongs to (a
+ * three level table, allocated lazily), so that the allocation containing an address is
+ * found in constant time instead of by a search in the ordered map of the MemoryManager.
+ * Granules shared by more than one allocation (e.g. small stack variables) are marked as
+ * ambiguous, lookups for them fall back to the ordered map.
+ */
+struct ShadowMemory
+{
+        typedef const char* LocalPtr;
+
+        ShadowMemory()
+        : root()
+        {}
+
+        ~ShadowMemory() { clear(); }
+
+        /// Returns true if the range [addr, addr+size) can be indexed
+        static bool indexable(LocalPtr addr, size_t size);
+
+        /// Maps the granules of [addr, addr+size) to mt
+        void insert(LocalPtr addr, size_t size, MemoryType* mt);
+
+        /// Removes the mapping of the granules of [addr, addr+size) to mt
+        void erase(LocalPtr addr, size_t size, const MemoryType* mt);
+
+        /// \brief  Returns the allocation which owns the granule of addr
+        /// \return NULL if no allocation is indexed at addr,
+        ///         ambiguous() if the granule is shared, or not indexable
+        MemoryType* owner(LocalPtr addr) const;
+
+        /// Marker for granules which must be looked up in the ordered map
+        static MemoryType* ambiguous() { return reinterpret_cast<MemoryType*>(1); }
+
+        /// Removes all mappings and frees the tables
+        void clear();
+
+    private:
+        static const size_t GRANULE_BITS = 4;
+        static const size_t LEAF_BITS    = 12;
+        static const size_t MID_BITS     = 16;
+        static const size_t ROOT_BITS    = 16;
+
+        struct Leaf { MemoryType* owners[1 << LEAF_BITS]; };
+        struct Mid  { Leaf*       leaves[1 << MID_BITS]; };
+
+        MemoryType*& entry(size_t granule);
+
+        // not copyable, the tables are owned
+        ShadowMemory(const ShadowMemory&);
+        ShadowMemory& operator=(const ShadowMemory&);
+
+        std::vector<Mid*> root;
+};
+
+#endif
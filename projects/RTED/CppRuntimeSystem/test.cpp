@@ -454,6 +454,46 @@ void testMemAccess()
     CLEANUP
 }
 
+void testShadowMemory()
+{
+    TEST_INIT("Testing memory access checks with the shadow memory");
+
+    MemoryManager& mm = rs.getMemManager();
+    mm.setShadowMemoryEnabled(true);
+
+    // 42 and 46 share a granule of the shadow memory
+    createMemory(rs, asAddr(42), 4);
+    createMemory(rs, asAddr(46), 100);
+
+    checkMemWrite(rs, asAddr(42), 4);
+    try { checkMemWrite(rs, asAddr(44), 4); }
+    TEST_CATCH(RuntimeViolation::INVALID_WRITE)
+
+    try { checkMemRead(rs, asAddr(60), 4); }
+    TEST_CATCH(RuntimeViolation::INVALID_READ)
+
+    checkMemWrite(rs, asAddr(46), 100);
+    checkMemRead(rs, asAddr(60), 86);
+
+    try { checkMemRead(rs, asAddr(146), 1); }
+    TEST_CATCH(RuntimeViolation::INVALID_READ)
+
+    freeMemory(rs, asAddr(42));
+
+    try { checkMemRead(rs, asAddr(42), 1); }
+    TEST_CATCH(RuntimeViolation::INVALID_READ)
+
+    checkMemRead(rs, asAddr(46), 1);
+    freeMemory(rs, asAddr(46));
+
+    try { checkMemRead(rs, asAddr(100), 1); }
+    TEST_CATCH(RuntimeViolation::INVALID_READ)
+
+    mm.setShadowMemoryEnabled(false);
+
+    CLEANUP
+}
+
 void testMallocDeleteCombinations()
 {
     TEST_INIT("Testing malloc/delete, new/free and similar combinations");
@@ -1612,6 +1652,7 @@ extern "C"
           testMemoryLeaks();
           testEmptyAllocation();
           testMemAccess();
+          testShadowMemory();
           testMallocDeleteCombinations();
   //~ //~
           testFileDoubleClose();
@@ -1,4 +1,12 @@
 #include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 
 // TraceId structure.
@@ -14,3 +22,123 @@ struct TraceId {
     }
 };
 
+// Trace files written by roseTraceLib.c start with this magic, followed by the varint encoded, zigzag mapped
+// differences between consecutive trace ids. Files without it are arrays of raw uint64_t trace ids (the format
+// of older traces).
+#define ROSE_TRACE_MAGIC "ROSETRC2"
+#define ROSE_TRACE_MAGIC_SIZE 8
+
+// TraceReader maps a trace file in memory and decodes its trace ids one after the other.
+class TraceReader {
+    int m_fd;
+    const unsigned char * m_begin;
+    const unsigned char * m_cur;
+    const unsigned char * m_end;
+    bool m_rawIds;
+    uint64_t m_lastId;
+
+    TraceReader(const TraceReader &);
+    TraceReader & operator=(const TraceReader &);
+
+public:
+    // Exits if the file can't be read.
+    TraceReader(const char * traceFile): m_fd(-1), m_begin(NULL), m_cur(NULL), m_end(NULL), m_rawIds(false), m_lastId(0){
+        struct stat st;
+        if((m_fd = open(traceFile, O_RDONLY)) < 0 || fstat(m_fd, &st)) {
+            fprintf(stderr, "\n Failed to read TraceFile %s", traceFile);
+            exit(-1);
+        }
+        if(st.st_size > 0) {
+            void * data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+            if(data == MAP_FAILED) {
+                fprintf(stderr, "\n Failed to map TraceFile %s", traceFile);
+                exit(-1);
+            }
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            m_begin = (const unsigned char *) data;
+            m_end = m_begin + st.st_size;
+        }
+        m_rawIds = !(m_end - m_begin >= ROSE_TRACE_MAGIC_SIZE && memcmp(m_begin, ROSE_TRACE_MAGIC, ROSE_TRACE_MAGIC_SIZE) == 0);
+        Rewind();
+    }
+
+    ~TraceReader(){
+        if(m_begin)
+            munmap((void *) m_begin, m_end - m_begin);
+        if(m_fd >= 0)
+            close(m_fd);
+    }
+
+    // Starts again from the first trace id.
+    void Rewind(){
+        m_cur = m_rawIds ? m_begin : m_begin + ROSE_TRACE_MAGIC_SIZE;
+        m_lastId = 0;
+    }
+
+    // Returns false at the end of the trace (a truncated last record is ignored).
+    bool Next(uint64_t & traceId){
+        if(m_rawIds) {
+            if(m_end - m_cur < (ptrdiff_t) sizeof(uint64_t))
+                return false;
+            memcpy(&traceId, m_cur, sizeof(uint64_t));
+            m_cur += sizeof(uint64_t);
+            return true;
+        }
+
+        uint64_t value = 0;
+        for(unsigned shift = 0; ; shift += 7) {
+            if(m_cur == m_end || shift > 63)
+                return false;
+            unsigned char byte = *m_cur++;
+            value |= uint64_t(byte & 0x7f) << shift;
+            if(!(byte & 0x80))
+                break;
+        }
+        m_lastId += (value >> 1) ^ (0 - (value & 1));
+        traceId = m_lastId;
+        return true;
+    }
+};
+
+// TraceWriter writes trace ids in the format of roseTraceLib.c.
+class TraceWriter {
+    FILE * m_fp;
+    uint64_t m_lastId;
+
+    TraceWriter(const TraceWriter &);
+    TraceWriter & operator=(const TraceWriter &);
+
+public:
+    // Exits if the file can't be written.
+    TraceWriter(const char * traceFile): m_lastId(0){
+        if(!(m_fp = fopen(traceFile, "wb")) || fwrite(ROSE_TRACE_MAGIC, ROSE_TRACE_MAGIC_SIZE, 1, m_fp) != 1) {
+            fprintf(stderr, "\n Failed to open output traceFile %s", traceFile);
+            exit(-1);
+        }
+    }
+
+    ~TraceWriter(){
+        if(fclose(m_fp)) {
+            fprintf(stderr, "\n Failed to close output traceFile");
+            exit(-1);
+        }
+    }
+
+    void Write(uint64_t traceId){
+        uint64_t delta = traceId - m_lastId;
+        uint64_t value = (delta << 1) ^ (uint64_t) ((int64_t) delta >> 63);
+        m_lastId = traceId;
+
+        unsigned char record[10];
+        size_t size = 0;
+        while(value >= 0x80) {
+            record[size++] = (unsigned char) (value | 0x80);
+            value >>= 7;
+        }
+        record[size++] = (unsigned char) value;
+        if(fwrite(record, size, 1, m_fp) != 1) {
+            fprintf(stderr, "\n Failed to write to output traceFile");
+            exit(-1);
+        }
+    }
+};
@@ -9,3 +9,4 @@ extern bool b_gen_mpi;
 extern bool b_enable_collapse;
 extern bool b_enable_polyopt;
 extern bool b_gen_vectorization;
+extern bool b_gen_openmp;
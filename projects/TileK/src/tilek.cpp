@@ -22,6 +22,8 @@
 #include "MFB/Sage/driver.hpp"
 #include "MFB/Sage/variable-declaration.hpp"
 
+#include <algorithm>
+
 namespace KLT {
 
 namespace MDCG {
@@ -72,6 +74,14 @@ SgExpression * SubkernelConfig< ::KLT::TileK::Generator>::createFieldInitializer
 int main(int argc, char ** argv) {
   std::vector<std::string> args(argv, argv + argc);
 
+  // '-tilek:autotune' generates tiling variants of each kernel, the runtime times them and keeps the fastest (see KLT/RTL/autotune.h)
+  bool autotuning = false;
+  std::vector<std::string>::iterator it_arg = std::find(args.begin(), args.end(), std::string("-tilek:autotune"));
+  if (it_arg != args.end()) {
+    autotuning = true;
+    args.erase(it_arg);
+  }
+
 #if defined(TILEK_ACCELERATOR)
 #  if defined(TILEK_TARGET_OPENCL)
   args.push_back("-DSKIP_OPENCL_SPECIFIC_DEFINITION");
@@ -88,6 +98,7 @@ int main(int argc, char ** argv) {
   std::string basename = filename.substr(0, filename.find_last_of('.'));
 
   KLT::DLX::Compiler< ::DLX::TileK::language_t, ::KLT::TileK::Generator> compiler(project, KLT_PATH, TILEK_PATH, basename);
+  compiler.setAutotuning(autotuning);
 
 //  MFB::api_t * api = compiler.getDriver().getAPI();
 //  dump_api(api);
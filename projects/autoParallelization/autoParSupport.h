@@ -42,6 +42,8 @@ namespace AutoParallelization
   extern bool enable_diff; // an option to compare user-defined OpenMP pragmas to compiler generated ones.
   extern bool b_unique_indirect_index; // assume all arrays used as indirect indices has unique elements(no overlapping)
   extern bool enable_distance; // print out absolute dependence distance for a dependence relation preventing from parallelization
+  extern bool enable_cost_model; // choose the loop level, collapse and schedule clauses by a cost model, skipping unprofitable loops
+  extern int min_parallel_work; // the minimum estimated work (in operations) of a loop worth parallelizing under the cost model
 
   extern bool keep_c99_loop_init; // avoid normalize C99 style loop init statement: for (int i=0; ...)
   // Conduct necessary analyses on the project, can be called multiple times during program transformations. 
@@ -87,6 +89,16 @@ namespace AutoParallelization
   //Generate and insert OpenMP pragmas according to OmpAttribute
   void generatedOpenMPPragmas(SgNode* node);
 #endif
+  //! Estimate the trip count of a canonical loop. Non-constant bounds are followed through variables initialized with a constant and never modified afterwards. 
+  //! A default estimate is used if the bounds are still unknown, and isConstant is set to false.
+  long EstimateTripCount(SgForStatement* loop, bool* isConstant=NULL);
+
+  //! Estimate the work of a statement or expression in operations, with the work of nested loops multiplied by their estimated trip counts
+  double EstimateWork(SgNode* node);
+
+  //! Decide whether a parallelizable loop is worth parallelizing, and choose its collapse and schedule clauses in the attribute, return false if it is not profitable
+  bool ApplyCostModel(SgForStatement* loop, OmpSupport::OmpAttribute* attribute, ArrayInterface* array_interface, ArrayAnnotation* annot);
+
   //Parallelize an input loop at its outermost loop level, return true if successful
   bool ParallelizeOutermostLoop(SgNode* loop, ArrayInterface* array_interface, ArrayAnnotation* annot);
 
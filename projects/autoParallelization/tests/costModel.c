@@ -0,0 +1,23 @@
+/* Loops handled by the cost model (-rose:autopar:cost_model)
+ */
+#define N 1000
+double a[N][N], b[N][N], c[16][N];
+
+void foo()
+{
+  int i, j, k;
+  /* only the inner loop can be parallelized, but it is too small */
+  for (i = 1; i < N; i++)
+    for (j = 0; j < 8; j++)
+      a[i][j] = a[i-1][j] + 1.0;
+
+  /* triangular: dynamic schedule */
+  for (i = 0; i < N; i++)
+    for (j = 0; j <= i; j++)
+      a[i][j] = b[i][j] * 2.0;
+
+  /* few outer iterations: collapse(2) */
+  for (k = 0; k < 16; k++)
+    for (j = 0; j < N; j++)
+      c[k][j] = c[k][j] + b[k][j];
+}
@@ -45,6 +45,20 @@ namespace CommaOperator
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each comma operator.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -85,34 +99,38 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::commaOperatorChecker->checkerName,
                           ::commaOperatorChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::CommaOperator::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::CommaOperator::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_comma;
-      MatchResult results_comma = match_comma.performMatching("$r = SgCommaOpExp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, results_comma)
-	{
-	  SgCommaOpExp* op = (SgCommaOpExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::CommaOperator::CheckerOutput(op));
-	}
-      
   }
 
-// Remove this function if your checker is not an AST traversal
+void
+CompassAnalyses::CommaOperator::
+Traversal::visit(SgNode* node)
+  {
+      if (SgCommaOpExp* op = isSgCommaOpExp(node))
+        {
+          output->addOutput(new CompassAnalyses::CommaOperator::CheckerOutput(op));
+        }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::CommaOperator::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::CommaOperator::Traversal(params, output);
   }
 
 extern const Compass::Checker* const commaOperatorChecker =
@@ -45,6 +45,20 @@ namespace DangerousOverload
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each overload of &, &&, || and the comma operator.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -85,24 +99,23 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::dangerousOverloadChecker->checkerName,
                           ::dangerousOverloadChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::DangerousOverload::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::DangerousOverload::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_member;
-      MatchResult func_matches = match_member.performMatching("$r = SgMemberFunctionDeclaration", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, func_matches)
+  }
+
+void
+CompassAnalyses::DangerousOverload::
+Traversal::visit(SgNode* node)
+  {
+      if (SgMemberFunctionDeclaration* decl = isSgMemberFunctionDeclaration(node))
         {
-          SgMemberFunctionDeclaration* decl = (SgMemberFunctionDeclaration*)match["$r"];
           string name = decl->get_name().getString();
           if (name == "operator&" || name == "operator&&" || name == "operator||" || name == "operator,")
             {
@@ -111,11 +124,17 @@ run(Compass::Parameters parameters, Compass::OutputObject* output)
         }
   }
 
-// Remove this function if your checker is not an AST traversal
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::DangerousOverload::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DangerousOverload::Traversal(params, output);
   }
 
 extern const Compass::Checker* const dangerousOverloadChecker =
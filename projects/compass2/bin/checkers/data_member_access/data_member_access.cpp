@@ -45,6 +45,20 @@ namespace DataMemberAccess
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each class with both public and non-public data members.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -85,54 +99,59 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::dataMemberAccessChecker->checkerName,
                           ::dataMemberAccessChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::DataMemberAccess::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::DataMemberAccess::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_classes;
-      MatchResult result_classes = match_classes.performMatching("$r = SgClassDefinition", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_classes)
-	{
-	  SgClassDefinition* classdef = (SgClassDefinition*)match["$r"];
-	  int pub, prot, priv;
-	  pub = prot = priv = 0;
-	  SgDeclarationStatementPtrList members = classdef->get_members();
-	  SgDeclarationStatementPtrList::iterator member;
-	  for (member = members.begin(); member != members.end(); ++member)
-	    {
-	      SgVariableDeclaration* vardecl = isSgVariableDeclaration(*member);
-	      if (vardecl != NULL)
-		{
-		  SgAccessModifier &mod = vardecl->get_declarationModifier().get_accessModifier();
-		  if (mod.isPublic())
-		    ++pub;
-		  else if (mod.isProtected())
-		    ++prot;
-		  else if (mod.isPrivate())
-		    ++priv;
-		}
-	    }
-	  if (pub != 0 && prot + priv != 0)
-	    {
-	      output->addOutput(new CompassAnalyses::DataMemberAccess::CheckerOutput(classdef));
-	    }
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
+void
+CompassAnalyses::DataMemberAccess::
+Traversal::visit(SgNode* node)
+  {
+      SgClassDefinition* classdef = isSgClassDefinition(node);
+      if (classdef == NULL)
+        return;
+      int pub, prot, priv;
+      pub = prot = priv = 0;
+      SgDeclarationStatementPtrList& members = classdef->get_members();
+      SgDeclarationStatementPtrList::iterator member;
+      for (member = members.begin(); member != members.end(); ++member)
+        {
+          SgVariableDeclaration* vardecl = isSgVariableDeclaration(*member);
+          if (vardecl != NULL)
+            {
+              SgAccessModifier &mod = vardecl->get_declarationModifier().get_accessModifier();
+              if (mod.isPublic())
+                ++pub;
+              else if (mod.isProtected())
+                ++prot;
+              else if (mod.isPrivate())
+                ++priv;
+            }
+        }
+      if (pub != 0 && prot + priv != 0)
+        {
+          output->addOutput(new CompassAnalyses::DataMemberAccess::CheckerOutput(classdef));
+        }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::DataMemberAccess::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DataMemberAccess::Traversal(params, output);
   }
 
 extern const Compass::Checker* const dataMemberAccessChecker =
@@ -45,6 +45,20 @@ namespace DiscardAssignment
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each assignment whose value is used.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -85,36 +99,39 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::discardAssignmentChecker->checkerName,
                           ::discardAssignmentChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::DiscardAssignment::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::DiscardAssignment::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_assign;
-      MatchResult result_assign = match_assign.performMatching("$r = SgAssignOp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_assign)
-	{
-	  SgAssignOp* op = (SgAssignOp*)match["$r"];
-	  if (!isSgExprStatement(op->get_parent()))
-	    {
-	      output->addOutput(new CompassAnalyses::DiscardAssignment::CheckerOutput(op));
-	    }
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
+void
+CompassAnalyses::DiscardAssignment::
+Traversal::visit(SgNode* node)
+  {
+      SgAssignOp* op = isSgAssignOp(node);
+      if (op != NULL && !isSgExprStatement(op->get_parent()))
+        {
+          output->addOutput(new CompassAnalyses::DiscardAssignment::CheckerOutput(op));
+        }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::DiscardAssignment::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DiscardAssignment::Traversal(params, output);
   }
 
 extern const Compass::Checker* const discardAssignmentChecker =
@@ -45,6 +45,20 @@ namespace DoNotDeleteThis
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each deletion of this.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -85,33 +99,39 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::doNotDeleteThisChecker->checkerName,
                           ::doNotDeleteThisChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::DoNotDeleteThis::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::DoNotDeleteThis::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_del_this;
-      MatchResult result_del_this = match_del_this.performMatching("$r = SgDeleteExp(SgThisExp)", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_del_this)
-	{
-	  SgDeleteExp* del = (SgDeleteExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::DoNotDeleteThis::CheckerOutput(del));
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
+void
+CompassAnalyses::DoNotDeleteThis::
+Traversal::visit(SgNode* node)
+  {
+      SgDeleteExp* del = isSgDeleteExp(node);
+      if (del != NULL && isSgThisExp(del->get_variable()))
+        {
+          output->addOutput(new CompassAnalyses::DoNotDeleteThis::CheckerOutput(del));
+        }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::DoNotDeleteThis::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DoNotDeleteThis::Traversal(params, output);
   }
 
 extern const Compass::Checker* const doNotDeleteThisChecker =
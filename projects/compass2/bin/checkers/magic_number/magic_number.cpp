@@ -48,6 +48,22 @@ namespace MagicNumber
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each integer or floating point literal that is not an allowed magic number.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+    // the allowed magic numbers
+    std::map<string, string> magic_;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -88,11 +104,10 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::magicNumberChecker->checkerName,
                           ::magicNumberChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::MagicNumber::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
-    typedef std::map<string, string> ExpectedValuesMap;
-    ExpectedValuesMap magic_;
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
@@ -101,47 +116,49 @@ run(Compass::Parameters parameters, Compass::OutputObject* output)
 
       Compass::ParametersMap things = parameters[boost::regex("^magicNumbers::.*$")];
       BOOST_FOREACH(const Compass::ParametersMap::value_type& pair, things)
-	{
-	  Compass::ParameterValues values = pair.second;
-	  BOOST_FOREACH(string keyword, values)
-	    {
-	      magic_[keyword] = keyword;
-	    }
-	}
-
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_val_exps;
-      MatchResult val_exps_result = match_val_exps.performMatching("$r = SgIntVal | $r = SgDoubleVal", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, val_exps_result)
-	{
-	  SgValueExp* val = (SgValueExp*)match["$r"];
-	  if (val->get_originalExpressionTree() == NULL)
-	    {
-	      SgNode* p = val->get_parent();
-	      while (isSgExpression(p) && !isSgInitializer(p))
-		{
-		  p = p->get_parent();
-		}
-	      if (!isSgInitializer(p) || isSgConstructorInitializer(p))
-		{
-		  string number = val->get_constant_folded_value_as_string();
-		  if (magic_[number] == "")
-		    {
-		      output->addOutput(new CompassAnalyses::MagicNumber::CheckerOutput(val));
-		    }
-		}
-	    }
-	}
+        {
+          Compass::ParameterValues values = pair.second;
+          BOOST_FOREACH(string keyword, values)
+            {
+              magic_[keyword] = keyword;
+            }
+        }
+  }
+
+void
+CompassAnalyses::MagicNumber::
+Traversal::visit(SgNode* node)
+  {
+      SgValueExp* val = isSgIntVal(node) ? (SgValueExp*)isSgIntVal(node) : (SgValueExp*)isSgDoubleVal(node);
+      if (val != NULL && val->get_originalExpressionTree() == NULL)
+        {
+          SgNode* p = val->get_parent();
+          while (isSgExpression(p) && !isSgInitializer(p))
+            {
+              p = p->get_parent();
+            }
+          if (!isSgInitializer(p) || isSgConstructorInitializer(p))
+            {
+              string number = val->get_constant_folded_value_as_string();
+              if (magic_[number] == "")
+                {
+                  output->addOutput(new CompassAnalyses::MagicNumber::CheckerOutput(val));
+                }
+            }
+        }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::MagicNumber::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::MagicNumber::Traversal(params, output);
   }
 
 extern const Compass::Checker* const magicNumberChecker =
@@ -42,6 +42,20 @@ class CheckerOutput: public Compass::OutputViolationBase {
   DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
 };
 
+/**
+ * \brief Reports each goto statement.
+ */
+class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+ public:
+  Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+  // Traverse the subtree of node
+  void run(SgNode* node) { this->traverse(node, preorder); }
+  void visit(SgNode* node);
+
+ private:
+  Compass::OutputObject* output;
+};
+
 bool IsNodeNotInUserLocation(const SgNode* node)
 {
   const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -82,35 +96,39 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                       ::noGotoChecker->checkerName,
                        ::noGotoChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
-{
-  // We only care about source code in the user's space, not,
-  // for example, Boost or system files.
-  string target_directory =
-      parameters["general::target_directory"].front();
-  CompassAnalyses::NoGoto::source_directory.assign(target_directory);
-
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode* root_node = (SgNode*) sageProject;
-
-
+CompassAnalyses::NoGoto::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
+  {
+      // We only care about source code in the user's space, not,
+      // for example, Boost or system files.
+      string target_directory =
+          parameters["general::target_directory"].front();
+      CompassAnalyses::NoGoto::source_directory.assign(target_directory);
+  }
 
-  // search for SgGotoStatements
-  AstMatching matcher;
-  MatchResult matches = matcher
-      .performMatching("$r = SgGotoStatement", root_node);
+void
+CompassAnalyses::NoGoto::
+Traversal::visit(SgNode* node)
+  {
+      if (SgGotoStatement* goto_statement = isSgGotoStatement(node))
+        {
+          output->addOutput(new CompassAnalyses::NoGoto::CheckerOutput(goto_statement));
+        }
+  }
 
-  BOOST_FOREACH(SingleMatchVarBindings match, matches)
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-    SgGotoStatement *goto_statement = (SgGotoStatement *)match["$r"];
-    output->addOutput(
-        new CompassAnalyses::NoGoto::
-        CheckerOutput(goto_statement));
+      CompassAnalyses::NoGoto::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
   }
 
-}
+static Compass::AstSimpleProcessingWithRunFunction*
+createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+  {
+    return new CompassAnalyses::NoGoto::Traversal(params, output);
+  }
 
 extern const Compass::Checker* const noGotoChecker =
     new Compass::CheckerUsingAstSimpleProcessing(
@@ -121,5 +139,5 @@ extern const Compass::Checker* const noGotoChecker =
         Compass::C | Compass::Cpp,
         Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
         run,
-        NULL);
+        createTraversal);
 
@@ -43,6 +43,20 @@ namespace CompassAnalyses
       DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
     };
 
+    /**
+     * \brief Reports each reference to a function whose name contains rand.
+     */
+    class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+     public:
+      Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+      // Traverse the subtree of node
+      void run(SgNode* node) { this->traverse(node, preorder); }
+      void visit(SgNode* node);
+
+     private:
+      Compass::OutputObject* output;
+    };
+
     bool IsNodeNotInUserLocation(const SgNode* node)
     {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -83,38 +97,44 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                       ::noRandChecker->checkerName,
                        ::noRandChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
-{
-  // We only care about source code in the user's space, not,
-  // for example, Boost or system files.
-  string target_directory =
-      parameters["general::target_directory"].front();
-  CompassAnalyses::NoRand::source_directory.assign(target_directory);
-
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode* root_node = (SgNode*) sageProject;
-
-  // perform AST matching
-  AstMatching matcher;
-
-  MatchResult matches = matcher.performMatching("$r=SgFunctionRefExp",
-                                                root_node);
+CompassAnalyses::NoRand::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
+  {
+      // We only care about source code in the user's space, not,
+      // for example, Boost or system files.
+      string target_directory =
+          parameters["general::target_directory"].front();
+      CompassAnalyses::NoRand::source_directory.assign(target_directory);
+  }
 
-  BOOST_FOREACH(SingleMatchVarBindings match, matches)
+void
+CompassAnalyses::NoRand::
+Traversal::visit(SgNode* node)
   {
-    SgFunctionRefExp *function = (SgFunctionRefExp *)match["$r"];
-    std::string fncName = function->get_symbol()->get_name().getString();
+      SgFunctionRefExp* function = isSgFunctionRefExp(node);
+      if (function != NULL)
+        {
+          std::string fncName = function->get_symbol()->get_name().getString();
+          if (fncName.find("rand", 0, 4) != std::string::npos)
+            {
+              output->addOutput(new CompassAnalyses::NoRand::CheckerOutput(function));
+            }
+        }
+  }
 
-    if( fncName.find( "rand", 0, 4) != std::string::npos)
-    {
-      output->addOutput(
-          new CompassAnalyses::NoRand::CheckerOutput(function));
-    }
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::NoRand::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
   }
-}
 
+static Compass::AstSimpleProcessingWithRunFunction*
+createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+  {
+    return new CompassAnalyses::NoRand::Traversal(params, output);
+  }
 
 extern const Compass::Checker* const noRandChecker =
     new Compass::CheckerUsingAstSimpleProcessing(
@@ -125,5 +145,5 @@ extern const Compass::Checker* const noRandChecker =
         Compass::C | Compass::Cpp,
         Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
         run,
-        NULL);
+        createTraversal);
 
@@ -48,6 +48,20 @@ namespace NoVfork
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each reference to vfork.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -88,42 +102,39 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::noVforkChecker->checkerName,
                           ::noVforkChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::NoVfork::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::NoVfork::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      SgNode *root_node = (SgNode*)sageProject;
-
-      AstMatching func_ref_matcher;
-      MatchResult func_ref_matches = func_ref_matcher
-          .performMatching("$f=SgFunctionRefExp", root_node);
-      BOOST_FOREACH(SingleMatchVarBindings match, func_ref_matches)
-      {
-        SgFunctionRefExp *func_ref = (SgFunctionRefExp *)match["$f"];
-        std::string func_str = func_ref->get_symbol()->get_name().getString();
-        if(func_str.compare("vfork") == 0)
+  }
+
+void
+CompassAnalyses::NoVfork::
+Traversal::visit(SgNode* node)
+  {
+      SgFunctionRefExp* func_ref = isSgFunctionRefExp(node);
+      if (func_ref != NULL && func_ref->get_symbol()->get_name().getString() == "vfork")
         {
-          output->addOutput(
-              new CompassAnalyses::NoVfork::
-              CheckerOutput(func_ref));
+          output->addOutput(new CompassAnalyses::NoVfork::CheckerOutput(func_ref));
         }
-      }
-      
   }
 
-// Remove this function if your checker is not an AST traversal
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::NoVfork::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::NoVfork::Traversal(params, output);
   }
 
 extern const Compass::Checker* const noVforkChecker =
@@ -45,6 +45,20 @@ namespace SizeOfPointer
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each sizeof of a pointer variable.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -85,34 +99,40 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::sizeOfPointerChecker->checkerName,
                           ::sizeOfPointerChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::SizeOfPointer::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::SizeOfPointer::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_sizeof;
-      MatchResult result_sizeof = match_sizeof.performMatching("SgSizeOfOp($r=SgVarRefExp)", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_sizeof)
-	{
-	  SgVarRefExp* var_ref = (SgVarRefExp*)match["$r"];
-	  if(isSgPointerType(var_ref->get_type()))
-	    output->addOutput(new CompassAnalyses::SizeOfPointer::CheckerOutput(var_ref));
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
+void
+CompassAnalyses::SizeOfPointer::
+Traversal::visit(SgNode* node)
+  {
+      SgSizeOfOp* op = isSgSizeOfOp(node);
+      SgVarRefExp* var_ref = op != NULL ? isSgVarRefExp(op->get_operand_expr()) : NULL;
+      if (var_ref != NULL && isSgPointerType(var_ref->get_type()))
+        {
+          output->addOutput(new CompassAnalyses::SizeOfPointer::CheckerOutput(var_ref));
+        }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::SizeOfPointer::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::SizeOfPointer::Traversal(params, output);
   }
 
 extern const Compass::Checker* const sizeOfPointerChecker =
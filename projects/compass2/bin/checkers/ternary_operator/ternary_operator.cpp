@@ -45,6 +45,20 @@ namespace TernaryOperator
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each conditional expression.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -85,33 +99,38 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::ternaryOperatorChecker->checkerName,
                           ::ternaryOperatorChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::TernaryOperator::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::TernaryOperator::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_ternary;
-      MatchResult result_ternary = match_ternary.performMatching("$r = SgConditionalExp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_ternary)
-	{
-	  SgConditionalExp* tri = (SgConditionalExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::TernaryOperator::CheckerOutput(tri));
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
+void
+CompassAnalyses::TernaryOperator::
+Traversal::visit(SgNode* node)
+  {
+      if (SgConditionalExp* tri = isSgConditionalExp(node))
+        {
+          output->addOutput(new CompassAnalyses::TernaryOperator::CheckerOutput(tri));
+        }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::TernaryOperator::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::TernaryOperator::Traversal(params, output);
   }
 
 extern const Compass::Checker* const ternaryOperatorChecker =
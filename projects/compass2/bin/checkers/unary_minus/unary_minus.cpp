@@ -45,6 +45,20 @@ namespace UnaryMinus
     DISALLOW_COPY_AND_ASSIGN(CheckerOutput);
   };
 
+  /**
+   * \brief Reports each negation of an unsigned variable.
+   */
+  class Traversal: public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters parameters, Compass::OutputObject* output);
+    // Traverse the subtree of node
+    void run(SgNode* node) { this->traverse(node, preorder); }
+    void visit(SgNode* node);
+
+   private:
+    Compass::OutputObject* output;
+  };
+
   bool IsNodeNotInUserLocation(const SgNode* node)
   {
       const SgLocatedNode* located_node = isSgLocatedNode(node);
@@ -85,39 +99,45 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::unaryMinusChecker->checkerName,
                           ::unaryMinusChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::UnaryMinus::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output(output)
   {
       // We only care about source code in the user's space, not,
       // for example, Boost or system files.
       string target_directory =
           parameters["general::target_directory"].front();
       CompassAnalyses::UnaryMinus::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_var;
-      MatchResult result_var = match_var.performMatching
-	("SgMinusOp($r=SgVarRefExp)\
-        | SgMinusOp(SgCastExp($r=SgVarRefExp))"\
-        , sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_var)
-	{
-	  SgVarRefExp* var = (SgVarRefExp*)match["$r"];
-	  if (var->get_type()->isUnsignedType())
-	    {
-	      output->addOutput(new CompassAnalyses::UnaryMinus::CheckerOutput(var));
-	    }
-	}
   }
 
-// Remove this function if your checker is not an AST traversal
+void
+CompassAnalyses::UnaryMinus::
+Traversal::visit(SgNode* node)
+  {
+      SgMinusOp* op = isSgMinusOp(node);
+      if (op == NULL)
+        return;
+      SgExpression* operand = op->get_operand();
+      if (SgCastExp* cast = isSgCastExp(operand))
+        operand = cast->get_operand();
+      SgVarRefExp* var = isSgVarRefExp(operand);
+      if (var != NULL && var->get_type()->isUnsignedType())
+        {
+          output->addOutput(new CompassAnalyses::UnaryMinus::CheckerOutput(var));
+        }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+      CompassAnalyses::UnaryMinus::Traversal(parameters, output)
+          .run(Compass::projectPrerequisite.getProject());
+  }
+
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::UnaryMinus::Traversal(params, output);
   }
 
 extern const Compass::Checker* const unaryMinusChecker =
@@ -86,6 +86,10 @@ int main (int argc, char** argv)
         CommandlineProcessing::generateArgListFromArgcArgv (argc, argv);
     Compass::commandLineProcessing (cli_args);
 
+    // -compass:processes <n> distributes the files over n worker processes
+    int number_of_processes = 1;
+    CommandlineProcessing::isOptionWithParameter (cli_args, "-compass:", "processes", number_of_processes, true);
+
     // -------------------------------------------------------------------------
     //  Compass parameters
     // -------------------------------------------------------------------------
@@ -235,8 +239,37 @@ int main (int argc, char** argv)
     // -------------------------------------------------------------------------
 
     std::vector<std::pair<std::string, std::string> > errors;
-    for (std::vector<const Compass::Checker*>::iterator itr = traversals.begin();
-         itr != traversals.end();
+
+    // Checkers that provide an AST traversal share one traversal per file;
+    // the remaining checkers are run one after the other.
+    std::vector<const Compass::Checker*> remaining;
+    try
+    {
+        if (SgProject::get_verbose () >= 0)
+        {
+            std::cout
+              << "[Compass] [Main] "
+              << "Running combined checker traversals"
+              << std::endl;
+        }
+        Compass::runCombinedTraversals (traversals, params, &output, project, remaining, number_of_processes);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr
+          << "[Compass] [Main] "
+          << "error running combined checker traversals"
+          << " - reason: "
+          << e.what()
+          << std::endl;
+
+        errors.push_back(
+          std::make_pair(std::string("combined traversals"),
+          std::string(e.what())));
+    }
+
+    for (std::vector<const Compass::Checker*>::iterator itr = remaining.begin();
+         itr != remaining.end();
          ++itr)
     {
         if (*itr == NULL)
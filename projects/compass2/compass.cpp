@@ -10,9 +10,14 @@
 /*-----------------------------------------------------------------------------
  * C/C++ system includes
  **--------------------------------------------------------------------------*/
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include <vector>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 /*-----------------------------------------------------------------------------
  * Library includes
@@ -230,13 +235,21 @@ Compass::PrintingOutputObject::addOutput(Compass::OutputViolationBase* theOutput
     }
 
   // printf ("skipOutput = %s \n",skipOutput ? "true" : "false");
-  if (skipOutput == false)
+  if (skipOutput == false && print(theOutput->getString()))
     {
       outputList.push_back(theOutput);
-      stream << theOutput->getString() << std::endl;
     }
 }
 
+bool
+Compass::PrintingOutputObject::print(const std::string& message)
+{
+  if (!printed.insert(message).second)
+    return false;
+  *stream << message << std::endl;
+  return true;
+}
+
 
 
 void
@@ -309,6 +322,155 @@ void Compass::runCheckerAndPrereqs(const Checker* checker, SgProject* proj, Para
   checker->run(params, output);
 }
 
+// Write all of data to a file descriptor
+static bool writeAll(int fd, const std::string& data) {
+  size_t written = 0;
+  while (written < data.size()) {
+    ssize_t n = write(fd, data.data() + written, data.size() - written);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    written += n;
+  }
+  return true;
+}
+
+// Traverse files first, first+stride, ... of the project. If messages is set, the messages collected in it are written to fd
+// after each file.
+static void traverseFiles(AstCombinedSimpleProcessing& combined, SgProject* proj, int first, int stride,
+                          std::ostringstream* messages, int fd) {
+  for (int i = first; i < proj->numberOfFiles(); i += stride) {
+    combined.traverse(&proj->get_file(i), preorder);
+    if (messages != NULL) {
+      if (!writeAll(fd, messages->str()))
+        _exit(1);
+      messages->str("");
+    }
+  }
+}
+
+// Distribute the files over worker processes, print their messages as they arrive, and traverse the files of failed
+// workers here.
+static void traverseFilesInProcesses(AstCombinedSimpleProcessing& combined, SgProject* proj,
+                                     PrintingOutputObject* output, int numberOfProcesses) {
+  int numberOfWorkers = std::min(numberOfProcesses, proj->numberOfFiles());
+  std::vector<pid_t> workers;
+  std::vector<struct pollfd> pipes;
+  std::cout.flush();
+  std::cerr.flush();
+  for (int w = 0; w < numberOfWorkers; ++w) {
+    int fd[2];
+    if (pipe(fd) != 0)
+      break;
+    pid_t pid = fork();
+    if (pid < 0) {
+      close(fd[0]);
+      close(fd[1]);
+      break;
+    }
+    if (pid == 0) {
+      close(fd[0]);
+      std::ostringstream messages;
+      output->setStream(messages);
+      int status = 0;
+      try {
+        traverseFiles(combined, proj, w, numberOfWorkers, &messages, fd[1]);
+      } catch (const std::exception& e) {
+        std::cerr << "[Compass] [Main] error in worker " << w << ": " << e.what() << std::endl;
+        status = 1;
+      }
+      close(fd[1]);
+      _exit(status);
+    }
+    close(fd[1]);
+    workers.push_back(pid);
+    struct pollfd p;
+    p.fd = fd[0];
+    p.events = POLLIN;
+    p.revents = 0;
+    pipes.push_back(p);
+  }
+
+  // Print complete lines as they arrive
+  std::vector<std::string> partial(pipes.size());
+  size_t open = pipes.size();
+  while (open > 0) {
+    if (poll(&pipes[0], pipes.size(), -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+    for (size_t w = 0; w < pipes.size(); ++w) {
+      if (pipes[w].fd < 0 || pipes[w].revents == 0)
+        continue;
+      char buffer[4096];
+      ssize_t n = read(pipes[w].fd, buffer, sizeof buffer);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0) {
+        close(pipes[w].fd);
+        pipes[w].fd = -1;
+        --open;
+        continue;
+      }
+      partial[w].append(buffer, n);
+      size_t start = 0, end;
+      while ((end = partial[w].find('\n', start)) != std::string::npos) {
+        output->print(partial[w].substr(start, end - start));
+        start = end + 1;
+      }
+      partial[w].erase(0, start);
+    }
+  }
+  for (size_t w = 0; w < pipes.size(); ++w) {
+    if (pipes[w].fd >= 0)
+      close(pipes[w].fd);
+  }
+
+  // Messages already printed by a failed worker are not printed again
+  for (int w = 0; w < numberOfWorkers; ++w) {
+    int status = 0;
+    bool succeeded = w < (int)workers.size() && waitpid(workers[w], &status, 0) == workers[w] &&
+                     WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (!succeeded)
+      traverseFiles(combined, proj, w, numberOfWorkers, NULL, -1);
+  }
+}
+
+void Compass::runCombinedTraversals(const std::vector<const Checker*>& checkers, Parameters params,
+                                    PrintingOutputObject* output, SgProject* proj,
+                                    std::vector<const Checker*>& remaining, int numberOfProcesses) {
+  AstCombinedSimpleProcessing combined;
+  remaining.clear();
+  for (size_t i = 0; i < checkers.size(); ++i) {
+    const CheckerUsingAstSimpleProcessing* astChecker = dynamic_cast<const CheckerUsingAstSimpleProcessing*>(checkers[i]);
+    AstSimpleProcessingWithRunFunction* traversal = NULL;
+    if (astChecker != NULL && astChecker->createSimpleTraversal)
+      traversal = astChecker->createSimpleTraversal(params, output);
+    if (traversal != NULL)
+      combined.addTraversal(traversal);
+    else
+      remaining.push_back(checkers[i]);
+  }
+
+  AstCombinedSimpleProcessing::TraversalPtrList& traversals = combined.get_traversalPtrListRef();
+  if (!traversals.empty()) {
+    try {
+      if (numberOfProcesses > 1 && proj->numberOfFiles() > 1)
+        traverseFilesInProcesses(combined, proj, output, numberOfProcesses);
+      else
+        traverseFiles(combined, proj, 0, 1, NULL, -1);
+    } catch (...) {
+      for (size_t i = 0; i < traversals.size(); ++i)
+        delete traversals[i];
+      throw;
+    }
+  }
+  for (size_t i = 0; i < traversals.size(); ++i)
+    delete traversals[i];
+}
+
 namespace Compass
 {
 
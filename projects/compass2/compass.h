@@ -12,6 +12,7 @@
 #include <sys/stat.h>
 #include <errno.h>
 #include <memory>   // std::auto_ptr
+#include <set>
 
 /*-----------------------------------------------------------------------------
  * Library includes
@@ -742,19 +743,28 @@ namespace Xml
         std::vector<OutputViolationBase*> outputList;
     };// end OutputObject class
 
-  /** A simple output object which just prints each error message
+  /** A simple output object which just prints each error message, once:
+    * a violation that is reported again (e.g. in a header file shared by
+    * several source files) is not printed again.
     */
   class PrintingOutputObject: public OutputObject
     {
       public:
         PrintingOutputObject (std::ostream& stream)
-          : stream (stream)
+          : stream (&stream)
         {}
 
         virtual void addOutput (OutputViolationBase* theOutput);
 
+        //! Print a message unless it has been printed before; returns whether it was printed
+        bool print (const std::string& message);
+
+        //! Print the following messages to another stream
+        void setStream (std::ostream& newStream) { stream = &newStream; }
+
       private:
-        std::ostream& stream;
+        std::ostream* stream;
+        std::set<std::string> printed;
     };// end PrintingOutputObject class
 
   /** \brief Format file info according to the GNU standard.
@@ -943,7 +953,10 @@ namespace Xml
 
 
   /** A checker that supports combining with other instances of
-    * AstSimpleProcessing
+    * AstSimpleProcessing. The createSimpleTraversal function of a checker
+    * returns a new instance of its traversal, which runCombinedTraversals()
+    * combines with the traversals of the other checkers so that each file is
+    * traversed once for all of them.
     */
   class CheckerUsingAstSimpleProcessing: public Checker
     {
@@ -1055,6 +1068,21 @@ namespace Xml
 
   //! Run a checker and its prerequisites
   void runCheckerAndPrereqs (const Checker* checker, SgProject* proj, Parameters params, OutputObject* output);
+
+  /** Run the checkers that provide a traversal (see CheckerUsingAstSimpleProcessing)
+    * in a single combined traversal of each file of the project, instead of
+    * one traversal per checker. With more than one process, the files are
+    * distributed over that many worker processes forked from this one, which
+    * send the messages of each file to this process as soon as the file is
+    * done. A file whose worker fails is traversed again by this process.
+    *
+    * The checkers that do not provide a traversal are returned in remaining,
+    * for the caller to run. The prerequisites of all checkers must have been
+    * run.
+    */
+  void runCombinedTraversals (const std::vector<const Checker*>& checkers, Parameters params,
+                              PrintingOutputObject* output, SgProject* proj,
+                              std::vector<const Checker*>& remaining, int numberOfProcesses = 1);
   /**--------------------------------------------------------------------
    *
    * End of Checkers group
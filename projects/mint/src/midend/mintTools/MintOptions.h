@@ -43,9 +43,11 @@ class MintOptions
   bool useSameIndex();
   bool isL1Preferred();
   bool isSwapOpt();//not being used
+  bool isPlannerOpt();
 
   std::vector<std::string>::const_iterator GetOptionPosition( const std::string& opt); 
 
   static int getNumberOfSharedMemPlanes();
+  static int getDeviceComputeCapability();
 };
 
@@ -43,7 +43,8 @@ public:
 			       std::set<SgInitializedName*> readOnlyVars,
 			       const MintArrFreqPairList_t& candidateVarsShared,
 			       const MintArrFreqPairList_t& candidateVarsReg,
-			       const bool optUnrollZ) ;
+			       const bool optUnrollZ,
+			       const bool optShared) ;
 
 
   static void findCandidateVarForSharedMem(MintInitNameMapExpList_t arrRefList,
@@ -0,0 +1,81 @@
+/*
+ * OnChipMemoryPlanner.h
+ *
+ * Chooses the on-chip memory optimization of a stencil kernel
+ * (shared memory tiling, register blocking along z or the read-only
+ * data cache) from its stencil footprint and the device parameters.
+ */
+
+#ifndef ONCHIPMEMORYPLANNER_H_
+#define ONCHIPMEMORYPLANNER_H_
+
+#include "rose.h"
+#include "../../types/MintTypes.h"
+#include <set>
+#include <string>
+
+using namespace SageBuilder;
+using namespace SageInterface;
+using namespace std;
+
+//on-chip memory strategies, -opt:planner picks one of them for each kernel
+typedef enum {
+  MINT_PLAN_GLOBAL,      //no on-chip memory opt
+  MINT_PLAN_SHARED,      //2D tiles of the stencil arrays in shared memory
+  MINT_PLAN_REGISTER_Z,  //2.5D: a shared memory plane sliding along z, up/down planes in registers
+  MINT_PLAN_READONLY     //center points in registers, other reads through the read-only data cache
+} MintOnChipStrategy_t;
+
+//resources of a streaming multiprocessor, selected with -opt:device=<compute capability>
+typedef struct {
+  int computeCapability;   //ex: 35 for sm_35
+  int sharedMemPerSM;      //in bytes
+  int sharedMemPerBlock;   //in bytes
+  int regsPerSM;
+  int maxRegsPerThread;
+  int maxThreadsPerSM;
+  int maxBlocksPerSM;
+  bool readOnlyCache;      //__ldg is available
+} MintDeviceParams_t;
+
+typedef struct {
+  MintOnChipStrategy_t strategy;
+  bool optShared;
+  bool optRegister;
+  bool readOnlyCache;      //route the remaining reads of read-only arrays through __ldg
+  double occupancy;        //estimated, in [0,1]
+  double trafficPerPoint;  //estimated global memory loads and stores per output point
+} MintOnChipPlan_t;
+
+class OnChipMemoryPlanner
+{
+
+public:
+  OnChipMemoryPlanner();
+  virtual ~OnChipMemoryPlanner();
+
+  static MintDeviceParams_t getDeviceParams(int computeCapability);
+
+  //estimates the cost of each strategy the kernel configuration allows and returns the cheapest one
+  static MintOnChipPlan_t plan(SgFunctionDeclaration* kernel,
+			       const std::set<SgInitializedName*>& readOnlyVars,
+			       const MintArrFreqPairList_t& candidateVarsShared,
+			       const MintArrFreqPairList_t& candidateVarsReg,
+			       const MintForClauses_t& clauseList,
+			       const SgType* elementType,
+			       const MintDeviceParams_t& device);
+
+  //replaces the global memory reads of the read-only arrays with __ldg(&A[..])
+  static void applyReadOnlyCacheOpt(SgFunctionDeclaration* kernel,
+				    const std::set<SgInitializedName*>& readOnlyVars);
+
+  static string getStrategyName(MintOnChipStrategy_t strategy);
+
+ private:
+
+  static double estimateOccupancy(const MintDeviceParams_t& device,
+				  int threadsPerBlock, int sharedMemPerBlock, int regsPerThread);
+
+};
+
+#endif
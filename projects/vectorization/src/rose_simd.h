@@ -4,7 +4,10 @@
 #ifndef LIB_SIMD_H 
 #define LIB_SIMD_H
 
+/* SSE unless another instruction set is selected, e.g. by -DUSE_AVX */
+#if !defined(USE_AVX) && !defined(USE_IBM)
 #define USE_SSE 1
+#endif
 
 /*
 The suffix implies the data type.
@@ -22,7 +25,7 @@ typedef  __m128i  __SIMDi;
 typedef  __m128d  __SIMDd; 
 
 #elif defined USE_AVX
-#include <avxintrin.h>
+#include <immintrin.h>
 #include "avx_mathfun.h"
 typedef  __m256   __SIMD; 
 typedef  __m256i  __SIMDi; 
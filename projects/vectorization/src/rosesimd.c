@@ -11,8 +11,6 @@
 //#include "rose_config.h"
 #include "rose_simd.h"
 
-#define USE_SSE 1
-
 __SIMD  cmpResult;
 __SIMDd cmpResultd;
 __SIMDi cmpResulti;
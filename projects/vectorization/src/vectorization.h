@@ -40,8 +40,12 @@ namespace SIMDVectorization
 //  Perform strip-mining transformation on a vectorizable loop, update its loop stride.
   void updateLoopIteration(SgForStatement*, int);
 
+//  Make the loop of the remaining iterations start after the last full vector.
   void changeRemainingLowerBound(SgForStatement*, int);
 
+//  Peel the first iterations of a loop into a loop of their own, until the loop index is a multiple of the vector factor.
+  void peelLoopForAlignment(SgForStatement*, int);
+
 //  vectorize unary operations insize vectorizable loop
   void vectorizeUnaryOp(SgUnaryOp*);
 
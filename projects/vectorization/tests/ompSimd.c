@@ -0,0 +1,26 @@
+/*
+  Test vectorization of OpenMP simd loops, with peeled and remaining iterations.
+*/
+int main(){
+  float a[19];
+  float b[19];
+  float c[19];
+  int n = 19;
+  int m = 3;
+#pragma omp simd
+  for (int i=0;i<n;i++)
+  {
+    c[i] = a[i] + b[i];
+  }
+#pragma omp simd
+  for (int i=m;i<n;i++)
+  {
+    c[i] = a[i] * b[i];
+  }
+// iterations closer than the vector factor may depend on each other, not vectorized
+#pragma omp simd safelen(2)
+  for (int i=2;i<n;i++)
+  {
+    c[i] = c[i-2] + b[i];
+  }
+}
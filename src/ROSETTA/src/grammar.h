@@ -562,6 +562,17 @@ class Grammar
        // Gets the number of columns in classHierarchyCastTable
           size_t getColumnsInClassHierarchyCastTable();
 
+       // Support for is-a tests as range checks on the preorder numbers of the classes.
+
+       // Generates the tables of preorder numbers and subtree sizes (indexed by variant) used by rose_isKindOf()
+          std::string generateClassHierarchyPreorderRanges();
+
+       // Numbers the classes of the subtree rooted at astNodeClass in preorder
+          void buildClassHierarchyPreorderRanges(AstNodeClass * astNodeClass, size_t & nextNumber, std::vector<size_t> & preorderNumber, std::vector<size_t> & subtreeSize);
+
+       // Gets the number of entries in the preorder range tables
+          size_t getNumberOfClassHierarchyPreorderEntries();
+
        // AS: build the function to get the class hierarchy subtree 
           std::string buildClassHierarchySubTreeFunction();
 
@@ -601,6 +612,22 @@ class Grammar
        // pattern on the IR nodes in memory pools.
           std::string buildMemoryPoolBasedTraversalSupport();
 
+       // Support for traversing the memory pools using multiple threads (the base class
+       // for thread-safe visitors is declared in the header, the traversal is generated
+       // into the memory pool traversal source file).
+          std::string buildMemoryPoolBasedParallelTraversalDeclarations();
+          std::string buildMemoryPoolBasedParallelTraversalSupport();
+
+       // Support for returning memory pool blocks without valid IR nodes to the system
+       // (declared in the header, generated into the memory pool traversal source file).
+          std::string buildReleaseEmptyMemoryPoolBlocksDeclarations();
+          std::string buildReleaseEmptyMemoryPoolBlocksSupport();
+
+       // Support for reporting the occupancy and fragmentation of the memory pools
+       // (declared in the header, generated into the memory pool traversal source file).
+          std::string buildMemoryPoolStatisticsDeclarations();
+          std::string buildMemoryPoolStatisticsSupport();
+
      private:
        // file cache for reading files
           static std::vector<GrammarFile*> fileList;
@@ -5,6 +5,7 @@
 
 #include "callbacks.h"          /* Needed for ROSE_Callbacks::List<> */
 #include "BinaryControlFlow.h"
+#include "BinaryDemangler.h"
 #include "BinaryFunctionCall.h"
 #include "BaseSemantics2.h"
 
@@ -798,7 +799,7 @@ public:
      **************************************************************************************************************************/
 
     /** Constructor that intializes the "unparser" callback lists with some useful functors. */
-    AsmUnparser(): user_registers(NULL), interp_registers(NULL) {
+    AsmUnparser(): user_registers(NULL), interp_registers(NULL), nthreads(1) {
         init();
     }
 
@@ -846,6 +847,22 @@ public:
     virtual const RegisterDictionary *get_registers() const;
     virtual void set_registers(const RegisterDictionary *registers) { user_registers = registers; }
     /** @}*/
+
+    /** Demangler for function names.
+     *
+     *  When a demangler is set, the function names printed by the unparser (function headers, callers and callees,
+     *  predecessor and successor blocks) are demangled through its cache. The names stored in the AST are not changed.
+     *  The default is a null demangler, which prints names as they are stored.
+     *
+     * @{ */
+    virtual Demangler::Ptr get_demangler() const { return demangler; }
+    virtual void set_demangler(const Demangler::Ptr &d) { demangler = d; }
+    /** @}*/
+
+    /** Name of a function as printed.
+     *
+     *  Returns the function's name, demangled if a demangler is set (see set_demangler()). */
+    virtual std::string function_name(SgAsmFunction*) const;
     
     /** Optional information about no-op sequences.
      *
@@ -869,6 +886,32 @@ public:
      *  unparsed.  In any case, a return value of zero means that nothing was unparsed and no output was produced. */
     virtual size_t unparse(std::ostream&, SgNode *ast);
 
+    /** Unparse a list of unparsable nodes.
+     *
+     *  Calls unparse_one_node() for each node, in order, and returns the number of nodes.  When the output is organized by AST
+     *  and more than one thread is configured (set_nthreads()) the nodes (typically the functions of an interpretation, see
+     *  InterpBody) are formatted in parallel, each thread using its own clone() of this unparser, and are written to the
+     *  output stream in the same order as by the serial unparser as soon as they are ready.  The number of formatted nodes
+     *  waiting to be written is bounded, so memory use does not depend on the size of the specimen. */
+    virtual size_t unparse_statements(std::ostream&, const std::vector<SgNode*> &nodes);
+
+    /** Number of threads used by unparse_statements().
+     *
+     *  The default is one thread (no parallel unparsing).  The callbacks are shared by all the threads, and must not modify
+     *  any state other than the unparser passed in their arguments.  Output is serial if the staticDataDisassembler
+     *  callback is initialized or if clone() returns null.
+     *
+     * @{ */
+    size_t get_nthreads() const { return nthreads; }
+    void set_nthreads(size_t n) { nthreads = n; }
+    /** @} */
+
+    /** Creates the unparser used by a thread of unparse_statements().
+     *
+     *  The default implementation copies this unparser (including its label map and control flow graph), sharing its
+     *  callbacks.  Subclasses return null unless they override this method, which makes the output serial. */
+    virtual AsmUnparser *clone() const;
+
     /** Unparse part of the AST into a string.
      *
      * This is a wrapper around unparse() that returns a string rather than producing output on a stream. */
@@ -999,6 +1042,7 @@ protected:
 
     /** Dictionaries used to convert register descriptors to register names. */
     const RegisterDictionary *user_registers;           // registers set by set_registers()
+    Demangler::Ptr demangler;                           // demangler set by set_demangler()
     const RegisterDictionary *interp_registers;         // registers obtained from the SgAsmInterpretation
 
     /** Initializes the callback lists.  This is invoked by the default constructor. */
@@ -1032,6 +1076,9 @@ protected:
         std::string format;             /**< Printf-style format string. This may contain a format for a uint64_t address. */
         rose_addr_t address;            /**< Address to use when generating a prefix string. */
     } lineprefix;
+
+    /** Number of threads used by unparse_statements(). See set_nthreads(). */
+    size_t nthreads;
 };
 
 } // namespace
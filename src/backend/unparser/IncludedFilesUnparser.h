@@ -30,6 +30,15 @@ private:
     set<string> filesToUnparse;
     set<string> newFilesToUnparse; //this is a temporary storage that needs to be accessible across several methods    
 
+    //Keeps the include directives rewritten by updatePreprocessingInfoPaths for each including file: the line of the directive,
+    //its original text and its new text. An unmodified file is copied with these rewrites instead of being unparsed.
+    struct IncludeRewrite {
+        int line;
+        string originalString;
+        string replacementString;
+    };
+    map<string, list<IncludeRewrite> > includeRewritesMap;
+
     void printDiagnosticOutput();
     void prepareForNewIteration();
     void initializeFilesToUnparse();
@@ -53,6 +62,8 @@ public:
     ~IncludedFilesUnparser();
     IncludedFilesUnparser(SgProject* projectNode);
     bool isInputFile(const string& absoluteFileName);
+    bool isModifiedFile(const string& absoluteFileName);
+    bool copyUnmodifiedFile(const string& absoluteFileName, const string& outputFileName);
     void unparse();    
     string getUnparseRootPath();
     map<string, string> getUnparseMap();
@@ -28,7 +28,12 @@ class CopyUnparser : public UnparseDelegate
       std::ostream* os; //! the directed output for the current file
      
  const char* filename;
- std::ifstream ifs;
+
+// contents of the original input file (memory-mapped if possible, else read into fileBuffer)
+ const char* fileContents;
+ unsigned long fileSize;
+ bool fileIsMapped;
+ std::vector <char> fileBuffer;
 
  void put(int c); 
 // character offset for the start of each line in the original input file
@@ -0,0 +1,67 @@
+#ifndef UNPARSE_OUTPUT_BUFFER_H
+#define UNPARSE_OUTPUT_BUFFER_H
+
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rosedll.h"
+
+/*! \brief Append-only, chunked buffer receiving the generated code.
+
+    The unparser writes its output through a std::ostream in many small pieces (one token or one formatting space at
+    a time). This std::streambuf keeps the text in fixed size chunks that are never reallocated nor copied while the
+    text grows, so that tools can unparse to memory (e.g. to compare or hash the generated code) and the unparser can
+    write a whole file to disk with a single vectored write. The first chunk is small (unparseToString() is mostly
+    called for single expressions and types), the size of the next ones doubles up to 64KB.
+
+    Use it with a std::ostream:
+
+         UnparseOutputBuffer buffer;
+         std::ostream output(&buffer);
+ */
+class ROSE_DLL_API UnparseOutputBuffer : public std::streambuf
+   {
+     public:
+          UnparseOutputBuffer();
+          virtual ~UnparseOutputBuffer();
+
+       // Number of characters written so far.
+          size_t size() const;
+
+       // The text written so far (one copy).
+          std::string str() const;
+
+       // Discards the text (the first chunk is kept for reuse).
+          void clear();
+
+       // The chunks of the text, for writing them without copying (the last one is only filled up to the end of the text).
+          size_t numberOfChunks() const { return chunks.size(); }
+          const char* chunkData ( size_t i ) const { return chunks[i].first; }
+          size_t chunkSize ( size_t i ) const;
+
+       // Writes the text to the file (replacing it) with as few system calls as possible; false if the file cannot be
+       // created or written.
+          bool writeToFile ( const std::string & filename ) const;
+
+     protected:
+          virtual int_type overflow ( int_type c );
+          virtual std::streamsize xsputn ( const char* s, std::streamsize n );
+          virtual int sync ();
+
+     private:
+          static const size_t firstChunkCapacity = 256;
+          static const size_t maxChunkCapacity   = 64 * 1024;
+
+          void addChunk();
+
+       // The chunks and their capacities.
+          std::vector<std::pair<char*,size_t> > chunks;
+
+       // The copy of a buffer would share the chunks.
+          UnparseOutputBuffer ( const UnparseOutputBuffer & );
+          UnparseOutputBuffer & operator= ( const UnparseOutputBuffer & );
+   };
+
+#endif
@@ -24,6 +24,14 @@
 // API function for new hidden list support.
 void generateNameQualificationSupport( SgNode* node, std::set<SgNode*> & referencedNameSet );
 
+// Incremental name qualification (for tools that transform and unparse the same AST repeatedly): the name qualification
+// of a file is not recomputed when the file was not changed since its name qualification was last computed. A file is
+// considered changed when the set of its IR nodes marked as modified (isModified flag) or the number of IR nodes in the
+// memory pools is different. The qualified names are kept in the static maps in SgNode, so the values of unchanged
+// files are still valid. Off by default.
+ROSE_DLL_API void setIncrementalNameQualification( bool incremental );
+ROSE_DLL_API bool get_incrementalNameQualification();
+
 class NameQualificationInheritedAttribute
    {
      private:
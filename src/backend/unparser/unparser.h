@@ -30,6 +30,7 @@
 // DQ (7/20/2008): New mechanism to permit unparsing of arbitrary strings at IR nodes.
 // This is intended to suppport non standard backend compiler annotations.
 #include "astUnparseAttribute.h"
+#include "unparseOutputBuffer.h"
 
 class Unparser_Nameq;
 
@@ -294,6 +295,12 @@ void resetSourcePositionToGeneratedCode( SgFile* file, UnparseFormatHelp *unpars
 //! User callable function available if compilation using the backend compiler is not required.
 ROSE_DLL_API void unparseFile   ( SgFile*    file,    UnparseFormatHelp* unparseHelp = NULL, UnparseDelegate *repl  = NULL, SgScopeStatement* unparseScope = NULL );
 
+//! Unparses the file (or the scope, if unparseScope is not NULL) to memory instead of the output file; the text is appended to the buffer.
+ROSE_DLL_API void unparseFileToBuffer ( SgFile* file, UnparseOutputBuffer & buffer, UnparseFormatHelp* unparseHelp = NULL, UnparseDelegate *repl  = NULL, SgScopeStatement* unparseScope = NULL );
+
+//! Unparses the file (or the scope, if unparseScope is not NULL) to a string (see unparseFileToBuffer()).
+ROSE_DLL_API std::string unparseFileToString ( SgFile* file, UnparseFormatHelp* unparseHelp = NULL, UnparseDelegate *repl  = NULL, SgScopeStatement* unparseScope = NULL );
+
 //! User callable function available if compilation using the backend compiler is not required.
 ROSE_DLL_API void unparseIncludedFiles( SgProject* project, UnparseFormatHelp* unparseHelp = NULL, UnparseDelegate *repl  = NULL );
 
@@ -103,5 +103,31 @@ void host_to_disk(Endianness sex, int h, int32_t *np);
 void host_to_disk(Endianness sex, int64_t h, int64_t *np);
 /** @} */
 
+/** Reverse the bytes of each word of an array in place.
+ *
+ *  This is much faster than reversing one word at a time, and uses SSSE3 byte shuffles when ROSE is compiled for a CPU that
+ *  has them.
+ * @{ */
+void swap_bytes(uint16_t *words, size_t nwords);
+void swap_bytes(uint32_t *words, size_t nwords);
+void swap_bytes(uint64_t *words, size_t nwords);
+/** @} */
+
+/** Convert an array of words from caller-specified order to host order in place.
+ *
+ *  This is used to convert a whole table that was read from a file, rather than converting its entries one at a time.
+ * @{ */
+void disk_to_host(Endianness sex, uint16_t *words, size_t nwords);
+void disk_to_host(Endianness sex, uint32_t *words, size_t nwords);
+void disk_to_host(Endianness sex, uint64_t *words, size_t nwords);
+/** @} */
+
+/** Convert an array of words from host order to caller-specified order in place.
+ * @{ */
+void host_to_disk(Endianness sex, uint16_t *words, size_t nwords);
+void host_to_disk(Endianness sex, uint32_t *words, size_t nwords);
+void host_to_disk(Endianness sex, uint64_t *words, size_t nwords);
+/** @} */
+
 } // namespace
 #endif
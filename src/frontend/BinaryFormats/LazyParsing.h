@@ -0,0 +1,66 @@
+#ifndef ROSE_BinaryFormats_LazyParsing_H
+#define ROSE_BinaryFormats_LazyParsing_H
+
+#include <cstddef>
+
+class SgAsmGenericFile;
+class SgAsmGenericHeader;
+class SgAsmGenericSection;
+class SgAsmInterpretation;
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** Deferred parsing of section contents.
+ *
+ *  Parsing a binary container normally parses the contents of every section it recognizes. For large ELF files most of the
+ *  time is spent building the relocation entries, the <code>.eh_frame</code> entries, and the symbol version tables, none of
+ *  which are needed by tools that only want the file headers, section headers, and memory map.  When lazy parsing is enabled
+ *  the ELF section table still creates all sections and initializes them from their section table entries, but the contents
+ *  of those sections are not parsed until @ref parse is called for the section. Until then such a section has no entries.
+ *
+ *  Parts of ROSE that use the contents of these sections (the ELF loader's relocation fixups and symbol version resolver,
+ *  the partitioner's ELF modules, and the code that reallocates, unparses, or dumps a file) call @ref parseAll first, so
+ *  enabling lazy parsing doesn't change their results. Other code that traverses these sections must do the same.
+ *
+ *  Lazy parsing is disabled by default. */
+namespace LazyParsing {
+
+/** Property: Whether section contents are parsed lazily.
+ *
+ *  This affects only containers that are parsed after the property is changed.
+ *
+ * @{ */
+bool isEnabled();
+void enable(bool b = true);
+/** @} */
+
+/** Mark a section as having unparsed contents.
+ *
+ *  This is called by the container parsers in place of parsing the section. */
+void defer(SgAsmGenericSection*);
+
+/** Whether a section's contents are still unparsed. */
+bool isDeferred(const SgAsmGenericSection*);
+
+/** Parse the contents of a deferred section.
+ *
+ *  If the section's contents were deferred then they are parsed now and true is returned; otherwise nothing happens. */
+bool parse(SgAsmGenericSection*);
+
+/** Parse the contents of all deferred sections.
+ *
+ *  Parses the deferred sections of a file header, of all the headers of a file, or of all the headers of an
+ *  interpretation. Returns the number of sections that were parsed.
+ *
+ * @{ */
+size_t parseAll(SgAsmGenericHeader*);
+size_t parseAll(SgAsmGenericFile*);
+size_t parseAll(SgAsmInterpretation*);
+/** @} */
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
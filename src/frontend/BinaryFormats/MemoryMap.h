@@ -348,6 +348,23 @@ public:
      *  is returned. An empty sequence matches at the beginning of the @p interval. */
     Sawyer::Optional<rose_addr_t> findSequence(const AddressInterval &interval, const std::vector<uint8_t> &sequence) const;
 
+    /** Search for all occurrences of a byte pattern.
+     *
+     *  Returns the starting address of every occurrence of @p pattern within the @p where interval, in increasing order,
+     *  including occurrences that overlap one another.  Only memory that has all the @p requiredPerms and none of the @p
+     *  prohibitedPerms is searched; an occurrence can span adjacent segments as long as both satisfy the permissions.
+     *
+     *  If @p mask is not empty then it must be the same size as the pattern, and a pattern byte matches a memory byte when
+     *  they're equal in the bits that are set in the corresponding mask byte. A zero mask byte is therefore a wildcard.
+     *
+     *  Segments whose buffers expose their data (see Sawyer::Container::Buffer::data) are searched in place without copying,
+     *  using the Boyer-Moore-Horspool algorithm, or memchr for single-byte patterns. Each segment is a separate unit of work and
+     *  the segments are searched with @p nThreads threads, or the hardware concurrency if @p nThreads is zero.  An empty
+     *  pattern matches nothing. */
+    std::vector<rose_addr_t> findAll(const AddressInterval &where, const std::vector<uint8_t> &pattern,
+                                     const std::vector<uint8_t> &mask = std::vector<uint8_t>(),
+                                     unsigned requiredPerms=READABLE, unsigned prohibitedPerms=0, size_t nThreads=1) const;
+
     /** Prints the contents of the map for debugging. The @p prefix string is added to the beginning of every line of output
      *  and typically is used to indent the output.
      *  @{ */
@@ -356,6 +373,14 @@ public:
     void print(std::ostream &o, std::string prefix="") const { dump(o, prefix); }
     /** @} */
 
+    /** Prints the memory used by each segment for debugging.
+     *
+     *  Each segment is listed with the kind of buffer that holds its data: memory allocated by the map, a mapped file,
+     *  memory borrowed from some other object (such as the file content held by an @ref SgAsmGenericFile), or no memory at
+     *  all.  Borrowed buffers that are copied on first write are marked as such.  A buffer that is shared by more than one
+     *  segment is counted only once in the totals. The @p prefix string is added to the beginning of every line of output. */
+    void dumpMemoryUsage(std::ostream&, std::string prefix="") const;
+
     /** Title of a segment when printing the map. */
     static std::string segmentTitle(const Segment&);
 
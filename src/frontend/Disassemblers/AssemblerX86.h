@@ -27,8 +27,10 @@ class AssemblerX86: public Assembler {
 public:
     AssemblerX86()
         : honor_operand_types(false) {
-        if (defns.size()==0)
+        if (defns.size()==0) {
             initAssemblyRules();
+            build_signature_index();
+        }
     }
 
     virtual ~AssemblerX86() {}
@@ -409,6 +411,32 @@ private:
     static void initAssemblyRules_part8();
     static void initAssemblyRules_part9();
 
+    /** Classes of instruction operand expressions, used to index the dictionary by operand signature. */
+    enum OperandClass {
+        oc_register,                            /**< SgAsmRegisterReferenceExpression. */
+        oc_memory,                              /**< SgAsmMemoryReferenceExpression. */
+        oc_value,                               /**< SgAsmValueExpression. */
+        oc_other                                /**< Any other kind of expression. */
+    };
+
+    /** Definitions indexed by signature. The key is computed by signature_key() from an instruction kind, architecture, and
+     *  the classes of the operands; the value is the list of indices into that kind's DictionaryPage, in page order, of the
+     *  definitions whose operands can accept operands of those classes. */
+    typedef std::map<uint64_t, std::vector<size_t> > SignatureIndex;
+
+    /** Build the signature index from the dictionary. This is called once, after initAssemblyRules(). */
+    static void build_signature_index();
+
+    /** Returns the set of operand classes (bit mask indexed by OperandClass) that an operand definition can match. Operand
+     *  definitions that are not implemented by the assembler accept all classes, leaving the rejection to matches(). */
+    static unsigned operand_classes(OperandDefn);
+
+    /** Returns the class of an instruction operand expression. */
+    static OperandClass operand_class(SgAsmExpression*);
+
+    /** Returns the signature index key for an instruction kind, architecture, and list of operand classes. */
+    static uint64_t signature_key(X86InstructionKind, bool is64, const std::vector<OperandClass>&);
+
     /** Adds a definition to the assembly dictionary. All x86 assemblers share a common dictionary. */
     static void define(const InsnDefn *d) {
         defns[d->kind].push_back(d);
@@ -462,6 +490,7 @@ private:
     uint8_t segment_override(SgAsmX86Instruction*);
 
     static InsnDictionary defns;                /**< Instruction assembly definitions organized by X86InstructionKind. */
+    static SignatureIndex signatures;           /**< Definitions organized by kind, architecture, and operand classes. */
     bool honor_operand_types;                   /**< If true, operand types rather than values determine assembled form. */
 };
 
@@ -2,6 +2,7 @@
 #define ROSE_BinaryAnalysis_BinaryDebugger_H
 
 #include <Sawyer/BitVector.h>
+#include <set>
 
 namespace rose {
 namespace BinaryAnalysis {
@@ -14,7 +15,6 @@ public:
     enum DetachMode { KILL, DETACH, CONTINUE, NOTHING };
 private:
     typedef Sawyer::Container::Map<RegisterDescriptor, size_t> UserRegDefs;
-    enum RegPageStatus { REGPAGE_NONE, REGPAGE_REGS, REGPAGE_FPREGS };
 
     int child_;                                         // process being debugged (int, not pid_t, for Windows portability)
     DetachMode howDetach_;                              // how to detach from the subordinate
@@ -24,29 +24,36 @@ private:
     UserRegDefs userRegDefs_;                           // how registers map to user_regs_struct in <sys/user.h>
     UserRegDefs userFpRegDefs_;                         // how registers map to user_fpregs_struct in <sys/user.h>
     size_t kernelWordSize_;                             // cached width in bits of kernel's words
-    uint8_t regsPage_[512];                             // latest register information read from subordinate
-    RegPageStatus regsPageStatus_;                      // what are the contents of regPage_?
+    uint8_t regsPage_[512];                             // latest user_regs_struct read from subordinate
+    uint8_t fpRegsPage_[512];                           // latest user_fpregs_struct read from subordinate
+    bool regsPageValid_;                                // is regsPage_ current? Cleared whenever the subordinate runs
+    bool fpRegsPageValid_;                              // is fpRegsPage_ current? Cleared whenever the subordinate runs
+    int memFd_;                                         // open /proc/N/mem for the subordinate, or -1
 
 public:
     BinaryDebugger()
-        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE) {
+        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageValid_(false),
+          fpRegsPageValid_(false), memFd_(-1) {
         init();
     }
 
     BinaryDebugger(int pid)
-        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE) {
+        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageValid_(false),
+          fpRegsPageValid_(false), memFd_(-1) {
         init();
         attach(pid);
     }
 
     BinaryDebugger(const std::string &exeName)
-        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE) {
+        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageValid_(false),
+          fpRegsPageValid_(false), memFd_(-1) {
         init();
         attach(exeName);
     }
 
     BinaryDebugger(const std::vector<std::string> &exeNameAndArgs)
-        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE) {
+        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageValid_(false),
+          fpRegsPageValid_(false), memFd_(-1) {
         init();
         attach(exeNameAndArgs);
     }
@@ -102,9 +109,25 @@ public:
     /** Execute one instruction. */
     void singleStep();
 
-    /** Run until the next breakpoint is reached. */
+    /** Run until the next breakpoint is reached.
+     *
+     *  If breakpoints are set then the subordinate is single stepped until it reaches one, since breakpoints are arbitrary
+     *  address intervals. See @ref runToAddresses for a faster alternative when the stopping points are instruction
+     *  addresses. */
     void runToBreakpoint();
 
+    /** Run until execution reaches one of the specified instruction addresses.
+     *
+     *  Executes at least one instruction, then runs the subordinate at full speed until it's about to execute the instruction
+     *  at one of the specified addresses, or until it terminates or stops for some other reason (such as a signal). This is
+     *  intended for stepping from one basic block to the next when the caller knows the basic block starting addresses.
+     *
+     *  The stopping points are implemented by temporarily replacing the first byte of each instruction with an x86 "int3"
+     *  instruction, therefore every address must be the start of an instruction, or else the subordinate will execute
+     *  corrupted code. The original bytes are restored before this method returns, and the execution address is adjusted to
+     *  be the address of the instruction that was reached. The breakpoints set with @ref setBreakpoint are not used. */
+    void runToAddresses(const std::set<rose_addr_t>&);
+
     /** Obtain and cache kernel's word size in bits.  The wordsize of the kernel is not necessarily the same as the word size
      * of the compiled version of this header. */
     size_t kernelWordSize();
@@ -120,10 +143,18 @@ public:
 
     /** Read subordinate memory.
      *
-     *  Returns the number of bytes read. The implementation accesses the subordinate memory via proc filesystem rather than
-     *  sending PTRACE_PEEKDATA commands. This allows large areas of memory to be read efficiently. */
+     *  Returns the number of bytes read. The implementation transfers the memory with a single process_vm_readv system call
+     *  when the kernel supports it, and otherwise (or for the parts of the request that it can't read) reads from the proc
+     *  filesystem rather than sending PTRACE_PEEKDATA commands. This allows large areas of memory to be read efficiently. */
     size_t readMemory(rose_addr_t va, size_t nBytes, uint8_t *buffer);
 
+    /** Write subordinate memory.
+     *
+     *  Returns the number of bytes written.  The memory is written through the proc filesystem, which can also write to
+     *  memory that's not writable by the subordinate (such as its instructions), falling back to PTRACE_POKEDATA commands if
+     *  the proc filesystem isn't writable. */
+    size_t writeMemory(rose_addr_t va, size_t nBytes, const uint8_t *buffer);
+
     /** Returns true if the subordinate terminated. */
     bool isTerminated();
 
@@ -137,6 +168,19 @@ private:
     // Wait for subordinate or throw on error
     void waitForChild();
 
+    // Subordinate's user_regs_struct and user_fpregs_struct, read from the subordinate only if not already cached.
+    uint8_t* regsPage();
+    uint8_t* fpRegsPage();
+
+    // File descriptor for the subordinate's /proc/N/mem, opened on first use
+    int memFd();
+
+    // Forget the cached registers, as when the subordinate runs
+    void invalidateRegisters();
+
+    // Close the /proc/N/mem file, as when detaching from the subordinate
+    void closeMemory();
+
 };
 
 } // namespace
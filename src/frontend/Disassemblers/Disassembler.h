@@ -221,6 +221,31 @@ public:
     /** The InstructionMap is a mapping from (absolute) virtual address to disassembled instruction. */
     typedef Map<rose_addr_t, SgAsmInstruction*> InstructionMap;
 
+    /** Length and control flow of an instruction.
+     *
+     *  This is what @ref scanOne returns: a summary of an instruction that can be obtained without constructing the
+     *  instruction. */
+    struct InstructionScan {
+        /** How an instruction affects control flow. */
+        enum ControlFlow {
+            CF_NONE,                                    /**< Falls through to the next instruction. */
+            CF_JUMP,                                    /**< Unconditional branch. */
+            CF_CONDITIONAL,                             /**< Conditional branch, which might also fall through. */
+            CF_CALL,                                    /**< Function call. */
+            CF_RETURN,                                  /**< Return from a function or interrupt handler. */
+            CF_INTERRUPT,                               /**< Software interrupt or system call. */
+            CF_HALT,                                    /**< Halts or always faults, such as "hlt" or "ud2" on x86. */
+            CF_OTHER                                    /**< Ends a basic block in some way not described above. */
+        };
+
+        size_t size;                                    /**< Size of the instruction in bytes. */
+        ControlFlow controlFlow;                        /**< How the instruction affects control flow. */
+        bool hasTarget;                                 /**< Whether @ref target is the statically known branch target. */
+        rose_addr_t target;                             /**< Branch target if @ref hasTarget is set. */
+
+        InstructionScan(): size(0), controlFlow(CF_NONE), hasTarget(false), target(0) {}
+    };
+
     /** The BadMap is a mapping from (absolute) virtual address to information about a failed disassembly attempt at that
      *  address. */
     typedef Map<rose_addr_t, Exception> BadMap;
@@ -552,6 +577,24 @@ public:
      *  can be modifying the MemoryMap or successors set at the same time. */
     virtual SgAsmInstruction *disassembleOne(const MemoryMap *map, rose_addr_t start_va, AddressSet *successors=NULL) = 0;
 
+    /** Scan one instruction without constructing it.
+     *
+     *  Determines whether the bytes at the specified address encode a valid instruction and, if so, the instruction's size and
+     *  effect on control flow, which is all that some uses need (e.g., deciding which addresses are worth disassembling).
+     *  Returns true and fills in @p scan if an instruction is found, and false otherwise.  The result is a prediction of what
+     *  @ref disassembleOne would do, which subclasses that override this method try to match but don't guarantee.
+     *
+     *  The default implementation disassembles the instruction, summarizes it, and deletes it, so it's no faster than @ref
+     *  disassembleOne; subclasses with a faster implementation also override @ref hasFastScan.
+     *
+     *  Thread safety: The same as @ref disassembleOne. */
+    virtual bool scanOne(const MemoryMap *map, rose_addr_t start_va, InstructionScan &scan /*out*/);
+
+    /** Whether @ref scanOne is faster than disassembling.
+     *
+     *  Returns true if this disassembler's @ref scanOne doesn't construct instructions. */
+    virtual bool hasFastScan() const { return false; }
+
     /** Similar in functionality to the disassembleOne method that takes a MemoryMap argument, except the content buffer is
      *  mapped 1:1 to virtual memory beginning at the specified address.
      *
@@ -41,6 +41,15 @@ public:
     /** Make an unknown instruction from an exception. */
     virtual SgAsmInstruction *make_unknown_instruction(const Exception&) ROSE_OVERRIDE;
 
+    /** See Disassembler::scanOne.
+     *
+     *  The x86 scanner is table driven: it decodes the prefixes, opcode, ModR/M, SIB, displacement, and immediate fields to
+     *  find the instruction length and control flow class, but doesn't construct the instruction or its operands. */
+    virtual bool scanOne(const MemoryMap *map, rose_addr_t start_va, InstructionScan &scan /*out*/) ROSE_OVERRIDE;
+
+    /** See Disassembler::hasFastScan. */
+    virtual bool hasFastScan() const ROSE_OVERRIDE { return true; }
+
 
     /*========================================================================================================================
      * Data types
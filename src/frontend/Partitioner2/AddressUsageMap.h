@@ -85,6 +85,17 @@ public:
     }
     /** @} */
 
+    /** Addresses occupied by this user.
+     *
+     *  Returns the interval of addresses occupied by the instruction or data block. */
+    AddressInterval extent() const {
+        if (insn_)
+            return AddressInterval::baseSize(insn_->get_address(), insn_->get_size());
+        if (DataBlock::Ptr dblock = odblock_.dataBlock())
+            return dblock->extent();
+        return AddressInterval();
+    }
+
     /** Determines if this user is a first instruction of a basic block. */
     bool isBlockEntry() const {
         return insn_ && bblock_ && insn_->get_address() == bblock_->address();
@@ -405,6 +416,36 @@ public:
     }
     /** @} */
 
+    /** Visit users that overlap the interval.
+     *
+     *  Calls the @p visitor for each user (instruction or data block) that overlaps the interval and for which the @p
+     *  userPredicate returns true.  This is like @ref overlapping except no list of users is constructed: each user is
+     *  passed directly from the map to the visitor, which is a functor taking a <code>const AddressUser&</code> argument and
+     *  returning false to stop the traversal.  Each user is visited once, even if it spans more than one interval of the map,
+     *  and the users are visited in no particular order.  Returns false if the traversal was stopped by the visitor.  The map
+     *  must not be modified by the visitor.
+     *
+     * @{ */
+    template<class UserVisitor>
+    bool traverseOverlapping(const AddressInterval &interval, UserVisitor &visitor) const {
+        return traverseOverlapping(interval, AddressUsers::selectAllUsers, visitor);
+    }
+
+    template<class UserPredicate, class UserVisitor>
+    bool traverseOverlapping(const AddressInterval &interval, UserPredicate userPredicate, UserVisitor &visitor) const {
+        BOOST_FOREACH (const Map::Node &node, map_.findAll(interval)) {
+            BOOST_FOREACH (const AddressUser &user, node.value().addressUsers()) {
+                // A user spanning several nodes is visited only in the node containing its first address in the interval.
+                if (!node.key().isContaining(std::max(user.extent().least(), interval.least())))
+                    continue;
+                if (userPredicate(user) && !visitor(user))
+                    return false;
+            }
+        }
+        return true;
+    }
+    /** @} */
+
     /** Users that are fully contained in the interval.
      *
      *  The return value is a vector of address users (instructions and/or data blocks) sorted by starting address where each
@@ -454,6 +495,8 @@ private:
     // block does not exist in the map, then this is a no-op.
     void eraseDataBlock(const DataBlock::Ptr&);
 
+    // True if the specified instruction or data block is the only user of every mapped address in the interval.
+    bool isSoleUser(const AddressInterval&, SgAsmInstruction*, const DataBlock::Ptr&) const;
 };
 
 } // namespace
@@ -295,6 +295,15 @@ public:
      *  semantics have not been dropped then nothing happens. */
     void undropSemantics();
 
+    /** Restore previously saved semantics.
+     *
+     *  This is an alternative to @ref undropSemantics that doesn't process the instructions again. The @p initialState and
+     *  @p finalState must be the states that resulted from processing this block's instructions, such as those saved in a
+     *  @ref SemanticCache, and the final state becomes the current state of this block's operators. There is no undo
+     *  information afterward, so @ref pop cannot be called until another instruction is appended.  This block's semantics must
+     *  have been dropped and the block must have a dispatcher. */
+    void restoreSemantics(const BaseSemantics::StatePtr &initialState, const BaseSemantics::StatePtr &finalState);
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Control flow
@@ -417,6 +426,7 @@ public:
 private:
     friend class Partitioner;
     void init(const Partitioner*);
+    void appendWithoutSemantics(SgAsmInstruction*);
     void freeze() { isFrozen_ = true; optionalPenultimateState_ = Sawyer::Nothing(); }
     void thaw() { isFrozen_ = false; }
 };
@@ -57,6 +57,14 @@ enum SemanticMemoryParadigm {
     MAP_BASED_MEMORY                                    /**< Fast but not precise. */
 };
 
+/** How basic blocks and functions are fingerprinted.  See @ref Partitioner::basicBlockFingerprint. */
+enum FingerprintAlgorithm {
+    FINGERPRINT_RAW_BYTES,                              /**< Instruction encodings. */
+    FINGERPRINT_MASKED_BYTES,                           /**< Instruction encodings with the bytes of addresses zeroed. */
+    FINGERPRINT_MNEMONICS,                              /**< Instruction mnemonics. */
+    FINGERPRINT_SEMANTICS                               /**< Symbolic registers and memory written by the block. */
+};
+
 /** Settings that control building the AST.
  *
  *  The runtime descriptions and command-line parser for these switches can be obtained from @ref
@@ -96,10 +104,19 @@ struct AstConstructionSettings {
      *  parent pointer will always return the same basic block. */
     bool copyAllInstructions;
 
+    /** Number of threads used to build the function ASTs.
+     *
+     *  When greater than one, the @ref SgAsmFunction subtrees are built by this many threads, their IR nodes allocated from
+     *  per-thread memory pool arenas, and then attached to the global block in order of function entry address. The
+     *  resulting AST is the same as the one built by a single thread.  Parallel construction requires @ref
+     *  copyAllInstructions, since otherwise the instructions of shared basic blocks would be modified by more than one
+     *  thread; the AST is built serially when that setting is false. */
+    size_t nThreads;
+
     /** Default constructor. */
     AstConstructionSettings()
         : allowEmptyGlobalBlock(false), allowFunctionWithNoBasicBlocks(false), allowEmptyBasicBlocks(false),
-          copyAllInstructions(true) {}
+          copyAllInstructions(true), nThreads(1) {}
 
     /** Default strict settings.
      *
@@ -188,6 +205,18 @@ struct DisassemblerSettings {
     std::string isaName;                            /**< Name of the instruction set architecture. Specifying a non-empty
                                                      *   ISA name will override the architecture that's chosen from the
                                                      *   binary container(s) such as ELF or PE. */
+    bool predisassembling;                          /**< Whether all executable memory is disassembled in parallel when a
+                                                     *   partitioner is created, before the partitioner starts asking for
+                                                     *   instructions. See @ref InstructionProvider::predisassemble. */
+    bool compactPredisassembly;                     /**< Whether predisassembly records only where instructions start,
+                                                     *   decoding each instruction when the partitioner first needs it. See
+                                                     *   @ref InstructionProvider::predisassemble. */
+    size_t maxCachedInstructions;                   /**< Maximum number of instructions cached by the instruction provider,
+                                                     *   or zero for no limit. See @ref
+                                                     *   InstructionProvider::maxCachedInstructions. */
+
+    DisassemblerSettings()
+        : predisassembling(false), compactPredisassembly(false), maxCachedInstructions(0) {}
 };
 
 /** Controls whether the function may-return analysis runs. */
@@ -226,6 +255,8 @@ struct PartitionerSettings {
                                                      *   branches. */
     bool findingFunctionPadding;                    /**< Look for padding before each function entry point? */
     bool findingDeadCode;                           /**< Look for unreachable basic blocks? */
+    bool discoveringInParallel;                     /**< Discover the instructions of pending basic blocks in batches using
+                                                     *   multiple threads. See @ref Engine::makeNextBasicBlocksInParallel. */
     rose_addr_t peScramblerDispatcherVa;            /**< Run the PeDescrambler module if non-zero. */
     bool findingIntraFunctionCode;                  /**< Suck up unused addresses as intra-function code. */
     bool findingIntraFunctionData;                  /**< Suck up unused addresses as intra-function data. */
@@ -240,16 +271,19 @@ struct PartitionerSettings {
     bool findingThunks;                             /**< Look for common thunk patterns in undiscovered areas. */
     bool splittingThunks;                           /**< Split thunks into their own separate functions. */
     SemanticMemoryParadigm semanticMemoryParadigm;  /**< Container used for semantic memory states. */
+    size_t semanticCacheSize;                       /**< Max instructions whose dropped basic block semantics are cached. */
     bool namingConstants;                           /**< Give names to constants by calling @ref Modules::nameConstants. */
     bool namingStrings;                             /**< Give labels to constants that are string literal addresses. */
+    bool demanglingNames;                           /**< Demangle all symbol names in parallel when creating a partitioner. */
 
     PartitionerSettings()
         : usingSemantics(false), followingGhostEdges(false), discontiguousBlocks(true), findingFunctionPadding(true),
-          findingDeadCode(true), peScramblerDispatcherVa(0), findingIntraFunctionCode(true), findingIntraFunctionData(true),
+          findingDeadCode(true), discoveringInParallel(false), peScramblerDispatcherVa(0), findingIntraFunctionCode(true), findingIntraFunctionData(true),
           doingPostAnalysis(true), doingPostFunctionMayReturn(true), doingPostFunctionStackDelta(true),
           doingPostCallingConvention(false), doingPostFunctionNoop(false), functionReturnAnalysis(MAYRETURN_DEFAULT_YES),
           findingDataFunctionPointers(false), findingThunks(true), splittingThunks(false),
-          semanticMemoryParadigm(LIST_BASED_MEMORY), namingConstants(true), namingStrings(true) {}
+          semanticMemoryParadigm(LIST_BASED_MEMORY), semanticCacheSize(0), namingConstants(true), namingStrings(true),
+          demanglingNames(true) {}
 };
 
 /** Settings for controling the engine behavior.
@@ -258,6 +292,10 @@ struct PartitionerSettings {
  *  descriptions and command-line parser for these switches can be obtained from @ref engineBehaviorSwitches. */
 struct EngineSettings {
     std::vector<std::string> configurationNames;    /**< List of configuration files and/or directories. */
+    size_t memoryBudget;                            /**< Resident memory in megabytes above which caches are reduced, or zero. */
+
+    EngineSettings()
+        : memoryBudget(0) {}
 };
 
 // Additional declarations w/out definitions yet.
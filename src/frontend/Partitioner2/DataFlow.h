@@ -231,6 +231,51 @@ StackVariables findFunctionArguments(const BaseSemantics::RiscOperatorsPtr &ops,
  *  larger units of memory written to by the same instruction will be broken into smaller variables. */
 std::vector<AbstractLocation> findGlobalVariables(const BaseSemantics::RiscOperatorsPtr &ops, size_t wordNBytes);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Whole-program driver
+//
+// Runs intra-function data-flow for many functions concurrently and hands each function's result to a user callback as soon as
+// it's available, so the results for all functions never need to be in memory at once.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Data-flow results for one function.
+ *
+ *  This is what @ref allFunctionDataFlow passes to its callback. */
+struct FunctionDataFlow {
+    Function::Ptr function;                             /**< Function that was analyzed. */
+    DfCfg dfCfg;                                        /**< Data-flow graph for the function. */
+    BaseSemantics::RiscOperatorsPtr ops;                /**< Operators used by the analysis, not shared with other functions. */
+    BaseSemantics::StatePtr initialState;               /**< State at the function's entry vertex. */
+    BaseSemantics::StatePtr finalState;                 /**< Incoming state of the return vertex, or null if not reached. */
+    bool converged;                                     /**< True if the analysis reached a fixed point. */
+
+    FunctionDataFlow(): converged(false) {}
+};
+
+/** Callback for @ref allFunctionDataFlow. */
+class FunctionDataFlowCallback {
+public:
+    virtual ~FunctionDataFlowCallback() {}
+
+    /** Called once for each function that was analyzed.
+     *
+     *  Calls come from the worker threads in no particular order but are serialized, so the callback need not be thread
+     *  safe. The result is discarded when the callback returns; anything that's needed later must be copied out of it. */
+    virtual void operator()(const FunctionDataFlow&) = 0;
+};
+
+/** Run intra-function data-flow on all functions.
+ *
+ *  Each function's data-flow graph is built with @ref buildDfCfg (not interprocedural) and analyzed with a dispatcher and
+ *  operators created for that function alone by the partitioner, so functions can be analyzed concurrently by up to @p
+ *  nThreads threads. (Zero means use the hardware concurrency.)  The results of each function are passed to @p callback and
+ *  then discarded, therefore memory usage is bounded by the number of threads rather than the number of functions.
+ *  Functions that have no instruction semantics are passed to the callback with no states.
+ *
+ *  The partitioner must not be modified while this is running, and the transfer function reads the stack deltas that have
+ *  already been computed for called functions, so run the stack delta analysis first if those are wanted. */
+void allFunctionDataFlow(const Partitioner&, FunctionDataFlowCallback &callback, size_t nThreads);
+
 
 
 } // namespace
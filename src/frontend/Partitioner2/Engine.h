@@ -155,6 +155,8 @@ private:
     Disassembler *disassembler_;                        // not ref-counted yet, but don't destroy it since user owns it
     MemoryMap map_;                                     // memory map initialized by load()
     BasicBlockWorkList::Ptr basicBlockWorkList_;        // what blocks to work on next
+    size_t nBlocksSinceMemoryCheck_;                    // blocks discovered since the resident size was last checked
+    bool memoryBudgetExceeded_;                         // whether the memory budget has been exceeded yet
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Constructors
@@ -162,14 +164,16 @@ private:
 public:
     /** Default constructor. */
     Engine()
-        : interp_(NULL), binaryLoader_(NULL), disassembler_(NULL), basicBlockWorkList_(BasicBlockWorkList::instance(this)) {
+        : interp_(NULL), binaryLoader_(NULL), disassembler_(NULL), basicBlockWorkList_(BasicBlockWorkList::instance(this)),
+          nBlocksSinceMemoryCheck_(0), memoryBudgetExceeded_(false) {
         init();
     }
 
     /** Construct engine with settings. */
     explicit Engine(const Settings &settings)
         : settings_(settings),
-          interp_(NULL), binaryLoader_(NULL), disassembler_(NULL), basicBlockWorkList_(BasicBlockWorkList::instance(this)) {
+          interp_(NULL), binaryLoader_(NULL), disassembler_(NULL), basicBlockWorkList_(BasicBlockWorkList::instance(this)),
+          nBlocksSinceMemoryCheck_(0), memoryBudgetExceeded_(false) {
         init();
     }
 
@@ -306,6 +310,48 @@ public:
     Partitioner partition(const std::string &fileName) /*final*/;
     /** @} */
 
+    /** Restore a partitioner from a saved state.
+     *
+     *  Creates a partitioner for the specimen and restores the partitioning results that were saved in @p stateFileName by
+     *  @ref Partitioner::saveState, instead of partitioning the specimen again:
+     *
+     *  @li If the specimen is not loaded (@ref areSpecimensLoaded) then call @ref loadSpecimens.
+     *
+     *  @li Obtain a disassembler by calling @ref obtainDisassembler.
+     *
+     *  @li Create a partitioner by calling @ref createPartitioner.
+     *
+     *  @li Restore the state by calling @ref Partitioner::loadState.
+     *
+     *  The specimen must be loaded the same way as when the state was saved since the state holds a digest of the memory map
+     *  and cannot be restored for a different memory map.  Returns the partitioner, which contains the restored
+     *  results. Throws a @ref Partitioner2::Exception if the state cannot be restored. */
+    virtual Partitioner loadPartitioner(const std::string &stateFileName,
+                                        const std::vector<std::string> &fileNames = std::vector<std::string>());
+
+    /** Repartition after a configuration change.
+     *
+     *  Replaces the partitioner's configuration with @p newConfig and updates the partitioning results incrementally instead
+     *  of partitioning the whole specimen again, which is useful when iterating on configuration files.  The entries that
+     *  differ between the old and new configuration determine what is invalidated:
+     *
+     *  @li A changed basic block entry causes that basic block to be detached and rediscovered, and the functions that own it
+     *      to be rediscovered.
+     *
+     *  @li A changed function entry (by address, or by name for functions having that name) causes that function and its
+     *      basic blocks to be detached and rediscovered.  If the function's may-return property changed, then all functions
+     *      that call it directly or indirectly are also rediscovered because their call-return edges might change.
+     *
+     *  @li A changed data block entry only changes the address name.
+     *
+     *  Rediscovery runs @ref runPartitionerRecursive and @ref runPartitionerFinal over the partitioner, which only does work
+     *  for the detached parts, followed by @ref updateAnalysisResults if post-partitioning analysis is enabled.  The result is
+     *  usually the same as partitioning from scratch with the new configuration, but since everything else is kept it can
+     *  differ where the invalidated parts interacted with the rest of the specimen in ways these rules don't capture.
+     *
+     *  Returns the number of functions that were detached and rediscovered. */
+    virtual size_t repartition(Partitioner&, const Configuration &newConfig);
+
     /** Obtain an abstract syntax tree.
      *
      *  Constructs a new abstract syntax tree (AST) from partitioner information with these steps:
@@ -320,6 +366,13 @@ public:
     SgAsmBlock* buildAst(const std::string &fileName) /*final*/;
     /** @} */
 
+    /** Obtain an abstract syntax tree for some functions.
+     *
+     *  On-demand AST construction: calls Modules::buildAst for the functions of the partitioner whose entry addresses are
+     *  specified, so that only those functions are converted to AST nodes.  Addresses that are not function entry addresses
+     *  are ignored.  As with the other @ref buildAst methods, the global block is attached to the engine's interpretation. */
+    SgAsmBlock* buildAst(const Partitioner&, const std::vector<rose_addr_t> &functionVas) /*final*/;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Command-line parsing
     //
@@ -630,9 +683,25 @@ public:
      *  Processes the "undiscovered" work list until the list becomes empty.  This list is the list of basic block placeholders
      *  for which no attempt has been made to discover instructions.  This method implements a recursive descent disassembler,
      *  although it does not process the control flow edges in any particular order. Subclasses are expected to override this
-     *  to implement a more directed approach to discovering basic blocks. */
+     *  to implement a more directed approach to discovering basic blocks. If @ref discoveringInParallel is set then the
+     *  undiscovered blocks are processed in batches by @ref makeNextBasicBlocksInParallel. */
     virtual void discoverBasicBlocks(Partitioner&);
 
+    /** Enforce the memory budget.
+     *
+     *  Called by @ref discoverBasicBlocks after @p nBlocks more basic blocks have been discovered. If there is a @ref
+     *  memoryBudget then every so often the resident size of the process is compared with it, and @ref reduceMemory is called
+     *  if it's exceeded. */
+    virtual void checkMemoryBudget(Partitioner&, size_t nBlocks);
+
+    /** Reduce memory used by the partitioner.
+     *
+     *  Called when the resident size of the process, @p residentMb megabytes, exceeds the @ref memoryBudget.  Everything this
+     *  discards can be recreated on demand: the limit on the instruction provider's cached instructions is lowered so that
+     *  speculatively decoded instructions that were never used are deleted (they're decoded from the memory map again if
+     *  needed), the semantic cache is halved, and the semantics of all attached basic blocks are dropped. */
+    virtual void reduceMemory(Partitioner&, size_t residentMb);
+
     /** Scan read-only data to find addresses.
      *
      *  Scans read-only data beginning at the specified address in order to find pointers to code, and makes a new function at
@@ -801,6 +870,19 @@ public:
      *  Returns the basic block that was discovered, or the null pointer if there are no pending undiscovered blocks. */
     virtual BasicBlock::Ptr makeNextBasicBlock(Partitioner&);
 
+    /** Discover a batch of basic blocks in parallel.
+     *
+     *  Takes up to @p batchSize placeholders from the "undiscovered" work list and discovers their instructions using @p
+     *  nThreads threads (the hardware concurrency if zero).  The partitioner is not modified while the threads run, so the
+     *  basic block callbacks must be thread safe.  The discovered blocks are then attached to the CFG/AUM one at a time in
+     *  order of their starting addresses.  A block whose instructions have become the start of another block, or part of a
+     *  block attached earlier in the same batch, is discovered again before it's attached, so the result doesn't depend on
+     *  the number of threads.
+     *
+     *  Returns the number of basic blocks that were attached. A return value of zero means the "undiscovered" work list is
+     *  empty. */
+    virtual size_t makeNextBasicBlocksInParallel(Partitioner&, size_t nThreads, size_t batchSize);
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Build AST
@@ -911,6 +993,36 @@ public:
     virtual void isaName(const std::string &s) { settings_.disassembler.isaName = s; }
     /** @} */
 
+    /** Property: Whether to disassemble in parallel before partitioning.
+     *
+     *  If set, then each partitioner created by this engine disassembles all executable memory in parallel before it's
+     *  returned. See @ref InstructionProvider::predisassemble.
+     *
+     * @{ */
+    bool predisassembling() const /*final*/ { return settings_.disassembler.predisassembling; }
+    virtual void predisassembling(bool b) { settings_.disassembler.predisassembling = b; }
+    /** @} */
+
+    /** Property: Whether predisassembly is compact.
+     *
+     *  If set, then predisassembly creates compact records instead of instructions when the disassembler supports it. See
+     *  the @p compact argument of @ref InstructionProvider::predisassemble.
+     *
+     * @{ */
+    bool compactPredisassembly() const /*final*/ { return settings_.disassembler.compactPredisassembly; }
+    virtual void compactPredisassembly(bool b) { settings_.disassembler.compactPredisassembly = b; }
+    /** @} */
+
+    /** Property: Maximum number of cached instructions.
+     *
+     *  The limit given to the instruction provider of each partitioner created by this engine. See @ref
+     *  InstructionProvider::maxCachedInstructions.
+     *
+     * @{ */
+    size_t maxCachedInstructions() const /*final*/ { return settings_.disassembler.maxCachedInstructions; }
+    virtual void maxCachedInstructions(size_t n) { settings_.disassembler.maxCachedInstructions = n; }
+    /** @} */
+
     /** Property: Starting addresses for disassembly.
      *
      *  This is a list of addresses where functions will be created in addition to those functions discovered by examining the
@@ -941,6 +1053,16 @@ public:
     virtual void semanticMemoryParadigm(SemanticMemoryParadigm p) { settings_.partitioner.semanticMemoryParadigm = p; }
     /** @} */
 
+    /** Property: Size of the basic block semantics cache.
+     *
+     *  Determines the @ref SemanticCache::maxInstructions "size" of the @ref Partitioner::semanticCache "semantic cache" of
+     *  @ref Partitioner objects created by this engine.  Zero disables the cache.
+     *
+     * @{ */
+    size_t semanticCacheSize() const /*final*/ { return settings_.partitioner.semanticCacheSize; }
+    virtual void semanticCacheSize(size_t n) { settings_.partitioner.semanticCacheSize = n; }
+    /** @} */
+
     /**  Property: Whether to follow ghost edges.
      *
      *   If set, then "ghost" edges are followed during disassembly.  A ghost edge is a control flow edge from a branch
@@ -1004,6 +1126,16 @@ public:
     virtual void findingDeadCode(bool b) { settings_.partitioner.findingDeadCode = b; }
     /** @} */
 
+    /** Property: Whether to discover basic blocks in parallel.
+     *
+     *  If set, then @ref discoverBasicBlocks discovers the pending basic blocks in batches using multiple threads. See @ref
+     *  makeNextBasicBlocksInParallel.
+     *
+     * @{ */
+    bool discoveringInParallel() const /*final*/ { return settings_.partitioner.discoveringInParallel; }
+    virtual void discoveringInParallel(bool b) { settings_.partitioner.discoveringInParallel = b; }
+    /** @} */
+
     /** Property: PE-Scrambler dispatcher address.
      *
      *  If non-zero then the partitioner defeats PE-scrambled binary obfuscation by replacing control flow edges that go
@@ -1120,6 +1252,16 @@ public:
     std::vector<std::string>& configurationNames() /*final*/ { return settings_.engine.configurationNames; }
     /** @} */
 
+    /** Property: Memory budget.
+     *
+     *  Resident memory size of the process in megabytes above which the engine reduces the partitioner's caches while
+     *  discovering basic blocks (see @ref reduceMemory). The size is only known on Linux. Zero means there is no budget.
+     *
+     * @{ */
+    size_t memoryBudget() const /*final*/ { return settings_.engine.memoryBudget; }
+    virtual void memoryBudget(size_t megabytes) { settings_.engine.memoryBudget = megabytes; }
+    /** @} */
+
     /** Property: Give names to constants.
      *
      *  If this property is set, then the partitioner calls @ref Modules::nameConstants as part of its final steps.
@@ -1138,6 +1280,16 @@ public:
     virtual void namingStrings(bool b) { settings_.partitioner.namingStrings = b; }
     /** @} */
 
+    /** Property: Demangle symbol names.
+     *
+     *  If this property is set, then @ref createBarePartitioner demangles the names of all symbols of the interpretation in
+     *  parallel and caches them in the partitioner's @ref Partitioner::demangler "demangler".
+     *
+     * @{ */
+    bool demanglingNames() const /*final*/ { return settings_.partitioner.demanglingNames; }
+    virtual void demanglingNames(bool b) { settings_.partitioner.demanglingNames = b; }
+    /** @} */
+
     /** Property: Whether to allow empty global block in the AST.
      *
      *  If partitioner has not detected any functions, then it will create an AST containing either a single global block with
@@ -1185,6 +1337,16 @@ public:
     virtual void astCopyAllInstructions(bool b) { settings_.astConstruction.copyAllInstructions = b; }
     /** @} */
 
+    /** Property: Number of threads used to build the AST.
+     *
+     *  The function ASTs are built by this many threads and attached to the global block in order of entry address.  See
+     *  @ref AstConstructionSettings::nThreads.
+     *
+     * @{ */
+    size_t astThreads() const /*final*/ { return settings_.astConstruction.nThreads; }
+    virtual void astThreads(size_t n) { settings_.astConstruction.nThreads = n; }
+    /** @} */
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Internal stuff
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
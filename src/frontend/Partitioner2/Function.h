@@ -63,9 +63,7 @@ private:
     // sure clearCache() resets these to initial values.
     Sawyer::Cached<bool> isNoop_;
 
-    void clearCache() {
-        isNoop_.clear();
-    }
+    void clearCache();                                  // also clears cached fingerprint attributes
     
 protected:
     // Use instance() instead
@@ -110,8 +110,9 @@ public:
      *  @ref E_FUNCTION_XFER.
      *
      *  If @p edgeCount is non-zero an an edge of the correct type already exists between the @p source and @p target, then the
-     *  count on that edge is incremented instead. Otherwise, when @p edgeCount is zero, a new edge with unit count is inserted
-     *  even if it means creating an edge parallel to an existing edge.
+     *  count on that edge is incremented by @p edgeCount instead, and if no such edge exists then a new edge whose count is @p
+     *  edgeCount is inserted. Otherwise, when @p edgeCount is zero, a new edge with unit count is inserted even if it means
+     *  creating an edge parallel to an existing edge.
      *
      *  Returns the edge that was inserted or incremented.
      *
@@ -123,6 +124,20 @@ public:
     Graph::EdgeIterator insertCall(const Graph::VertexIterator &source, const Graph::VertexIterator &target,
                                    EdgeType type = E_FUNCTION_CALL, size_t edgeCount = 0);
     /** @} */
+
+    /** Erase a call edge.
+     *
+     *  Decrements by @p edgeCount the count of an edge of the specified type from @p source to @p target, and erases the edge
+     *  when its count reaches zero.  Does nothing if the functions are not in the call graph or there is no such edge. This is
+     *  the inverse of @ref insertCall with a non-zero edge count. */
+    void eraseCall(const Function::Ptr &source, const Function::Ptr &target, EdgeType type = E_FUNCTION_CALL,
+                   size_t edgeCount = 1);
+
+    /** Erase a function vertex.
+     *
+     *  Erases the specified function and all its incident edges from the call graph. Does nothing if the function is not a
+     *  member of the call graph. */
+    void eraseFunction(const Function::Ptr &function);
     
     /** List of all functions that call the specified function.
      *
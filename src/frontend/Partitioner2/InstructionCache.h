@@ -0,0 +1,183 @@
+#ifndef ROSE_BinaryAnalysis_Partitioner2_InstructionCache_H
+#define ROSE_BinaryAnalysis_Partitioner2_InstructionCache_H
+
+#include "MemoryMap.h"
+
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** Concurrent cache of instructions indexed by starting address.
+ *
+ *  This is the cache used by @ref InstructionProvider. The instructions are stored in an open-addressing hash table (linear
+ *  probing, 16 bytes per slot) that can be read by any number of threads without locking while other threads insert
+ *  instructions. Insertions, replacements, table growth and eviction are serialized by a mutex.  Addresses where an
+ *  instruction is known not to exist are not stored in the table, but in a bitmap over the executable memory that's allocated
+ *  in 64 kB chunks on demand.
+ *
+ *  The cache does not own instructions that were handed out to a caller (returned by @ref lookup or @ref insert) or inserted
+ *  with @ref replace: the caller may have saved pointers to them, for instance in basic blocks.  The speculatively decoded
+ *  instructions inserted with @ref insertSpeculative that have not yet been handed out are owned by the cache, and are the
+ *  instructions that are deleted when the cache exceeds its maximum number of instructions (see @ref maxInstructions).  An
+ *  evicted address is decoded again if it's needed later.
+ *
+ *  An address can also hold a compact record (see @ref insertCompact) instead of an instruction: it occupies only its slot and
+ *  records that a valid instruction starts there, without the IR nodes of the instruction and its operand expressions. A
+ *  compact record is materialized the first time the instruction is needed: @ref lookup reports it as not cached, and the
+ *  instruction decoded by the caller replaces the record when it's given to @ref insert.
+ *
+ *  When the table grows, the previous table cannot be freed immediately because other threads might still be reading it. The
+ *  previous tables (which altogether are smaller than the current table) are freed when the cache is destroyed; use @ref
+ *  reserve to avoid them when the number of instructions is known in advance. */
+class InstructionCache {
+public:
+    /** Construct an empty cache.
+     *
+     *  The executable segments of the memory map are the addresses for which an absent instruction can be recorded. */
+    explicit InstructionCache(const MemoryMap&);
+
+    ~InstructionCache();
+
+    /** Look up an address.
+     *
+     *  Returns true if the address is cached, in which case @p insn is set to the cached instruction, or null if the address
+     *  is known to not have an instruction.  The returned instruction is no longer owned by the cache.
+     *
+     *  Thread safety: This method is thread safe and does not lock in the common case. */
+    bool lookup(rose_addr_t va, SgAsmInstruction *&insn);
+
+    /** Whether an address is cached.
+     *
+     *  Unlike @ref lookup, this does not hand out the cached instruction.
+     *
+     *  Thread safety: This method is thread safe and does not lock in the common case. */
+    bool exists(rose_addr_t va) const;
+
+    /** Insert an instruction that's being handed out.
+     *
+     *  Inserts a newly decoded instruction unless another instruction was inserted at the same address in the meantime (by
+     *  another thread), in which case the new instruction is deleted.  Returns the instruction that's cached at the address.
+     *  If @p insn is null then the address is recorded as not having an instruction, and null is returned.  A compact record
+     *  at the address is replaced by the instruction.
+     *
+     *  Thread safety: This method is thread safe. */
+    SgAsmInstruction* insert(rose_addr_t va, SgAsmInstruction *insn);
+
+    /** Insert speculatively decoded instructions.
+     *
+     *  Inserts the specified instructions, which are owned by the cache until they're handed out. Instructions at addresses
+     *  that are already cached are deleted.  Returns the number of instructions that were inserted.
+     *
+     *  Thread safety: This method is thread safe. */
+    size_t insertSpeculative(const std::vector<std::pair<rose_addr_t, SgAsmInstruction*> > &insns);
+
+    /** Insert compact records.
+     *
+     *  Records that a valid instruction starts at each of the specified addresses without storing the instruction. Addresses
+     *  that are already cached are not changed. Compact records are never evicted and don't count toward @ref nInstructions
+     *  until they're materialized.  Returns the number of records that were inserted.
+     *
+     *  Thread safety: This method is thread safe. */
+    size_t insertCompact(const std::vector<rose_addr_t> &vas);
+
+    /** Insert or replace an instruction.
+     *
+     *  The instruction is inserted at its own starting address, replacing any instruction or compact record that's cached
+     *  there. The
+     *  instruction is not owned by the cache.
+     *
+     *  Thread safety: This method is thread safe. */
+    void replace(SgAsmInstruction*);
+
+    /** Number of cached addresses.
+     *
+     *  This includes the addresses that have an instruction or a compact record, and those addresses where an instruction is
+     *  known to not exist.
+     *
+     *  Thread safety: This method is thread safe. */
+    size_t size() const;
+
+    /** Number of cached instructions.
+     *
+     *  Thread safety: This method is thread safe. */
+    size_t nInstructions() const;
+
+    /** Number of compact records that have not been materialized.
+     *
+     *  Thread safety: This method is thread safe. */
+    size_t nCompact() const;
+
+    /** Property: Maximum number of cached instructions.
+     *
+     *  When an insertion makes the cache hold more than this many instructions, speculatively decoded instructions that were
+     *  never handed out are evicted until the cache holds at most three quarters of the limit, or until nothing else can be
+     *  evicted. Zero means there is no limit, which is the default.
+     *
+     *  Thread safety: These methods are thread safe.
+     *
+     * @{ */
+    size_t maxInstructions() const;
+    void maxInstructions(size_t n);
+    /** @} */
+
+    /** Make room for the specified number of instructions.
+     *
+     *  Thread safety: This method is thread safe. */
+    void reserve(size_t nInsns);
+
+private:
+    struct Slot {
+        rose_addr_t key;
+        volatile uintptr_t value;                       // instruction pointer and flags, or a marker
+    };
+
+    struct Table {
+        size_t nSlots;                                  // power of two
+        size_t shift;                                   // 64 - log2(nSlots)
+        Slot *slots;
+    };
+
+    // Bits indicating which addresses have no instruction, for one segment of executable memory.
+    struct AbsentBits {
+        AddressInterval where;
+        std::vector<uint64_t*> chunks;                  // each chunk is allocated on demand, then never changes
+    };
+
+    enum ProbeResult { FOUND, FOUND_COMPACT, NOT_FOUND, RETRY_LOCKED };
+
+    ProbeResult probe(const Table*, rose_addr_t va, bool handOut, SgAsmInstruction *&insn) const;
+    static size_t findSlot(const Table*, rose_addr_t va);
+    static size_t findEmptySlot(const Table*, rose_addr_t va);
+    volatile uint64_t* absentWord(rose_addr_t va, uint64_t &bit, bool allocate) const;
+    bool isAbsent(rose_addr_t va) const;
+    void insertAbsent(rose_addr_t va);
+    void eraseAbsent(rose_addr_t va);
+    void insertLocked(rose_addr_t va, SgAsmInstruction *insn, bool handOut);
+    void materializeLocked(size_t idx, SgAsmInstruction *insn);
+    void growLocked(size_t nSlots);
+    void evictLocked();
+
+    // not copyable
+    InstructionCache(const InstructionCache&);
+    InstructionCache& operator=(const InstructionCache&);
+
+private:
+    mutable boost::mutex mutex_;                        // serializes all modifications of the table
+    Table * volatile table_;                            // current table
+    std::vector<Table*> retiredTables_;                 // previous tables, possibly still being read by other threads
+    size_t nUsedSlots_;                                 // slots that are not empty, including evicted slots
+    volatile size_t nInsns_;                            // number of instructions in the table
+    volatile size_t nCompact_;                          // number of compact records in the table
+    volatile size_t nAbsent_;                           // number of addresses known to not have an instruction
+    size_t maxInsns_;                                   // eviction threshold, or zero
+    size_t evictionCursor_;                             // slot at which the next eviction scan starts
+    size_t nextEviction_;                               // no eviction scan until there are this many instructions
+    mutable std::vector<AbsentBits> absent_;            // sorted by address; only the chunks are modified
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -3,7 +3,9 @@
 
 #include "Disassembler.h"
 #include "BaseSemantics2.h"
+#include <Partitioner2/InstructionCache.h>
 
+#include <boost/thread/mutex.hpp>
 #include <Sawyer/Assert.h>
 #include <Sawyer/Map.h>
 #include <Sawyer/SharedPointer.h>
@@ -34,12 +36,13 @@ public:
 private:
     Disassembler *disassembler_;
     MemoryMap memMap_;
-    mutable InsnMap insnMap_;                           // this is a cache
+    mutable InstructionCache cache_;
+    mutable boost::mutex disassemblerMutex_;            // disassemblers keep the state of the instruction being decoded
     bool useDisassembler_;
 
 protected:
     InstructionProvider(Disassembler *disassembler, const MemoryMap &map)
-        : disassembler_(disassembler), memMap_(map), useDisassembler_(true) {
+        : disassembler_(disassembler), memMap_(map), cache_(memMap_), useDisassembler_(true) {
         ASSERT_not_null(disassembler);
     }
 
@@ -74,7 +77,11 @@ public:
      *  If the virtual address is non-executable then a null pointer is returned, otherwise either a valid instruction or an
      *  "unknown" instruction is returned.  An "unknown" instruction is used for cases where a valid instruction could not be
      *  disassembled, including the case when the first byte of a multi-byte instruction is executable but the remaining bytes
-     *  are not executable. */
+     *  are not executable.
+     *
+     *  Thread safety: Cached instructions are returned without locking, so this method can be called concurrently. When the
+     *  instruction is not cached, the calls to the disassembler are serialized by a lock; then IR nodes must be allocated from
+     *  per-thread arenas if other threads are also allocating them (see AstThreadLocalMemoryPool). */
     SgAsmInstruction* operator[](rose_addr_t va) const;
 
     /** Insert an instruction into the cache.
@@ -83,6 +90,33 @@ public:
      *  exists at the new instruction's address then the new instruction replaces the old instruction. */
     void insert(SgAsmInstruction*);
 
+    /** Disassemble all executable memory in parallel.
+     *
+     *  Speculatively disassembles an instruction at every executable address of the memory map and caches the results, so
+     *  that later calls to @ref operator[] are satisfied from the cache instead of calling the disassembler.  The executable
+     *  segments are split into work items at page granularity (@p pageSize bytes, aligned) and the work items are distributed
+     *  among @p nThreads worker threads, each of which uses its own copy of the disassembler obtained with @ref
+     *  Disassembler::clone.  If @p nThreads is zero then the hardware concurrency is used.  Addresses that are already cached
+     *  are not changed.  Nothing is disassembled if the disassembler is disabled.
+     *
+     *  Since an instruction is created at every executable address, not only at the addresses that are eventually found to be
+     *  the start of an instruction, this uses much more memory than on-demand disassembly; it's intended for large specimens
+     *  where most of the executable memory is code.  The instructions that are never returned by this provider are deleted
+     *  when the provider is destroyed, or earlier if the cache exceeds @ref maxCachedInstructions.  If the disassembler has a
+     *  fast scanner (see @ref Disassembler::hasFastScan) then each address is scanned first and no instruction is created at
+     *  addresses that don't decode to a valid instruction; those addresses are left uncached.
+     *
+     *  If @p compact is set and the disassembler has a fast scanner, then no instruction is created at all: each address
+     *  where a valid instruction starts gets a compact record in the cache (see @ref InstructionCache::insertCompact), which
+     *  is a small fraction of the memory of an instruction and its operand expressions.  The instruction is decoded when @ref
+     *  operator[] first asks for it, so this trades most of the memory of predisassembly for decoding the instructions that
+     *  are used again, serially.  Without a fast scanner, instructions are created as if @p compact was clear.
+     *
+     *  Returns the number of addresses that were added to the cache.
+     *
+     *  Thread safety: Other threads may obtain instructions from this provider while this method runs. */
+    size_t predisassemble(size_t nThreads, size_t pageSize=4096, bool compact=false);
+
     /** Returns the disassembler.
      *
      *  Returns the disassembler pointer provided in the constructor.  The disassembler is not owned by this instruction
@@ -95,7 +129,29 @@ public:
      *  an instruction is known to not exist.
      *
      *  This is a constant-time operation. */
-    size_t nCached() const { return insnMap_.size(); }
+    size_t nCached() const { return cache_.size(); }
+
+    /** Returns number of compact records that have not been decoded yet.
+     *
+     *  See @ref predisassemble. */
+    size_t nCompact() const { return cache_.nCompact(); }
+
+    /** Returns number of cached instructions.
+     *
+     *  This includes the instructions that have been returned by this provider, and the speculatively decoded instructions
+     *  that have not been returned yet (see @ref maxCachedInstructions). */
+    size_t nInstructions() const { return cache_.nInstructions(); }
+
+    /** Property: Maximum number of cached instructions.
+     *
+     *  When the cache holds more than this many instructions, the instructions that were decoded by @ref predisassemble and
+     *  have not been returned yet are deleted, and are decoded again if they're needed later.  The instructions that were
+     *  returned by this provider are never deleted since they may be part of basic blocks. Zero means no limit.
+     *
+     * @{ */
+    size_t maxCachedInstructions() const { return cache_.maxInstructions(); }
+    void maxCachedInstructions(size_t n) { cache_.maxInstructions(n); }
+    /** @} */
 
     /** Returns the register dictionary. */
     const RegisterDictionary* registerDictionary() const { return disassembler_->get_registers(); }
@@ -388,6 +388,13 @@ SgAsmFunction* buildFunctionAst(const Partitioner&, const Function::Ptr&, const
  *  basic blocks, which in turn contain instructions. */
 SgAsmBlock* buildGlobalBlockAst(const Partitioner&, const AstConstructionSettings&);
 
+/** Builds the global block AST for some functions.
+ *
+ *  Same as @ref buildGlobalBlockAst except only the specified functions are converted to AST nodes, which is much faster
+ *  than building the whole AST when only a few functions of a large specimen are needed.  The functions need not be attached
+ *  to the partitioner. They appear in the global block in order of entry address, whatever their order in the vector. */
+SgAsmBlock* buildGlobalBlockAst(const Partitioner&, const std::vector<Function::Ptr>&, const AstConstructionSettings&);
+
 /** Builds an AST from the CFG.
  *
  *  Builds an abstract syntax tree from the control flow graph.  The returned SgAsmBlock will have child functions; each
@@ -399,6 +406,13 @@ SgAsmBlock* buildGlobalBlockAst(const Partitioner&, const AstConstructionSetting
 SgAsmBlock* buildAst(const Partitioner&, SgAsmInterpretation *interp=NULL,
                      const AstConstructionSettings &settings = AstConstructionSettings::strict());
 
+/** Builds an AST for some functions.
+ *
+ *  On-demand AST construction: same as @ref buildAst except only the specified functions have AST nodes (see @ref
+ *  buildGlobalBlockAst).  Constants that refer to functions or basic blocks outside the AST keep their absolute values. */
+SgAsmBlock* buildAst(const Partitioner&, const std::vector<Function::Ptr>&, SgAsmInterpretation *interp=NULL,
+                     const AstConstructionSettings &settings = AstConstructionSettings::strict());
+
 /** Fixes pointers in the AST.
  *
  *  Traverses the AST to find SgAsmIntegerValueExpressions and changes absolute values to relative values.  If such an
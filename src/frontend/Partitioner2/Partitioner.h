@@ -1,6 +1,7 @@
 #ifndef ROSE_Partitioner2_Partitioner_H
 #define ROSE_Partitioner2_Partitioner_H
 
+#include <BinaryDemangler.h>
 #include <Partitioner2/AddressUsageMap.h>
 #include <Partitioner2/BasicBlock.h>
 #include <Partitioner2/BasicTypes.h>
@@ -12,6 +13,7 @@
 #include <Partitioner2/InstructionProvider.h>
 #include <Partitioner2/Modules.h>
 #include <Partitioner2/Reference.h>
+#include <Partitioner2/SemanticCache.h>
 
 #include <Sawyer/Attribute.h>
 #include <Sawyer/Callbacks.h>
@@ -308,9 +310,28 @@ private:
     bool assumeFunctionsReturn_;                        // Assume that unproven functions return to caller?
     size_t stackDeltaInterproceduralLimit_;             // Max depth of call stack when computing stack deltas
     AddressNameMap addressNames_;                       // Names for various addresses
+    Demangler::Ptr demangler_;                          // Demangled names, shared by copies of this partitioner
     bool basicBlockSemanticsAutoDrop_;                  // Conserve memory by dropping semantics for attached basic blocks?
+    SemanticCache::Ptr semanticCache_;                  // Dropped semantics that can be restored, shared by copies
     SemanticMemoryParadigm semanticMemoryParadigm_;     // Slow and precise, or fast and imprecise?
 
+    // Function call graph kept up to date as the CFG and the functions change (see functionCallGraph). The calls contributed
+    // by the outgoing edges of each basic block vertex are remembered so they can be withdrawn when the vertex's edges or the
+    // functions owning the vertex or its successors change.  Changes are only recorded when they happen; the call graph is
+    // updated when it's next asked for.
+    struct CallGraphCall {
+        Function::Ptr source, target;
+        EdgeType type;
+        CallGraphCall(const Function::Ptr &source, const Function::Ptr &target, EdgeType type)
+            : source(source), target(target), type(type) {}
+    };
+    typedef Sawyer::Container::Map<rose_addr_t, std::vector<CallGraphCall> > CallGraphContributions;
+    mutable FunctionCallGraph cgCache_;                 // calls with counts (no parallel edges); valid if cgCacheValid_
+    mutable CallGraphContributions cgContributions_;    // calls of cgCache_ per source basic block address
+    mutable std::set<rose_addr_t> cgDirtyVertices_;     // basic blocks whose contributions need to be recomputed
+    mutable std::vector<Function::Ptr> cgDirtyFunctions_; // functions attached or detached since the last update
+    mutable bool cgCacheValid_;                         // if false then the whole cache is rebuilt from the CFG
+
     // Callback lists
     CfgAdjustmentCallbacks cfgAdjustmentCallbacks_;
     BasicBlockCallbacks basicBlockCallbacks_;
@@ -340,7 +361,8 @@ public:
     Partitioner(Disassembler *disassembler, const MemoryMap &map)
         : memoryMap_(map), solver_(NULL), progressTotal_(0), isReportingProgress_(true), useSemantics_(false),
           autoAddCallReturnEdges_(false), assumeFunctionsReturn_(true), stackDeltaInterproceduralLimit_(1),
-          basicBlockSemanticsAutoDrop_(true), semanticMemoryParadigm_(LIST_BASED_MEMORY) {
+          demangler_(Demangler::instance()), basicBlockSemanticsAutoDrop_(true), semanticCache_(SemanticCache::instance()),
+          semanticMemoryParadigm_(LIST_BASED_MEMORY), cgCacheValid_(false) {
         init(disassembler, map);
     }
 
@@ -351,7 +373,8 @@ public:
     Partitioner()
         : solver_(NULL), progressTotal_(0), isReportingProgress_(true), useSemantics_(false),
           autoAddCallReturnEdges_(false), assumeFunctionsReturn_(true), stackDeltaInterproceduralLimit_(1),
-          basicBlockSemanticsAutoDrop_(true), semanticMemoryParadigm_(LIST_BASED_MEMORY) {
+          demangler_(Demangler::instance()), basicBlockSemanticsAutoDrop_(true), semanticCache_(SemanticCache::instance()),
+          semanticMemoryParadigm_(LIST_BASED_MEMORY), cgCacheValid_(false) {
         init(NULL, memoryMap_);
     }
 
@@ -364,7 +387,7 @@ public:
     Partitioner(const Partitioner &other)               // initialize just like default
         : solver_(NULL), progressTotal_(0), isReportingProgress_(true), useSemantics_(false),
           autoAddCallReturnEdges_(false), assumeFunctionsReturn_(true), basicBlockSemanticsAutoDrop_(true),
-          semanticMemoryParadigm_(LIST_BASED_MEMORY) {
+          semanticCache_(SemanticCache::instance()), semanticMemoryParadigm_(LIST_BASED_MEMORY), cgCacheValid_(false) {
         init(NULL, memoryMap_);                         // initialize just like default
         *this = other;                                  // then delegate to the assignment operator
     }
@@ -385,12 +408,15 @@ public:
         assumeFunctionsReturn_ = other.assumeFunctionsReturn_;
         stackDeltaInterproceduralLimit_ = other.stackDeltaInterproceduralLimit_;
         addressNames_ = other.addressNames_;
+        demangler_ = other.demangler_;
         basicBlockSemanticsAutoDrop_ = other.basicBlockSemanticsAutoDrop_;
+        semanticCache_ = other.semanticCache_;
         cfgAdjustmentCallbacks_ = other.cfgAdjustmentCallbacks_;
         basicBlockCallbacks_ = other.basicBlockCallbacks_;
         functionPrologueMatchers_ = other.functionPrologueMatchers_;
         functionPaddingMatchers_ = other.functionPaddingMatchers_;
         semanticMemoryParadigm_ = other.semanticMemoryParadigm_;
+        invalidateFunctionCallGraph();                  // rebuilt from the copied CFG when next needed
         init(other);                                    // copies graph iterators, etc.
         return *this;
     }
@@ -783,11 +809,33 @@ public:
     /** Immediately drop semantic information for all attached basic blocks.
      *
      *  Semantic information for all attached basic blocks is immediately forgotten by calling @ref
-     *  BasicBlock::dropSemantics. It can be recomputed later if necessary.
+     *  BasicBlock::dropSemantics. It can be recomputed later if necessary. Blocks whose semantics fit in the @ref
+     *  semanticCache are saved there first.
      *
      *  @sa basicBlockSemanticsAutoDrop */
     void basicBlockDropSemantics() const /*final*/;
 
+    /** Property: Cache of dropped basic block semantics.
+     *
+     *  When semantics are dropped for an attached basic block, either automatically (see @ref basicBlockSemanticsAutoDrop) or
+     *  by @ref basicBlockDropSemantics, the block's initial and final states are first saved in this cache if its instruction
+     *  limit allows. The cache is disabled (has a zero limit) by default, which gives the all-or-nothing behavior of the
+     *  auto-drop property alone.  Cached semantics are restored by @ref basicBlockUndropSemantics, and by the basic block
+     *  queries that use semantics (such as @ref basicBlockSuccessors) when they're asked about a block whose semantics were
+     *  dropped.  Copies of a partitioner share the same cache.  The cache is never null.
+     *
+     * @{ */
+    SemanticCache::Ptr semanticCache() const /*final*/ { return semanticCache_; }
+    void semanticCache(const SemanticCache::Ptr &c) /*final*/ { ASSERT_not_null(c); semanticCache_ = c; }
+    /** @} */
+
+    /** Restore dropped semantics for a basic block.
+     *
+     *  If the block's semantics have been dropped then they're restored from the @ref semanticCache if possible, otherwise
+     *  they're recomputed by processing the block's instructions again (see @ref BasicBlock::undropSemantics). Returns true
+     *  if the states came from the cache. */
+    bool basicBlockUndropSemantics(const BasicBlock::Ptr&) const /*final*/;
+
     /** Returns the number of basic blocks attached to the CFG/AUM.
      *
      *  This method returns the number of CFG vertices that are more than mere placeholders in that they point to an actual,
@@ -1217,21 +1265,35 @@ private:
         MayReturnVertexInfo(): state(INIT), processedCallees(false), anyCalleesReturn(false), result(boost::indeterminate) {}
     };
 
+    // Per-vertex data for one may-return query. The changed entries are remembered so that they can be reset for the next
+    // query without initializing an entry for every CFG vertex again.
+    struct MayReturnVertexInfos {
+        std::vector<MayReturnVertexInfo> info;
+        std::vector<size_t> changed;                        // IDs of vertices whose info was changed, possibly duplicated
+        explicit MayReturnVertexInfos(size_t nVertices): info(nVertices) {}
+        MayReturnVertexInfo& operator[](size_t vertexId) { return info[vertexId]; }
+        void reset() {
+            BOOST_FOREACH (size_t vertexId, changed)
+                info[vertexId] = MayReturnVertexInfo();
+            changed.clear();
+        }
+    };
+
     // Is edge significant for analysis? See .C file for full documentation.
     bool mayReturnIsSignificantEdge(const ControlFlowGraph::ConstEdgeIterator &edge,
-                                    std::vector<MayReturnVertexInfo> &vertexInfo) const;
+                                    MayReturnVertexInfos &vertexInfo) const;
 
     // Determine (and cache in vertexInfo) whether any callees return.
     boost::logic::tribool mayReturnDoesCalleeReturn(const ControlFlowGraph::ConstVertexIterator &vertex,
-                                                    std::vector<MayReturnVertexInfo> &vertexInfo) const;
+                                                    MayReturnVertexInfos &vertexInfo) const;
 
     // Maximum may-return result from significant successors including phantom call-return edge.
     boost::logic::tribool mayReturnDoesSuccessorReturn(const ControlFlowGraph::ConstVertexIterator &vertex,
-                                                       std::vector<MayReturnVertexInfo> &vertexInfo) const;
+                                                       MayReturnVertexInfos &vertexInfo) const;
 
     // The guts of the may-return analysis
     Sawyer::Optional<bool> basicBlockOptionalMayReturn(const ControlFlowGraph::ConstVertexIterator &start,
-                                                       std::vector<MayReturnVertexInfo> &vertexInfo) const;
+                                                       MayReturnVertexInfos &vertexInfo) const;
 
 
 
@@ -1574,7 +1636,11 @@ public:
      *
      *  If @p allowParallelEdges is true then the returned call graph will have one edge for each function call and each edge
      *  will have a count of one.  Otherwise multiple calls between the same pair of functions are coalesced into single edges
-     *  with non-unit counts in the call graph. */
+     *  with non-unit counts in the call graph.
+     *
+     *  The partitioner maintains the call graph as basic blocks and functions are attached and detached, so this does not
+     *  scan the whole CFG: only the calls of the basic blocks that changed since the previous call are recomputed.  The
+     *  vertices of the returned graph are in order of function entry address and the edges are grouped by caller. */
     FunctionCallGraph functionCallGraph(bool allowParallelEdges = true) const /*final*/;
 
     /** Stack delta analysis for one function.
@@ -1596,7 +1662,11 @@ public:
      *  performing any analysis. */
     BaseSemantics::SValuePtr functionStackDelta(const Function::Ptr &function) const /*final*/;
 
-    /** Compute stack delta analysis for all functions. */
+    /** Compute stack delta analysis for all functions.
+     *
+     *  The functions are ordered by the function call graph (with cycles broken) so that callees are analyzed before their
+     *  callers, and functions that don't depend on one another are analyzed concurrently by the number of threads specified
+     *  with the generic "--threads" switch.  Each analysis uses its own semantic operators. */
     void allFunctionStackDelta() const /*final*/;
 
     /** May-return analysis for one function.
@@ -1605,7 +1675,11 @@ public:
      *  basicBlockOptionalMayReturn invoked on the function's entry block. See that method for details. */
     Sawyer::Optional<bool> functionOptionalMayReturn(const Function::Ptr &function) const /*final*/;
 
-    /** Compute may-return analysis for all functions. */
+    /** Compute may-return analysis for all functions.
+     *
+     *  The functions are analyzed in depth-first post-order of the function call graph so that callees are analyzed before
+     *  their callers.  Unlike @ref allFunctionStackDelta this runs in the calling thread: each query caches results in the
+     *  basic blocks it reaches, including blocks of other functions, so concurrent queries would race on those caches. */
     void allFunctionMayReturn() const /*final*/;
 
     /** Calling convention analysis for one function.
@@ -1712,6 +1786,51 @@ public:
     void forgetFunctionIsNoop(const Function::Ptr&) const /*final*/;
     /** @} */
 
+    /** Fingerprint of a basic block.
+     *
+     *  Returns a 64-bit hash of the basic block computed by the specified algorithm:
+     *
+     *  @li @ref FINGERPRINT_RAW_BYTES hashes the instruction encodings, so it identifies exact copies of code.
+     *
+     *  @li @ref FINGERPRINT_MASKED_BYTES is the same except the bytes that encode addresses (constants and branch
+     *  displacements that refer to mapped memory) are zeroed first, so it identifies code that was relocated or that calls
+     *  functions at other addresses.  The encoded bytes are found by matching the values of the instruction's integer operands
+     *  against its encoding.
+     *
+     *  @li @ref FINGERPRINT_MNEMONICS hashes the instruction mnemonics, ignoring operands.
+     *
+     *  @li @ref FINGERPRINT_SEMANTICS hashes the symbolic values of the registers and memory written by the block.
+     *  Variables are numbered by order of appearance and constants that are mapped addresses all hash alike,
+     *  therefore code that computes the same values gets the same fingerprint regardless of its address or of how its
+     *  instructions are scheduled.  Returns zero if the architecture has no instruction semantics or the semantics of an
+     *  instruction fail.
+     *
+     *  Fingerprints are cached in the basic block as attributes (see @ref fingerprintAttributeId) and the cached value is
+     *  returned if there is one; attached basic blocks are immutable so they never need to be recomputed.
+     *
+     *  See also, @ref allFingerprints, which fingerprints all basic blocks and functions at once in parallel. */
+    uint64_t basicBlockFingerprint(const BasicBlock::Ptr&, FingerprintAlgorithm) const /*final*/;
+
+    /** Fingerprint of a function.
+     *
+     *  Returns a 64-bit hash combining the fingerprints of the function's basic blocks in order of their starting
+     *  addresses. The basic blocks must be attached, and a block address that has no attached basic block contributes a fixed
+     *  value. The fingerprint is cached in the function as an attribute and cleared when the function's basic blocks change.
+     *  See @ref basicBlockFingerprint for the algorithms. */
+    uint64_t functionFingerprint(const Function::Ptr&, FingerprintAlgorithm) const /*final*/;
+
+    /** Fingerprint all basic blocks and functions.
+     *
+     *  Computes the fingerprints of all attached basic blocks and then all attached functions using the number of threads from
+     *  the @c --threads switch, and caches them. Afterward, calls to @ref basicBlockFingerprint and @ref functionFingerprint
+     *  only read the cache, so several tools (clone detection, library identification, diffing) can share one pass. */
+    void allFingerprints(FingerprintAlgorithm) const /*final*/;
+
+    /** Clears cached fingerprints.
+     *
+     *  Clears all fingerprints computed by the specified algorithm from all attached basic blocks and functions.  */
+    void forgetFingerprints(FingerprintAlgorithm) const /*final*/;
+
 
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1831,6 +1950,25 @@ public:
     void cfgGraphViz(std::ostream&, const AddressInterval &restrict = AddressInterval::whole(),
                      bool showNeighbors=true) const /*final*/;
 
+    /** Save the partitioning results to a file.
+     *
+     *  Writes a compact binary snapshot of the control flow graph (basic blocks, placeholders and edges), the data blocks,
+     *  the functions, and the demangled names cached by the @ref demangler, so that the results can be restored with @ref loadState (usually by @ref Engine::loadPartitioner)
+     *  without partitioning the specimen again.  The address usage map is not written since it's rebuilt from the basic
+     *  blocks and data blocks, and instructions are saved only by address since they're decoded again from the specimen
+     *  when the snapshot is loaded.  The snapshot also holds a digest of the memory map, which must not change between
+     *  saving and loading.  Throws an @ref Exception if the file cannot be written. */
+    void saveState(const std::string &fileName) const /*final*/;
+
+    /** Restore partitioning results from a file.
+     *
+     *  Reads a snapshot written by @ref saveState into this partitioner, which must not have any basic blocks or functions
+     *  yet.  Throws an @ref Exception if the file cannot be read, is not a partitioner snapshot, or was saved for a different
+     *  memory map.  The instruction semantics of the restored basic blocks are dropped (see @ref
+     *  basicBlockSemanticsAutoDrop) and recomputed when needed; the other cached basic block properties (successors,
+     *  function call and return, may-return) are restored as they were saved. */
+    void loadState(const std::string &fileName) /*final*/;
+
     /** Name of a vertex.
      *
      *  @{ */
@@ -1944,6 +2082,18 @@ public:
     const AddressNameMap& addressNames() const /*final*/ { return addressNames_; }
     /** @} */
 
+    /** Property: Cache of demangled names.
+     *
+     *  Function names are the (usually mangled) symbol names from the specimen; the demangler caches their demangled forms
+     *  for printing.  The engine populates it in parallel from the symbol tables after the containers are parsed, and it's
+     *  saved and restored with the partitioner state.  Copies of a partitioner share the same demangler. The demangler is
+     *  never null.
+     *
+     * @{ */
+    Demangler::Ptr demangler() const /*final*/ { return demangler_; }
+    void demangler(const Demangler::Ptr &d) /*final*/ { ASSERT_not_null(d); demangler_ = d; }
+    /** @} */
+
 
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2027,6 +2177,17 @@ private:
     // This method is called whenever a basic block is detached from the CFG/AUM or when a placeholder is erased from the CFG.
     // The call happens immediately after the CFG/AUM are updated.
     void bblockDetached(rose_addr_t startVa, const BasicBlock::Ptr &removedBlock);
+
+    // Function call graph maintenance. The outgoing edges of a vertex changed, the owning functions of a vertex changed (which
+    // also changes the calls of its predecessors), a function was attached or detached, or everything must be recomputed.
+    void functionCallGraphVertexChanged(rose_addr_t startVa) const;
+    void functionCallGraphOwnersChanged(const ControlFlowGraph::ConstVertexIterator &vertex) const;
+    void functionCallGraphFunctionChanged(const Function::Ptr &function) const;
+    void invalidateFunctionCallGraph() const;
+
+    // Calls contributed by the outgoing edges of one basic block vertex, and bringing cgCache_ up to date.
+    void functionCallGraphCalls(const ControlFlowGraph::ConstVertexIterator &vertex, std::vector<CallGraphCall> &calls) const;
+    void updateFunctionCallGraph() const;
 };
 
 } // namespace
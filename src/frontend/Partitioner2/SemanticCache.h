@@ -0,0 +1,124 @@
+#ifndef ROSE_Partitioner2_SemanticCache_H
+#define ROSE_Partitioner2_SemanticCache_H
+
+#include <Partitioner2/BasicBlock.h>
+
+#include <boost/thread/mutex.hpp>
+#include <Sawyer/Map.h>
+#include <Sawyer/SharedPointer.h>
+
+#include <list>
+#include <vector>
+
+namespace rose {
+namespace BinaryAnalysis {
+namespace Partitioner2 {
+
+/** Bounded cache of basic block semantic states.
+ *
+ *  When a partitioner drops the semantics of a basic block (see @ref Partitioner::basicBlockSemanticsAutoDrop), the block's
+ *  initial and final states can be saved here first, and later restored into the block without processing its instructions
+ *  again.  The states are indexed by the block's starting address and are only restored into a block that has the same
+ *  instruction addresses and bytes as the block from which they were saved.
+ *
+ *  The size of the cache is limited by the total number of instructions of the cached blocks, which is a reasonable proxy
+ *  for the number of symbolic expressions held by their states (see @ref maxInstructions). When the limit is exceeded the
+ *  least recently used states are evicted.  A limit of zero disables the cache, which is the default.
+ *
+ *  All methods are thread safe. */
+class SemanticCache: public Sawyer::SharedObject {
+public:
+    /** Shared-ownership pointer to a @ref SemanticCache. See @ref heap_object_shared_ownership. */
+    typedef Sawyer::SharedPointer<SemanticCache> Ptr;
+
+private:
+    typedef std::list<rose_addr_t> LruList;             // least recently used at the front
+
+    struct Entry {
+        std::vector<rose_addr_t> insnVas;               // instruction addresses of the block
+        std::vector<uint8_t> insnBytes;                 // instruction bytes of the block, concatenated
+        BaseSemantics::StatePtr initialState;
+        BaseSemantics::StatePtr finalState;             // never handed out; restored blocks get a copy
+        LruList::iterator lru;
+    };
+
+    typedef Sawyer::Container::Map<rose_addr_t, Entry> Entries;
+
+    mutable boost::mutex mutex_;                        // protects the following data members
+    Entries entries_;
+    LruList lru_;
+    size_t nInsns_;                                     // total number of instructions for all entries
+    size_t maxInsns_;                                   // eviction threshold, or zero to disable the cache
+    size_t nHits_, nMisses_;
+
+protected:
+    explicit SemanticCache(size_t maxInsns)
+        : nInsns_(0), maxInsns_(maxInsns), nHits_(0), nMisses_(0) {}
+
+public:
+    /** Allocating constructor. */
+    static Ptr instance(size_t maxInsns = 0) {
+        return Ptr(new SemanticCache(maxInsns));
+    }
+
+    /** Property: Maximum number of instructions.
+     *
+     *  This is the total number of instructions of all the basic blocks whose semantics are cached.  Reducing the limit evicts
+     *  states immediately, and setting it to zero disables the cache and empties it.
+     *
+     * @{ */
+    size_t maxInstructions() const;
+    void maxInstructions(size_t n);
+    /** @} */
+
+    /** Whether the cache is enabled.
+     *
+     *  The cache is enabled if its @ref maxInstructions property is non-zero. */
+    bool isEnabled() const { return maxInstructions() > 0; }
+
+    /** Save the semantics of a basic block.
+     *
+     *  If the block has semantics (they've not been dropped, and no semantic error occurred) then its initial state and a copy
+     *  of its final state are saved, replacing any states saved for another block at the same address.  Returns true if the
+     *  states were saved.  Blocks with more instructions than the whole cache allows are not saved. */
+    bool insert(const BasicBlock::Ptr&);
+
+    /** Restore the semantics of a basic block.
+     *
+     *  If the block's semantics have been dropped and states were saved for a block with the same instructions, then the
+     *  states are restored into the block (see @ref BasicBlock::restoreSemantics) and true is returned. */
+    bool restore(const BasicBlock::Ptr&);
+
+    /** Forget the states saved for the block at the specified address, if any. */
+    void erase(rose_addr_t startVa);
+
+    /** Forget all saved states. */
+    void clear();
+
+    /** Number of blocks whose states are saved. */
+    size_t size() const;
+
+    /** Number of instructions of the blocks whose states are saved. */
+    size_t nInstructions() const;
+
+    /** Number of successful and unsuccessful calls to @ref restore.
+     *
+     *  Calls for blocks whose semantics were not dropped are not counted.
+     *
+     * @{ */
+    size_t nHits() const;
+    size_t nMisses() const;
+    /** @} */
+
+private:
+    static void signature(const BasicBlock::Ptr&, std::vector<rose_addr_t> &insnVas /*out*/,
+                          std::vector<uint8_t> &insnBytes /*out*/);
+    void eraseLocked(rose_addr_t startVa);
+    void evictLocked();
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -216,6 +216,12 @@ public:
 /** Return the next serial number. */
 size_t serialNumber();
 
+/** Attribute that caches a fingerprint.
+ *
+ *  Returns the ID of the attribute under which basic blocks and functions store the 64-bit fingerprint computed by the
+ *  specified algorithm. See @ref Partitioner::basicBlockFingerprint. */
+Sawyer::Attribute::Id fingerprintAttributeId(FingerprintAlgorithm);
+
 
 
 } // namespace
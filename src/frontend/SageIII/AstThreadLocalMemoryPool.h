@@ -0,0 +1,76 @@
+#ifndef AST_THREAD_LOCAL_MEMORY_POOL_H
+#define AST_THREAD_LOCAL_MEMORY_POOL_H
+
+// Per thread arenas for the memory pools of the IR nodes.
+//
+// The operator new and operator delete generated by ROSETTA for every IR node class take the IR nodes from one
+// global memory pool per class, without any synchronization. Between AstThreadLocalMemoryPool::beginParallelConstruction()
+// and AstThreadLocalMemoryPool::endParallelConstruction() the generated operators instead use an arena that belongs
+// to the calling thread: a thread takes a whole memory pool block worth of IR nodes from the global memory pool at once
+// (under a lock), hands them out without any locking, and keeps the IR nodes it deletes for reuse. The IR nodes always
+// stay within the blocks of the global memory pools, so the memory pool traversals see every IR node that was
+// built (the free entries of an arena are not marked as valid and are skipped, as the free entries of the global pool).
+//
+// At a fence (endParallelConstruction(), or fence() while no IR nodes are allocated concurrently) the free IR nodes of
+// all arenas are returned to the global memory pools. AST_FILE_IO calls fence() before it writes or clears the memory
+// pools. The arena of a thread that terminates is returned to the global memory pools as well.
+//
+// Typical use:
+//      AstThreadLocalMemoryPool::beginParallelConstruction();
+//      ... start threads that build IR nodes (e.g. using SageBuilder), join them ...
+//      AstThreadLocalMemoryPool::endParallelConstruction();
+
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+class SgNode;
+
+class ROSE_DLL_API AstThreadLocalMemoryPool
+   {
+     public:
+       // The operator new and operator delete of the global memory pool of an IR node class (generated by ROSETTA).
+          typedef void* (*GlobalAllocateFunction) ( size_t size );
+          typedef void  (*GlobalDeallocateFunction) ( void* pointer, size_t size );
+
+          AstThreadLocalMemoryPool ( size_t nodeSize, size_t blockSize, GlobalAllocateFunction globalAllocate, GlobalDeallocateFunction globalDeallocate );
+
+       // Called by the generated operator new and operator delete while isActive() is true.
+          void* allocate ();
+          void deallocate ( void* pointer );
+
+       // Start and end of a section of the program in which IR nodes may be built from several threads. The threads
+       // must be started after beginParallelConstruction() and joined before endParallelConstruction().
+          static void beginParallelConstruction ();
+          static void endParallelConstruction ();
+          static bool isActive ();
+
+       // Return the free IR nodes of all arenas to the global memory pools. No other thread may allocate or delete IR
+       // nodes while this runs.
+          static void fence ();
+
+       // Lock protecting the global memory pools while isActive() is true.
+          static boost::mutex & globalMemoryPoolMutex ();
+
+     private:
+          struct ThreadArenas;
+
+          static ThreadArenas & threadArenas ();
+          static void releaseThreadArenas ( ThreadArenas* arenas );
+          static std::vector<AstThreadLocalMemoryPool*> & listOfMemoryPools ();
+          static std::vector<ThreadArenas*> & listOfThreadArenas ();
+
+          void refill ( SgNode* & freeList );
+          void release ( SgNode* & freeList );
+
+          size_t nodeSize;
+          size_t blockSize;
+          GlobalAllocateFunction globalAllocate;
+          GlobalDeallocateFunction globalDeallocate;
+          size_t poolIndex;
+
+       // not copyable
+          AstThreadLocalMemoryPool ( const AstThreadLocalMemoryPool & );
+          AstThreadLocalMemoryPool & operator= ( const AstThreadLocalMemoryPool & );
+   };
+
+#endif
@@ -7,6 +7,9 @@
  */
 
 #include <exception>
+#include <string>
+#include <vector>
+#include <stddef.h>
 #include "rosedll.h"
 using namespace std;
 
@@ -66,6 +69,26 @@ public:
      */
     static string getUtf8String(int value);
 
+    /**
+     * Convert a sequence of "count" unicode characters into its Utf8 representation.
+     * Runs of ASCII characters are copied without going through getUtf8String(int).
+     */
+    static string getUtf8String(const unsigned short *values, size_t count);
+
+    /**
+     * Check whether the "size" bytes starting at "bytes" are a sequence of Utf8
+     * characters that getUnicodeValues() accepts (i.e., that it does not throw on).
+     * ASCII bytes are checked one machine word at a time.
+     */
+    static bool isValid(const char *bytes, size_t size);
+
+    /**
+     * Compute the code values of all the Unicode characters encoded in UTF8 format
+     * in the string "str" and append them to "values".  Runs of ASCII characters are
+     * decoded one machine word at a time.
+     */
+    static void getUnicodeValues(const string &str, vector<int> &values);
+
     /**
      * Convert the Unicode "value" into a printable Unicode character.
      *
@@ -0,0 +1,39 @@
+#ifndef AST_FILE_IO_FILE_INDEX_H
+#define AST_FILE_IO_FILE_INDEX_H
+
+// Per source file index for binary AST files (AST_FILE_IO).
+//
+// A binary AST written with AstFileIOFileIndex::writeASTToFile() contains, for every SgSourceFile, the global
+// indices (as used by AST_FILE_IO) of the IR nodes that the file needs: the nodes reachable from the SgSourceFile
+// through any data member except the parent pointers (so this includes the shared types, symbols and declarations
+// the file refers to), plus the SgFileList and SgProject above it. AstFileIOFileIndex::readASTFromFile() uses the
+// index to rebuild only the IR nodes needed by the listed files. The memory pool slots of the other IR nodes are
+// released again, and parent pointers into the parts that were not loaded (and the entries of the SgFileList for
+// the files that were not loaded) are reset afterwards.
+//
+// Files written with AST_FILE_IO::writeASTToFile() have an empty index and can only be read completely.
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class SgProject;
+
+class ROSE_DLL_API AstFileIOFileIndex
+   {
+     public:
+       // Write the AST held in the memory pools, including the per file index.
+          static void writeASTToFile ( const std::string & fileName );
+
+       // Read only the IR nodes needed by the listed source files (names as returned by SgFile::getFileName()).
+          static SgProject* readASTFromFile ( const std::string & fileName, const std::vector<std::string> & sourceFileNames );
+
+       // Support for the code generated by ROSETTA in AST_FILE_IO::writeASTToFile() and AST_FILE_IO::readASTFromFile().
+          static void writeIndex ( std::ostream & out );
+          static void readIndex ( std::istream & in );
+          static bool isSelected ( unsigned long globalIndex );
+          static void skipNode ( void* memoryPoolSlot );
+          static void* popSkippedNode ();
+   };
+
+#endif
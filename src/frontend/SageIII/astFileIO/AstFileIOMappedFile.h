@@ -0,0 +1,73 @@
+#ifndef AST_FILE_IO_MAPPED_FILE_H
+#define AST_FILE_IO_MAPPED_FILE_H
+
+// Memory mapped input for the AST file I/O (AST_FILE_IO).
+//
+// The binary AST file contains, for every non-abstract IR node class, one array of StorageClass objects. The
+// writer generated by ROSETTA (see buildAstFileIO.C) places each of these arrays at a file offset that is a
+// multiple of STORAGE_ALIGNMENT (a page) and records the layout version right behind the AST_FILE_IO header.
+// If the file is read through AstFileIOMappedFile::readASTFromFile() the reader uses the StorageClass arrays in
+// place within a private (copy on write) mapping of the file instead of allocating a heap buffer for every
+// memory pool and copying the data with istream::read(). The IR nodes are still rebuilt from the StorageClass
+// objects by the generated reader, the pointers are fixed up memory pool by memory pool as before.
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <iosfwd>
+#include <string>
+
+class SgProject;
+
+class ROSE_DLL_API AstFileIOMappedFile
+   {
+     public:
+       // Layout of the StorageClass arrays within the file; the version is increased whenever the layout changes.
+          enum { STORAGE_ALIGNMENT = 4096 };
+          enum { LAYOUT_VERSION = 1 };
+
+       // Maps the file and makes this the current mapping until the object is destroyed.
+          explicit AstFileIOMappedFile ( const std::string & fileName );
+         ~AstFileIOMappedFile ();
+
+       // Read a binary AST file using the mapped input; same result as AST_FILE_IO::readASTFromFile().
+          static SgProject* readASTFromFile ( const std::string & fileName );
+
+       // The mapping the generated reader should use, NULL if the file is read with the stream only.
+          static AstFileIOMappedFile* current ();
+
+          const char* data () const;
+          size_t size () const;
+
+       // Support for the code generated by ROSETTA in AST_FILE_IO::writeASTToFile() and AST_FILE_IO::readASTFromFile().
+          static void writeLayoutHeader ( std::ostream & out );
+          static void readLayoutHeader ( std::istream & in );
+          static void alignOutput ( std::ostream & out );
+          static void alignInput ( std::istream & in );
+
+       // Returns a pointer to the next numberOfElements objects of the stream within the current mapping and advances
+       // the stream behind them, or returns NULL (without touching the stream) if there is no current mapping.
+          template <class T>
+          static T* mapArray ( std::istream & in, size_t numberOfElements )
+             {
+               return static_cast<T*>(mapBytes(in,numberOfElements * sizeof(T)));
+             }
+
+       // Counterpart of mapArray, releases an array that was either mapped or allocated with new [].
+          template <class T>
+          static void releaseArray ( T* array )
+             {
+               if (current() == NULL)
+                    delete [] array;
+             }
+
+     private:
+          static void* mapBytes ( std::istream & in, size_t numberOfBytes );
+
+          boost::iostreams::mapped_file mappedFile;
+          AstFileIOMappedFile* previous;
+
+       // not copyable
+          AstFileIOMappedFile ( const AstFileIOMappedFile & );
+          AstFileIOMappedFile & operator= ( const AstFileIOMappedFile & );
+   };
+
+#endif
@@ -52,6 +52,10 @@ class MangledNameMapTraversal : public ROSE_VisitTraversal
        // The delete list is just a set
           typedef std::set<SgNode*> SetOfNodesType;
 
+       // Maps each IR node added to the mangled name map to the IR node the map holds for its mangled name (the IR
+       // node itself, or the shared IR node that replaces it), so that the mangled names are not recomputed later.
+          typedef rose_hash::unordered_map<SgNode*, SgNode*> RepresentativeMapType;
+
           int numberOfNodes;
           int numberOfNodesSharable;
           int numberOfNodesEvaluated;
@@ -62,6 +66,7 @@ class MangledNameMapTraversal : public ROSE_VisitTraversal
           MangledNameMapType & mangledNameMap;
           SetOfNodesType     & setOfNodesToDelete;
           SetOfNodesType     setOfNodesPreviouslyVisited;
+          RepresentativeMapType representativeMap;
 
           void visit ( SgNode* node);
           void addToMap ( std::string key, SgNode* node);
@@ -81,4 +86,8 @@ class MangledNameMapTraversal : public ROSE_VisitTraversal
 
 void generateMangledNameMap (MangledNameMapTraversal::MangledNameMapType & mangledMap, MangledNameMapTraversal::SetOfNodesType & setOfIRnodesToDelete );
 
+// Also returns the representative of each IR node added to the mangled name map (see replacementMapTraversal()).
+void generateMangledNameMap (MangledNameMapTraversal::MangledNameMapType & mangledMap, MangledNameMapTraversal::SetOfNodesType & setOfIRnodesToDelete,
+                             MangledNameMapTraversal::RepresentativeMapType & representativeMap );
+
 #endif // ROSE_BUILD_MANGLED_NAME_MAP_H
@@ -66,9 +66,13 @@ class ReplacementMapTraversal : public ROSE_VisitTraversal
        // Record all One-time Definition Rule (ODR) violations
           ODR_ViolationType odrViolations;
 
+       // The shared IR node of the IR nodes in the representative map (if any) is taken from it.
+          const MangledNameMapTraversal::RepresentativeMapType* representativeMap;
+
        // DQ (2/19/2007): Modified to permit replacement map to be built externally and updated
        // ReplacementMapTraversal( MangledNameMapTraversal::MangledNameMapType & inputMangledNameMap, ListToDeleteType & inputDeleteList );
-          ReplacementMapTraversal( MangledNameMapTraversal::MangledNameMapType & inputMangledNameMap, ReplacementMapType & replacementMap, ListToDeleteType & inputDeleteList );
+          ReplacementMapTraversal( MangledNameMapTraversal::MangledNameMapType & inputMangledNameMap, ReplacementMapType & replacementMap, ListToDeleteType & inputDeleteList,
+                                   const MangledNameMapTraversal::RepresentativeMapType* inputRepresentativeMap = NULL );
 
           void visit ( SgNode* node);
 
@@ -97,5 +101,15 @@ replacementMapTraversal (
    ReplacementMapTraversal::ReplacementMapType & replacementMap,
    ReplacementMapTraversal::ODR_ViolationType  & violations,
    ReplacementMapTraversal::ListToDeleteType   & deleteList );
+
+// Uses the representative map built by generateMangledNameMap() to avoid computing the
+// mangled names of the IR nodes in the mangled name map a second time.
+void
+replacementMapTraversal (
+   MangledNameMapTraversal::MangledNameMapType & mangledNameMap,
+   const MangledNameMapTraversal::RepresentativeMapType* representativeMap,
+   ReplacementMapTraversal::ReplacementMapType & replacementMap,
+   ReplacementMapTraversal::ODR_ViolationType  & violations,
+   ReplacementMapTraversal::ListToDeleteType   & deleteList );
 #endif
 
@@ -75,6 +75,9 @@
 // DQ (11/14/2015): This corrects inconstancies in the setting of flags in the Sg_File_Info objects.
 #include "fixupFileInfoFlags.h"
 
+// Runs the post-processing passes that do not depend on each other as one (fused) traversal of the AST.
+#include "fusedAstPostProcessing.h"
+
 /*! \brief Postprocessing that is not likely to be handled in the EDG/Sage III translation.
  */
 void postProcessingSupport (SgNode* node);
@@ -93,6 +96,40 @@ void postProcessingSupport (SgNode* node);
  */
 ROSE_DLL_API void AstPostProcessing(SgNode* node);
 
+/*! \brief Selects the AST invariants that the post-processing establishes (for the C and C++ frontend).
+
+    Analysis-only tools that never unparse can declare (before calling frontend()) that they only need the
+    parent pointers and symbol tables, e.g.
+
+         AstPostProcessingProfile::set_requiredInvariants(AstPostProcessingProfile::e_parentPointers | AstPostProcessingProfile::e_symbolTables);
+
+    The fixups that only establish the other invariants (the source position fixups, the marking of the templates
+    and default arguments for output, ...) are then deferred: they are run by runDeferredFixups(), called by the
+    unparser before the first file is unparsed. The parent pointers and symbol tables are always fixed up.
+ */
+class ROSE_DLL_API AstPostProcessingProfile
+   {
+     public:
+          enum Invariant
+             {
+               e_parentPointers  = 0x1, //!< parent pointers of the AST and of the IR nodes in the memory pools
+               e_symbolTables    = 0x2, //!< symbol tables, defining and non-defining declarations and template names
+               e_sourcePositions = 0x4, //!< consistent source positions (end of constructs, logical and physical positions)
+               e_codeGeneration  = 0x8, //!< templates, default arguments and macros marked for output in the generated code
+               e_allInvariants   = 0xf
+             };
+
+       // The default is e_allInvariants (nothing is deferred).
+          static void set_requiredInvariants ( unsigned invariants );
+          static unsigned get_requiredInvariants ();
+
+       // Invariants not established by the last post-processing yet.
+          static unsigned get_deferredInvariants ();
+
+       // Runs the deferred fixups on the AST they were deferred for (does nothing if there are none).
+          static void runDeferredFixups ();
+   };
+
 
 #if 0
 // DQ (4/26/2013): Test constructed to detect problems with where default arguments are marked.
@@ -9,5 +9,19 @@
  *  compiler-generated. */
 size_t checkIsCompilerGeneratedFlag(SgNode *ast);
 
+/** Traversal used by checkIsCompilerGeneratedFlag() (preorder). It is also registered with FusedAstPostProcessing so that it
+ *  can share one traversal of the AST with other post-processing passes. */
+class CheckIsCompilerGeneratedFlag: public AstSimpleProcessing {
+public:
+    size_t nviolations;
+    CheckIsCompilerGeneratedFlag(): nviolations(0) {}
+
+protected:
+    void visit(SgNode *node);
+
+private:
+    void fix(SgNode *node, Sg_File_Info *finfo);
+};
+
 #endif
 
@@ -7,5 +7,22 @@
  *  in the AST that is frontend-specific.   All violations are fixed in place.  Returns the number of violations found/fixed. */
 size_t checkIsFrontendSpecificFlag(SgNode *ast);
 
+/** Traversal used by checkIsFrontendSpecificFlag(). It is also registered with FusedAstPostProcessing so that it can share
+ *  one traversal of the AST with other post-processing passes. */
+class CheckIsFrontendSpecificFlag: public AstPrePostProcessing {
+public:
+    size_t nviolations;
+    CheckIsFrontendSpecificFlag(): nviolations(0), fes_ast(NULL) {}
+
+protected:
+    void preOrderVisit(SgNode *node);
+    void postOrderVisit(SgNode *node);
+
+private:
+    SgNode *fes_ast; // top node of frontend-specific AST
+    bool is_frontend_specific(Sg_File_Info *finfo);
+    void fix(SgNode *node, Sg_File_Info *finfo);
+};
+
 
 #endif
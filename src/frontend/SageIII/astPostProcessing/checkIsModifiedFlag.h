@@ -17,5 +17,12 @@ ROSE_DLL_API void unsetNodesMarkedAsModified(SgNode *node);
 // a different function in the near future.
 bool checkIsModifiedFlag(SgNode *node);
 
+//! Traversal used by unsetNodesMarkedAsModified() (preorder), it only resets the isModified flag of the visited node.
+class UnsetNodesMarkedAsModified : public AstSimpleProcessing
+   {
+     protected:
+          void visit (SgNode* node);
+   };
+
 // endif for CHECK_ISMODIFIED_FLAG_H
 #endif
@@ -7,5 +7,20 @@
  *  */
 size_t checkPhysicalSourcePosition(SgNode *ast);
 
+/** Traversal used by checkPhysicalSourcePosition() (preorder), it only looks at the visited node.
+ *  */
+class CheckPhysicalSourcePosition : public AstSimpleProcessing
+   {
+     public:
+          size_t nviolations;
+          CheckPhysicalSourcePosition() : nviolations(0) {}
+
+     protected:
+          void visit(SgNode *node);
+
+     private:
+          void check(SgNode *node, Sg_File_Info *finfo);
+   };
+
 #endif
 
@@ -8,6 +8,11 @@ void detectTransformations( SgNode* node );
 
 void detectTransformations_local( SgNode* node );
 
+/*! \brief The memory pool part of detectTransformations(): reports Sg_File_Info objects marked as a transformation
+           anywhere in the memory pool (not just in the AST).
+ */
+void detectTransformationsInMemoryPool();
+
 /*! \brief There sould not be any IR nodes marked as a transformation coming from the EDG/ROSE translation.
            This test enforces this.
 
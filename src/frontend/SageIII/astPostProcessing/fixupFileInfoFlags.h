@@ -9,5 +9,20 @@
  *  */
 size_t fixupFileInfoInconsistanties(SgNode *ast);
 
+/** Traversal used by fixupFileInfoInconsistanties() (preorder).
+ *
+ *  Only the Sg_File_Info objects of the visited node are changed, so it can share one traversal of the AST with other
+ *  post-processing passes (see FusedAstPostProcessing).
+ *  */
+class FixupFileInfoInconsistanties : public AstSimpleProcessing
+   {
+     public:
+          size_t nviolations;
+          FixupFileInfoInconsistanties() : nviolations(0) {}
+
+     protected:
+          void visit(SgNode *node);
+   };
+
 #endif
 
@@ -0,0 +1,51 @@
+#ifndef FUSED_AST_POST_PROCESSING_H
+#define FUSED_AST_POST_PROCESSING_H
+
+/*! \brief Runs a sequence of AST post-processing passes, fusing consecutive traversals into one traversal of the AST.
+
+    Passes are registered in the order in which they have to run.  Consecutive traversals (AstSimpleProcessing
+    traversals, which are visited in preorder, and AstPrePostProcessing traversals) are run together as one
+    AstCombinedPrePostProcessing traversal; at each IR node the traversals are called in the order in which they
+    were registered, so a traversal sees the changes that the earlier traversals made to the visited node (and to the
+    nodes visited before it).  A pass registered with addPass() (memory pool traversals, traversals using inherited
+    attributes, passes working on data collected over the whole AST) always runs on its own.
+
+    Two traversals are not fused when the dependency table (see mustRunSeparately()) says that the later one depends
+    on changes the earlier one makes to IR nodes that are visited before the node being processed (e.g. a parent).
+
+    \internal The registered traversals are owned by the caller.
+ */
+class FusedAstPostProcessing
+   {
+     public:
+          typedef void (*PassFunction) ( SgNode* node );
+
+       //! Register a traversal that may be fused with the neighbouring traversals.
+          void addTraversal ( const std::string & name, AstSimpleProcessing* traversal );
+          void addTraversal ( const std::string & name, AstPrePostProcessing* traversal );
+
+       //! Register a pass that always runs on its own (it also separates the traversals before and after it).
+          void addPass ( const std::string & name, PassFunction pass );
+
+       //! Run all registered passes on the AST rooted at node.
+          void run ( SgNode* node );
+
+       //! True if the pass named later must not share a traversal with the (earlier) pass named earlier.
+          static bool mustRunSeparately ( const std::string & earlier, const std::string & later );
+
+     private:
+          struct Pass
+             {
+               std::string name;
+               AstSimpleProcessing* simpleTraversal;
+               AstPrePostProcessing* prePostTraversal;
+               PassFunction function;
+             };
+
+          void runFusedTraversal ( SgNode* node, size_t begin, size_t end );
+
+          std::vector<Pass> passes;
+   };
+
+// endif for FUSED_AST_POST_PROCESSING_H
+#endif
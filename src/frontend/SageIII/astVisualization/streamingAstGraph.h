@@ -0,0 +1,86 @@
+#ifndef STREAMING_AST_GRAPH_H
+#define STREAMING_AST_GRAPH_H
+
+#include <iosfwd>
+#include <set>
+#include <string>
+
+// Streaming export of the AST (tree edges only) as a DOT or GraphML graph.
+//
+// AstDOTGeneration and generateWholeGraphOfAST() collect all nodes and edges (as strings) before anything is written,
+// which does not scale to real translation units, and the resulting files are often too large for a viewer anyway.
+// StreamingAstGraphWriter writes every node and edge to the output stream as soon as it is visited, using memory
+// proportional to the depth of the AST only (nodes are numbered in the order they are written, so no map from nodes
+// to names is needed). The output can be bounded by
+//   - a budget on the total number of nodes written,
+//   - a maximum depth below the root of the export,
+//   - a maximum number of children written for any single node (wide lists such as global scopes),
+//   - a set of variants whose nodes (and subtrees) are not written.
+// Where a budget cuts off children of a node a placeholder node "... (n more)" is written, so the graph shows what
+// was left out. writeNeighborhood() writes only the part of the AST around one node, which is useful to look at a
+// single node of an AST far too large to be viewed as a whole.
+//
+// Typical use:
+//      std::ofstream output("around.dot");
+//      StreamingAstGraphWriter writer(output);
+//      writer.set_maximumNumberOfNodes(2000);
+//      writer.skipVariant(V_SgFileInfo);
+//      writer.writeNeighborhood(suspiciousNode,3);
+
+class ROSE_DLL_API StreamingAstGraphWriter
+   {
+     public:
+          enum OutputFormat
+             {
+               DOT_FORMAT,
+               GRAPHML_FORMAT
+             };
+
+          StreamingAstGraphWriter ( std::ostream & output, OutputFormat format = DOT_FORMAT );
+
+       // Budgets, 0 means no limit (the default for all of them).
+          void set_maximumNumberOfNodes ( size_t n ) { maximumNumberOfNodes = n; }
+          void set_maximumDepth ( size_t depth ) { maximumDepth = depth; }
+          void set_maximumNumberOfChildren ( size_t n ) { maximumNumberOfChildren = n; }
+
+       // Nodes of this variant and their subtrees are not written.
+          void skipVariant ( VariantT variant ) { skippedVariants.insert(variant); }
+
+       // Write the subtree of root as one complete graph.
+          void writeGraph ( SgNode* root );
+
+       // Write the chain of the (at most) radius ancestors of node, and the subtree of node down to depth radius,
+       // as one complete graph. The node itself is highlighted.
+          void writeNeighborhood ( SgNode* node, size_t radius );
+
+       // Statistics of the last graph written.
+          size_t get_numberOfNodesWritten() const { return numberOfNodesWritten; }
+          bool get_truncated() const { return truncated; }
+
+     private:
+          void writeHeader();
+          void writeFooter();
+          size_t writeNode ( SgNode* node, bool highlight );
+          size_t writePlaceholderNode ( size_t numberOfOmittedNodes );
+          void writeEdge ( size_t source, size_t target, const std::string & label );
+
+       // Write the subtree of root (with root numbered rootNumber already written) down to maximumDepth levels.
+          void writeSubtree ( SgNode* root, size_t rootNumber, size_t maximumDepth );
+
+          bool budgetExhausted() const;
+          std::string quote ( const std::string & s ) const;
+
+          std::ostream & output;
+          OutputFormat format;
+
+          size_t maximumNumberOfNodes;
+          size_t maximumDepth;
+          size_t maximumNumberOfChildren;
+          std::set<VariantT> skippedVariants;
+
+          size_t numberOfNodesWritten;
+          size_t nextNodeNumber;
+          bool truncated;
+   };
+
+#endif
@@ -26,6 +26,9 @@ ROSE_DLL_API void generateGraphOfAST( SgProject* project, std::string filename,
 
 ROSE_DLL_API void generateGraphOfAST( SgProject* project, std::string filename );
 
+// Streaming (size bounded) export of the AST as DOT or GraphML, for ASTs too large for the generators above.
+#include "streamingAstGraph.h"
+
 // Include debugging visualization support used for AST Copy and AST Outlining (when done to a separate file).
 #include "copyGraph.h"
 
@@ -90,6 +90,19 @@ namespace AtermSupport
   // Function for reading aterms and converting them to ROSE AST IR nodes.
      SgNode* generate_AST(ATerm & term);
 
+  // Streaming export and import of the aterm of an AST.  The writer does not build the aterm of the whole AST:
+  // the outer nodes (SgProject, SgFileList, SgSourceFile, SgGlobal and SgNamespaceDefinitionStatement) are written
+  // as records during the traversal, each of their other children is converted with convertNodeToAterm(), written
+  // as one record, and left for the aterm garbage collector before the next one is converted.  Each record is
+  // written in the shared textual format (TAF, repeated subterms such as types are written once) when
+  // shareSubterms is true, else in the plain textual format.  The reader rebuilds the same aterm as
+  // convertNodeToAterm(root) one record at a time (without reading the whole stream into memory first).
+     void writeAtermStream(std::ostream & output, SgNode* root, bool shareSubterms = true);
+     ATerm readAtermStream(std::istream & input);
+
+  // Reads a stream written by writeAtermStream() and builds the ROSE AST from it (returns NULL on a malformed stream).
+     SgNode* generate_AST(std::istream & input);
+
   // Generate a list of aterms from the input aterm.
      std::vector<ATerm> getAtermList(ATerm ls);
 
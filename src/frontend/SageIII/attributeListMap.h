@@ -47,6 +47,26 @@ class AttributeListMap {
        //called as an argument or as part of the macro definition corresponding to the macro call this data is *not* inside this variable.
           PreprocessingInfo::rose_macro_call* macro_call_to_expand;
           token_container currentTokSeq;
+          std::map<std::string,unsigned> macroIds;
+
+          unsigned macroId(const std::string& name);
+          void addMacroExpansionRange(const std::string& filename, uint64_t begin, uint64_t end, const std::string& name);
+
+       //End of the tokens of a macro call: the last token of the last argument (+1 for the closing parenthesis, which
+       //Wave does not give to the hooks) or the name of the macro.
+          template<typename TokenT, typename ContainerT>
+                  static uint64_t macroCallEnd(TokenT const& macrocall, std::vector<ContainerT> const& arguments){
+                          uint64_t end = packPosition(macrocall.get_position().get_line(),
+                                          macrocall.get_position().get_column() + macrocall.get_value().size());
+                          for(typename std::vector<ContainerT>::const_iterator arg = arguments.begin(); arg != arguments.end(); ++arg)
+                                  for(typename ContainerT::const_iterator tok = arg->begin(); tok != arg->end(); ++tok){
+                                          uint64_t tokEnd = packPosition(tok->get_position().get_line(),
+                                                          tok->get_position().get_column() + tok->get_value().size() + 1);
+                                          if(tokEnd > end)
+                                                  end = tokEnd;
+                                  }
+                          return end;
+                  }
 
        //For optimization and practical purposes a list of preprocessor attributes is created
        //for each file. Since the preprocessor does an auxiliary pass over the AST a map
@@ -67,6 +87,30 @@ class AttributeListMap {
   // DQ (4/13/2007): This is due to a bug in ROSE, or a misunderstanding about constant folded values and their source position information.
   // token_type lastOperator;
 
+       //A macro expansion in the compact mode (see recordMacroExpansionRangesOnly). The positions are packed by
+       //packPosition() so that comparing them compares (line, column) pairs; macroId indexes macroNames.
+          struct MacroExpansionRange {
+               uint64_t begin;
+               uint64_t end;
+               unsigned macroId;
+               bool operator<(const MacroExpansionRange& other) const { return begin < other.begin; }
+          };
+          typedef std::map<std::string,std::vector<MacroExpansionRange> > macro_range_map_type;
+
+       //If true the expansions of macros are only recorded as MacroExpansionRange's (per file, sorted by begin) instead of
+       //PreprocessingInfo::rose_macro_call objects with copies of the arguments and of the expansion.  This is enough to
+       //find the statements which are part of a macro expansion, see findMacroExpansions().  Default is false.
+          bool recordMacroExpansionRangesOnly;
+          macro_range_map_type macroExpansionRanges;
+          std::vector<std::string> macroNames;
+
+          static uint64_t packPosition(unsigned line, unsigned column) { return ((uint64_t)line << 32) | column; }
+
+       //Returns for each statement (which must be sorted by the position of their start) the index of the range of
+       //the file which contains its start, or -1. This is a single merge of the two sorted sequences. Expansions of
+       //macros in the arguments of another macro are nested in the range of the outer call and are not reported.
+          std::vector<int> findMacroExpansions(const std::string& filename, const std::vector<SgStatement*>& statements) const;
+
           AttributeListMap(SgFile* sageFilePtr);
 
           template <typename TokenT> bool found_include_directive(TokenT directive, std::string relname, std::string absname );
@@ -439,7 +483,11 @@ class AttributeListMap {
                        //DefinitionT is a ContextT::token_sequence_type which is the type of a token sequence defined in cpp_context
                        //    typedef std::list<token_type, boost::fast_pool_allocator<token_type> > token_sequence_type;
 
-                       if(rescan_macro_status==0){
+                       if(rescan_macro_status==0 && recordMacroExpansionRangesOnly){
+                               addMacroExpansionRange(std::string(macrocall.get_position().get_file().c_str()),
+                                               packPosition(macrocall.get_position().get_line(), macrocall.get_position().get_column()),
+                                               macroCallEnd(macrocall, arguments), std::string(macrocall.get_value().c_str()));
+                       }else if(rescan_macro_status==0){
 
                                if(SgProject::get_verbose() >= 1){
 
@@ -553,7 +601,13 @@ class AttributeListMap {
 
                        //have to implement mechanism to find macro definition here 
 
-                       if(rescan_macro_status==0){
+                       if(rescan_macro_status==0 && recordMacroExpansionRangesOnly){
+                               addMacroExpansionRange(std::string(macrocall.get_position().get_file().c_str()),
+                                               packPosition(macrocall.get_position().get_line(), macrocall.get_position().get_column()),
+                                               packPosition(macrocall.get_position().get_line(),
+                                                       macrocall.get_position().get_column() + macrocall.get_value().size()),
+                                               std::string(macrocall.get_value().c_str()));
+                       }else if(rescan_macro_status==0){
                                ROSE_ASSERT(macro_call_to_expand == NULL);
                                if(SgProject::get_verbose() >= 1)
                                        std::cout << "DEFINITION: " << boost::wave::util::impl::as_string(definition);
@@ -634,7 +688,7 @@ class AttributeListMap {
 #if 0
                        std::cout << "Rescanned macro: " << boost::wave::util::impl::as_string(result) << std::endl;
 #endif
-                       if(rescan_macro_status==0){
+                       if(rescan_macro_status==0 && !recordMacroExpansionRangesOnly){
                                ROSE_ASSERT(macro_call_to_expand != NULL);
 
                                copy (result.begin(), result.end(),
@@ -23,6 +23,12 @@ namespace MangledNameSupport
      extern setType visitedTemplateDefinitions;
 
      void outputVisitedTemplateDefinitions();
+
+  // The mangled qualifiers computed by mangleQualifiersToString() are kept for each scope (scopes with equal
+  // qualifiers share one copy of the string).  The cache has the same lifetime as the global mangled name cache
+  // (SgNode::get_globalMangledNameMap()) and the scope numbers used to mangle local scopes: it must be cleared
+  // when they are cleared.  Cached qualifiers of scopes that are marked as modified are recomputed.
+     void clearMangledQualifierCache();
    }
 
 std::string replaceNonAlphaNum (const std::string& s);
@@ -6,6 +6,8 @@
 //#include <list>
 //#include <vector>
 #include <map>
+#include <ostream>
+#include <string>
 
 // Include the ROSE lex specific definitions of tokens
 #include "general_token_defs.h"
@@ -117,6 +119,36 @@ typedef std::vector<std::list<token_type> > token_container_container;
 #endif
 
 //! For preprocessing information including source comments, #include , #if, #define, etc
+// Text of a comment or CPP directive.  The texts are interned: identical texts (such as the license comment at the top of
+// every header file of a project) share one copy, which is kept until the end of the process.  The text cannot be modified
+// in place, assigning a new text interns it.
+class ROSE_DLL_API PreprocessingText
+   {
+     private:
+          const std::string* text;
+
+     public:
+          PreprocessingText();
+          PreprocessingText( const std::string & s );
+          PreprocessingText( const char* s );
+
+          const std::string & str() const { return *text; }
+          operator const std::string & () const { return *text; }
+
+          const char* c_str() const { return text->c_str(); }
+          std::string::size_type size() const { return text->size(); }
+          std::string::size_type length() const { return text->length(); }
+          bool empty() const { return text->empty(); }
+       // Index up to and including size() (the terminating NUL), as the line counting loops do.
+          char operator[] ( std::string::size_type i ) const { return i < text->size() ? (*text)[i] : '\0'; }
+
+       // Number of distinct texts that were interned, and the bytes of their characters.
+          static size_t numberOfTexts();
+          static size_t numberOfBytes();
+   };
+
+ROSE_DLL_API std::ostream & operator<< ( std::ostream & os, const PreprocessingText & text );
+
 class  PreprocessingInfo
    {
      public:
@@ -236,7 +268,8 @@ class  PreprocessingInfo
 
        // Use string class to improve implementation
        // char* stringPointer;
-          std::string internalString;
+       // The text is interned, identical comments and directives share their characters.
+          PreprocessingText internalString;
 
           int   numberOfLines;
 
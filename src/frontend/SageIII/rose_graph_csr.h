@@ -0,0 +1,109 @@
+#ifndef ROSE_GRAPH_CSR_H
+#define ROSE_GRAPH_CSR_H
+
+// Frozen compressed sparse row (CSR) view of a graph built with the SgGraph IR nodes.
+//
+// SgGraph and SgIncidenceDirectedGraph keep their edges in hash multimaps of heap allocated nodes, and queries such as
+// SgIncidenceDirectedGraph::computeEdgeSetOut() return a newly built std::set for every call. Analyses that only read
+// a graph (call graphs, class hierarchy graphs, binary CFGs) can instead build a GraphCsrView once. The view numbers
+// the nodes 0 .. numberOfNodes()-1 in order of their SgGraphNode indices and stores, for every node, its outgoing and
+// its incoming edges in two contiguous arrays (in order of their SgGraphEdge indices), so iterating over the
+// successors or predecessors of a node does not allocate and touches consecutive memory.
+//
+// Every edge is seen as going from get_node_A() to get_node_B(), for a SgIncidenceUndirectedGraph as well; the
+// neighbors of a node in an undirected graph are its successors together with its predecessors. The view is not
+// updated when the graph changes, it must be rebuilt.
+//
+// Typical use:
+//      GraphCsrView csr(callGraph);
+//      for (size_t n = 0; n < csr.numberOfNodes(); n++)
+//           for (GraphCsrView::NodeRange s = csr.successors(n); !s.empty(); s.pop_front())
+//                visit(csr.node(n), csr.node(s.front()));
+
+#include <cstddef>
+#include <vector>
+
+class SgGraph;
+class SgGraphNode;
+class SgGraphEdge;
+
+class ROSE_DLL_API GraphCsrView
+   {
+     public:
+       // A range of elements within one of the arrays of the view, valid as long as the view.
+          template <class T>
+          class Range
+             {
+               public:
+                    typedef const T* const_iterator;
+
+                    Range() : first(NULL), last(NULL) {}
+                    Range(const T* begin, const T* end) : first(begin), last(end) {}
+
+                    const_iterator begin() const { return first; }
+                    const_iterator end() const { return last; }
+                    size_t size() const { return last - first; }
+                    bool empty() const { return first == last; }
+                    const T & front() const { return *first; }
+                    void pop_front() { ++first; }
+                    const T & operator[](size_t i) const { return first[i]; }
+
+               private:
+                    const T* first;
+                    const T* last;
+             };
+
+          typedef Range<size_t> NodeRange;
+          typedef Range<SgGraphEdge*> EdgeRange;
+
+       // Returned by position() for a node that is not in the view.
+          static const size_t NO_NODE = (size_t)(-1);
+
+       // Build the view of all the nodes and edges of the graph.
+          explicit GraphCsrView ( SgGraph* graph );
+
+          size_t numberOfNodes() const { return nodes.size(); }
+          size_t numberOfEdges() const { return outEdges.size(); }
+
+       // The node numbered n, and the number of a node (NO_NODE if the node was not in the graph).
+          SgGraphNode* node ( size_t n ) const { return nodes[n]; }
+          size_t position ( const SgGraphNode* node ) const;
+
+       // Numbers of the targets of the outgoing edges of node n, and the outgoing edges themselves (in the same order).
+          NodeRange successors ( size_t n ) const { return range(outTargets,outOffsets,n); }
+          EdgeRange edgesOut ( size_t n ) const { return range(outEdges,outOffsets,n); }
+
+       // Numbers of the sources of the incoming edges of node n, and the incoming edges themselves (in the same order).
+          NodeRange predecessors ( size_t n ) const { return range(inSources,inOffsets,n); }
+          EdgeRange edgesIn ( size_t n ) const { return range(inEdges,inOffsets,n); }
+
+          size_t outDegree ( size_t n ) const { return outOffsets[n+1] - outOffsets[n]; }
+          size_t inDegree ( size_t n ) const { return inOffsets[n+1] - inOffsets[n]; }
+
+       // Bytes used by the arrays of the view.
+          size_t memory_usage() const;
+
+     private:
+          template <class T>
+          static Range<T> range ( const std::vector<T> & elements, const std::vector<size_t> & offsets, size_t n )
+             {
+               if (offsets[n] == offsets[n+1])
+                    return Range<T>();
+               return Range<T>(&elements[offsets[n]], &elements[0] + offsets[n+1]);
+             }
+
+       // Nodes sorted by their index, and the sorted indices for position().
+          std::vector<SgGraphNode*> nodes;
+          std::vector<int> nodeIndices;
+
+       // Edges of node n are at [offsets[n], offsets[n+1]) of the edge and the node arrays.
+          std::vector<size_t> outOffsets;
+          std::vector<SgGraphEdge*> outEdges;
+          std::vector<size_t> outTargets;
+
+          std::vector<size_t> inOffsets;
+          std::vector<SgGraphEdge*> inEdges;
+          std::vector<size_t> inSources;
+   };
+
+#endif
@@ -94,6 +94,15 @@ namespace SageInterface
 //! An internal counter for generating unique SgName
 ROSE_DLL_API extern int gensym_counter;
 
+//! Count a change of the AST. Information cached from the AST, like the variant index of NodeQuery and the CFG cache of
+//! VirtualCFG, is recomputed once the count changes. The ROSETTA generated set_* functions of pointer data members, the
+//! SageBuilder functions that attach nodes to an existing AST, and the SageInterface functions that change the AST call it.
+//! Code that edits the lists of an IR node directly (e.g. get_statements().push_back()) must call it as well.
+ROSE_DLL_API void noteAstModification();
+
+//! The number of AST changes counted by noteAstModification()
+ROSE_DLL_API unsigned long getAstModificationCount();
+
 // tps : 28 Oct 2008 - support for finding the main interpretation
  SgAsmInterpretation* getMainInterpretation(SgAsmGenericFile* file);
 
@@ -174,6 +183,17 @@ struct hash_nodeptr
 // SgSymbol *lookupSymbolInParentScopes (const SgName & name, SgScopeStatement *currentScope, SgTemplateParameterPtrList* templateParameterList, SgTemplateArgumentPtrList* templateArgumentList);
    ROSE_DLL_API SgSymbol *lookupSymbolInParentScopes (const SgName & name, SgScopeStatement *currentScope = NULL, SgTemplateParameterPtrList* templateParameterList = NULL, SgTemplateArgumentPtrList* templateArgumentList = NULL);
 
+   //! Enable or disable caching of lookupSymbolInParentScopes() results; the cache is off by default and is cleared by this call.
+   /*! Only lookups without template parameters and arguments are cached. A cached result is reused while the symbol
+       tables of the searched scopes keep their sizes, so inserting or removing symbols in those scopes invalidates it.
+       Replacing a symbol (a removal followed by an insertion), deleting scopes or changing the parent of a scope is not
+       detected; call clearSymbolLookupCache() after such transformations. */
+   ROSE_DLL_API void setSymbolLookupCacheEnabled (bool enabled);
+   //! Whether lookupSymbolInParentScopes() results are cached.
+   ROSE_DLL_API bool isSymbolLookupCacheEnabled ();
+   //! Discard all cached lookupSymbolInParentScopes() results.
+   ROSE_DLL_API void clearSymbolLookupCache ();
+
    // DQ (11/24/2007): Functions moved from the Fortran support so that they could be called from within astPostProcessing.
    //!look up the first matched function symbol in parent scopes given only a function name, starting from top of ScopeStack if currentscope is not given or NULL
    ROSE_DLL_API SgFunctionSymbol *lookupFunctionSymbolInParentScopes (const SgName & functionName, SgScopeStatement *currentScope=NULL);
@@ -1661,6 +1681,9 @@ NodeType* getEnclosingNode(const SgNode* astNode, const bool includingSelf = fal
 //! Function to delete AST subtree's nodes only, users must take care of any dangling pointers, symbols or types that result.
 ROSE_DLL_API void deleteAST(SgNode* node);
 
+//! Delete a large AST subtree (e.g. the declarations from a header file) in bulk: the subtree is collected in a single traversal, the symbols of its declarations are removed from their symbol tables table by table (one memory pool pass instead of one per symbol), the nodes are deleted and the memory pool blocks left without any valid IR node are freed. Returns the number of bytes returned to the system. As for deleteAST(), users must take care of any remaining pointers into the subtree (including the parent's pointer to the subtree root).
+ROSE_DLL_API size_t deleteASTBulk(SgNode* node);
+
 //! Special purpose function for deleting AST expression tress containing valid original expression trees in constant folded expressions (for internal use only).
 ROSE_DLL_API void deleteExpressionTreeWithOriginalExpressionSubtrees(SgNode* root);
 
@@ -1962,6 +1985,35 @@ ROSE_DLL_API std::set<SgLocatedNode*> collectModifiedLocatedNodes( SgNode* node
  */
 ROSE_DLL_API void updateDefiningNondefiningLinks(SgFunctionDeclaration* func, SgScopeStatement* scope);
 
+//! Defers the defining and nondefining link updates of inserted function declarations while an instance is alive.
+/*! appendStatement(), prependStatement() and insertStatement() call updateDefiningNondefiningLinks() for every inserted
+ *  function declaration, and each call scans the whole scope, so generating many functions into one scope takes
+ *  quadratic time. While a batch is open, updateDefiningNondefiningLinks() only records the declaration; when the
+ *  outermost batch is closed (or flushed) the recorded declarations are grouped by scope and each scope is scanned
+ *  once. The links are computed against the contents of the scopes at that time, and declarations that were removed
+ *  from their scope in the meantime are ignored. Symbol table and parent pointer updates are still done immediately,
+ *  since the builder functions look up symbols created by earlier insertions.
+ *
+ *  Batches may be nested; only the outermost one applies the updates. This is not thread safe.
+ */
+class ROSE_DLL_API StatementInsertionBatch
+   {
+     public:
+          StatementInsertionBatch();
+          ~StatementInsertionBatch();
+
+       //! Apply the link updates recorded so far.
+          void flush();
+
+       //! Whether a batch is currently open.
+          static bool isOpen();
+
+     private:
+       // Not copyable.
+          StatementInsertionBatch(const StatementInsertionBatch&);
+          StatementInsertionBatch& operator=(const StatementInsertionBatch&);
+   };
+
 //------------------------------------------------------------------------
 //@{
 /*! @name Advanced AST transformations, analyses, and optimizations
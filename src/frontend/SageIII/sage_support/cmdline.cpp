@@ -24,6 +24,9 @@ using namespace rose;                                   // temporary, until this
  *  Variable Definitions
  *---------------------------------------------------------------------------*/
 ROSE_DLL_API int Rose::Cmdline::verbose = 0;
+ROSE_DLL_API int Rose::Cmdline::parallel_frontend_workers = 0;
+ROSE_DLL_API int Rose::Cmdline::parallel_unparse_workers = 0;
+ROSE_DLL_API std::string Rose::Cmdline::frontend_cache_directory;
 ROSE_DLL_API bool Rose::Cmdline::Java::Ecj::batch_mode = false;
 ROSE_DLL_API std::list<std::string> Rose::Cmdline::Fortran::Ofp::jvm_options;
 ROSE_DLL_API std::list<std::string> Rose::Cmdline::Java::Ecj::jvm_options;
@@ -313,6 +316,10 @@ CommandlineProcessing::isOptionTakingSecondParameter( string argument )
           argument == "-rose:o" ||                          // Used to specify output file to ROSE (alternative to -rose:output)
           argument == "-rose:compilationPerformanceFile" || // Use to output performance information about ROSE compilation phases
           argument == "-rose:verbose" ||                    // Used to specify output of internal information about ROSE phases
+          argument == "-rose:parallel_frontend" ||          // Number of processes used to parse the source files
+          argument == "-rose:parallel_unparse" ||           // Number of processes used to unparse the source files
+          argument == "-rose:frontend_cache" ||             // Directory of the persistent frontend cache
+          argument == "-rose:performance_trace" ||          // Chrome trace file of the ROSE compilation phases
           argument == "-rose:log" ||                        // Used to conntrol rose::Diagnostics
           argument == "-rose:assert" ||                     // Controls behavior of failed assertions
           argument == "-rose:test" ||
@@ -769,6 +776,10 @@ SgProject::processCommandLine(const vector<string>& input_argv)
         }
 
      Rose::Cmdline::ProcessKeepGoing(this, local_commandLineArgumentList);
+     Rose::Cmdline::ProcessParallelFrontend(this, local_commandLineArgumentList);
+     Rose::Cmdline::ProcessParallelUnparse(this, local_commandLineArgumentList);
+     Rose::Cmdline::ProcessFrontendCache(this, local_commandLineArgumentList);
+     Rose::Cmdline::ProcessPerformanceTrace(this, local_commandLineArgumentList);
 
   //
   // Standard compiler options (allows specification of language -x option to just run compiler without /dev/null as input file)
@@ -1618,6 +1629,112 @@ ProcessKeepGoing (SgProject* project, std::vector<std::string>& argv)
   }
 }
 
+void
+Rose::Cmdline::
+ProcessParallelFrontend (SgProject* project, std::vector<std::string>& argv)
+{
+  int number_of_workers = 0;
+  bool has_parallel_frontend =
+      CommandlineProcessing::isOptionWithParameter(
+          argv,
+          "-rose:",
+          "(parallel_frontend)",
+          number_of_workers,
+          true);
+
+  if (has_parallel_frontend)
+  {
+      if (SgProject::get_verbose() >= 1)
+          std::cout << "[INFO] [Cmdline] [-rose:parallel_frontend " << number_of_workers << "]" << std::endl;
+
+      if (number_of_workers < 0)
+      {
+          std::cout
+              << "[FATAL] "
+              << "Invalid argument to -rose:parallel_frontend; expecting a number of workers >= 0"
+              << std::endl;
+          exit(1);
+      }
+
+      Rose::Cmdline::parallel_frontend_workers = number_of_workers;
+  }
+}
+
+void
+Rose::Cmdline::
+ProcessParallelUnparse (SgProject* project, std::vector<std::string>& argv)
+{
+  int number_of_workers = 0;
+  bool has_parallel_unparse =
+      CommandlineProcessing::isOptionWithParameter(
+          argv,
+          "-rose:",
+          "(parallel_unparse)",
+          number_of_workers,
+          true);
+
+  if (has_parallel_unparse)
+  {
+      if (SgProject::get_verbose() >= 1)
+          std::cout << "[INFO] [Cmdline] [-rose:parallel_unparse " << number_of_workers << "]" << std::endl;
+
+      if (number_of_workers < 0)
+      {
+          std::cout
+              << "[FATAL] "
+              << "Invalid argument to -rose:parallel_unparse; expecting a number of processes >= 0"
+              << std::endl;
+          exit(1);
+      }
+
+      Rose::Cmdline::parallel_unparse_workers = number_of_workers;
+  }
+}
+
+void
+Rose::Cmdline::
+ProcessFrontendCache (SgProject* project, std::vector<std::string>& argv)
+{
+  std::string directory;
+  bool has_frontend_cache =
+      CommandlineProcessing::isOptionWithParameter(
+          argv,
+          "-rose:",
+          "(frontend_cache)",
+          directory,
+          true);
+
+  if (has_frontend_cache)
+  {
+      if (SgProject::get_verbose() >= 1)
+          std::cout << "[INFO] [Cmdline] [-rose:frontend_cache " << directory << "]" << std::endl;
+
+      Rose::Cmdline::frontend_cache_directory = directory;
+  }
+}
+
+void
+Rose::Cmdline::
+ProcessPerformanceTrace (SgProject* project, std::vector<std::string>& argv)
+{
+  std::string filename;
+  bool has_performance_trace =
+      CommandlineProcessing::isOptionWithParameter(
+          argv,
+          "-rose:",
+          "(performance_trace)",
+          filename,
+          true);
+
+  if (has_performance_trace)
+  {
+      if (SgProject::get_verbose() >= 1)
+          std::cout << "[INFO] [Cmdline] [-rose:performance_trace " << filename << "]" << std::endl;
+
+      AstPerformance::enableTrace(filename);
+  }
+}
+
 //------------------------------------------------------------------------------
 //                                  Unparser
 //------------------------------------------------------------------------------
@@ -3026,6 +3143,30 @@ SgFile::usage ( int status )
 "                             in order to gauage the overall status of your translator,\n"
 "                             with respect to that application.\n"
 "\n"
+"     -rose:parallel_frontend <N>\n"
+"                             parse the source files in N forked processes and\n"
+"                             merge the resulting ASTs (default: 0, serial frontend).\n"
+"                             Only used for C and C++ source files.\n"
+"\n"
+"     -rose:parallel_unparse <N>\n"
+"                             unparse the source files of the project in N forked\n"
+"                             processes (default: 0, serial unparsing).\n"
+"\n"
+"     -rose:frontend_cache <directory>\n"
+"                             keep the ASTs of the C and C++ source files in the\n"
+"                             directory and reuse them, instead of running the\n"
+"                             frontend, while the file, its command line and the\n"
+"                             headers it uses are unchanged.\n"
+"\n"
+"     -rose:compile_server <socket>\n"
+"                             stay loaded and run the compile requests received on\n"
+"                             the UNIX domain socket (sent by rose-compile-client),\n"
+"                             each one in a forked process; the other options are\n"
+"                             added to the command line of every request.\n"
+"     -rose:compile_server_jobs <N>\n"
+"                             run at most N compile requests at the same time\n"
+"                             (default: the number of processors).\n"
+"\n"
 "Operation modifiers:\n"
 "     -rose:output_warnings   compile with warnings mode on\n"
 "     -rose:C_only, -rose:C   follow C89 standard, disable C++\n"
@@ -3130,6 +3271,10 @@ SgFile::usage ( int status )
 "                             filename where compiler performance for internal\n"
 "                             phases (in CSV form) is placed for later\n"
 "                             processing (using script/graphPerformance)\n"
+"     -rose:performance_trace FILE\n"
+"                             filename where the timed phases of the compilation\n"
+"                             (frontend, AST fixups, analyses and unparsing) are\n"
+"                             written as a Chrome trace (chrome://tracing, Perfetto)\n"
 "     -rose:exit_after_parser just call the parser (C, C++, and fortran only)\n"
 "     -rose:skip_syntax_check skip Fortran syntax checking (required for F2003 and Co-Array Fortran code\n"
 "                             when using gfortran versions greater than 4.1)\n"
@@ -5511,6 +5656,12 @@ SgFile::stripRoseCommandLineOptions ( vector<string> & argv )
      int integerOption = 0;
      optionCount = sla(argv, "-rose:", "($)^", "(v|verbose)", &integerOption, 1);
      optionCount = sla(argv, "-rose:", "($)^", "(upc_threads)", &integerOption, 1);
+     optionCount = sla(argv, "-rose:", "($)^", "(parallel_frontend)", &integerOption, 1);
+     optionCount = sla(argv, "-rose:", "($)^", "(parallel_unparse)", &integerOption, 1);
+     char* frontendCacheDirectory = NULL;
+     optionCount = sla(argv, "-rose:", "($)^", "(frontend_cache)", frontendCacheDirectory, 1);
+     char* performanceTraceFile = NULL;
+     optionCount = sla(argv, "-rose:", "($)^", "(performance_trace)", performanceTraceFile, 1);
      optionCount = sla(argv, "-rose:", "($)", "(C|C_only)",1);
      optionCount = sla(argv, "-rose:", "($)", "(UPC|UPC_only)",1);
      optionCount = sla(argv, "-rose:", "($)", "(OpenMP|openmp)",1);
@@ -25,6 +25,15 @@ namespace Cmdline {
 
   extern ROSE_DLL_API int verbose;
 
+  //! Number of worker processes used by the frontend (-rose:parallel_frontend N), 0 for a serial frontend.
+  extern ROSE_DLL_API int parallel_frontend_workers;
+
+  //! Number of processes used by the unparser (-rose:parallel_unparse N), 0 for a serial unparser.
+  extern ROSE_DLL_API int parallel_unparse_workers;
+
+  //! Directory of the persistent frontend cache (-rose:frontend_cache <directory>), empty if not used.
+  extern ROSE_DLL_API std::string frontend_cache_directory;
+
   void
   makeSysIncludeList(const Rose_STL_Container<string> &dirs, Rose_STL_Container<string> &result, bool using_nostdinc_option = false);
 
@@ -65,6 +74,34 @@ namespace Cmdline {
   void
   ProcessKeepGoing (SgProject* project, std::vector<std::string>& argv);
 
+  /** -rose:parallel_frontend N
+   *
+   *  Parse the source files in N forked processes, see Rose::Frontend::RunParallel().
+   */
+  void
+  ProcessParallelFrontend (SgProject* project, std::vector<std::string>& argv);
+
+  /** -rose:parallel_unparse N
+   *
+   *  Unparse the source files in N forked processes, see unparseFileList().
+   */
+  void
+  ProcessParallelUnparse (SgProject* project, std::vector<std::string>& argv);
+
+  /** -rose:frontend_cache <directory>
+   *
+   *  Reuse the ASTs of unchanged source files, see Rose::Frontend::RunWithCache().
+   */
+  void
+  ProcessFrontendCache (SgProject* project, std::vector<std::string>& argv);
+
+  /** -rose:performance_trace <file>
+   *
+   *  Write the timed phases as a Chrome trace, see AstPerformance::enableTrace().
+   */
+  void
+  ProcessPerformanceTrace (SgProject* project, std::vector<std::string>& argv);
+
   namespace Unparser {
     static const std::string option_prefix = "-rose:unparser:";
 
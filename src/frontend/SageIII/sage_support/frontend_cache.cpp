@@ -0,0 +1,315 @@
+/**
+ * \file    frontend_cache.cpp
+ *
+ * Persistent frontend cache (-rose:frontend_cache <directory>): the ASTs
+ * built for the C/C++ source files are kept in binary AST files
+ * (AstFileIOFileIndex) in the cache directory and are read back, instead of
+ * running the frontend again, when a later run parses the same file with the
+ * same command line and the headers it used are unchanged.
+ *
+ * Every cached file has a manifest (<key>.manifest), indexed by a digest of
+ * the ROSE version, the command line (the macro definitions and include
+ * paths are part of it), the name and the contents of the source file. The
+ * manifest records the binary AST file and the digests of the headers that
+ * the AST has source positions in; a manifest is only used if all these
+ * headers still have the same contents. Headers that do not contribute any
+ * IR node (e.g. headers that only define macros) are not recorded: use a new
+ * cache directory when such a header changes.
+ *
+ * The declarations of the headers that are shared by several files of a
+ * project are merged using the AST merge mechanism, as on a cache miss.
+ */
+#include "sage3basic.h"
+#include "sage_support.h"
+#include "cmdline.h"
+#include "merge.h"
+#include "AstFileIOFileIndex.h"
+#include "Combinatorics.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace
+{
+  const char* manifest_signature = "ROSE frontend cache manifest 1";
+
+  std::string
+  Digest(const std::string& data)
+  {
+      std::vector<uint8_t> sha1 = Combinatorics::sha1_digest(data);
+      if (!sha1.empty())
+          return Combinatorics::digest_to_string(sha1);
+
+      // No SHA1 implementation in this configuration of ROSE.
+      std::ostringstream fnv1a64;
+      fnv1a64 << std::hex << Combinatorics::fnv1a64_digest(data);
+      return fnv1a64.str();
+  }
+
+  // False if the file cannot be read.
+  bool
+  DigestOfFile(const std::string& filename, std::string& digest)
+  {
+      std::ifstream in(filename.c_str(), std::ios::binary);
+      if (!in)
+          return false;
+
+      std::ostringstream contents;
+      contents << in.rdbuf();
+      digest = Digest(contents.str());
+      return true;
+  }
+
+  struct Manifest
+  {
+      std::string binary_ast_filename;
+      std::string source_filename;
+      std::vector<std::pair<std::string, std::string> > header_digests;
+  };
+
+  std::string
+  ManifestFilename(const std::string& key)
+  {
+      return (boost::filesystem::path(Rose::Cmdline::frontend_cache_directory) / (key + ".manifest")).string();
+  }
+
+  // The key of a file is empty if the source file cannot be read.
+  std::string
+  KeyOfFile(SgFile* file)
+  {
+      std::string source_digest;
+      if (!DigestOfFile(file->getFileName(), source_digest))
+          return "";
+
+      std::ostringstream key;
+      key << version_number() << "\n" << file->getFileName() << "\n" << source_digest << "\n";
+      BOOST_FOREACH(const std::string& argument, file->get_originalCommandLineArgumentList())
+      {
+          key << argument << "\n";
+      }
+      return Digest(key.str());
+  }
+
+  bool
+  ReadManifest(const std::string& key, Manifest& manifest)
+  {
+      std::ifstream in(ManifestFilename(key).c_str());
+      std::string line;
+      if (!in || !std::getline(in, line) || line != manifest_signature)
+          return false;
+      if (!std::getline(in, manifest.binary_ast_filename) || !std::getline(in, manifest.source_filename))
+          return false;
+
+      std::string digest, header;
+      while (in >> digest && std::getline(in >> std::ws, header))
+      {
+          manifest.header_digests.push_back(std::make_pair(header, digest));
+      }
+      return true;
+  }
+
+  // The manifest is written to a temporary file first, so that a concurrent
+  // run never reads an incomplete manifest.
+  void
+  WriteManifest(const std::string& key, const Manifest& manifest)
+  {
+      std::string filename = ManifestFilename(key);
+      std::string temporary_filename = filename + "." + boost::filesystem::unique_path().string();
+      {
+          std::ofstream out(temporary_filename.c_str());
+          out << manifest_signature << "\n"
+              << manifest.binary_ast_filename << "\n"
+              << manifest.source_filename << "\n";
+          for (size_t i = 0; i < manifest.header_digests.size(); ++i)
+          {
+              out << manifest.header_digests[i].second << " " << manifest.header_digests[i].first << "\n";
+          }
+      }
+
+      boost::system::error_code error;
+      boost::filesystem::rename(temporary_filename, filename, error);
+      if (error)
+          boost::filesystem::remove(temporary_filename, error);
+  }
+
+  bool
+  IsValidManifest(const Manifest& manifest, SgFile* file)
+  {
+      if (manifest.source_filename != file->getFileName() || !boost::filesystem::exists(manifest.binary_ast_filename))
+          return false;
+
+      for (size_t i = 0; i < manifest.header_digests.size(); ++i)
+      {
+          std::string digest;
+          if (!DigestOfFile(manifest.header_digests[i].first, digest) || digest != manifest.header_digests[i].second)
+              return false;
+      }
+      return true;
+  }
+
+  // Digests of the files (other than the source files) that the ASTs have
+  // source positions in.
+  std::vector<std::pair<std::string, std::string> >
+  HeaderDigests(const std::vector<SgFile*>& files)
+  {
+      std::set<std::string> source_filenames;
+      BOOST_FOREACH(SgFile* file, files)
+      {
+          source_filenames.insert(file->getFileName());
+      }
+
+      std::vector<std::pair<std::string, std::string> > header_digests;
+      const std::map<std::string, int>& nametofileid_map = Sg_File_Info::get_nametofileid_map();
+      for (std::map<std::string, int>::const_iterator i = nametofileid_map.begin(); i != nametofileid_map.end(); ++i)
+      {
+          std::string digest;
+          if (source_filenames.count(i->first) == 0 && DigestOfFile(i->first, digest))
+              header_digests.push_back(std::make_pair(i->first, digest));
+      }
+      return header_digests;
+  }
+} // anonymous namespace
+
+int
+Rose::Frontend::RunWithCache(SgProject* project)
+{
+  ROSE_ASSERT(project != NULL);
+  ROSE_ASSERT(!Rose::Cmdline::frontend_cache_directory.empty());
+
+  SgFilePtrList& all_files = project->get_fileList_ptr()->get_listOfFiles();
+
+  bool supported = !project->get_Fortran_only() && !project->get_Java_only();
+  BOOST_FOREACH(SgFile* file, all_files)
+  {
+      supported = supported && isSgSourceFile(file) != NULL;
+  }
+
+  boost::system::error_code error;
+  boost::filesystem::create_directories(Rose::Cmdline::frontend_cache_directory, error);
+  if (error)
+  {
+      std::cout
+          << "[WARN] "
+          << "Unable to use the frontend cache directory '" << Rose::Cmdline::frontend_cache_directory << "'"
+          << std::endl;
+      supported = false;
+  }
+
+  if (!supported)
+  {
+      if (SgProject::get_verbose() > 0)
+          std::cout << "[INFO] [Frontend] Frontend cache not used for this project" << std::endl;
+
+      return Rose::Cmdline::parallel_frontend_workers > 1 ?
+          Rose::Frontend::RunParallel(project) : Rose::Frontend::RunSerial(project);
+  }
+
+  TimingPerformance timer ("AST (Rose::Frontend::RunWithCache()):");
+
+  // Look up the files in the cache.
+  std::vector<std::string> keys(all_files.size());
+  std::vector<size_t> missed_file_indices;
+  std::vector<std::string> binary_ast_filenames;
+  std::vector<std::vector<size_t> > cached_file_indices;
+  for (size_t i = 0; i < all_files.size(); ++i)
+  {
+      keys[i] = KeyOfFile(all_files[i]);
+
+      Manifest manifest;
+      if (keys[i].empty() || !ReadManifest(keys[i], manifest) || !IsValidManifest(manifest, all_files[i]))
+      {
+          missed_file_indices.push_back(i);
+          continue;
+      }
+
+      std::vector<std::string>::iterator binary =
+          std::find(binary_ast_filenames.begin(), binary_ast_filenames.end(), manifest.binary_ast_filename);
+      if (binary == binary_ast_filenames.end())
+      {
+          binary_ast_filenames.push_back(manifest.binary_ast_filename);
+          cached_file_indices.push_back(std::vector<size_t>());
+          binary = binary_ast_filenames.end() - 1;
+      }
+      cached_file_indices[binary - binary_ast_filenames.begin()].push_back(i);
+  }
+
+  if (SgProject::get_verbose() > 0)
+      std::cout
+          << "[INFO] [Frontend] Frontend cache: "
+          << all_files.size() - missed_file_indices.size() << " of " << all_files.size() << " files found"
+          << std::endl;
+
+  // Run the frontend on the missed files only, then add them to the cache
+  // (all of them in one binary AST file) unless the frontend failed on them.
+  int status_of_function = 0;
+  if (!missed_file_indices.empty())
+  {
+      SgFilePtrList project_files = all_files;
+      all_files.clear();
+      BOOST_FOREACH(size_t index, missed_file_indices)
+      {
+          all_files.push_back(project_files[index]);
+      }
+
+      status_of_function = Rose::Cmdline::parallel_frontend_workers > 1 ?
+          Rose::Frontend::RunParallel(project) : Rose::Frontend::RunSerial(project);
+
+      // The parallel frontend replaces the files by the ones it parsed.
+      std::vector<SgFile*> missed_files(all_files.begin(), all_files.end());
+      for (size_t i = 0; i < missed_file_indices.size(); ++i)
+      {
+          project_files[missed_file_indices[i]] = missed_files[i];
+      }
+      all_files = project_files;
+
+      std::string missed_keys;
+      BOOST_FOREACH(size_t index, missed_file_indices)
+      {
+          missed_keys += keys[index];
+      }
+
+      Manifest manifest;
+      manifest.binary_ast_filename =
+          (boost::filesystem::path(Rose::Cmdline::frontend_cache_directory) / (Digest(missed_keys) + ".binary")).string();
+      manifest.header_digests = HeaderDigests(missed_files);
+
+      bool written = false;
+      for (size_t i = 0; i < missed_file_indices.size(); ++i)
+      {
+          SgFile* file = missed_files[i];
+          if (keys[missed_file_indices[i]].empty() || file->get_frontendErrorCode() != 0)
+              continue;
+
+          if (!written)
+          {
+              AstFileIOFileIndex::writeASTToFile(manifest.binary_ast_filename);
+              written = true;
+          }
+
+          manifest.source_filename = file->getFileName();
+          WriteManifest(keys[missed_file_indices[i]], manifest);
+      }
+  }
+
+  // Read the cached files; each one replaces the unparsed SgFile at the same
+  // position of the file list.
+  if (!binary_ast_filenames.empty())
+  {
+      Rose::Frontend::ReplaceFilesFromBinaryAsts(project, binary_ast_filenames, cached_file_indices);
+
+      if (all_files.size() > 1)
+      {
+          bool skipFrontendSpecificIRnodes = false;
+          mergeAST(project, skipFrontendSpecificIRnodes);
+      }
+  }
+
+  project->set_frontendErrorCode(status_of_function);
+
+  return status_of_function;
+} // Rose::Frontend::RunWithCache
@@ -0,0 +1,426 @@
+/**
+ * \file    parallel_frontend.cpp
+ *
+ * Parallel frontend (-rose:parallel_frontend N): the source files of the
+ * project are parsed by N forked worker processes. Each worker runs the
+ * frontend on its share of the files and writes its AST to a binary AST file
+ * (AstFileIOFileIndex). The parent process reads the ASTs of the parsed
+ * files back, puts them at the positions of the (unparsed) files in its own
+ * file list, merges the static data of the ASTs (file id maps and function
+ * type tables, as in tests/testAstFileRead.C), and shares the redundant parts
+ * of the ASTs using the AST merge mechanism.
+ *
+ * With -rose:keep_going the workers form a supervised pool: each file is
+ * parsed by a worker of its own, a crashed worker only loses its file and is
+ * replaced, and the failures are reported together at the end.
+ */
+#include "sage3basic.h"
+#include "sage_support.h"
+#include "keep_going.h"
+#include "cmdline.h"
+#include "merge.h"
+#include "AstFileIOFileIndex.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/foreach.hpp>
+
+#include <errno.h>
+#include <string.h>
+#include <map>
+#include <sstream>
+
+#ifndef _MSC_VER
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  // Collects the Sg_File_Info objects that were not yet seen, i.e. the ones
+  // read with the last binary AST.
+  class NewFileInfoCollection : public ROSE_VisitTraversal
+  {
+    public:
+      NewFileInfoCollection(std::set<Sg_File_Info*>& seen) : seen_file_infos(seen) {}
+
+      void visit(SgNode* node)
+      {
+          Sg_File_Info* file_info = isSg_File_Info(node);
+          ROSE_ASSERT(file_info != NULL);
+          if (seen_file_infos.insert(file_info).second == true)
+              new_file_infos.push_back(file_info);
+      }
+
+      std::set<Sg_File_Info*>& seen_file_infos;
+      std::vector<Sg_File_Info*> new_file_infos;
+  };
+
+  // Static data of the ASTs read from the workers, merged into one set.
+  struct MergedStaticData
+  {
+      std::map<int, std::string> fileidtoname_map;
+      std::map<std::string, int> nametofileid_map;
+      std::vector<SgFunctionTypeTable*> function_type_tables;
+      std::set<Sg_File_Info*> seen_file_infos;
+  };
+
+  void
+  RecordStaticDataOfParent(MergedStaticData& merged)
+  {
+      merged.fileidtoname_map = Sg_File_Info::get_fileidtoname_map();
+      merged.nametofileid_map = Sg_File_Info::get_nametofileid_map();
+      merged.function_type_tables.push_back(SgNode::get_globalFunctionTypeTable());
+
+      NewFileInfoCollection collection(merged.seen_file_infos);
+      Sg_File_Info::traverseMemoryPoolNodes(collection);
+  }
+
+  // Called right after a binary AST was read and its static data was set:
+  // renumbers the file ids of its Sg_File_Info objects into the merged file
+  // id maps.
+  void
+  MergeStaticDataOfLastAst(MergedStaticData& merged)
+  {
+      std::map<int, int> fileid_to_merged_fileid;
+      const std::map<int, std::string>& fileidtoname_map = Sg_File_Info::get_fileidtoname_map();
+      for (std::map<int, std::string>::const_iterator i = fileidtoname_map.begin(); i != fileidtoname_map.end(); ++i)
+      {
+          std::map<std::string, int>::iterator existing = merged.nametofileid_map.find(i->second);
+          if (existing == merged.nametofileid_map.end())
+          {
+              int new_fileid = merged.fileidtoname_map.empty() ? 0 : merged.fileidtoname_map.rbegin()->first + 1;
+              merged.nametofileid_map[i->second] = new_fileid;
+              merged.fileidtoname_map[new_fileid] = i->second;
+              fileid_to_merged_fileid[i->first] = new_fileid;
+          }
+          else
+          {
+              fileid_to_merged_fileid[i->first] = existing->second;
+          }
+      }
+
+      NewFileInfoCollection collection(merged.seen_file_infos);
+      Sg_File_Info::traverseMemoryPoolNodes(collection);
+      BOOST_FOREACH(Sg_File_Info* file_info, collection.new_file_infos)
+      {
+          // Values less than zero indicate file name classifications.
+          int fileid = file_info->get_file_id();
+          if (fileid >= 0)
+          {
+              ROSE_ASSERT(fileid_to_merged_fileid.count(fileid) == 1);
+              file_info->set_file_id(fileid_to_merged_fileid[fileid]);
+          }
+      }
+
+      merged.function_type_tables.push_back(SgNode::get_globalFunctionTypeTable());
+  }
+
+  // The function types of all ASTs are added to the global function type
+  // table that is current (the one of the last AST read).
+  void
+  InstallMergedStaticData(MergedStaticData& merged)
+  {
+      SgFunctionTypeTable* global_function_type_table = SgNode::get_globalFunctionTypeTable();
+      ROSE_ASSERT(global_function_type_table != NULL);
+
+      BOOST_FOREACH(SgFunctionTypeTable* function_type_table, merged.function_type_tables)
+      {
+          if (function_type_table == NULL || function_type_table == global_function_type_table)
+              continue;
+
+          SgSymbolTable::BaseHashType* internal_table = function_type_table->get_function_type_table()->get_table();
+          ROSE_ASSERT(internal_table != NULL);
+          for (SgSymbolTable::hash_iterator i = internal_table->begin(); i != internal_table->end(); ++i)
+          {
+              ROSE_ASSERT(isSgSymbol(i->second) != NULL);
+              if (global_function_type_table->lookup_function_type(i->first) == NULL)
+                  global_function_type_table->get_function_type_table()->insert(i->first, i->second);
+          }
+      }
+
+      Sg_File_Info::get_fileidtoname_map() = merged.fileidtoname_map;
+      Sg_File_Info::get_nametofileid_map() = merged.nametofileid_map;
+  }
+
+#ifndef _MSC_VER
+  // Runs in the forked worker: parse the files assigned to this worker and
+  // write the AST. Never returns.
+  void
+  RunWorker(const std::vector<SgFile*>& files, const std::string& binary_ast_filename)
+  {
+      int status_of_worker = 0;
+      BOOST_FOREACH(SgFile* file, files)
+      {
+          int status_of_file = 0;
+          if (Rose::KeepGoing::g_keep_going)
+          {
+              try
+              {
+                  file->runFrontend(status_of_file);
+              }
+              catch (...)
+              {
+                  file->set_frontendErrorCode(100);
+                  status_of_file = 100;
+              }
+          }
+          else
+          {
+              file->runFrontend(status_of_file);
+          }
+          status_of_worker = std::max(status_of_file, status_of_worker);
+      }
+
+      AstFileIOFileIndex::writeASTToFile(binary_ast_filename);
+
+      // Skip the destructors of the static objects of the parent process.
+      fflush(stdout);
+      fflush(stderr);
+      _exit(std::min(status_of_worker, 255));
+  }
+#endif
+} // anonymous namespace
+
+void
+Rose::Frontend::ReplaceFilesFromBinaryAsts(
+    SgProject* project,
+    const std::vector<std::string>& binary_ast_filenames,
+    const std::vector<std::vector<size_t> >& file_indices)
+{
+  ROSE_ASSERT(project != NULL);
+  ROSE_ASSERT(binary_ast_filenames.size() == file_indices.size());
+
+  SgFilePtrList& all_files = project->get_fileList_ptr()->get_listOfFiles();
+
+  MergedStaticData merged_static_data;
+  RecordStaticDataOfParent(merged_static_data);
+
+  std::vector<SgFile*> unparsed_files;
+  std::vector<SgProject*> read_projects;
+  for (size_t b = 0; b < binary_ast_filenames.size(); ++b)
+  {
+      std::vector<std::string> filenames;
+      BOOST_FOREACH(size_t index, file_indices[b])
+      {
+          ROSE_ASSERT(index < all_files.size());
+          filenames.push_back(all_files[index]->getFileName());
+      }
+
+      SgProject* read_project = AstFileIOFileIndex::readASTFromFile(binary_ast_filenames[b], filenames);
+      ROSE_ASSERT(read_project != NULL);
+      read_projects.push_back(read_project);
+
+      AST_FILE_IO::setStaticDataOfAst(AST_FILE_IO::getAst(AST_FILE_IO::getNumberOfAsts() - 1));
+      MergeStaticDataOfLastAst(merged_static_data);
+
+      SgFilePtrList& parsed_files = read_project->get_fileList_ptr()->get_listOfFiles();
+      ROSE_ASSERT(parsed_files.size() == file_indices[b].size());
+      for (size_t i = 0; i < parsed_files.size(); ++i)
+      {
+          size_t index = file_indices[b][i];
+          SgFile* unparsed_file = all_files[index];
+          ROSE_ASSERT(parsed_files[i]->getFileName() == unparsed_file->getFileName());
+
+          parsed_files[i]->set_parent(unparsed_file->get_parent());
+          all_files[index] = parsed_files[i];
+          unparsed_files.push_back(unparsed_file);
+      }
+      parsed_files.clear();
+  }
+
+  InstallMergedStaticData(merged_static_data);
+
+  BOOST_FOREACH(SgFile* file, unparsed_files)
+  {
+      SageInterface::deleteAST(file);
+  }
+  BOOST_FOREACH(SgProject* read_project, read_projects)
+  {
+      SageInterface::deleteAST(read_project);
+  }
+} // Rose::Frontend::ReplaceFilesFromBinaryAsts
+
+int
+Rose::Frontend::RunParallel(SgProject* project)
+{
+  ROSE_ASSERT(project != NULL);
+
+  SgFilePtrList& all_files = project->get_fileList_ptr()->get_listOfFiles();
+  size_t number_of_workers = std::min((size_t) std::max(Rose::Cmdline::parallel_frontend_workers, 1), all_files.size());
+
+  bool supported = number_of_workers > 1 && !project->get_Fortran_only() && !project->get_Java_only();
+  BOOST_FOREACH(SgFile* file, all_files)
+  {
+      supported = supported && isSgSourceFile(file) != NULL;
+  }
+
+#ifdef _MSC_VER
+  supported = false;
+#endif
+
+  if (!supported)
+  {
+      if (SgProject::get_verbose() > 0)
+          std::cout << "[INFO] [Frontend] Parallel mode not used for this project" << std::endl;
+
+      return Rose::Frontend::RunSerial(project);
+  }
+
+#ifndef _MSC_VER
+  if (SgProject::get_verbose() > 0)
+      std::cout << "[INFO] [Frontend] Running in parallel mode with " << number_of_workers << " workers" << std::endl;
+
+  TimingPerformance timer ("AST (Rose::Frontend::RunParallel()):");
+
+  // Worker w parses the files with index w, w + N, w + 2N, ... (so that the
+  // files of one directory, often of similar size, are spread over the workers).
+  // With -rose:keep_going every file is parsed by a worker of its own: a
+  // worker that crashes only loses its file, and the next file is given to a
+  // new worker (forked from the parent, whose state is not tainted by the
+  // failure) while the others keep running.
+  size_t number_of_tasks = Rose::KeepGoing::g_keep_going ? all_files.size() : number_of_workers;
+  std::vector<std::vector<SgFile*> > files_of_task(number_of_tasks);
+  std::vector<std::vector<size_t> > file_indices_of_task(number_of_tasks);
+  for (size_t i = 0; i < all_files.size(); ++i)
+  {
+      files_of_task[i % number_of_tasks].push_back(all_files[i]);
+      file_indices_of_task[i % number_of_tasks].push_back(i);
+  }
+
+  std::vector<std::string> binary_ast_filenames(number_of_tasks);
+  std::map<pid_t, size_t> task_of_worker;
+  std::vector<bool> task_succeeded(number_of_tasks, false);
+  std::vector<std::string> failure_reports;
+  int status_of_function = 0;
+  size_t next_task = 0;
+  while (next_task < number_of_tasks || !task_of_worker.empty())
+  {
+      // Keep number_of_workers workers running.
+      while (next_task < number_of_tasks && task_of_worker.size() < number_of_workers)
+      {
+          size_t t = next_task++;
+          binary_ast_filenames[t] =
+              (boost::filesystem::temp_directory_path() /
+               boost::filesystem::unique_path("rose-parallel-frontend-%%%%-%%%%-%%%%.binary")).string();
+
+          // Flush so that the buffered output is not written by every worker.
+          fflush(stdout);
+          fflush(stderr);
+          std::cout.flush();
+
+          pid_t worker = fork();
+          if (worker < 0)
+          {
+              printf ("Error: Rose::Frontend::RunParallel(): fork() failed for worker %zu \n", t);
+              ROSE_ASSERT(false);
+          }
+          else if (worker == 0)
+          {
+              RunWorker(files_of_task[t], binary_ast_filenames[t]);
+          }
+          task_of_worker[worker] = t;
+      }
+
+      int wait_status = 0;
+      pid_t worker = waitpid(-1, &wait_status, 0);
+      if (worker < 0)
+      {
+          if (errno == EINTR)
+              continue;
+
+          printf ("Error: Rose::Frontend::RunParallel(): waitpid() failed (%s) \n", strerror(errno));
+          ROSE_ASSERT(false);
+      }
+
+      std::map<pid_t, size_t>::iterator finished = task_of_worker.find(worker);
+      if (finished == task_of_worker.end())
+          continue;
+      size_t t = finished->second;
+      task_of_worker.erase(finished);
+
+      if (!WIFEXITED(wait_status))
+      {
+          if (Rose::KeepGoing::g_keep_going)
+          {
+              std::ostringstream report;
+              report << "frontend worker terminated by signal " << (WIFSIGNALED(wait_status) ? WTERMSIG(wait_status) : 0)
+                     << " while parsing " << files_of_task[t].front()->getFileName();
+              failure_reports.push_back(report.str());
+
+              std::cout
+                  << "[WARN] "
+                  << "Configured to keep going after the " << report.str()
+                  << std::endl;
+
+              BOOST_FOREACH(SgFile* file, files_of_task[t])
+              {
+                  file->set_frontendErrorCode(100);
+              }
+              boost::system::error_code error;
+              boost::filesystem::remove(binary_ast_filenames[t], error);
+              status_of_function = std::max(100, status_of_function);
+              continue;
+          }
+
+          printf ("Error: Rose::Frontend::RunParallel(): frontend worker %zu was terminated (signal %d) \n",
+                  t, WIFSIGNALED(wait_status) ? WTERMSIG(wait_status) : 0);
+          ROSE_ASSERT(false);
+      }
+
+      if (Rose::KeepGoing::g_keep_going && WEXITSTATUS(wait_status) != 0)
+      {
+          std::ostringstream report;
+          report << "frontend failed (status " << WEXITSTATUS(wait_status) << ") on "
+                 << files_of_task[t].front()->getFileName();
+          failure_reports.push_back(report.str());
+      }
+
+      status_of_function = std::max(WEXITSTATUS(wait_status), status_of_function);
+      task_succeeded[t] = true;
+  }
+
+  if (Rose::KeepGoing::g_keep_going && (!failure_reports.empty() || SgProject::get_verbose() > 0))
+  {
+      std::cout
+          << "[INFO] [Frontend] Parallel frontend: "
+          << all_files.size() - failure_reports.size() << " of " << all_files.size() << " files parsed without errors"
+          << std::endl;
+      BOOST_FOREACH(const std::string& report, failure_reports)
+      {
+          std::cout << "[INFO] [Frontend]     " << report << std::endl;
+      }
+  }
+
+  // Read the ASTs of the workers; each parsed file replaces the unparsed
+  // SgFile at the same position of the file list.
+  std::vector<std::string> read_binary_ast_filenames;
+  std::vector<std::vector<size_t> > read_file_indices;
+  for (size_t t = 0; t < number_of_tasks; ++t)
+  {
+      if (task_succeeded[t])
+      {
+          read_binary_ast_filenames.push_back(binary_ast_filenames[t]);
+          read_file_indices.push_back(file_indices_of_task[t]);
+      }
+  }
+
+  Rose::Frontend::ReplaceFilesFromBinaryAsts(project, read_binary_ast_filenames, read_file_indices);
+
+  BOOST_FOREACH(const std::string& binary_ast_filename, read_binary_ast_filenames)
+  {
+      boost::filesystem::remove(binary_ast_filename);
+  }
+
+  // Share the parts of the ASTs that are built by more than one worker
+  // (mostly the declarations from common header files).
+  bool skipFrontendSpecificIRnodes = false;
+  mergeAST(project, skipFrontendSpecificIRnodes);
+
+  project->set_frontendErrorCode(status_of_function);
+
+  return status_of_function;
+#else
+  return Rose::Frontend::RunSerial(project);
+#endif
+} // Rose::Frontend::RunParallel
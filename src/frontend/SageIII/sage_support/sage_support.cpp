@@ -2404,6 +2404,9 @@ SgFile::callFrontEnd()
   // DQ (4/21/2006): I think we can now assert this!
      ROSE_ASSERT(fileNameIndex == 0);
 
+  // Attribute the frontend phases of this file to it in the performance trace (-rose:performance_trace).
+     PerformanceTraceFile traceFile (getFileName());
+
   // DQ (7/6/2005): Introduce tracking of performance of ROSE.
      TimingPerformance timer ("AST Front End Processing (SgFile):");
 
@@ -4244,6 +4247,14 @@ Rose::Frontend::Run(SgProject* project)
       {
           status = Rose::Frontend::Java::Run(project);
       }
+      else if (!Rose::Cmdline::frontend_cache_directory.empty())
+      {
+          status = Rose::Frontend::RunWithCache(project);
+      }
+      else if (Rose::Cmdline::parallel_frontend_workers > 1)
+      {
+          status = Rose::Frontend::RunParallel(project);
+      }
       else
       {
           status = Rose::Frontend::RunSerial(project);
@@ -87,6 +87,27 @@ namespace Rose {
 namespace Frontend {
   int Run(SgProject* project);
   int RunSerial(SgProject* project);
+
+  /** Parse the files in Rose::Cmdline::parallel_frontend_workers forked
+   *  processes (-rose:parallel_frontend N) and merge their ASTs; falls back
+   *  to RunSerial() for projects that are not (only) C/C++ source files.
+   *  Defined in parallel_frontend.cpp. */
+  int RunParallel(SgProject* project);
+
+  /** Replace the files of the project at the positions file_indices[b] by the
+   *  files of the same name read from the binary AST file
+   *  binary_ast_filenames[b] (AstFileIOFileIndex), merging the static data of
+   *  the ASTs. The replaced files are deleted. Defined in
+   *  parallel_frontend.cpp. */
+  void ReplaceFilesFromBinaryAsts(
+      SgProject* project,
+      const std::vector<std::string>& binary_ast_filenames,
+      const std::vector<std::vector<size_t> >& file_indices);
+
+  /** Read the ASTs of the files found in the frontend cache
+   *  (-rose:frontend_cache <directory>) and run the frontend on the other
+   *  files only, adding them to the cache. Defined in frontend_cache.cpp. */
+  int RunWithCache(SgProject* project);
 namespace Java {
   int Run(SgProject* project);
 namespace Ecj {
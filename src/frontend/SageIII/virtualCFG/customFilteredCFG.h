@@ -9,6 +9,7 @@
 #define CUSTOMFILTEREDCFG_H
 
 #include "staticCFG.h"
+#include "filteredCFG.h"
 
 namespace StaticCFG 
 {
@@ -22,6 +23,10 @@ public:
         ~CustomFilteredCFG() {
         }
         virtual void buildFilteredCFG();
+
+        //! Compile-once mode: the filtered CFG of the same start node as buildFilteredCFG(), with the filter applied once
+        //! and the result stored in plain arrays (see VirtualCFG::FilteredCFGSnapshot).
+        VirtualCFG::FilteredCFGSnapshot<_Filter> buildFilteredSnapshot() const;
         
         
 protected:        
@@ -3,6 +3,7 @@
 
 //#include "rose.h"
 #include "virtualCFG.h"
+#include <map>
 #include <string>
 #include <vector>
 
@@ -155,6 +156,88 @@ namespace VirtualCFG
         }
     };
 
+    /** A filtered CFG computed once.
+     *
+     *  FilteredCFGNode::outEdges() and inEdges() apply the filter again on every call.  A snapshot applies it once to every
+     *  interesting node reachable (in either direction) from the start nodes, numbers these nodes densely in the order they
+     *  are found, and stores their filtered out and in edges as compressed sparse rows: an offset array per direction into
+     *  an array of edges and an array of node numbers.  Repeated analyses over the same filtered CFG can then walk plain
+     *  arrays.  Enable the virtual CFG cache (enableCfgCache()) while the snapshot is built so that the raw edges come from
+     *  the cached per-function CFGs.  The snapshot does not follow changes to the AST; build a new one instead. */
+    template < typename FilterFunction > class FilteredCFGSnapshot
+    {
+      public:
+        typedef FilteredCFGNode < FilterFunction > Node;
+        typedef FilteredCFGEdge < FilterFunction > Edge;
+
+        /** Snapshot of the nodes reachable from one start node. */
+        explicit FilteredCFGSnapshot(const Node & start);
+
+        /** Snapshot of the nodes reachable from any of the start nodes, e.g., the beginning of every function. */
+        explicit FilteredCFGSnapshot(const std::vector < Node > & starts);
+
+        /** Number of nodes. */
+        size_t size() const
+        {
+            return nodes.size();
+        }
+        /** Node with the specified number. */
+        const Node & node(size_t id) const
+        {
+            return nodes[id];
+        }
+        /** Number of a node, or false if the node is not in the snapshot. */
+        bool findNode(const Node & n, size_t & id) const
+        {
+            typename std::map < Node, size_t >::const_iterator found = ids.find(n);
+            if (found == ids.end())
+                return false;
+            id = found->second;
+            return true;
+        }
+
+        /** Successor node numbers of a node, and their edges (in the order of Node::outEdges()).
+         *  @{ */
+        const size_t *successorsBegin(size_t id) const
+        {
+            return targets.empty() ? NULL : &targets[0] + outOffsets[id];
+        }
+        const size_t *successorsEnd(size_t id) const
+        {
+            return targets.empty() ? NULL : &targets[0] + outOffsets[id + 1];
+        }
+        const Edge & outEdge(size_t id, size_t i) const
+        {
+            return outEdgeList[outOffsets[id] + i];
+        }
+        /** @} */
+
+        /** Predecessor node numbers of a node, and their edges (in the order of Node::inEdges()).
+         *  @{ */
+        const size_t *predecessorsBegin(size_t id) const
+        {
+            return sources.empty() ? NULL : &sources[0] + inOffsets[id];
+        }
+        const size_t *predecessorsEnd(size_t id) const
+        {
+            return sources.empty() ? NULL : &sources[0] + inOffsets[id + 1];
+        }
+        const Edge & inEdge(size_t id, size_t i) const
+        {
+            return inEdgeList[inOffsets[id] + i];
+        }
+        /** @} */
+
+      private:
+        size_t number(const Node & n, std::vector < size_t > & worklist);
+        void build(std::vector < size_t > & worklist);
+
+        std::vector < Node > nodes;
+        std::map < Node, size_t > ids;
+        std::vector < size_t > outOffsets, targets, inOffsets, sources;
+        std::vector < Edge > outEdgeList, inEdgeList;
+    };
+
     template < typename FilterFunction > std::ostream & cfgToDot(std::ostream & o,
                                                                  std::string graphName,
                                                                  FilteredCFGNode <
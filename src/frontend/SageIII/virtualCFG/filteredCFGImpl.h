@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <stdint.h>
 #include <set>
+#include <algorithm>
 
 #define SgNULL_FILE Sg_File_Info::generateDefaultFileInfoForTransformationNode()
 
@@ -137,6 +138,89 @@ namespace VirtualCFG
                                                                   &mergePathsReversed, 
                                                                   filter);
     }
+    // ---------------------------------------------
+    // FILTERED CFG SNAPSHOT IMPL
+    template < typename FilterFunction >
+    FilteredCFGSnapshot < FilterFunction >::FilteredCFGSnapshot(const Node & start)
+    {
+        std::vector < size_t > worklist;
+        number(start, worklist);
+        build(worklist);
+    }
+
+    template < typename FilterFunction >
+    FilteredCFGSnapshot < FilterFunction >::FilteredCFGSnapshot(const std::vector < Node > & starts)
+    {
+        std::vector < size_t > worklist;
+        for (size_t i = 0; i < starts.size(); ++i)
+            number(starts[i], worklist);
+        std::reverse(worklist.begin(), worklist.end());  // the first start node is explored first
+        build(worklist);
+    }
+
+    //! Number of a node, numbering it (and adding it to the worklist) the first time it is seen
+    template < typename FilterFunction >
+    size_t FilteredCFGSnapshot < FilterFunction >::number(const Node & n, std::vector < size_t > & worklist)
+    {
+        std::pair < typename std::map < Node, size_t >::iterator, bool > inserted =
+            ids.insert(std::make_pair(n, nodes.size()));
+        if (inserted.second)
+        {
+            nodes.push_back(n);
+            worklist.push_back(inserted.first->second);
+        }
+        return inserted.first->second;
+    }
+
+    //! Apply the filter once to each node, in both directions, until no new node is found
+    template < typename FilterFunction >
+    void FilteredCFGSnapshot < FilterFunction >::build(std::vector < size_t > & worklist)
+    {
+        std::vector < std::vector < Edge > > outs, ins;
+        while (!worklist.empty())
+        {
+            size_t id = worklist.back();
+            worklist.pop_back();
+            if (id >= outs.size())
+            {
+                outs.resize(nodes.size());
+                ins.resize(nodes.size());
+            }
+            Node n = nodes[id];                 // copied: numbering new nodes can reallocate the node list
+            outs[id] = n.outEdges();
+            ins[id] = n.inEdges();
+            for (size_t i = 0; i < outs[id].size(); ++i)
+                number(outs[id][i].target(), worklist);
+            for (size_t i = 0; i < ins[id].size(); ++i)
+                number(ins[id][i].source(), worklist);
+        }
+
+        outOffsets.resize(nodes.size() + 1, 0);
+        inOffsets.resize(nodes.size() + 1, 0);
+        for (size_t id = 0; id < nodes.size(); ++id)
+        {
+            outOffsets[id + 1] = outOffsets[id] + outs[id].size();
+            inOffsets[id + 1] = inOffsets[id] + ins[id].size();
+        }
+        targets.reserve(outOffsets.back());
+        outEdgeList.reserve(outOffsets.back());
+        sources.reserve(inOffsets.back());
+        inEdgeList.reserve(inOffsets.back());
+        for (size_t id = 0; id < nodes.size(); ++id)
+        {
+            for (size_t i = 0; i < outs[id].size(); ++i)
+            {
+                targets.push_back(ids.find(outs[id][i].target())->second);
+                outEdgeList.push_back(outs[id][i]);
+            }
+            for (size_t i = 0; i < ins[id].size(); ++i)
+            {
+                sources.push_back(ids.find(ins[id][i].source())->second);
+                inEdgeList.push_back(ins[id][i]);
+            }
+        }
+    }
+
     // ---------------------------------------------
     // DOT OUT IMPL
     template < typename NodeT, typename EdgeT ,bool Debug>  /*Filtered Node Type, Filtered CFG Type*/
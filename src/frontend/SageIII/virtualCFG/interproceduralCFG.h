@@ -3,9 +3,11 @@
 
 #include "staticCFG.h"
 #include "CallGraph.h"
+#include <list>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 
 class SgIncidenceDirectedGraph;
@@ -62,6 +64,63 @@ public:
     virtual void buildFilteredCFG();
 };
 
+// Demand-driven interprocedural CFG.
+//
+// Unlike InterproceduralCFG, which expands every reachable function into one SgIncidenceDirectedGraph before any query, this
+// class computes the edges of a node only when they are asked for.  The nodes and edges are the virtual CFG nodes and edges
+// of the AST, plus the interprocedural edges of InterproceduralCFG: from the interprocedural index of a call (or constructor
+// initializer) to the beginning of each callee, and from the end of each callee back to the call.  The edges computed for
+// the nodes of a function are kept until more than 'maxFunctions' functions have materialized edges, then the least recently
+// used function is forgotten (and recomputed if it is needed again); zero means no limit.
+//
+// The edges leaving the end of a function and those entering its beginning need the callers of the function, which are found
+// by resolving the targets of every call of the project once, the first time such an edge is asked for.  Clients that only
+// follow edges forward from their starting node never pay for it unless they reach the end of a function.
+class ROSE_DLL_API LazyInterproceduralCFG
+{
+public:
+    explicit LazyInterproceduralCFG(SgProject* project, size_t maxFunctions = 256);
+    ~LazyInterproceduralCFG();
+
+    // Beginning of main(), the usual starting point for iterating over the edges.
+    CFGNode getEntry();
+
+    // Edges leaving or entering a node, computed on demand.
+    std::vector<CFGEdge> outEdges(const CFGNode& n);
+    std::vector<CFGEdge> inEdges(const CFGNode& n);
+
+    // Functions whose call targets and edges are currently cached.
+    size_t numberOfMaterializedFunctions() const { return functions_.size(); }
+    size_t getMaxFunctions() const { return maxFunctions_; }
+    void setMaxFunctions(size_t n);
+
+private:
+    struct FunctionEdges
+    {
+        std::map<CFGNode, std::vector<CFGEdge> > outEdges;
+        std::map<CFGNode, std::vector<CFGEdge> > inEdges;
+        std::map<SgExpression*, std::vector<SgFunctionDefinition*> > callees;
+        std::list<SgFunctionDefinition*>::iterator lru;
+    };
+
+    FunctionEdges& materialize(SgNode* node);
+    const std::vector<SgFunctionDefinition*>& callees(FunctionEdges& function, SgExpression* call);
+    const std::vector<SgExpression*>& callers(SgFunctionDefinition* def);
+    void evict();
+
+    SgProject* project_;
+    ClassHierarchyWrapper* classHierarchy_;             // built on first use
+    size_t maxFunctions_;
+    std::map<SgFunctionDefinition*, FunctionEdges> functions_;   // the nodes outside of any function are keyed by null
+    std::list<SgFunctionDefinition*> lru_;              // most recently used first
+    bool haveCallers_;
+    std::map<SgFunctionDefinition*, std::vector<SgExpression*> > callers_;
+
+    // Not copyable
+    LazyInterproceduralCFG(const LazyInterproceduralCFG&);
+    LazyInterproceduralCFG& operator=(const LazyInterproceduralCFG&);
+};
+
 } // end of namespace StaticCFG
 
 #endif
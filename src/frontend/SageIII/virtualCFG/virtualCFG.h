@@ -17,6 +17,7 @@ class SgInitializedName;
 class SgLabelSymbol;
 class SgLabelRefExp;
 class SgStatement;
+class SgFunctionDefinition;
 
 #ifndef _MSC_VER
 SgStatement* isSgStatement(SgNode* node);
@@ -272,6 +273,27 @@ extern int efgh;
     return cfgBeginningOfConstruct(start);
   }
 
+  //! Enable the CFG cache.  While the cache is enabled, CFGNode::outEdges()
+  //! and CFGNode::inEdges() are answered from a materialized CFG of the
+  //! enclosing function instead of being recomputed from the AST.  The CFG of
+  //! a function is built the first time one of its nodes is queried: the
+  //! nodes reachable from the function's start and end nodes in either
+  //! direction are numbered densely, each number maps back to its (SgNode*,
+  //! index) pair, and the successor and predecessor lists are stored as
+  //! compressed arrays of node numbers.  Edges are returned in the same order
+  //! as the AST computes them.  Nodes that are not part of any cached function
+  //! are answered from the AST as usual.  The whole cache is discarded when
+  //! the AST modification count changes, which the generated set_* functions,
+  //! SageBuilder, and SageInterface bump (see
+  //! SageInterface::noteAstModification(); code that edits the lists of IR
+  //! nodes directly must call it).  Lookups may be made from several threads
+  //! at once as long as no thread modifies the AST meanwhile.
+  ROSE_DLL_API void enableCfgCache();
+  //! Disable the CFG cache and discard its contents
+  ROSE_DLL_API void disableCfgCache();
+  //! Whether the CFG cache is enabled
+  ROSE_DLL_API bool isCfgCacheEnabled();
+
   //! "Interesting" node and edge filters
   class InterestingEdge;
 
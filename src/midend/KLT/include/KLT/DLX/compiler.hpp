@@ -34,6 +34,7 @@
 #endif
 
 #include <map>
+#include <algorithm>
 
 template <class A, class B, class C>
 void maps_composition(const std::map<A, B> & map_A_B, const std::map<B, C> & map_B_C, std::map<A, C> & map_A_C) {
@@ -77,15 +78,22 @@ class Compiler : public ::DLX::Compiler<language_tpl> {
 
     generator_t * generator;
 
+    // Generates variants of the tiling of each kernel (see generateTilingVariants). The RTL's autotuner selects the fastest version at runtime.
+    bool autotuning;
+
   public:
     Compiler(SgProject * project, const std::string & klt_rtl_path_, const std::string & user_rtl_path_, const std::string & basename) :
       ::DLX::Compiler<language_tpl>(), driver(project), model_builder(driver), klt_rtl_path(klt_rtl_path_), user_rtl_path(user_rtl_path_),
-      generator(KLT::Generator::build<generator_tpl>(driver, model_builder, klt_rtl_path + "/include", user_rtl_path + "/include", basename))
+      generator(KLT::Generator::build<generator_tpl>(driver, model_builder, klt_rtl_path + "/include", user_rtl_path + "/include", basename)),
+      autotuning(false)
     {}
     
     MFB::Driver<MFB::KLT::KLT> & getDriver() { return driver; }
     const MFB::Driver<MFB::KLT::KLT> & getDriver() const { return driver; }
 
+    void setAutotuning(bool autotuning_) { autotuning = autotuning_; }
+    bool getAutotuning() const { return autotuning; }
+
   protected: // Extract Data
     // It requires language_tpl to have KLT's data extension ('language_tpl::has_klt_data')
     Descriptor::data_t * convertData(data_clause_t * data_clause, const data_sections_t & data_section) const;
@@ -120,6 +128,8 @@ class Compiler : public ::DLX::Compiler<language_tpl> {
   protected:
     // 
     void splitKernelRoot(Kernel::kernel_t * kernel, const tiling_info_t & tiling_info, std::vector<Kernel::kernel_t *> & kernels) const;
+    // Builds the variants of 'tiling_info' that are evaluated by the autotuner: static tiles of constant size twice larger and twice smaller, and reversed order of the ordered tiles.
+    void generateTilingVariants(const tiling_info_t & tiling_info, std::vector<tiling_info_t *> & variants) const;
     // It requires language_tpl to have KLT's loop extension ('language_tpl::has_klt_loop') and tile extension ('language_tpl::has_klt_tile')
     void applyLoopTiling(
       Kernel::kernel_t * kernel,
@@ -311,6 +321,68 @@ void Compiler<language_tpl, generator_tpl>::applyLoopTiling(
   }
 
   splitKernelRoot(kernel, *tiling_info, tiled_kernels[tiling_info]);
+
+  if (autotuning) {
+    std::vector<tiling_info_t *> variants;
+    generateTilingVariants(*tiling_info, variants);
+
+    typename std::vector<tiling_info_t *>::const_iterator it_variant;
+    for (it_variant = variants.begin(); it_variant != variants.end(); it_variant++)
+      splitKernelRoot(kernel, **it_variant, tiled_kernels[*it_variant]);
+  }
+}
+
+template <class language_tpl, class generator_tpl>
+void Compiler<language_tpl, generator_tpl>::generateTilingVariants(const tiling_info_t & tiling_info, std::vector<tiling_info_t *> & variants) const {
+  typedef std::map<size_t, std::map<size_t, tile_parameter_t *> > tiling_map_t;
+  typename tiling_map_t::const_iterator it_loop;
+  typename std::map<size_t, tile_parameter_t *>::const_iterator it_tile;
+
+  // Range of the ordering indices given by the user (unordered tiles have order == -1)
+  size_t min_order = (size_t)-1;
+  size_t max_order = 0;
+  for (it_loop = tiling_info.tiling_map.begin(); it_loop != tiling_info.tiling_map.end(); it_loop++)
+    for (it_tile = it_loop->second.begin(); it_tile != it_loop->second.end(); it_tile++)
+      if (it_tile->second->order != (size_t)-1) {
+        min_order = std::min(min_order, it_tile->second->order);
+        max_order = std::max(max_order, it_tile->second->order);
+      }
+
+  // Variant #0 and #1: scale static tiles (x2 and /2), variant #2: reverse the order of the ordered tiles
+  for (size_t variant_id = 0; variant_id < 3; variant_id++) {
+    if (variant_id == 2 && (min_order == (size_t)-1 || min_order == max_order)) break;
+
+    tiling_info_t * variant = new tiling_info_t();
+    bool changed = false;
+    for (it_loop = tiling_info.tiling_map.begin(); it_loop != tiling_info.tiling_map.end(); it_loop++)
+      for (it_tile = it_loop->second.begin(); it_tile != it_loop->second.end(); it_tile++) {
+        tile_parameter_t * tile = new tile_parameter_t(*(it_tile->second));
+        variant->tiling_map[it_loop->first][it_tile->first] = tile;
+
+        if (variant_id < 2) {
+          SgIntVal * size = isSgIntVal(tile->param);
+          if ((Descriptor::tile_kind_e)tile->kind != Descriptor::e_static_tile || size == NULL) continue;
+          int value = variant_id == 0 ? size->get_value() * 2 : size->get_value() / 2;
+          if (value < 1) continue;
+          tile->param = SageBuilder::buildIntVal(value);
+          changed = true;
+        }
+        else if (tile->order != (size_t)-1) {
+          tile->order = max_order + min_order - tile->order;
+          changed = true;
+        }
+      }
+
+    if (changed) {
+      variants.push_back(variant);
+    }
+    else {
+      for (it_loop = variant->tiling_map.begin(); it_loop != variant->tiling_map.end(); it_loop++)
+        for (it_tile = it_loop->second.begin(); it_tile != it_loop->second.end(); it_tile++)
+          delete it_tile->second;
+      delete variant;
+    }
+  }
 }
 
 //////////////////////////////////////  Generate Kernels
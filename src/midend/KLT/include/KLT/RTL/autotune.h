@@ -0,0 +1,28 @@
+
+#ifndef __KLT_RTL_AUTOTUNE_H__
+#define __KLT_RTL_AUTOTUNE_H__
+
+struct klt_kernel_t;
+struct klt_version_desc_t;
+
+/* Number of executions of each version of a kernel before the fastest one is selected. */
+#ifndef KLT_AUTOTUNE_NUM_TRIALS
+#define KLT_AUTOTUNE_NUM_TRIALS 3
+#endif
+
+/* Selections are saved in a text file (one line per kernel: "hostname kernel_idx num_versions version").
+   Its path is given by the environment variable KLT_TUNING_DB (empty: nothing is saved), the default is "$HOME/.klt-tuning". */
+#define KLT_AUTOTUNE_DB_ENV "KLT_TUNING_DB"
+#define KLT_AUTOTUNE_DB_DEFAULT ".klt-tuning"
+
+/* Version to execute: the one found in the tuning database, else each version in turn until all of them have been timed. */
+struct klt_version_desc_t * klt_autotune_select_version(struct klt_kernel_t * kernel);
+
+/* Records the execution time (seconds) of one version, selects (and saves) the fastest once all of them have been timed. */
+void klt_autotune_record(struct klt_kernel_t * kernel, struct klt_version_desc_t * version, double time);
+
+/* Wall clock time in seconds. */
+double klt_autotune_time();
+
+#endif /* __KLT_RTL_AUTOTUNE_H__ */
+
@@ -0,0 +1,139 @@
+
+#include "KLT/RTL/kernel.h"
+#include "KLT/RTL/autotune.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <unistd.h>
+#include <sys/time.h>
+
+struct klt_autotune_entry_t {
+  struct klt_kernel_desc_t * desc;
+  int selected; // -1 while the versions are timed
+  int num_runs;
+  int * num_trials;
+  double * best_time;
+  struct klt_autotune_entry_t * next;
+};
+
+static struct klt_autotune_entry_t * klt_autotune_entries = NULL;
+
+static const char * klt_autotune_db_path() {
+  static char path[1024];
+  const char * env = getenv(KLT_AUTOTUNE_DB_ENV);
+  if (env != NULL) return env[0] != '\0' ? env : NULL;
+
+  const char * home = getenv("HOME");
+  if (home == NULL) return NULL;
+  snprintf(path, sizeof(path), "%s/%s", home, KLT_AUTOTUNE_DB_DEFAULT);
+  return path;
+}
+
+static void klt_autotune_hostname(char * hostname, size_t size) {
+  if (gethostname(hostname, size) != 0) strncpy(hostname, "unknown", size);
+  hostname[size - 1] = '\0';
+}
+
+/* The last line matching this machine and kernel wins (a kernel is tuned again if its line was removed). */
+static int klt_autotune_load(int kernel_idx, int num_versions) {
+  const char * path = klt_autotune_db_path();
+  if (path == NULL) return -1;
+
+  FILE * db = fopen(path, "r");
+  if (db == NULL) return -1;
+
+  char hostname[256];
+  klt_autotune_hostname(hostname, sizeof(hostname));
+
+  int selected = -1;
+  char host[256];
+  int idx, num, version;
+  while (fscanf(db, "%255s %d %d %d", host, &idx, &num, &version) == 4)
+    if (strcmp(host, hostname) == 0 && idx == kernel_idx && num == num_versions && version >= 0 && version < num_versions)
+      selected = version;
+
+  fclose(db);
+  return selected;
+}
+
+static void klt_autotune_save(int kernel_idx, int num_versions, int version) {
+  const char * path = klt_autotune_db_path();
+  if (path == NULL) return;
+
+  FILE * db = fopen(path, "a");
+  if (db == NULL) return;
+
+  char hostname[256];
+  klt_autotune_hostname(hostname, sizeof(hostname));
+
+  fprintf(db, "%s %d %d %d\n", hostname, kernel_idx, num_versions, version);
+  fclose(db);
+}
+
+static struct klt_autotune_entry_t * klt_autotune_lookup(struct klt_kernel_desc_t * desc) {
+  struct klt_autotune_entry_t * entry;
+  for (entry = klt_autotune_entries; entry != NULL; entry = entry->next)
+    if (entry->desc == desc)
+      return entry;
+
+  entry = (struct klt_autotune_entry_t *)malloc(sizeof(struct klt_autotune_entry_t));
+  entry->desc = desc;
+  entry->selected = klt_autotune_load(desc - klt_kernel_desc, desc->num_versions);
+  entry->num_runs = 0;
+  entry->num_trials = (int *)malloc(desc->num_versions * sizeof(int));
+  entry->best_time = (double *)malloc(desc->num_versions * sizeof(double));
+  int i;
+  for (i = 0; i < desc->num_versions; i++) {
+    entry->num_trials[i] = 0;
+    entry->best_time[i] = 0.;
+  }
+  entry->next = klt_autotune_entries;
+  klt_autotune_entries = entry;
+
+  return entry;
+}
+
+struct klt_version_desc_t * klt_autotune_select_version(struct klt_kernel_t * kernel) {
+  struct klt_autotune_entry_t * entry = klt_autotune_lookup(kernel->desc);
+
+  if (entry->selected >= 0)
+    return &(kernel->desc->versions[entry->selected]);
+
+  // Round-robin: interleaving the versions spreads the effect of the first executions (cold caches, page faults) over all of them.
+  return &(kernel->desc->versions[entry->num_runs % kernel->desc->num_versions]);
+}
+
+void klt_autotune_record(struct klt_kernel_t * kernel, struct klt_version_desc_t * version, double time) {
+  struct klt_autotune_entry_t * entry = klt_autotune_lookup(kernel->desc);
+  if (entry->selected >= 0) return;
+
+  int num_versions = kernel->desc->num_versions;
+  int version_idx = version - kernel->desc->versions;
+  assert(version_idx >= 0 && version_idx < num_versions);
+
+  // The best time of each version is kept: it is the least perturbed by the rest of the system.
+  if (entry->num_trials[version_idx] == 0 || time < entry->best_time[version_idx])
+    entry->best_time[version_idx] = time;
+  entry->num_trials[version_idx]++;
+  entry->num_runs++;
+
+  if (entry->num_runs < num_versions * KLT_AUTOTUNE_NUM_TRIALS) return;
+
+  int i, best = 0;
+  for (i = 1; i < num_versions; i++)
+    if (entry->best_time[i] < entry->best_time[best])
+      best = i;
+
+  entry->selected = best;
+  klt_autotune_save(kernel->desc - klt_kernel_desc, num_versions, best);
+}
+
+double klt_autotune_time() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
@@ -4,6 +4,7 @@
 #include "KLT/RTL/tile.h"
 #include "KLT/RTL/context.h"
 #include "KLT/RTL/build-context.h"
+#include "KLT/RTL/autotune.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -44,7 +45,11 @@ struct klt_kernel_t * klt_build_kernel(int idx) {
 }
 
 void klt_execute_kernel(struct klt_kernel_t * kernel) {
-  struct klt_version_desc_t * version = klt_user_select_kernel_version(kernel);
+  // Multiple versions of a kernel are tiling variants generated for autotuning, the user's runtime only selects among the versions of single-version kernels.
+  int autotune = kernel->desc->num_versions > 1;
+  struct klt_version_desc_t * version = autotune ? klt_autotune_select_version(kernel) : klt_user_select_kernel_version(kernel);
+
+  double start = autotune ? klt_autotune_time() : 0.;
 
   int i;
   for (i = 0; i < version->num_subkernels; i++) {
@@ -54,5 +59,8 @@ void klt_execute_kernel(struct klt_kernel_t * kernel) {
   }
 
   klt_user_wait(kernel);
+
+  if (autotune)
+    klt_autotune_record(kernel, version, klt_autotune_time() - start);
 }
 
@@ -129,6 +129,9 @@ class Driver<Sage> {
     /// Set a file to be compiled with the project (by default file added to the driver are *NOT* compiled)
     void setCompiledFile(file_id_t file_id) const;
 
+    /// Unparse the files that are set to be unparsed (in order of file ID) without the rest of the project, in 'number_of_workers' forked processes (default: -rose:parallel_unparse)
+    void unparse(int number_of_workers = -1) const;
+
     /// Build API of one file
     api_t * getAPI(file_id_t file_id) const;
 
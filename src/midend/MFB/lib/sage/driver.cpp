@@ -4,6 +4,9 @@
 #include "MFB/Sage/driver.hpp"
 #include "MFB/Sage/api.hpp"
 
+#include "unparser.h"
+#include "cmdline.h"
+
 #include <boost/filesystem.hpp>
 
 #ifndef VERBOSE
@@ -165,6 +168,26 @@ void Driver<Sage>::setCompiledFile(size_t file_id) const {
   it_file->second->set_skipfinalCompileStep(false);
 }
 
+void Driver<Sage>::unparse(int number_of_workers) const {
+  // A file list of its own: the files stay in the file list of the project (their parent)
+  SgFileList * file_list = new SgFileList();
+  std::map<size_t, SgSourceFile *>::const_iterator it_file;
+  for (it_file = id_to_file_map.begin(); it_file != id_to_file_map.end(); it_file++)
+    if (!it_file->second->get_skip_unparse())
+      file_list->get_listOfFiles().push_back(it_file->second);
+
+  int parallel_unparse_workers = Rose::Cmdline::parallel_unparse_workers;
+  if (number_of_workers >= 0)
+    Rose::Cmdline::parallel_unparse_workers = number_of_workers;
+
+  unparseFileList(file_list);
+
+  Rose::Cmdline::parallel_unparse_workers = parallel_unparse_workers;
+
+  file_list->get_listOfFiles().clear();
+  delete file_list;
+}
+
 boost::filesystem::path resolve(
     const boost::filesystem::path & p,
     const boost::filesystem::path & base = boost::filesystem::current_path()
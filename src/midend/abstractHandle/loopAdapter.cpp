@@ -16,6 +16,41 @@ using namespace AbstractHandle;
 map<string, abstract_node*> file_node_map;
 map<MyLoop*, abstract_node*> loop_node_map;
 
+// Return the one loopNode of a loop, creating it on the first request
+static abstract_node* getLoopNode(MyLoop* loop)
+{
+  abstract_node*& result = loop_node_map[loop];
+  if (result == NULL)
+    result = new loopNode(loop);
+  return result;
+}
+
+// Find the first of the loops matching the specifier. The numbering of a loop is its position
+// among the loops (see loopNode::getNumbering()), so it is looked up directly.
+static abstract_node* findLoop(const vector<MyLoop*>& loops, specifier mspecifier)
+{
+  if (mspecifier.get_type()==e_numbering)
+  {
+    size_t number = mspecifier.get_value().int_v;
+    if (number < 1 || number > loops.size())
+      return NULL;
+    return getLoopNode(loops[number-1]);
+  }
+  else if (mspecifier.get_type()==e_position)
+  {
+    for (vector<MyLoop *>::const_iterator i=loops.begin();i!=loops.end();i++)
+    {
+      abstract_node* cnode = getLoopNode(*i);
+      if (isEqual(mspecifier.get_value().positions, cnode->getSourcePos()))
+        return cnode;
+    }
+    return NULL;
+  }
+  cerr<<"error: unhandled specifier type in loopNode::findNode()"<<endl;
+  assert(false);
+  return NULL;
+}
+
 /* Only handle for loops
 * */
 string loopNode::getConstructTypeName() const
@@ -39,13 +74,7 @@ string loopNode::getFileName() const
 abstract_node* loopNode::getParent() const
 {
   if (getNode()->parent!=NULL)
-  {
-    abstract_node* result = loop_node_map[getNode()->parent];
-    if (result == NULL)
-      return new loopNode(getNode()->parent);
-    else
-      return result;
-  }
+    return getLoopNode(getNode()->parent);
   else
     return getFileNode();
 }
@@ -103,36 +132,7 @@ size_t loopNode::getNumbering(const abstract_node * another_node) const
 
 AbstractHandle::abstract_node* loopNode::findNode(std::string construct_type_str, AbstractHandle::specifier mspecifier) const
 {
-   abstract_node* result=NULL;
-    //Get all matched nodes according to node type
-  vector<MyLoop*> loops = getChildren();  
-  for (vector<MyLoop *>::iterator i=loops.begin();i!=loops.end();i++)
-  {
-    abstract_node* cnode = new loopNode(*i);
-    if (mspecifier.get_type()==e_position)
-    {
-      if (isEqual(mspecifier.get_value().positions, cnode->getSourcePos()))
-      {
-        result = cnode;
-        break;
-      }
-    }
-    else if (mspecifier.get_type()==e_numbering)
-    {
-      if (mspecifier.get_value().int_v == cnode->getNumbering(this))
-      {
-        result = cnode;
-        break;
-      }
-    }
-    else 
-    {
-      cerr<<"error: unhandled specifier type in loopNode::findNode()"<<endl;
-      assert(false);
-    }
-  }//end for
-  return result;
-
+  return findLoop(mNode->children, mspecifier);
 }
 
 std::string loopNode::toString() const
@@ -169,36 +169,7 @@ std::string fileNode::getName() const
 
 AbstractHandle::abstract_node* fileNode::findNode(std::string construct_type_str, AbstractHandle::specifier mspecifier) const
 {
-  abstract_node* result=NULL;
-
-  //Get all matched nodes according to node type
-  vector<MyLoop*> loops = mLoops;  
-
-  for (vector<MyLoop *>::iterator i=loops.begin();i!=loops.end();i++)
-  {
-    abstract_node* cnode = new loopNode(*i);
-    if (mspecifier.get_type()==e_position)
-    {
-      if (isEqual(mspecifier.get_value().positions, cnode->getSourcePos()))
-      {
-        result = cnode;
-        break;
-      }
-    } else if (mspecifier.get_type()==e_numbering)
-    {
-      if (mspecifier.get_value().int_v == cnode->getNumbering(this))
-      {
-        result = cnode;
-        break;
-      }
-    }
-    else 
-    {
-      cerr<<"error: unhandled specifier type in loopNode::findNode()"<<endl;
-      assert(false);
-    }
-  }//end for
-  return result;  
+  return findLoop(mLoops, mspecifier);
 }
 
 std::string fileNode::getFileName() const
@@ -27,6 +27,114 @@ namespace AbstractHandle{
       i++;
     return (VariantT)i;  
   }
+  // Index answering roseNode::findNode() and roseNode::getNumbering() without a sub-tree query per call.
+  // For a (sub-tree root, variant) pair it keeps the result of NodeQuery::querySubTree() together with
+  //  - the numbering of every node (1 + the number of preceding nodes in the same file, as getNumbering() counts),
+  //    and the first node of every numbering,
+  //  - the nodes by start line (0 without source position), the line must match for isEqual() on position pairs,
+  //  - the first node of every name, filled in only as far as lookups needed it since getName() asserts for
+  //    some declaration types that a lookup stopping earlier would never have touched.
+  // Everything is dropped when the AST modification count of NodeQuery changes.
+  class FindNodeIndex
+  {
+  public:
+    FindNodeIndex():modificationCount(0){}
+
+    SgNode* findByNumbering(SgNode* root, VariantT vt, size_t number)
+    {
+      Entry& entry = lookup(root,vt);
+      map<size_t,SgNode*>::const_iterator i = entry.firstOfNumber.find(number);
+      return i != entry.firstOfNumber.end() ? i->second : NULL;
+    }
+
+    size_t getNumbering(SgNode* root, SgNode* node)
+    {
+      Entry& entry = lookup(root,node->variantT());
+      map<SgNode*,size_t>::const_iterator i = entry.numberOf.find(node);
+      return i != entry.numberOf.end() ? i->second : entry.nextNumberOfFile[fileNameOf(node)] + 1;
+    }
+
+    SgNode* findByPosition(SgNode* root, VariantT vt, const source_position_pair& positions)
+    {
+      Entry& entry = lookup(root,vt);
+      map<size_t,vector<SgNode*> >::const_iterator line = entry.nodesOfLine.find(positions.first.line);
+      if (line == entry.nodesOfLine.end())
+        return NULL;
+      for (vector<SgNode*>::const_iterator i = line->second.begin(); i != line->second.end(); i++)
+      {
+        if (isEqual(positions, buildroseNode(*i)->getSourcePos()))
+          return *i;
+      }
+      return NULL;
+    }
+
+    SgNode* findByName(SgNode* root, VariantT vt, const string& name)
+    {
+      Entry& entry = lookup(root,vt);
+      map<string,SgNode*>::const_iterator i = entry.firstOfName.find(name);
+      if (i != entry.firstOfName.end())
+        return i->second;
+      while (entry.namesScanned < entry.nodes.size())
+      {
+        SgNode* node = entry.nodes[entry.namesScanned++];
+        string nodeName = buildroseNode(node)->getName();
+        entry.firstOfName.insert(make_pair(nodeName,node));
+        if (nodeName == name)
+          return node;
+      }
+      return NULL;
+    }
+
+  private:
+    struct Entry
+    {
+      Entry():namesScanned(0){}
+      Rose_STL_Container<SgNode*> nodes;
+      map<SgNode*,size_t> numberOf;
+      map<size_t,SgNode*> firstOfNumber;
+      map<string,size_t> nextNumberOfFile;
+      map<size_t,vector<SgNode*> > nodesOfLine;
+      map<string,SgNode*> firstOfName;
+      size_t namesScanned;
+    };
+
+    static string fileNameOf(SgNode* node)
+    {
+      return node->get_file_info() != NULL ? node->get_file_info()->get_filenameString() : string();
+    }
+
+    Entry& lookup(SgNode* root, VariantT vt)
+    {
+      if (modificationCount != NodeQuery::getAstModificationCount())
+      {
+        entries.clear();
+        modificationCount = NodeQuery::getAstModificationCount();
+      }
+
+      pair<map<pair<SgNode*,VariantT>,Entry>::iterator,bool> inserted = entries.insert(make_pair(make_pair(root,vt),Entry()));
+      Entry& entry = inserted.first->second;
+      if (inserted.second)
+      {
+        entry.nodes = NodeQuery::querySubTree(root,vt);
+        for (size_t i = 0; i < entry.nodes.size(); i++)
+        {
+          SgNode* node = entry.nodes[i];
+          size_t number = ++entry.nextNumberOfFile[fileNameOf(node)];
+          if (entry.numberOf.find(node) == entry.numberOf.end())
+            entry.numberOf[node] = number;
+          entry.firstOfNumber.insert(make_pair(number,node));
+          entry.nodesOfLine[buildroseNode(node)->getStartPos().line].push_back(node);
+        }
+      }
+      return entry;
+    }
+
+    unsigned long modificationCount;
+    map<pair<SgNode*,VariantT>,Entry> entries;
+  };
+
+  static FindNodeIndex findNodeIndex;
+
 // test LDADD dependency
   roseNode* buildroseNode(SgNode* snode)
   {
@@ -230,25 +338,13 @@ namespace AbstractHandle{
   // return the numbering within a scope 
   size_t roseNode::getNumbering(const abstract_node * another_node) const
   {
-    size_t number = 1;
     // self is counted as number 1 if no parent node exists
     if (another_node==NULL)
       return 1;
     SgNode* root = (SgNode*) ((dynamic_cast<const roseNode*> (another_node))->getNode());
     ROSE_ASSERT(root !=NULL);
-    Rose_STL_Container <SgNode*> nodeArray = NodeQuery::querySubTree(root,mNode->variantT());
-    for (Rose_STL_Container<SgNode *>::iterator i=nodeArray.begin();
-        i!=nodeArray.end(); i++)
-    {
-      if (*i == mNode) 
-        break;
-      else 
-        // should consider the node within the same file only!!
-        if ((*i)->get_file_info()->get_filenameString() == 
-            mNode->get_file_info()->get_filenameString())
-          number++;
-    }  
-    return number;
+    // Counts the preceding nodes of the same type within the same file only, see FindNodeIndex.
+    return findNodeIndex.getNumbering(root,mNode);
   }
 
   std::string roseNode::toString() const
@@ -262,45 +358,24 @@ namespace AbstractHandle{
   // eg. find a file node from a string like SgSourceFile<name,/home/liao6/names.cpp>
   abstract_node* roseNode::findNode(std::string construct_type_str, specifier mspecifier) const  
   {
-    abstract_node* result=NULL;
+    SgNode* result=NULL;
     VariantT vt = getVariantT(construct_type_str); 
-
-    //Get all matched nodes according to node type
-    Rose_STL_Container<SgNode*> nodelist =  NodeQuery::querySubTree((SgNode*)(getNode()),vt);
-
-    for (Rose_STL_Container<SgNode *>::iterator i=nodelist.begin();i!=nodelist.end();i++)
+    SgNode* root = (SgNode*)(getNode());
+
+    //Look up the first matched node of the type, in the order of NodeQuery::querySubTree()
+    if (mspecifier.get_type()==e_position)
+      result = findNodeIndex.findByPosition(root,vt,mspecifier.get_value().positions);
+    else if (mspecifier.get_type()==e_name)
+      result = findNodeIndex.findByName(root,vt,mspecifier.get_value().str_v);
+    else if (mspecifier.get_type()==e_numbering)
+      result = findNodeIndex.findByNumbering(root,vt,mspecifier.get_value().int_v);
+    else
     {
-      abstract_node* cnode = buildroseNode(*i);
-      if (mspecifier.get_type()==e_position)
-      {
-        if (isEqual(mspecifier.get_value().positions, cnode->getSourcePos()))
-        {
-          result = cnode;
-          break;
-        }
-      }
-      else if (mspecifier.get_type()==e_name)
-      {
-        if (mspecifier.get_value().str_v == cnode->getName())
-        {
-          result = cnode;
-          break;
-        }
-      } else if (mspecifier.get_type()==e_numbering)
-      {
-        if (mspecifier.get_value().int_v == cnode->getNumbering(this))
-        {
-          result = cnode;
-          break;
-        }
-      } else
-      {
-        cerr<<"error: unhandled specifier type in roseNode::findNode()"<<endl;
-        ROSE_ASSERT(false);
-      }
-    }//end for
+      cerr<<"error: unhandled specifier type in roseNode::findNode()"<<endl;
+      ROSE_ASSERT(false);
+    }
 
-    return result;
+    return result != NULL ? buildroseNode(result) : NULL;
   }
 
   // A simplest implementation here, for now
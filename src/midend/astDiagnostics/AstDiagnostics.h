@@ -6,6 +6,7 @@
 #include "AstConsistencyTests.h"
 #include "AstWarnings.h"
 #include "AstStatistics.h"
+#include "AstMemoryReport.h"
 
 // DQ (7/6/2005): Added to support performance analysis of ROSE.
 #include "AstPerformance.h"
@@ -0,0 +1,101 @@
+#ifndef AST_MEMORY_REPORT_H
+#define AST_MEMORY_REPORT_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+/*! \brief Memory accounting of the IR nodes, per IR node type.
+
+    The report is a snapshot of the memory pools taken when it is built (it can be built at any
+    point, e.g. before and after a transformation, and the two compared).  For each IR node type
+    it reports:
+    -#) the number of valid IR nodes and the bytes they use (sizeof() times the number of nodes),
+    -#) the capacity of the memory pool (entries of all its blocks) and the bytes of its blocks,
+    -#) the fragmentation of the memory pool: free entries in blocks that also contain valid IR
+        nodes (these blocks can not be released, see releaseEmptyMemoryPoolBlocks()), and the
+        number of blocks without any valid IR node,
+    -#) an estimate of the bytes held by the STL containers of the IR nodes (the lists of IR node
+        pointers, the symbol tables, the strings of names, string values and pragmas, and the
+        attached comments and preprocessor directives), and by their attribute containers.
+    The static name caches of SgNode (mangled and qualified names, maps from IR nodes to strings)
+    are reported as one total.
+    The memory used by AstAttribute objects is reported per attribute name (see AstAttribute::memoryUsage()).
+
+    \internal The memory pools are scanned by memoryPoolStatistics() (generated by ROSETTA), the
+    container and attribute estimates use one traversal of the memory pools.  Must not be called
+    while IR nodes are built or deleted.
+ */
+namespace ROSE_Statistics
+{
+class ROSE_DLL_API AstMemoryReport
+   {
+     public:
+          class ClassEntry
+             {
+               public:
+                    VariantT variant;
+                    std::string className;
+                    size_t sizeOfNode;
+                    size_t numberOfNodes;
+                    size_t numberOfBlocks;
+                    size_t numberOfEmptyBlocks;
+                    size_t capacity;
+                    size_t freeEntriesInUsedBlocks;
+                    size_t freeListLength;
+                    size_t containerBytes;
+                    size_t attributeContainerBytes;
+                    size_t attributeBytes;
+
+                    ClassEntry(const MemoryPoolStatistics & statistics);
+
+                 // Bytes of the valid IR nodes and of all the blocks of the memory pool.
+                    size_t nodeBytes() const { return numberOfNodes * sizeOfNode; }
+                    size_t poolBytes() const { return capacity * sizeOfNode; }
+
+                 // Free entries in blocks with valid IR nodes relative to the capacity of the memory pool.
+                    double fragmentation() const { return capacity > 0 ? (double) freeEntriesInUsedBlocks / capacity : 0.0; }
+             };
+
+          class AttributeEntry
+             {
+               public:
+                    std::string name;
+                    size_t count;
+                    size_t bytes;
+
+                    AttributeEntry(const std::string & name) : name(name), count(0), bytes(0) {}
+             };
+
+       // Build the report from the current state of the memory pools.
+          AstMemoryReport();
+
+       // IR node types which have a memory pool block (in the order of the IR node variants).
+          const std::vector<ClassEntry> & get_classes() const { return classes; }
+
+       // Attributes of all IR nodes, by attribute name (in the order of the names).
+          const std::vector<AttributeEntry> & get_attributes() const { return attributes; }
+
+       // Sums over all IR node types.
+          size_t totalNodeBytes() const;
+          size_t totalPoolBytes() const;
+          size_t totalContainerBytes() const;
+          size_t totalAttributeBytes() const;
+
+       // Estimate of the bytes of the static name caches of SgNode.
+          size_t get_nameCacheBytes() const { return nameCacheBytes; }
+
+       // Human readable table (one line per IR node type, then one line per attribute name).
+          std::string toString() const;
+
+       // JSON document with the same data (sizes in bytes).
+          void writeJson(std::ostream & output) const;
+
+     private:
+          std::vector<ClassEntry> classes;
+          std::vector<AttributeEntry> attributes;
+          size_t nameCacheBytes;
+   };
+}
+
+#endif
@@ -209,6 +209,19 @@ class ROSE_DLL_API AstPerformance
           static void startTimer ( RoseTimeType & time );
           static void accumulateTime ( RoseTimeType & startTime, double & accumulatedTime, double & numberFunctionCalls );
 
+       // Performance trace (-rose:performance_trace <file>): every TimingPerformance phase that ends once the trace is
+       // enabled is recorded as a complete event (with its thread, the source file it is attributed to, and the current
+       // and peak memory use). The events are written at exit in the Chrome Trace Event Format (read by
+       // chrome://tracing and Perfetto); only the process that enabled the trace writes the file.
+          static void enableTrace ( const std::string & filename );
+          static bool traceEnabled ();
+          static void writeTrace ();
+
+     protected:
+          static void recordTraceEvent ( const std::string & name, const RoseTimeType & startTime, double duration, double memoryUsage );
+
+     public:
+
      protected:
        // Storage of all performance information about 
        // processing phases saved here for later processing.
@@ -241,6 +254,17 @@ class ROSE_DLL_API TimingPerformance : public AstPerformance
           typedef RoseTimeType time_type; // For compatibility
    };
 
+// Attributes the phases that end during its lifetime (on the same thread) to a source file in the performance trace.
+class ROSE_DLL_API PerformanceTraceFile
+   {
+     public:
+          PerformanceTraceFile ( const std::string & filename );
+          ~PerformanceTraceFile ();
+
+     private:
+          std::string previousFileName;
+   };
+
 // comment out use of namespace
 // }
 
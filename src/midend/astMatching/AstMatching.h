@@ -11,12 +11,16 @@
 #include "MatchOperation.h"
 #include "RoseAst.h"
 #include <list>
+#include <map>
 #include <set>
 
 class SgNode;
 
 class MatchOperation;
 
+/* An AstMatching object must not be used by more than one thread at a
+   time, and distinct objects must not parse patterns concurrently: the
+   pattern parser and lexer keep their state in global variables. */
 class AstMatching {
  public:
   AstMatching();
@@ -45,11 +49,26 @@ class AstMatching {
   void performMatchingOnAst(SgNode* root);
   void performMatching();
   void generateMatchOperationsSequence();
+  bool canMatchAt(SgNode* node);
+
+ private:
+  // not copyable: the parsed match expressions are owned by the object
+  AstMatching(const AstMatching&);
+  AstMatching& operator=(const AstMatching&);
 
  private:
   std::string _matchExpression;
   SgNode* _root;
   MatchOperationList* _matchOperationsSequence;
+  /* match expressions parsed by this object, owned by it. Match
+     operation sequences are not modified by matching, hence a matcher
+     reused for the same pattern parses it only once. */
+  std::map<std::string,MatchOperationList*> _parsedMatchExpressions;
+  /* type names (in typeid format) a node must have for the pattern to
+     match at it, if _rootNodeNamesRestricted. Nodes of other types are
+     not matched against the pattern. */
+  std::set<std::string> _rootNodeNames;
+  bool _rootNodeNamesRestricted;
   MatchStatus _status;
   bool _keepMarkedLocations;
 };
@@ -66,22 +66,36 @@ class MatchStatus {
 
 class MatchOperation {
  public:
+  virtual ~MatchOperation() {}
   virtual std::string toString()=0;
   virtual bool performOperation(MatchStatus&  status, RoseAst::iterator& i, SingleMatchResult& vb);
+  /* adds the type names (in typeid format) one of which the node at
+     the iterator must have for this operation to succeed. Returns
+     false if the operation is not restricted to a set of names. */
+  virtual bool rootNodeNames(std::set<std::string>& names) { return false; }
 };
 
 class MatchOpSequence : public std::list<MatchOperation*>{
   // we are using default std::list constructors
  public:
+  // the sequence owns its operations
+  ~MatchOpSequence();
   std::string toString();
   bool performOperation(MatchStatus&  status, RoseAst::iterator& i, SingleMatchResult& vb);
+  /* adds the type names one of which a node must have for the
+     sequence to match at this node (operations that neither move the
+     iterator nor inspect the node are passed over). Returns false if
+     the sequence can match at a node of any type. */
+  bool rootNodeNames(std::set<std::string>& names);
 };
 
 class MatchOpOr : public MatchOperation {
  public:
  MatchOpOr(MatchOpSequence* l, MatchOpSequence* r):_left(l),_right(r){}
+  ~MatchOpOr() { delete _left; delete _right; }
   std::string toString();
   bool performOperation(MatchStatus& status, RoseAst::iterator& i, SingleMatchResult& vb);
+  bool rootNodeNames(std::set<std::string>& names);
  private:
   MatchOpSequence* _left;
   MatchOpSequence* _right;
@@ -101,6 +115,7 @@ class MatchOpCheckNode : public MatchOperation {
   MatchOpCheckNode(std::string nodename);
   std::string toString();
   bool performOperation(MatchStatus&  status, RoseAst::iterator& i, SingleMatchResult& vb);
+  bool rootNodeNames(std::set<std::string>& names);
  private:
   std::string _nodename;
 };
@@ -182,6 +197,7 @@ typedef std::list<MatchOperationList*> MatchOperationListList;
 class MatchOpBinaryOp : public MatchOperation {
  public:
  MatchOpBinaryOp(int op,MatchOperation* l,MatchOperation* r):_op(op),_left(l),_right(r) {}
+  ~MatchOpBinaryOp() { delete _left; delete _right; }
   std::string toString() { return "binop()";}
   bool performOperation(MatchStatus&  status, RoseAst::iterator& i, SingleMatchResult& vb) {
     switch(_op) {
@@ -4,8 +4,10 @@
 #include "rosedll.h"
 #include "rose_override.h"
 #include <Sawyer/Attribute.h>
+#include <Sawyer/Map.h>
 #include <list>
 #include <set>
+#include <vector>
 
 class SgNode;
 class SgNamedType;
@@ -200,6 +202,15 @@ public:
      *
      *  Or to tailor the presentation of information about ASTs. */
     virtual bool commentOutNodeInGraph();
+
+    /** Memory used by the attribute.
+     *
+     *  Returns the number of bytes used by this attribute, including any heap memory that it owns.  This is used to account
+     *  for the memory held by attributes of IR nodes (see @ref ROSE_Statistics::AstMemoryReport).  The base implementation
+     *  only knows the size of @ref AstAttribute itself, subclasses that are large or own memory should override it. */
+    virtual size_t memoryUsage() const {
+        return sizeof(AstAttribute);
+    }
 };
 
 
@@ -237,14 +248,33 @@ public:
  *
  *  For additional information, including examples, see @ref attributes. */
 class ROSE_DLL_API AstAttributeMechanism {
-    // Use containment because we want to keep the original API.
-    Sawyer::Attribute::Storage attributes_;
+public:
+    /** Interned attribute name.
+     *
+     *  Attribute names are interned in the @ref Sawyer::Attribute name table. A key can be obtained once with @ref key and
+     *  then used for all subsequent operations, which avoids looking up the name string for every query. */
+    typedef Sawyer::Attribute::Id Key;
+
+private:
+    // Most IR nodes have zero or one attribute, so the first few attributes are stored inline and only additional
+    // attributes are stored in a map that is allocated on demand.
+    enum { N_INLINE_ATTRIBUTES = 2 };
+    struct InlineAttribute {
+        Key key;
+        AstAttribute *value;
+    };
+    typedef Sawyer::Container::Map<Key, AstAttribute*> SpilledAttributes;
+
+    InlineAttribute inline_[N_INLINE_ATTRIBUTES];
+    size_t nInline_;                                    // number of used inline_ slots (they are at the front)
+    SpilledAttributes *spilled_;                        // null until more than N_INLINE_ATTRIBUTES are stored
 
 public:
     /** Default constructor.
      *
      *  Constructs an attribute mechanism that holds no attributes. */
-    AstAttributeMechanism() {}
+    AstAttributeMechanism()
+        : nInline_(0), spilled_(NULL) {}
 
     /** Copy constructor.
      *
@@ -254,7 +284,8 @@ public:
      *
      *  <b>New semantics:</b> The original behavior was that if the value's @c copy method returned null, the @ref exists
      *  predicate returned true even though no value existed. */
-    AstAttributeMechanism(const AstAttributeMechanism &other) {
+    AstAttributeMechanism(const AstAttributeMechanism &other)
+        : nInline_(0), spilled_(NULL) {
         assignFrom(other);
     }
 
@@ -385,9 +416,49 @@ public:
      *  number of stored attributes (such as when a previous query for a non-existing attribute occurred). */
     size_t size() const;
 
+    /** Memory used by the container.
+     *
+     *  Returns the number of bytes used by this container itself (the inline attribute slots and the map for additional
+     *  attributes, when there is one), not including the memory used by the attributes stored in it. */
+    size_t memoryUsage() const;
+
+    /** Obtain the key for an attribute name.
+     *
+     *  Returns the interned key for the specified attribute name, declaring the name if it was not used before. The key is
+     *  the same for all containers and for the lifetime of the program, so it can be stored (e.g., in a static variable) and
+     *  reused by the key-based methods below, none of which look at the name string. */
+    static Key key(const std::string &name);
+
+    /** Name for an attribute key.
+     *
+     *  Returns the name that was used to obtain the specified key. */
+    static const std::string& name(Key);
+
+    /** Key-based versions of the string-based methods.
+     *
+     *  These have the same semantics as the methods of the same name that take an attribute name string. The string-based
+     *  methods are thin wrappers that look up the key for the name.
+     *
+     * @{ */
+    bool exists(Key) const;
+    void set(Key, AstAttribute *value);
+    bool add(Key, AstAttribute *value);
+    bool replace(Key, AstAttribute *value);
+    AstAttribute* operator[](Key) const;
+    void remove(Key);
+    /** @} */
+
 private:
     // Called by copy constructor and assignment.
     void assignFrom(const AstAttributeMechanism &other);
+
+    // Low-level storage. These do not apply any ownership policies.
+    AstAttribute* findValue(Key) const;
+    void storeValue(Key, AstAttribute *value);
+    void eraseValue(Key);
+    void clearValues();
+    std::vector<Key> keys() const;
+    void swap(AstAttributeMechanism &other);
 };
 
 
@@ -455,6 +526,7 @@ public:
 
     virtual AstAttribute* copy() const ROSE_OVERRIDE { return new AstValueAttribute(*this); }
     virtual std::string attribute_class_name() const ROSE_OVERRIDE { return "AstValueAttribute"; }
+    virtual size_t memoryUsage() const ROSE_OVERRIDE { return sizeof(*this); }
 
     /** Return the stored value by reference.
      *
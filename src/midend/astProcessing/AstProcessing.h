@@ -14,6 +14,7 @@
 #endif
 
 #include <vector>
+#include <deque>
 #include <algorithm>
 #include <utility>
 #include <iostream>
@@ -45,6 +46,9 @@ SgTreeTraversal_inFileToTraverse(SgNode* node, bool traversalConstraint, SgFile*
      principle) only passing iterators instead of copying a container;
      traverse() is now only a thin wrapper around performTraversal() that
      takes care of visiting nodes and pushing/popping synthesized attributes
+     (performTraversal() keeps the path to the current node on an explicit
+     stack rather than recursing, so the depth of the AST is not limited by
+     the size of the call stack)
    - rewrote inFileToTraverse() to use new AST features instead of lots of
      string comparisons; it is now explicitly stated (at least in this
      comment) that we *do* visit subtrees from other files unless their root
@@ -165,6 +169,26 @@ private:
             t_traverseOrder travOrder);
     SynthesizedAttributeType traversalResult();
 
+    // A node whose successors are being visited by performTraversal(), which keeps these on an explicit stack
+    // instead of recursing (deeply nested expressions would otherwise overflow the call stack).
+    struct TraversalFrame
+    {
+        SgNode *node;
+        InheritedAttributeType inheritedValue;
+        SuccessorsContainer succContainer;
+        size_t numberOfSuccessors;
+        size_t nextSuccessor;
+
+        TraversalFrame(SgNode *n, const InheritedAttributeType &inh)
+            : node(n), inheritedValue(inh), numberOfSuccessors(0), nextSuccessor(0) {}
+    };
+    typedef std::deque<TraversalFrame> TraversalStack;
+
+    // Evaluates the inherited attribute of node and pushes its frame onto the stack.
+    void enterNode(TraversalStack &stack, SgNode *node,
+            InheritedAttributeType inheritedValue,
+            t_traverseOrder travOrder);
+
     bool useDefaultIndexBasedTraversal;
     bool traversalConstraint;
     SgFile *fileToVisit;
@@ -203,6 +227,33 @@ public:
     SynthesizedAttributeType traverseWithinFile(SgNode* node, InheritedAttributeType inheritedValue);
     
 
+    //! combines the synthesized attributes of two adjacent ranges of children of parent (left comes first), see
+    //! parallelTraverse(); must be associative
+    class SynthesizedAttributeReduction
+    {
+    public:
+        virtual ~SynthesizedAttributeReduction() {}
+        virtual SynthesizedAttributeType operator()(SgNode* parent, SynthesizedAttributeType left,
+                SynthesizedAttributeType right) = 0;
+    };
+
+    //! evaluates attributes on the entire AST, sibling subtrees concurrently (see below)
+    SynthesizedAttributeType parallelTraverse(SgNode* node, InheritedAttributeType inheritedValue,
+            size_t grainSize = 1000, SynthesizedAttributeReduction* reduction = NULL, size_t numberOfThreads = 0);
+
+    // parallelTraverse() computes the same attributes as traverse(), but the children of a node are split into
+    // ranges of consecutive children with at least grainSize nodes (a child that large is a range of its own), and
+    // if there are at least two such ranges they are evaluated as tasks of an AstWorkStealingScheduler with
+    // numberOfThreads workers (zero: the hardware concurrency); the other children are evaluated by the thread that
+    // visits the node. evaluateInheritedAttribute() and evaluateSynthesizedAttribute() are therefore called
+    // concurrently for nodes of different subtrees and must not have side effects on shared data. The AST is walked
+    // with an explicit stack, and the subtrees are always visited with the default (index-based) successors.
+    // If a reduction is given, the synthesized attributes of the children of a node with more than grainSize
+    // successors (such as a global scope with many declarations) are combined with it in order, as they are
+    // computed, and evaluateSynthesizedAttribute() is called with a list of that single value for such a node.
+    // The implementation is in AstSharedMemorySubtreeParallelProcessing.h (not available on Windows), which has to
+    // be included to use parallelTraverse().
+
     friend class AstCombinedTopDownBottomUpProcessing<InheritedAttributeType, SynthesizedAttributeType>;
 
 protected:
@@ -225,6 +276,16 @@ protected:
     //! no-op.
     virtual void atTraversalStart();
     virtual void atTraversalEnd();
+
+private:
+    struct ParallelContext;
+    struct ParallelFrame;
+    class ParallelRangeTask;
+
+    SynthesizedAttributeType parallelEvaluateSubtree(const ParallelContext& context, SgNode* node,
+            size_t preorder, InheritedAttributeType inheritedValue, bool spawnChildren);
+    void parallelEnterNode(const ParallelContext& context, std::deque<ParallelFrame>& frames, SgNode* node,
+            size_t preorder, InheritedAttributeType inheritedValue, bool spawnChildren);
 };
 
 template <class InheritedAttributeType>
@@ -738,6 +799,37 @@ traverse(SgNode *node, InheritedAttributeType inheritedValue,
 
 
 
+template<class InheritedAttributeType, class SynthesizedAttributeType>
+void
+SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+enterNode(TraversalStack &stack,
+        SgNode* node,
+        InheritedAttributeType inheritedValue,
+        t_traverseOrder treeTraversalOrder)
+   {
+  // In case of a preorder traversal call the function to be applied to each node of the AST
+  // GB (7/6/2007): Because AstPrePostProcessing was introduced, a
+  // treeTraversalOrder can now be pre *and* post at the same time! The
+  // == comparison was therefore replaced by a bit mask check.
+     if (treeTraversalOrder & preorder)
+          inheritedValue = evaluateInheritedAttribute(node, inheritedValue);
+
+  // Visit the traversable data members of this AST node.
+  // GB (09/25/2007): Added support for index-based traversals. The useDefaultIndexBasedTraversal flag tells us
+  // whether to use successor containers or direct index-based access to the node's successors.
+     stack.push_back(TraversalFrame(node, inheritedValue));
+     TraversalFrame &frame = stack.back();
+     if (!useDefaultIndexBasedTraversal)
+        {
+          setNodeSuccessors(node, frame.succContainer);
+          frame.numberOfSuccessors = frame.succContainer.size();
+        }
+       else
+        {
+          frame.numberOfSuccessors = node->get_numberOfTraversalSuccessors();
+        }
+   }
+
 template<class InheritedAttributeType, class SynthesizedAttributeType>
 void
 SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>::
@@ -752,96 +844,77 @@ performTraversal(SgNode* node,
   // 2. inFileToTraverse is false if we are trying to go to a different file (than the input file)
   //    and only if traverseInputFiles was invoked, otherwise it's always true
 
-     if (node && SgTreeTraversal_inFileToTraverse(node, traversalConstraint, fileToVisit))
+     if (!node || !SgTreeTraversal_inFileToTraverse(node, traversalConstraint, fileToVisit))
         {
-       // In case of a preorder traversal call the function to be applied to each node of the AST
-       // GB (7/6/2007): Because AstPrePostProcessing was introduced, a
-       // treeTraversalOrder can now be pre *and* post at the same time! The
-       // == comparison was therefore replaced by a bit mask check.
-          if (treeTraversalOrder & preorder)
-               inheritedValue = evaluateInheritedAttribute(node, inheritedValue);
-  
-       // Visit the traversable data members of this AST node.
-       // GB (09/25/2007): Added support for index-based traversals. The useDefaultIndexBasedTraversal flag tells us
-       // whether to use successor containers or direct index-based access to the node's successors.
-          AstSuccessorsSelectors::SuccessorsContainer succContainer;
-          size_t numberOfSuccessors;
-          if (!useDefaultIndexBasedTraversal)
-             {
-               setNodeSuccessors(node, succContainer);
-               numberOfSuccessors = succContainer.size();
-             }
-            else
-             {
-               numberOfSuccessors = node->get_numberOfTraversalSuccessors();
-             }
+          if (treeTraversalOrder & postorder)
+               synthesizedAttributes->push(defaultSynthesizedAttribute(inheritedValue));
+          return;
+        }
 
-          for (size_t idx = 0; idx < numberOfSuccessors; idx++)
+  // The nodes on the path from node to the node currently visited, with their (evaluated) inherited attributes. The
+  // callbacks are made in the same order as by a recursive traversal. A deque does not move its elements when it
+  // grows, so references to frames stay valid while children are pushed.
+     TraversalStack stack;
+     enterNode(stack, node, inheritedValue, treeTraversalOrder);
+
+     while (!stack.empty())
+        {
+          TraversalFrame &frame = stack.back();
+
+          if (frame.nextSuccessor < frame.numberOfSuccessors)
              {
+               size_t idx = frame.nextSuccessor++;
                SgNode *child = NULL;
 
                if (useDefaultIndexBasedTraversal)
                   {
-                 // ROSE_ASSERT(node->get_traversalSuccessorByIndex(idx) != NULL || node->get_traversalSuccessorByIndex(idx) == NULL);
-                    child = node->get_traversalSuccessorByIndex(idx);
+                    child = frame.node->get_traversalSuccessorByIndex(idx);
 
                  // DQ (4/21/2014): Valgrind test to isolate uninitialised read reported where child is read below.
                     ROSE_ASSERT(child == NULL || child != NULL);
                   }
                  else
                   {
-                 // ROSE_ASSERT(succContainer[idx] != NULL || succContainer[idx] == NULL);
-                    child = succContainer[idx];
+                    child = frame.succContainer[idx];
 
                  // DQ (4/21/2014): Valgrind test to isolate uninitialised read reported where child is read below.
                     ROSE_ASSERT(child == NULL || child != NULL);
                   }
 
-               if (child != NULL)
+               if (child != NULL && SgTreeTraversal_inFileToTraverse(child, traversalConstraint, fileToVisit))
                   {
-                
-                    
-                   
-                        performTraversal(child, inheritedValue, treeTraversalOrder);
-                        
-                
-                   
-                //ENDEDIT
-                   }
+                    enterNode(stack, child, frame.inheritedValue, treeTraversalOrder);
+                  }
                  else
                   {
-                 // null pointer (not traversed): we put the default value(s) of SynthesizedAttribute onto the stack
+                 // null pointer or node in another file (not traversed): we put the default value(s) of
+                 // SynthesizedAttribute onto the stack
                     if (treeTraversalOrder & postorder)
-                         synthesizedAttributes->push(defaultSynthesizedAttribute(inheritedValue));
+                         synthesizedAttributes->push(defaultSynthesizedAttribute(frame.inheritedValue));
                   }
              }
- 
-       // In case of a postorder traversal call the function to be applied to each node of the AST
-       // GB (7/6/2007): Because AstPrePostProcessing was introduced, a
-       // treeTraversalOrder can now be pre *and* post at the same time! The
-       // == comparison was therefore replaced by a bit mask check.
-       // The call to evaluateInheritedAttribute at this point also had to be
-       // changed; it was never elegant anyway as we were not really
-       // evaluating attributes here.
-          if (treeTraversalOrder & postorder)
+            else
              {
-            // Now that every child's synthesized attributes are on the stack:
-            // Tell the stack how big the stack frame containing those
-            // attributes is to be, and pass that frame to
-            // evaluateSynthesizedAttribute(); then replace those results by
-            // pushing the computed value onto the stack (which pops off the
-            // previous stack frame).
-               synthesizedAttributes->setFrameSize(numberOfSuccessors);
-               ROSE_ASSERT(synthesizedAttributes->size() == numberOfSuccessors);
-               synthesizedAttributes->push(evaluateSynthesizedAttribute(node, inheritedValue, *synthesizedAttributes));
+            // In case of a postorder traversal call the function to be applied to each node of the AST
+            // GB (7/6/2007): Because AstPrePostProcessing was introduced, a
+            // treeTraversalOrder can now be pre *and* post at the same time! The
+            // == comparison was therefore replaced by a bit mask check.
+               if (treeTraversalOrder & postorder)
+                  {
+                 // Now that every child's synthesized attributes are on the stack:
+                 // Tell the stack how big the stack frame containing those
+                 // attributes is to be, and pass that frame to
+                 // evaluateSynthesizedAttribute(); then replace those results by
+                 // pushing the computed value onto the stack (which pops off the
+                 // previous stack frame).
+                    synthesizedAttributes->setFrameSize(frame.numberOfSuccessors);
+                    ROSE_ASSERT(synthesizedAttributes->size() == frame.numberOfSuccessors);
+                    synthesizedAttributes->push(evaluateSynthesizedAttribute(frame.node, frame.inheritedValue, *synthesizedAttributes));
+                  }
+               stack.pop_back();
              }
         }
-       else // if (node && inFileToTraverse(node))
-        {
-          if (treeTraversalOrder & postorder)
-               synthesizedAttributes->push(defaultSynthesizedAttribute(inheritedValue));
-        }
-       } // function body
+   }
 
 
 // GB (05/30/2007)
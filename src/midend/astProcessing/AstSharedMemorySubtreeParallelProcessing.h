@@ -0,0 +1,172 @@
+// Subtree-parallel (multithreaded) AST traversals.
+
+// The AstSharedMemoryParallel*Processing classes run each traversal of a combined traversal in its own thread, so they
+// only scale with the number of traversals. The classes in this file instead split the AST itself: child subtrees near
+// the root (up to a configurable depth, and only if they are large enough) are turned into tasks that are executed by a
+// pool of worker threads using work stealing. The synthesized attribute of a spawned subtree is passed back to the
+// parent through a future, so the attribute evaluation order seen by evaluateSynthesizedAttribute() is the same as for
+// the sequential traversal. The evaluate*Attribute() functions of the user's traversal are called concurrently for
+// nodes in different subtrees and must therefore be thread-safe.
+
+#ifndef ASTSHAREDMEMORYSUBTREEPARALLELPROCESSING_H
+#define ASTSHAREDMEMORYSUBTREEPARALLELPROCESSING_H
+
+#include "AstProcessing.h"
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <deque>
+
+// A unit of work for the AstWorkStealingScheduler. The scheduler calls execute() exactly once and then marks the
+// task as finished; waitForTask() can be used to block (while helping with other tasks) until that happens.
+class ROSE_DLL_API AstWorkStealingTask
+{
+public:
+    AstWorkStealingTask();
+    virtual ~AstWorkStealingTask();
+    virtual void execute() = 0;
+
+    bool isFinished();
+
+private:
+    friend class AstWorkStealingScheduler;
+    void markFinished();
+
+    boost::mutex mutex;
+    bool finished;
+};
+
+// A pool of worker threads, each of which has its own deque of tasks. A worker pushes and pops tasks at the back of
+// its own deque (depth-first, good locality), idle workers steal from the front of another worker's deque (the oldest
+// and thus usually the largest subtrees). A thread that waits for a task executes other tasks in the meantime, so
+// nested waiting does not deadlock and does not waste a worker.
+class ROSE_DLL_API AstWorkStealingScheduler
+{
+public:
+    // Creates the worker threads. If numberOfThreads is zero the hardware concurrency is used.
+    explicit AstWorkStealingScheduler(size_t numberOfThreads = 0);
+    ~AstWorkStealingScheduler();
+
+    size_t get_numberOfThreads() const;
+
+    // Submit a task. If called from one of the worker threads the task is placed on that worker's deque, otherwise
+    // it is placed on the deque of worker zero. The task is not owned by the scheduler.
+    void spawn(AstWorkStealingTask *task);
+
+    // Wait for a task to finish. Worker threads (and the thread that owns the scheduler) execute other tasks while
+    // they wait, stealing them from other workers only up to a small nesting depth.
+    void waitForTask(AstWorkStealingTask *task);
+
+private:
+    struct WorkerDeque
+    {
+        boost::mutex mutex;
+        std::deque<AstWorkStealingTask *> tasks;
+    };
+
+    enum { maximumStealDepth = 16 };
+
+    void workerMain(size_t workerId);
+    AstWorkStealingTask *findTask(size_t workerId, bool ownOnly);
+    void runTask(AstWorkStealingTask *task);
+    size_t currentWorkerId() const;
+
+    std::vector<WorkerDeque *> deques;
+    boost::thread_group workers;
+    boost::thread_specific_ptr<size_t> workerId;         // set in each worker thread, NULL in other threads
+    std::vector<size_t> helpDepth;                      // nested tasks run by waitForTask(), by worker (last: owner)
+    boost::mutex mutex;                                 // protects the following members
+    boost::condition_variable workAvailable;            // signaled when a task is spawned or on shutdown
+    size_t pendingTasks;                                // number of spawned tasks not yet taken by a worker
+    bool shuttingDown;
+
+    // not copyable
+    AstWorkStealingScheduler(const AstWorkStealingScheduler &);
+    AstWorkStealingScheduler &operator=(const AstWorkStealingScheduler &);
+};
+
+// TOP DOWN BOTTOM UP subtree-parallel traversal
+
+// Drop-in replacement for AstTopDownBottomUpProcessing. Calling traverse() performs the ordinary sequential
+// traversal; traverseInParallel() splits the AST into tasks. A child subtree is evaluated as a separate task if its
+// depth (the root of the traversal has depth 0) is at most the spawn depth and it contains at least the minimum
+// subtree size number of nodes (counting stops as soon as that bound is met, so checking is cheap).
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+class AstSharedMemorySubtreeParallelTopDownBottomUpProcessing
+    : public AstTopDownBottomUpProcessing<InheritedAttributeType, SynthesizedAttributeType>
+{
+public:
+    typedef AstTopDownBottomUpProcessing<InheritedAttributeType, SynthesizedAttributeType> Superclass;
+    typedef typename Superclass::SynthesizedAttributesList SynthesizedAttributesList;
+
+    AstSharedMemorySubtreeParallelTopDownBottomUpProcessing();
+
+    SynthesizedAttributeType traverseInParallel(SgNode *basenode, InheritedAttributeType inheritedValue);
+
+    void set_numberOfThreads(size_t threads);
+    void set_spawnDepth(size_t depth);
+    void set_minimumSubtreeSize(size_t size);
+
+private:
+    class SubtreeTask;
+
+    SynthesizedAttributeType evaluateSubtree(SgNode *node, InheritedAttributeType inheritedValue, size_t depth,
+                                             SynthesizedAttributesList &stack);
+    void traverseSubtree(SgNode *node, InheritedAttributeType inheritedValue, size_t depth,
+                         SynthesizedAttributesList &stack);
+    bool shouldSpawn(SgNode *child, size_t depth) const;
+
+    size_t numberOfThreads;
+    size_t spawnDepth;
+    size_t minimumSubtreeSize;
+    AstWorkStealingScheduler *scheduler;
+};
+
+// TOP DOWN subtree-parallel traversal
+
+template <class InheritedAttributeType>
+class AstSharedMemorySubtreeParallelTopDownProcessing
+    : public AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<InheritedAttributeType, DummyAttribute>
+{
+public:
+    typedef AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<InheritedAttributeType, DummyAttribute> Superclass;
+    typedef typename Superclass::SynthesizedAttributesList SynthesizedAttributesList;
+
+    void traverseInParallel(SgNode *basenode, InheritedAttributeType inheritedValue);
+
+protected:
+    virtual InheritedAttributeType evaluateInheritedAttribute(SgNode *astNode, InheritedAttributeType inheritedValue) = 0;
+    virtual void destroyInheritedValue(SgNode *, InheritedAttributeType);
+
+private:
+    DummyAttribute evaluateSynthesizedAttribute(SgNode *astNode, InheritedAttributeType inheritedValue,
+                                                SynthesizedAttributesList l);
+};
+
+// BOTTOM UP subtree-parallel traversal
+
+template <class SynthesizedAttributeType>
+class AstSharedMemorySubtreeParallelBottomUpProcessing
+    : public AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<DummyAttribute, SynthesizedAttributeType>
+{
+public:
+    typedef AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<DummyAttribute, SynthesizedAttributeType> Superclass;
+    typedef typename Superclass::SynthesizedAttributesList SynthesizedAttributesList;
+
+    SynthesizedAttributeType traverse(SgNode *basenode);
+    SynthesizedAttributeType traverseInParallel(SgNode *basenode);
+
+protected:
+    virtual SynthesizedAttributeType evaluateSynthesizedAttribute(SgNode *, SynthesizedAttributesList) = 0;
+
+private:
+    DummyAttribute evaluateInheritedAttribute(SgNode *astNode, DummyAttribute inheritedValue);
+    SynthesizedAttributeType evaluateSynthesizedAttribute(SgNode *astNode, DummyAttribute inheritedValue,
+                                                          SynthesizedAttributesList l);
+};
+
+#include "AstSharedMemorySubtreeParallelProcessingImpl.h"
+
+#endif
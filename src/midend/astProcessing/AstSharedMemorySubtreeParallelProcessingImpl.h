@@ -0,0 +1,557 @@
+#ifndef ASTSHAREDMEMORYSUBTREEPARALLELPROCESSING_C
+#define ASTSHAREDMEMORYSUBTREEPARALLELPROCESSING_C
+
+#include "AstSharedMemorySubtreeParallelProcessing.h"
+
+// Throughout this file, I is the InheritedAttributeType, S is the
+// SynthesizedAttributeType
+
+// subtree-parallel TOP DOWN BOTTOM UP implementation
+
+// A spawned child subtree. The task evaluates the subtree on its own stack of
+// synthesized attributes and leaves the subtree's attribute in 'result' where
+// the parent picks it up after waiting for the task (i.e., the task is the
+// future of the child's synthesized attribute).
+template <class I, class S>
+class AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::SubtreeTask
+    : public AstWorkStealingTask
+{
+public:
+    SubtreeTask(AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S> *traversal,
+            SgNode *node, I inheritedValue, size_t depth)
+        : traversal(traversal), node(node), inheritedValue(inheritedValue), depth(depth), result()
+    {
+    }
+
+    virtual void execute()
+    {
+        SynthesizedAttributesList stack;
+        result = traversal->evaluateSubtree(node, inheritedValue, depth, stack);
+    }
+
+    AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S> *traversal;
+    SgNode *node;
+    I inheritedValue;
+    size_t depth;
+    S result;
+};
+
+template <class I, class S>
+AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::AstSharedMemorySubtreeParallelTopDownBottomUpProcessing()
+    : numberOfThreads(0), spawnDepth(8), minimumSubtreeSize(1000), scheduler(NULL)
+{
+}
+
+template <class I, class S>
+void
+AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::set_numberOfThreads(size_t threads)
+{
+    numberOfThreads = threads;
+}
+
+template <class I, class S>
+void
+AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::set_spawnDepth(size_t depth)
+{
+    spawnDepth = depth;
+}
+
+template <class I, class S>
+void
+AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::set_minimumSubtreeSize(size_t size)
+{
+    minimumSubtreeSize = size;
+}
+
+template <class I, class S>
+S
+AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::traverseInParallel(SgNode *basenode, I inheritedValue)
+{
+    AstWorkStealingScheduler workers(numberOfThreads);
+    scheduler = &workers;
+
+    this->atTraversalStart();
+
+    // The root is a task like any other subtree; the calling thread helps with
+    // the work while it waits for the result.
+    SubtreeTask root(this, basenode, inheritedValue, 0);
+    workers.spawn(&root);
+    workers.waitForTask(&root);
+
+    scheduler = NULL;
+    this->atTraversalEnd();
+
+    return root.result;
+}
+
+template <class I, class S>
+S
+AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::evaluateSubtree(SgNode *node, I inheritedValue,
+        size_t depth, SynthesizedAttributesList &stack)
+{
+    traverseSubtree(node, inheritedValue, depth, stack);
+    ROSE_ASSERT(stack.debugSize() == 1);
+    return stack.pop();
+}
+
+// This is the same as SgTreeTraversal::performTraversal() for the index-based
+// traversal, except that large children are spawned as tasks before any child
+// is visited; the results of spawned children are pushed onto the stack in
+// their proper position, so evaluateSynthesizedAttribute() sees them in the
+// usual order.
+template <class I, class S>
+void
+AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::traverseSubtree(SgNode *node, I inheritedValue,
+        size_t depth, SynthesizedAttributesList &stack)
+{
+    if (node == NULL)
+    {
+        stack.push(this->defaultSynthesizedAttribute(inheritedValue));
+        return;
+    }
+
+    inheritedValue = this->evaluateInheritedAttribute(node, inheritedValue);
+
+    size_t numberOfSuccessors = node->get_numberOfTraversalSuccessors();
+    std::vector<SubtreeTask *> tasks;
+    if (scheduler != NULL && depth < spawnDepth)
+    {
+        tasks.resize(numberOfSuccessors, NULL);
+        for (size_t idx = 0; idx < numberOfSuccessors; idx++)
+        {
+            SgNode *child = node->get_traversalSuccessorByIndex(idx);
+            if (child != NULL && shouldSpawn(child, depth + 1))
+            {
+                tasks[idx] = new SubtreeTask(this, child, inheritedValue, depth + 1);
+                scheduler->spawn(tasks[idx]);
+            }
+        }
+    }
+
+    for (size_t idx = 0; idx < numberOfSuccessors; idx++)
+    {
+        if (!tasks.empty() && tasks[idx] != NULL)
+        {
+            scheduler->waitForTask(tasks[idx]);
+            stack.push(tasks[idx]->result);
+            delete tasks[idx];
+        }
+        else
+        {
+            traverseSubtree(node->get_traversalSuccessorByIndex(idx), inheritedValue, depth + 1, stack);
+        }
+    }
+
+    stack.setFrameSize(numberOfSuccessors);
+    ROSE_ASSERT(stack.size() == numberOfSuccessors);
+    stack.push(this->evaluateSynthesizedAttribute(node, inheritedValue, stack));
+}
+
+// Returns true if the subtree rooted at child has at least minimumSubtreeSize
+// nodes. The count stops at the bound, so this costs at most
+// minimumSubtreeSize node visits and is only done near the root.
+template <class I, class S>
+bool
+AstSharedMemorySubtreeParallelTopDownBottomUpProcessing<I, S>::shouldSpawn(SgNode *child, size_t depth) const
+{
+    if (depth > spawnDepth)
+        return false;
+    if (minimumSubtreeSize == 0)
+        return true;
+
+    size_t count = 0;
+    std::vector<SgNode *> worklist(1, child);
+    while (!worklist.empty())
+    {
+        SgNode *n = worklist.back();
+        worklist.pop_back();
+        if (++count >= minimumSubtreeSize)
+            return true;
+        size_t numberOfSuccessors = n->get_numberOfTraversalSuccessors();
+        for (size_t idx = 0; idx < numberOfSuccessors; idx++)
+        {
+            if (SgNode *grandchild = n->get_traversalSuccessorByIndex(idx))
+                worklist.push_back(grandchild);
+        }
+    }
+    return false;
+}
+
+// AstTopDownBottomUpProcessing::parallelTraverse() implementation
+
+// subtreeSize holds the number of nodes of each subtree of the AST, indexed
+// by the pre-order number of its root, so that the children of a node can be
+// split into ranges without counting the same nodes again at every level.
+template <class I, class S>
+struct AstTopDownBottomUpProcessing<I, S>::ParallelContext
+{
+    AstWorkStealingScheduler *scheduler;
+    size_t grainSize;
+    typename AstTopDownBottomUpProcessing<I, S>::SynthesizedAttributeReduction *reduction;
+    std::vector<size_t> subtreeSize;
+};
+
+// A node whose children are being visited by parallelEvaluateSubtree().
+// nextPreorder is the pre-order number of the next non-null child. If reduce
+// is set, the synthesized attributes of the children are combined into
+// 'reduced' instead of being pushed onto the stack. tasks is either empty or
+// has an entry for each child, which is the task evaluating the range of
+// children starting at that child.
+template <class I, class S>
+struct AstTopDownBottomUpProcessing<I, S>::ParallelFrame
+{
+    SgNode *node;
+    I inheritedValue;
+    size_t numberOfSuccessors;
+    size_t nextSuccessor;
+    size_t nextPreorder;
+    size_t largeChild;
+    bool reduce;
+    bool haveReduced;
+    S reduced;
+    std::vector<ParallelRangeTask *> tasks;
+
+    ParallelFrame(SgNode *n, const I &inh, size_t preorder)
+        : node(n), inheritedValue(inh), numberOfSuccessors(0), nextSuccessor(0), nextPreorder(preorder + 1),
+          largeChild((size_t) -1), reduce(false), haveReduced(false), reduced()
+    {
+    }
+};
+
+// Evaluates the children begin..end-1 of parent; the first non-null one has
+// the pre-order number preorderBegin. Their synthesized attributes are left
+// in 'results', or combined into 'reduced' if the parent's attributes are
+// reduced.
+template <class I, class S>
+class AstTopDownBottomUpProcessing<I, S>::ParallelRangeTask
+    : public AstWorkStealingTask
+{
+public:
+    ParallelRangeTask(AstTopDownBottomUpProcessing<I, S> *traversal, const ParallelContext &context,
+            SgNode *parent, I inheritedValue, size_t begin, size_t end, size_t preorderBegin, size_t preorderEnd,
+            bool spawnChildren, bool reduce)
+        : traversal(traversal), context(context), parent(parent), inheritedValue(inheritedValue),
+          begin(begin), end(end), preorderBegin(preorderBegin), preorderEnd(preorderEnd),
+          spawnChildren(spawnChildren), reduce(reduce), reduced()
+    {
+    }
+
+    virtual void execute()
+    {
+        if (!reduce)
+            results.reserve(end - begin);
+        size_t preorder = preorderBegin;
+        for (size_t idx = begin; idx < end; idx++)
+        {
+            SgNode *child = parent->get_traversalSuccessorByIndex(idx);
+            S value;
+            if (child != NULL)
+            {
+                value = traversal->parallelEvaluateSubtree(context, child, preorder, inheritedValue, spawnChildren);
+                preorder += context.subtreeSize[preorder];
+            }
+            else
+            {
+                value = traversal->defaultSynthesizedAttribute(inheritedValue);
+            }
+            if (!reduce)
+                results.push_back(value);
+            else if (idx == begin)
+                reduced = value;
+            else
+                reduced = (*context.reduction)(parent, reduced, value);
+        }
+    }
+
+    AstTopDownBottomUpProcessing<I, S> *traversal;
+    const ParallelContext &context;
+    SgNode *parent;
+    I inheritedValue;
+    size_t begin, end;
+    size_t preorderBegin, preorderEnd;
+    bool spawnChildren;
+    bool reduce;
+    S reduced;
+    std::vector<S> results;
+};
+
+// A range of children of a node, see parallelEnterNode().
+struct AstParallelTraversal_Range
+{
+    size_t begin, end, preorderBegin, preorderEnd;
+    bool largeChild;
+};
+
+// Computes the subtree sizes of ParallelContext, with an explicit stack.
+static inline void
+AstParallelTraversal_computeSubtreeSizes(SgNode *root, std::vector<size_t> &subtreeSize)
+{
+    // (node, pre-order number, next child)
+    std::vector<std::pair<SgNode *, std::pair<size_t, size_t> > > stack;
+    subtreeSize.push_back(0);
+    stack.push_back(std::make_pair(root, std::make_pair((size_t) 0, (size_t) 0)));
+    while (!stack.empty())
+    {
+        SgNode *node = stack.back().first;
+        size_t &nextChild = stack.back().second.second;
+        if (nextChild < node->get_numberOfTraversalSuccessors())
+        {
+            if (SgNode *child = node->get_traversalSuccessorByIndex(nextChild++))
+            {
+                subtreeSize.push_back(0);
+                stack.push_back(std::make_pair(child, std::make_pair(subtreeSize.size() - 1, (size_t) 0)));
+            }
+        }
+        else
+        {
+            size_t preorder = stack.back().second.first;
+            subtreeSize[preorder] = subtreeSize.size() - preorder;
+            stack.pop_back();
+        }
+    }
+}
+
+template <class I, class S>
+S
+AstTopDownBottomUpProcessing<I, S>::parallelTraverse(SgNode *node, I inheritedValue, size_t grainSize,
+        SynthesizedAttributeReduction *reduction, size_t numberOfThreads)
+{
+    if (node == NULL)
+    {
+        this->atTraversalStart();
+        this->atTraversalEnd();
+        return this->defaultSynthesizedAttribute(inheritedValue);
+    }
+
+    AstWorkStealingScheduler workers(numberOfThreads);
+    ParallelContext context;
+    context.scheduler = &workers;
+    context.grainSize = grainSize > 0 ? grainSize : 1;
+    context.reduction = reduction;
+    AstParallelTraversal_computeSubtreeSizes(node, context.subtreeSize);
+
+    this->atTraversalStart();
+    S result = parallelEvaluateSubtree(context, node, 0, inheritedValue, true);
+    this->atTraversalEnd();
+
+    return result;
+}
+
+// Evaluates the inherited attribute of node and pushes its frame. If
+// spawnChildren is set, the children are split into ranges of at least
+// grainSize nodes, which are spawned if there are two or more of them; a
+// single large child is instead marked to be visited the same way by this
+// thread. Children outside of these ranges are small and their subtrees are
+// visited without looking for more parallelism.
+template <class I, class S>
+void
+AstTopDownBottomUpProcessing<I, S>::parallelEnterNode(const ParallelContext &context,
+        std::deque<ParallelFrame> &frames, SgNode *node, size_t preorder, I inheritedValue, bool spawnChildren)
+{
+    frames.push_back(ParallelFrame(node, this->evaluateInheritedAttribute(node, inheritedValue), preorder));
+    ParallelFrame &frame = frames.back();
+    frame.numberOfSuccessors = node->get_numberOfTraversalSuccessors();
+    frame.reduce = context.reduction != NULL && frame.numberOfSuccessors > context.grainSize;
+
+    if (!spawnChildren || context.subtreeSize[preorder] <= context.grainSize)
+        return;
+
+    // a large child is a range of its own; the small children after the last range are not spawned
+    std::vector<AstParallelTraversal_Range> ranges;
+    size_t pendingBegin = 0, pendingPreorderBegin = frame.nextPreorder;
+    size_t childPreorder = frame.nextPreorder;
+    for (size_t idx = 0; idx < frame.numberOfSuccessors; idx++)
+    {
+        size_t size = 0;
+        if (node->get_traversalSuccessorByIndex(idx) != NULL)
+            size = context.subtreeSize[childPreorder];
+        bool largeChild = size >= context.grainSize;
+        if (largeChild || childPreorder + size - pendingPreorderBegin >= context.grainSize)
+        {
+            AstParallelTraversal_Range range;
+            range.begin = largeChild ? idx : pendingBegin;
+            range.end = idx + 1;
+            range.preorderBegin = largeChild ? childPreorder : pendingPreorderBegin;
+            range.preorderEnd = childPreorder + size;
+            range.largeChild = largeChild;
+            ranges.push_back(range);
+            pendingBegin = idx + 1;
+            pendingPreorderBegin = childPreorder + size;
+        }
+        childPreorder += size;
+    }
+
+    if (ranges.size() == 1 && ranges[0].largeChild)
+    {
+        frame.largeChild = ranges[0].begin;
+    }
+    else if (ranges.size() > 1)
+    {
+        frame.tasks.resize(frame.numberOfSuccessors, NULL);
+        for (size_t r = 0; r < ranges.size(); r++)
+        {
+            ParallelRangeTask *task = new ParallelRangeTask(this, context, node, frame.inheritedValue,
+                    ranges[r].begin, ranges[r].end, ranges[r].preorderBegin, ranges[r].preorderEnd,
+                    ranges[r].largeChild, frame.reduce);
+            frame.tasks[ranges[r].begin] = task;
+            context.scheduler->spawn(task);
+        }
+    }
+}
+
+// The same walk as SgTreeTraversal::performTraversal(), on a stack of
+// synthesized attributes of its own. Waiting for a spawned range makes this
+// thread execute other tasks in the meantime.
+template <class I, class S>
+S
+AstTopDownBottomUpProcessing<I, S>::parallelEvaluateSubtree(const ParallelContext &context, SgNode *node,
+        size_t preorder, I inheritedValue, bool spawnChildren)
+{
+    SynthesizedAttributesList synthesizedAttributes;
+    std::deque<ParallelFrame> frames;
+    parallelEnterNode(context, frames, node, preorder, inheritedValue, spawnChildren);
+
+    // the synthesized attribute of a child of the frame on top, or of the range of children evaluated by a task
+    S value;
+    while (true)
+    {
+        ParallelFrame &frame = frames.back();
+        if (frame.nextSuccessor < frame.numberOfSuccessors)
+        {
+            size_t idx = frame.nextSuccessor;
+            if (!frame.tasks.empty() && frame.tasks[idx] != NULL)
+            {
+                ParallelRangeTask *task = frame.tasks[idx];
+                context.scheduler->waitForTask(task);
+                frame.nextSuccessor = task->end;
+                frame.nextPreorder = task->preorderEnd;
+                if (!frame.reduce)
+                {
+                    for (size_t r = 0; r < task->results.size(); r++)
+                        synthesizedAttributes.push(task->results[r]);
+                    delete task;
+                    continue;
+                }
+                value = task->reduced;
+                delete task;
+            }
+            else
+            {
+                frame.nextSuccessor++;
+                SgNode *child = frame.node->get_traversalSuccessorByIndex(idx);
+                if (child != NULL)
+                {
+                    size_t childPreorder = frame.nextPreorder;
+                    frame.nextPreorder += context.subtreeSize[childPreorder];
+                    parallelEnterNode(context, frames, child, childPreorder, frame.inheritedValue,
+                            idx == frame.largeChild);
+                    continue;
+                }
+                value = this->defaultSynthesizedAttribute(frame.inheritedValue);
+            }
+        }
+        else
+        {
+            size_t frameSize = frame.numberOfSuccessors;
+            if (frame.reduce)
+            {
+                synthesizedAttributes.push(frame.haveReduced ? frame.reduced
+                                           : this->defaultSynthesizedAttribute(frame.inheritedValue));
+                frameSize = 1;
+            }
+            synthesizedAttributes.setFrameSize(frameSize);
+            ROSE_ASSERT(synthesizedAttributes.size() == frameSize);
+            value = this->evaluateSynthesizedAttribute(frame.node, frame.inheritedValue, synthesizedAttributes);
+
+            // pop the children's attributes off the stack
+            synthesizedAttributes.setFrameSize(frameSize);
+            synthesizedAttributes.push(value);
+            synthesizedAttributes.pop();
+
+            frames.pop_back();
+            if (frames.empty())
+                break;
+        }
+
+        // hand the value over to the frame on top of the stack
+        ParallelFrame &parent = frames.back();
+        if (!parent.reduce)
+        {
+            synthesizedAttributes.push(value);
+        }
+        else if (!parent.haveReduced)
+        {
+            parent.reduced = value;
+            parent.haveReduced = true;
+        }
+        else
+        {
+            parent.reduced = (*context.reduction)(parent.node, parent.reduced, value);
+        }
+    }
+
+    ROSE_ASSERT(synthesizedAttributes.debugSize() == 0);
+    return value;
+}
+
+// subtree-parallel TOP DOWN implementation
+
+template <class I>
+void
+AstSharedMemorySubtreeParallelTopDownProcessing<I>::traverseInParallel(SgNode *basenode, I inheritedValue)
+{
+    Superclass::traverseInParallel(basenode, inheritedValue);
+}
+
+template <class I>
+void
+AstSharedMemorySubtreeParallelTopDownProcessing<I>::destroyInheritedValue(SgNode *, I)
+{
+}
+
+template <class I>
+DummyAttribute
+AstSharedMemorySubtreeParallelTopDownProcessing<I>::evaluateSynthesizedAttribute(SgNode *astNode, I inheritedValue,
+        typename AstSharedMemorySubtreeParallelTopDownProcessing<I>::SynthesizedAttributesList l)
+{
+    destroyInheritedValue(astNode, inheritedValue);
+    DummyAttribute a = defaultDummyAttribute;
+    return a;
+}
+
+// subtree-parallel BOTTOM UP implementation
+
+template <class S>
+S
+AstSharedMemorySubtreeParallelBottomUpProcessing<S>::traverse(SgNode *basenode)
+{
+    DummyAttribute da = defaultDummyAttribute;
+    return Superclass::traverse(basenode, da);
+}
+
+template <class S>
+S
+AstSharedMemorySubtreeParallelBottomUpProcessing<S>::traverseInParallel(SgNode *basenode)
+{
+    DummyAttribute da = defaultDummyAttribute;
+    return Superclass::traverseInParallel(basenode, da);
+}
+
+template <class S>
+DummyAttribute
+AstSharedMemorySubtreeParallelBottomUpProcessing<S>::evaluateInheritedAttribute(SgNode *astNode, DummyAttribute inheritedValue)
+{
+    DummyAttribute a = defaultDummyAttribute;
+    return a;
+}
+
+template <class S>
+S
+AstSharedMemorySubtreeParallelBottomUpProcessing<S>::evaluateSynthesizedAttribute(SgNode *astNode,
+        DummyAttribute inheritedValue,
+        typename AstSharedMemorySubtreeParallelBottomUpProcessing<S>::SynthesizedAttributesList l)
+{
+    return evaluateSynthesizedAttribute(astNode, l);
+}
+
+#endif
@@ -185,6 +185,7 @@ namespace NodeQuery
 
   // Functions supporting the query of variants
   void pushNewNode ( NodeQuerySynthesizedAttributeType* nodeList, const VariantVector & targetVariantVector, SgNode * astNode);
+  void collectVariantQueryCandidates ( SgNode * astNode, Rose_STL_Container<SgNode*> & candidates );
   void* querySolverGrammarElementFromVariantVector ( SgNode * astNode, VariantVector targetVariantVector,  NodeQuerySynthesizedAttributeType* returnNodeList );
   NodeQuerySynthesizedAttributeType querySolverGrammarElementFromVariantVector ( SgNode * astNode, VariantVector targetVariantVector );
 
@@ -344,6 +345,22 @@ namespace NodeQuery
   // DQ (3/25/2004): Added to support more general form of query based on variant value
   ROSE_DLL_API NodeQuerySynthesizedAttributeType queryNodeList ( NodeQuerySynthesizedAttributeType, VariantVector);
 
+  /**********************************************************************************************
+   * The functions
+   *    enableVariantIndex (SgNode * root) and disableVariantIndex ()
+   * control an index that answers the variant based querySubTree() functions (with the default
+   * AstQueryNamespace::AllNodes) for sub-trees below 'root' by range lookups instead of traversals.
+   * The index stores the preorder number range of every node and, per variant, the preorder sorted
+   * list of nodes a query would return; it is built by the first query and rebuilt by the first
+   * query after the AST modification count changed (see SageInterface::noteAstModification(),
+   * which the generated set_* functions, SageBuilder, and SageInterface call, and which code
+   * that edits the lists of IR nodes directly must call; noteAstModification() here is the same).
+   *********************************************************************************************/
+  ROSE_DLL_API void enableVariantIndex (SgNode * root);
+  ROSE_DLL_API void disableVariantIndex ();
+  ROSE_DLL_API void noteAstModification ();
+  ROSE_DLL_API unsigned long getAstModificationCount ();
+
   void
   mergeList (Rose_STL_Container<SgNode*> & nodeList, const Rose_STL_Container<SgNode*> & localList);
 
@@ -369,6 +369,36 @@ class ROSE_DLL_API MidLevelRewrite
       //! remove member function implemented using lower level remove member function
           static void remove  ( SgStatement* target );
 
+      //! Queues the insert() calls made while an instance is alive and compiles them together.
+      /*! Every insert() writes an intermediate file (with the prefix of declarations visible at the
+          target) and runs the frontend on it. While a batch is open, insert() only records the
+          request; when the outermost batch is closed (or flushed) the requests for the same target
+          statement that share a prefix are placed into one intermediate file, so they cost a single
+          frontend invocation. Targets are processed in the order of their first request. Strings
+          queued for the same position at the same target end up in the order they were queued (as
+          if they had been concatenated into one string), and since the strings are not compiled
+          until the flush, a string cannot refer to declarations added by another queued string.
+
+          Batches may be nested; only the outermost one compiles the requests. This is not thread safe.
+       */
+          class ROSE_DLL_API InsertionBatch
+             {
+               public:
+                    InsertionBatch();
+                   ~InsertionBatch();
+
+                 //! Compile and insert the requests queued so far.
+                    void flush();
+
+                 //! Whether a batch is currently open.
+                    static bool isOpen();
+
+               private:
+                 // Not copyable.
+                    InsertionBatch(const InsertionBatch&);
+                    InsertionBatch& operator=(const InsertionBatch&);
+             };
+
       //! Wraps macro calls so that they are understood in the intermediate files where 
       //! they specify transformations but not expanded until the final source code is 
       //! generated.
@@ -26,33 +26,63 @@ class OperatorAnnotCollection
   void add_annot( const OperatorDeclaration& op, const Descriptor& d)
     {
       std::string sig = op.get_signiture();
-      this->typemap[ sig ] = d;
+      this->insert_annot( sig, d);
+      callcache.clear();
     }
   bool known_operator( AstInterface& fa, 
                        const AstNodePtr& exp, AstInterface::AstNodeList* argp= 0, 
                        Descriptor* desc= 0, bool replpar = false,
                        Map2Object<AstInterface*, AstNodePtr, AstNodePtr>* astcodegen =0) const
   {
-    AstInterface::AstNodeList args;
-    AstInterface::AstTypeList params;
+    const AstInterface::AstNodeList* args = 0;
+    AstInterface::AstNodeList defargs;
     AstNodePtr f;
-    std::string fname;
-    if (!(fa.IsFunctionCall(exp,&f, &args, 0, &params) && fa.IsVarRef(f,0,&fname))
-       && !fa.IsFunctionDefinition(exp,&fname,&args,0,0, &params))
-        return false;
-    std::string sig = OperatorDeclaration::get_signiture(fa, fname, params);
-    if (this->known_type( sig, desc)) {
-       if (argp != 0)
-          *argp = args;
-       if (desc != 0 && replpar) {
+    const Descriptor* d = 0;
+    if (fa.IsFunctionCall(exp, &f, args)) {
+       d = find_call(fa, exp, f);
+    }
+    else {
+       AstInterface::AstTypeList params;
+       std::string fname;
+       if (!fa.IsFunctionDefinition(exp,&fname,&defargs,0,0, &params))
+          return false;
+       d = this->find_type( OperatorDeclaration::get_signiture(fa, fname, params));
+       args = &defargs;
+    }
+    if (d == 0)
+       return false;
+    if (argp != 0)
+       *argp = *args;
+    if (desc != 0) {
+       *desc = *d;
+       if (replpar) {
          ParamDescriptor params = desc->get_param_decl().get_params();
-         ReplaceParams repl( params, args, astcodegen);
+         ReplaceParams repl( params, *args, astcodegen);
          repl.add( "result", exp, astcodegen);
          desc->replace_val( repl);
        }
-       return true;
     }
-    return false;
+    return true;
+  }
+ private:
+  // Lookups for call expressions, both positive and negative (a null descriptor). Each is valid only while the call
+  // still has the same callee; the signature depends on nothing else.
+  typedef boost::unordered_map<void*, std::pair<AstNodePtr, const Descriptor*> > CallCache;
+  mutable CallCache callcache;
+
+  const Descriptor* find_call( AstInterface& fa, const AstNodePtr& exp, const AstNodePtr& f) const
+  {
+    typename CallCache::const_iterator p = callcache.find(exp.get_ptr());
+    if (p != callcache.end() && p->second.first == f)
+       return p->second.second;
+    const Descriptor* d = 0;
+    const std::string* fname = 0;
+    const AstInterface::AstNodeList* args = 0;
+    const AstInterface::AstTypeList* params = 0;
+    if (fa.IsVarRef(f,0,fname) && fa.IsFunctionCall(exp, 0, args, 0, &params))
+       d = this->find_type( OperatorDeclaration::get_signiture(fa, *fname, *params));
+    callcache[exp.get_ptr()] = std::make_pair(f, d);
+    return d;
   }
 };
 
@@ -7,6 +7,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <boost/unordered_map.hpp>
 #include "AnnotDescriptors.h"
 #include "SymbolicVal.h"
 //! An interface to a single annotation item
@@ -59,8 +60,30 @@ class TypeCollection
 {
  protected:
   std::map <std::string, Descriptor> typemap;
+  // Hash index into typemap, since lookups far outnumber insertions
+  boost::unordered_map <std::string, const Descriptor*> typeindex;
+
+  //! Add or replace the descriptor of a name, keeping the index up to date
+  void insert_annot( const std::string& name, const Descriptor& d)
+    {
+      Descriptor& cur = typemap[name];
+      cur = d;
+      typeindex[name] = &cur;
+    }
+  void build_index()
+    {
+      typeindex.clear();
+      for (typename std::map<std::string,Descriptor>::const_iterator p = typemap.begin();
+           p != typemap.end(); ++p)
+         typeindex[p->first] = &p->second;
+    }
 
  public:
+  TypeCollection() {}
+  TypeCollection( const TypeCollection& that) : typemap(that.typemap) { build_index(); }
+  TypeCollection& operator = ( const TypeCollection& that)
+    { typemap = that.typemap; build_index(); return *this; }
+
     class const_iterator 
       : public std::map<std::string,Descriptor>::const_iterator 
       {
@@ -77,6 +100,12 @@ class TypeCollection
   const_iterator end() const { return typemap.end(); }
   //Check if a named type 'name' is a type with annotation descriptor records
   bool known_type( const TypeDescriptor &name, Descriptor* desc = 0)  const;
+  //! Same as known_type, but returns the descriptor record itself (0 if unknown) rather than a copy
+  const Descriptor* find_type( const std::string& name) const
+    {
+      typename boost::unordered_map<std::string, const Descriptor*>::const_iterator p = typeindex.find(name);
+      return p == typeindex.end()? 0 : p->second;
+    }
   bool known_type( AstInterface& fa, const AstNodePtr& exp, 
                    Descriptor* desc = 0) const;
   bool known_type( AstInterface& fa, const AstNodeType& exp, 
@@ -99,7 +128,7 @@ class TypeAnnotCollection
       {
     // pmp 08JUN05
     //   was: typemap[name] = d;
-       this->typemap[name] = d;
+       this->insert_annot(name, d);
       }
 };
 
@@ -127,6 +127,11 @@ public:
   void AttachObserver(AstObserver* ob);
   void DetachObserver(AstObserver* ob);
 
+  //! The results of the more expensive queries (IsFunctionCall, IsVarRef with a name or scope, IsFortranLoop) are
+  //! memoized per node. The memo is discarded whenever the AST is modified through this interface; call this
+  //! after modifying the AST by other means.
+  void ClearQueryCache();
+
   bool get_fileInfo(const AstNodePtr& n, std:: string* fname= 0, int* lineno = 0);
 
   void InsertStmt( const AstNodePtr& orig, const AstNodePtr& n, 
@@ -228,6 +233,11 @@ public:
   bool IsFunctionCall( const AstNodePtr& s, AstNodePtr* f = 0, 
                        AstNodeList* args = 0, AstNodeList* outargs = 0, 
                        AstTypeList* paramtypes = 0, AstNodeType* returntype=0);
+  //! Same as the above, except the argument and parameter type lists are not copied: they point into the
+  //! interface's query cache and are valid until the AST is modified or ClearQueryCache is called.
+  bool IsFunctionCall( const AstNodePtr& s, AstNodePtr* f, const AstNodeList*& args,
+                       const AstNodeList** outargs = 0, const AstTypeList** paramtypes = 0,
+                       AstNodeType* returntype=0);
   bool IsMin(const AstNodePtr& exp);
   bool IsMax(const AstNodePtr& exp);
   AstNodePtr CreateFunctionCall(const std::string& func, const AstNodeList& args);
@@ -261,6 +271,10 @@ public:
   bool IsVarRef( const AstNodePtr& exp, AstNodeType* vartype = 0,
                    std::string* varname = 0, AstNodePtr* scope = 0, 
                     bool *isglobal = 0) ;
+  //! Same as the above, except the variable name is not copied: it points into the interface's query cache
+  //! and is valid until the AST is modified or ClearQueryCache is called.
+  bool IsVarRef( const AstNodePtr& exp, AstNodeType* vartype, const std::string*& varname,
+                   AstNodePtr* scope = 0, bool *isglobal = 0) ;
 
   std::string GetVarName( const AstNodePtr& exp);
 
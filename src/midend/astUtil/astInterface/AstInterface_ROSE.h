@@ -6,6 +6,7 @@
 #include <iostream>
 #include <map>
 #include <stdexcept>
+#include <vector>
 #include "ObserveObject.h"
 #include "AstInterface.h"
 
@@ -98,6 +99,9 @@ class ROSE_DLL_API AstInterfaceImpl : public ObserveObject< AstObserver>
   SgNode* GetVarDecl( const std:: string& varname);
   bool ReplaceAst( SgNode* orig, SgNode* n);
 
+  //! Forget all memoized query results; see AstInterface::ClearQueryCache.
+  void clear_queryCache();
+
   void delay_newVarInsert() { ++delayNewVarInsert; }
   void apply_newVarInsert() {
       --delayNewVarInsert;
@@ -121,6 +125,34 @@ public:
   int newVarIndex;
   int delayNewVarInsert;
   std::vector< std::pair<SgScopeStatement*,SgStatement*> > newVarList;
+
+  // Memoized results of the more expensive AstInterface queries, indexed by the queried node. These are cleared
+  // whenever the AST is modified through the interface.
+  struct FunctionCallInfo {
+     SgNode* func;
+     AstNodeList args;
+     bool hasSignature; // whether the following are computed 
+     AstNodeList outargs;
+     AstTypeList paramtypes;
+     AstNodeType returntype;
+     FunctionCallInfo() : func(0), hasSignature(false) {}
+  };
+  struct VarRefInfo {
+     AstNodeType vartype;
+     std::string varname;
+     bool hasScope; // whether the following are computed 
+     AstNodePtr scope;
+     bool isglobal;
+     VarRefInfo() : hasScope(false), isglobal(false) {}
+  };
+  struct FortranLoopInfo {
+     bool isFortranLoop;
+     AstNodePtr ivar, lb, ub, step, body;
+     FortranLoopInfo() : isFortranLoop(false) {}
+  };
+  std::map<SgNode*, FunctionCallInfo> functionCallCache;
+  std::map<SgNode*, VarRefInfo> varRefCache;
+  std::map<SgNode*, FortranLoopInfo> fortranLoopCache;
  friend class AstInterface;
 };
 
@@ -4,6 +4,7 @@
 #include <BaseSemantics2.h>
 #include <BinaryStackVariable.h>
 #include <RegisterParts.h>
+#include <Sawyer/Map.h>
 
 namespace rose {
 namespace BinaryAnalysis {
@@ -895,6 +896,20 @@ private:
 std::ostream& operator<<(std::ostream&, const Definition&);
 std::ostream& operator<<(std::ostream&, const Analysis&);
 
+/** Analysis results for many functions, indexed by function entry address. */
+typedef Sawyer::Container::Map<rose_addr_t, Analysis> FunctionAnalyses;
+
+/** Analyze all functions.
+ *
+ *  Runs the calling convention analysis on each function of the partitioner by calling @ref
+ *  Partitioner2::Partitioner::allFunctionCallingConvention, which analyzes the functions in parallel in call graph order and
+ *  gives each analysis its own instruction dispatcher and RISC operators. The results are returned indexed by function entry
+ *  address.  The partitioner is shared by all threads and must not be modified while this runs.
+ *
+ *  The results are also cached in the function objects as usual; the returned analyses are copies from which the
+ *  instruction dispatcher has been removed (see @ref Analysis::clearNonResults) so that the table holds only the results. */
+FunctionAnalyses analyzeAllFunctions(const Partitioner2::Partitioner&, const Definition *dfltCc = NULL);
+
 } // namespace
 } // namespace
 } // namespace
@@ -5,11 +5,16 @@
 #include "Diagnostics.h"
 #include "SymbolicSemantics2.h"
 
+#include <algorithm>
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <list>
 #include <Sawyer/GraphTraversal.h>
 #include <Sawyer/DistinctList.h>
+#include <Sawyer/ThreadWorkers.h>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -103,6 +108,12 @@ public:
         explicit NotConverging(const std::string &s): Exception(s) {}
     };
 
+    /** Order in which an @ref Engine visits the vertices on its work list. */
+    enum WorkListOrder {
+        WORKLIST_FIFO,                                  /**< Vertices are visited in the order they were added. */
+        WORKLIST_REVERSE_POSTORDER                      /**< Vertex with lowest reverse postorder number is visited first. */
+    };
+
 private:
     InstructionSemantics2::BaseSemantics::RiscOperatorsPtr userOps_; // operators (and state) provided by the user
     InstructionSemantics2::DataFlowSemantics::RiscOperatorsPtr dfOps_; // data-flow operators (which point to user ops)
@@ -277,14 +288,27 @@ public:
      *      bound. This implies that the lattice has a bottom element that is a descendent of all other vertices.  However, the
      *      data-flow engine is designed to also operate in cases where a fixed point cannot be reached.
      *
+     *  @li @p WideningFunction is a functor with the same interface as the @p MergeFunction. It is used instead of the merge
+     *      function for vertices that have been visited more than the @ref wideningThreshold number of times and should
+     *      produce a state that is an upper bound of its two arguments and guarantees that the data-flow eventually reaches a
+     *      fixed point, for instance by giving a new, unknown value to every location whose value changed.  The default is the
+     *      merge function itself.
+     *
      *  A common configuration for an engine is to use a control-flow graph whose vertices are basic blocks, whose @p StatePtr
      *  is an @ref InstructionSemantics2::BaseSemantics::State "instruction semantics state", whose @p TransferFunction calls
      *  @ref InstructionSemantics2::BaseSemantics::Dispatcher::processInstruction "Dispatcher::processInstruction", and whose
      *  @p MergeFunction calls the state's @ref InstructionSemantics2::BaseSemantics::State::merge "merge" method.
      *
      *  The control flow graph and transfer function are specified in the engine's constructor.  The starting CFG vertex and
-     *  its initial state are supplied when the engine starts to run. */
-    template<class CFG, class StatePtr, class TransferFunction, class MergeFunction = BasicMerge<StatePtr> >
+     *  its initial state are supplied when the engine starts to run.
+     *
+     *  By default the work list is first in, first out.  On graphs with loops, visiting vertices in reverse postorder (see
+     *  @ref workListOrder) usually reaches the fixed point with fewer visits since a vertex is then normally visited only after
+     *  all its non-back-edge predecessors.  Large graphs can also be solved with @ref runToFixedPointParallel, which solves
+     *  the strongly connected components of the graph in separate threads as soon as all the components on which they depend
+     *  are solved. */
+    template<class CFG, class StatePtr, class TransferFunction, class MergeFunction = BasicMerge<StatePtr>,
+             class WideningFunction = MergeFunction>
     class Engine {
     public:
         typedef std::vector<StatePtr> VertexStates;     /**< Data-flow states indexed by vertex ID. */
@@ -293,21 +317,45 @@ public:
         const CFG &cfg_;
         TransferFunction &xfer_;
         MergeFunction merge_;
+        WideningFunction widen_;
         VertexStates incomingState_;                    // incoming data-flow state per CFG vertex ID
         VertexStates outgoingState_;                    // outgoing data-flow state per CFG vertex ID
         typedef Sawyer::Container::DistinctList<size_t> WorkList;
-        WorkList workList_;                             // CFG vertex IDs to be visited, last in first out w/out duplicates
+        WorkList workList_;                             // CFG vertex IDs to be visited, first in first out w/out duplicates
+        std::set<size_t> priorityList_;                 // ranks of CFG vertices to be visited for WORKLIST_REVERSE_POSTORDER
+        WorkListOrder workListOrder_;                   // how to choose the next vertex to visit
+        std::vector<size_t> rank_;                      // reverse postorder number per CFG vertex ID
+        std::vector<size_t> rankVertex_;                // CFG vertex ID per reverse postorder number
+        size_t nReachable_;                             // number of vertices reachable from the start vertex
+        std::vector<size_t> nVisits_;                   // number of times each vertex has been visited since last reset
         size_t maxIterations_;                          // max number of iterations to allow
         size_t nIterations_;                            // number of iterations since last reset
+        size_t wideningThreshold_;                      // number of visits after which merging becomes widening
+        size_t nWidenings_;                             // number of widening operations since last reset
+
+        // Used only by runToFixedPointParallel
+        std::vector<size_t> sccOf_;                     // strongly connected component per reachable CFG vertex ID
+        std::vector<std::vector<size_t> > sccVertices_; // CFG vertex IDs per strongly connected component
+        boost::mutex mutex_;                            // protects counters and merging across components
+        std::string parallelError_;                     // first error reported by a worker
+        bool parallelNotConverging_;                    // true if parallelError_ came from a NotConverging exception
 
     public:
         /** Constructor.
          *
          *  Constructs a new data-flow engine that will operate over the specified control flow graph using the specified
          *  transfer function.  The control flow graph is incorporated into the engine by reference; the transfer functor is
-         *  copied. */
+         *  copied.  The merge function is also used as the widening function.
+         *
+         * @{ */
         Engine(const CFG &cfg, TransferFunction &xfer, MergeFunction merge = MergeFunction())
-            : cfg_(cfg), xfer_(xfer), merge_(merge), maxIterations_(-1), nIterations_(0) {}
+            : cfg_(cfg), xfer_(xfer), merge_(merge), widen_(merge), workListOrder_(WORKLIST_FIFO), nReachable_(0),
+              maxIterations_(-1), nIterations_(0), wideningThreshold_(-1), nWidenings_(0), parallelNotConverging_(false) {}
+
+        Engine(const CFG &cfg, TransferFunction &xfer, MergeFunction merge, WideningFunction widen)
+            : cfg_(cfg), xfer_(xfer), merge_(merge), widen_(widen), workListOrder_(WORKLIST_FIFO), nReachable_(0),
+              maxIterations_(-1), nIterations_(0), wideningThreshold_(-1), nWidenings_(0), parallelNotConverging_(false) {}
+        /** @} */
 
         /** Data-flow control flow graph.
          *
@@ -329,9 +377,17 @@ public:
             incomingState_[startVertexId] = initialState;
             outgoingState_.clear();
             outgoingState_.resize(cfg_.nVertices());
+            nVisits_.clear();
+            nVisits_.resize(cfg_.nVertices(), 0);
+            rank_.clear();
+            rankVertex_.clear();
+            if (WORKLIST_REVERSE_POSTORDER == workListOrder_)
+                computeRanks(startVertexId);
             workList_.clear();
-            workList_.pushBack(startVertexId);
+            priorityList_.clear();
+            pushWorkList(startVertexId);
             nIterations_ = 0;
+            nWidenings_ = 0;
         }
 
         /** Max number of iterations to allow.
@@ -348,6 +404,34 @@ public:
          *
          *  The number of times runOneIteration was called since the last reset. */
         size_t nIterations() const { return nIterations_; }
+
+        /** Order in which vertices are visited.
+         *
+         *  A change takes effect at the next @ref reset.  The default is @ref WORKLIST_FIFO.
+         *
+         * @{ */
+        WorkListOrder workListOrder() const { return workListOrder_; }
+        void workListOrder(WorkListOrder order) { workListOrder_ = order; }
+        /** @} */
+
+        /** Number of visits before widening.
+         *
+         *  Once a vertex has been visited this many times, outgoing states of its predecessors are combined with its incoming
+         *  state by the widening function instead of the merge function.  The default is to never widen.  Unlike @ref
+         *  maxIterations, reaching this limit is not an error; the @ref maxIterations limit still applies as a last resort.
+         *
+         * @{ */
+        size_t wideningThreshold() const { return wideningThreshold_; }
+        void wideningThreshold(size_t n) { wideningThreshold_ = n; }
+        /** @} */
+
+        /** Number of widening operations performed since the last reset. */
+        size_t nWidenings() const { return nWidenings_; }
+
+        /** Number of times a vertex has been visited since the last reset. */
+        size_t nVisits(size_t cfgVertexId) const {
+            return cfgVertexId < nVisits_.size() ? nVisits_[cfgVertexId] : 0;
+        }
         
         /** Runs one iteration.
          *
@@ -355,62 +439,26 @@ public:
          *  work list is empty (before of after the iteration). */
         bool runOneIteration() {
             using namespace Diagnostics;
-            if (!workList_.isEmpty()) {
+            if (!isWorkListEmpty()) {
                 if (++nIterations_ > maxIterations_) {
                     throw NotConverging("data-flow max iterations reached"
                                         " (max=" + StringUtility::numberToString(maxIterations_) + ")");
                 }
-                size_t cfgVertexId = workList_.popFront();
+                size_t cfgVertexId = popWorkList();
                 if (mlog[DEBUG]) {
                     mlog[DEBUG] <<"runOneIteration: vertex #" <<cfgVertexId <<"\n";
                     mlog[DEBUG] <<"  remaining worklist is {";
-                    BOOST_FOREACH (size_t id, workList_.items())
+                    BOOST_FOREACH (size_t id, workListItems())
                         mlog[DEBUG] <<" " <<id;
                     mlog[DEBUG] <<" }\n";
                 }
-                
-                ASSERT_require2(cfgVertexId < cfg_.nVertices(),
-                                "vertex " + boost::lexical_cast<std::string>(cfgVertexId) + " must be valid within CFG");
-                typename CFG::ConstVertexIterator vertex = cfg_.findVertex(cfgVertexId);
-                StatePtr state = incomingState_[cfgVertexId];
-                ASSERT_not_null2(state,
-                                 "initial state must exist for CFG vertex " + boost::lexical_cast<std::string>(cfgVertexId));
-                if (mlog[DEBUG]) {
-                    std::ostringstream ss;
-                    ss <<*state;
-                    mlog[DEBUG] <<"  incoming state for vertex #" <<cfgVertexId <<"\n";
-                    mlog[DEBUG] <<StringUtility::prefixLines(ss.str(), "    ");
-                }
 
-                state = outgoingState_[cfgVertexId] = xfer_(cfg_, cfgVertexId, state);
-                ASSERT_not_null2(state, "outgoing state not created for vertex "+boost::lexical_cast<std::string>(cfgVertexId));
-                if (mlog[DEBUG]) {
-                    std::ostringstream ss;
-                    ss <<*state;
-                    mlog[DEBUG] <<"  outgoing state for vertex #" <<cfgVertexId <<"\n";
-                    mlog[DEBUG] <<StringUtility::prefixLines(ss.str(), "    ");
-                }
-                
-                // Outgoing state must be merged into the incoming states for the CFG successors.  Any such incoming state that
-                // is modified as a result will have its CFG vertex added to the work list.
-                SAWYER_MESG(mlog[DEBUG]) <<"  forwarding vertex #" <<cfgVertexId <<" output state to "
-                                         <<StringUtility::plural(vertex->nOutEdges(), "vertices", "vertex") <<"\n";
-                BOOST_FOREACH (const typename CFG::Edge &edge, vertex->outEdges()) {
-                    size_t nextVertexId = edge.target()->id();
-                    StatePtr targetState = incomingState_[nextVertexId];
-                    if (targetState==NULL) {
-                        SAWYER_MESG(mlog[DEBUG]) <<"    forwarded to vertex #" <<nextVertexId <<"\n";
-                        incomingState_[nextVertexId] = xfer_(state); // copy the state
-                        workList_.pushBack(nextVertexId);
-                    } else if (merge_(targetState, state)) { // merge state into targetState, return true if changed
-                        SAWYER_MESG(mlog[DEBUG]) <<"    merged with vertex #" <<nextVertexId <<" (which changed as a result)\n";
-                        workList_.pushBack(nextVertexId);
-                    } else {
-                        SAWYER_MESG(mlog[DEBUG]) <<"     merged with vertex #" <<nextVertexId <<" (no change)\n";
-                    }
-                }
+                std::vector<size_t> changed;
+                visitVertex(cfgVertexId, changed /*out*/);
+                BOOST_FOREACH (size_t nextVertexId, changed)
+                    pushWorkList(nextVertexId);
             }
-            return !workList_.isEmpty();
+            return !isWorkListEmpty();
         }
         
         /** Run data-flow until it reaches a fixed point.
@@ -423,6 +471,52 @@ public:
             while (runOneIteration()) /*void*/;
         }
 
+        /** Run data-flow to a fixed point using multiple threads.
+         *
+         *  The vertices reachable from the start vertex are partitioned into strongly connected components.  Each component is
+         *  solved to a fixed point, in reverse postorder, by one of up to @p nThreads worker threads (the hardware concurrency
+         *  if zero) once every component with an edge into it has been solved, so components that don't depend on each other
+         *  are solved concurrently.  The result is the same as @ref runToFixedPoint for lattice-based analyses although the
+         *  number of iterations may differ.
+         *
+         *  The transfer, merge, and widening functions are called concurrently from different threads, although never
+         *  concurrently for the same state, and must therefore be thread safe.  Merging into a vertex of a different component
+         *  is serialized by the engine.  An exception thrown by any of them, or reaching @ref maxIterations, stops all workers
+         *  and is reported as an @ref Exception or @ref NotConverging once the workers have returned. */
+        void runToFixedPointParallel(size_t startVertexId, const StatePtr &initialState, size_t nThreads = 0) {
+            reset(startVertexId, initialState);
+            workList_.clear();
+            priorityList_.clear();
+            if (WORKLIST_REVERSE_POSTORDER != workListOrder_)
+                computeRanks(startVertexId);
+            computeSccs();
+
+            // Component A depends on component B if the CFG has an edge from a vertex of B to a vertex of A.
+            typedef Sawyer::Container::Graph<size_t> Dependencies;
+            Dependencies dependencies;
+            for (size_t i=0; i<sccVertices_.size(); ++i)
+                dependencies.insertVertex(i);
+            std::set<std::pair<size_t, size_t> > inserted;
+            for (size_t i=0; i<nReachable_; ++i) {
+                size_t sourceScc = sccOf_[rankVertex_[i]];
+                BOOST_FOREACH (const typename CFG::Edge &edge, cfg_.findVertex(rankVertex_[i])->outEdges()) {
+                    size_t targetScc = sccOf_[edge.target()->id()];
+                    if (targetScc != sourceScc && inserted.insert(std::make_pair(targetScc, sourceScc)).second)
+                        dependencies.insertEdge(dependencies.findVertex(targetScc), dependencies.findVertex(sourceScc));
+                }
+            }
+
+            parallelError_.clear();
+            parallelNotConverging_ = false;
+            Sawyer::workInParallel(dependencies, nThreads, SccWorker(this));
+            sccOf_.clear();
+            sccVertices_.clear();
+            if (parallelNotConverging_)
+                throw NotConverging(parallelError_);
+            if (!parallelError_.empty())
+                throw Exception(parallelError_);
+        }
+
         /** Return the incoming state for the specified CFG vertex.
          *
          *  This is a pointer to the incoming state for the vertex as of the latest data-flow iteration.  If the data-flow has
@@ -454,6 +548,210 @@ public:
         const VertexStates& getFinalStates() const {
             return outgoingState_;
         }
+
+    private:
+        // Functor for Sawyer::workInParallel that solves one strongly connected component.
+        struct SccWorker {
+            Engine *engine;
+            explicit SccWorker(Engine *engine): engine(engine) {}
+            void operator()(size_t sccId, size_t) { engine->solveScc(sccId); }
+        };
+
+        bool isWorkListEmpty() const {
+            return WORKLIST_REVERSE_POSTORDER == workListOrder_ ? priorityList_.empty() : workList_.isEmpty();
+        }
+
+        void pushWorkList(size_t cfgVertexId) {
+            if (WORKLIST_REVERSE_POSTORDER == workListOrder_) {
+                ASSERT_require(cfgVertexId < rank_.size());
+                priorityList_.insert(rank_[cfgVertexId]);
+            } else {
+                workList_.pushBack(cfgVertexId);
+            }
+        }
+
+        size_t popWorkList() {
+            if (WORKLIST_REVERSE_POSTORDER == workListOrder_) {
+                ASSERT_forbid(priorityList_.empty());
+                size_t cfgVertexId = rankVertex_[*priorityList_.begin()];
+                priorityList_.erase(priorityList_.begin());
+                return cfgVertexId;
+            }
+            return workList_.popFront();
+        }
+
+        std::vector<size_t> workListItems() const {
+            std::vector<size_t> retval;
+            if (WORKLIST_REVERSE_POSTORDER == workListOrder_) {
+                BOOST_FOREACH (size_t rank, priorityList_)
+                    retval.push_back(rankVertex_[rank]);
+            } else {
+                retval.insert(retval.end(), workList_.items().begin(), workList_.items().end());
+            }
+            return retval;
+        }
+
+        // Number the vertices in reverse postorder of a depth-first traversal from the start vertex. Vertices that are not
+        // reachable are numbered after all reachable vertices.
+        void computeRanks(size_t startVertexId) {
+            using namespace Sawyer::Container::Algorithm;
+            const size_t UNRANKED = (size_t)(-1);
+            rankVertex_.clear();
+            typedef DepthFirstForwardGraphTraversal<const CFG> Traversal;
+            for (Traversal t(cfg_, cfg_.findVertex(startVertexId), LEAVE_VERTEX); t; ++t)
+                rankVertex_.push_back(t.vertex()->id());
+            std::reverse(rankVertex_.begin(), rankVertex_.end());
+            nReachable_ = rankVertex_.size();
+            rank_.clear();
+            rank_.resize(cfg_.nVertices(), UNRANKED);
+            for (size_t i=0; i<nReachable_; ++i)
+                rank_[rankVertex_[i]] = i;
+            for (size_t id=0; id<cfg_.nVertices(); ++id) {
+                if (UNRANKED == rank_[id]) {
+                    rank_[id] = rankVertex_.size();
+                    rankVertex_.push_back(id);
+                }
+            }
+        }
+
+        // Strongly connected components of the reachable vertices by Kosaraju's algorithm: reverse traversals started in
+        // reverse postorder each find one component.  The ranks must already be computed.
+        void computeSccs() {
+            using namespace Sawyer::Container::Algorithm;
+            const size_t NO_SCC = (size_t)(-1);
+            sccOf_.clear();
+            sccOf_.resize(cfg_.nVertices(), NO_SCC);
+            sccVertices_.clear();
+            for (size_t i=0; i<nReachable_; ++i) {
+                if (sccOf_[rankVertex_[i]] != NO_SCC)
+                    continue;
+                size_t sccId = sccVertices_.size();
+                sccVertices_.push_back(std::vector<size_t>());
+                typedef DepthFirstReverseGraphTraversal<const CFG> Traversal;
+                for (Traversal t(cfg_, cfg_.findVertex(rankVertex_[i]), ENTER_VERTEX); t; ++t) {
+                    size_t id = t.vertex()->id();
+                    if (rank_[id] >= nReachable_ || sccOf_[id] != NO_SCC) {
+                        t.skipChildren();
+                    } else {
+                        sccOf_[id] = sccId;
+                        sccVertices_[sccId].push_back(id);
+                    }
+                }
+            }
+        }
+
+        // Combine a vertex's outgoing state into the incoming state of one of its successors. Returns true if the successor's
+        // incoming state changed.
+        bool mergeIncoming(size_t cfgVertexId, size_t nextVertexId, const StatePtr &state) {
+            using namespace Diagnostics;
+            boost::unique_lock<boost::mutex> lock(mutex_, boost::defer_lock);
+            if (!sccOf_.empty() && sccOf_[nextVertexId] != sccOf_[cfgVertexId])
+                lock.lock();
+
+            StatePtr targetState = incomingState_[nextVertexId];
+            if (targetState==NULL) {
+                SAWYER_MESG(mlog[DEBUG]) <<"    forwarded to vertex #" <<nextVertexId <<"\n";
+                incomingState_[nextVertexId] = xfer_(state); // copy the state
+                return true;
+            }
+
+            bool changed = false;
+            if (nVisits_[nextVertexId] >= wideningThreshold_) {
+                changed = widen_(targetState, state);
+                if (!sccOf_.empty() && !lock.owns_lock()) {
+                    boost::lock_guard<boost::mutex> counterLock(mutex_);
+                    ++nWidenings_;
+                } else {
+                    ++nWidenings_;
+                }
+            } else {
+                changed = merge_(targetState, state); // merge state into targetState, return true if changed
+            }
+            if (changed) {
+                SAWYER_MESG(mlog[DEBUG]) <<"    merged with vertex #" <<nextVertexId <<" (which changed as a result)\n";
+            } else {
+                SAWYER_MESG(mlog[DEBUG]) <<"     merged with vertex #" <<nextVertexId <<" (no change)\n";
+            }
+            return changed;
+        }
+
+        // Run the transfer function for one vertex and merge its outgoing state into its successors. The IDs of successors
+        // whose incoming state changed are appended to @p changed.
+        void visitVertex(size_t cfgVertexId, std::vector<size_t> &changed /*in,out*/) {
+            using namespace Diagnostics;
+            ASSERT_require2(cfgVertexId < cfg_.nVertices(),
+                            "vertex " + boost::lexical_cast<std::string>(cfgVertexId) + " must be valid within CFG");
+            typename CFG::ConstVertexIterator vertex = cfg_.findVertex(cfgVertexId);
+            StatePtr state = incomingState_[cfgVertexId];
+            ASSERT_not_null2(state,
+                             "initial state must exist for CFG vertex " + boost::lexical_cast<std::string>(cfgVertexId));
+            ++nVisits_[cfgVertexId];
+            if (mlog[DEBUG]) {
+                std::ostringstream ss;
+                ss <<*state;
+                mlog[DEBUG] <<"  incoming state for vertex #" <<cfgVertexId <<"\n";
+                mlog[DEBUG] <<StringUtility::prefixLines(ss.str(), "    ");
+            }
+
+            state = outgoingState_[cfgVertexId] = xfer_(cfg_, cfgVertexId, state);
+            ASSERT_not_null2(state, "outgoing state not created for vertex "+boost::lexical_cast<std::string>(cfgVertexId));
+            if (mlog[DEBUG]) {
+                std::ostringstream ss;
+                ss <<*state;
+                mlog[DEBUG] <<"  outgoing state for vertex #" <<cfgVertexId <<"\n";
+                mlog[DEBUG] <<StringUtility::prefixLines(ss.str(), "    ");
+            }
+
+            // Outgoing state must be merged into the incoming states for the CFG successors.  Any such incoming state that
+            // is modified as a result will be reported to the caller so the successor can be added to the work list.
+            SAWYER_MESG(mlog[DEBUG]) <<"  forwarding vertex #" <<cfgVertexId <<" output state to "
+                                     <<StringUtility::plural(vertex->nOutEdges(), "vertices", "vertex") <<"\n";
+            BOOST_FOREACH (const typename CFG::Edge &edge, vertex->outEdges()) {
+                size_t nextVertexId = edge.target()->id();
+                if (mergeIncoming(cfgVertexId, nextVertexId, state))
+                    changed.push_back(nextVertexId);
+            }
+        }
+
+        // Solve one strongly connected component to a fixed point. All components on which it depends are already solved.
+        void solveScc(size_t sccId) {
+            try {
+                std::set<size_t> work;                  // ranks of vertices to visit
+                BOOST_FOREACH (size_t id, sccVertices_[sccId]) {
+                    if (incomingState_[id] != NULL)
+                        work.insert(rank_[id]);
+                }
+                while (!work.empty()) {
+                    size_t cfgVertexId = rankVertex_[*work.begin()];
+                    work.erase(work.begin());
+                    {
+                        boost::lock_guard<boost::mutex> lock(mutex_);
+                        if (!parallelError_.empty())
+                            return;
+                        if (++nIterations_ > maxIterations_) {
+                            throw NotConverging("data-flow max iterations reached"
+                                                " (max=" + StringUtility::numberToString(maxIterations_) + ")");
+                        }
+                    }
+                    std::vector<size_t> changed;
+                    visitVertex(cfgVertexId, changed /*out*/);
+                    BOOST_FOREACH (size_t nextVertexId, changed) {
+                        if (sccOf_[nextVertexId] == sccId)
+                            work.insert(rank_[nextVertexId]);
+                    }
+                }
+            } catch (const NotConverging &e) {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                if (parallelError_.empty()) {
+                    parallelError_ = e.what();
+                    parallelNotConverging_ = true;
+                }
+            } catch (const std::exception &e) {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                if (parallelError_.empty())
+                    parallelError_ = e.what();
+            }
+        }
     };
 };
 
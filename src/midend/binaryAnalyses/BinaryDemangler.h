@@ -0,0 +1,85 @@
+#ifndef ROSE_BinaryAnalysis_Demangler_H
+#define ROSE_BinaryAnalysis_Demangler_H
+
+#include <boost/thread/mutex.hpp>
+#include <Sawyer/Map.h>
+#include <Sawyer/SharedPointer.h>
+#include <string>
+#include <vector>
+
+class SgAsmInterpretation;
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** Cache of demangled names.
+ *
+ *  Demangling a name is expensive, especially when it's done by running c++filt, and the same names are demangled over and
+ *  over by the unparser, the partitioner, and library identification.  A demangler caches the demangled form of each name it
+ *  has seen. It is normally populated once, in parallel, with all the symbol names of a binary container right after the
+ *  container is parsed, and then only queried.  All methods are thread safe.
+ *
+ *  Names that are not mangled, or that cannot be demangled, map to themselves. */
+class Demangler: public Sawyer::SharedObject {
+public:
+    /** Shared-ownership pointer to a @ref Demangler. See @ref heap_object_shared_ownership. */
+    typedef Sawyer::SharedPointer<Demangler> Ptr;
+
+    /** Mapping from mangled name to demangled name. */
+    typedef Sawyer::Container::Map<std::string, std::string> NameMap;
+
+private:
+    mutable boost::mutex mutex_;                        // protects the following data members
+    NameMap names_;
+
+protected:
+    Demangler() {}
+
+public:
+    /** Allocating constructor. */
+    static Ptr instance() {
+        return Ptr(new Demangler);
+    }
+
+    /** Demangle one name without using the cache.
+     *
+     *  Uses the C++ runtime's demangler when it's available and c++filt otherwise. A version suffix like "@plt" or
+     *  "@@GLIBC_2.2.5" is not part of the mangled name and is appended to the demangled result. */
+    static std::string demangleUncached(const std::string &mangled);
+
+    /** Demangle a name.
+     *
+     *  Returns the cached result if there is one, otherwise demangles the name and caches the result. */
+    std::string demangle(const std::string &mangled);
+
+    /** Demangle many names.
+     *
+     *  Names that are not already cached are demangled using the specified number of threads and then added to the cache. If
+     *  @p nThreads is zero then the system's hardware concurrency is used. */
+    void insert(const std::vector<std::string> &mangledNames, size_t nThreads = 1);
+
+    /** Demangle all symbol names of an interpretation.
+     *
+     *  The names of the symbols, PE imports, and PE exports of all headers of the interpretation are demangled in parallel
+     *  and added to the cache.  See @ref insert. */
+    void insertSymbols(SgAsmInterpretation*, size_t nThreads = 1);
+
+    /** Insert a known demangled name.
+     *
+     *  This is how a cache is restored without demangling anything, such as when loading a partitioner state. */
+    void insert(const std::string &mangled, const std::string &demangled);
+
+    /** All cached names. */
+    NameMap allNames() const;
+
+    /** Number of cached names. */
+    size_t size() const;
+
+    /** Remove all cached names. */
+    void clear();
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -2,6 +2,7 @@
 #define ROSE_BinaryAnalysis_Dominance_H
 
 #include "BinaryControlFlow.h"
+#include "GraphDominance.h"
 
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/reverse_graph.hpp>
@@ -237,11 +238,10 @@ public:
      *  in the CFG), the stored value is the null vertex.  See RelationMap for details.
      *
      *  This method is intended to be the lowest level implementation for finding dominators; all other methods are built
-     *  upon this one.  This method uses an algorithm based on "A Simple, Fast Dominance Algorithm" by Keith
-     *  D. Cooper, Timothy J. Harvey, and Ken Kennedy at Rice University, Houston, Texas.  It has been extended in various
-     *  ways to simplify it and make it slightly faster.  Although run-time complexity is higher than the Lengauer-Tarjan
-     *  algorithm, the algorithm is much simpler, and for CFGs typically encountered in practice is faster than
-     *  Lengauer-Tarjan.
+     *  upon this one.  It converts the CFG to compact adjacency arrays and calls GraphUtility::immediateDominators, which
+     *  uses the semi-NCA variant of the Lengauer-Tarjan algorithm.  The run time is nearly linear in the size of the CFG,
+     *  which matters for functions with very many basic blocks, such as obfuscated code or large switch statements.  The
+     *  source-code dominator trees in DominatorTreesAndDominanceFrontiers use the same implementation.
      *
      *  @{ */
     template<class ControlFlowGraph>
@@ -491,38 +491,9 @@ Dominance::build_idom_relation_from_cfg(const ControlFlowGraph &cfg,
     return idom;
 }
 
-/* Loosely based on an algorithm from Rice University known to be O(n^2) where n is the number of vertices in the control flow
- * subgraph connected to the start vertex.  According to the Rice paper, their algorithm outperforms Lengauer-Tarjan on
- * typicall control flow graphs even though asymptotically, Lengauer-Tarjan is better.  The Rice algorithm is also much
- * simpler, as evidenced below.
- *
- * I've added a few minor optimizations:
- *   (1) reverse post-order dfs is calculated once rather than each time through the loop.  Rice's analysis indicates that
- *       they also made this optimization, although their listed algorithm does not show it.
- *   (2) the first processed predecessor of the vertex under consideration is determined in the same loop that processes
- *       the other predecessors, while in the listed algorithm this was a separate operation.
- *   (3) self loops in the control flow graph are not processed, since they don't contribute to the dominance relation.
- *   (4) undefined state for idom(x) is represented by idom(x)==x.
- *   (5) nodes are labeled in reverse order from Rice, but traversed in the same order.  This simplifies the code a bit
- *       because the vertices are traversed according to the "flowlist" vector, and the index into the "flowlist" vector
- *       can serve as the node label.
- *
- * The set of dominators of vertex v, namely dom(v), is represented as a linked list stored as an array indexed by vertex
- * number. That is
- *      dom(v) = { v, idom(v), idom(idom(v)), ..., start }
- *
- * is stored in the idom array as:
- *
- *      dom(v) = { v, idom[v], idom[idom[v]], ..., start }
- *
- * This representation, combined with the fact that:
- *
- *      a ELEMENT_OF dom(v) implies dom(a) SUBSET_OF dom(v)
- *
- * allows us to perform intersection by simply walking the two sorted lists until we find an element in common, and including
- * that element an all subsequent elements in the intersection result.  The idom array uses the flow-list vertex numbering
- * produced by a post-order visitor of a depth-first search, and the nodes are processed from highest to lowest.
- */
+/* The dominators are computed by GraphUtility::immediateDominators, which implements the semi-NCA algorithm on compact
+ * adjacency arrays.  This function only converts the Boost graph to that representation and converts the result back to CFG
+ * vertex descriptors.  Vertex descriptors are integers since the vertices are stored in a vector. */
 template<class ControlFlowGraph>
 void
 Dominance::build_idom_relation_from_cfg(const ControlFlowGraph &cfg,
@@ -531,18 +502,6 @@ Dominance::build_idom_relation_from_cfg(const ControlFlowGraph &cfg,
 {
     typedef typename boost::graph_traits<ControlFlowGraph>::vertex_descriptor CFG_Vertex;
 
-    struct debug_dom_set {
-        debug_dom_set(FILE *debug, size_t vertex_i, size_t idom_i,
-                      const std::vector<size_t> &domsets, const std::vector<CFG_Vertex> &flowlist) {
-            if (debug) {
-                fprintf(debug, "{ #%" PRIuPTR "(%" PRIuPTR ")", vertex_i, flowlist[vertex_i]);
-                for (size_t d=idom_i; d!=vertex_i; vertex_i=d, d=domsets[d])
-                    fprintf(debug, " #%" PRIuPTR "(%" PRIuPTR ")", d, flowlist[d]);
-                fprintf(debug, " }");
-            }
-        }
-    };
-
     if (debug) {
         fprintf(debug, "rose::BinaryAnalysis::Dominance::build_idom_relation_from_cfg: starting at vertex %" PRIuPTR "\n", start);
         SgAsmBlock *block = get(boost::vertex_name, cfg, start);
@@ -558,130 +517,37 @@ Dominance::build_idom_relation_from_cfg(const ControlFlowGraph &cfg,
         }
     }
 
-    /* Initialize */
-    std::vector<size_t> rflowlist; /* reverse mapping; flowlist[i]==v implies rflowlist[v]==i */
-    std::vector<CFG_Vertex> flowlist = ControlFlow().flow_order(cfg, start, &rflowlist);
-    std::vector<size_t> idom(flowlist.size());
-    for (size_t i=0; i<flowlist.size(); i++)
-        idom[i] = i; /* idom[i]==i implies idom[i] is unknown */
-
-    if (debug) {
+    /* Convert the CFG to adjacency arrays */
+    std::vector<std::pair<size_t, size_t> > edges;
+    edges.reserve(num_edges(cfg));
+    if (debug)
         fprintf(debug, "  CFG:\n");
-        typename boost::graph_traits<ControlFlowGraph>::vertex_iterator vi, vi_end;
-        for (boost::tie(vi, vi_end)=vertices(cfg); vi!=vi_end; ++vi) {
+    typename boost::graph_traits<ControlFlowGraph>::vertex_iterator vi, vi_end;
+    for (boost::tie(vi, vi_end)=vertices(cfg); vi!=vi_end; ++vi) {
+        if (debug) {
             SgAsmBlock *block = get(boost::vertex_name, cfg, *vi);
             fprintf(debug, "    %" PRIuPTR " 0x%08" PRIx64 " --> {", (size_t)(*vi), block?block->get_address():0);
-            typename boost::graph_traits<ControlFlowGraph>::out_edge_iterator ei, ei_end;
-            for (boost::tie(ei, ei_end)=out_edges(*vi, cfg); ei!=ei_end; ++ei) {
-                fprintf(debug, " %" PRIuPTR "", (size_t)target(*ei, cfg));
-            }
-            fprintf(debug, " }\n");
         }
-
-        fprintf(debug, "  Note: notation #M(N) means CFG vertex N at position M in the flow list.\n");
-        fprintf(debug, "  Flowlist: {");
-        for (size_t i=0; i<flowlist.size(); i++) {
-            fprintf(debug, " #%" PRIuPTR "(%" PRIuPTR ")", i, (size_t)flowlist[i]);
-            assert((size_t)flowlist[i]<rflowlist.size());
-            assert(rflowlist[flowlist[i]]==i);
+        typename boost::graph_traits<ControlFlowGraph>::out_edge_iterator ei, ei_end;
+        for (boost::tie(ei, ei_end)=out_edges(*vi, cfg); ei!=ei_end; ++ei) {
+            edges.push_back(std::make_pair((size_t)(*vi), (size_t)target(*ei, cfg)));
+            if (debug)
+                fprintf(debug, " %" PRIuPTR "", (size_t)target(*ei, cfg));
         }
-        fprintf(debug, " }\n");
-    }
-
-    /* Iterative data flow */
-    bool changed;
-    do {
-        changed = false;
         if (debug)
-            fprintf(debug, "  Next pass through vertices...\n");
-        for (size_t vertex_i=0; vertex_i<flowlist.size(); vertex_i++) {
-            CFG_Vertex vertex = flowlist[vertex_i];
-            if (debug) {
-                fprintf(debug, "    vertex #%" PRIuPTR "(%" PRIuPTR ")", (size_t)vertex_i, (size_t)vertex);
-                if (vertex==start) {
-                    fprintf(debug, " [skipping start vertex]\n");
-                } else {
-                    fprintf(debug, " dominators are ");
-                    debug_dom_set(debug, vertex_i, idom[vertex_i], idom, flowlist);
-                    fprintf(debug, "\n");
-                }
-            }
-
-            if (vertex!=start) {
-                typename boost::graph_traits<ControlFlowGraph>::in_edge_iterator pi, pi_end; /*predecessors*/
-                size_t new_idom = vertex_i; /*undefined for now*/
-                for (boost::tie(pi, pi_end)=in_edges(vertex, cfg); pi!=pi_end; ++pi) {
-                    CFG_Vertex predecessor = source(*pi, cfg);
-                    assert(predecessor>=0 && predecessor<rflowlist.size());
-                    size_t predecessor_i = rflowlist[predecessor];
-                    if (debug)
-                        fprintf(debug, "      pred #%zd(%" PRIuPTR ")", (size_t)predecessor_i, (size_t)predecessor);
-
-                    /* It's possible that the predecessor lies outside the part of the CFG connected to the entry node. We
-                     * should not consider those predecessors. */
-                    if (predecessor!=vertex && predecessor_i!=boost::graph_traits<ControlFlowGraph>::null_vertex()) {
-                        if (predecessor==start) {
-                            new_idom = predecessor_i;
-                            if (debug) {
-                                fprintf(debug, "; new doms of #%" PRIuPTR "(%" PRIuPTR ") are ", vertex_i, vertex);
-                                debug_dom_set(debug, vertex_i, predecessor_i, idom, flowlist);
-                            }
-                        } else if (idom[predecessor_i]!=predecessor_i) {
-                            if (new_idom==vertex_i) {
-                                new_idom = predecessor_i;
-                                if (debug) {
-                                    fprintf(debug, "; new doms of #%" PRIuPTR "(%" PRIuPTR ") are ", vertex_i, vertex);
-                                    debug_dom_set(debug, vertex_i, predecessor_i, idom, flowlist);
-                                }
-                            } else {
-                                if (debug) {
-                                    fprintf(debug, "; new doms of #%" PRIuPTR "(%" PRIuPTR ") are intersect(", vertex_i, vertex);
-                                    debug_dom_set(debug, vertex_i, new_idom, idom, flowlist);
-                                    fprintf(debug, ", ");
-                                    debug_dom_set(debug, vertex_i, predecessor_i, idom, flowlist);
-                                }
-                                size_t f1=new_idom, f2=predecessor_i;
-                                while (f1!=f2) {
-                                    while (f1 > f2)
-                                        f1 = idom[f1];
-                                    while (f2 > f1)
-                                        f2 = idom[f2];
-                                }
-                                new_idom = f1;
-                                if (debug) {
-                                    fprintf(debug, ") = ");
-                                    debug_dom_set(debug, vertex_i, new_idom, idom, flowlist);
-                                }
-                            }
-                        }
-                    }
-                    if (debug)
-                        fprintf(debug, "\n");
-                }
-                if (idom[vertex_i]!=new_idom) {
-                    idom[vertex_i] = new_idom;
-                    changed = true;
-                }
-            }
-        }
-    } while (changed);
+            fprintf(debug, " }\n");
+    }
+    std::vector<size_t> idom = GraphUtility::immediateDominators(GraphUtility::Adjacency(num_vertices(cfg), edges), start);
 
     /* Build result relation */
     result.clear();
     result.resize(num_vertices(cfg), boost::graph_traits<ControlFlowGraph>::null_vertex());
-    for (size_t i=0; i<flowlist.size(); i++) {
-        if (idom[i]!=i)
-            result[flowlist[i]] = flowlist[idom[i]];
+    for (size_t i=0; i<idom.size(); i++) {
+        if (idom[i]!=GraphUtility::NO_VERTEX)
+            result[i] = (CFG_Vertex)idom[i];
     }
 
     if (debug) {
-        fprintf(debug, "  Final dom sets:\n");
-        for (size_t vertex_i=0; vertex_i<flowlist.size(); vertex_i++) {
-            CFG_Vertex vertex = flowlist[vertex_i];
-            fprintf(debug, "    #%" PRIuPTR "(%" PRIuPTR ") has dominators ", (size_t)vertex_i, (size_t)vertex);
-            debug_dom_set(debug, vertex_i, idom[vertex_i], idom, flowlist);
-            fprintf(debug, "\n");
-        }
         fprintf(debug, "  Final result:\n");
         for (size_t i=0; i<result.size(); i++) {
             if (result[i]==boost::graph_traits<ControlFlow::Graph>::null_vertex()) {
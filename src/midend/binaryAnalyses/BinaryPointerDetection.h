@@ -3,6 +3,7 @@
 
 #include <BaseSemantics2.h>
 #include <MemoryCellList.h>
+#include <Sawyer/Map.h>
 #include <Sawyer/Set.h>
 
 namespace rose {
@@ -168,6 +169,7 @@ public:
 private:
     Settings settings_;
     InstructionSemantics2::BaseSemantics::DispatcherPtr cpu_;
+    bool usePartitionerSolver_;                         // Use the partitioner's SMT solver during analysis?
     bool hasResults_;                                   // Are the following data members initialized?
     bool didConverge_;                                  // Are the following data members valid (else only appoximations)?
     PointerDescriptors codePointers_;                   // Memory addresses that hold a pointer to code
@@ -182,13 +184,13 @@ public:
      *  would be analyzing.  This is mostly for use in situations where an analyzer must be constructed as a member of another
      *  class's default constructor, in containers that initialize their contents with a default constructor, etc. */
     Analysis()
-        : hasResults_(false), didConverge_(false) {}
+        : usePartitionerSolver_(true), hasResults_(false), didConverge_(false) {}
 
     /** Construct an analysis using a specific disassembler.
      *
      *  This constructor chooses a symbolic domain and a dispatcher appropriate for the disassembler's architecture. */
     explicit Analysis(Disassembler *d, const Settings &settings = Settings())
-        : hasResults_(false), didConverge_(false) {
+        : settings_(settings), usePartitionerSolver_(true), hasResults_(false), didConverge_(false) {
         init(d);
     }
 
@@ -200,12 +202,23 @@ public:
      *  defaults used by @ref InstructionSemantics2::SymbolicSemantics. */
     explicit Analysis(const InstructionSemantics2::BaseSemantics::DispatcherPtr &cpu,
                       const Settings &settings = Settings())
-        : cpu_(cpu), hasResults_(false), didConverge_(false) {}
+        : settings_(settings), cpu_(cpu), usePartitionerSolver_(true), hasResults_(false), didConverge_(false) {}
 
     /** Property: Analysis settings.
      *
      *  Returns the settings that are being used for this analysis. Settings are read-only, initialized by the constructor. */
     const Settings& settings() const { return settings_; }
+
+    /** Property: Whether to use the partitioner's SMT solver.
+     *
+     *  If set, which is the default, the symbolic operators created by @ref analyzeFunction use the partitioner's SMT solver,
+     *  otherwise they use no solver. A solver is not thread safe, so analyses that run concurrently with one another must
+     *  clear this property.
+     *
+     * @{ */
+    bool usePartitionerSolver() const { return usePartitionerSolver_; }
+    void usePartitionerSolver(bool b) { usePartitionerSolver_ = b; }
+    /** @} */
     
     /** Analyze one function.
      *
@@ -291,6 +304,21 @@ private:
                              size_t wordSize, PointerDescriptors &result);
 };
 
+/** Analysis results for many functions, indexed by function entry address. */
+typedef Sawyer::Container::Map<rose_addr_t, Analysis> FunctionAnalyses;
+
+/** Analyze all functions.
+ *
+ *  Runs a pointer detection analysis on each function of the partitioner and returns the results indexed by function entry
+ *  address. The functions are analyzed in parallel using the number of threads specified by ROSE's "--threads" switch. The
+ *  partitioner is shared by all threads and must not be modified while this runs; each thread has its own analysis object and
+ *  therefore its own symbolic operators. Since the threads can't share the partitioner's SMT solver, the analyses use no
+ *  solver unless only one thread is used.
+ *
+ *  The initial and final states are cleared from the returned analyses (see @ref Analysis::clearNonResults) so that the table
+ *  holds only the results. Functions whose CFG has no return vertex are present but have no results. */
+FunctionAnalyses analyzeAllFunctions(const Partitioner2::Partitioner&, const Settings &settings = Settings());
+
 } // namespace
 } // namespace
 } // namespace
@@ -842,10 +842,22 @@ public:
 
         Settings(): minLength(5), maxLength(-1), maxOverlap(8), keepingOnlyLongest(true) {}
     };
+
+    /** Functor called for each string that's found.
+     *
+     *  See the @ref find method that takes a callback. */
+    class FoundCallback {
+    public:
+        virtual ~FoundCallback() {}
+
+        /** Called for each string that's found. */
+        virtual void operator()(const EncodedString&) = 0;
+    };
     
 private:
     Settings settings_;                                 // command-line settings for this analysis
     bool discardingCodePoints_;                         // whether to store decoded code points
+    size_t nThreads_;                                   // number of threads for searching, or zero for hardware concurrency
     std::vector<StringEncodingScheme::Ptr> encoders_;   // encodings to use when searching
     std::vector<EncodedString> strings_;                // strings that have been found
 
@@ -854,7 +866,7 @@ public:
      *
      *  Initializes the analysis with default settings but no encoders. Encoders will need to be added before this analysis can
      *  be used to find any strings. */
-    StringFinder(): discardingCodePoints_(false) {}
+    StringFinder(): discardingCodePoints_(false), nThreads_(1) {}
 
     /** Property: %Analysis settings often set from a command-line.
      *
@@ -874,6 +886,18 @@ public:
     StringFinder& discardingCodePoints(bool b) { discardingCodePoints_=b; return *this; }
     /** @} */
 
+    /** Property: Number of threads used for searching.
+     *
+     *  Each contiguous region of memory that's searched (each memory map segment that satisfies the search constraints) is a
+     *  unit of work, and the regions are searched in parallel using this many threads. Zero means use the hardware
+     *  concurrency. The default is one. Strings never span regions, so the results are the same regardless of the number of
+     *  threads.
+     *
+     * @{ */
+    size_t nThreads() const { return nThreads_; }
+    StringFinder& nThreads(size_t n) { nThreads_ = n; return *this; }
+    /** @} */
+
     /** Property: List of string encodings.
      *
      *  When searching for strings, this analysis must know what kinds of strings to look for, and does that with a vector of
@@ -935,7 +959,9 @@ public:
      *
      *  The search progresses by looking at each possible starting address using each registered encoding. The algorithm reads
      *  each byte from memory only one time, simultaneously attempting all encoders.  If the MemoryMap constraint contains an
-     *  anchor point (e.g., @ref MemoryMap::at) then only strings starting at the specified address are returned.
+     *  anchor point (e.g., @ref MemoryMap::at) then only strings starting at the specified address are returned.  A decoder
+     *  is started at an address only if its encoding accepts the byte at that address as the first byte of a string, and when
+     *  no decoders are active the search skips over bytes that can't start a string for any encoding.
      *
      *  Example 1: Find all C-style, NUL-terminated, ASCII strings contaiing only printable characters (no control characters)
      *  and containing at least five characters but not more than 31 (not counting the NUL terminator).  Make sure that the
@@ -954,6 +980,15 @@ public:
      * @endcode */
     StringFinder& find(const MemoryMap::ConstConstraints&, Sawyer::Container::MatchFlags flags=0);
 
+    /** Finds strings by searching memory, sending them to a callback.
+     *
+     *  This is like the other @ref find method except the strings are not saved in this analysis (@ref strings will be empty)
+     *  but are passed to the callback as they're found, which uses much less memory when searching large specimens. Since not
+     *  all strings are known when the callback is invoked, the @ref Settings::keepingOnlyLongest "keepingOnlyLongest" setting
+     *  is not applied. When more than one thread is used (see @ref nThreads) the callback is invoked by the worker threads,
+     *  one call at a time, and the order of the strings is not defined. */
+    StringFinder& find(const MemoryMap::ConstConstraints&, FoundCallback&, Sawyer::Container::MatchFlags flags=0);
+
     /** Obtain strings that were found.
      *
      * @{ */
@@ -965,6 +1000,11 @@ public:
      *
      *  Print information about each string, one string per line.  Strings are displayed with C/C++ string syntax. */
     std::ostream& print(std::ostream&) const;
+
+private:
+    // Search for strings, appending them to "strings" or sending them to "callback", exactly one of which is non-null.
+    void search(const MemoryMap::ConstConstraints&, Sawyer::Container::MatchFlags, std::vector<EncodedString> *strings,
+                FoundCallback *callback);
 };
 
 std::ostream& operator<<(std::ostream&, const StringFinder&);
@@ -9,7 +9,9 @@
 
 #include <cassert>
 #include <boost/any.hpp>
+#include <boost/unordered_map.hpp>
 #include <inttypes.h>
+#include <list>
 #include <Sawyer/Attribute.h>
 #include <Sawyer/BitVector.h>
 #include <Sawyer/Set.h>
@@ -158,6 +160,167 @@ public:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Hash consing
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Table of unique expressions.
+ *
+ *  While a table is installed (see @ref install), the class methods that create nodes (@ref Interior::create, @ref
+ *  Leaf::createInteger, etc.) return the node from the table that's equivalent to the newly created node, if there is one,
+ *  instead of the new node. This is known as "hash consing". Equivalent expressions are then the same object instead of
+ *  separate copies, which saves memory, and comparing them with @ref Node::isEquivalentTo succeeds on the first test since
+ *  they're the same pointer.  Two nodes are considered to be the same if they're equivalent according to @ref
+ *  Node::isEquivalentTo and they have the same comment. New variables and memory states are never equivalent to existing
+ *  nodes and are therefore not added to the table.
+ *
+ *  The table holds a reference to each of its nodes, so they're not freed until the table is cleared or destroyed.  Since
+ *  nodes created while a table is installed may be shared by unrelated expressions, their comments and user data should not
+ *  be changed.
+ *
+ *  At most one table is installed at a time for the whole process. All access to the installed table is serialized, so nodes
+ *  can be created by multiple threads. */
+class ROSE_DLL_API HashConsTable {
+    typedef boost::unordered_map<Hash, Nodes> Buckets;
+    Buckets buckets_;                                   // nodes with the same hash
+    size_t nNodes_;                                     // total number of nodes in all buckets
+
+public:
+    /** Construct an empty table that is not installed. */
+    HashConsTable(): nNodes_(0) {}
+
+    /** Destructor uninstalls the table if it's installed. */
+    ~HashConsTable();
+
+    /** Make this the installed table.
+     *
+     *  Replaces any table that was installed previously. */
+    void install();
+
+    /** Uninstall the installed table, if any. */
+    static void uninstall();
+
+    /** The installed table, or null. */
+    static HashConsTable* installed();
+
+    /** Find or insert a node.
+     *
+     *  Returns the node in this table that's the same as the specified node, inserting the specified node if the table has no
+     *  such node. */
+    Ptr insert(const Ptr&);
+
+    /** Number of nodes in the table. */
+    size_t size() const;
+
+    /** Remove all nodes from the table.
+     *
+     *  Nodes are freed if the table holds their only reference. */
+    void clear();
+
+private:
+    HashConsTable(const HashConsTable&);                // not copyable
+    HashConsTable& operator=(const HashConsTable&);     // not copyable
+};
+
+/** Hash cons a node.
+ *
+ *  Returns the node from the installed @ref HashConsTable that's the same as the specified node, inserting it if necessary. If
+ *  no table is installed then the argument is returned. */
+ROSE_DLL_API Ptr hashCons(const Ptr&);
+
+/** Cache of simplification results.
+ *
+ *  While a cache is installed (see @ref install), simplifying a newly created interior node first looks for an earlier node
+ *  with the same hash that's equivalent according to @ref Node::isEquivalentTo, and if found returns that node's simplified
+ *  result instead of running the simplification rules again.  Since the hash of an interior node is computed from its operator,
+ *  width, flags, and the hashes of its children, lookups are inexpensive, and they're especially effective when combined with
+ *  @ref HashConsTable since equivalent children are then the same object.  Nodes that have a comment are neither looked up nor
+ *  cached because the comment could be lost or misattributed.
+ *
+ *  The cache holds the specified maximum number of results and evicts the least recently used result when it's full.  The
+ *  cache is shared by everything that creates expressions, such as all states of a semantic analysis.
+ *
+ *  At most one cache is installed at a time for the whole process. All access to the installed cache is serialized, so nodes
+ *  can be created by multiple threads. */
+class ROSE_DLL_API SimplifierCache {
+    struct Entry {
+        Hash key;
+        Ptr input;                                      // the unsimplified expression
+        Ptr result;                                     // its simplified form
+        Entry(Hash key, const Ptr &input, const Ptr &result): key(key), input(input), result(result) {}
+    };
+    typedef std::list<Entry> Entries;                   // most recently used at the front
+    typedef boost::unordered_map<Hash, Entries::iterator> Index;
+    Entries entries_;
+    Index index_;
+    size_t maxSize_;
+    size_t nHits_, nMisses_, nEvictions_;
+
+public:
+    /** Construct an empty cache that is not installed. */
+    explicit SimplifierCache(size_t maxSize = 100000)
+        : maxSize_(maxSize), nHits_(0), nMisses_(0), nEvictions_(0) {}
+
+    /** Destructor uninstalls the cache if it's installed. */
+    ~SimplifierCache();
+
+    /** Make this the installed cache.
+     *
+     *  Replaces any cache that was installed previously. */
+    void install();
+
+    /** Uninstall the installed cache, if any. */
+    static void uninstall();
+
+    /** The installed cache, or null. */
+    static SimplifierCache* installed();
+
+    /** Find a cached result.
+     *
+     *  Returns the simplified form of an expression equivalent to @p input, or null if there is none. */
+    Ptr lookup(const Ptr &input);
+
+    /** Insert a result.
+     *
+     *  Records that @p input simplifies to @p result, evicting the least recently used result if the cache is full. */
+    void insert(const Ptr &input, const Ptr &result);
+
+    /** Property: Maximum number of cached results.
+     *
+     *  Reducing the size evicts results as necessary. A size of zero disables caching.
+     *
+     * @{ */
+    size_t maxSize() const { return maxSize_; }
+    void maxSize(size_t n);
+    /** @} */
+
+    /** Number of cached results. */
+    size_t size() const { return entries_.size(); }
+
+    /** Number of lookups that found a result. */
+    size_t nHits() const { return nHits_; }
+
+    /** Number of lookups that did not find a result. */
+    size_t nMisses() const { return nMisses_; }
+
+    /** Number of results that were evicted to make room for others. */
+    size_t nEvictions() const { return nEvictions_; }
+
+    /** Remove all results.
+     *
+     *  The statistics are not reset; see @ref resetStatistics. */
+    void clear();
+
+    /** Reset the hit, miss, and eviction counters to zero. */
+    void resetStatistics() { nHits_ = nMisses_ = nEvictions_ = 0; }
+
+private:
+    void evict();
+    SimplifierCache(const SimplifierCache&);            // not copyable
+    SimplifierCache& operator=(const SimplifierCache&); // not copyable
+};
+
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Base Node Type
@@ -712,22 +875,22 @@ public:
      *  @{ */
     static Ptr create(size_t nbits, Operator op, const Ptr &a, const std::string &comment="", unsigned flags=0) {
         InteriorPtr retval(new Interior(nbits, op, a, comment, flags));
-        return retval->simplifyTop();
+        return hashCons(retval->simplifyTop());
     }
     static Ptr create(size_t nbits, Operator op, const Ptr &a, const Ptr &b,
                       const std::string &comment="", unsigned flags=0) {
         InteriorPtr retval(new Interior(nbits, op, a, b, comment, flags));
-        return retval->simplifyTop();
+        return hashCons(retval->simplifyTop());
     }
     static Ptr create(size_t nbits, Operator op, const Ptr &a, const Ptr &b, const Ptr &c,
                       const std::string &comment="", unsigned flags=0) {
         InteriorPtr retval(new Interior(nbits, op, a, b, c, comment, flags));
-        return retval->simplifyTop();
+        return hashCons(retval->simplifyTop());
     }
     static Ptr create(size_t nbits, Operator op, const Nodes &children, const std::string &comment="",
                       unsigned flags=0) {
         InteriorPtr retval(new Interior(nbits, op, children, comment, flags));
-        return retval->simplifyTop();
+        return hashCons(retval->simplifyTop());
     }
     /** @} */
 
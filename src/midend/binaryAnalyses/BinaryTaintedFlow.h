@@ -6,7 +6,11 @@
 
 #include <boost/foreach.hpp>
 #include <boost/shared_ptr.hpp>
+#include <list>
+#include <Sawyer/Map.h>
+#include <Sawyer/Optional.h>
 #include <stdexcept>
+#include <vector>
 
 namespace rose {
 namespace BinaryAnalysis {
@@ -20,7 +24,7 @@ public:
      *
      *  These values form a lattice where <code>NOT_TAINTED</code> and <code>TAINTED</code> are children of <code>TOP</code>
      *  and parents of <code>BOTTOM</code>. */
-    enum Taintedness { BOTTOM, NOT_TAINTED, TAINTED, TOP };
+    enum Taintedness { BOTTOM=0, NOT_TAINTED=1, TAINTED=2, TOP=3 };
 
     /** Mode of operation.
      *
@@ -31,7 +35,8 @@ public:
 
     /** Merges two taint values.
      *
-     *  Given two taint values that are part of a taintedness lattice, return the least common ancestor. */
+     *  Given two taint values that are part of a taintedness lattice, return the least common ancestor. The enum values are
+     *  chosen so that this is the bitwise OR of the two values. */
     static Taintedness merge(Taintedness, Taintedness);
 
     /** Variable-Taintedness pair. */
@@ -44,30 +49,58 @@ public:
     /** Taint state.
      *
      *  This class represents the variables being tracked by dataflow and maps each of those variables to a taintedness value.
-     *  States are reference counted, so use either @ref instance or @ref copy to create new states. */
+     *  States are reference counted, so use either @ref instance or @ref copy to create new states.
+     *
+     *  The variables are numbered once and the numbering is shared by all states created from the same list of variables
+     *  and their copies.  The taintedness values are stored densely, two bits per variable, such that the bitwise OR of two
+     *  values is their merge (@c BOTTOM is zero, @c TOP has both bits set).  Merging two states with the same numbering is
+     *  therefore a bitwise OR of two word vectors. */
     class State {
-        typedef std::list<VariableTaint> VarTaintList;
-        VarTaintList taints_;
-
     public:
         /** Shared-ownership pointer to taint states. See @ref heap_object_shared_ownership. */
         typedef boost::shared_ptr<State> Ptr;
 
+        /** List of variable-taintedness pairs. */
+        typedef std::list<VariableTaint> VarTaintList;
+
+        /** Numbered variables shared by related states. */
+        typedef boost::shared_ptr<const std::vector<DataFlow::Variable> > VariableIndexPtr;
+
+    private:
+        typedef uint64_t Word;
+        static const size_t BITS_PER_TAINT = 2;
+        static const size_t TAINTS_PER_WORD = 8*sizeof(Word) / BITS_PER_TAINT;
+
+        VariableIndexPtr variables_;                    // variable for each variable number
+        std::vector<Word> bits_;                        // taintedness per variable number, packed
+
     protected:
         // Initialize taintedness for all variables; this is protected because this is a reference-counted object
-        State(const DataFlow::VariableList &variables, Taintedness taint) {
-            BOOST_FOREACH (const DataFlow::Variable &variable, variables)
-                taints_.push_back(std::make_pair(variable, taint));
+        State(const VariableIndexPtr &variables, Taintedness taint)
+            : variables_(variables) {
+            ASSERT_not_null(variables);
+            fill(taint);
         }
 
     public:
         /** Allocating constructor.
          *
          *  Allocates a new instance of a taint state, initializing all variables to the specified @p taint.  Returns a pointer
-         *  to the new reference-counted object. */
+         *  to the new reference-counted object.  The variables are numbered in the order given.
+         *
+         * @{ */
         static State::Ptr instance(const DataFlow::VariableList &variables, Taintedness taint = BOTTOM) {
+            return State::Ptr(new State(numberVariables(variables), taint));
+        }
+        static State::Ptr instance(const VariableIndexPtr &variables, Taintedness taint = BOTTOM) {
             return State::Ptr(new State(variables, taint));
         }
+        /** @} */
+
+        /** Number a list of variables.
+         *
+         *  Returns a numbering that can be used to create states that share it. */
+        static VariableIndexPtr numberVariables(const DataFlow::VariableList&);
 
         /** Virtual copy constructor.
          *
@@ -78,11 +111,43 @@ public:
 
         virtual ~State() {}
 
+        /** Variable numbering used by this state. */
+        const VariableIndexPtr& variableIndex() const { return variables_; }
+
+        /** Number of variables. */
+        size_t nVariables() const { return variables_->size(); }
+
+        /** Variable with the specified number. */
+        const DataFlow::Variable& variable(size_t idx) const {
+            ASSERT_require(idx < nVariables());
+            return (*variables_)[idx];
+        }
+
+        /** Number of a variable.
+         *
+         *  Returns the number of the first variable that must alias the specified variable, or nothing if there is none. */
+        Sawyer::Optional<size_t> findVariable(const DataFlow::Variable&, SMTSolver *solver = NULL) const;
+
+        /** Property: taintedness of a numbered variable.
+         *
+         * @{ */
+        Taintedness taint(size_t idx) const {
+            ASSERT_require(idx < nVariables());
+            return (Taintedness)((bits_[idx / TAINTS_PER_WORD] >> (BITS_PER_TAINT * (idx % TAINTS_PER_WORD))) & 3);
+        }
+        void taint(size_t idx, Taintedness t) {
+            ASSERT_require(idx < nVariables());
+            size_t shift = BITS_PER_TAINT * (idx % TAINTS_PER_WORD);
+            Word &word = bits_[idx / TAINTS_PER_WORD];
+            word = (word & ~((Word)3 << shift)) | ((Word)t << shift);
+        }
+        /** @} */
+
         /** Find the taintedness for some variable.
          *
-         * The specified variable must exist in this state according to <code>Variable::mustAlias</code>. Returns a reference
-         * to the variables taintedness value. */
-        Taintedness& lookup(const DataFlow::Variable&);
+         *  The specified variable must exist in this state according to <code>Variable::mustAlias</code>, otherwise an
+         *  <code>std::runtime_error</code> is thrown. */
+        Taintedness lookup(const DataFlow::Variable&) const;
 
         /** Set taintedness if the variable exists.
          *
@@ -96,15 +161,14 @@ public:
 
         /** List of all variables and their taintedness.
          *
-         *  Returns a list of VariableTaint pairs in no particular order.
-         *
-         *  @{ */
-        const VarTaintList& variables() const { return taints_; }
-        VarTaintList& variables() { return taints_; }
-        /** @} */
+         *  Returns a list of VariableTaint pairs in variable number order. Changing the list does not change this state. */
+        VarTaintList variables() const;
 
         /** Print this state. */
         void print(std::ostream&) const;
+
+    private:
+        void fill(Taintedness);
     };
 
     /** Reference counting pointer to State.
@@ -117,10 +181,21 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 protected:
     class TransferFunction {
+        // One data flow edge with its variables resolved to variable numbers.
+        struct Flow {
+            size_t source;                              // number of the source variable
+            bool clobber;                               // true if the edge is a CLOBBER edge
+            std::vector<size_t> mustTargets;            // variables that must alias the edge target
+            std::vector<size_t> mayTargets;             // variables that may alias the target (over-approximation only)
+        };
+        typedef std::vector<Flow> Flows;
+
         const DataFlow::VertexFlowGraphs &index_; // maps CFG vertex to data flow graph
         Approximation approximation_;
         SMTSolver *smtSolver_;
         Sawyer::Message::Facility &mlog;
+        State::VariableIndexPtr resolvedFor_;           // numbering used by resolved_
+        Sawyer::Container::Map<size_t, Flows> resolved_; // resolved data flow edges per CFG vertex
     public:
         TransferFunction(const DataFlow::VertexFlowGraphs &index, Approximation approx, SMTSolver *solver,
                          Sawyer::Message::Facility &mlog)
@@ -136,6 +211,10 @@ protected:
         StatePtr operator()(const StatePtr &in) {
             return in->copy();
         }
+
+    private:
+        // Resolve the data flow edges of a CFG vertex to variable numbers of the specified state.
+        const Flows& resolve(size_t cfgVertex, const State &state);
     };
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -147,6 +226,7 @@ private:
     DataFlow dataFlow_;
     DataFlow::VertexFlowGraphs vertexFlowGraphs_;
     DataFlow::VariableList variableList_;
+    State::VariableIndexPtr variableIndex_;             // numbering of variableList_ shared by all states
     bool vlistInitialized_;
     std::vector<StatePtr> results_;
     SMTSolver *smtSolver_;
@@ -201,6 +281,7 @@ public:
         Stream mesg(mlog[WHERE] <<"computeFlowGraphs starting at CFG vertex " <<cfgStartVertex);
         vertexFlowGraphs_ = dataFlow_.buildGraphPerVertex(cfg, cfgStartVertex);
         variableList_ = dataFlow_.getUniqueVariables(vertexFlowGraphs_);
+        variableIndex_ = State::numberVariables(variableList_);
         results_.clear();
         vlistInitialized_ = true;
         mesg <<"; found " <<StringUtility::plural(variableList_.size(), "variables") <<"\n";
@@ -226,6 +307,7 @@ public:
         ASSERT_this();
         vertexFlowGraphs_ = graphMap;
         variableList_ = dataFlow_.getUniqueVariables(vertexFlowGraphs_);
+        variableIndex_ = State::numberVariables(variableList_);
         vlistInitialized_ = true;
         results_.clear();
         mlog[WHERE] <<"vertexFlowGraphs set by user with " <<StringUtility::plural(variableList_.size(), "variables") <<"\n";
@@ -249,7 +331,7 @@ public:
     StatePtr stateInstance(Taintedness taint) const {
         ASSERT_this();
         ASSERT_require2(vlistInitialized_, "TaintedFlow::computeFlowGraphs must be called before TaintedFlow::stateInstance");
-        return State::instance(variableList_, taint);
+        return State::instance(variableIndex_, taint);
     }
 
     /** Run data flow.
@@ -37,9 +37,31 @@ public:
          *  specified size. */
         Sawyer::Optional<rose_addr_t> allocateMemoryArray;
 
+        /** Copy registers into local variables.  Normally the generated code operates directly on the global register
+         *  variables, which the C compiler must load and store around every access.  When this setting is enabled, each
+         *  generated function copies the registers it uses into local variables when it's entered, operates on those, and
+         *  copies them back to the globals around each function call and when it returns. */
+        bool promoteRegisters;
+
+        /** Store each flag in its own variable.  Without this setting an instruction that sets a flag reads and writes the
+         *  whole flags register. See @ref InstructionSemantics2::SourceAstSemantics::RiscOperators::splitFlags. */
+        bool splitFlags;
+
+        /** Omit dead register assignments.  An assignment to a register is omitted when a later instruction of the same basic
+         *  block assigns to the same register and no instruction in between reads it.  Together with @ref splitFlags this
+         *  means most flags are computed only when they're used. */
+        bool eliminateDeadStores;
+
+        /** Branch directly between basic blocks.  Normally each basic block ends by going back to the top of its function's
+         *  loop which switches on the instruction pointer.  When this setting is enabled, a basic block whose successor is
+         *  a basic block of the same function jumps directly to that block's label when the instruction pointer is the
+         *  successor's address. The switch is still used to enter the function and for indirect branches. */
+        bool directBranches;
+
         /** Constructs the default settings. */
         Settings()
-            : traceRiscOps(false), traceInsnExecution(false), allocateMemoryArray(false) {}
+            : traceRiscOps(false), traceInsnExecution(false), allocateMemoryArray(false), promoteRegisters(false),
+              splitFlags(false), eliminateDeadStores(false), directBranches(false) {}
     };
 
     /** Exceptions thrown by this analysis. */
@@ -106,11 +128,21 @@ private:
     // Emit accumulated side effects and/or SSA. */
     void emitEffects(std::ostream&);
 
-    // Emit code for one instruction
-    void emitInstruction(SgAsmInstruction*, std::ostream&);
+    // Emit the specified side effects and/or SSA, omitting the assignments whose isDead element is set.
+    void emitEffects(const InstructionSemantics2::SourceAstSemantics::RiscOperators::SideEffects&,
+                     const std::vector<bool> &isDead, std::ostream&);
+
+    // Find which register assignments of each instruction of a basic block are overwritten before being read.
+    std::vector<std::vector<bool> >
+    findDeadStores(const std::vector<InstructionSemantics2::SourceAstSemantics::RiscOperators::SideEffects>&);
+
+    // Emit code for one instruction whose side effects have already been computed
+    void emitInstruction(SgAsmInstruction*, const InstructionSemantics2::SourceAstSemantics::RiscOperators::SideEffects&,
+                         const std::vector<bool> &isDead, std::ostream&);
 
     // Emit code for one basic block
-    void emitBasicBlock(const Partitioner2::Partitioner&, const Partitioner2::BasicBlock::Ptr&, std::ostream&);
+    void emitBasicBlock(const Partitioner2::Partitioner&, const Partitioner2::Function::Ptr&,
+                        const Partitioner2::BasicBlock::Ptr&, std::ostream&);
 
     // Emit code for one function
     void emitFunction(const Partitioner2::Partitioner&, const Partitioner2::Function::Ptr&, std::ostream&);
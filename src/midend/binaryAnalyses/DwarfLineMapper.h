@@ -64,7 +64,10 @@ public:
     void init(SgNode *ast, Direction d=BIDIRECTIONAL);
 
     /** Insert additional mapping information from an AST without first clearing existing mapping info.  Conflicts are resolved
-     *  in favor of the new information (since an address can be associated with at most one source position). */
+     *  in favor of the new information (since an address can be associated with at most one source position).
+     *
+     *  The lines are first collected from the AST, then sorted by address and coalesced so that each run of consecutive
+     *  addresses having the same source location is inserted into the address map only once. */
     void insert(SgNode *ast);
 
     /** Clear all mapping information. */
@@ -114,8 +117,10 @@ protected:
     AddressSourceMap p_addr2src;                        // Forward mapping
     mutable SourceAddressMap p_src2addr;                // Reverse mapping
     mutable bool up_to_date;                            // Is reverse mapping up-to-date?
+    std::vector<std::pair<rose_addr_t, SrcInfo> > pending; // lines found by the traversal, in traversal order
     virtual void visit(SgNode *node) ROSE_OVERRIDE;
     void update() const;                                // update p_src2addr if necessary
+    void flush();                                       // move pending lines into p_addr2src
     void init();                                        // called by constructors
 };
 
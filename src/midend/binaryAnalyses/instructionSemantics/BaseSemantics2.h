@@ -463,6 +463,28 @@ public:
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Memory allocation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Pool allocation for semantic objects.
+ *
+ *  Semantic values, memory cells, and states are small, short-lived, and allocated in large numbers, so classes that inherit
+ *  from this class allocate their objects from memory pools instead of the global allocator.  Unlike Sawyer::SmallObject,
+ *  which has one pool shared by all threads, each thread allocates from one of a number of independent pools so that
+ *  analyses running in parallel don't contend for the same lock. An object may be freed by any thread; it's returned to
+ *  the pool from which it was allocated. */
+class PooledObject {
+public:
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
+    /** Number of independent pools. Threads are assigned to pools round-robin the first time they allocate. */
+    static size_t nPools();
+};
+
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Merging states
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -530,7 +552,7 @@ typedef Sawyer::SharedPointer<class SValue> SValuePtr;
  *  Semantics value objects are allocated on the heap and reference counted.  The BaseSemantics::SValue is an abstract class
  *  that defines the interface.  See the rose::BinaryAnalysis::InstructionSemantics2 namespace for an overview of how the parts
  *  fit together.*/
-class SValue: public Sawyer::SharedObject, public Sawyer::SharedFromThis<SValue>, public Sawyer::SmallObject {
+class SValue: public Sawyer::SharedObject, public Sawyer::SharedFromThis<SValue>, public PooledObject {
 protected:
     size_t width;                               /** Width of the value in bits. Typically (not always) a power of two. */
 
@@ -737,7 +759,7 @@ typedef boost::shared_ptr<class RegisterState> RegisterStatePtr;
 /** The set of all registers and their values. RegisterState objects are allocated on the heap and reference counted.  The
  *  BaseSemantics::RegisterState is an abstract class that defines the interface.  See the
  *  rose::BinaryAnalysis::InstructionSemantics2 namespace for an overview of how the parts fit together.*/
-class RegisterState: public boost::enable_shared_from_this<RegisterState> {
+class RegisterState: public boost::enable_shared_from_this<RegisterState>, public PooledObject {
 private:
     MergerPtr merger_;
     SValuePtr protoval_;                                /**< Prototypical value for virtual constructors. */
@@ -1023,7 +1045,7 @@ typedef boost::shared_ptr<class MemoryState> MemoryStatePtr;
 /** Represents all memory in the state. MemoryState objects are allocated on the heap and reference counted.  The
  *  BaseSemantics::MemoryState is an abstract class that defines the interface.  See the
  *  rose::BinaryAnalysis::InstructionSemantics2 namespace for an overview of how the parts fit together.*/
-class MemoryState: public boost::enable_shared_from_this<MemoryState> {
+class MemoryState: public boost::enable_shared_from_this<MemoryState>, public PooledObject {
     SValuePtr addrProtoval_;                            /**< Prototypical value for addresses. */
     SValuePtr valProtoval_;                             /**< Prototypical value for values. */
     ByteOrder::Endianness byteOrder_;                   /**< Memory byte order. */
@@ -1217,33 +1239,43 @@ typedef boost::shared_ptr<class State> StatePtr;
  *  that are mostly no-ops.
  *
  *  States must be copyable objects.  Many analyses keep a copy of the machine state for each instruction or each CFG
- *  vertex.
+ *  vertex.  To make this inexpensive, copying a state shares its register and memory substates copy-on-write: the copy
+ *  takes constant time and a substate is deep-copied only when one of the states sharing it is about to modify it, which
+ *  includes reading registers or memory (reads can create new locations) and obtaining the substate with @ref
+ *  registerState or @ref memoryState.  A substate that is referenced from outside any state when the state is copied is
+ *  deep-copied immediately since it could be modified through that reference.
  *
  *  State objects are allocated on the heap and reference counted.  The BaseSemantics::State is an abstract class that defines
  *  the interface.  See the rose::BinaryAnalysis::InstructionSemantics2 namespace for an overview of how the parts fit
  *  together.  */
-class State: public boost::enable_shared_from_this<State> {
+class State: public boost::enable_shared_from_this<State>, public PooledObject {
     SValuePtr protoval_;                                // Initial value used to create additional values as needed.
-    RegisterStatePtr registers_;                        // All machine register values for this semantic state.
-    MemoryStatePtr memory_;                             // All memory for this semantic state.
+    mutable RegisterStatePtr registers_;                // All machine register values for this semantic state.
+    mutable MemoryStatePtr memory_;                     // All memory for this semantic state.
+
+    // Copy-on-write bookkeeping. All states that share a register (or memory) substate also share its token, so the token's
+    // use count is the number of states sharing the substate and any additional references to the substate itself are held
+    // by something other than a state.
+    mutable boost::shared_ptr<void> registersToken_;
+    mutable boost::shared_ptr<void> memoryToken_;
 
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
 protected:
     State(const RegisterStatePtr &registers, const MemoryStatePtr &memory)
-        : registers_(registers), memory_(memory) {
+        : registers_(registers), memory_(memory), registersToken_(newSharingToken()), memoryToken_(newSharingToken()) {
         ASSERT_not_null(registers);
         ASSERT_not_null(memory);
         protoval_ = registers->protoval();
         ASSERT_not_null(protoval_);
     }
 
-    // deep-copy the registers and memory
+    // Copy the registers and memory. Substates are shared copy-on-write unless something other than a state also refers to
+    // them, in which case they're deep-copied.
     State(const State &other)
         : protoval_(other.protoval_) {
-        registers_ = other.registers_->clone();
-        memory_ = other.memory_->clone();
+        copySubstates(other);
     }
 
 public:
@@ -1274,9 +1306,9 @@ public:
         return instance(registers, memory);
     }
 
-    /** Virtual copy constructor. Allocates a new state object which is a deep copy of this state. States must be copyable
-     *  objects because many analyses depend on being able to make a copy of the entire semantic state at each machine
-     *  instruction, at each CFG vertex, etc. */
+    /** Virtual copy constructor. Allocates a new state object which behaves as a deep copy of this state, although the
+     *  substates are shared copy-on-write. States must be copyable objects because many analyses depend on being able to make
+     *  a copy of the entire semantic state at each machine instruction, at each CFG vertex, etc. */
     virtual StatePtr clone() const {
         StatePtr self = boost::const_pointer_cast<State>(shared_from_this());
         return instance(self);
@@ -1316,8 +1348,10 @@ public:
 
     /** Property: Register state.
      *
-     *  This read-only property is the register substate of this whole state. */
+     *  This read-only property is the register substate of this whole state.  If the substate was shared with a copy of this
+     *  state then a private copy is made first, so the returned substate can be modified without affecting other states. */
     RegisterStatePtr registerState() const {
+        unshareRegisters();
         return registers_;
     }
 
@@ -1328,8 +1362,10 @@ public:
 
     /** Property: Memory state.
      *
-     *  This read-only property is the memory substate of this whole state. */
+     *  This read-only property is the memory substate of this whole state. As with @ref registerState, a shared substate is
+     *  copied before it's returned. */
     MemoryStatePtr memoryState() const {
+        unshareMemory();
         return memory_;
     }
 
@@ -1431,8 +1467,21 @@ public:
      *
      *  Merges the @p other state into this state. Returns true if this state changed, false otherwise.  This method usually
      *  isn't overridden in subclasses since all the base implementation does is invoke the merge operation on the memory state
-     *  and register state. */
+     *  and register state. Substates that this state shares with @p other are already equal and are not merged. */
     virtual bool merge(const StatePtr &other, RiscOperators *ops);
+
+    /** Whether substates are shared with other states.
+     *
+     *  Returns true if the register or memory substate is currently shared copy-on-write with some other state. */
+    bool isSharingSubstates() const {
+        return registersToken_.use_count() > 1 || memoryToken_.use_count() > 1;
+    }
+
+private:
+    static boost::shared_ptr<void> newSharingToken();
+    void copySubstates(const State &other);
+    void unshareRegisters() const;
+    void unshareMemory() const;
 };
 
 
@@ -2160,6 +2209,30 @@ protected:
     typedef std::vector<InsnProcessor*> InsnProcessors;
     InsnProcessors iproc_table;
 
+public:
+    /** Dispatch information resolved for one instruction.
+     *
+     *  The dispatcher remembers the instruction processor of the most recently processed instructions, keyed by instruction
+     *  identity, so that processing the same instruction again (in loops, or while iterating a data-flow analysis to a fixed
+     *  point) skips the work that depends only on the instruction.  An entry is valid only if the instruction pointer,
+     *  address, and encoding all match since instructions can be deleted and their memory reused.  The @ref flags are
+     *  available to subclasses for recording per-instruction checks that have already been done (see @ref resolvedFlags). */
+    struct ResolvedInstruction {
+        static const size_t maxBytes = 16;              /**< Longest encoding that's cached. */
+        SgAsmInstruction *insn;                         /**< Instruction, or null for an unused entry. */
+        rose_addr_t address;                            /**< Address of the instruction. */
+        size_t nBytes;                                  /**< Size of the encoding. */
+        uint8_t bytes[maxBytes];                        /**< Encoding of the instruction. */
+        InsnProcessor *iproc;                           /**< Instruction processor from @ref iproc_lookup. */
+        unsigned flags;                                 /**< Subclass-defined bits, cleared when the entry is filled. */
+
+        ResolvedInstruction(): insn(NULL), address(0), nBytes(0), iproc(NULL), flags(0) {}
+    };
+
+protected:
+    typedef std::vector<ResolvedInstruction> ResolvedInstructions;
+    ResolvedInstructions resolved_;                     // direct-mapped by instruction pointer, allocated on first use
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
 protected:
@@ -2226,6 +2299,29 @@ public:
     /** Obtain an iproc table entry for the specified key. */
     virtual InsnProcessor *iproc_get(int key);
 
+    /** Resolved dispatch information for an instruction.
+     *
+     *  Returns the cache entry for the instruction, filling it with a fresh @ref iproc_lookup (and clearing its flags) if it
+     *  was for some other instruction, or if the instruction changed since the entry was filled.  The entry is valid until
+     *  the next call for another instruction.  Instructions whose encodings are too long are resolved every time. */
+    virtual const ResolvedInstruction& resolveInstruction(SgAsmInstruction*);
+
+    /** Property: Resolved flags of an instruction.
+     *
+     *  Subclass-defined bits recorded for an instruction that was resolved by @ref resolveInstruction, such as checks of its
+     *  operands that were already done.  The getter returns zero if the instruction is not in the cache, and the setter
+     *  (which adds to the existing bits) does nothing in that case.
+     *
+     * @{ */
+    unsigned resolvedFlags(SgAsmInstruction*) const;
+    void resolvedFlags(SgAsmInstruction*, unsigned flags);
+    /** @} */
+
+    /** Forget all resolved instructions.
+     *
+     *  This happens automatically when the instruction processor table or the register dictionary changes. */
+    void clearResolvedInstructions() { resolved_.clear(); }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Convenience methods that defer the call to some member object
 public:
@@ -2297,6 +2393,7 @@ public:
     }
     virtual void set_register_dictionary(const RegisterDictionary *regdict) {
         this->regdict = regdict;
+        clearResolvedInstructions();
     }
     /** @} */
 
@@ -278,6 +278,16 @@ public:
      *  is already allocated unless: it will replace the allocated page with a new one containing all zeros. */
     void allocatePage(rose_addr_t va);
 
+    /** Read or write bytes directly.
+     *
+     *  These are the same as reading or writing one byte at a time through the RISC operators, including allocating pages
+     *  that don't exist yet (their bytes read as zero), but without creating any semantic values. They're intended for
+     *  fast emulators that keep values in native form.
+     *
+     * @{ */
+    void readBytes(rose_addr_t va, uint8_t *buffer, size_t nBytes);
+    void writeBytes(rose_addr_t va, const uint8_t *buffer, size_t nBytes);
+    /** @} */
 };
 
 
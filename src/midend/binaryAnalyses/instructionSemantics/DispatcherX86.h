@@ -123,6 +123,11 @@ public:
     void processorMode(X86InstructionSize m) { processorMode_ = m; }
     /** @} */
 
+    /** Bits recorded for resolved instructions. See @ref BaseSemantics::Dispatcher::resolvedFlags. */
+    enum ResolvedFlag {
+        OPERAND_WIDTHS_CHECKED  = 0x0001                /**< Operands wider than 32 bits use registers of the dictionary. */
+    };
+
     virtual void set_register_dictionary(const RegisterDictionary *regdict) ROSE_OVERRIDE;
 
     /** Get list of common registers. Returns a list of non-overlapping registers composed of the largest registers except
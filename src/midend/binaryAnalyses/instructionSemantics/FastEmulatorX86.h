@@ -0,0 +1,140 @@
+#ifndef ROSE_BinaryAnalysis_InstructionSemantics2_FastEmulatorX86_H
+#define ROSE_BinaryAnalysis_InstructionSemantics2_FastEmulatorX86_H
+
+#include <ConcreteSemantics2.h>
+#include <DispatcherX86.h>
+
+#include <boost/unordered_map.hpp>
+
+namespace rose {
+namespace BinaryAnalysis {
+
+class Disassembler;
+
+namespace InstructionSemantics2 {
+namespace ConcreteSemantics {
+
+/** Fast concrete emulation of x86 instructions.
+ *
+ *  Emulating with @ref ConcreteSemantics and @ref DispatcherX86 creates semantic values for every operand and goes through
+ *  the general instruction dispatch for every instruction. This emulator translates each basic block once, the first time
+ *  it's executed, into an array of pre-decoded operations that work on native integers, and keeps the translation in a
+ *  cache indexed by the block's starting address.  The general-purpose registers, instruction pointer, and the status flags
+ *  CF, PF, AF, ZF, SF, and OF are held natively while translated code runs.
+ *
+ *  Only the most common integer instructions are translated (data movement, integer add/subtract/compare, logical
+ *  operations, stack operations, and control transfers); all others, and any instruction whose operands are not
+ *  general-purpose registers, immediates, or simple memory references, fall back to the dispatcher.  The native registers are
+ *  written to the dispatcher's state before such an instruction and read back afterward, so the fast and slow paths can be
+ *  freely intermixed and the state seen by the dispatcher is always correct.  The translated operations produce the same
+ *  results as the dispatcher's semantics, including the value zero for flags that the x86 semantics leaves unspecified.
+ *
+ *  Since translated operations don't go through the RISC operators, they don't invoke RiscOperators::startInstruction,
+ *  filterCallTarget, or similar hooks, and user-defined instruction processors registered with the dispatcher are only used
+ *  for instructions that fall back to the dispatcher.  This emulator should therefore be used only with plain @ref
+ *  ConcreteSemantics::RiscOperators. The translation cache is not updated when a program writes to its own instructions or
+ *  the memory map is changed; call @ref invalidate in those cases.
+ *
+ *  @code
+ *   DispatcherX86Ptr dispatcher = DispatcherX86::instance(ConcreteSemantics::RiscOperators::instance(regdict), 64, regdict);
+ *   ConcreteSemantics::MemoryState::promote(dispatcher->currentState()->memoryState())->memoryMap(specimen);
+ *   dispatcher->get_operators()->writeRegister(dispatcher->REG_anyIP, ...);
+ *   ConcreteSemantics::FastEmulatorX86 emulator(dispatcher, disassembler);
+ *   emulator.run(1000000);
+ *  @endcode */
+class FastEmulatorX86 {
+public:
+    /** Emulation statistics. */
+    struct Statistics {
+        size_t nFastInsns;                              /**< Instructions executed by translated operations. */
+        size_t nSlowInsns;                              /**< Instructions executed by the dispatcher. */
+        size_t nBlocksTranslated;                       /**< Basic blocks translated. */
+        size_t nBlocksExecuted;                         /**< Basic blocks executed, including partial executions. */
+        Statistics(): nFastInsns(0), nSlowInsns(0), nBlocksTranslated(0), nBlocksExecuted(0) {}
+    };
+
+private:
+    struct Exec;
+    struct Operand;
+    struct Op;
+    struct Block;
+    typedef boost::unordered_map<rose_addr_t, Block*> Blocks;
+
+    DispatcherX86Ptr dispatcher_;
+    RiscOperatorsPtr ops_;
+    Disassembler *disassembler_;
+    Blocks blocks_;                                     // translated blocks indexed by starting address
+    size_t maxBlockSize_;                               // maximum number of instructions per translated block
+    Statistics stats_;
+
+    // Native copy of the registers, valid only while run() is executing translated code.
+    size_t wordBits_;                                   // width of the instruction pointer and general-purpose registers
+    size_t addrBits_;                                   // width of memory addresses
+    size_t nGprs_;                                      // number of general-purpose registers in the dictionary
+    uint64_t gpr_[16];
+    uint64_t ip_;
+    bool cf_, pf_, af_, zf_, sf_, of_;
+    bool nativeValid_;                                  // true if the native registers are newer than the state
+    MemoryState *mem_;                                  // memory state while run() is executing
+
+public:
+    /** Construct an emulator.
+     *
+     *  The dispatcher must use @ref ConcreteSemantics::RiscOperators, and its current state is the state that's emulated.
+     *  The disassembler is used to decode instructions from the state's memory. Neither is owned by the emulator. */
+    FastEmulatorX86(const DispatcherX86Ptr &dispatcher, Disassembler *disassembler);
+
+    ~FastEmulatorX86();
+
+    /** Dispatcher used for instructions that are not translated. */
+    DispatcherX86Ptr dispatcher() const { return dispatcher_; }
+
+    /** Maximum number of instructions in a translated block.
+     *
+     * @{ */
+    size_t maxBlockSize() const { return maxBlockSize_; }
+    void maxBlockSize(size_t n) { maxBlockSize_ = std::max(n, (size_t)1); }
+    /** @} */
+
+    /** Emulate instructions.
+     *
+     *  Emulates up to @p maxInsns instructions starting at the state's current instruction pointer and returns the number
+     *  emulated. The state is up to date when this returns or throws. Exceptions from the disassembler (e.g., when the
+     *  instruction pointer leaves mapped memory) and from the dispatcher are passed to the caller. */
+    size_t run(size_t maxInsns);
+
+    /** Discard all translated blocks. */
+    void invalidate();
+
+    /** Number of translated blocks in the cache. */
+    size_t nBlocks() const { return blocks_.size(); }
+
+    /** Emulation statistics.
+     *
+     * @{ */
+    const Statistics& statistics() const { return stats_; }
+    void resetStatistics() { stats_ = Statistics(); }
+    /** @} */
+
+private:
+    // not copyable
+    FastEmulatorX86(const FastEmulatorX86&);
+    FastEmulatorX86& operator=(const FastEmulatorX86&);
+
+    RegisterDescriptor gprRegister(size_t i) const;
+    void loadRegisters();
+    void storeRegisters();
+    Block* translate(rose_addr_t va);
+    bool translateInstruction(SgAsmX86Instruction*, Op&);
+    bool translateOperand(SgAsmExpression*, rose_addr_t nextVa, Operand&);
+    bool translateAddress(SgAsmExpression*, rose_addr_t nextVa, Operand&);
+    uint64_t readMemory(uint64_t va, size_t nBits);
+    void writeMemory(uint64_t va, uint64_t value, size_t nBits);
+};
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#endif
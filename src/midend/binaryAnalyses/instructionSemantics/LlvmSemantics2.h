@@ -6,6 +6,13 @@
 
 namespace rose {
 namespace BinaryAnalysis {
+
+// Forwards
+namespace Partitioner2 {
+    class Partitioner;
+    class Function;
+}
+
 namespace InstructionSemantics2 {
 
 /** A semantic domain to generate LLVM. */
@@ -202,6 +209,10 @@ public:
      *  LLVM definition, then the empty string is returned. */
     virtual std::string get_variable(const LeafPtr&);
 
+    /** Bind a ROSE variable to an LLVM name.  The name includes the sigil and is defined by the caller, such as a phi node
+     *  that begins a basic block.  The variable must not already have an LLVM name. */
+    virtual void bind_variable(const LeafPtr&, const std::string &name);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // New methods to emit the machine state
 public:
@@ -211,6 +222,12 @@ public:
     /** Output LLVM global register definitions for the specified registers. */
     virtual void emit_register_definitions(std::ostream&, const RegisterDescriptors&);
 
+    /** Output LLVM for the values of the specified registers.  The value of each register is emitted and then replaced in
+     *  the current state by the resulting LLVM term (a constant or variable), so the registers no longer depend on pending
+     *  memory reads. This is used before emitting memory writes when registers are kept in LLVM variables rather than being
+     *  stored to their global variables after each instruction. */
+    virtual void emit_register_values(std::ostream&, const RegisterDescriptors&);
+
     /** Output LLVM global variable reads that are needed to define the specified registers and pending memory writes.  Since
      *  registers are stored in global variables and we routinely emit more than one register definition at a time, we need to
      *  first make sure that any global prerequisites for the definitions are saved in temporaries.  This is to handle cases
@@ -255,6 +272,10 @@ public:
     /** Obtain the LLVM type name for an integer. */
     virtual std::string llvm_integer_type(size_t nbits);
 
+    /** Obtain the right hand side of an LLVM load instruction.  Returns a "load" instruction that reads an @p nbits wide
+     *  integer through @p pointer (an LLVM term, including its sigil) in the dialect selected by @ref llvmVersion. */
+    virtual std::string llvm_load(size_t nbits, const std::string &pointer);
+
     /** Convert a ROSE variable or integer to an LLVM term. A term must be a constant or a variable reference (rvalue). */
     virtual std::string llvm_term(const ExpressionPtr&);
 
@@ -271,8 +292,11 @@ public:
     /** Obtain a label for a virtual address. */
     virtual std::string addr_label(rose_addr_t);
 
-    /** Obtain a label for a function. */
+    /** Obtain a label for a function.
+     * @{ */
     virtual std::string function_label(SgAsmFunction*);
+    virtual std::string function_label(rose_addr_t entry_va, const std::string &name);
+    /** @} */
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // New methods to emit LLVM code for an expression.
@@ -351,6 +375,8 @@ typedef boost::shared_ptr<class Transcoder> TranscoderPtr;
 /** Translates machine instructions to LLVM. */
 class Transcoder {
 private:
+    struct FunctionLowering;                            // state for transcoding one function from a partitioner CFG
+
     RiscOperatorsPtr operators;
     BaseSemantics::DispatcherPtr dispatcher;
     bool emit_funcfrags;                                // emit BBs that aren't part of the CFG?
@@ -446,6 +472,54 @@ public:
     void transcodeInterpretation(SgAsmInterpretation*, std::ostream&);
     std::string transcodeInterpretation(SgAsmInterpretation*);
     /** @} */
+
+    /** Transcode a function using a partitioner's control flow graph.
+     *
+     *  Unlike the AST-based @ref transcodeFunction, the registers are not stored to their global variables after each
+     *  instruction. Instead, each register is an LLVM SSA value within the function: basic blocks begin with phi nodes that
+     *  merge the register values from their CFG predecessors, and the globals are read only on function entry and after
+     *  calls and written only before calls and returns.  Memory writes are emitted in program order.  This produces far
+     *  fewer LLVM instructions and gives LLVM's optimizer code that it can promote and simplify.
+     *
+     *  Intra-function control flow follows the CFG edges: unconditional branches, conditional branches whose instruction
+     *  pointer is an if-then-else of two successors, and a "switch" over the successors otherwise. Function calls become
+     *  LLVM calls of the callee (indirectly through the instruction pointer if the callee is not known) followed by a branch
+     *  to the call-return successor, and function returns become "ret".  Calls refer to other functions by @ref
+     *  RiscOperators::function_label, which are all defined when using @ref transcodeModule.
+     *
+     *  Each basic block is generated into its own buffer and the function is written to the stream in one piece once its
+     *  phi nodes are known.  Returns the number of basic blocks emitted.
+     *
+     * @{ */
+    size_t transcodeFunction(const Partitioner2::Partitioner&, const Sawyer::SharedPointer<Partitioner2::Function>&,
+                             std::ostream&);
+    std::string transcodeFunction(const Partitioner2::Partitioner&, const Sawyer::SharedPointer<Partitioner2::Function>&);
+    /** @} */
+
+    /** Transcode all functions of a partitioner to a single LLVM module.
+     *
+     *  The module contains the @ref emitFilePrologue declarations followed by a definition for each function as produced by
+     *  @ref transcodeFunction(const Partitioner2::Partitioner&, const Sawyer::SharedPointer<Partitioner2::Function>&,
+     *  std::ostream&), and is suitable as input to LLVM's "opt" and "llc" tools.
+     *
+     * @{ */
+    void transcodeModule(const Partitioner2::Partitioner&, std::ostream&);
+    std::string transcodeModule(const Partitioner2::Partitioner&);
+    /** @} */
+
+private:
+    // Bind the merged registers to the LLVM variables defined by the phi nodes (or loads) at the start of a block.
+    void bindBlockRegisters(FunctionLowering&, const std::string &label);
+
+    // Set the merged registers from their global variables.
+    void loadRegisters(FunctionLowering&, std::ostream&);
+
+    // Record an LLVM control flow edge with the current register values for the target block's phi nodes.
+    void addIncoming(FunctionLowering&, const std::string &fromLabel, rose_addr_t targetVa);
+
+    // Transcode one basic block into its buffer, including the terminator.
+    void lowerBasicBlock(const Partitioner2::Partitioner&, const Sawyer::SharedPointer<Partitioner2::Function>&,
+                         size_t blockIdx, FunctionLowering&);
 };
 
 } // namespace
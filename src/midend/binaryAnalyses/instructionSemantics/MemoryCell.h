@@ -9,7 +9,7 @@ namespace InstructionSemantics2 {
 namespace BaseSemantics {
 
 /** Shared-ownership pointer to a semantic memory cell. See @ref heap_object_shared_ownership. */
-typedef boost::shared_ptr<class MemoryCell> MemoryCellPtr;
+typedef Sawyer::SharedPointer<class MemoryCell> MemoryCellPtr;
 
 /** Represents one location in memory.
  *
@@ -18,7 +18,7 @@ typedef boost::shared_ptr<class MemoryCell> MemoryCellPtr;
  *  the @ref RiscOperators separately from updating cell addresses and values and according to settings in the
  *  RiscOperators. Cells written to by RiscOperators typically contain one writer address since each write operation creates a
  *  new cell; however, the result of a dataflow merge operation might produce cells that have multiple writers. */
-class MemoryCell: public boost::enable_shared_from_this<MemoryCell> {
+class MemoryCell: public Sawyer::SharedObject, public Sawyer::SharedFromThis<MemoryCell>, public PooledObject {
 public:
     typedef Sawyer::Container::Set<rose_addr_t> AddressSet; /**< A set of concrete virtual addresses. */
 
@@ -258,7 +258,7 @@ public:
      *  std::cout <<"The value is: " <<(*obj+fmt) <<"\n";
      * @endcode
      * @{ */
-    WithFormatter with_format(Formatter &fmt) { return WithFormatter(shared_from_this(), fmt); }
+    WithFormatter with_format(Formatter &fmt) { return WithFormatter(sharedFromThis(), fmt); }
     WithFormatter operator+(Formatter &fmt) { return with_format(fmt); }
     /** @} */
 };
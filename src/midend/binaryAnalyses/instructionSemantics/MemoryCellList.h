@@ -29,7 +29,12 @@ typedef boost::shared_ptr<class MemoryCellList> MemoryCellListPtr;
  *  for users to define their own subclasses and use them in the semantic framework.
  *
  *  This implementation stores memory cells in reverse chronological order: the most recently created cells appear at the
- *  beginning of the list.  Subclasses, of course, are free to reorder the list however they want. */
+ *  beginning of the list.  Subclasses, of course, are free to reorder the list however they want.
+ *
+ *  Copies of a cell list share the cells themselves, so copying a memory state copies only the list of pointers.  Cells
+ *  that are modified in place, such as by updating their I/O properties when they're read or by @ref traverse, are first
+ *  replaced by a private copy if some other state also refers to them.  Code that modifies cells obtained from @ref
+ *  get_cells or @ref matchingCells must do the same. */
 class MemoryCellList: public MemoryCellState {
 public:
     typedef std::list<MemoryCellPtr> CellList;          /**< List of memory cells. */
@@ -47,12 +52,10 @@ protected:
     MemoryCellList(const SValuePtr &addrProtoval, const SValuePtr &valProtoval)
         : MemoryCellState(addrProtoval, valProtoval), occlusionsErased_(false) {}
 
-    // deep-copy cell list so that modifying this new state does not modify the existing state
+    // The copy shares the cells with the original. A cell that's referenced by more than one state is copied before it's
+    // modified (see unshareCell), so modifying this new state does not modify the existing state.
     MemoryCellList(const MemoryCellList &other)
-        : MemoryCellState(other), occlusionsErased_(other.occlusionsErased_) {
-        for (CellList::const_iterator ci=other.cells.begin(); ci!=other.cells.end(); ++ci)
-            cells.push_back((*ci)->clone());
-    }
+        : MemoryCellState(other), cells(other.cells), occlusionsErased_(other.occlusionsErased_) {}
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Static allocating constructors
@@ -157,6 +160,9 @@ public:
      *  cursor and ends either when an exact alias is found or the end of the list is reached. In either case, the cell that
      *  caused the scan to terminate is returned--either the exact alias or the end iterator.
      *
+     *  When scanning for one-byte values, one-byte cells whose addresses are rejected by @ref addressesDisjoint are skipped
+     *  without evaluating the aliasing predicates, which might otherwise invoke an SMT solver for each cell.
+     *
      *  Typical usage is like this:
      *
      * @code
@@ -172,6 +178,8 @@ public:
         CellList retval;
         MemoryCellPtr tempCell = protocell->create(addr, valOps->undefined_(nBits));
         for (/*void*/; cursor!=cells.end(); ++cursor) {
+            if (8 == nBits && 8 == (*cursor)->get_value()->get_width() && addressesDisjoint(addr, (*cursor)->get_address()))
+                continue;
             if (tempCell->may_alias(*cursor, addrOps)) {
                 retval.push_back(*cursor);
                 if (tempCell->must_alias(*cursor, addrOps))
@@ -181,6 +189,16 @@ public:
         return retval;
     }
 
+    /** Inexpensive test for distinct byte addresses.
+     *
+     *  Returns true if one-byte cells at the two addresses cannot alias each other, as determined without an SMT solver and
+     *  without building new values. A false return means only that the addresses might be equal. This is used by @ref scan to
+     *  skip cells before evaluating the more expensive aliasing predicates, so an implementation must never return true for
+     *  addresses that MemoryCell::may_alias would consider aliases.  The base implementation recognizes distinct concrete
+     *  addresses; subclasses for symbolic domains also recognize addresses that are the same expression plus different
+     *  constants, such as stack locations relative to the same stack pointer value. */
+    virtual bool addressesDisjoint(const SValuePtr &a, const SValuePtr &b) const;
+
     // [Robb P. Matzke 2015-08-18]: deprecated
     virtual CellList scan(const SValuePtr &address, size_t nbits, RiscOperators *addrOps, RiscOperators *valOps,
                           bool &short_circuited/*out*/) const ROSE_DEPRECATED("use the cursor-based scan instead");
@@ -223,6 +241,11 @@ protected:
     // may also add READ_AFTER_WRITE, READ_BEFORE_WRITE, and/or READ_UNINITIALIZED.
     virtual void updateReadProperties(CellList &cells);
 
+    // Make a cell private to this state before modifying it in place. If the cell has more references than the @p nKnownRefs
+    // held by this state's list and the caller (and the latest written cell pointer), then it might be shared with other
+    // states and is replaced, both in the list and in @p cell, by a copy.
+    void unshareCell(MemoryCellPtr &cell /*in,out*/, size_t nKnownRefs);
+
     // Insert a new cell at the head of the list. It's writers set is empty and its I/O properties will be READ,
     // READ_BEFORE_WRITE, and READ_UNINITIALIZED.
     virtual MemoryCellPtr insertReadCell(const SValuePtr &addr, const SValuePtr &value);
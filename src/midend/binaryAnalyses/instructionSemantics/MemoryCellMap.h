@@ -41,11 +41,10 @@ protected:
     MemoryCellMap(const SValuePtr &addrProtoval, const SValuePtr &valProtoval)
         : MemoryCellState(addrProtoval, valProtoval) {}
 
+    // The copy shares the cells with the original. Cells are never modified in place except by traverse, which first copies
+    // any cell that's shared with another state.
     MemoryCellMap(const MemoryCellMap &other)
-        : MemoryCellState(other) {
-        BOOST_FOREACH (const MemoryCellPtr &cell, other.cells.values())
-            cells.insert(other.generateCellKey(cell->get_address()), cell->clone());
-    }
+        : MemoryCellState(other), cells(other.cells) {}
 
 private:
     MemoryCellMap& operator=(MemoryCellMap&) /*delete*/;
@@ -243,18 +243,20 @@ protected:
     Subdomains subdomains;
     std::vector<bool> active;
     Formatter formatter;                // contains names for the subdomains
+    std::vector<size_t> dispatch;       // sorted indices of active subdomains, see active_subdomains()
+    bool dispatch_is_current;           // false if dispatch needs to be recomputed
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
 protected:
     explicit RiscOperators(const BaseSemantics::SValuePtr &protoval, SMTSolver *solver=NULL)
-        : BaseSemantics::RiscOperators(protoval, solver) {
+        : BaseSemantics::RiscOperators(protoval, solver), dispatch_is_current(false) {
         name("Multi");
         (void) SValue::promote(protoval); // check that its dynamic type is a MultiSemantics::SValue
     }
 
     explicit RiscOperators(const BaseSemantics::StatePtr &state, SMTSolver *solver=NULL)
-        : BaseSemantics::RiscOperators(state, solver) {
+        : BaseSemantics::RiscOperators(state, solver), dispatch_is_current(false) {
         name("Multi");
         (void) SValue::promote(state->protoval());      // dynamic type must be a MultiSemantics::SValue
     }
@@ -337,6 +339,17 @@ public:
      *  subdomain when activating. */
     virtual void set_active(size_t idx, bool status);
 
+    /** Indices of the active subdomains.  RISC operations dispatch to these subdomains (those whose inputs are valid) instead
+     *  of testing every subdomain with is_active() on every operation.  The list is computed from is_active() when needed and
+     *  is recomputed at the start of each instruction and whenever a subdomain is added, activated, or deactivated.  A
+     *  subclass whose is_active() depends on something else should call invalidate_dispatch() when that changes. */
+    const std::vector<size_t>& active_subdomains(); // hot
+
+    /** Causes the list of active subdomains to be recomputed before the next RISC operation.  See active_subdomains(). */
+    void invalidate_dispatch() {
+        dispatch_is_current = false;
+    }
+
     /** Called before each subdomain RISC operation.  The default implementation does nothing, but subclasses can override this
      *  to do interesting things. The @p idx is the index of the subdomain that's about to be called. */
     virtual void before(size_t idx) {}
@@ -368,24 +381,40 @@ public:
     class Cursor {
     public:
         typedef std::vector<SValuePtr> Inputs;
+
+        /** Zero to three multidomain inputs.  This is like Inputs, but it doesn't allocate or adjust reference counts, so it's
+         *  what the SUBDOMAINS macro uses. The referenced values must outlive the cursor. */
+        struct Args {
+            const SValue *values[3];
+            size_t nvalues;
+            explicit Args(const BaseSemantics::SValuePtr &arg1=BaseSemantics::SValuePtr(),
+                          const BaseSemantics::SValuePtr &arg2=BaseSemantics::SValuePtr(),
+                          const BaseSemantics::SValuePtr &arg3=BaseSemantics::SValuePtr());
+        };
+
     protected:
         RiscOperators *ops_;
-        Inputs inputs_;
+        Inputs owned_inputs_;                   // inputs when constructed from an Inputs vector
+        const SValue *inputs_[3];               // the inputs tested by inputs_are_valid()
+        size_t ninputs_;
         size_t idx_;
     public:
         Cursor(RiscOperators *ops, const SValuePtr &arg1=SValuePtr(), const SValuePtr &arg2=SValuePtr(),
                const SValuePtr &arg3=SValuePtr())
-            : ops_(ops), idx_(0) {
+            : ops_(ops), ninputs_(0), idx_(0) {
             init(arg1, arg2, arg3);
         }
         Cursor(RiscOperators *ops, const Inputs &inputs)
-            : ops_(ops), inputs_(inputs), idx_(0) {
-            init();
+            : ops_(ops), owned_inputs_(inputs), ninputs_(0), idx_(0) {
+            init(owned_inputs_);
+        }
+        Cursor(RiscOperators *ops, const Args &args)
+            : ops_(ops), ninputs_(0), idx_(0) {
+            init(args);
         }
 
-        /** Class method to construct the array of inputs from a variable number of arguments.  This is used only by the
-         *  SUBDOMAINS macro in the MultiSemantics source code so that the input values can be passed as a parenthesized
-         *  group as the macro's second argument. */
+        /** Class method to construct the array of inputs from a variable number of arguments.  The SUBDOMAINS macro in the
+         *  MultiSemantics source code used to call this; it now uses Args, which doesn't allocate. */
         static Inputs inputs(const BaseSemantics::SValuePtr &arg1=BaseSemantics::SValuePtr(),
                              const BaseSemantics::SValuePtr &arg2=BaseSemantics::SValuePtr(),
                              const BaseSemantics::SValuePtr &arg3=BaseSemantics::SValuePtr());
@@ -393,7 +422,7 @@ public:
         bool at_end() const;                    /**< Returns true when the cursor has gone past the last valid subdomain. */
         void next();                            /**< Advance to the next valid subdomain. */
         size_t idx() const;                     /**< Return the subdomain index for the current cursor position. */
-        BaseSemantics::RiscOperatorsPtr operator->() const;   /**< Return the subdomain for the current cursor position. */
+        BaseSemantics::RiscOperators* operator->() const;     /**< Return the subdomain for the current cursor position. */
         BaseSemantics::RiscOperatorsPtr operator*() const;    /**< Return the subdomain for the current cursor position. */
 
         /** Returns subdomain value of its multidomain argument. */
@@ -401,6 +430,8 @@ public:
 
     protected:
         void init(const SValuePtr &arg1, const SValuePtr &arg2, const SValuePtr &arg3);
+        void init(const Inputs&);
+        void init(const Args&);
         void init();
         void skip_invalid();
         bool inputs_are_valid() const;
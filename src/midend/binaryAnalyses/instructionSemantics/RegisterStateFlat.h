@@ -0,0 +1,226 @@
+#ifndef ROSE_BinaryAnalysis_InstructionSemantics2_RegisterStateFlat_H
+#define ROSE_BinaryAnalysis_InstructionSemantics2_RegisterStateFlat_H
+
+#include <BaseSemantics2.h>
+
+namespace rose {
+namespace BinaryAnalysis {
+namespace InstructionSemantics2 {
+namespace BaseSemantics {
+
+/** Shared-ownership pointer to flat register states. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<class RegisterStateFlat> RegisterStateFlatPtr;
+
+/** A RegisterState with flat storage for a fixed register dictionary.
+ *
+ *  When the state is first instantiated, the register dictionary is split into slots: one slot for each range of bits
+ *  that no register boundary crosses.  For instance, the x86-64 RAX, EAX, AX, AH, and AL registers produce four slots for
+ *  bits 0-7, 8-15, 16-31, and 32-63 of the same storage. The slots are numbered densely and the values live in a single
+ *  vector indexed by slot number, so finding the storage for a register is a table lookup and copying or merging two
+ *  states is a linear pass over two vectors.  The slot layout is computed once and shared by all states created from that
+ *  state by @ref create (with the same dictionary) or @ref clone.
+ *
+ *  Each slot points to a value and remembers which bit of the register corresponds to bit zero of that value. Writing a
+ *  register makes all its slots point to the written value without extracting the parts, and reading the register returns
+ *  that same value as long as it still covers the register exactly, so the common case of reading and writing whole
+ *  registers performs no RISC operations.  Reads that cover parts of different values are extracted and concatenated
+ *  like in @ref RegisterStateGeneric.
+ *
+ *  Unlike @ref RegisterStateGeneric, this state does not store writer sets or I/O properties, and it can only store
+ *  registers whose major/minor numbers appear in the dictionary. Reading a register that was never written stores a copy
+ *  of the default value, as @ref RegisterStateGeneric does when its @c accessCreatesLocations property is set.
+ *
+ *  No semantic domain or analysis uses this state by default.  The data-flow based analyses (stack delta, calling
+ *  convention, pointer detection, Partitioner2 data-flow) promote their register states to @ref RegisterStateGeneric for
+ *  its writer sets and I/O properties, so this state is only for analyses that need neither; they choose it by passing a
+ *  RegisterStateFlat when they construct their semantic state. */
+class RegisterStateFlat: public RegisterState {
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Basic Types
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Value stored in one slot.
+     *
+     *  The slot's bits are bits <code>slotOffset-base</code> through <code>slotOffset-base+slotSize-1</code> of the @ref
+     *  value, where @c slotOffset and @c slotSize come from the layout. A null value means the slot has not been accessed. */
+    struct Slot {
+        SValuePtr value;                                // value containing this slot's bits, or null
+        size_t base;                                    // register bit number corresponding to bit zero of value
+
+        Slot(): base(0) {}
+        Slot(const SValuePtr &value, size_t base): value(value), base(base) {}
+
+        /** True if two slots refer to the same bits of the same value. */
+        bool isSame(const Slot &other) const {
+            return value == other.value && (!value || base == other.base);
+        }
+    };
+
+    /** Slot numbering for a register dictionary.
+     *
+     *  This is computed when a state is instantiated and is shared by all states created from that state. */
+    struct Layout {
+        /** The slots for one major/minor pair. */
+        struct Storage {
+            unsigned majr, minr;                        // register major and minor numbers
+            size_t firstSlot;                           // index of first slot in the flat arrays
+            size_t nSlots;                              // number of contiguous slots for this storage
+            std::vector<size_t> bounds;                 // nSlots+1 bit offsets; slot i is [bounds[i], bounds[i+1])
+        };
+
+        static const size_t NO_STORAGE = (size_t)(-1);
+
+        const RegisterDictionary *regdict;              // dictionary from which the layout was computed
+        std::vector<Storage> storages;                  // one per major/minor pair, sorted by major then minor
+        std::vector<std::vector<size_t> > index;        // [major][minor] -> storages index, or NO_STORAGE
+        std::vector<size_t> slotOffset;                 // first bit of each slot
+        std::vector<size_t> slotSize;                   // number of bits in each slot
+        std::vector<size_t> slotStorage;                // storages index for each slot
+
+        explicit Layout(const RegisterDictionary*);
+
+        /** Storage for a major/minor pair, or null if the dictionary has no such registers. */
+        const Storage* storage(unsigned majr, unsigned minr) const {
+            if (majr >= index.size() || minr >= index[majr].size() || NO_STORAGE == index[majr][minr])
+                return NULL;
+            return &storages[index[majr][minr]];
+        }
+
+        /** Slots overlapping a register.
+         *
+         *  Returns false if the register's storage is not in the layout or its bits are not all covered by the storage;
+         *  otherwise sets @p first and @p last (inclusive) to the overlapping slot numbers. */
+        bool slots(const RegisterDescriptor&, size_t &first /*out*/, size_t &last /*out*/) const;
+    };
+
+    /** Shared-ownership pointer to a layout. */
+    typedef boost::shared_ptr<const Layout> LayoutPtr;
+
+protected:
+    LayoutPtr layout_;                                  // slot numbering shared by related states
+    std::vector<Slot> slots_;                           // one entry per slot, indexed by slot number
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Normal constructors
+    //
+    // These are protected because objects of this class are reference counted and always allocated on the heap.
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+protected:
+    RegisterStateFlat(const SValuePtr &protoval, const RegisterDictionary *regdict)
+        : RegisterState(protoval, regdict), layout_(new Layout(regdict)) {
+        clear();
+    }
+
+    RegisterStateFlat(const SValuePtr &protoval, const LayoutPtr &layout)
+        : RegisterState(protoval, layout->regdict), layout_(layout) {
+        clear();
+    }
+
+    RegisterStateFlat(const RegisterStateFlat &other)
+        : RegisterState(other), layout_(other.layout_), slots_(other.slots_) {
+        deep_copy_values();
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Static allocating constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Instantiate a new register state. The @p protoval argument must be a non-null pointer to a semantic value which will be
+     *  used only to create additional instances of the value via its virtual constructors.
+     *
+     *  The register dictionary, @p regdict, describes the registers that can be stored by this register state and is used to
+     *  compute the slot layout. The dictionary must not be modified while the state exists. */
+    static RegisterStateFlatPtr instance(const SValuePtr &protoval, const RegisterDictionary *regdict) {
+        return RegisterStateFlatPtr(new RegisterStateFlat(protoval, regdict));
+    }
+
+    /** Instantiate a new copy of an existing register state. */
+    static RegisterStateFlatPtr instance(const RegisterStateFlatPtr &other) {
+        return RegisterStateFlatPtr(new RegisterStateFlat(*other));
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Virtual constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    virtual RegisterStatePtr create(const SValuePtr &protoval, const RegisterDictionary *regdict) const ROSE_OVERRIDE {
+        if (regdict == layout_->regdict)
+            return RegisterStateFlatPtr(new RegisterStateFlat(protoval, layout_));
+        return instance(protoval, regdict);
+    }
+
+    virtual RegisterStatePtr clone() const ROSE_OVERRIDE {
+        return RegisterStateFlatPtr(new RegisterStateFlat(*this));
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Dynamic pointer casts
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Run-time promotion of a base register state pointer to a RegisterStateFlat pointer. This is a checked conversion--it
+     *  will fail if @p from does not point to a RegisterStateFlat object. */
+    static RegisterStateFlatPtr promote(const RegisterStatePtr &from) {
+        RegisterStateFlatPtr retval = boost::dynamic_pointer_cast<RegisterStateFlat>(from);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Object properties
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Slot layout shared by this state. */
+    const LayoutPtr& layout() const { return layout_; }
+
+    /** Number of slots. */
+    size_t nSlots() const { return slots_.size(); }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Inherited non-constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    virtual void clear() ROSE_OVERRIDE;
+    virtual void zero() ROSE_OVERRIDE;
+    virtual SValuePtr readRegister(const RegisterDescriptor &reg, const SValuePtr &dflt, RiscOperators *ops) ROSE_OVERRIDE;
+    virtual void writeRegister(const RegisterDescriptor &reg, const SValuePtr &value, RiscOperators *ops) ROSE_OVERRIDE;
+    virtual void print(std::ostream&, Formatter&) const ROSE_OVERRIDE;
+    virtual bool merge(const RegisterStatePtr &other, RiscOperators *ops) ROSE_OVERRIDE;
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Non-inherited methods
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Make each slot point to a copy of its value.
+     *
+     *  Slots that shared a value before the call share the copy afterward. This is called by the copy constructor. */
+    virtual void deep_copy_values();
+
+protected:
+    // Bits [lo,hi) of a slot's value, where lo and hi are register bit offsets within the slot.
+    SValuePtr slotBits(size_t slotIdx, size_t lo, size_t hi, RiscOperators *ops) const;
+
+    // Bits [lo,hi) of the register storage for the run of slots [first,last], which all must be non-null. Runs of slots
+    // that refer to the same value are extracted as a unit.
+    SValuePtr readSlots(size_t first, size_t last, size_t lo, size_t hi, RiscOperators *ops) const;
+
+    // Replace bits [lo,hi) of one slot, where lo and hi are register bit offsets within the slot. Bit zero of the value
+    // corresponds to register bit lo.  The slot must be non-null.
+    void spliceSlot(size_t slotIdx, size_t lo, size_t hi, const SValuePtr &value, RiscOperators *ops);
+
+    // Throws an exception if the register cannot be stored in this state.
+    void slotsOrThrow(const RegisterDescriptor&, size_t &first /*out*/, size_t &last /*out*/) const;
+};
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -8,6 +8,8 @@
 #include <BinarySymbolicExpr.h>
 #include <boost/thread/mutex.hpp>
 #include <inttypes.h>
+#include <map>
+#include <string>
 
 namespace rose {
 namespace BinaryAnalysis {
@@ -31,15 +33,62 @@ public:
 
     /** SMT solver statistics. */
     struct Stats {
-        Stats(): ncalls(0), input_size(0), output_size(0) {}
+        Stats(): ncalls(0), ncached(0), input_size(0), output_size(0) {}
         size_t ncalls;                          /**< Number of times satisfiable() was called. */
+        size_t ncached;                         /**< Number of times satisfiable() was answered by the query cache. */
         size_t input_size;                      /**< Bytes of input generated for satisfiable(). */
         size_t output_size;                     /**< Amount of output produced by the SMT solver. */
     };
 
     typedef std::set<uint64_t> Definitions;     /**< Free variables that have been defined. */
 
-    SMTSolver(): debug(NULL) { init(); }
+    /** Evidence of satisfiability indexed by the names returned by evidence_names(). */
+    typedef std::map<std::string, SymbolicExpr::Ptr> EvidenceMap;
+
+    /** Cache of query results.
+     *
+     *  A cache remembers whether each conjunction of expressions passed to satisfiable() was satisfiable, along with the
+     *  evidence of satisfiability, so that the solver doesn't need to be run again for the same query.  Queries are compared
+     *  after renaming their variables in order of first appearance, so that queries that differ only in variable names (such
+     *  as the same path condition computed again from fresh variables) use the same cache entry, and the evidence is renamed
+     *  accordingly.  The key is a digest of the renamed query (SHA1 if ROSE is configured with libgcrypt, otherwise a 64-bit
+     *  FNV hash and the query size).
+     *
+     *  Results are always kept in memory. If a file name is given, then results previously saved in that file are loaded when
+     *  the cache is constructed and each new result is appended to the file, so that later runs on the same specimen can reuse
+     *  them.  A cache may be shared by any number of solvers (see set_cache()) and is thread safe. */
+    class Cache {
+    public:
+        /** Result of a query. */
+        struct Result {
+            Satisfiable sat;
+            EvidenceMap evidence;               /**< Evidence using the canonical variable names. */
+            Result(): sat(SAT_UNKNOWN) {}
+        };
+
+        /** Construct a cache, optionally backed by a file.  Throws an Exception if the file exists but cannot be parsed. */
+        explicit Cache(const std::string &fileName = "");
+
+        /** Look up a result by key. Returns true and sets @p result if found. */
+        bool lookup(const std::string &key, Result &result) const;
+
+        /** Insert a result, replacing any previous result for the same key. */
+        void insert(const std::string &key, const Result&);
+
+        /** Number of results. */
+        size_t size() const;
+
+        /** Name of the backing file, or empty. */
+        const std::string& fileName() const { return fileName_; }
+
+    private:
+        void load();
+        mutable boost::mutex mutex_;
+        std::string fileName_;
+        std::map<std::string, Result> results_;
+    };
+
+    SMTSolver(): debug(NULL), cache(NULL) { init(); }
 
     virtual ~SMTSolver() {}
 
@@ -55,6 +104,29 @@ public:
     virtual Satisfiable satisfiable(std::vector<SymbolicExpr::Ptr>, const SymbolicExpr::Ptr&);
     /** @} */
 
+    /** Incremental solving.
+     *
+     *  Instead of passing all expressions to @ref satisfiable for each query, the expressions can be asserted one at a time
+     *  with @ref insert, grouped into levels with @ref push and @ref pop, and checked with @ref check.  Popping a level removes
+     *  the assertions that were inserted since the matching push. This lets a caller that explores paths assert the common
+     *  prefix once and only add and remove the last few conditions.  The base implementation remembers the assertions and
+     *  passes all of them to @ref satisfiable when checked; subclasses that have a persistent solver context override these to
+     *  use the solver's own incremental interface.
+     *
+     *  The @ref check method returns the same thing as @ref satisfiable would for all current assertions.
+     * @{ */
+    virtual void push();
+    virtual void pop();
+    virtual void insert(const SymbolicExpr::Ptr&);
+    virtual Satisfiable check();
+    /** @} */
+
+    /** Number of levels pushed by @ref push and not yet popped. */
+    size_t nLevels() const { return levels_.size() - 1; }
+
+    /** All assertions inserted by @ref insert that have not been popped. */
+    std::vector<SymbolicExpr::Ptr> assertions() const;
+
 
 
     /** Evidence of satisfiability for a bitvector variable.  If an expression is satisfiable, this function will return
@@ -102,6 +174,13 @@ public:
     /** Obtain current debugging setting. */
     FILE *get_debug() const { return debug; }
 
+    /** Sets the query result cache.  The cache is not owned by this solver and may be shared with other solvers. A null
+     *  pointer disables caching, which is the default. */
+    void set_cache(Cache *c) { cache = c; }
+
+    /** Obtain the query result cache, if any. */
+    Cache *get_cache() const { return cache; }
+
     /** Returns statistics for this solver. The statistics are not reset by this call, but continue to accumulate. */
     const Stats& get_stats() const { return stats; }
     /** Returns statistics for all solvers. The statistics are not reset by this call, but continue to accumulate. */
@@ -127,6 +206,23 @@ protected:
      *  expression.  This information is parsed by this function and added to a mapping of variable to value. */
     virtual void parse_evidence() {};
 
+    /** Replaces the evidence of satisfiability.  Called when a satisfiable() result comes from the query cache. Subclasses
+     *  that return evidence should override this so that the cached evidence is available through evidence_for_name(). */
+    virtual void restore_evidence(const EvidenceMap&) {}
+
+    /** Renaming of one query for the cache. */
+    struct CacheKey {
+        std::string digest;                     /**< Key for the query cache. */
+        std::map<uint64_t, uint64_t> variables; /**< Map from variable ID to canonical variable number. */
+    };
+
+    /** Look up a query in the cache.  If a cache is set and it contains the query then the result is returned through @p
+     *  sat, the evidence is restored, and true is returned.  Otherwise @p key is initialized for a later cache_insert(). */
+    bool cache_lookup(const std::vector<SymbolicExpr::Ptr>&, CacheKey &key, Satisfiable &sat);
+
+    /** Save a query result and the current evidence in the cache, if a cache is set. */
+    void cache_insert(const CacheKey&, Satisfiable);
+
     /** Additional output obtained by satisfiable(). */
     std::string output_text;
 
@@ -137,6 +233,8 @@ protected:
 
 private:
     FILE *debug;
+    Cache *cache;
+    std::vector<std::vector<SymbolicExpr::Ptr> > levels_;      // assertions for incremental solving; never empty
     void init();
 };
 
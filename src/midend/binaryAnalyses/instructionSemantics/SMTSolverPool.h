@@ -0,0 +1,149 @@
+#ifndef Rose_SMTSolverPool_H
+#define Rose_SMTSolverPool_H
+
+#include "SMTSolver.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <deque>
+#include <vector>
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** Pool of SMT solvers that answer queries in parallel.
+ *
+ *  The pool has a fixed number of worker threads, each with its own solver, and a queue of submitted queries. The submit()
+ *  method returns immediately with a handle that can be used later to wait for the answer, so a caller can have any number of
+ *  independent queries in flight.  Queries are answered in the order they were submitted, but they may finish in any order.
+ *
+ *  A query that's no longer needed (for instance, a speculative path feasibility check for a path that has since been
+ *  abandoned) can be cancelled. A cancelled query that has not started is never given to a solver; a query that's already
+ *  running is allowed to finish but its answer is discarded.
+ *
+ *  @code
+ *   static SMTSolver* makeSolver() { return new YicesSolver; }
+ *
+ *   SMTSolverPool pool(0, makeSolver);                  // one solver per CPU
+ *   std::vector<SMTSolverPool::QueryPtr> queries;
+ *   BOOST_FOREACH (const SymbolicExpr::Ptr &condition, pathConditions)
+ *       queries.push_back(pool.submit(condition));
+ *   BOOST_FOREACH (const SMTSolverPool::QueryPtr &query, queries) {
+ *       if (query->wait() == SMTSolver::SAT_NO)
+ *           ...
+ *   }
+ *  @endcode */
+class SMTSolverPool {
+public:
+    /** Function that creates one solver for a worker thread. The pool owns the returned solver. */
+    typedef SMTSolver* (*SolverFactory)();
+
+    /** State of a query. */
+    enum QueryState {
+        QUERY_PENDING,                                  /**< Waiting for a solver. */
+        QUERY_RUNNING,                                  /**< Being answered by a solver. */
+        QUERY_FINISHED,                                 /**< Answered; see Query::wait(). */
+        QUERY_CANCELLED,                                /**< Cancelled before it was answered. */
+        QUERY_FAILED                                    /**< The solver threw an exception. */
+    };
+
+    class Query;
+
+    /** Reference-counted pointer to a query. */
+    typedef boost::shared_ptr<Query> QueryPtr;
+
+    /** A submitted query.
+     *
+     *  This is the handle returned by submit(). All methods are thread safe. */
+    class Query {
+        friend class SMTSolverPool;
+        mutable boost::mutex mutex_;
+        mutable boost::condition_variable done_;        // signaled when the query leaves the pending and running states
+        std::vector<SymbolicExpr::Ptr> exprs_;
+        QueryState state_;
+        SMTSolver::Satisfiable result_;
+        SMTSolver::EvidenceMap evidence_;
+        std::string error_;
+
+        explicit Query(const std::vector<SymbolicExpr::Ptr> &exprs)
+            : exprs_(exprs), state_(QUERY_PENDING), result_(SMTSolver::SAT_UNKNOWN) {}
+
+    public:
+        /** Current state. */
+        QueryState get_state() const;
+
+        /** True if the query is finished, cancelled, or failed. */
+        bool is_ready() const;
+
+        /** Wait for the answer.
+         *
+         *  Blocks until the query is ready and returns the answer. A cancelled query returns SAT_UNKNOWN, and a query whose
+         *  solver failed throws an SMTSolver::Exception. */
+        SMTSolver::Satisfiable wait() const;
+
+        /** Evidence of satisfiability.
+         *
+         *  Blocks until the query is ready and returns the evidence the solver produced, which is empty unless the answer was
+         *  SAT_YES and the solver supports evidence. */
+        SMTSolver::EvidenceMap evidence() const;
+
+        /** Cancel the query.
+         *
+         *  Returns true if the query was cancelled, or false if it was already finished, cancelled, or failed. */
+        bool cancel();
+
+    private:
+        void finish(QueryState, SMTSolver::Satisfiable, const SMTSolver::EvidenceMap&, const std::string &error);
+    };
+
+    /** Construct a pool.
+     *
+     *  Starts @p nthreads worker threads, or one per hardware thread if @p nthreads is zero, each with a solver created by
+     *  @p factory. */
+    SMTSolverPool(size_t nthreads, SolverFactory factory);
+
+    /** Destructor cancels all pending queries and waits for the running queries to finish. */
+    ~SMTSolverPool();
+
+    /** Submit a query.
+     *
+     *  The query asks whether all of the expressions are satisfiable, like SMTSolver::satisfiable().  Returns immediately.
+     * @{ */
+    QueryPtr submit(const std::vector<SymbolicExpr::Ptr>&);
+    QueryPtr submit(const SymbolicExpr::Ptr&);
+    /** @} */
+
+    /** Cancel all queries that have not finished. */
+    void cancel_all();
+
+    /** Wait until all submitted queries are ready. */
+    void wait_all();
+
+    /** Number of worker threads. */
+    size_t nthreads() const { return solvers.size(); }
+
+    /** Number of queries waiting for a solver.  Statistics for the solvers are available from SMTSolver::get_class_stats(). */
+    size_t npending() const;
+
+private:
+    struct Worker;
+    void work(SMTSolver*);
+
+    // not copyable
+    SMTSolverPool(const SMTSolverPool&);
+    SMTSolverPool& operator=(const SMTSolverPool&);
+
+private:
+    mutable boost::mutex mutex;                         // protects the following data members
+    boost::condition_variable queueChanged;             // signaled when a query is queued or a worker becomes idle
+    std::deque<QueryPtr> queue;                         // pending queries, some of which might have been cancelled
+    size_t nrunning;                                    // number of queries being answered
+    bool stopping;                                      // set by the destructor
+    std::vector<SMTSolver*> solvers;                    // one per thread; each is used only by its thread
+    std::vector<boost::thread*> threads;
+};
+
+} // namespace
+} // namespace
+
+#endif
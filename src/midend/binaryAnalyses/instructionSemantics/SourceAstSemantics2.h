@@ -248,16 +248,20 @@ public:
 private:
     SideEffects sideEffects_;                           // Side effects, including substitutions
     bool executionHalted_;                              // Stop adding inputs and outputs?
+    std::string registerVariablePrefix_;                // Prefix for C register variable names
+    bool splitFlags_;                                   // Store each flag bit in its own C variable?
 
 protected:
     RiscOperators(const BaseSemantics::SValuePtr &protoval, SMTSolver *solver)
-        : BaseSemantics::RiscOperators(protoval, solver), executionHalted_(false) {
+        : BaseSemantics::RiscOperators(protoval, solver), executionHalted_(false), registerVariablePrefix_("R_"),
+          splitFlags_(false) {
         name("SourceAstSemantics");
         (void) SValue::promote(protoval); // make sure its dynamic type is a SourceAstSemantics::SValue
     }
 
     RiscOperators(const BaseSemantics::StatePtr &state, SMTSolver *solver)
-        : BaseSemantics::RiscOperators(state, solver), executionHalted_(false) {
+        : BaseSemantics::RiscOperators(state, solver), executionHalted_(false), registerVariablePrefix_("R_"),
+          splitFlags_(false) {
         name("SourceAstSemantics");
         (void) SValue::promote(state->protoval());      // values must have SourceAstSemantics::SValue dynamic type
     }
@@ -346,9 +350,35 @@ public:
     /** Global variable name for a register.
      *
      *  No attempt is made to ensure that the register really has a valid global variable. The rule is that if the register
-     *  exists as a single location in the register state then it has a global variable. */
+     *  exists as a single location in the register state then it has a global variable.  The name starts with the @ref
+     *  registerVariablePrefix. */
     std::string registerVariableName(const RegisterDescriptor&);
 
+    /** Property: Prefix for register variable names.
+     *
+     *  All register variable names generated by @ref registerVariableName start with this string, which is "R_" by default for
+     *  the C global variables.  A translator that copies registers into local variables changes the prefix while it generates
+     *  the code that uses the local copies.  Changing the prefix does not rename the values already stored in the register
+     *  state; call @ref resetState for that.
+     *
+     * @{ */
+    const std::string& registerVariablePrefix() const { return registerVariablePrefix_; }
+    void registerVariablePrefix(const std::string &s) { registerVariablePrefix_ = s; }
+    /** @} */
+
+    /** Property: Whether flags are stored separately.
+     *
+     *  Normally each of the largest registers is stored as one location in the register state and therefore becomes one C
+     *  variable, which means that an instruction that sets a single flag reads and writes the whole flags register.  When
+     *  this property is set, a register whose bits are all named one-bit registers (such as the x86 EFLAGS register) is
+     *  stored as one location per bit instead, so each flag is its own C variable and a flag that is never read before being
+     *  assigned again can be optimized away.  The property takes effect at the next @ref resetState.
+     *
+     * @{ */
+    bool splitFlags() const { return splitFlags_; }
+    void splitFlags(bool b) { splitFlags_ = b; }
+    /** @} */
+
     /** Reset to initial state. */
     void reset() {
         sideEffects_.clear();
@@ -364,6 +394,12 @@ public:
      *  state from halted to running. */
     void haltExecution() { executionHalted_ = true; }
 
+    /** Registers stored when flags are split.
+     *
+     *  Returns the largest registers of the dictionary, except each register whose bits are all named one-bit registers is
+     *  replaced by those one-bit registers.  See @ref splitFlags. */
+    static std::vector<RegisterDescriptor> splitFlagRegisters(const RegisterDictionary*);
+
     /** Return a bit mask.
      *
      *  The resuling mask has a type that is @p nBits wide, and it has @p nSet bits set and shifted left @p sa.  The @p nSet
@@ -548,6 +548,12 @@ public:
     virtual void writeMemory(const BaseSemantics::SValuePtr &addr, const BaseSemantics::SValuePtr &value,
                              BaseSemantics::RiscOperators *addrOps, BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
 
+    /** Inexpensive test for distinct byte addresses.
+     *
+     *  In addition to distinct constants, this recognizes addresses of the form <em>X + c1</em> and <em>X + c2</em> (where
+     *  either constant may be absent) which are equal only if the constants are equal. */
+    virtual bool addressesDisjoint(const BaseSemantics::SValuePtr &a, const BaseSemantics::SValuePtr &b) const ROSE_OVERRIDE;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Methods first declared in this class
 public:
@@ -4,6 +4,11 @@
 #include "BaseSemantics2.h"
 #include "Diagnostics.h"
 
+#include <boost/thread.hpp>
+#include <cstdio>
+#include <cstring>
+#include <Sawyer/Map.h>
+
 namespace rose {
 namespace BinaryAnalysis {                      // documented elsewhere
 namespace InstructionSemantics2 {               // documented elsewhere
@@ -46,6 +51,11 @@ namespace InstructionSemantics2 {               // documented elsewhere
  *  ops = TraceSemantics::RiscOperators::promote(ops)->get_subdomain();
  *  dispatcher->set_operators(ops);
  * @endcode
+ *
+ *  Formatting every operation as text is slow and the output is large. For long runs, a @ref TraceWriter can be given to
+ *  the RISC operators with @ref RiscOperators::binaryTrace, in which case each operation is written as a fixed-size binary
+ *  record instead of text. Binary traces are converted back to the text form with a @ref TraceReader (the
+ *  "decodeSemanticTrace" tool does this).
  */
 namespace TraceSemantics {
 
@@ -80,6 +90,191 @@ typedef void MemoryState;
 typedef boost::shared_ptr<void> MemoryStatePtr;
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Binary traces
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** One record of a binary trace.
+ *
+ *  A binary trace is a header followed by a sequence of these 64-byte records in the byte order of the machine that wrote
+ *  the trace. Operator names, register names, and other strings are interned: the first time a string is used, a
+ *  @ref R_STRING record defines its identification number and is followed by the string's bytes padded to a whole number of
+ *  records. Thereafter the string is referenced by its number. */
+struct TraceRecord {
+    /** Kind of record. */
+    enum Type {
+        R_NONE      = 0,                                /**< Unused record. */
+        R_OPERATOR  = 1,                                /**< Start of a RISC operator; @c name is the operator name. */
+        R_RESULT    = 2,                                /**< Values returned by the preceding operator. */
+        R_EXCEPTION = 3,                                /**< Preceding operator threw; argument is the message (if any). */
+        R_STRING    = 4                                 /**< String definition: args[0] is the ID, args[1] the length. */
+    };
+
+    /** Kind of operator argument. */
+    enum ArgType {
+        A_NONE      = 0,                                /**< No argument. */
+        A_NUMBER    = 1,                                /**< Concrete value: argument is the value, width is its size. */
+        A_VALUE     = 2,                                /**< Other value: argument is a hash, width is its size. */
+        A_NULL      = 3,                                /**< Null value pointer. */
+        A_REGISTER  = 4,                                /**< Register: argument is the string ID of its name. */
+        A_INTEGER   = 5,                                /**< Integer argument such as a width or bit number. */
+        A_STRING    = 6                                 /**< Argument is a string ID, such as a floating-point type name. */
+    };
+
+    /** Maximum number of arguments per record. */
+    static const size_t MAX_ARGS = 4;
+
+    uint64_t insnVa;                                    /**< Address of the current instruction. */
+    uint32_t insnIndex;                                 /**< One more than the current instruction's sequence number, or 0. */
+    uint32_t name;                                      /**< String ID of the operator name for @ref R_OPERATOR. */
+    uint8_t type;                                       /**< A @ref Type. */
+    uint8_t nArgs;                                      /**< Number of arguments used. */
+    uint8_t argType[MAX_ARGS];                          /**< An @ref ArgType for each argument. */
+    uint16_t argWidth[MAX_ARGS];                        /**< Width of each value argument in bits. */
+    uint16_t reserved;                                  /**< Zero. */
+    uint64_t args[MAX_ARGS];                            /**< Argument data according to the argument type. */
+
+    TraceRecord() { clear(); }
+
+    /** Reset the record to all zero. */
+    void clear() { memset(this, 0, sizeof *this); }
+};
+
+/** Writes binary trace records to a file.
+ *
+ *  Records are appended to a ring of fixed-size chunks. The thread producing the trace fills the current chunk with no
+ *  locking and only synchronizes with the background thread that writes to the file when it moves to the next chunk, so the
+ *  cost per record is a copy into memory. If the writer falls behind and all chunks are full, the producer waits.  A writer
+ *  must be used by only one producing thread at a time.
+ *
+ *  Errors writing the file are detected by the background thread and reported by the next call to @ref flush (or logged by
+ *  the destructor). */
+class TraceWriter {
+public:
+    /** Magic number at the start of each binary trace file. */
+    static const char *MAGIC;
+
+    /** Version number of the binary trace format. */
+    static const uint32_t VERSION = 1;
+
+private:
+    struct Worker;
+
+    std::string fileName_;
+    FILE *file_;
+    std::vector<std::vector<TraceRecord> > chunks_;     // the ring buffer; each chunk holds chunkSize_ records
+    size_t chunkSize_;                                  // records per chunk
+    size_t head_;                                       // chunk being filled by the producer (not visible to the worker)
+    size_t nUsed_;                                      // records used in the head chunk
+    size_t nRecords_;                                   // total records appended
+    Sawyer::Container::Map<std::string, uint32_t> strings_; // interned strings
+
+    boost::mutex mutex_;                                // protects the following data members
+    boost::condition_variable changed_;                 // signaled when a chunk is queued or written
+    size_t tail_;                                       // oldest chunk queued for writing
+    size_t nQueued_;                                    // number of chunks queued for writing, starting at tail_
+    std::vector<size_t> chunkUsed_;                     // number of records to write from each queued chunk
+    bool stopping_;                                     // set by the destructor
+    std::string error_;                                 // first write error, if any
+    boost::thread *thread_;
+
+public:
+    /** Create a trace file.
+     *
+     *  The file is truncated and a header is written. The ring buffer has @p nChunks chunks of @p chunkSize records
+     *  each. Throws an <code>std::runtime_error</code> if the file cannot be created. */
+    explicit TraceWriter(const std::string &fileName, size_t chunkSize = 4096, size_t nChunks = 16);
+
+    /** Flushes all records, stops the background thread, and closes the file. */
+    ~TraceWriter();
+
+    /** Name of the file being written. */
+    const std::string& fileName() const { return fileName_; }
+
+    /** Append a record.
+     *
+     *  The record is copied into the ring buffer. */
+    void append(const TraceRecord &record) {
+        chunks_[head_][nUsed_] = record;
+        ++nRecords_;
+        if (++nUsed_ == chunkSize_)
+            queueHead(false);
+    }
+
+    /** String identification number.
+     *
+     *  Returns the ID for the specified string, appending its definition to the trace the first time the string is seen. */
+    uint32_t intern(const std::string&);
+
+    /** Write all records appended so far.
+     *
+     *  Blocks until the background thread has written everything to the file. Throws an <code>std::runtime_error</code>
+     *  if any write failed. */
+    void flush();
+
+    /** Number of records appended, including string definitions. */
+    size_t nRecords() const { return nRecords_; }
+
+private:
+    // not copyable
+    TraceWriter(const TraceWriter&);
+    TraceWriter& operator=(const TraceWriter&);
+
+    // Queue the head chunk for writing and advance to the next chunk, waiting if necessary. If "partial" is set then the
+    // chunk might not be full and the producer waits until it has been written.
+    void queueHead(bool partial);
+
+    // Body of the background thread.
+    void work();
+};
+
+/** Shared-ownership pointer to a binary trace writer. */
+typedef boost::shared_ptr<TraceWriter> TraceWriterPtr;
+
+/** Reads binary trace files.
+ *
+ *  The reader keeps the string table as string definitions are read, so the strings referenced by a record are available
+ *  once the record has been returned by @ref next. */
+class TraceReader {
+    std::string fileName_;
+    FILE *file_;
+    std::vector<std::string> strings_;                  // indexed by string ID
+
+public:
+    /** Open a binary trace file.
+     *
+     *  Throws an <code>std::runtime_error</code> if the file cannot be opened or is not a binary trace written on a machine
+     *  with the same byte order. */
+    explicit TraceReader(const std::string &fileName);
+
+    ~TraceReader();
+
+    /** Read the next record.
+     *
+     *  String definitions are processed internally and not returned. Returns false at the end of the trace. Throws an
+     *  <code>std::runtime_error</code> if the file is truncated in the middle of a string definition. */
+    bool next(TraceRecord&);
+
+    /** String for an ID.
+     *
+     *  Returns a placeholder if the ID has not been defined. */
+    std::string string(uint32_t id) const;
+
+    /** Text for one argument of a record, formatted like the text trace. */
+    std::string argument(const TraceRecord&, size_t argIdx) const;
+
+    /** Convert the rest of the trace to text.
+     *
+     *  Produces one line per RISC operator in the same format as the text trace, and returns the number of operators. */
+    size_t decode(std::ostream&);
+
+private:
+    // not copyable
+    TraceReader(const TraceReader&);
+    TraceReader& operator=(const TraceReader&);
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      RISC operators
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -91,6 +286,9 @@ typedef boost::shared_ptr<class RiscOperators> RiscOperatorsPtr;
 class RiscOperators: public BaseSemantics::RiscOperators {
     BaseSemantics::RiscOperatorsPtr subdomain_;         // Domain to which all our RISC operators chain
     Sawyer::Message::Stream stream_;                    // stream to which output is emitted
+    TraceWriterPtr binaryTrace_;                        // optional binary trace used instead of stream_
+    TraceRecord record_;                                // binary record being built by before()
+    Sawyer::Container::Map<RegisterDescriptor, uint32_t> registerIds_; // string IDs of register names for binaryTrace_
     
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -116,8 +314,10 @@ protected:
 
 public:
     virtual ~RiscOperators() {
-        linePrefix();
-        stream_ <<"operators destroyed\n";
+        if (!binaryTrace_) {
+            linePrefix();
+            stream_ <<"operators destroyed\n";
+        }
     }
     
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -218,6 +418,24 @@ public:
     void stream(Sawyer::Message::Stream &s) { stream_ = s; }
     /** @} */
 
+    /** Property: binary trace.
+     *
+     *  When non-null, operations are written as records to this binary trace instead of as text to the @ref stream. Value
+     *  arguments and results that are concrete numbers are recorded exactly; other values are recorded by their width and
+     *  @ref valueHash.  Several operators can share one writer as long as they're used by a single thread.
+     *
+     * @{ */
+    const TraceWriterPtr& binaryTrace() const { return binaryTrace_; }
+    void binaryTrace(const TraceWriterPtr &writer) { binaryTrace_ = writer; registerIds_.clear(); }
+    /** @} */
+
+    /** Hash recorded in binary traces for a value that's not a concrete number.
+     *
+     *  The default is a 64-bit FNV-1a hash of the value's printed form, so equal hashes mean the values print the same
+     *  (barring hash collisions) regardless of which value objects hold them. Subclasses can override this with a cheaper or
+     *  more precise content hash, such as a symbolic expression's own hash. */
+    virtual uint64_t valueHash(const BaseSemantics::SValuePtr&);
+
 protected:
     void linePrefix();
     std::string toString(const BaseSemantics::SValuePtr&);
@@ -253,6 +471,15 @@ protected:
     const BaseSemantics::SValuePtr& after(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&);
     void after(const BaseSemantics::Exception&);
     void after_exception();
+
+    // Building binary trace records.
+    void binaryStart(TraceRecord::Type, const std::string &operator_name);
+    void binaryArg(const BaseSemantics::SValuePtr&);
+    void binaryArg(const RegisterDescriptor&);
+    void binaryArg(uint64_t);
+    void binaryArg(SgAsmFloatType*);
+    void binaryArgString(const std::string&);
+    void binaryEmit();
     
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Methods we override from our super class
@@ -18,7 +18,10 @@ namespace BinaryAnalysis {
  *  assertion when instantiated).
  *
  *  Yices provides two interfaces: an executable named "yices", and a library. The choice of which linkage to use to answer
- *  satisfiability questions is made at runtime (see set_linkage()).
+ *  satisfiability questions is made at runtime (see set_linkage()).  The executable can either be run once per query with the
+ *  query in a temporary file (LM_EXECUTABLE), or run once for the life of the solver object and fed queries through a socket
+ *  (LM_SESSION), which avoids a process creation and file I/O per query.  In session mode and library mode the variable
+ *  declarations are shared by all queries, and each query's assertions are removed afterward with Yices' push/pop mechanism.
  */
 class YicesSolver: public SMTSolver {
 public:
@@ -26,14 +29,16 @@ public:
     enum LinkMode {
         LM_NONE=0x0000,                         /**< No available linkage. */
         LM_LIBRARY=0x0001,                      /**< The Yices runtime library is available. */
-        LM_EXECUTABLE=0x0002                    /**< The "yices" executable is available. */
+        LM_EXECUTABLE=0x0002,                   /**< The "yices" executable is available. */
+        LM_SESSION=0x0004                       /**< The "yices" executable can be run as a persistent process. */
     };
 
     /** Maps expression nodes to term names.  This map is populated for common subexpressions. */
     typedef Sawyer::Container::Map<SymbolicExpr::Ptr, std::string> TermNames;
 
-    /** Constructor prefers to use the Yices executable interface. See set_linkage(). */
-    YicesSolver(): linkage(LM_NONE), context(NULL) {
+    /** Constructor prefers to use a persistent Yices executable, then the library. See set_linkage(). */
+    YicesSolver()
+        : linkage(LM_NONE), session(NULL), nSessionQueries(0), csePrefix("cse_"), context(NULL), incrementalContext(NULL) {
         init();
     }
     virtual ~YicesSolver();
@@ -49,9 +54,11 @@ public:
         return linkage;
     }
 
-    /** Sets the linkage style. */
+    /** Sets the linkage style.  Changing away from LM_SESSION terminates the persistent Yices process. */
     void set_linkage(LinkMode lm) {
         ROSE_ASSERT(lm & available_linkage());
+        if (lm != LM_SESSION)
+            close_session();
         linkage = lm;
     }
 
@@ -68,6 +75,17 @@ public:
     }
     /** @} */
 
+    /** Incremental solving.
+     *
+     *  When the link mode is LM_LIBRARY these use a separate Yices context whose assertions are pushed and popped
+     *  directly. Other link modes use the base class implementation.
+     * @{ */
+    virtual void push() ROSE_OVERRIDE;
+    virtual void pop() ROSE_OVERRIDE;
+    virtual void insert(const SymbolicExpr::Ptr&) ROSE_OVERRIDE;
+    virtual Satisfiable check() ROSE_OVERRIDE;
+    /** @} */
+
     virtual SymbolicExpr::Ptr evidence_for_name(const std::string&) /*overrides*/;
     virtual std::vector<std::string> evidence_names() /*overrides*/;
     virtual void clear_evidence() /*overrides*/;
@@ -75,13 +93,23 @@ public:
 protected:
     virtual uint64_t parse_variable(const char *nptr, char **endptr, char first_char);
     virtual void parse_evidence();
+    virtual void restore_evidence(const EvidenceMap&) ROSE_OVERRIDE;
     typedef std::map<std::string/*name or hex-addr*/, std::pair<size_t/*nbits*/, uint64_t/*value*/> > Evidence;
     Evidence evidence;
 
 private:
     LinkMode linkage;
     TermNames termNames;                                // only used by Yices executable translator; library uses termExprs
+    class Session;
+    Session *session;                                   // persistent Yices process for LM_SESSION, created on demand
+    Definitions sessionDefns;                           // variables declared in the session
+    size_t nSessionQueries;                             // used to give common subexpressions unique names in the session
+    std::string csePrefix;                              // prefix for common subexpression names
+    Definitions libraryDefns;                           // variables declared in the library context
+    Definitions incrementalDefns;                       // variables declared in the library's incremental context
     void init();
+    Satisfiable session_satisfiable(const std::vector<SymbolicExpr::Ptr>&);
+    void close_session();
 
     static std::string get_typename(const SymbolicExpr::Ptr&);
 
@@ -120,6 +148,7 @@ private:
     typedef yices_expr (*ShiftAPI)(yices_context, yices_expr, unsigned amount);
 
     yices_context context;
+    yices_context incrementalContext;                   // for push, pop, insert, and check
     void ctx_common_subexpressions(const std::vector<SymbolicExpr::Ptr>&);
     void ctx_define(const std::vector<SymbolicExpr::Ptr>&, Definitions*);
     void ctx_assert(const SymbolicExpr::Ptr&);
@@ -143,6 +172,7 @@ private:
     
 #else
     void *context; /*unused for now*/
+    void *incrementalContext; /*unused for now*/
 #endif
 
 };
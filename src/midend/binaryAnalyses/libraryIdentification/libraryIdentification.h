@@ -3,19 +3,30 @@
 
 #include "sqlite3x.h"
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 // #include "functionIdentification.h"
 // #include "rose.h"
 // #include "libraryIdentification.h"
 
 namespace LibraryIdentification
    {
+     class SignatureIndex;
+
   // This is an implementation of Fast Library Identification and Recognition Technology
      void generateLibraryIdentificationDataBase    ( std::string databaseName, SgProject* project );
      void matchAgainstLibraryIdentificationDataBase( std::string databaseName, SgProject* project );
 
+  // The SQL database is the authoring format. For matching, it can be compiled into a signature index file once and the
+  // index file used by any number of later runs (see SignatureIndex).
+     void generateLibraryIdentificationIndex       ( std::string databaseName, std::string indexName );
+     void matchAgainstLibraryIdentificationIndex   ( std::string indexName, SgProject* project );
+
   // Low level factored code to support generateLibraryIdentificationDataBase() and 
-  // matchAgainstLibraryIdentificationDataBase() interface functions.
-     void libraryIdentificationDataBaseSupport( std::string databaseName, SgProject* project, bool generate_database );
+  // matchAgainstLibraryIdentificationDataBase() interface functions. When matching, the functions are matched against
+  // the index if one is given, otherwise against an index built in memory from the database.
+     void libraryIdentificationDataBaseSupport( std::string databaseName, SgProject* project, bool generate_database,
+                                                const SignatureIndex* index = NULL );
 
   // Debugging support
      void testForDuplicateEntries( const std::vector<SgUnsignedCharList> & functionOpcodeList );
@@ -63,6 +74,91 @@ namespace LibraryIdentification
          sqlite3x::sqlite3_connection con;
      };
 
+  // In-memory index of the function signatures in a database.
+  //
+  // Querying the database once per function is slow for large binaries, so for matching the signatures are loaded into
+  // an index once, either from the database or from an index file written by save(). Each function is identified by a
+  // 128-bit digest of its normalized opcode vector (the same digest that's stored in the database): the first half is the
+  // key by which the entries are sorted and the second half is a fingerprint that's compared when the keys are equal. A
+  // bloom filter over the keys rejects most functions that are not in the index without searching the entries.
+  //
+  // Index files contain the bloom filter, entries, and strings as arrays in the byte order of the machine that wrote
+  // them, and are used in place by memory mapping them. An index is not modified after it's loaded, so any number of
+  // threads can match against it concurrently.
+     class SignatureIndex
+        {
+          public:
+            // One function. File and function names are offsets into the string pool.
+               struct Entry
+                  {
+                    uint64_t hash;                      // first half of the digest; entries are sorted by this
+                    uint64_t fingerprint;               // second half of the digest
+                    uint64_t begin;                     // library_handle::begin
+                    uint64_t end;                       // library_handle::end
+                    uint32_t filename;                  // string pool offset of library_handle::filename
+                    uint32_t function_name;             // string pool offset of library_handle::function_name
+                  };
+
+               SignatureIndex();
+
+            // Number of hash functions used by the bloom filter.
+               static const size_t BLOOM_HASHES = 4;
+
+            // Compute the digest of a normalized opcode vector.
+               static void digest( const unsigned char* str, size_t str_length, uint64_t & hash, uint64_t & fingerprint );
+
+            // Replace the index with all the functions in an SQL database built by generateLibraryIdentificationDataBase().
+               void load_database( const std::string & databaseName );
+
+            // Write the index to a file, or replace the index by memory mapping a file written by save(). The load()
+            // function throws an std::runtime_error if the file is not a valid index.
+               void save( const std::string & indexName ) const;
+               void load( const std::string & indexName );
+
+            // Number of functions in the index.
+               size_t size() const { return n_entries; }
+
+            // Returns false if the index definitely has no function with the specified digest key.
+               bool may_contain( uint64_t hash ) const;
+
+            // Return the library_handle matching an opcode vector. Returns false if there is no match or if the index
+            // has more than one entry for the vector.
+               bool get_function_match( library_handle & handle, const SgUnsignedCharList & opcode_vector ) const;
+
+            // Match many opcode vectors using nThreads threads (zero means one per processor). The found vector is
+            // parallel to the functions and indicates which of the handles are valid. Returns the number of matches.
+               size_t match_all( const std::vector<SgUnsignedCharList> & functions, std::vector<library_handle> & handles,
+                                 std::vector<bool> & found, size_t nThreads = 0 ) const;
+
+          private:
+            // Not copyable, since the arrays might point into this object's own storage.
+               SignatureIndex( const SignatureIndex & );
+               SignatureIndex & operator=( const SignatureIndex & );
+
+            // Entry matching a digest, or NULL. Sets duplicate if more than one entry matches.
+               const Entry* find( uint64_t hash, uint64_t fingerprint, bool & duplicate ) const;
+
+            // Fill in a library_handle from an entry.
+               void get_handle( library_handle & handle, const Entry & entry ) const;
+
+            // Point the arrays at the owned vectors.
+               void use_owned_storage();
+
+            // Storage for an index built in memory, or the mapped file for a loaded index.
+               std::vector<uint64_t> owned_bloom;
+               std::vector<Entry> owned_entries;
+               std::vector<char> owned_strings;
+               boost::iostreams::mapped_file_source mapped_file;
+
+            // The index, pointing into one of the above.
+               const uint64_t* bloom;                   // bloom filter bits; the number of bits is a power of two
+               size_t n_bloom_words;
+               const Entry* entries;                    // sorted by hash, then fingerprint
+               size_t n_entries;
+               const char* strings;                     // NUL-terminated strings
+               size_t n_string_bytes;
+        };
+
   // Add an entry to store the pair <library_handle,string> in the database
      void set_function_match( const library_handle & handle, const std::string & data );
 
@@ -95,6 +95,10 @@ class ROSE_DLL_API FunctionData
 
     FunctionData(SgFunctionDeclaration* functionDeclaration, SgProject *project, ClassHierarchyWrapper * );
 
+    //! Like the constructor above, but only finds the call sites (function calls and then constructor initializers) in
+    //! the function's definition without resolving them. The caller adds their targets to functionList.
+    FunctionData(SgFunctionDeclaration* functionDeclaration, std::vector<SgExpression*> &callSites /*out*/);
+
     //! All the callees of this function
     Rose_STL_Container<SgFunctionDeclaration *> functionList;
 
@@ -133,14 +137,71 @@ class ROSE_DLL_API CallGraphBuilder
     //We map each function to the corresponding graph node
     boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*>& getGraphNodesMapping(){ return graphNodes; }
 
+    //! Number of threads that resolve the call sites of the functions. Zero means the number of hardware threads; the
+    //! default is one. The mangled names of all functions, function types and classes are computed before the threads
+    //! start, since the resolution of virtual and function pointer calls compares them and the name caches are not
+    //! thread safe. The AST must not be modified while the graph is built.
+    void setNumThreads(size_t n) { nThreads = n; }
+    size_t getNumThreads() const { return nThreads; }
+
   private:
     SgProject *project;
     SgIncidenceDirectedGraph *graph;
     //We map each function to the corresponding graph node
     typedef boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*> GraphNodes;
     GraphNodes graphNodes;
+    size_t nThreads;
+
+    // Computes the callees of each function, in the same order as the functions
+    void computeFunctionData(const std::vector<SgFunctionDeclaration*> &functions, ClassHierarchyWrapper *classHierarchy,
+                             std::vector<FunctionData> &callGraphData /*out*/);
 
 };
+//! A call graph in a compact form that can be saved to a binary file and merged with the call graphs of other
+//! translation units, so a whole-program graph can be assembled incrementally instead of being built from a merged AST.
+//! Functions are identified by their mangled names: the same function seen from several translation units is one
+//! function of the merged graph, and it has a definition if any of them defines it.
+class ROSE_DLL_API CallGraphStore
+{
+  public:
+    struct Function
+    {
+      std::string mangledName;
+      std::string name;                 // qualified name, used as the graph node name
+      bool hasDefinition;
+    };
+
+    CallGraphStore() {}
+
+    //! Store a graph built by CallGraphBuilder, whose nodes point to function declarations.
+    explicit CallGraphStore(SgIncidenceDirectedGraph *graph);
+
+    //! Add the functions and calls of another store.
+    void merge(const CallGraphStore &other);
+
+    //! Write the store to a file. Throws std::runtime_error if the file can't be written.
+    void save(const std::string &fileName) const;
+
+    //! Replace the contents by those of a file written by save(). Throws std::runtime_error if the file can't be read
+    //! or is not a call graph file.
+    void load(const std::string &fileName);
+
+    //! Build a new graph with one node per function, named by its qualified name. The nodes don't point to AST nodes.
+    SgIncidenceDirectedGraph *toGraph() const;
+
+    const std::vector<Function> &getFunctions() const { return functions; }
+
+    //! The calls as pairs of caller and callee indices into getFunctions(), sorted and without duplicates.
+    const std::vector<std::pair<size_t, size_t> > &getCalls() const { return calls; }
+
+  private:
+    size_t insertFunction(const Function &function);
+
+    std::vector<Function> functions;
+    std::vector<std::pair<size_t, size_t> > calls;
+    boost::unordered_map<std::string, size_t> functionIndex;
+};
+
 //! Generate a dot graph named 'fileName' from a call graph 
 //TODO this function is not defined? If so, need to be removed. 
 // AstDOTGeneration::writeIncidenceGraphToDOTFile() is used instead in the tutorial. Liao 6/17/2012
@@ -171,17 +232,17 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
     // that can be used as keys in a map (using get_firstNondefiningDeclaration()), and filtering according to the predicate.
     graph = new SgIncidenceDirectedGraph();
     std::vector<FunctionData> callGraphData;
-    ClassHierarchyWrapper classHierarchy(project);
+    ClassHierarchyWrapper &classHierarchy = ClassHierarchyWrapper::getClassHierarchy(project);
     graphNodes.clear();
     VariantVector vv(V_SgFunctionDeclaration);
     GetOneFuncDeclarationPerFunction defFunc;
     std::vector<SgNode*> fdecl_nodes = NodeQuery::queryMemoryPool(defFunc, &vv);
+    std::vector<SgFunctionDeclaration*> selected;
     BOOST_FOREACH(SgNode *node, fdecl_nodes) {
         SgFunctionDeclaration *fdecl = isSgFunctionDeclaration(node);
         SgFunctionDeclaration *unique = isSgFunctionDeclaration(fdecl->get_firstNondefiningDeclaration());
         if (isSelected(pred)(unique) && graphNodes.find(unique)==graphNodes.end()) {
-            FunctionData fdata(unique, project, &classHierarchy); // computes functions called by unique
-            callGraphData.push_back(fdata);
+            selected.push_back(unique);
             std::string functionName = unique->get_qualified_name().getString();
             SgGraphNode *graphNode = new SgGraphNode(functionName);
             graphNode->set_SgNode(unique);
@@ -189,6 +250,7 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
             graph->addNode(graphNode);
         }
     }
+    computeFunctionData(selected, &classHierarchy, callGraphData); // computes functions called by each one
 
     // Add edges to the graph
     BOOST_FOREACH(FunctionData &currentFunction, callGraphData) {
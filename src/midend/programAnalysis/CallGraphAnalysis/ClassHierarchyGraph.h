@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <map>
+#include <stdint.h>
 #include <boost/unordered_set.hpp>
 
 class ROSE_DLL_API ClassHierarchyWrapper
@@ -21,11 +22,25 @@ private:
     /** Map from each class to all its immediate subclasses. */
     MangledNameToClassDefsMap directChildren;
 
-    /** Map from class to all (strict) ancestors. */
-    MangledNameToClassDefsMap ancestorClasses;
+    /** Number of each class, by mangled name. Every class is numbered after all its ancestors. */
+    boost::unordered_map<std::string, size_t> classNumbers;
 
-    /** Map from class to all (strict) subclasses. */
-    MangledNameToClassDefsMap subclasses;
+    /** Class number of each class definition seen while building, so that queries don't have to mangle names. */
+    boost::unordered_map<SgClassDefinition*, size_t> definitionNumbers;
+
+    /** Definitions of each class that occur as a parent, respectively a child, of another class. */
+    std::vector<ClassDefSet> parentDefinitions, childDefinitions;
+
+    /** Transitive closure of the parent relation: one row of bits per class, where bit j of row i is set if class j is
+     *  a strict ancestor of class i. */
+    std::vector<uint64_t> ancestorBits;
+    size_t wordsPerRow;
+
+    /** All (strict) ancestors of each class, by class number. */
+    std::vector<ClassDefSet> ancestorClasses;
+
+    /** All (strict) subclasses of each class, by class number. */
+    std::vector<ClassDefSet> subclasses;
 
     SgIncidenceDirectedGraph* classGraph;
 
@@ -36,12 +51,27 @@ public:
     const ClassDefSet& getDirectSubclasses(SgClassDefinition *) const;
     const ClassDefSet& getAncestorClasses(SgClassDefinition *) const;
 
+    /** Whether @p sub is a strict subclass of @p super. Takes constant time. */
+    bool isSubclassOf(SgClassDefinition *sub, SgClassDefinition *super) const;
+
+    /** The class hierarchy of a project, shared by all callers.
+     *
+     *  It's built on the first call and rebuilt only when the number of class definitions or base class specifiers in
+     *  the memory pools has changed, or after @ref invalidateClassHierarchy. A transformation that changes base classes
+     *  in place must call the latter. The returned reference is valid until the hierarchy is rebuilt. Not thread
+     *  safe, though queries of the returned hierarchy are. */
+    static ClassHierarchyWrapper& getClassHierarchy(SgProject *project);
+
+    /** Discard the shared class hierarchy, so that the next @ref getClassHierarchy builds a new one. */
+    static void invalidateClassHierarchy();
+
 private:
 
-    /** Computes the transitive closure of the child-parent class relationship.
-     * @param parents map from each class to its parents. 
-     * @param transitiveParents map from each class to all its ancestors */
-    static void buildAncestorsMap(const MangledNameToClassDefsMap& parents, MangledNameToClassDefsMap& transitiveParents);
+    /** Number of a class definition, or -1 if the class isn't part of the hierarchy. */
+    size_t classNumber(SgClassDefinition *) const;
+
+    /** Numbers the classes and computes the transitive closure of the child-parent class relationship. */
+    void buildClosure();
 };
 
 
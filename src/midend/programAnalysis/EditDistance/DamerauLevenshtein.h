@@ -3,13 +3,16 @@
 
 #include <EditDistance/Levenshtein.h>
 
+#include <algorithm>
+#include <map>
+
 namespace rose {
 namespace EditDistance {
 
 /** Damerau-Levenshtein edit distance.
  *
  *  Returns the true Damerau-Levenshtein edit distance of vectors with adjacent transpositions.  The arguments may be vectors
- *  of any type that defines an equality operation. */
+ *  of any type that defines an equality operation and an ordering ("<" operator). */
 template<typename T>
 size_t
 damerauLevenshteinDistance(const std::vector<T> &src, const std::vector<T> &tgt)
@@ -32,11 +35,12 @@ damerauLevenshteinDistance(const std::vector<T> &src, const std::vector<T> &tgt)
         score[0][j+1] = score_ceil;
     }
     
-    LevenshteinStack<T> dict;
+    // Last row of src in which each element occurs, or zero
+    std::map<T, size_t> dict;
     for (size_t i=0; i<x; ++i)
-        dict.unique_push_zero(src[i]);
+        dict.insert(std::make_pair(src[i], (size_t)0));
     for (size_t j=0; j<y; ++j)
-        dict.unique_push_zero(tgt[j]);
+        dict.insert(std::make_pair(tgt[j], (size_t)0));
 
     for (size_t i=1; i<=x; ++i) {
         size_t db = 0;
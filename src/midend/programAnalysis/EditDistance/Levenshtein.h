@@ -1,80 +1,155 @@
 #ifndef ROSE_EditDistance_Levenshtein_H
 #define ROSE_EditDistance_Levenshtein_H
 
+#include <map>
+#include <stdint.h>
+#include <vector>
+
 namespace rose {
 namespace EditDistance {
 
-// Stack for Levenshtein distance. Used internally
+/** Pattern for bit-parallel Levenshtein edit distance.
+ *
+ *  Holds a vector preprocessed so that its Levenshtein edit distance to any number of other vectors can be computed with
+ *  Myers' bit-vector algorithm, as extended to patterns of any length by Hyyro.  Each element of the other vector is
+ *  processed against 64 elements of the pattern at a time with a few word operations, so computing a distance takes
+ *  O(ceil(n/64) m + m log k) time and O(n/64) space for a pattern of length n with k distinct elements and another vector
+ *  of length m, instead of O(n m) for both.  The preprocessing records, for each distinct element of the pattern, which
+ *  positions of the pattern hold an equal element.  The distinct elements are found in a map, so the element type must
+ *  define a "<" operator that orders elements which are not equal ("==" operator).
+ *
+ *  Preprocessing the pattern once is worthwhile when one vector is compared against many others. */
 template<typename T>
-struct LevenshteinStack {
-    typedef std::pair<T/*key*/, size_t/*value*/> KeyVal;
-    typedef std::list<KeyVal> KeyValList;
-    KeyValList pairs;
-
-    void unique_push_zero(const T& key) {
-        for (typename KeyValList::iterator pi=pairs.begin(); pi!=pairs.end(); ++pi) {
-            if (pi->first==key)
-                return;
+class LevenshteinPattern {
+    typedef std::map<T, size_t> SymbolIndex;
+    SymbolIndex symbols_;                               // distinct elements of the pattern and their symbol numbers
+    std::vector<uint64_t> peq_;                         // nWords_ match masks per symbol; bit i of word w is position 64*w+i
+    size_t nWords_;                                     // number of 64-bit words per match mask
+    size_t size_;                                       // number of elements in the pattern
+
+public:
+    /** Preprocess a pattern. */
+    explicit LevenshteinPattern(const std::vector<T> &pattern)
+        : nWords_((pattern.size() + 63) / 64), size_(pattern.size()) {
+        for (size_t i=0; i<pattern.size(); ++i) {
+            std::pair<typename SymbolIndex::iterator, bool> inserted =
+                symbols_.insert(std::make_pair(pattern[i], symbols_.size()));
+            if (inserted.second)
+                peq_.resize(peq_.size() + nWords_, 0);
+            peq_[inserted.first->second * nWords_ + i / 64] |= (uint64_t)1 << (i % 64);
         }
-        pairs.push_front(KeyVal(key, 0));
     }
 
-    size_t& operator[](const T& key) {
-        for (typename KeyValList::iterator pi=pairs.begin(); pi!=pairs.end(); ++pi) {
-            if (pi->first==key)
-                return pi->second;
+    /** Number of elements in the pattern. */
+    size_t size() const { return size_; }
+
+    /** Edit distance from the pattern to a vector.
+     *
+     *  Returns the Levenshtein edit distance between the pattern and @p text.  If the distance is greater than @p maxDistance
+     *  then @p maxDistance + 1 is returned instead, and the computation stops as soon as a bound shows that the limit will be
+     *  exceeded: when the lengths differ by more than the limit, or when the distance so far exceeds the limit by more than
+     *  the number of elements of @p text that remain to be processed. */
+    size_t distance(const std::vector<T> &text, size_t maxDistance = (size_t)(-1)) const {
+        size_t lengthDifference = text.size() > size_ ? text.size() - size_ : size_ - text.size();
+        if (lengthDifference > maxDistance)
+            return maxDistance + 1;
+        if (text.empty() || 0 == size_)
+            return lengthDifference;
+
+        // Vertical deltas between adjacent rows of the current column, one bit per pattern position.
+        std::vector<uint64_t> vp(nWords_, ~(uint64_t)0), vn(nWords_, 0);
+        const uint64_t last = (uint64_t)1 << ((size_ - 1) % 64);
+        size_t score = size_;                           // distance from the pattern to the prefix of text processed so far
+
+        for (size_t j=0; j<text.size(); ++j) {
+            const uint64_t *eq = matchMasks(text[j]);
+            uint64_t hpCarry = 1, hnCarry = 0;          // horizontal delta entering the top of each word
+            for (size_t w=0; w<nWords_; ++w) {
+                uint64_t x = (eq ? eq[w] : 0) | hnCarry;
+                uint64_t d0 = (((x & vp[w]) + vp[w]) ^ vp[w]) | x | vn[w];
+                uint64_t hp = vn[w] | ~(d0 | vp[w]);
+                uint64_t hn = d0 & vp[w];
+                uint64_t hpIn = hpCarry, hnIn = hnCarry;
+                if (w + 1 < nWords_) {
+                    hpCarry = hp >> 63;
+                    hnCarry = hn >> 63;
+                } else {
+                    hpCarry = (hp & last) ? 1 : 0;
+                    hnCarry = (hn & last) ? 1 : 0;
+                }
+                hp = (hp << 1) | hpIn;
+                hn = (hn << 1) | hnIn;
+                vp[w] = hn | ~(d0 | hp);
+                vn[w] = hp & d0;
+            }
+            score = score + hpCarry - hnCarry;
+
+            // Each remaining element can lower the distance by at most one.
+            size_t nRemaining = text.size() - (j + 1);
+            if (score > maxDistance && score - maxDistance > nRemaining)
+                return maxDistance + 1;
         }
-        assert(!"not found");
-        abort();
+        return score;
+    }
+
+    /** Edit distances from the pattern to many vectors.
+     *
+     *  Returns the @ref distance from the pattern to each of the @p texts, in the same order. */
+    std::vector<size_t> distances(const std::vector<std::vector<T> > &texts, size_t maxDistance = (size_t)(-1)) const {
+        std::vector<size_t> retval;
+        retval.reserve(texts.size());
+        for (size_t i=0; i<texts.size(); ++i)
+            retval.push_back(distance(texts[i], maxDistance));
+        return retval;
+    }
+
+private:
+    // Match masks for an element, or null if the element is not equal to any element of the pattern.
+    const uint64_t* matchMasks(const T &element) const {
+        typename SymbolIndex::const_iterator found = symbols_.find(element);
+        return found != symbols_.end() ? &peq_[found->second * nWords_] : NULL;
     }
 };
 
 /** Levenshtein edit distance.
  *
  *  Returns the Levenshtein edit distance of the specified vectors. The vectors may contain any type of element as long as they
- *  are both the same type and the element types define equality ("==" operator). */
+ *  are both the same type and the element types define equality ("==" operator) and an ordering ("<" operator).  The distance is computed by the
+ *  bit-parallel algorithm of @ref LevenshteinPattern using the shorter vector as the pattern. */
 template<typename T>
 size_t
 levenshteinDistance(const std::vector<T> &src, const std::vector<T> &tgt)
 {
-    // Implementation is cut-n-pasted from above, but removed the line for swaps and associated variables
-    if (src.empty() || tgt.empty())
-        return std::max(src.size(), tgt.size());
-
-    const size_t x = src.size();
-    const size_t y = tgt.size();
-    std::vector<std::vector<size_t> > score(x+2, std::vector<size_t>(y+2, 0));
-    size_t score_ceil = x + y;
-    score[0][0] = score_ceil;
-    for (size_t i=0; i<=x; ++i) {
-        score[i+1][1] = i;
-        score[i+1][0] = score_ceil;
-    }
-    for (size_t j=0; j<=y; ++j) {
-        score[1][j+1] = j;
-        score[0][j+1] = score_ceil;
-    }
-    
-    LevenshteinStack<T> dict;
-    for (size_t i=0; i<x; ++i)
-        dict.unique_push_zero(src[i]);
-    for (size_t j=0; j<y; ++j)
-        dict.unique_push_zero(tgt[j]);
-
-    for (size_t i=1; i<=x; ++i) {
-        for (size_t j=1; j<=y; ++j) {
-            if (src[i-1]==tgt[j-1]) {
-                score[i+1][j+1] = score[i][j];
-            } else {
-                score[i+1][j+1] = std::min(score[i][j], std::min(score[i+1][j], score[i][j+1])) + 1;
-            }
-        }
-        dict[src[i-1]] = i;
-    }
+    if (tgt.size() < src.size())
+        return LevenshteinPattern<T>(tgt).distance(src);
+    return LevenshteinPattern<T>(src).distance(tgt);
+}
 
-    return score[x+1][y+1];
+/** Levenshtein edit distance with a limit.
+ *
+ *  Returns the Levenshtein edit distance of the specified vectors, or @p maxDistance + 1 if the distance is greater than @p
+ *  maxDistance.  Pairs that are far apart are rejected early, which makes this much faster than computing the exact distance
+ *  when only similar vectors are of interest.  See @ref LevenshteinPattern::distance. */
+template<typename T>
+size_t
+levenshteinDistance(const std::vector<T> &src, const std::vector<T> &tgt, size_t maxDistance)
+{
+    if (tgt.size() < src.size())
+        return LevenshteinPattern<T>(tgt).distance(src, maxDistance);
+    return LevenshteinPattern<T>(src).distance(tgt, maxDistance);
 }
 
+/** Levenshtein edit distances from one vector to many.
+ *
+ *  Returns the Levenshtein edit distance from @p query to each of the @p candidates, in the same order.  The query is
+ *  preprocessed only once.  Distances greater than @p maxDistance are reported as @p maxDistance + 1. */
+template<typename T>
+std::vector<size_t>
+levenshteinDistances(const std::vector<T> &query, const std::vector<std::vector<T> > &candidates,
+                     size_t maxDistance = (size_t)(-1))
+{
+    return LevenshteinPattern<T>(query).distances(candidates, maxDistance);
+}
 
 } // namespace
 } // namespace
@@ -27,6 +27,9 @@ namespace EditDistance {
  *      bool operator==(const ListNode &other) const {
  *          return variant == other.variant;
  *      }
+ *      bool operator<(const ListNode &other) const {
+ *          return variant < other.variant;
+ *      }
  *  };
  *
  *  // Create an object that will perform the analysis
@@ -40,7 +43,8 @@ namespace LinearEditDistance {
 /** Type for comparing two AST nodes.
  *
  *  This type defines the API used by @ref Analysis and also serves as the default parameter for that class template.  It must
- *  be able to construct an edit distance list node from an AST node and test two list nodes for equality. */
+ *  be able to construct an edit distance list node from an AST node, test two list nodes for equality, and order two list nodes
+ *  that are not equal. */
 class Node {
     unsigned first_, second_;
 public:
@@ -63,6 +67,13 @@ public:
     bool operator==(const Node &other) const {
         return first_==other.first_ && second_==other.second_;
     }
+
+    /** Order two list nodes.
+     *
+     *  Any strict weak order consistent with @ref operator== will do; it's used to index the distinct list nodes. */
+    bool operator<(const Node &other) const {
+        return first_<other.first_ || (first_==other.first_ && second_<other.second_);
+    }
 };
 
 // Used internally to build a list of nodes over which edit distance is computed. The list of nodes is constructed by visiting
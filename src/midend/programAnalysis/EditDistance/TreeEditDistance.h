@@ -3,9 +3,7 @@
 
 #include "Diagnostics.h"
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/graph_traits.hpp>
-
+#include <limits>
 #include <map>
 #include <string>
 #include <vector>
@@ -88,38 +86,55 @@ public:
     virtual bool operator()(SgNode *source, SgNode *target) = 0;
 };
 
+/** A tree prepared for comparison.
+ *
+ *  Holds the pre-order list of selected nodes of an AST and their depths, which is all the analysis needs from the AST. When
+ *  one tree is compared against many others, preparing each tree once and passing the prepared trees to @ref
+ *  Analysis::compute avoids traversing the same AST over and over. */
+class Tree {
+    friend class Analysis;
+    SgNode *ast_;                                       // root of the tree
+    std::vector<SgNode*> nodes_;                        // selected nodes in pre-order, preceded by a nil node
+    std::vector<size_t> depths_;                        // depth of each of nodes_ within the tree
+public:
+    /** Construct an empty tree. */
+    Tree(): ast_(NULL) {}
+
+    /** Prepare a tree from an AST.
+     *
+     *  If @p file is non-null then only those nodes that belong to the specified file are selected. */
+    explicit Tree(SgNode *ast, SgFile *file=NULL);
+
+    /** Root of the tree. */
+    SgNode* ast() const { return ast_; }
+
+    /** Selected nodes in pre-order, preceded by a nil node. */
+    const std::vector<SgNode*>& nodes() const { return nodes_; }
+
+    /** Number of selected nodes, not counting the nil node. */
+    size_t size() const { return nodes_.empty() ? 0 : nodes_.size()-1; }
+};
+
 /** Analysis object for tree edit distance.
  *
  *  The Analysis object holds the settings and state for performing tree edit distance. See @ref TreeEditDistance for details
  *  and examples. */
 class Analysis {
-    // Graph used for computing Dijkstra's shortest path (DSP).
-    typedef boost::property<boost::edge_weight_t, double> EdgeProperty;
-    typedef boost::adjacency_list<boost::listS,         // edge representation
-                                  boost::vecS,          // vertex representation
-                                  boost::directedS,     // edges are directed
-                                  boost::no_property,   // vertex values
-                                  EdgeProperty          // edge values
-                                 > Graph;
-    typedef boost::graph_traits<Graph>::vertex_descriptor Vertex;
-    typedef std::pair<size_t, size_t> Edge;             // source and target vertex IDs
-
     double insertionCost_;                              // non-negative cost for insertion edit
     double deletionCost_;                               // non-negative cost for deletion edit
     double substitutionCost_;                           // non-negative cost for substitution edit
+    double costLimit_;                                  // stop computing once the cost is known to exceed this
 
-    SgNode *ast1_, *ast2_;                              // trees being compared
-    std::vector<SgNode*> nodes1_, nodes2_;              // list of nodes from parts of trees being compared
-    std::vector<size_t> depths1_, depths2_;             // subtree depths for nodes1_ and nodes2_
-    Graph graph_;                                       // graph connectivity and edge weights
-    std::vector<double> totalCost_;                     // total cost of minimal-cost path from origin to each vertex
-    std::vector<Vertex> predecessors_;                  // predecessor vertex for each node in minimal-cost path from origin
+    Tree tree1_, tree2_;                                // trees being compared
+    bool computed_;                                     // whether totalCost_ is valid
+    double totalCost_;                                  // cost of the minimal-cost edit path, or infinity
     SubstitutionPredicate *substitutionPredicate_;      // determines whether one node can be substituted for another
 
 public:
     /** Construct an analysis with default values. */
     Analysis()
-        : insertionCost_(1.0), deletionCost_(1.0), substitutionCost_(1.0), ast1_(NULL), ast2_(NULL),
+        : insertionCost_(1.0), deletionCost_(1.0), substitutionCost_(1.0),
+          costLimit_(std::numeric_limits<double>::infinity()), computed_(false), totalCost_(0.0),
           substitutionPredicate_(NULL)  {}
 
     /** Forget calculated results.
@@ -127,11 +142,8 @@ public:
      *  Causes the analysis to forget the trees being compared and previous results. Does not modify properties that affect the
      *  analysis operation (like the various edit costs). */
     Analysis& clear() {
-        ast1_ = ast2_ = NULL;
-        nodes1_.clear(), nodes2_.clear();
-        depths1_.clear(), depths2_.clear();
-        graph_ = Graph();
-        totalCost_.clear(), predecessors_.clear();
+        tree1_ = tree2_ = Tree();
+        computed_ = false;
         return *this;
     }
     
@@ -196,6 +208,24 @@ public:
     }
     /** @} */
 
+    /** Property: cost limit.
+     *
+     *  When a caller only needs to know whether two trees are within some distance of each other, setting this limit lets
+     *  @ref compute give up as soon as every edit path is known to cost more than the limit, which is usually long before the
+     *  whole calculation is done for dissimilar trees.  In that case @ref cost returns infinity and @ref edits returns an
+     *  empty list.  The default is infinity, which never gives up.
+     *
+     * @{ */
+    double costLimit() const {
+        return costLimit_;
+    }
+    Analysis& costLimit(double limit) {
+        ASSERT_require(limit >= 0.0);
+        costLimit_ = limit;
+        return *this;
+    }
+    /** @} */
+
     /** Compute tree edit distances.
      *
      *  Computes edit distances and stores them in this analysis.  Most of the other methods simply query the results computed
@@ -214,30 +244,43 @@ public:
      *  double diff = TreeEditDistance::Analysis().compute(t1,t2).cost();
      * @endcode
      *
-     *  There are three versions of this function:
+     *  There are four versions of this function:
      *
      * @li A version where both trees are specified.
      *
+     * @li A version where both trees are specified as prepared trees. This is useful when comparing many pairs from one set
+     *     of trees, since each AST is traversed only once.
+     *
      * @li A version where only the target tree is specified and the source tree is re-used from a previous calculation. This
      *     is useful when comparing one tree against many trees.
      *
      * @li A version that re-uses both trees from a previous calculation.  This is useful when one changes only the edit costs
      *     or other properties that might influence the result.
      *
-     *  This analysis uses Dijkstra's shortest path and takes a total of \f$O(V_s V_t)\f$ memory and
-     *  \f$O(V_s V_t log(V_s V_t) + E)\f$ where \f$V_s\f$ and \f$V_t\f$ are the number of nodes in the source and target
-     *  trees and \f$E\f$ is the number of edges representing possible insertions, deletions, and substitutions.
+     *  The edit distance is the cost of the cheapest path through a grid whose rows are the nodes of the source tree and whose
+     *  columns are the nodes of the target tree, where downward steps are deletions, rightward steps are insertions, and
+     *  diagonal steps are substitutions, each allowed only between nodes of compatible depths.  The grid is never stored: its
+     *  edges are implied by the node depths and its costs are computed one row at a time, so this function takes
+     *  \f$O(V_s V_t)\f$ time but only \f$O(V_t)\f$ memory, where \f$V_s\f$ and \f$V_t\f$ are the number of nodes in the
+     *  source and target trees. See also @ref costLimit.
      *
      * @{ */
     Analysis& compute(SgNode *source, SgNode *target, SgFile *sourceFile=NULL, SgFile *targetFile=NULL);
+    Analysis& compute(const Tree &source, const Tree &target);
     Analysis& compute(SgNode *target, SgFile *targetFile=NULL);
     Analysis& compute();
     /** @} */
 
+    /** Costs of editing one tree into each of many others.
+     *
+     *  Computes the edit distance from @p source to each of the @p targets in turn, subject to the @ref costLimit, and returns
+     *  their costs in the same order.  Afterward this analysis holds the results for the last target. */
+    std::vector<double> costs(const Tree &source, const std::vector<Tree> &targets);
+
     /** Total cost for making one tree the same shape as the other.
      *
      *  This is the same value returned by the previous call to @ref compute and also available by querying for the actual list
-     *  of edits and summing their costs. */
+     *  of edits and summing their costs. It is infinity if the cost exceeded the @ref costLimit. */
     double cost() const;
 
     /** Relative cost.
@@ -246,29 +289,32 @@ public:
      *  total edit cost by the number of selected nodes in the larger tree. */
     double relativeCost() const;
 
-    /** Edit operations to make one path look like another. */
+    /** Edit operations to make one path look like another.
+     *
+     *  The edits are recovered by divide and conquer, recomputing costs of halves of the grid rather than storing it, so this
+     *  takes about twice the time of @ref compute and still only linear memory. */
     Edits edits() const;
 
     /** The two trees that were compared. */
     std::pair<SgNode*, SgNode*> trees() const {
-        return std::make_pair(ast1_, ast2_);
+        return std::make_pair(tree1_.ast_, tree2_.ast_);
     }
 
     /** List of nodes in the trees.
      *
      * @{ */
     const std::vector<SgNode*>& sourceTreeNodes() const {
-        return nodes1_;
+        return tree1_.nodes_;
     }
     const std::vector<SgNode*>& targetTreeNodes() const {
-        return nodes2_;
+        return tree2_.nodes_;
     }
     /** @} */
 
     /** Number of vertices and edges in the graph.
      *
-     *  The graph is used to compute Dijkstra's shortest path and minimize the cost of the edits.  This function returns the
-     *  number of vertices and edges in the graph. */
+     *  The graph is the grid of possible edits over which the cost of the edits is minimized.  It is not stored, so this
+     *  function counts its vertices and edges, in time proportional to their number. */
     std::pair<size_t, size_t> graphSize() const;
 
     /** Emit a GraphViz file.
@@ -291,7 +337,29 @@ public:
      * @{ */
     Analysis& setTree1(SgNode *ast, SgFile *file=NULL);
     Analysis& setTree2(SgNode *ast, SgFile *file=NULL);
+    Analysis& setTree1(const Tree&);
+    Analysis& setTree2(const Tree&);
     /** @} */
+
+private:
+    // Whether the grid has a deletion, insertion, or substitution edge leaving vertex (i,j).
+    bool canDelete(size_t i, size_t j) const;
+    bool canInsert(size_t i, size_t j) const;
+    bool canSubstitute(size_t i, size_t j) const;
+
+    // Costs from vertex (i0,j0) to each vertex (iEnd,j) for j0 <= j <= j1. Returns false, leaving the costs incomplete, as
+    // soon as every vertex of a row costs more than the limit.
+    bool forwardCosts(size_t i0, size_t j0, size_t iEnd, size_t j1, std::vector<double> &row /*out*/,
+                      double limit = std::numeric_limits<double>::infinity()) const;
+
+    // Costs from each vertex (iStart,j) for j0 <= j <= j1 to vertex (i1,j1).
+    void backwardCosts(size_t iStart, size_t j0, size_t i1, size_t j1, std::vector<double> &row /*out*/) const;
+
+    // Appends to path the vertices after (i0,j0) through (i1,j1) of a minimal-cost path between them.
+    void appendPath(size_t i0, size_t j0, size_t i1, size_t j1, std::vector<std::pair<size_t, size_t> > &path) const;
+
+    // Vertices of a minimal-cost path from the origin to the last vertex, or empty if there is none.
+    std::vector<std::pair<size_t, size_t> > path() const;
 };
 
 std::ostream& operator<<(std::ostream&, const TreeEditDistance::Edit&);
@@ -26,6 +26,12 @@ protected:
     ClassHierarchyWrapper *classHierarchy;
     
     CallGraphBuilder *cgBuilder;
+
+    //! Solve with the SCC-ordered worklist instead of iterating over all functions
+    bool useWorklist;
+
+    //! Input signature of each function the last time its IntraProcAliasAnalysis ran
+    boost::unordered_map<SgFunctionDeclaration *, unsigned long> signatures;
 public:
     //! Enum used for Topological sorting
     enum COLOR {WHITE=0, GREY, BLACK};
@@ -40,7 +46,29 @@ public:
     //! Execute IntraProc Analysis and check whether something changed
     bool runAndCheckIntraProcAnalysis(SgFunctionDeclaration *);
 
+    //! Choose between the worklist solver (the default) and InterProcDataFlowAnalysis::run, which reruns every
+    //! function until none changes. Both reach the same fixed point.
+    void setUseWorklist(bool b) { useWorklist = b; }
+    bool getUseWorklist() const { return useWorklist; }
+
 private:
+    //! Solve the alias relations with a worklist ordered by the strongly connected components of the call graph,
+    //! callees first. A function is rerun only when its entry or the exit of one of its callees changed.
+    void solveWorklist();
+
+    //! Number the functions reachable from main so that each SCC of the call graph is contiguous and comes after the
+    //! SCCs it calls
+    void computeSccOrder(std::vector<SgFunctionDeclaration*> &order,
+                boost::unordered_map<SgFunctionDeclaration*, size_t> &position);
+
+    //! Hash of what the analysis of a function depends on: its entry and the exits of its callees
+    unsigned long inputSignature(SgFunctionDeclaration *funcDecl);
+
+    //! Hash of the entry or exit of a function, or zero if it has none yet
+    unsigned long entryHash(SgFunctionDeclaration *funcDecl);
+    unsigned long exitHash(SgFunctionDeclaration *funcDecl);
+
+
     void SortCallGraphRecursive(SgFunctionDeclaration* targetFunction, SgIncidenceDirectedGraph* callGraph,
                 boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*> &graphNodeToFunction, boost::unordered_map<SgGraphNode*, 
                 PtrAliasAnalysis::COLOR> &colors, std::vector<SgFunctionDeclaration*> &processingOrder, 
@@ -33,6 +33,16 @@ int DefUseAnalysis::getIntForSgNode(SgNode* sgNode) {
   return -1;
 }
 
+/**********************************************************
+ * Return the bit-vector table that replaces a table,
+ * or NULL if the tables are not bit vectors
+ *********************************************************/
+DefUseBitTable* DefUseAnalysis::bitTableFor(const tabletype* tabl) {
+  if (!bitVectorTables)
+    return NULL;
+  return tabl == &table ? &defBits : &useBits;
+}
+
 /**********************************************************
  *  Add helping ID to each node for vizz purpose
  *********************************************************/
@@ -91,7 +101,10 @@ void DefUseAnalysis::addAnyElement(tabletype* tabl, SgNode* sgNode,
 #pragma omp critical (DefUseAnalysisaddUseE) 
 #endif
   //  (*tabl)[sgNode].insert(make_pair(initName, defNode));
-  (*tabl)[sgNode].push_back(make_pair(initName, defNode));
+  if (DefUseBitTable* bits = bitTableFor(tabl))
+    bits->add(sgNode, initName, defNode);
+  else
+    (*tabl)[sgNode].push_back(make_pair(initName, defNode));
    addID(sgNode);
 }
 
@@ -113,7 +126,10 @@ void DefUseAnalysis::replaceElement(SgNode* sgNode,
 #if ROSE_GCC_OMP
 #pragma omp critical (DefUseAnalysisreplaceE1) 
 #endif
-  {
+  if (bitVectorTables) {
+    defBits.remove(sgNode, initName);
+    defBits.add(sgNode, initName, sgNode);
+  } else {
     //table[sgNode].erase(initName);
     //    table[sgNode].insert(make_pair(initName,sgNode));
 
@@ -133,7 +149,9 @@ void DefUseAnalysis::clearUseOfElement(SgNode* sgNode,
 #if ROSE_GCC_OMP
 #pragma omp critical (DefUseAnalysisclearUse) 
 #endif
-  {
+  if (bitVectorTables) {
+    useBits.remove(sgNode, initName);
+  } else {
   //  usetable[sgNode].erase(initName);
 
     multitype& map = usetable[sgNode];
@@ -160,6 +178,14 @@ void DefUseAnalysis::mapUseUnion(SgNode* before, SgNode* other, SgNode* sgNode)
  *  Union of two maps
  *********************************************************/
 void DefUseAnalysis::mapAnyUnion(tabletype* tabl, SgNode* before, SgNode* other, SgNode* sgNode) {
+  if (DefUseBitTable* bits = bitTableFor(tabl)) {
+    addID(sgNode);
+#if ROSE_GCC_OMP
+#pragma omp critical (DefUseAnalysismapUse)
+#endif
+    bits->unite(sgNode, before, other);
+    return;
+  }
   
   bool beforeFound = true;
   if ((*tabl).find(before)==(*tabl).end())
@@ -263,6 +289,11 @@ void DefUseAnalysis::printUseMap() {
 void DefUseAnalysis::printAnyMap(tabletype* tabl) {
   int pos = 0;
   cout << "\n **************** MAP ************************** " << endl;
+  tabletype decoded;
+  if (DefUseBitTable* bits = bitTableFor(tabl)) {
+    decoded = bits->toMap();
+    tabl = &decoded;
+  }
   for (tabletype::const_iterator i = tabl->begin(); i != tabl->end(); ++i) {  
     pos++;
     SgNode* sgNode = (*i).first;
@@ -279,6 +310,8 @@ void DefUseAnalysis::printAnyMap(tabletype* tabl) {
  *  Return the size of the table
  *********************************************************/
 int DefUseAnalysis::getDefSize() {
+  if (bitVectorTables)
+    return defBits.size();
   return table.size();
 }
 
@@ -286,6 +319,8 @@ int DefUseAnalysis::getDefSize() {
  *  Return the size of the table
  *********************************************************/
 int DefUseAnalysis::getUseSize() {
+  if (bitVectorTables)
+    return useBits.size();
   return usetable.size();
 }
 
@@ -331,6 +366,8 @@ bool DefUseAnalysis::searchVizzMap(SgNode* node) {
 bool DefUseAnalysis::searchMap(const tabletype* ltable, SgNode* node) {
   bool isCurrentValueContained=false;
   //  std::cerr << " size map : " << ltable->size() << std::endl;
+  if (DefUseBitTable* bits = bitTableFor(ltable))
+    return bits->contains(node);
 #if 0   
   if (ltable->size()>0) {
     tabletype::const_iterator i = ltable->begin();
@@ -358,6 +395,8 @@ bool DefUseAnalysis::searchMap(const tabletype* ltable, SgNode* node) {
  * for any given node and initName, return all definitions 
  *****************************************/
 std::vector < SgNode* > DefUseAnalysis::getDefFor(SgNode* node, SgInitializedName* initName) {
+  if (bitVectorTables)
+    return defBits.get(node, initName);
   multitype multi = getDefMultiMapFor(node);
   return getAnyFor( &multi, initName); 
 }
@@ -367,6 +406,8 @@ std::vector < SgNode* > DefUseAnalysis::getDefFor(SgNode* node, SgInitializedNam
  * for any given node and initName, return all definitions 
  *****************************************/
 std::vector < SgNode* > DefUseAnalysis::getUseFor(SgNode* node, SgInitializedName* initName) {
+  if (bitVectorTables)
+    return useBits.get(node, initName);
   multitype multi = getUseMultiMapFor(node);
   return getAnyFor(&multi, initName); 
 }
@@ -399,6 +440,8 @@ std::vector < SgNode* > DefUseAnalysis::getAnyFor(const multitype* multi, SgInit
  *****************************************/
 std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getDefMultiMapFor(SgNode* node) {
   multitype multi;
+  if (bitVectorTables)
+    return defBits.get(node);
   if (searchMap(&table, node)==true) {
     // multimap is contained
     multi = table[node];
@@ -412,6 +455,8 @@ std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getDefM
  *****************************************/
 std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getUseMultiMapFor(SgNode* node) {
   multitype multi;
+  if (bitVectorTables)
+    return useBits.get(node);
   if (searchMap(&usetable, node)==true) {
     // multimap is contained
     multi = usetable[node];
@@ -533,6 +578,7 @@ int DefUseAnalysis::run() {
   ROSE_ASSERT(project != NULL);
 
   table.clear();
+  defBits.clear();
   vizzhelp.clear();
 
   clock_t start = clock();
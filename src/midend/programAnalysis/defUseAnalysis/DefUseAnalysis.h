@@ -12,6 +12,7 @@
 #include "DFAnalysis.h"
 #include "support.h"
 #include "DFAFilter.h"
+#include "DefUseBitTable.h"
 
 #include <iostream>
 
@@ -90,6 +91,11 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   // the main table of all entries
   tabletype table;
   tabletype usetable;
+  // the same tables as bit vectors, used instead if bitVectorTables is set
+  bool bitVectorTables;
+  DefUseBitTable defBits;
+  DefUseBitTable useBits;
+  DefUseBitTable* bitTableFor(const tabletype* tabl);
   // table for indirect definitions
   //ideftype idefTable;
   // the helper table for visualization
@@ -107,7 +113,7 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
 
  public:
   DefUseAnalysis(SgProject* proj): project(proj), 
-    DEBUG_MODE(false), DEBUG_MODE_EXTRA(false){
+    DEBUG_MODE(false), DEBUG_MODE_EXTRA(false), bitVectorTables(false){
     //visualizationEnabled=true;
     //table.clear();
     //usetable.clear();
@@ -117,12 +123,24 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   };
   virtual ~DefUseAnalysis() {}
 
-  std::map< SgNode* , multitype  > getDefMap() { return table;}
-  std::map< SgNode* , multitype  > getUseMap() { return usetable;}
+  std::map< SgNode* , multitype  > getDefMap() { return bitVectorTables ? defBits.toMap() : table;}
+  std::map< SgNode* , multitype  > getUseMap() { return bitVectorTables ? useBits.toMap() : usetable;}
   void setMaps(std::map< SgNode* , multitype  > def,
           std::map< SgNode* , multitype > use) {
-    table = def;
-    usetable = use;
+    if (bitVectorTables) {
+      defBits.fromMap(def);
+      useBits.fromMap(use);
+    } else {
+      table = def;
+      usetable = use;
+    }
+  }
+
+  // Store the def and use tables as bit vectors over numbered definitions (see DefUseBitTable) instead of
+  // a vector of pairs per node. This uses much less memory for large functions, and the sets are decoded
+  // only when queried. Must be called before run().
+  void enableBitVectorTables() {
+    bitVectorTables=true;
   }
        
   // def-use-public-functions -----------
@@ -163,6 +181,8 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   void flush() {
    table.clear();
    usetable.clear();
+   defBits.clear();
+   useBits.clear();
    globalVarList.clear();
    vizzhelp.clear();
    sgNodeCounter=1;
@@ -181,6 +201,8 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   void flushDefuse() {
    table.clear();
    usetable.clear();
+   defBits.clear();
+   useBits.clear();
    //   vizzhelp.clear();
    //sgNodeCounter=1;
   }
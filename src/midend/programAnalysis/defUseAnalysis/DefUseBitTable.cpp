@@ -0,0 +1,187 @@
+/******************************************
+ * Category: DFA
+ * Bit-vector table for the DefUse Analysis
+ *****************************************/
+
+#include "sage3basic.h"
+#include "DefUseBitTable.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+  // Orders words by word number, for binary searches
+  struct WordLess {
+    template <class W>
+    bool operator()(const W& w, size_t index) const { return w.index < index; }
+  };
+}
+
+/**********************************************************
+ *  Remove everything
+ *********************************************************/
+void DefUseBitTable::clear() {
+  defs.clear();
+  defNumbers.clear();
+  defsOfVar.clear();
+  nodes.clear();
+}
+
+/**********************************************************
+ *  Return the number of a definition, numbering it if new
+ *********************************************************/
+size_t DefUseBitTable::number(SgInitializedName* initName, SgNode* defNode) {
+  std::pair<SgInitializedName*, SgNode*> def(initName, defNode);
+  boost::unordered_map<std::pair<SgInitializedName*, SgNode*>, size_t>::iterator i = defNumbers.find(def);
+  if (i != defNumbers.end())
+    return i->second;
+  size_t n = defs.size();
+  defs.push_back(def);
+  defNumbers.insert(make_pair(def, n));
+  defsOfVar[initName].push_back(n);
+  return n;
+}
+
+/**********************************************************
+ *  Set one bit of a sparse bit vector
+ *********************************************************/
+void DefUseBitTable::setBit(Bits& bits, size_t n) {
+  size_t index = n / 64;
+  uint64_t mask = (uint64_t)1 << (n % 64);
+  Bits::iterator w = std::lower_bound(bits.begin(), bits.end(), index, WordLess());
+  if (w != bits.end() && w->index == index)
+    w->bits |= mask;
+  else
+    bits.insert(w, Word(index, mask));
+}
+
+/**********************************************************
+ *  Union of two sparse bit vectors
+ *********************************************************/
+void DefUseBitTable::merge(const Bits& a, const Bits& b, Bits& result) {
+  result.clear();
+  result.reserve(std::max(a.size(), b.size()));
+  Bits::const_iterator i = a.begin(), j = b.begin();
+  while (i != a.end() && j != b.end()) {
+    if (i->index < j->index) {
+      result.push_back(*i++);
+    } else if (j->index < i->index) {
+      result.push_back(*j++);
+    } else {
+      result.push_back(Word(i->index, i->bits | j->bits));
+      ++i;
+      ++j;
+    }
+  }
+  result.insert(result.end(), i, a.end());
+  result.insert(result.end(), j, b.end());
+}
+
+/**********************************************************
+ *  Add a definition to a node
+ *********************************************************/
+void DefUseBitTable::add(SgNode* node, SgInitializedName* initName, SgNode* defNode) {
+  size_t n = number(initName, defNode);
+  setBit(nodes[node], n);
+}
+
+/**********************************************************
+ *  Remove all definitions of a variable from a node
+ *********************************************************/
+void DefUseBitTable::remove(SgNode* node, SgInitializedName* initName) {
+  Bits& bits = nodes[node];
+  boost::unordered_map<SgInitializedName*, std::vector<size_t> >::const_iterator var = defsOfVar.find(initName);
+  if (bits.empty() || var == defsOfVar.end())
+    return;
+  for (std::vector<size_t>::const_iterator n = var->second.begin(); n != var->second.end(); ++n) {
+    Bits::iterator w = std::lower_bound(bits.begin(), bits.end(), *n / 64, WordLess());
+    if (w != bits.end() && w->index == *n / 64)
+      w->bits &= ~((uint64_t)1 << (*n % 64));
+  }
+  Bits::iterator last = bits.begin();
+  for (Bits::iterator w = bits.begin(); w != bits.end(); ++w) {
+    if (w->bits != 0)
+      *last++ = *w;
+  }
+  bits.erase(last, bits.end());
+}
+
+/**********************************************************
+ *  Union of the sets at two nodes
+ *********************************************************/
+void DefUseBitTable::unite(SgNode* node, SgNode* before, SgNode* other) {
+  boost::unordered_map<SgNode*, Bits>::const_iterator b = nodes.find(before);
+  boost::unordered_map<SgNode*, Bits>::const_iterator o = nodes.find(other);
+  Bits result;
+  if (b != nodes.end() && o != nodes.end())
+    merge(b->second, o->second, result);
+  else if (b != nodes.end())
+    result = b->second;
+  else if (o != nodes.end())
+    result = o->second;
+  nodes[node].swap(result);
+}
+
+/**********************************************************
+ *  Decode the set at a node
+ *********************************************************/
+DefUseBitTable::multitype DefUseBitTable::get(SgNode* node) const {
+  multitype multi;
+  boost::unordered_map<SgNode*, Bits>::const_iterator i = nodes.find(node);
+  if (i == nodes.end())
+    return multi;
+  for (Bits::const_iterator w = i->second.begin(); w != i->second.end(); ++w) {
+    for (size_t bit = 0; bit < 64; ++bit) {
+      if (w->bits & ((uint64_t)1 << bit))
+        multi.push_back(defs[64 * w->index + bit]);
+    }
+  }
+  return multi;
+}
+
+/**********************************************************
+ *  Definition nodes of one variable at a node
+ *********************************************************/
+std::vector<SgNode*> DefUseBitTable::get(SgNode* node, SgInitializedName* initName) const {
+  std::vector<SgNode*> defNodes;
+  boost::unordered_map<SgNode*, Bits>::const_iterator i = nodes.find(node);
+  boost::unordered_map<SgInitializedName*, std::vector<size_t> >::const_iterator var = defsOfVar.find(initName);
+  if (i == nodes.end() || var == defsOfVar.end())
+    return defNodes;
+  const Bits& bits = i->second;
+  for (std::vector<size_t>::const_iterator n = var->second.begin(); n != var->second.end(); ++n) {
+    Bits::const_iterator w = std::lower_bound(bits.begin(), bits.end(), *n / 64, WordLess());
+    if (w != bits.end() && w->index == *n / 64 && (w->bits & ((uint64_t)1 << (*n % 64))))
+      defNodes.push_back(defs[*n].second);
+  }
+  return defNodes;
+}
+
+/**********************************************************
+ *  Replace the set at a node
+ *********************************************************/
+void DefUseBitTable::set(SgNode* node, const multitype& multi) {
+  Bits& bits = nodes[node];
+  bits.clear();
+  for (multitype::const_iterator i = multi.begin(); i != multi.end(); ++i)
+    setBit(bits, number(i->first, i->second));
+}
+
+/**********************************************************
+ *  Decode all sets
+ *********************************************************/
+std::map<SgNode*, DefUseBitTable::multitype> DefUseBitTable::toMap() const {
+  std::map<SgNode*, multitype> map;
+  for (boost::unordered_map<SgNode*, Bits>::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+    map[i->first] = get(i->first);
+  return map;
+}
+
+/**********************************************************
+ *  Replace all sets
+ *********************************************************/
+void DefUseBitTable::fromMap(const std::map<SgNode*, multitype>& map) {
+  nodes.clear();
+  for (std::map<SgNode*, multitype>::const_iterator i = map.begin(); i != map.end(); ++i)
+    set(i->first, i->second);
+}
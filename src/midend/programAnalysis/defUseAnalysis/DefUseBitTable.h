@@ -0,0 +1,82 @@
+/******************************************
+ * Category: DFA
+ * Bit-vector table for the DefUse Analysis
+ *****************************************/
+
+#ifndef __DefUseBitTable_HXX_LOADED__
+#define __DefUseBitTable_HXX_LOADED__
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+#include <boost/unordered_map.hpp>
+
+class SgNode;
+class SgInitializedName;
+
+/** Definitions (or uses) reaching each node, stored as bit vectors.
+ *
+ *  Each (variable, definition node) pair gets a number the first time it's added, and the set at each node is a bit
+ *  vector over those numbers.  The pairs are numbered in the order in which the functions are analyzed, so the numbers
+ *  of one function's definitions are close together.  The vectors are stored sparsely as sorted lists of non-zero
+ *  64-bit words, so a node only pays for the words its definitions fall in and the union of two sets is a merge that
+ *  ORs whole words at a time.  Sets are decoded into (variable, definition) pairs only when they're queried. */
+class DefUseBitTable {
+ public:
+  typedef std::vector < std::pair<SgInitializedName* , SgNode*> > multitype;
+
+  /** Whether the node has an entry, which may be empty. */
+  bool contains(SgNode* node) const { return nodes.find(node) != nodes.end(); }
+
+  /** Number of nodes with entries. */
+  size_t size() const { return nodes.size(); }
+
+  /** Remove all entries and definition numbers. */
+  void clear();
+
+  /** Add the pair (initName, defNode) to the set at the node. */
+  void add(SgNode* node, SgInitializedName* initName, SgNode* defNode);
+
+  /** Remove all pairs for the variable from the set at the node. The node gets an entry even if it had none. */
+  void remove(SgNode* node, SgInitializedName* initName);
+
+  /** Make the set at the node the union of the sets at before and other.  A missing entry is treated as the empty
+   *  set, and either may be the node itself. */
+  void unite(SgNode* node, SgNode* before, SgNode* other);
+
+  /** The pairs at the node ordered by definition number, or nothing if the node has no entry. */
+  multitype get(SgNode* node) const;
+
+  /** The definition nodes of one variable at the node. */
+  std::vector<SgNode*> get(SgNode* node, SgInitializedName* initName) const;
+
+  /** Replace the set at the node. */
+  void set(SgNode* node, const multitype& multi);
+
+  /** All entries decoded into pairs. */
+  std::map<SgNode*, multitype> toMap() const;
+
+  /** Replace all entries. */
+  void fromMap(const std::map<SgNode*, multitype>& map);
+
+ private:
+  struct Word {
+    size_t index;                                 // word number; holds definition numbers 64*index through 64*index+63
+    uint64_t bits;                                // never zero
+    Word(size_t index, uint64_t bits): index(index), bits(bits) {}
+  };
+  typedef std::vector<Word> Bits;                 // sorted by word number
+
+  size_t number(SgInitializedName* initName, SgNode* defNode);
+  static void setBit(Bits& bits, size_t n);
+  static void merge(const Bits& a, const Bits& b, Bits& result);
+
+  multitype defs;                                 // (variable, definition) pair for each definition number
+  boost::unordered_map<std::pair<SgInitializedName*, SgNode*>, size_t> defNumbers;
+  boost::unordered_map<SgInitializedName*, std::vector<size_t> > defsOfVar;
+  boost::unordered_map<SgNode*, Bits> nodes;
+};
+
+#endif
@@ -44,6 +44,12 @@ public:
   void computeFunctionIndicesPerNode(SgNode *root, std::vector<int>& functionToProcessor,  
                                      InheritedAttributeType rootInheritedValue,
                                      AstTopDownProcessing<InheritedAttributeType> *preTraversal);
+  // Runs the pre-traversal like computeFunctionIndices, but instead of splitting the functions returns their indices
+  // ordered by decreasing estimated cost (node count times weight, as in sortFunctions). funcDecls and
+  // initialInheritedValues stay in traversal order.
+  std::vector<size_t> computeFunctionOrder(SgNode *root,
+                                           InheritedAttributeType rootInheritedValue,
+                                           AstTopDownProcessing<InheritedAttributeType> *preTraversal);
   void sortFunctions(std::vector<SgFunctionDeclaration*>& funcDecls, std::vector<InheritedAttributeType>& inhertiedValues,
                      std::vector<size_t>& nodeCounts, std::vector<size_t>& funcWeights);
   
@@ -63,9 +69,19 @@ public:
                          AstTopDownProcessing<InheritedAttributeType> *preTraversal,
                          AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal);
     SynthesizedAttributeType getFinalResults() {return finalResults;}
-    DistributedMemoryTraversal() {}
+    DistributedMemoryTraversal(): scheduling(STATIC_SCHEDULING) {}
     virtual ~DistributedMemoryTraversal() {}
 
+    // How functions are assigned to processes. With static scheduling (the default) the functions are split into
+    // contiguous ranges of about the same number of nodes before the analysis starts. With dynamic scheduling the root
+    // process hands out one function at a time to each process that becomes idle, most expensive first according to the
+    // pre-traversal's estimates, and collects the results as they arrive; between messages the root analyzes the
+    // cheapest remaining functions itself. Dynamic scheduling needs at least two processes and otherwise falls back to
+    // static scheduling.
+    enum Scheduling { STATIC_SCHEDULING, DYNAMIC_SCHEDULING };
+    void setScheduling(Scheduling s) { scheduling = s; }
+    Scheduling getScheduling() const { return scheduling; }
+
 protected:
     virtual SynthesizedAttributeType analyzeSubtree(SgFunctionDeclaration *funcDecl,
                                                     InheritedAttributeType initialInheritedValue) = 0;
@@ -76,6 +92,13 @@ protected:
 private:
     SynthesizedAttributeType finalResults;
     std::vector<SynthesizedAttributeType> functionResults;
+    Scheduling scheduling;
+
+    // message tags used by dynamic scheduling
+    enum { TASK_TAG = 1, RESULT_TAG = 2, STOP_TAG = 3 };
+    void performDynamicAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
+                                AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                                AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal);
 
     DistributedMemoryTraversal(const DistributedMemoryTraversal &);
     const DistributedMemoryTraversal &operator=(const DistributedMemoryTraversal &);
@@ -197,6 +197,50 @@ sortFunctions(std::vector<SgFunctionDeclaration*>& funcDecls, std::vector<Inheri
 
 
 
+template <class InheritedAttributeType>
+std::vector<size_t>
+DistributedMemoryAnalysisBase<InheritedAttributeType>::
+computeFunctionOrder(
+        SgNode *root,
+        InheritedAttributeType rootInheritedValue,
+        AstTopDownProcessing<InheritedAttributeType> *preTraversal)
+{
+    DistributedMemoryAnalysisPreTraversal<InheritedAttributeType> nodeCounter(preTraversal);
+    nodeCounter.traverse(root, rootInheritedValue);
+
+    funcDecls = nodeCounter.get_funcDecls();
+    initialInheritedValues = nodeCounter.get_initialInheritedValues();
+    myNodeCounts = nodeCounter.get_nodeCounts();
+    myFuncWeights = nodeCounter.get_funcWeights();
+    ROSE_ASSERT(funcDecls.size() == initialInheritedValues.size());
+    ROSE_ASSERT(funcDecls.size() == myNodeCounts.size());
+    ROSE_ASSERT(funcDecls.size() == myFuncWeights.size());
+
+    size_t totalNodes = 0;
+    double totalWeight = 0;
+    std::vector<std::pair<double, size_t> > weights(funcDecls.size());
+    for (size_t i = 0; i < funcDecls.size(); i++) {
+        weights[i].first = ((double)myNodeCounts[i]*myFuncWeights[i])/(double)funcDecls.size()/100;
+        weights[i].second = i;
+        totalNodes += myNodeCounts[i];
+        totalWeight += weights[i].first;
+    }
+    std::stable_sort(weights.begin(), weights.end(), SortDescending());
+
+    if (myID() == 0)
+    {
+        nrOfNodes = totalNodes;
+        std::cout << "ROOT - scheduling functions: " << funcDecls.size() << ", total nodes: " << totalNodes
+                  << "   totalWeight: " << totalWeight << std::endl;
+    }
+
+    std::vector<size_t> order(weights.size());
+    for (size_t i = 0; i < weights.size(); i++)
+        order[i] = weights[i].second;
+    return order;
+}
+
+
 // --------------------------------------------------------------------------
 // class DistributedMemoryAnalysisBase -- version by tps (based on computation weight -- dynamic algorithm)
 // --------------------------------------------------------------------------
@@ -315,6 +359,12 @@ performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
                 AstTopDownProcessing<InheritedAttributeType> *preTraversal,
                 AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal)
 {
+    if (scheduling == DYNAMIC_SCHEDULING && DistributedMemoryAnalysisBase<InheritedAttributeType>::numberOfProcesses() > 1)
+    {
+        performDynamicAnalysis(root, rootInheritedValue, preTraversal, postTraversal);
+        return;
+    }
+
 #if DIS_DEBUG_OUTPUT
       std::cout << " >>> >>>>>>>>>>>>> start computeFunctionIndeces" << std::endl;
 #endif
@@ -513,6 +563,117 @@ performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
 
 
 
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+DistributedMemoryTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+performDynamicAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
+                       AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                       AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal)
+{
+    /* every process runs the pre-traversal, so that all of them number the functions the same way */
+    std::vector<size_t> order = this->computeFunctionOrder(root, rootInheritedValue, preTraversal);
+    const std::vector<SgFunctionDeclaration *> &funcDecls =
+        DistributedMemoryAnalysisBase<InheritedAttributeType>::funcDecls;
+    const std::vector<InheritedAttributeType> &initialInheritedValues =
+        DistributedMemoryAnalysisBase<InheritedAttributeType>::initialInheritedValues;
+    const int processes = DistributedMemoryAnalysisBase<InheritedAttributeType>::numberOfProcesses();
+
+    if (DistributedMemoryAnalysisBase<InheritedAttributeType>::myID() != 0)
+    {
+        /* worker: analyze the functions the root sends until it says stop; each result message is the function
+         * index followed by the serialized attribute */
+        while (true)
+        {
+            int index;
+            MPI_Status status;
+            MPI_Recv(&index, 1, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+            if (status.MPI_TAG == STOP_TAG)
+                break;
+            SynthesizedAttributeType result = analyzeSubtree(funcDecls[index], initialInheritedValues[index]);
+            std::pair<int, void *> serialized = serializeAttribute(result);
+            std::vector<unsigned char> message(sizeof(int) + serialized.first);
+            std::memcpy(&message[0], &index, sizeof(int));
+            if (serialized.first > 0)
+                std::memcpy(&message[sizeof(int)], serialized.second, serialized.first);
+            deleteSerializedAttribute(serialized);
+            MPI_Send(&message[0], message.size(), MPI_UNSIGNED_CHAR, 0, RESULT_TAG, MPI_COMM_WORLD);
+        }
+        return;
+    }
+
+    /* root: workers take the most expensive functions from the front of the order, the root itself takes the cheapest
+     * ones from the back whenever no result is waiting */
+    functionResults.clear();
+    functionResults.resize(funcDecls.size());
+    std::vector<unsigned char *> buffers;               // received results, kept until the post traversal is done
+    size_t head = 0, tail = order.size();
+    int busy = 0;
+    for (int rank = 1; rank < processes; rank++)
+    {
+        if (head < tail)
+        {
+            int index = order[head++];
+            MPI_Send(&index, 1, MPI_INT, rank, TASK_TAG, MPI_COMM_WORLD);
+            busy++;
+        }
+        else
+        {
+            int none = -1;
+            MPI_Send(&none, 1, MPI_INT, rank, STOP_TAG, MPI_COMM_WORLD);
+        }
+    }
+    while (busy > 0 || head < tail)
+    {
+        MPI_Status status;
+        int arrived = 0;
+        if (head < tail)
+            MPI_Iprobe(MPI_ANY_SOURCE, RESULT_TAG, MPI_COMM_WORLD, &arrived, &status);
+        if (!arrived && head < tail)
+        {
+            size_t index = order[--tail];
+            functionResults[index] = analyzeSubtree(funcDecls[index], initialInheritedValues[index]);
+            continue;
+        }
+        if (!arrived)
+            MPI_Probe(MPI_ANY_SOURCE, RESULT_TAG, MPI_COMM_WORLD, &status);
+
+        int size;
+        MPI_Get_count(&status, MPI_UNSIGNED_CHAR, &size);
+        unsigned char *buffer = new unsigned char[size];
+        MPI_Recv(buffer, size, MPI_UNSIGNED_CHAR, status.MPI_SOURCE, RESULT_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        buffers.push_back(buffer);
+        busy--;
+
+        /* hand the worker its next function before unpacking, so it doesn't wait for us */
+        if (head < tail)
+        {
+            int next = order[head++];
+            MPI_Send(&next, 1, MPI_INT, status.MPI_SOURCE, TASK_TAG, MPI_COMM_WORLD);
+            busy++;
+        }
+        else
+        {
+            int none = -1;
+            MPI_Send(&none, 1, MPI_INT, status.MPI_SOURCE, STOP_TAG, MPI_COMM_WORLD);
+        }
+
+        int index;
+        std::memcpy(&index, buffer, sizeof(int));
+        functionResults[index] = deserializeAttribute(std::make_pair(size - (int)sizeof(int), (void *)(buffer + sizeof(int))));
+    }
+
+    /* perform the post traversal */
+    DistributedMemoryAnalysisPostTraversal<SynthesizedAttributeType> postT(postTraversal, functionResults);
+    finalResults = postT.traverse(root, false);
+
+    for (size_t i = 0; i < buffers.size(); i++)
+        delete[] buffers[i];
+}
+
+
+
+
+
 // --------------------------------------------------------------------------
 // class DistributedMemoryAnalysisPreTraversal
 // --------------------------------------------------------------------------
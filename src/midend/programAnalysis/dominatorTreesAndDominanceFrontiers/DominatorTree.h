@@ -2,6 +2,7 @@
 #define _DOMINATORTREE_H_
 
 #include "ControlFlowGraph.h"
+#include <GraphDominance.h>
 #include <GraphDotOutput.h>
 #include <map>
 
@@ -68,6 +69,12 @@ public:
   int getDom(ControlNode * node) {return doms[node->getID(_iddir)];}
   //! for a given node id, return the id of its immediate dominator
   int getDom(int id) {return doms[id];}
+
+  /*! returns the CFG as adjacency lists indexed by node id, with edges
+    following the direction of the tree (successors for a dominator
+    tree, predecessors for a post-dominator tree)
+  */
+  const rose::GraphUtility::Adjacency & getFlowGraph() {return _flow;}
                                           
   void printCFG();
   void printDominators();
@@ -78,11 +85,9 @@ private:
   void _buildCFG(SgNode * head);
   void _setupStructures();
 
+  //! builds _flow and computes the immediate dominators with
+  //! rose::GraphUtility::immediateDominators (semi-NCA)
   void _findDominators();
-  int _intersect(int f1, int f2);
-  //! performs the next iteration of finding i-dom for a given node,
-  //! returns whether the i-dom changed from the previous iteration.
-  bool _processNode(int i);
 
   //! The control flow graph the dominator tree is built from
   ControlFlowGraph * _cfg;
@@ -99,6 +104,9 @@ private:
 
   int _size;
 
+  //! The CFG edges in the direction of _dir, indexed by node id
+  rose::GraphUtility::Adjacency _flow;
+
   //! Holds the immediate dominator for each ControlNode (indexed using CFG indices)
   int * doms;
 
@@ -208,12 +208,29 @@ class IntraUniDirectionalDataflow : public IntraUnitDataflow
 {
         public:
 
+        IntraUniDirectionalDataflow(): sparseWorklist(false)
+        {}
+
         // Runs the intra-procedural analysis on the given function and returns true if
         // the function's NodeState gets modified as a result and false otherwise
         // state - the function's NodeState
         bool runAnalysis(const Function& func, NodeState* state, bool analyzeDueToCallers, std::set<Function> calleesUpdated);
 
+        // Selects the worklist used by runAnalysis. By default, every node downstream from the initial worklist is
+        // visited each time a function is analyzed. If sparse=true, the nodes are visited in reverse postorder of the
+        // direction of the analysis and only the nodes whose incoming lattices changed are revisited: all the nodes
+        // are visited the first time the function is analyzed, and afterward only the nodes from the initial worklist
+        // and those to which changes propagate. The results are the same for monotone analyses.
+        void setSparseWorklist(bool sparse) { sparseWorklist = sparse; }
+        bool getSparseWorklist() const { return sparseWorklist; }
+
         protected:
+        bool sparseWorklist;
+
+        // Returns the nodes of the function reachable from getOrigin(), in reverse postorder of the direction of
+        // the analysis
+        std::vector<DataflowNode> getReversePostorder(const Function &func);
+
         // propagates the dataflow info from the current node's NodeState (curNodeState) to the next node's
         // NodeState (nextNodeState)
         bool propagateStateToNextNode(
@@ -235,6 +252,7 @@ class IntraUniDirectionalDataflow : public IntraUnitDataflow
 
 
         virtual vector<DataflowNode> getDescendants(const DataflowNode &n) = 0;
+        virtual DataflowNode getOrigin(const Function &func) = 0;
         virtual DataflowNode getUltimate(const Function &func) = 0;
 };
 
@@ -253,6 +271,7 @@ class IntraFWDataflow  : public IntraUniDirectionalDataflow
         vector<Lattice*> getLatticePost(NodeState *state);
         void transferFunctionCall(const Function &func, const DataflowNode &n, NodeState *state);
         vector<DataflowNode> getDescendants(const DataflowNode &n);
+        DataflowNode getOrigin(const Function &func);
         DataflowNode getUltimate(const Function &func);
 };
 
@@ -271,6 +290,7 @@ class IntraBWDataflow  : public IntraUniDirectionalDataflow
         virtual vector<Lattice*> getLatticePost(NodeState *state);
         void transferFunctionCall(const Function &func, const DataflowNode &n, NodeState *state);
         vector<DataflowNode> getDescendants(const DataflowNode &n);
+        DataflowNode getOrigin(const Function &func);
         DataflowNode getUltimate(const Function &func);
 };
 
@@ -356,9 +376,18 @@ class UnstructuredPassInterDataflow : virtual public InterProceduralDataflow
         public:
 
         UnstructuredPassInterDataflow(IntraProceduralDataflow* intraDataflowAnalysis)
-                             : InterProceduralAnalysis((IntraProceduralAnalysis*)intraDataflowAnalysis), InterProceduralDataflow(intraDataflowAnalysis)
+                             : InterProceduralAnalysis((IntraProceduralAnalysis*)intraDataflowAnalysis), InterProceduralDataflow(intraDataflowAnalysis),
+                               nThreads(1)
         {}
 
+        // The number of threads that runAnalysis uses to analyze functions concurrently. Zero means the number of
+        // hardware threads. Since the functions are independent of one another in this inter-procedural analysis, each
+        // one is analyzed by a single thread and the threads only share the NodeState map; the intra-procedural
+        // analysis must therefore allow different functions to be analyzed at the same time. The analysis runs in
+        // the calling thread if analysisDebugLevel is non-zero, since the debugging output is not thread safe.
+        void setNumThreads(size_t n) { nThreads = n; }
+        size_t getNumThreads() const { return nThreads; }
+
         // the transfer function that is applied to SgFunctionCallExp nodes to perform the appropriate state transfers
         // fw - =true if this is a forward analysis and =false if this is a backward analysis
         // n - the dataflow node that is being processed
@@ -377,6 +406,9 @@ class UnstructuredPassInterDataflow : virtual public InterProceduralDataflow
         }
 
         void runAnalysis();
+
+        protected:
+        size_t nThreads;
 };
 
 // Analysis that merges the dataflow states belonging to the given Analysis at all the return statements in the given function
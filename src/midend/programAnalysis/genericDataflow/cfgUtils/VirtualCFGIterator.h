@@ -6,8 +6,11 @@
 //#include "baseCFGIterator.h"
 
 #include <list>
+#include <map>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace VirtualCFG{
 
@@ -113,7 +116,7 @@ class dataflow : /*public virtual BaseCFG::dataflow, */public virtual iterator
                 this->terminator = terminator;
         }*/
         
-        void add(const DataflowNode &next);
+        virtual void add(const DataflowNode &next);
         
         //void operator ++ (int);
         
@@ -156,5 +159,37 @@ class back_dataflow: /*public virtual BaseCFG::back_dataflow,*/ public virtual d
                 
         void operator ++ (int);
 };
+
+// A dataflow worklist that visits only the nodes that have been added to it, lowest priority number first. The priorities
+// are given as a list of nodes, normally in reverse postorder of the direction of the analysis, so that a node is only
+// visited after the nodes that flow into it, except around loops. Nodes not in the list are visited after all the listed
+// ones, in the order they were first added. Unlike dataflow, advancing does not add the current node's descendants, and
+// adding a node that is already waiting to be visited does nothing.
+class priority_dataflow: public virtual dataflow
+{
+        // Priority number of each node
+        std::map<DataflowNode, size_t> priority;
+        
+        // The nodes waiting to be visited, other than the current node, sorted by priority
+        std::set<std::pair<size_t, DataflowNode> > pending;
+        
+        // The node that is never visited
+        DataflowNode terminator;
+        
+        public:
+        // Creates a worklist whose priorities are the positions of the nodes in order and that initially holds the
+        // nodes in start
+        priority_dataflow(const std::vector<DataflowNode> &order, const std::list<DataflowNode> &start,
+                          const DataflowNode &terminator_arg);
+        
+        // Adds a node to the worklist. The terminator is never added.
+        void add(const DataflowNode &next);
+        
+        // Moves on to the waiting node with the lowest priority number
+        void operator ++ (int);
+        
+        // Number of nodes waiting to be visited, including the current node
+        size_t size() const { return remainingNodes.size() + pending.size(); }
+};
 }
 #endif
@@ -5,8 +5,11 @@
 #include "variables.h"
 #include <string>
 #include <map>
+#include <Sawyer/SmallObject.h>
 
-class Lattice : public printable
+// Lattices are allocated from Sawyer's pool allocator since every CFG node holds separately allocated copies of the
+// lattices of every analysis, and most of them are small.
+class Lattice : public printable, public Sawyer::SmallObject
 {
         public:
         // initializes this Lattice to its default state, if it is not already initialized
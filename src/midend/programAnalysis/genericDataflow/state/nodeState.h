@@ -7,7 +7,9 @@ class NodeState;
 
 #include "lattice.h"
 #include "analysis.h"
+#include <algorithm>
 #include <map>
+#include <utility>
 #include <vector>
 #include <string>
 #include <set>
@@ -84,6 +86,64 @@ class NodeStateHashCompare
         
         static size_t hash( const Analysis* k ) { return (size_t) k; }
 };
+#else
+// A map from analyses to values, stored as a vector sorted by analysis. A NodeState usually holds the state of only a
+// few analyses, for which this takes much less memory than a std::map, all of whose entries are allocated separately.
+// Unlike std::map, adding or erasing an entry invalidates references to the values of the other entries.
+template<class T>
+class NodeStateAnalysisMap
+{
+        public:
+        typedef std::pair<Analysis*, T> value_type;
+        typedef typename std::vector<value_type>::iterator iterator;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+        
+        private:
+        std::vector<value_type> entries;
+        
+        struct KeyLess
+        {
+                bool operator()(const value_type &entry, Analysis* key) const { return entry.first < key; }
+        };
+        
+        public:
+        iterator begin() { return entries.begin(); }
+        iterator end() { return entries.end(); }
+        const_iterator begin() const { return entries.begin(); }
+        const_iterator end() const { return entries.end(); }
+        size_t size() const { return entries.size(); }
+        
+        iterator find(Analysis* key)
+        {
+                iterator it = std::lower_bound(entries.begin(), entries.end(), key, KeyLess());
+                return it!=entries.end() && it->first==key ? it : entries.end();
+        }
+        
+        const_iterator find(Analysis* key) const
+        {
+                const_iterator it = std::lower_bound(entries.begin(), entries.end(), key, KeyLess());
+                return it!=entries.end() && it->first==key ? it : entries.end();
+        }
+        
+        // Returns the value for the given analysis, inserting a default value if there is none
+        T& operator[](Analysis* key)
+        {
+                iterator it = std::lower_bound(entries.begin(), entries.end(), key, KeyLess());
+                if(it==entries.end() || it->first!=key)
+                        it = entries.insert(it, value_type(key, T()));
+                return it->second;
+        }
+        
+        // Removes the value for the given analysis and returns the number of values removed
+        size_t erase(Analysis* key)
+        {
+                iterator it = find(key);
+                if(it==entries.end())
+                        return 0;
+                entries.erase(it);
+                return 1;
+        }
+};
 #endif
 
 class NodeState
@@ -94,10 +154,10 @@ class NodeState
         typedef tbb::concurrent_hash_map <Analysis*, std::vector<NodeFact*>, NodeStateHashCompare > NodeFactMap;
         typedef tbb::concurrent_hash_map <Analysis*, bool, NodeStateHashCompare  > BoolMap;     
         #else
-        typedef std::map<Analysis*, std::vector<Lattice*> > LatticeMap;
+        typedef NodeStateAnalysisMap<std::vector<Lattice*> > LatticeMap;
         //typedef std::map<Analysis*, std::map<int, NodeFact*> > NodeFactMap;
-        typedef std::map<Analysis*, std::vector<NodeFact*> > NodeFactMap;
-        typedef std::map<Analysis*, bool > BoolMap;
+        typedef NodeStateAnalysisMap<std::vector<NodeFact*> > NodeFactMap;
+        typedef NodeStateAnalysisMap<bool> BoolMap;
         #endif
         
         // the dataflow information Above the node, for each analysis that 
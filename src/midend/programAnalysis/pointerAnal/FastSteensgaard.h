@@ -0,0 +1,74 @@
+#ifndef FAST_STEENSGAARD_H
+#define FAST_STEENSGAARD_H
+
+#include <boost/unordered_map.hpp>
+#include <vector>
+
+class SgNode;
+class SgExpression;
+class SgFunctionDeclaration;
+class SgInitializedName;
+
+/* Whole-program Steensgaard points-to analysis over the Sage AST.
+
+   Unlike SteensgaardPtrAnal, which is driven statement by statement through the AstInterface CFG and keeps an ECR
+   object per variable name, this engine numbers the variables (SgInitializedName), functions (their return values)
+   and allocation sites (calls of malloc, calloc, realloc and strdup, and new expressions) densely and keeps the
+   equivalence classes in arrays: a union-find forest with path compression and union by rank, and for each class the
+   class it points to.  The constraints are generated in one pass over the memory pools of the assignment, initializer,
+   function call and return nodes, in any order, since unification does not depend on it.
+
+   The analysis is flow- and context-insensitive and field-insensitive: the fields of a structure and the elements of
+   an array are represented by the variable itself.  Arguments are bound to the parameters of the called function only
+   for direct calls.  A call through a function pointer does see the return values of all the functions the pointer
+   may point to, since those functions are unified and so are the locations of their return values.
+
+   Typical use:
+       FastSteensgaard ptr;
+       ptr.run();
+       if (ptr.may_alias(p, q)) ...
+ */
+class ROSE_DLL_API FastSteensgaard
+{
+ public:
+   FastSteensgaard() {}
+
+   // Generate and solve the constraints of all the nodes in the memory pools. May be called again after the AST
+   // changed, which starts over.
+   void run();
+
+   // True if the pointer variables x and y may point to the same location
+   bool may_alias(SgInitializedName* x, SgInitializedName* y);
+
+   // The variables and allocation sites that the pointer variable x may point to, in numbering order
+   std::vector<SgNode*> points_to(SgInitializedName* x);
+
+   // Number of numbered locations (variables, functions and allocation sites) and of classes left after unification
+   size_t num_locations() const { return locations.size(); }
+   size_t num_classes();
+
+ private:
+   static const unsigned NONE = (unsigned)(-1);
+
+   std::vector<unsigned> parent;         // union-find forest
+   std::vector<unsigned char> rank;
+   std::vector<unsigned> pointee;        // class that each class points to, valid at roots only, or NONE
+   std::vector<SgNode*> locations;       // AST node of each numbered location; node number equals location number
+   boost::unordered_map<SgNode*, unsigned> location_number;
+
+   unsigned new_node();
+   unsigned find(unsigned n);
+   unsigned join(unsigned a, unsigned b);
+   unsigned deref(unsigned n);
+   unsigned location(SgNode* node);
+   unsigned function_return(SgFunctionDeclaration* func);
+
+   // The class of the locations that the value of an expression points to, or of the location an lvalue denotes
+   unsigned value_of(SgExpression* exp);
+   unsigned location_of(SgExpression* exp);
+
+   void assign(unsigned lhsLocation, SgExpression* rhs);
+   void process_call(SgExpression* call);
+};
+
+#endif
@@ -2,6 +2,8 @@
 
 #include "DependenceGraph.h"
 #include <set>
+#include <vector>
+#include <boost/unordered_map.hpp>
 
 
 class ROSE_DLL_API CreateSliceSet
@@ -15,3 +17,44 @@ class ROSE_DLL_API CreateSliceSet
                 std::list<SgNode*> sliceTargetNodes;
                 std::set<DependenceNode*> getSliceDepNodes(std::set <DependenceNode*> searchSet,std::set<DependenceGraph::EdgeType> allowedEdges);
 };
+
+/*! \class SliceGraph
+
+   A compact, read-only copy of a SystemDependenceGraph for computing many slices of the same program. The SDG,
+   including its summary edges, is built once by the caller; this class numbers its nodes densely and keeps the
+   predecessors of each node in one array, each edge labelled with the phases of the two-phase slice (see
+   CreateSliceSet::computeSliceSet) that may traverse it. Slicing then touches only arrays, and since the graph is not
+   modified (nodes are not highlighted) slices for different criteria can be computed concurrently.
+*/
+class ROSE_DLL_API SliceGraph
+{
+        public:
+                SliceGraph(SystemDependenceGraph *program);
+
+                //! the slice for one criterion, the same set as CreateSliceSet::computeSliceSet(node)
+                std::set<SgNode*> computeSliceSet(SgNode * node) const;
+
+                /*! the slices for many criteria, in the same order. Criteria are taken one at a time by nThreads threads;
+                  zero means one per hardware thread. */
+                std::vector<std::set<SgNode*> > computeSliceSets(const std::vector<SgNode*> &criteria, size_t nThreads=1) const;
+
+                size_t numNodes() const {return sgNodes.size();}
+                size_t numEdges() const {return predecessors.size();}
+
+        private:
+                enum {PHASE_1=0x1, PHASE_2=0x2};
+                //! predecessors of node i are at predOffsets[i] up to predOffsets[i+1]
+                std::vector<size_t> predOffsets;
+                std::vector<unsigned> predecessors;
+                std::vector<unsigned char> predPhases;
+                //! the SgNode of each node, or NULL for dummy nodes
+                std::vector<SgNode*> sgNodes;
+                //! nodes that can be slicing criteria
+                boost::unordered_map<SgNode*, unsigned> criterionNodes;
+
+                friend struct SliceWorker;
+                /*! slice from one node. marks has an entry per node and is reused between calls; generation is bumped
+                  for each call so the marks needn't be cleared */
+                void slice(unsigned start, std::vector<unsigned> &marks, unsigned &generation, std::vector<unsigned> &work,
+                           std::set<SgNode*> &result) const;
+};
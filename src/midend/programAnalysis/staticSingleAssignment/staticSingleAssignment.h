@@ -69,6 +69,17 @@ private:
     /** The project to perform SSA Analysis on. */
     SgProject* project;
 
+    /** The arguments of the last call to run(), reused by incremental updates. */
+    bool interproceduralAnalysis;
+    bool pointersAsStructures;
+
+    /** Number of threads used by run(). */
+    size_t nThreads;
+
+    /** Analyzes functions in one thread of run(). */
+    struct FunctionWorker;
+    friend struct FunctionWorker;
+
 public:
 
     /** A compound variable name as used by the variable renaming.  */
@@ -132,7 +143,8 @@ private:
 
 public:
 
-    StaticSingleAssignment(SgProject* proj) : project(proj)
+    StaticSingleAssignment(SgProject* proj) : project(proj), interproceduralAnalysis(false), pointersAsStructures(true),
+            nThreads(1)
     {
     }
 
@@ -146,6 +158,38 @@ public:
      * @param treatPointersAsStructures if true, p->x is versioned as if it were the variable p.x. */
     void run(bool interprocedural, bool treatPointersAsStructures);
 
+    /** Update the analysis after statements were inserted, removed or replaced, without rerunning it on the whole
+     * project. The analysis must already have been run. Every function enclosing a changed statement is analyzed again
+     * with the arguments of the last call to run(); all other functions keep their results.
+     * Interprocedural definitions at call sites in other functions are not recomputed, so if a transformation changes
+     * which variables a function modifies, its callers should be passed here as well.
+     * @param changedStatements inserted statements, replacement statements, and the statements from whose scope
+     *        statements were removed. They must be attached to the AST.
+     * @param removedStatements statements that were removed or replaced. Results attached to their subtrees are discarded,
+     *        so they must not have been deleted yet. */
+    void update(const std::vector<SgStatement*>& changedStatements,
+            const std::vector<SgStatement*>& removedStatements = std::vector<SgStatement*>());
+
+    /** Analyze one function again after its body was transformed. This recomputes the local defs and uses, phi functions
+     * (using iterated dominance frontiers) and reaching definitions of the function only. See update(). */
+    void updateFunction(SgFunctionDefinition* func);
+
+    /** The number of threads used by run() to analyze functions concurrently. Zero means the number of hardware threads.
+     * Each function is analyzed by one thread into private tables that are merged when all the threads finish, and
+     * independent parts of the call graph are summarized concurrently during interprocedural propagation. Unique names are
+     * still assigned, and call targets resolved, in the calling thread. The analysis runs
+     * in the calling thread if debugging output is enabled, since it is not thread safe. The AST must not be modified
+     * while run() executes. */
+    void setNumThreads(size_t n)
+    {
+        nThreads = n;
+    }
+
+    size_t getNumThreads() const
+    {
+        return nThreads;
+    }
+
     static bool getDebug()
     {
         return SgProject::get_verbose() > 0;
@@ -157,6 +201,23 @@ public:
     }
 
 private:
+    /** Insert the external definitions, phi functions and reaching definitions of one function, once all the local
+     * definitions (including the interprocedural ones) are in the original def table. */
+    void propagateDefsInFunction(SgFunctionDefinition* func);
+
+    /** Remove all the entries for the nodes in the subtree from the def, use and reaching def tables. */
+    void discardSubtree(SgNode* root);
+
+    /** Compute the local defs and uses of the functions (if propagate is false), or their reaching definitions (if
+     * propagate is true), using the configured number of threads. */
+    void processFunctions(const std::vector<SgFunctionDefinition*>& funcs, bool propagate);
+
+    /** The number of threads to use for the specified number of independent work items. */
+    size_t getNumWorkers(size_t nWorkItems) const;
+
+    /** Copy the entries of another analysis' tables into this one's, replacing existing entries for the same nodes. */
+    void mergeTables(const StaticSingleAssignment& other);
+
     /** Once all the local definitions have been inserted in the ssaLocalDefsTable and phi functions have been inserted
      * in the reaching defs table, propagate reaching definitions along the CFG. */
     void runDefUseDataFlow(SgFunctionDefinition* func);
@@ -242,25 +303,43 @@ private:
 
     //------------ INTERPROCEDURAL ANALYSIS FUNCTIONS ------------ //
 
-    /** Insert definitions at function call sites for all variables defined interprocedurally. Iterates on the
-     * call graph until the definitions converge (hence it works with recursion).
+    /** The call sites (SgFunctionCallExp or SgConstructorInitializer) of one function and the functions each of them may
+     * call. */
+    typedef std::vector<std::pair<SgExpression*, std::vector<SgFunctionDeclaration*> > > CallSiteList;
+
+    /** Map from each function to the variables defined anywhere in its body, including the definitions at its call sites. */
+    typedef boost::unordered_map<SgFunctionDefinition*, std::set<VarName> > FunctionSummaryTable;
+
+    /** Summarizes call graph components in one thread of interproceduralDefPropagation(). */
+    struct SummaryWorker;
+    friend struct SummaryWorker;
+
+    /** Insert definitions at function call sites for all variables defined interprocedurally. The strongly connected
+     * components of the call graph are summarized bottom-up, so that the summaries of all the callees are complete when a
+     * function is summarized; only the components with recursion are iterated, and only until their own summaries
+     * converge. Components that don't call each other are summarized concurrently using the configured number of threads.
      * @param interestinFunctions all functions that should be analyzed. */
     void interproceduralDefPropagation(const boost::unordered_set<SgFunctionDefinition*>& interestingFunctions);
 
-    /** This function returns the order in which functions should be processed so that callees are processed before
-     * callers whenever possible (this is sometimes not possible due to recursion). Internally, it builds a call graph
-     * and constructs a depth-first ordering of it. */
-    std::vector<SgFunctionDefinition*> calculateInterproceduralProcessingOrder(
-            const boost::unordered_set<SgFunctionDefinition*>& interestingFunctions);
-
-    /** Add all the callees of the function to the processing list, then add the function itself. Does nothing
-     * if the function is already in the list. */
-    void processCalleesThenFunction(SgFunctionDefinition* targetFunction, SgIncidenceDirectedGraph* callGraph,
-            const boost::unordered_map<SgFunctionDefinition*, SgGraphNode*>& graphNodeToFunction,
-            std::vector<SgFunctionDefinition*> &processingOrder, std::set<SgFunctionDefinition*> visited);
+    /** Compute the mod summaries of the functions of one strongly connected component of the call graph, and the
+     * interprocedural defs at their call sites. Only reads the analysis tables, so that components can be summarized
+     * concurrently.
+     * @param component the functions of the component
+     * @param recursive true if the component has a call from one of its functions to one of its functions
+     * @param callSites the resolved call sites of every function
+     * @param summaries summaries of every function to analyze. The summaries of the functions called by the component
+     *                  must be complete. On entry the component's summaries are empty; on return they are complete.
+     * @param callSiteDefs receives the interprocedural defs of each of the component's call sites */
+    void summarizeComponent(const std::vector<SgFunctionDefinition*>& component, bool recursive,
+            const boost::unordered_map<SgFunctionDefinition*, CallSiteList>& callSites, FunctionSummaryTable& summaries,
+            ClassHierarchyWrapper* classHierarchy, LocalDefUseTable& callSiteDefs) const;
+
+    /** Returns the function definition of a callee, or NULL if it has none. */
+    static SgFunctionDefinition* getCalleeDefinition(SgFunctionDeclaration* callee);
 
     /** Add definitions at function call expressions for variables that are modified interprocedurally.
-     * The definitions are inserted in the original def table.
+     * The definitions are inserted in the original def table. The defs of each callee are collected from its body, so
+     * this is used to update one function rather than to analyze the whole program.
      * @param funcDef function whose body should be queries for function calls
      * @param processed all the functions completely processed by SSA. If a callee is one of these functions,
      *                  we can use exact information.
@@ -268,12 +347,16 @@ private:
     bool insertInterproceduralDefs(SgFunctionDefinition* funcDef, const boost::unordered_set<SgFunctionDefinition*>& processed,
             ClassHierarchyWrapper* classHierarchy);
 
-    /** Insert the interprocedural defs at a particular call site for a particular callee. This function may be called
+    /** Find the interprocedural defs at a particular call site for a particular callee. This function may be called
      * multiple times for the same call site with different callees (e.g. in the case of virtual functions).
      * The call site should either be a SgFunctionCallExp or SgConstructorInitializer
-     * @param processed functions already processed by SSA */
-    void processOneCallSite(SgExpression* callSite, SgFunctionDeclaration* callee,
-            const boost::unordered_set<SgFunctionDefinition*>& processed, ClassHierarchyWrapper* classHierarchy);
+     * @param calleeDef the definition of the callee, or NULL if it has none
+     * @param varsDefinedInCallee the variables defined by the callee, or NULL if they are not known exactly. In that case
+     *                            every argument the callee could modify is assumed to be modified.
+     * @param callSiteDefs receives the variables defined at the call site */
+    void processOneCallSite(SgExpression* callSite, SgFunctionDeclaration* callee, SgFunctionDefinition* calleeDef,
+            const std::set<VarName>* varsDefinedInCallee, ClassHierarchyWrapper* classHierarchy,
+            std::set<VarName>& callSiteDefs) const;
 
     /** Given a variable that is in a callee's scope, returns true if the caller can access the same variable, false otherwise.
      * @param callSite either a SgFunctionCallExp or SgConstructorInitializer. */
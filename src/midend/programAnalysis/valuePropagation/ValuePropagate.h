@@ -4,28 +4,65 @@
 #include <DefUseChain.h>
 #include <ValueAnnot.h>
 #include <FunctionObject.h>
+#include <map>
+#include <string>
+#include <utility>
+
+// Interned has_value descriptors. Each distinct descriptor is stored once and
+// never changes afterwards, so the values are shared by pointer and two values
+// are equal exactly when their pointers are. Joins are memoized, so merging the
+// same pair of values again costs one lookup and no copy.
+class ROSE_DLL_API HasValueTable
+{
+  std::map<std::string, HasValueDescriptor> values;
+  std::map<std::pair<const HasValueDescriptor*, const HasValueDescriptor*>,
+           const HasValueDescriptor*> joins;
+  const HasValueDescriptor* emptyval;
+
+  HasValueTable( const HasValueTable&);
+  void operator = ( const HasValueTable&);
+ public:
+  HasValueTable();
+  // the interned copy of desc
+  const HasValueDescriptor* intern( const HasValueDescriptor& desc);
+  // the descriptor with no values
+  const HasValueDescriptor* empty() const { return emptyval; }
+  // the interned result of merging that into cur; cur itself if nothing changes
+  const HasValueDescriptor* join( const HasValueDescriptor* cur,
+                                  const HasValueDescriptor* that);
+  unsigned size() const { return values.size(); }
+};
 
 class ROSE_DLL_API ValuePropagateNode : public DefUseChainNode
 {
-  HasValueDescriptor desc;
+  const HasValueDescriptor* desc;
  public:
   ValuePropagateNode( MultiGraphCreate *c, const AstNodePtr& ref, 
                       const AstNodePtr& _stmt, bool def)
-    : DefUseChainNode( c, ref, _stmt, def) {}
+    : DefUseChainNode( c, ref, _stmt, def), desc(0) {}
 
-  const HasValueDescriptor& get_desc() const { return desc; }
-  HasValueDescriptor& get_desc() { return desc; }
+  const HasValueDescriptor& get_desc() const;
+  // the interned value of the node, 0 if nothing is known yet
+  const HasValueDescriptor* get_val() const { return desc; }
+  void set_val( const HasValueDescriptor* val) { desc = val; }
   virtual std::string toString() const;
 };
 
 class ROSE_DLL_API HasValueMap : public AstObserver
 {
-  std::map<AstNodePtr, HasValueDescriptor> valmap;
+  HasValueTable table;
+  std::map<AstNodePtr, const HasValueDescriptor*> valmap;
 
   void ObserveCopyAst(AstInterfaceImpl& fa, const AstNodePtr& orig, const AstNodePtr& copy);
  public:
   bool has_value( const AstNodePtr& ast, HasValueDescriptor* r = 0) const;
+  // the interned value of ast, 0 if it has none
+  const HasValueDescriptor* get_val( const AstNodePtr& ast) const;
   void set_val( const AstNodePtr& ast, const HasValueDescriptor& val);
+  // merges an interned value into that of ast; returns whether it changed
+  bool set_val( const AstNodePtr& ast, const HasValueDescriptor* val);
+
+  HasValueTable& get_table() { return table; }
 
   void copy_value( AstInterfaceImpl& fa, const AstNodePtr& orig, const AstNodePtr& copy);
  friend class ValuePropagate;
@@ -64,6 +101,7 @@ class ROSE_DLL_API ValuePropagate
   virtual ValuePropagateNode* 
     CreateNode( AstInterface& fa, const AstNodePtr& ref, 
                 const AstNodePtr& stmt, bool def);
+  void propagate( AstInterface& fa, const AstNodePtr& head);
 
  public:
   ValuePropagate( BaseGraphCreate* c = 0) 
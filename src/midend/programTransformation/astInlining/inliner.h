@@ -18,7 +18,44 @@
 //! pointer).  Also, the body of the function must already be visible.
 //! Recursive procedures are handled properly (when allowRecursion is set), by
 //! inlining one copy of the procedure into itself.  Any other restrictions on
-//! what can be inlined are bugs in the inliner code.
-ROSE_DLL_API bool doInline(SgFunctionCallExp* funcall, bool allowRecursion = false);
+//! what can be inlined are bugs in the inliner code.  The AST consistency
+//! tests that follow each inlining in some builds are skipped if checkAst is
+//! false, for callers that inline many calls and test the AST once.
+ROSE_DLL_API bool doInline(SgFunctionCallExp* funcall, bool allowRecursion = false, bool checkAst = true);
+
+//! Policy of inlineCallSites().
+struct ROSE_DLL_API InliningPolicy
+   {
+  //! Name of the MetricAttribute holding the execution count (or time) of
+  //! each statement, such as a metric attached by the roseHPCToolkit.  A call
+  //! site gets the value of its nearest enclosing node carrying the metric.
+  //! If empty, counts are estimated statically as 10 to the loop nesting
+  //! depth of the call site.
+     std::string profileMetric;
+
+  //! Code growth allowed, as a fraction of the size of all function bodies
+  //! in the project.  Sizes are numbers of AST nodes.
+     double growthBudget;
+
+  //! Functions whose body is larger than this are never inlined.
+     size_t maxCalleeSize;
+
+  //! Call sites whose count is below this are never inlined.
+     double minCount;
+
+  //! Run variable renaming, block flattening and cleanupInlinedCode() on the
+  //! project once, after the last inlining.
+     bool cleanup;
+
+     InliningPolicy();
+   };
+
+//! Inline the call sites of a project chosen by a cost model, in one batch.
+//! The candidates are the calls doInline() accepts, except recursive ones.
+//! They are chosen by decreasing count per unit of callee size until the
+//! growth budget is spent, and inlined bottom-up over the call graph, so
+//! that a callee already has its own chosen calls inlined when it is copied
+//! into its callers.  Returns the number of calls inlined.
+ROSE_DLL_API size_t inlineCallSites(SgProject* project, const InliningPolicy& policy = InliningPolicy());
 
 #endif // INLINER_H
@@ -8,6 +8,7 @@
 #include "sage3basic.h"
 #include <iostream>
 #include <list>
+#include <map>
 #include <string>
 
 
@@ -40,14 +41,12 @@ dump (const ASTtools::VarSymSet_t& V, const std::string& tag)
 //  * Q: declared within the enclosing function surrounding 's'
 //       but not globally declared beyond the function surrounding 's'  (global variables should not be passed if the outlined function  is put within the same file )  
 //
-void
-Outliner::collectVars (const SgStatement* s, 
-                       ASTtools::VarSymSet_t& syms) // return the symbols(variables) that need to be passed into the outlined function 
+// Q is computed by the caller, since it can be shared among several targets; it is unused if the outlined function is put into a new file.
+static void
+collectPassedVars (const SgStatement* s,
+                   const ASTtools::VarSymSet_t& Q,
+                   ASTtools::VarSymSet_t& syms) // return the symbols(variables) that need to be passed into the outlined function 
 {
-  // Determine the function definition surrounding 's'. The enclosing function of 's'
-  const SgFunctionDefinition* outer_func_s = ASTtools::findFirstFuncDef (s);
-  ROSE_ASSERT (outer_func_s);
-
   // U = {symbols used within 's'}
   ASTtools::VarSymSet_t U;
   ASTtools::collectRefdVarSyms (s, U);
@@ -78,10 +77,6 @@ Outliner::collectVars (const SgStatement* s,
   }
   else
   {
-    // Q = {symbols defined within the function surrounding 's' that are visible at 's'}, including function parameters
-    ASTtools::VarSymSet_t Q;
-    ASTtools::collectLocalVisibleVarSyms (outer_func_s->get_declaration (),
-        s, Q);
     dump (Q, "Q (variables defined within the function surrounding s that are visible at s) = ");
 
     // (U - L) \cap Q = {variables that need to be passed as parameters to the outlined function}
@@ -94,4 +89,60 @@ Outliner::collectVars (const SgStatement* s,
   }
 }
 
+void
+Outliner::collectVars (const SgStatement* s, 
+                       ASTtools::VarSymSet_t& syms) // return the symbols(variables) that need to be passed into the outlined function 
+{
+  // Determine the function definition surrounding 's'. The enclosing function of 's'
+  const SgFunctionDefinition* outer_func_s = ASTtools::findFirstFuncDef (s);
+  ROSE_ASSERT (outer_func_s);
+
+  // Q = {symbols defined within the function surrounding 's' that are visible at 's'}, including function parameters
+  ASTtools::VarSymSet_t Q;
+  if (!Outliner::useNewFile)
+    ASTtools::collectLocalVisibleVarSyms (outer_func_s->get_declaration (),
+        s, Q);
+  collectPassedVars (s, Q, syms);
+}
+
+//! Collect the variables to be passed for each of several targets
+// The Q sets of the targets within the same function are collected in a single traversal of that function.
+void
+Outliner::collectVars (const std::vector<const SgStatement*>& stmts,
+                       std::vector<ASTtools::VarSymSet_t>& syms)
+{
+  syms.clear ();
+  syms.resize (stmts.size ());
+
+  std::vector<ASTtools::VarSymSet_t> Q (stmts.size ());
+  if (!Outliner::useNewFile)
+  {
+    // Group the targets by their enclosing function
+    typedef std::map<const SgFunctionDefinition*, std::vector<size_t> > FuncTargets_t;
+    FuncTargets_t func_targets;
+    for (size_t i = 0; i < stmts.size (); ++i)
+    {
+      const SgFunctionDefinition* outer_func_s = ASTtools::findFirstFuncDef (stmts[i]);
+      ROSE_ASSERT (outer_func_s);
+      func_targets[outer_func_s].push_back (i);
+    }
+
+    for (FuncTargets_t::const_iterator f = func_targets.begin (); f != func_targets.end (); ++f)
+    {
+      const std::vector<size_t>& index = f->second;
+      std::vector<const SgStatement*> targets;
+      for (size_t k = 0; k < index.size (); ++k)
+        targets.push_back (stmts[index[k]]);
+
+      std::vector<ASTtools::VarSymSet_t> visible;
+      ASTtools::collectLocalVisibleVarSyms (f->first->get_declaration (), targets, visible);
+      for (size_t k = 0; k < index.size (); ++k)
+        Q[index[k]].swap (visible[k]);
+    }
+  }
+
+  for (size_t i = 0; i < stmts.size (); ++i)
+    collectPassedVars (stmts[i], Q[i], syms[i]);
+}
+
 // eof
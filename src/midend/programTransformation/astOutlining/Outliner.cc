@@ -7,6 +7,7 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <set>
 
 
 
@@ -166,6 +167,33 @@ Outliner::outline (SgStatement* s, const std::string& func_name)
   }  
 }
 
+std::vector<Outliner::Result>
+Outliner::outline (const std::vector<SgStatement*>& stmts)
+{
+  // Each target is analyzed before the others are transformed, so none may enclose another
+  std::set<SgNode*> targets (stmts.begin (), stmts.end ());
+  ROSE_ASSERT (targets.size () == stmts.size ());
+  for (size_t i = 0; i < stmts.size (); ++i)
+    for (SgNode* p = stmts[i]->get_parent (); p != NULL; p = p->get_parent ())
+      if (targets.find (p) != targets.end ())
+      {
+        cerr<<"Outliner::outline() Input statement:"<<stmts[i]->unparseToString()<<"\n is enclosed by another outlining target!"<<endl;
+        ROSE_ASSERT(false);
+      }
+
+  std::vector<std::string> func_names;
+  std::vector<SgBasicBlock*> blocks;
+  for (size_t i = 0; i < stmts.size (); ++i)
+  {
+    func_names.push_back (generateFuncName (stmts[i]));
+    blocks.push_back (preprocess (stmts[i]));
+  }
+
+  if (preproc_only_)
+    return std::vector<Result> (stmts.size ());
+  return outlineBlocks (blocks, func_names);
+}
+
 //! Set internal options based on command line options
 void Outliner::commandLineProcessing(std::vector<std::string> &argvList)
 {
@@ -350,7 +378,7 @@ Outliner::preprocess (SgStatement* s)
  */
 
 Outliner::Result::Result (void)
-  : decl_ (0), call_ (0)
+  : decl_ (0), call_ (0), file_ (0)
 {
 }
 
@@ -361,7 +389,7 @@ Outliner::Result::Result (SgFunctionDeclaration* decl,
 }
 
 Outliner::Result::Result (const Result& b)
-  : decl_ (b.decl_), call_ (b.call_)
+  : decl_ (b.decl_), call_ (b.call_), file_ (b.file_)
 {
 }
 
@@ -147,6 +147,19 @@ namespace Outliner
   //! Outline to a new function with the specified name, calling preprocessing internally
   Result outline (SgStatement* s, const std::string& func_name);
 
+  //! Outlines several statements at once, sharing the analyses among them.
+  /*!
+   *  The statements must be outlineable and none may enclose another.
+   *  All of them are preprocessed and analyzed before any is transformed;
+   *  the variable references of the scopes receiving the calls are then
+   *  fixed and each affected source file is post-processed once, instead
+   *  of once per statement. Much faster than calling outline() for each
+   *  statement when there are many of them in a file.
+   *
+   *  \returns The results, in the order of the statements.
+   */
+  ROSE_DLL_API std::vector<Result> outline (const std::vector<SgStatement*>& stmts);
+
   //! If 's' is an outline pragma, this function "executes" it.
   /*!
    *  \post The outlined statement and the pragma are removed from the
@@ -181,6 +194,35 @@ namespace Outliner
      */
     Result outlineBlock (SgBasicBlock* b, const std::string& name);
 
+    //! Analysis results of an outlining target used by outlineBlock().
+    struct BlockAnalysis
+    {
+      ASTtools::VarSymSet_t syms; //!< Variables to be passed, see collectVars().
+      ASTtools::VarSymSet_t pdSyms; //!< Variables to be replaced by pointer dereferencing.
+      std::set<SgInitializedName*> readOnlyVars;
+      std::set<SgInitializedName*> liveIns, liveOuts;
+    };
+
+    /*!
+     *  \brief Computes the analysis results of 'b', except for the
+     *  variables to be passed, which are left to collectVars().
+     */
+    void analyzeBlock (SgBasicBlock* b, BlockAnalysis& info);
+
+    /*!
+     *  \brief Outlines 'b' using analysis results computed beforehand.
+     *
+     *  If 'postprocess' is false, the caller must fix the variable
+     *  references of the scope of the call and run the AST post
+     *  processing on the source file of 'b' afterwards.
+     */
+    Result outlineBlock (SgBasicBlock* b, const std::string& name,
+                         BlockAnalysis& info, bool postprocess);
+
+    //! Outlines several basic blocks, analyzing all of them before transforming any.
+    std::vector<Result> outlineBlocks (const std::vector<SgBasicBlock*>& blocks,
+                                       const std::vector<std::string>& names);
+
     /*!
      *  \brief Computes the set of variables in 's' that need to be
      *  passed to the outlined routine (semantically equivalent to shared variables in OpenMP) 
@@ -193,6 +235,10 @@ namespace Outliner
      *  handle their special variables in advance. 
      */
     void collectVars (const SgStatement* s, ASTtools::VarSymSet_t& syms);
+
+    //! Same as above for several targets, syms[i] receiving the variables of stmts[i].
+    void collectVars (const std::vector<const SgStatement*>& stmts,
+                      std::vector<ASTtools::VarSymSet_t>& syms);
     //void collectVars (const SgStatement* s, ASTtools::VarSymSet_t& syms, ASTtools::VarSymSet_t& private_syms);
 
     /*!\brief Generate a new source file under the same SgProject as
@@ -191,37 +191,17 @@ static void calculateVariableUsingAddressOf(const ASTtools::VarSymSet_t& syms, c
 }
 
 /**
- * Major work of outlining is done here
- *  Preparations: variable collection
- *  Generate outlined function
- *  Replace outlining target with a function call
- *  Append dependent declarations,headers to new file if needed
+ * Analysis of the outlining target s, except for the variables to be passed
+ *  read-only variables, variables using pointer dereferencing, live variables
  */
-Outliner::Result
-Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
+void
+Outliner::analyzeBlock (SgBasicBlock* s, BlockAnalysis& info)
 {
-  //---------step 1. Preparations-----------------------------------
-  //new file, cut preprocessing information, collect variables
-  // Generate a new source file for the outlined function, if requested
-  SgSourceFile* new_file = NULL;
-  if (Outliner::useNewFile)
-    new_file = generateNewSourceFile(s,func_name_str);
-
-  // Save some preprocessing information for later restoration. 
-  AttachedPreprocessingInfoType ppi_before, ppi_after;
-  ASTtools::cutPreprocInfo (s, PreprocessingInfo::before, ppi_before);
-  ASTtools::cutPreprocInfo (s, PreprocessingInfo::after, ppi_after);
-
-  // Determine variables to be passed to outlined routine.
-  // ----------------------------------------------------------
-  // Also collect symbols which must use pointer dereferencing if replaced during outlining
-  ASTtools::VarSymSet_t syms, pdSyms;
-  collectVars (s, syms);
-
   // prepare necessary analysis to optimize the outlining 
   //-----------------------------------------------------------------
-  std::set<SgInitializedName*> readOnlyVars;
-  std::set< SgInitializedName *> liveIns, liveOuts;
+  std::set<SgInitializedName*>& readOnlyVars = info.readOnlyVars;
+  std::set< SgInitializedName *>& liveIns = info.liveIns;
+  std::set< SgInitializedName *>& liveOuts = info.liveOuts;
   // Collect read-only variables of the outlining target
 
   //Determine variables to be replaced by temp copy or pointer dereferencing.
@@ -231,9 +211,9 @@ Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
     // Collect use by address plus non-assignable variables
     // They must be passed by reference if they need to be passed as parameters
     // TODO: this is not accurate: array variables are not assignable , but they should not using pointer dereferencing 
-    ASTtools::collectPointerDereferencingVarSyms(s,pdSyms);
+    ASTtools::collectPointerDereferencingVarSyms(s,info.pdSyms);
 
-    // liveness analysis
+    // liveness analysis, run once for the whole project
     SgStatement* firstStmt = (s->get_statements())[0];
     if (isSgForStatement(firstStmt)&& enable_liveness)
     {
@@ -255,6 +235,87 @@ Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
       cout<<endl; 
     }
   }
+}
+
+Outliner::Result
+Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
+{
+  // Determine variables to be passed to outlined routine.
+  // ----------------------------------------------------------
+  BlockAnalysis info;
+  collectVars (s, info.syms);
+  analyzeBlock (s, info);
+  return outlineBlock (s, func_name_str, info, true);
+}
+
+/**
+ * Outlining of several targets
+ *  All targets are analyzed before any of them is transformed, sharing the
+ *  traversals of their enclosing functions and the liveness analysis.
+ *  The variable references of the scopes receiving the calls are fixed and the
+ *  original source files are post-processed once, after the last target.
+ */
+std::vector<Outliner::Result>
+Outliner::outlineBlocks (const std::vector<SgBasicBlock*>& blocks, const std::vector<std::string>& func_names)
+{
+  ROSE_ASSERT (blocks.size () == func_names.size ());
+
+  std::vector<const SgStatement*> targets (blocks.begin (), blocks.end ());
+  std::vector<ASTtools::VarSymSet_t> syms;
+  collectVars (targets, syms);
+
+  std::vector<BlockAnalysis> infos (blocks.size ());
+  for (size_t i = 0; i < blocks.size (); ++i)
+  {
+    infos[i].syms.swap (syms[i]);
+    analyzeBlock (blocks[i], infos[i]);
+  }
+
+  std::vector<Result> results;
+  std::set<SgScopeStatement*> call_scopes;
+  std::set<SgSourceFile*> src_files;
+  for (size_t i = 0; i < blocks.size (); ++i)
+  {
+    src_files.insert (TransformationSupport::getSourceFile (blocks[i]));
+    call_scopes.insert (blocks[i]->get_scope ());
+    results.push_back (outlineBlock (blocks[i], func_names[i], infos[i], false));
+  }
+
+  for (std::set<SgScopeStatement*>::const_iterator i = call_scopes.begin (); i != call_scopes.end (); ++i)
+    SageInterface::fixVariableReferences (*i);
+  for (std::set<SgSourceFile*>::const_iterator i = src_files.begin (); i != src_files.end (); ++i)
+    AstPostProcessing (*i);
+
+  return results;
+}
+
+/**
+ * Major work of outlining is done here
+ *  Preparations: given by the analysis of the target
+ *  Generate outlined function
+ *  Replace outlining target with a function call
+ *  Append dependent declarations,headers to new file if needed
+ */
+Outliner::Result
+Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str, BlockAnalysis& info, bool postprocess)
+{
+  //---------step 1. Preparations-----------------------------------
+  //new file, cut preprocessing information
+  // Generate a new source file for the outlined function, if requested
+  SgSourceFile* new_file = NULL;
+  if (Outliner::useNewFile)
+    new_file = generateNewSourceFile(s,func_name_str);
+
+  // Save some preprocessing information for later restoration. 
+  AttachedPreprocessingInfoType ppi_before, ppi_after;
+  ASTtools::cutPreprocInfo (s, PreprocessingInfo::before, ppi_before);
+  ASTtools::cutPreprocInfo (s, PreprocessingInfo::after, ppi_after);
+
+  // Variables to be passed and the analysis results of the target
+  ASTtools::VarSymSet_t& syms = info.syms;
+  ASTtools::VarSymSet_t& pdSyms = info.pdSyms;
+  const std::set<SgInitializedName*>& readOnlyVars = info.readOnlyVars;
+  const std::set< SgInitializedName *>& liveOuts = info.liveOuts;
 
   // Insert outlined function.
   // grab target scope first
@@ -397,7 +458,8 @@ Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
   ASTtools::pastePreprocInfoFront (ppi_before, func_call);
   ASTtools::pastePreprocInfoBack  (ppi_after, func_call);
 
-  SageInterface::fixVariableReferences(p_scope);
+  if (postprocess)
+    SageInterface::fixVariableReferences(p_scope);
 
   //-----------handle dependent declarations, headers if new file is generated-------------
   if (new_file)
@@ -461,7 +523,8 @@ Outliner::outlineBlock (SgBasicBlock* s, const string& func_name_str)
   // Run the AST fixup on the AST for the source file.
   SgSourceFile* originalSourceFile = TransformationSupport::getSourceFile(src_scope);
   //     printf ("##### Calling AstPostProcessing() on SgFile = %s \n",originalSourceFile->getFileName().c_str());
-  AstPostProcessing (originalSourceFile);
+  if (postprocess)
+    AstPostProcessing (originalSourceFile);
   //     printf ("##### DONE: Calling AstPostProcessing() on SgFile = %s \n",originalSourceFile->getFileName().c_str());
 #else
   printf ("Skipping call to AstPostProcessing (originalSourceFile); \n");
@@ -7,6 +7,7 @@
 // tps (01/14/2010) : Switching from rose.h to sage3.
 #include "sage3basic.h"
 #include <algorithm>
+#include <map>
 
 #include "VarSym.hh"
 
@@ -284,6 +285,29 @@ ASTtools::collectDefdVarSyms (const SgStatement* s, VarSymSet_t& syms)
   for_each (vars_local.begin (), vars_local.end (), bind2nd (ptr_fun (getVarSyms), &syms));
 }
 
+//! Collect the variable symbols declared at 'n', for collectLocalVisibleVarSyms().
+static
+void
+getLocalVarSyms (SgNode* n, ASTtools::VarSymSet_t* p_syms)
+{
+  getVarSyms (n, p_syms);
+#if 1
+  // Liao, 12/18/2007
+  // for Fortran, variables without declarations are legal,but easy to miss
+  // grab them all from symbol tables
+  SgScopeStatement* scope = isSgScopeStatement(n);
+  if(scope) {
+    SgSymbolTable * table = scope->get_symbol_table();
+    std::set<SgNode*> nodeset = table->get_symbolSet();
+    for (std::set<SgNode*>::iterator i=nodeset.begin();i!=nodeset.end();i++)
+    {
+        SgVariableSymbol* varsymbol = isSgVariableSymbol (*i);
+        if(varsymbol) getVarSyms (varsymbol, p_syms);
+    }
+  }// end if scope
+#endif
+}
+
 void
 ASTtools::collectLocalVisibleVarSyms (const SgStatement* root,
                                       const SgStatement* target,
@@ -303,22 +327,7 @@ ASTtools::collectLocalVisibleVarSyms (const SgStatement* root,
       //Stop the traversal once target node is met.
       if (isSgStatement (n) == target_)
         throw string ("done");
-      getVarSyms (n, &syms_);
-#if 1
-      // Liao, 12/18/2007
-      // for Fortran, variables without declarations are legal,but easy to miss
-      // grab them all from symbol tables
-      SgScopeStatement* scope = isSgScopeStatement(n);
-      if(scope) {
-        SgSymbolTable * table = scope->get_symbol_table();
-        std::set<SgNode*> nodeset = table->get_symbolSet();
-        for (std::set<SgNode*>::iterator i=nodeset.begin();i!=nodeset.end();i++)
-        {
-            SgVariableSymbol* varsymbol = isSgVariableSymbol (*i);
-            if(varsymbol) getVarSyms (varsymbol, &syms_);
-        }
-      }// end if scope
-#endif
+      getLocalVarSyms (n, &syms_);
     }
 
   private:
@@ -338,6 +347,58 @@ ASTtools::collectLocalVisibleVarSyms (const SgStatement* root,
     }
 }
 
+void
+ASTtools::collectLocalVisibleVarSyms (const SgStatement* root,
+                                      const std::vector<const SgStatement*>& targets,
+                                      std::vector<VarSymSet_t>& syms)
+{
+  //! Traversal that records the symbols collected so far at each target, stopping after the last one.
+  class Collector : public AstSimpleProcessing
+  {
+  public:
+    Collector (const std::vector<const SgStatement*>& targets, std::vector<VarSymSet_t>& syms)
+      : syms_ (syms), left_ (0)
+    {
+      for (size_t i = 0; i < targets.size (); ++i)
+        if (targets_.insert (make_pair (targets[i], i)).second)
+          ++left_;
+    }
+
+    virtual void visit (SgNode* n)
+    {
+      std::map<const SgStatement*, size_t>::const_iterator t = targets_.find (isSgStatement (n));
+      if (t != targets_.end ())
+      {
+        syms_[t->second] = seen_;
+        if (--left_ == 0)
+          throw string ("done");
+      }
+      getLocalVarSyms (n, &seen_);
+    }
+
+  private:
+    std::map<const SgStatement*, size_t> targets_; //!< Position of each target in 'syms_'.
+    std::vector<VarSymSet_t>& syms_; //!< Symbols visible at each target.
+    VarSymSet_t seen_; //!< Symbols collected so far.
+    size_t left_; //!< Number of targets not met yet.
+  };
+
+  syms.clear ();
+  syms.resize (targets.size ());
+  if (targets.empty ())
+    return;
+
+  Collector collector (targets, syms);
+  try
+    {
+      collector.traverse (const_cast<SgStatement *> (root), preorder);
+    }
+  catch (string& stopped_early)
+    {
+      ROSE_ASSERT (stopped_early == "done");
+    }
+}
+
 //! Collect variable reference a using addresses within s, 
 //including &a expression and foo(a) when type2 foo(Type& parameter) in C++
 void ASTtools::collectVarRefsUsingAddress(const SgStatement* s, std::set<SgVarRefExp* >& varSetB)
@@ -10,6 +10,7 @@
 #define INC_ASTTOOLS_VARSYM_HH
 
 #include <set>
+#include <vector>
 #include "Outliner.hh"
 
 class SgVariableSymbol;
@@ -36,6 +37,15 @@ namespace ASTtools
                                    const SgStatement* target,
                                    VarSymSet_t& syms);
 
+  /*!
+   *  Same as above for several targets below 'root' at once, in one
+   *  traversal: syms[i] receives the symbols visible to targets[i].
+   */
+  ROSE_DLL_API
+  void collectLocalVisibleVarSyms (const SgStatement* root,
+                                   const std::vector<const SgStatement*>& targets,
+                                   std::vector<VarSymSet_t>& syms);
+
   //! Convert a variable symbol set to a string-friendly form for debugging.
   ROSE_DLL_API std::string toString (const VarSymSet_t& syms);
 
@@ -9,6 +9,9 @@
 #ifndef ROSE_CONSTANT_FOLDING_H
 #define ROSE_CONSTANT_FOLDING_H
 
+#include <utility>
+#include <vector>
+
 namespace ConstantFolding {
 
 // Build an inherited attribute for the tree traversal to skip constant folded expressions
@@ -34,20 +37,48 @@ class ConstantFoldingInheritedAttribute
              {};
    };
 
+// A constant value computed by the folding traversal, typed like a C/C++ arithmetic value so that the width and
+// signedness of the operations are those of the source language
+class ConstantValue
+   {
+     public:
+          enum Type
+             {
+               None, // not a constant
+               Bool, Char, UnsignedChar, Short, UnsignedShort, Int, UnsignedInt, Long, UnsignedLong, LongLong, UnsignedLongLong,
+               Float, Double, LongDouble
+             };
+
+          Type type;
+       // Integer types: the value truncated to the width of the type, sign extended for signed types
+          unsigned long long bits;
+       // Floating point types: the value rounded to the precision of the type
+          long double real;
+
+          ConstantValue() : type(None), bits(0), real(0) {};
+          bool isConstant() const { return type != None; };
+   };
+
 class ConstantFoldingSynthesizedAttribute
    {
      public:
-          SgValueExp* newValueExp;
+          SgExpression* expression;
+          ConstantValue value;
 
-          ConstantFoldingSynthesizedAttribute() : newValueExp(NULL) {};
+          ConstantFoldingSynthesizedAttribute() : expression(NULL) {};
           ConstantFoldingSynthesizedAttribute ( const ConstantFoldingSynthesizedAttribute & X )
-             : newValueExp(X.newValueExp) {};
+             : expression(X.expression), value(X.value) {};
    };
 
+// Folding is done in one bottom-up pass computing the values of constant subexpressions. The largest constant
+// subtrees found are recorded and replaced by value expressions after the traversal, so the AST is not modified
+// while it is traversed and each node is visited once.
 class ConstantFoldingTraversal
    : public SgTopDownBottomUpProcessing<ConstantFoldingInheritedAttribute,ConstantFoldingSynthesizedAttribute>
    {
      public:
+          ConstantFoldingTraversal(SgNode* root);
+
        // Functions required by the rewrite mechanism
           ConstantFoldingInheritedAttribute evaluateInheritedAttribute (
              SgNode* n, 
@@ -56,7 +87,18 @@ class ConstantFoldingTraversal
              SgNode* n,
              ConstantFoldingInheritedAttribute inheritedAttribute,
              SubTreeSynthesizedAttributes synthesizedAttributeList );
+
+       // Replace the recorded constant subtrees by their values
+          void replaceFoldedExpressions();
+
+     private:
+       // The node the traversal starts at, which is not folded itself
+          SgNode* root;
+       // Comparisons and logical operators yield bool (C++) rather than int (C)
+          bool boolComparisons;
+          std::vector<std::pair<SgExpression*, ConstantValue> > foldedExpressions;
    };
+
 //! This is the external interface of constant folding:
 //It relies on the EDG frontend to do constant folding by default. 
 // The original source code pass trough EDG will have all constant fold already  (not know how)
@@ -67,6 +109,7 @@ class ConstantFoldingTraversal
 ROSE_DLL_API void constantFoldingOptimization(SgNode* n, bool internalTestingAgainstFrontend = false);
 
 // DQ (6/13/2015): Added support to return the constant valued expression.
+// Returns a new value expression for the value of n if it is constant, NULL otherwise.
 ROSE_DLL_API SgValueExp* returnConstantFoldedValueExpression(SgNode* n, bool internalTestingAgainstFrontend = false);
 
 // ***************************************************************************
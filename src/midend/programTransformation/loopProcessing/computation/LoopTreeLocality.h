@@ -3,6 +3,9 @@
 #define LOOP_TREE_LOCALITY
 
 #include <LoopTreeDepComp.h>
+#include <set>
+#include <string>
+#include <vector>
 
 struct DepCompAstRef { 
   AstNodePtr orig; 
@@ -90,11 +93,31 @@ class LoopTreeLocalityAnal
   LoopTreeDepGraph* GetInputGraph() { return &inputCreate; }
   LoopTreeDepComp& GetDepComp() { return comp; }
 
+  // the induction variable of the loop at level 'loop' in the original code of n
+  std::string LoopIvarName( LoopTreeNode *n, int loop);
   float SelfSpatialReuses( LoopTreeNode *n, int loop, int linesize);
   int TemporaryReuseRefs(LoopTreeNode *s1, int loop1, LoopTreeNode *s2, int loop2,
                    AstNodeSet &refSet, int reuseDist);
 };
 
+// The data that one tile of a loop nest touches, estimated from the strides at
+// which the loops of the nest sweep each array reference. References to the
+// same array that are swept at the same strides are counted once, since they
+// touch about the same data, e.g. the neighbouring elements a stencil reads.
+class LoopNestFootprint
+{
+  typedef std::vector<unsigned> Strides;  // in bytes, one per loop of the nest
+  std::set<std::pair<std::string, Strides> > refs;
+ public:
+  // Adds the array references of statement s; levels[i] is the loop level of
+  // the i-th loop of the nest around s, or -1 if s isn't inside that loop.
+  void AddStmt( LoopTreeLocalityAnal& anal, LoopTreeNode* s, const std::vector<int>& levels);
+  unsigned NumOfRefs() const { return refs.size(); }
+  // The number of distinct blocks of 'blocksize' bytes -- cache lines or pages --
+  // touched by a tile of tiles[i] iterations of each loop i.
+  double Blocks( const std::vector<unsigned>& tiles, unsigned blocksize) const;
+};
+
 class DepCompAstRefGraphCreate: public DepInfoGraphCreate<DepCompAstRefGraphNode> 
 {
   typedef std::map<DepCompAstRef, DepCompAstRefGraphNode*, std::less<DepCompAstRef> > AstRefNodeMap; 
@@ -21,6 +21,8 @@ class DepInfoAnal
       DomainCond domain; 
       std::vector<SymbolicVar> ivars;
       std::vector<SymbolicBound> ivarbounds;
+      AstNodePtr nest; // the outermost enclosing loop
+
       bool IsTop() const { return domain.IsTop(); }
    };
    struct StmtRefInfo { 
@@ -91,6 +93,33 @@ class AdhocDependenceTesting : public DependenceTesting {
                        const DepInfoAnal::StmtRefDep& ref, DepType deptype);
 };
 
+// Results of the array dependence tests, kept across rebuilds of the dependence
+// graph of a loop nest. A result is keyed on the symbolic subscripts of the two
+// references, the induction variables, bounds and domains of their loops, the
+// common loop and the dependence type, so that references with the same
+// subscripts in the same context share one test. Results are only kept for
+// pairs of references within one loop nest, and are dropped when the nest is
+// transformed; a transformation that changes a loop nest outside of
+// LoopTreeDepCompCreate::CodeGen must call Invalidate itself.
+class DepTestCache
+{
+  std::map<AstNodePtr, std::map<std::string, DepInfo> > nests;
+  unsigned hits, misses;
+  DepTestCache() : hits(0), misses(0) {}
+ public:
+  static DepTestCache& get_inst();
+  // whether the cache is used at all; it's off with -nodepcache
+  static bool enabled();
+
+  bool Lookup( const AstNodePtr& nest, const std::string& key, DepInfo& result);
+  void Insert( const AstNodePtr& nest, const std::string& key, const DepInfo& result);
+  // drop the results of the loop nest enclosing top and of the nests within top
+  void Invalidate( AstInterface& fa, const AstNodePtr& top);
+  void Clear() { nests.clear(); }
+  unsigned NumOfHits() const { return hits; }
+  unsigned NumOfMisses() const { return misses; }
+};
+
 bool AnalyzeStmtRefs( AstInterface& fa, const AstNodePtr& n,
                       CollectObject<AstNodePtr> &wRefs, 
                       CollectObject<AstNodePtr> &rRefs);
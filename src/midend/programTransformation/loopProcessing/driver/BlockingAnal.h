@@ -83,6 +83,24 @@ class AllLoopReuseBlocking : public LoopBlocking
                         const CompSliceDepGraphNode::FullNestInfo& nestInfo);
 };
 
+/* Blocks all loops like AllLoopReuseBlocking, with the sizes chosen from the footprint of
+   a block of the nest: the largest blocks whose data fit in half of the given
+   cache level (and whose pages fit in the TLB, for levels within its reach) are
+   selected, level by level from the innermost, each level's blocks containing
+   those of the level inside it. The cache levels and TLB come from -bk_cache and
+   -bk_tlb. With -dt the sizes are left to be tuned empirically at run time. */
+class CacheModelBlocking : public AllLoopReuseBlocking
+{
+  unsigned level;
+ public:
+  CacheModelBlocking( unsigned l) : level(l) {}
+  virtual LoopTransformOptions::OptType GetOptimizationType() { return LoopTransformOptions::LOOP_NEST_OPT; }
+  /* return the innermost slice after blocking */
+  virtual const CompSlice* 
+  SetBlocking( CompSliceLocalityRegistry *anal, 
+                        const CompSliceDepGraphNode::FullNestInfo& nestInfo);
+};
+
 class ParameterizeBlocking : public AllLoopReuseBlocking
 {
  protected:
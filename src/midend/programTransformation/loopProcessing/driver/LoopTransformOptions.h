@@ -29,6 +29,11 @@ class ROSE_DLL_API LoopTransformOptions
           std::string GetExpl() const { return expl; }
           virtual ~OptRegistryType() {}
          };
+  // a level of the cache hierarchy of the target machine; sizes in bytes
+  struct CacheLevel {
+     unsigned size, linesize;
+     CacheLevel( unsigned s, unsigned l) : size(s), linesize(l) {}
+  };
  private:
   static LoopTransformOptions *inst;
 
@@ -40,6 +45,8 @@ class ROSE_DLL_API LoopTransformOptions
   LoopPar * parOp;
   CopyArrayOperator* cpOp;
   unsigned cacheline, reuseDist, splitlimit, defaultblocksize, parblocksize;
+  std::vector<CacheLevel> cachelevels; // innermost first
+  unsigned tlbentries, pagesize;
   LoopTransformOptions();
   ~LoopTransformOptions();
 
@@ -59,6 +66,9 @@ class ROSE_DLL_API LoopTransformOptions
   unsigned GetTransAnalSplitLimit() const { return splitlimit; }
   unsigned GetDefaultBlockSize() const { return defaultblocksize; }
   unsigned GetParBlockSize() const { return parblocksize; }
+  const std::vector<CacheLevel>& GetCacheLevels() const { return cachelevels; }
+  unsigned GetTLBEntries() const { return tlbentries; }
+  unsigned GetPageSize() const { return pagesize; }
   void SetDefaultBlockSize(unsigned size) { defaultblocksize = size; }
   void SetParBlockSize(unsigned size) { parblocksize = size; }
   bool DoDynamicTuning() const;
@@ -78,6 +88,8 @@ class ROSE_DLL_API LoopTransformOptions
   void SetCacheLineSize( unsigned sel) { cacheline = sel; }
   void SetReuseDistance( unsigned sel) { reuseDist = sel; }
   void SetTransAnalSplitLimit( unsigned sel) { splitlimit = sel; }
+  void SetCacheLevels( const std::vector<CacheLevel>& levels) { cachelevels = levels; }
+  void SetTLB( unsigned entries, unsigned psize) { tlbentries = entries; pagesize = psize; }
 };
 
 
@@ -19,6 +19,7 @@ class CompSliceLocalityAnal
                       AstNodeSet& refSet);
   float SpatialReuses( const CompSlice *slice1);
   unsigned GetCacheLineSize() const { return linesize; }
+  LoopTreeLocalityAnal& GetLoopTreeAnal() { return anal; }
 };
 
 class CompSliceLocalityRegistry : protected CompSliceLocalityAnal
@@ -99,6 +100,7 @@ class CompSliceLocalityRegistry : protected CompSliceLocalityAnal
   int SpatialReuses(const CompSlice *slice1, const CompSlice *slice2);
   int TemporaryReuses(const CompSlice* slice);
   float SpatialReuses( const CompSlice *slice);
+  LoopTreeLocalityAnal& GetLoopTreeAnal() { return CompSliceLocalityAnal::GetLoopTreeAnal(); }
 };
 
 #endif
@@ -129,6 +129,15 @@ extern bool XOMP_master(void);
 extern void XOMP_atomic_start (void);
 extern void XOMP_atomic_end (void);
 
+// Combine each thread's partial result of a reduction into the shared variable, using one of the XOMP_REDUCTION_*
+// operations defined below. All threads of the team must call it for each reduction variable, in the same order.
+// The partial results are combined up a tree of per-thread slots of the team instead of in a critical section, and
+// the shared variable is written by the master thread. No thread returns before the shared variable is updated.
+extern void XOMP_reduction_int (int * shared, int local, int reduction_op);
+extern void XOMP_reduction_long (long * shared, long local, int reduction_op);
+extern void XOMP_reduction_float (float * shared, float local, int reduction_op);
+extern void XOMP_reduction_double (double * shared, double local, int reduction_op);
+
 extern void XOMP_loop_end (void);
 extern void XOMP_loop_end_nowait (void);
    // --- end loop functions ---
@@ -211,6 +220,14 @@ extern bool xomp_freeDevice(void* devPtr);
 // free the host memory pointed by a pointer, return false in case of failure, otherwise return true
 extern bool xomp_freeHost(void* hostPtr);
 
+// page-locked host memory from a pool, sizes are rounded up to a power of two. Released buffers are kept for reuse.
+extern void* xomp_pinnedMalloc(size_t size);
+extern void xomp_pinnedFree(void* hostPtr);
+
+// wait for the transfers of mapped variables still in progress on a device,
+// see XOMP_ASYNC_TRANSFER, XOMP_TRANSFER_CHUNK and XOMP_DEVICE_CACHE in xomp_cuda_lib.cu
+extern void xomp_transferSynchronize(int devID);
+
 /* Allocation/Free functions for Host */
 /* Allocate a multi-dimensional array
  *
@@ -229,7 +246,7 @@ extern void xomp_freeArrayPointer (void* array, int * dimensions, size_t dimensi
 
 /* CUDA reduction support */
 //------------ types for CUDA reduction support---------
-// Reduction for regular OpenMP is supported by compiler translation. No runtime support is needed.
+// Reduction for regular OpenMP is supported by compiler translation, using XOMP_reduction_*() for the common types.
 // For the accelerator model experimental implementation, we use a two-level reduction method:
 // thread-block level within GPU + beyond-block level on CPU
 
@@ -4456,6 +4456,53 @@ static void insertOmpLastprivateCopyBackStmts(SgStatement* ompStmt, vector <SgSt
   }
   end_stmt_list.push_back(save_stmt);
 
+}
+
+  //! Return the integer representing a reduction operation in libxomp.h (XOMP_REDUCTION_PLUS, etc.), or -1 if the runtime has none
+static int getReductionOperatorValue(SgOmpClause::omp_reduction_operator_enum r_operator)
+{
+  switch (r_operator)
+  {
+    case SgOmpClause::e_omp_reduction_plus:
+      return 6;
+    case SgOmpClause::e_omp_reduction_minus:
+      return 7;
+    case SgOmpClause::e_omp_reduction_mul:
+      return 8;
+    case SgOmpClause::e_omp_reduction_bitand:
+      return 9;
+    case SgOmpClause::e_omp_reduction_bitor:
+      return 10;
+    case SgOmpClause::e_omp_reduction_bitxor:
+      return 11;
+    case SgOmpClause::e_omp_reduction_logand:
+      return 12;
+    case SgOmpClause::e_omp_reduction_logor:
+      return 13;
+      //TODO: more operation types
+    default:
+      return -1;
+  }
+}
+
+  //! Return the type suffix of the XOMP_reduction_* () runtime function for a reduction variable's type, or an empty string if there is none
+static string getReductionRuntimeTypeName(SgType* type, SgOmpClause::omp_reduction_operator_enum r_operator)
+{
+  ROSE_ASSERT (type != NULL);
+  type = type->stripTypedefsAndModifiers();
+  if (isSgTypeInt(type))
+    return "int";
+  if (isSgTypeLong(type))
+    return "long";
+  // bitwise operations are only defined for integer types
+  if (r_operator == SgOmpClause::e_omp_reduction_bitand || r_operator == SgOmpClause::e_omp_reduction_bitor ||
+      r_operator == SgOmpClause::e_omp_reduction_bitxor)
+    return "";
+  if (isSgTypeFloat(type))
+    return "float";
+  if (isSgTypeDouble(type))
+    return "double";
+  return "";
 }
 
   //!Generate copy-back statements for reduction variables
@@ -4463,17 +4510,29 @@ static void insertOmpLastprivateCopyBackStmts(SgStatement* ompStmt, vector <SgSt
   // bb1: the affected code block by the reduction clause
   // orig_var: the reduction variable's original copy
   // local_decl: the local copy of the reduction variable
-  // Two ways to do the reduction operation: 
+  // Three ways to do the reduction operation: 
   //1. builtin function TODO
   //    __sync_fetch_and_add_4(&shared, (unsigned int)local);
   //2. using atomic runtime call: 
   //    GOMP_atomic_start ();
   //    shared = shared op local;
   //    GOMP_atomic_end ();
-  // We use the 2nd method only for now for simplicity and portability
+  //3. using the XOMP runtime, which combines the partial results of the threads up a tree without locking:
+  //    XOMP_reduction_int (&shared, local, XOMP_REDUCTION_PLUS);
+  // We use the 3rd method for C/C++ variables of the types supported by XOMP, and the 2nd method otherwise
 static void insertOmpReductionCopyBackStmts (SgOmpClause::omp_reduction_operator_enum r_operator, vector <SgStatement* >& end_stmt_list,  SgBasicBlock* bb1, SgInitializedName* orig_var, SgVariableDeclaration* local_decl)
 {
 #ifdef ENABLE_XOMP
+  int op_value = getReductionOperatorValue(r_operator);
+  string type_name = getReductionRuntimeTypeName(orig_var->get_type(), r_operator);
+  if (!SageInterface::is_Fortran_language() && op_value >= 0 && !type_name.empty())
+  {
+    SgExprListExp* parameter_list = buildExprListExp(buildAddressOfOp(buildVarRefExp(orig_var, bb1)), buildVarRefExp(local_decl),
+                                                     buildIntVal(op_value));
+    end_stmt_list.push_back(buildFunctionCallStmt("XOMP_reduction_"+type_name, buildVoidType(), parameter_list, bb1));
+    return;
+  }
+
   SgExprStatement* atomic_start_stmt = buildFunctionCallStmt("XOMP_atomic_start", buildVoidType(), NULL, bb1); 
 #else  
   SgExprStatement* atomic_start_stmt = buildFunctionCallStmt("GOMP_atomic_start", buildVoidType(), NULL, bb1); 
@@ -4488,8 +4547,8 @@ static void insertOmpReductionCopyBackStmts (SgOmpClause::omp_reduction_operator
     case SgOmpClause::e_omp_reduction_mul:
       r_exp = buildMultiplyOp(buildVarRefExp(orig_var, bb1), buildVarRefExp(local_decl)); 
       break;
-    case SgOmpClause::e_omp_reduction_minus:
-      r_exp = buildSubtractOp(buildVarRefExp(orig_var, bb1), buildVarRefExp(local_decl)); 
+    case SgOmpClause::e_omp_reduction_minus: // the partial results of a minus reduction are added, like in XOMP_reduction_*()
+      r_exp = buildAddOp(buildVarRefExp(orig_var, bb1), buildVarRefExp(local_decl)); 
       break;
     case SgOmpClause::e_omp_reduction_bitand:
       r_exp = buildBitAndOp(buildVarRefExp(orig_var, bb1), buildVarRefExp(local_decl)); 
@@ -4538,49 +4597,9 @@ static void insertInnerThreadBlockReduction(SgOmpClause::omp_reduction_operator_
 {
    ROSE_ASSERT (bb1 && orig_var && local_decl && per_block_decl);  
    // the integer value representing different reduction operations, defined within libxomp.h for accelerator model
-   // TODO refactor the code to have a function converting operand types to integers
-  int op_value = -1;
-  switch (r_operator)
-  {
-    case SgOmpClause::e_omp_reduction_plus:
-      op_value = 6;
-      break;
-    case SgOmpClause::e_omp_reduction_minus:
-      op_value = 7;
-      break;
-    case SgOmpClause::e_omp_reduction_mul:
-      op_value = 8;
-      break;
-    case SgOmpClause::e_omp_reduction_bitand:
-      op_value = 9;
-      break;
-    case SgOmpClause::e_omp_reduction_bitor:
-      op_value = 10;
-      break;
-    case SgOmpClause::e_omp_reduction_bitxor:
-      op_value = 11;
-      break;
-    case SgOmpClause::e_omp_reduction_logand:
-      op_value = 12;
-      break;
-    case SgOmpClause::e_omp_reduction_logor:
-      op_value = 13;
-      break;
-      //TODO: more operation types
-    case SgOmpClause::e_omp_reduction_and: // Fortran .and.
-    case SgOmpClause::e_omp_reduction_or: // Fortran .or.
-    case SgOmpClause::e_omp_reduction_eqv:
-    case SgOmpClause::e_omp_reduction_neqv:
-    case SgOmpClause::e_omp_reduction_max:
-    case SgOmpClause::e_omp_reduction_min:
-    case SgOmpClause::e_omp_reduction_iand:
-    case SgOmpClause::e_omp_reduction_ior:
-    case SgOmpClause::e_omp_reduction_ieor:
-    case SgOmpClause::e_omp_reduction_unknown:
-    case SgOmpClause::e_omp_reduction_last:
-    default:
-      cerr<<"Error. insertThreadBlockReduction() in omp_lowering.cpp: Illegal or unhandled reduction operator type:"<< r_operator<<endl;
-  }
+  int op_value = getReductionOperatorValue(r_operator);
+  if (op_value < 0)
+    cerr<<"Error. insertThreadBlockReduction() in omp_lowering.cpp: Illegal or unhandled reduction operator type:"<< r_operator<<endl;
 
   SgVariableSymbol* var_sym = getFirstVarSym(per_block_decl);
   ROSE_ASSERT (var_sym != NULL);
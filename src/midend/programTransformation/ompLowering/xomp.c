@@ -22,6 +22,8 @@ extern int omp_get_num_threads(void);
 #include <assert.h>
 #include <stdarg.h>
 #include <string.h> // for memcpy()
+#include <stdint.h> // for uintptr_t
+#include <sched.h> // for sched_yield()
 
 /* Timing support, Liao 2/15/2013 */
 #include <sys/time.h>
@@ -56,6 +58,707 @@ double xomp_time_stamp(void)
   return time;
 }
 
+//------------------------------------------------------------------------------
+// Native task and dynamic loop scheduling runtime, enabled by XOMP_NATIVE=1
+//
+// Tasks are queued in per-thread deques: the owner pushes and pops at the tail, idle threads steal from the
+// head of a victim's deque. Each deque has its own lock, so threads only contend when they steal from the same
+// victim. Task records come from per-thread free lists refilled by slabs, so there is no limit on the number
+// of tasks. Tasks nested deeper than XOMP_TASK_CUTOFF (default 16, 0 for no limit) run immediately in their
+// creator.
+//
+// Dynamic loops give each thread a contiguous range of chunks. A thread takes chunks from its own range and,
+// once it is empty, steals half of the remaining chunks of another thread.
+//
+// Like the rest of XOMP, nested parallelism is not supported.
+//------------------------------------------------------------------------------
+static bool xomp_native = false;
+static int xomp_task_cutoff = 16;
+
+#define XOMP_MAX_THREADS 1024
+#define XOMP_TASK_SLAB 64 // task records allocated at once
+#define XOMP_TASK_INLINE_DATA 128 // task data up to this size is stored in the task record
+#define XOMP_LOOP_SLOTS 8 // dynamic loops a thread may be ahead of the slowest one
+
+typedef struct xomp_task
+{
+  void (*fn) (void *);
+  void *data;
+  void *heap_data; // data allocated outside the record, if any
+  struct xomp_task *parent;
+  volatile long refs; // 1 until the task finishes, plus 1 per unfinished child
+  int depth;
+  bool implicit; // the implicit task of a thread, never released
+  struct xomp_task *next_free;
+  union { char bytes[XOMP_TASK_INLINE_DATA]; long double ld; void *p; } buffer;
+} xomp_task_t;
+
+typedef struct xomp_chunk_range
+{
+  volatile int lock;
+  long next, end; // chunks [next, end) not taken yet
+  char pad[64];
+} xomp_chunk_range_t;
+
+typedef struct xomp_loop
+{
+  volatile long seq; // loop instance using the slot, -1 while being set up, 0 if unused
+  volatile long done; // threads that got all their chunks
+  long nthreads;
+  long start, incr, chunk_size, iter_count;
+  xomp_chunk_range_t *ranges;
+  long capacity;
+} xomp_loop_t;
+
+typedef struct xomp_thread
+{
+  int id;
+  volatile int lock; // protects the deque
+  xomp_task_t **deque;
+  long head, tail, capacity; // tasks are deque[head..tail), indices taken modulo capacity
+  xomp_task_t *free_list;
+  xomp_task_t implicit_task;
+  xomp_task_t *current;
+  long loop_seq; // dynamic loops started in the current parallel region
+  xomp_loop_t *loop; // the native dynamic loop being executed, if any
+  char pad[64];
+} xomp_thread_t;
+
+static xomp_thread_t * volatile xomp_threads[XOMP_MAX_THREADS];
+static volatile long xomp_pending_tasks = 0; // created and not finished
+static xomp_loop_t xomp_loops[XOMP_LOOP_SLOTS];
+
+static void xomp_lock (volatile int *lock)
+{
+  while (__sync_lock_test_and_set(lock, 1))
+    while (*lock)
+      ;
+}
+
+static void xomp_unlock (volatile int *lock)
+{
+  __sync_lock_release(lock);
+}
+
+// State of the current thread, created on first use
+static xomp_thread_t * xomp_self (void)
+{
+  int id = omp_get_thread_num();
+  assert (id < XOMP_MAX_THREADS);
+  xomp_thread_t *ts = xomp_threads[id];
+  if (ts == NULL)
+  {
+    ts = (xomp_thread_t *) calloc (1, sizeof(xomp_thread_t));
+    if (ts == NULL)
+    {
+      printf("xomp.c xomp_self(), calloc failed for the state of thread %d.\n", id);
+      exit (3);
+    }
+    ts->id = id;
+    ts->implicit_task.refs = 1;
+    ts->implicit_task.implicit = true;
+    ts->current = &(ts->implicit_task);
+    __sync_synchronize();
+    xomp_threads[id] = ts;
+  }
+  return ts;
+}
+
+static xomp_task_t * xomp_task_alloc (xomp_thread_t *ts, long arg_size, long arg_align)
+{
+  xomp_task_t *t = ts->free_list;
+  if (t == NULL)
+  {
+    int i;
+    xomp_task_t *slab = (xomp_task_t *) malloc (sizeof(xomp_task_t) * XOMP_TASK_SLAB);
+    if (slab == NULL)
+    {
+      printf("xomp.c xomp_task_alloc(), malloc failed for %d tasks.\n", XOMP_TASK_SLAB);
+      exit (3);
+    }
+    for (i = 0; i < XOMP_TASK_SLAB; i++)
+      slab[i].next_free = (i + 1 < XOMP_TASK_SLAB) ? &slab[i + 1] : NULL;
+    t = slab;
+  }
+  ts->free_list = t->next_free;
+
+  if (arg_align < 1)
+    arg_align = 1;
+  t->heap_data = NULL;
+  if (arg_size <= XOMP_TASK_INLINE_DATA && arg_align <= __alignof__(t->buffer))
+    t->data = t->buffer.bytes;
+  else
+  {
+    t->heap_data = malloc (arg_size + arg_align);
+    if (t->heap_data == NULL)
+    {
+      printf("xomp.c xomp_task_alloc(), malloc failed for %ld bytes of task data.\n", arg_size);
+      exit (3);
+    }
+    t->data = (void *) (((uintptr_t) t->heap_data + arg_align - 1) & ~(uintptr_t) (arg_align - 1));
+  }
+  t->implicit = false;
+  return t;
+}
+
+// Drop a reference to a task, putting its record into the free list of the current thread once unused
+static void xomp_task_release (xomp_thread_t *ts, xomp_task_t *t)
+{
+  if (__sync_sub_and_fetch(&(t->refs), 1) == 0 && !t->implicit)
+  {
+    free (t->heap_data);
+    t->next_free = ts->free_list;
+    ts->free_list = t;
+  }
+}
+
+static void xomp_deque_push (xomp_thread_t *ts, xomp_task_t *t)
+{
+  xomp_lock (&(ts->lock));
+  if (ts->tail - ts->head == ts->capacity)
+  {
+    long i, capacity = ts->capacity == 0 ? 64 : 2 * ts->capacity;
+    xomp_task_t **deque = (xomp_task_t **) malloc (sizeof(xomp_task_t *) * capacity);
+    if (deque == NULL)
+    {
+      printf("xomp.c xomp_deque_push(), malloc failed for %ld tasks.\n", capacity);
+      exit (3);
+    }
+    for (i = ts->head; i < ts->tail; i++)
+      deque[i % capacity] = ts->deque[i % ts->capacity];
+    free (ts->deque);
+    ts->deque = deque;
+    ts->capacity = capacity;
+  }
+  ts->deque[ts->tail % ts->capacity] = t;
+  ts->tail++;
+  xomp_unlock (&(ts->lock));
+}
+
+// Newest task of the thread's own deque
+static xomp_task_t * xomp_deque_pop (xomp_thread_t *ts)
+{
+  xomp_task_t *t = NULL;
+  if (ts->tail == ts->head)
+    return NULL;
+  xomp_lock (&(ts->lock));
+  if (ts->tail > ts->head)
+  {
+    ts->tail--;
+    t = ts->deque[ts->tail % ts->capacity];
+  }
+  xomp_unlock (&(ts->lock));
+  return t;
+}
+
+// Oldest task of another thread's deque
+static xomp_task_t * xomp_deque_steal (xomp_thread_t *victim)
+{
+  xomp_task_t *t = NULL;
+  if (victim->tail == victim->head)
+    return NULL;
+  xomp_lock (&(victim->lock));
+  if (victim->tail > victim->head)
+  {
+    t = victim->deque[victim->head % victim->capacity];
+    victim->head++;
+  }
+  xomp_unlock (&(victim->lock));
+  return t;
+}
+
+static void xomp_task_run (xomp_thread_t *ts, xomp_task_t *t)
+{
+  xomp_task_t *parent = t->parent;
+  xomp_task_t *prev = ts->current;
+  ts->current = t;
+  t->fn (t->data);
+  ts->current = prev;
+  xomp_task_release (ts, t);
+  xomp_task_release (ts, parent);
+  __sync_sub_and_fetch(&xomp_pending_tasks, 1);
+}
+
+// Run one queued task, the thread's own newest or else one stolen from another thread. Returns false if none was found.
+static bool xomp_task_run_one (xomp_thread_t *ts)
+{
+  xomp_task_t *t = xomp_deque_pop (ts);
+  if (t == NULL)
+  {
+    int k, n = omp_get_num_threads();
+    for (k = 1; k < n && t == NULL; k++)
+    {
+      xomp_thread_t *victim = xomp_threads[(ts->id + k) % n];
+      if (victim != NULL)
+        t = xomp_deque_steal (victim);
+    }
+  }
+  if (t == NULL)
+    return false;
+  xomp_task_run (ts, t);
+  return true;
+}
+
+static void xomp_native_task (void (*fn) (void *), void *data, void (*cpyfn) (void *, void *),
+                              long arg_size, long arg_align, bool if_clause)
+{
+  xomp_thread_t *ts = xomp_self();
+  xomp_task_t *parent = ts->current;
+  bool deferred = if_clause && omp_get_num_threads() > 1 && (xomp_task_cutoff <= 0 || parent->depth < xomp_task_cutoff);
+
+  // An undeferred task without a copy function uses the data in place
+  xomp_task_t *t = xomp_task_alloc (ts, (deferred || cpyfn) ? arg_size : 0, arg_align);
+  if (cpyfn)
+    cpyfn (t->data, data);
+  else if (deferred)
+    memcpy (t->data, data, arg_size);
+  else
+    t->data = data;
+  t->fn = fn;
+  t->parent = parent;
+  t->depth = parent->depth + 1;
+  t->refs = 1;
+  __sync_add_and_fetch(&(parent->refs), 1);
+  __sync_add_and_fetch(&xomp_pending_tasks, 1);
+
+  if (deferred)
+    xomp_deque_push (ts, t);
+  else
+    xomp_task_run (ts, t);
+}
+
+// Wait for the children of the current task, running queued tasks meanwhile
+static void xomp_native_taskwait (void)
+{
+  xomp_thread_t *ts = xomp_self();
+  xomp_task_t *current = ts->current;
+  while (current->refs > 1)
+    if (!xomp_task_run_one (ts))
+      sched_yield();
+}
+
+// Run queued tasks until all tasks of the team are finished, before a barrier
+static void xomp_native_drain (void)
+{
+  xomp_thread_t *ts = xomp_self();
+  while (xomp_pending_tasks > 0)
+    if (!xomp_task_run_one (ts))
+      sched_yield();
+}
+
+// Reset the state of the current thread at the start of a parallel region
+static void xomp_native_region_enter (void)
+{
+  xomp_thread_t *ts = xomp_self();
+  ts->loop_seq = 0;
+  ts->loop = NULL;
+}
+
+// Reset the loop slots, done by the master before the team starts
+static void xomp_native_region_init (void)
+{
+  int i;
+  for (i = 0; i < XOMP_LOOP_SLOTS; i++)
+  {
+    xomp_loops[i].seq = 0;
+    xomp_loops[i].done = 0;
+    xomp_loops[i].nthreads = 0;
+  }
+  __sync_synchronize();
+}
+
+// Bounds of the chunk number c of a loop, with inclusive upper bound
+static void xomp_loop_chunk_bounds (xomp_loop_t *loop, long c, long *istart, long *iend)
+{
+  long first = c * loop->chunk_size;
+  long count = loop->iter_count - first < loop->chunk_size ? loop->iter_count - first : loop->chunk_size;
+  *istart = loop->start + first * loop->incr;
+  *iend = *istart + (count - 1) * loop->incr;
+}
+
+static bool xomp_native_loop_next (long *istart, long *iend)
+{
+  xomp_thread_t *ts = xomp_self();
+  xomp_loop_t *loop = ts->loop;
+  xomp_chunk_range_t *own;
+  long c = -1;
+  int k;
+  assert (loop != NULL);
+  own = &(loop->ranges[ts->id]);
+
+  xomp_lock (&(own->lock));
+  if (own->next < own->end)
+    c = own->next++;
+  xomp_unlock (&(own->lock));
+
+  // Steal half of the chunks left to another thread, keeping all but the first one in the own range
+  for (k = 1; c < 0 && k < loop->nthreads; k++)
+  {
+    xomp_chunk_range_t *victim = &(loop->ranges[(ts->id + k) % loop->nthreads]);
+    long taken = 0, first = 0;
+    if (victim->end - victim->next <= 0)
+      continue;
+    xomp_lock (&(victim->lock));
+    if (victim->end > victim->next)
+    {
+      taken = (victim->end - victim->next + 1) / 2;
+      victim->end -= taken;
+      first = victim->end;
+    }
+    xomp_unlock (&(victim->lock));
+    if (taken > 0)
+    {
+      c = first;
+      xomp_lock (&(own->lock));
+      own->next = first + 1;
+      own->end = first + taken;
+      xomp_unlock (&(own->lock));
+    }
+  }
+
+  if (c < 0)
+  {
+    __sync_add_and_fetch(&(loop->done), 1);
+    return false;
+  }
+  xomp_loop_chunk_bounds (loop, c, istart, iend);
+  return true;
+}
+
+// Start a dynamic loop with inclusive upper bound. The first thread to arrive sets up the loop in the next
+// slot, once the loop that used the slot before is finished by all threads.
+static bool xomp_native_loop_start (long start, long end, long incr, long chunk_size, long *istart, long *iend)
+{
+  xomp_thread_t *ts = xomp_self();
+  long my_seq = ++(ts->loop_seq);
+  xomp_loop_t *loop = &(xomp_loops[my_seq % XOMP_LOOP_SLOTS]);
+
+  for (;;)
+  {
+    long seq = loop->seq;
+    if (seq == my_seq)
+      break;
+    if (seq >= 0 && seq < my_seq && loop->done == loop->nthreads && __sync_bool_compare_and_swap(&(loop->seq), seq, -1))
+    {
+      long t, chunk_count, nthreads = omp_get_num_threads();
+      if (chunk_size < 1)
+        chunk_size = 1;
+      loop->start = start;
+      loop->incr = incr;
+      loop->chunk_size = chunk_size;
+      // the division truncates toward zero, so an empty loop gets a count of 0 or less
+      loop->iter_count = (end - start + incr) / incr;
+      if (loop->iter_count < 0)
+        loop->iter_count = 0;
+      chunk_count = (loop->iter_count + chunk_size - 1) / chunk_size;
+      if (loop->capacity < nthreads)
+      {
+        free (loop->ranges);
+        loop->ranges = (xomp_chunk_range_t *) calloc (nthreads, sizeof(xomp_chunk_range_t));
+        if (loop->ranges == NULL)
+        {
+          printf("xomp.c xomp_native_loop_start(), calloc failed for %ld threads.\n", nthreads);
+          exit (3);
+        }
+        loop->capacity = nthreads;
+      }
+      for (t = 0; t < nthreads; t++)
+      {
+        loop->ranges[t].next = chunk_count * t / nthreads;
+        loop->ranges[t].end = chunk_count * (t + 1) / nthreads;
+      }
+      loop->nthreads = nthreads;
+      loop->done = 0;
+      __sync_synchronize();
+      loop->seq = my_seq;
+      break;
+    }
+    sched_yield();
+  }
+
+  ts->loop = loop;
+  return xomp_native_loop_next (istart, iend);
+}
+
+// Whether the current thread is in a native dynamic loop, which is then left
+static bool xomp_native_loop_end (void)
+{
+  xomp_thread_t *ts;
+  if (!xomp_native)
+    return false;
+  ts = xomp_self();
+  if (ts->loop == NULL)
+    return false;
+  ts->loop = NULL;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Teams, reductions and the native barrier
+//
+// Each parallel region started by XOMP_parallel_start() has a team descriptor, which every thread of the team
+// finds in a thread local variable while it runs the region. Nested or concurrent teams use different
+// descriptors, so their reductions and barriers are independent.
+//
+// A reduction combines the partial values of the threads up a binomial tree: at step s, a thread whose id has
+// bit s set posts its value to its own slot, and thread id - s combines that value into its own. Thread 0 ends
+// up with the combined value, which it combines into the shared variable before it releases the team. So no
+// thread leaves a reduction before the shared variable is updated. Each slot is written by one thread and read
+// by one other, and the slots are padded to separate cache lines.
+//
+// The native barrier is a dissemination barrier: in round k each thread signals thread id + 2^k and waits for
+// the signal of thread id - 2^k (modulo the number of threads), so there is no counter shared by all threads.
+// The signals are counted rather than flagged, so the barrier can be reused without resetting anything.
+//------------------------------------------------------------------------------
+#define XOMP_BARRIER_ROUNDS 10 // enough for XOMP_MAX_THREADS
+#define XOMP_SPIN_COUNT 1000 // busy waiting iterations before yielding the processor
+
+typedef union xomp_reduction_value
+{
+  int i;
+  long l;
+  float f;
+  double d;
+} xomp_reduction_value_t;
+
+typedef struct xomp_reduction_slot
+{
+  volatile int full; // a value was posted and not combined yet
+  xomp_reduction_value_t value;
+  long passed; // reductions the thread took part in, only used by the thread itself
+  char pad[64];
+} xomp_reduction_slot_t;
+
+typedef struct xomp_barrier_flags
+{
+  volatile long signals[XOMP_BARRIER_ROUNDS]; // signals received in each round
+  long waits[XOMP_BARRIER_ROUNDS]; // barriers passed in each round, only used by the thread itself
+  char pad[64];
+} xomp_barrier_flags_t;
+
+typedef struct xomp_team
+{
+  void (*func) (void *);
+  void *data;
+  struct xomp_team *started_before; // the team started before by the same master thread, still running
+  void * volatile reduction_slots; // one xomp_reduction_slot_t per thread, allocated by the first reduction
+  void * volatile barrier_flags; // one xomp_barrier_flags_t per thread, allocated by the first native barrier
+  volatile long reductions_done; // reductions whose shared variable was updated
+  char pad[64];
+} xomp_team_t;
+
+static __thread xomp_team_t *xomp_team = NULL; // the team of the region the thread runs
+static __thread xomp_team_t *xomp_started_team = NULL; // the last team started by the thread as a master
+
+// Allocate the team of a parallel region, done by the master before the team starts
+static xomp_team_t * xomp_team_start (void (*func) (void *), void *data)
+{
+  xomp_team_t *team = (xomp_team_t *) calloc (1, sizeof(xomp_team_t));
+  if (team == NULL)
+  {
+    printf("xomp.c xomp_team_start(), calloc failed for a team.\n");
+    exit (3);
+  }
+  team->func = func;
+  team->data = data;
+  team->started_before = xomp_started_team;
+  xomp_started_team = team;
+  return team;
+}
+
+// Free the team started last by the master thread, once all the threads of the team finished the region
+static void xomp_team_end (void)
+{
+  xomp_team_t *team = xomp_started_team;
+  if (team == NULL)
+    return;
+  xomp_started_team = team->started_before;
+  free (team->reduction_slots);
+  free (team->barrier_flags);
+  free (team);
+}
+
+// Body of a parallel region run by each thread: the outlined function, and with the native runtime, the tasks left
+// before the implicit barrier at the end of the region
+static void xomp_team_region (void *data)
+{
+  xomp_team_t *team = (xomp_team_t *) data;
+  xomp_team_t *outer = xomp_team;
+  xomp_team = team;
+  if (xomp_native)
+    xomp_native_region_enter();
+  team->func (team->data);
+  if (xomp_native)
+    xomp_native_drain();
+  xomp_team = outer;
+}
+
+// Per-thread array of the current team, allocated by the first thread that needs it
+static void * xomp_team_array (void * volatile *array, size_t element_size)
+{
+  void *p = *array;
+  if (p == NULL)
+  {
+    assert (xomp_team != NULL);
+    p = calloc (omp_get_num_threads(), element_size);
+    if (p == NULL)
+    {
+      printf("xomp.c xomp_team_array(), calloc failed for %d threads.\n", omp_get_num_threads());
+      exit (3);
+    }
+    if (!__sync_bool_compare_and_swap(array, NULL, p))
+    {
+      free (p);
+      p = *array;
+    }
+  }
+  return p;
+}
+
+// Busy wait a little, then yield the processor so that oversubscribed threads can make progress
+static void xomp_spin_wait (long *spins)
+{
+  if (++(*spins) >= XOMP_SPIN_COUNT)
+  {
+    *spins = 0;
+    sched_yield();
+  }
+}
+
+// Combine the partial values of a reduction of the team. Returns true in thread 0, whose value is then the
+// combined value of all the threads, and which must call xomp_reduction_release() once it used the value. The
+// other threads return once thread 0 released the team.
+static bool xomp_reduction_tree (xomp_reduction_value_t *value, int reduction_op,
+                                 void (*combine) (xomp_reduction_value_t *, const xomp_reduction_value_t *, int))
+{
+  int id = omp_get_thread_num(), n = omp_get_num_threads();
+  int s;
+  xomp_reduction_slot_t *slots;
+  if (n == 1)
+    return true;
+  slots = (xomp_reduction_slot_t *) xomp_team_array (&(xomp_team->reduction_slots), sizeof(xomp_reduction_slot_t));
+  slots[id].passed++;
+  for (s = 1; s < n; s *= 2)
+  {
+    long spins = 0;
+    if (id & s)
+    {
+      // the slot is empty: the previous reduction was combined before thread 0 released the team
+      xomp_reduction_slot_t *own = &(slots[id]);
+      own->value = *value;
+      __sync_synchronize();
+      own->full = 1;
+      while (xomp_team->reductions_done < own->passed)
+        xomp_spin_wait (&spins);
+      __sync_synchronize();
+      return false;
+    }
+    if (id + s < n)
+    {
+      xomp_reduction_slot_t *child = &(slots[id + s]);
+      while (!child->full)
+        xomp_spin_wait (&spins);
+      __sync_synchronize();
+      combine (value, &(child->value), reduction_op);
+      __sync_synchronize();
+      child->full = 0;
+    }
+  }
+  return true;
+}
+
+// Let the other threads of the team leave the current reduction, done by thread 0 once it updated the shared variable
+static void xomp_reduction_release (void)
+{
+  if (xomp_team == NULL || omp_get_num_threads() == 1)
+    return;
+  __sync_add_and_fetch(&(xomp_team->reductions_done), 1);
+}
+
+#define XOMP_REDUCTION_ARITHMETIC_CASES(acc, val) \
+    case XOMP_REDUCTION_PLUS: \
+    case XOMP_REDUCTION_MINUS: /* partial results of a minus reduction are added */ \
+      acc += val; \
+      break; \
+    case XOMP_REDUCTION_MUL: \
+      acc *= val; \
+      break; \
+    case XOMP_REDUCTION_LOGAND: \
+      acc = acc && val; \
+      break; \
+    case XOMP_REDUCTION_LOGOR: \
+      acc = acc || val; \
+      break;
+
+#define XOMP_REDUCTION_BITWISE_CASES(acc, val) \
+    case XOMP_REDUCTION_BITAND: \
+      acc &= val; \
+      break; \
+    case XOMP_REDUCTION_BITOR: \
+      acc |= val; \
+      break; \
+    case XOMP_REDUCTION_BITXOR: \
+      acc ^= val; \
+      break;
+
+#define XOMP_REDUCTION_DEF(dtype, member, cases) \
+static void xomp_reduction_combine_##dtype (xomp_reduction_value_t *acc, const xomp_reduction_value_t *val, int reduction_op) \
+{ \
+  switch (reduction_op) \
+  { \
+    cases(acc->member, val->member) \
+    default: \
+      printf("xomp.c XOMP_reduction_" #dtype "(), unhandled reduction operation %d.\n", reduction_op); \
+      assert (0); \
+  } \
+} \
+void XOMP_reduction_##dtype (dtype *shared, dtype local, int reduction_op) \
+{ \
+  xomp_reduction_value_t value; \
+  value.member = local; \
+  if (xomp_reduction_tree (&value, reduction_op, xomp_reduction_combine_##dtype)) \
+  { \
+    xomp_reduction_value_t total; \
+    total.member = *shared; \
+    xomp_reduction_combine_##dtype (&total, &value, reduction_op); \
+    *shared = total.member; \
+    xomp_reduction_release(); \
+  } \
+}
+
+#define XOMP_REDUCTION_INTEGER_CASES(acc, val) XOMP_REDUCTION_ARITHMETIC_CASES(acc, val) XOMP_REDUCTION_BITWISE_CASES(acc, val)
+
+XOMP_REDUCTION_DEF(int, i, XOMP_REDUCTION_INTEGER_CASES)
+XOMP_REDUCTION_DEF(long, l, XOMP_REDUCTION_INTEGER_CASES)
+XOMP_REDUCTION_DEF(float, f, XOMP_REDUCTION_ARITHMETIC_CASES)
+XOMP_REDUCTION_DEF(double, d, XOMP_REDUCTION_ARITHMETIC_CASES)
+
+#undef XOMP_REDUCTION_DEF
+#undef XOMP_REDUCTION_INTEGER_CASES
+#undef XOMP_REDUCTION_BITWISE_CASES
+#undef XOMP_REDUCTION_ARITHMETIC_CASES
+
+static void xomp_native_barrier (void)
+{
+  int id = omp_get_thread_num(), n = omp_get_num_threads();
+  int k, s;
+  xomp_barrier_flags_t *flags, *own;
+  if (n == 1)
+    return;
+  assert (n <= XOMP_MAX_THREADS);
+  flags = (xomp_barrier_flags_t *) xomp_team_array (&(xomp_team->barrier_flags), sizeof(xomp_barrier_flags_t));
+  own = &(flags[id]);
+  for (k = 0, s = 1; s < n; k++, s *= 2)
+  {
+    long spins = 0;
+    __sync_fetch_and_add(&(flags[(id + s) % n].signals[k]), 1);
+    own->waits[k]++;
+    while (own->signals[k] < own->waits[k])
+      xomp_spin_wait (&spins);
+  }
+  __sync_synchronize();
+}
+
 #if 0
 enum omp_rtl_enum {
   e_undefined,
@@ -118,6 +821,22 @@ void XOMP_init (int argc, char ** argv)
     env_region_instr_val = env_var_val;
   }
 
+  env_var_str = getenv("XOMP_NATIVE");
+  if (env_var_str != NULL)
+  {
+    sscanf(env_var_str, "%d", &env_var_val);
+    assert (env_var_val==0 || env_var_val == 1);
+    xomp_native = env_var_val;
+  }
+
+  env_var_str = getenv("XOMP_TASK_CUTOFF");
+  if (env_var_str != NULL)
+  {
+    sscanf(env_var_str, "%d", &env_var_val);
+    assert (env_var_val >= 0);
+    xomp_task_cutoff = env_var_val;
+  }
+
   if (env_region_instr_val)
   {
     char* instr_file_name;
@@ -244,6 +963,11 @@ void XOMP_parallel_start (void (*func) (void *), void *data, unsigned ifClauseVa
     fprintf (fp,"%f\t1\t%s\t%d\n",xomp_time_stamp(),file_name, line_no);
     fprintf (fp, "%f\t2\t%s\t%d\n",xomp_time_stamp(),file_name, line_no);
   }
+  if (xomp_native)
+    xomp_native_region_init ();
+  // every thread runs the region through xomp_team_region(), which makes the team known to the thread
+  data = xomp_team_start (func, data);
+  func = xomp_team_region;
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY 
   // XOMP  to GOMP
   unsigned numThread = 0;
@@ -283,6 +1007,7 @@ void XOMP_parallel_end (char* file_name, int line_no)
   GOMP_parallel_end ();
 #else   
 #endif    
+  xomp_team_end ();
 }
 
 
@@ -338,6 +1063,8 @@ void xomp_sections_end(void)
 /* Called after the current thread is told that all sections are executed. It synchronizes all threads also. */
 void XOMP_sections_end(void)
 {
+  if (xomp_native)
+    xomp_native_drain();
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY  
   GOMP_sections_end();
 #else
@@ -361,9 +1088,6 @@ void XOMP_sections_end_nowait(void)
 
 //---------------------------------------------
 #include "run_me_task_defs.inc"
-// statically allocated pg_parameter
-#define MAX_XOMP_TASK_NUMBER 99999 // cannot be too large, otherwise exceed static allocation limit
-void *task_parameter[MAX_XOMP_TASK_NUMBER][MAX_OUTLINED_FUNC_PARAMETER_COUNT];
 void xomp_task(void (*func) (void *), void (*cpyfn) (void *, void *), int* arg_size, int* arg_align, 
                int* if_clause, int* untied, int * argcount, ...);
 #pragma weak xomp_task_=xomp_task
@@ -507,11 +1231,18 @@ void xomp_task(void (*func) (void *), void (*cpyfn) (void *, void *), int* arg_s
       assert (0);
       break;
   }
+  // the task has its own copy of the arg_size bytes of pg_parameter by now, or has already run
+  free (pg_parameter);
 }
 
 void XOMP_task (void (*fn) (void *), void *data, void (*cpyfn) (void *, void *),
                        long arg_size, long arg_align, bool if_clause, unsigned untied)
 {
+  if (xomp_native)
+  {
+    xomp_native_task (fn, data, cpyfn, arg_size, arg_align, if_clause);
+    return;
+  }
 
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY  
 //// only gcc 4.4.x has task support
@@ -529,6 +1260,11 @@ void XOMP_task (void (*fn) (void *), void *data, void (*cpyfn) (void *, void *),
 }
 void XOMP_taskwait (void)
 {
+  if (xomp_native)
+  {
+    xomp_native_taskwait();
+    return;
+  }
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY  
 //#if __GNUC__ > 4 || \           //
 //  (__GNUC__ == 4 && (__GNUC_MINOR__ > 4 || \  //
@@ -683,6 +1419,8 @@ void xomp_loop_dynamic_init(int* lower, int* upper, int* stride, int* chunk_size
 // scheduler initialization, only meaningful used for OMNI
 void XOMP_loop_dynamic_init(int lower, int upper, int stride, int chunk_size)
 {
+  if (xomp_native) // the native scheduler is set up by XOMP_loop_dynamic_start()
+    return;
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY  
   // empty operation for gomp
 #else
@@ -925,6 +1663,9 @@ bool XOMP_loop_dynamic_start (long start, long end, long incr, long chunk_size,l
   bool rt ;
   long lend;
 
+  if (xomp_native)
+    return xomp_native_loop_start (start, end, incr, chunk_size, istart, iend);
+
 // convert inclusive bounds of XOMP to non-inclusive upper bound from GOMP/OMNI
   if (incr>0 )
    end ++;
@@ -1340,6 +2081,8 @@ bool XOMP_loop_dynamic_next (long * l, long *u)
 {
   bool rt;
   long lu;
+  if (xomp_native)
+    return xomp_native_loop_next (l, u);
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY  
   rt = GOMP_loop_dynamic_next (l, &lu);
 #else
@@ -1658,6 +2401,14 @@ void xomp_loop_end(void)
 }
 void XOMP_loop_end (void)
 {
+  if (xomp_native_loop_end())
+  {
+    // the loop was not scheduled by the underlying runtime, only its barrier is needed
+    XOMP_barrier();
+    return;
+  }
+  if (xomp_native)
+    xomp_native_drain();
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY  
   GOMP_loop_end();
 #else   
@@ -1673,6 +2424,8 @@ void xomp_loop_end_nowait(void)
 
 void XOMP_loop_end_nowait (void)
 {
+  if (xomp_native_loop_end())
+    return;
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY  
   GOMP_loop_end_nowait();
 #else   
@@ -1688,6 +2441,12 @@ void xomp_barrier(void)
 }
 void XOMP_barrier (void)
 {
+  if (xomp_native)
+  {
+    xomp_native_drain();
+    xomp_native_barrier();
+    return;
+  }
 #ifdef USE_ROSE_GOMP_OPENMP_LIBRARY  
   GOMP_barrier();
 #else   
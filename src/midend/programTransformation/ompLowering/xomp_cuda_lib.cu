@@ -7,6 +7,7 @@ Liao 4/11/2012
 
 //#include "cuda_lib.h"
 #include "libxomp.h"
+#include <string.h> // for memcpy() and memcmp()
 //----------------------------------------------------
 // Device xomp_cuda_property retrieving functions
 
@@ -19,6 +20,55 @@ int xomp_max_num_devices =  -1; // -1 means un-initialized
 void** xomp_cuda_prop; 
 bool xomp_verbose = false;
 
+//----------------------------------------------------
+// Transfer pipeline, device data cache and pinned host buffers
+//
+// With XOMP_ASYNC_TRANSFER=1, mapped variables are copied through two pinned staging buffers of XOMP_TRANSFER_CHUNK
+// bytes (default 4 MB), each with its own stream: the host packs the next chunk into one buffer while the other
+// one is transferred. Copies to the device are not waited for; they are issued on blocking streams, so a kernel
+// launched on the default stream afterwards still runs after them. This relies on the legacy default stream and
+// must not be combined with nvcc --default-stream per-thread.
+//
+// With XOMP_DEVICE_CACHE=<MB>, the device memory of variables is kept up to that size after their data
+// environment is exited, and reused when the same section of the same variable is mapped again. A variable
+// copied back to the host also keeps a host copy of its device contents, which are then only copied to the
+// device again if the host data has changed since.
+//
+// Like the data environments, none of this is thread safe.
+
+#define XOMP_PINNED_BINS 64
+#define XOMP_PINNED_HEADER 64 // keeps the size class of a pinned buffer, and its alignment
+
+static void* xomp_pinned_free_lists[XOMP_PINNED_BINS];
+
+bool xomp_async_transfer = false;
+size_t xomp_transfer_chunk = 4 << 20;
+size_t xomp_device_cache_capacity = 0;
+
+typedef struct xomp_transfer_state
+{
+  cudaStream_t stream[2];
+  cudaEvent_t done[2]; // the copy from or to each staging buffer is finished
+  char* buffer[2];
+  int next; // the staging buffer to use next
+} xomp_transfer_state;
+
+typedef struct xomp_cached_variable
+{
+  void* address;
+  int nDim;
+  int typeSize;
+  int size[3], offset[3], DimSize[3];
+  void* dev_address;
+  size_t bytes;
+  char* shadow; // host copy of the device contents, NULL if they are unknown
+  struct xomp_cached_variable* next;
+} xomp_cached_variable;
+
+static xomp_transfer_state** xomp_transfers; // per device, created on first use
+static xomp_cached_variable** xomp_device_cache; // per device, most recently used first
+static size_t* xomp_device_cache_bytes;
+
 /* Set the device id to be used by the current task */
 void xomp_set_default_device (int devID)
 {
@@ -116,6 +166,33 @@ void xomp_acc_init(void)
   DDE_head = (DDE**)calloc(1,sizeof(DDE*)*xomp_max_num_devices);
   DDE_tail = (DDE**)calloc(1,sizeof(DDE*)*xomp_max_num_devices);
   xomp_cuda_prop = (void**)calloc(1,sizeof(void*)*xomp_max_num_devices);
+  xomp_transfers = (xomp_transfer_state**)calloc(1,sizeof(xomp_transfer_state*)*xomp_max_num_devices);
+  xomp_device_cache = (xomp_cached_variable**)calloc(1,sizeof(xomp_cached_variable*)*xomp_max_num_devices);
+  xomp_device_cache_bytes = (size_t*)calloc(1,sizeof(size_t)*xomp_max_num_devices);
+
+  char * env_var_str;
+  int  env_var_val;
+  env_var_str = getenv("XOMP_ASYNC_TRANSFER");
+  if (env_var_str != NULL)
+  {
+    sscanf(env_var_str, "%d", &env_var_val);
+    assert (env_var_val==0 || env_var_val == 1);
+    xomp_async_transfer = env_var_val;
+  }
+  env_var_str = getenv("XOMP_TRANSFER_CHUNK");
+  if (env_var_str != NULL)
+  {
+    sscanf(env_var_str, "%d", &env_var_val);
+    assert (env_var_val > 0);
+    xomp_transfer_chunk = env_var_val;
+  }
+  env_var_str = getenv("XOMP_DEVICE_CACHE");
+  if (env_var_str != NULL)
+  {
+    sscanf(env_var_str, "%d", &env_var_val);
+    assert (env_var_val >= 0);
+    xomp_device_cache_capacity = (size_t)env_var_val << 20;
+  }
 } 
 
 // this can be called multiple times. But the xomp_cuda_prop variable will only be set once
@@ -709,6 +786,343 @@ void copy_mapped_variable (struct XOMP_mapped_variable* desc, struct XOMP_mapped
   //desc->copyFrom= src ->copyFrom; 
 }
 
+//----------------------------------------------------
+// Transfer pipeline and device data cache, see the top of the file
+
+static void xomp_check (cudaError_t err, const char* what)
+{
+  if (err != cudaSuccess)
+  {
+    fprintf(stderr, "Error: %s failed: %s\n", what, cudaGetErrorString(err));
+    assert (false);
+  }
+}
+
+/* Allocate page-locked host memory, reusing buffers released by xomp_pinnedFree(). Sizes are rounded up to a power of two. */
+void* xomp_pinnedMalloc(size_t size)
+{
+  int bin = 12; // at least 4 KB
+  while (((size_t)1 << bin) < size)
+    bin++;
+  assert (bin < XOMP_PINNED_BINS);
+  char* block = (char*) xomp_pinned_free_lists[bin];
+  if (block != NULL)
+    xomp_pinned_free_lists[bin] = *(void**) block;
+  else
+  {
+    xomp_check (cudaMallocHost((void**)&block, XOMP_PINNED_HEADER + ((size_t)1 << bin)), "cudaMallocHost()");
+    *(int*)(block + sizeof(void*)) = bin;
+  }
+  return block + XOMP_PINNED_HEADER;
+}
+
+/* Return a buffer from xomp_pinnedMalloc() to the pool */
+void xomp_pinnedFree(void* hostPtr)
+{
+  if (hostPtr == NULL)
+    return;
+  char* block = (char*) hostPtr - XOMP_PINNED_HEADER;
+  int bin = *(int*)(block + sizeof(void*));
+  *(void**) block = xomp_pinned_free_lists[bin];
+  xomp_pinned_free_lists[bin] = block;
+}
+
+static xomp_transfer_state* xomp_getTransferState(int devID)
+{
+  if (xomp_transfers[devID] == NULL)
+  {
+    xomp_transfer_state* t = (xomp_transfer_state*) calloc (1, sizeof(xomp_transfer_state));
+    assert (t != NULL);
+    int i;
+    for (i = 0; i < 2; i++)
+    {
+      xomp_check (cudaStreamCreate(&(t->stream[i])), "cudaStreamCreate()");
+      xomp_check (cudaEventCreateWithFlags(&(t->done[i]), cudaEventDisableTiming), "cudaEventCreate()");
+      t->buffer[i] = (char*) xomp_pinnedMalloc(xomp_transfer_chunk);
+    }
+    xomp_transfers[devID] = t;
+  }
+  return xomp_transfers[devID];
+}
+
+/* Wait for all the copies issued through the staging buffers of a device */
+void xomp_transferSynchronize(int devID)
+{
+  if (xomp_transfers == NULL || xomp_transfers[devID] == NULL)
+    return;
+  xomp_check (cudaStreamSynchronize(xomp_transfers[devID]->stream[0]), "cudaStreamSynchronize()");
+  xomp_check (cudaStreamSynchronize(xomp_transfers[devID]->stream[1]), "cudaStreamSynchronize()");
+}
+
+// Number of contiguous host rows of a section, in the layout used by xomp_memScatterHostToDevice() and xomp_memGatherDeviceToHost()
+static size_t xomp_sectionRowCount(int* vsize, int ndim)
+{
+  assert (ndim >= 1 && ndim <= 3);
+  if (ndim == 1)
+    return 1;
+  if (ndim == 2)
+    return vsize[0];
+  return (size_t) vsize[2] * vsize[1];
+}
+
+// Element offsets of row k of a section in the host variable and in the device copy, and the row length
+static void xomp_sectionRow(size_t k, int* vsize, int* voffset, int* vDimSize, int ndim, size_t* host, size_t* packed, size_t* length)
+{
+  if (ndim == 1)
+  {
+    *host = voffset[0];
+    *packed = 0;
+    *length = vsize[0];
+  }
+  else if (ndim == 2)
+  {
+    *host = voffset[1] + (k + voffset[0]) * vDimSize[1];
+    *packed = k * vsize[1];
+    *length = vsize[1];
+  }
+  else
+  {
+    size_t j = k / vsize[1], i = k % vsize[1];
+    *host = (j + voffset[2]) * vDimSize[0] * vDimSize[1] + (voffset[1] + i) * vDimSize[0] + voffset[0];
+    *packed = j * vsize[1] * vsize[2] + i * vsize[0];
+    *length = vsize[0];
+  }
+}
+
+// Issue the copy of the filled part of the current staging buffer to the device
+static void xomp_flushToDevice(xomp_transfer_state* t, char* dest, size_t* fill)
+{
+  int b = t->next;
+  xomp_check (cudaMemcpyAsync(dest, t->buffer[b], *fill, cudaMemcpyHostToDevice, t->stream[b]), "cudaMemcpyAsync()");
+  xomp_check (cudaEventRecord(t->done[b], t->stream[b]), "cudaEventRecord()");
+  t->next = 1 - b;
+  *fill = 0;
+}
+
+// Pipelined version of xomp_memScatterHostToDevice(). Returns once the host data is staged, before it reaches the device.
+static void xomp_stagedScatterHostToDevice(int devID, void* dest, void* src, int* vsize, int* voffset, int* vDimSize, int ndim, int typeSize)
+{
+  xomp_transfer_state* t = xomp_getTransferState(devID);
+  size_t rows = xomp_sectionRowCount(vsize, ndim);
+  size_t fill = 0, run = 0; // bytes in the current staging buffer, and their offset in dest
+  size_t k;
+  for (k = 0; k < rows; k++)
+  {
+    size_t host, packed, length;
+    xomp_sectionRow(k, vsize, voffset, vDimSize, ndim, &host, &packed, &length);
+    host *= typeSize;
+    packed *= typeSize;
+    length *= typeSize;
+    while (length > 0)
+    {
+      if (fill > 0 && (packed != run + fill || fill == xomp_transfer_chunk))
+        xomp_flushToDevice(t, (char*)dest + run, &fill);
+      if (fill == 0)
+      {
+        // the buffer may still be copied from by an earlier transfer
+        xomp_check (cudaEventSynchronize(t->done[t->next]), "cudaEventSynchronize()");
+        run = packed;
+      }
+      size_t n = xomp_transfer_chunk - fill < length ? xomp_transfer_chunk - fill : length;
+      memcpy (t->buffer[t->next] + fill, (char*)src + host, n);
+      fill += n;
+      host += n;
+      packed += n;
+      length -= n;
+    }
+  }
+  if (fill > 0)
+    xomp_flushToDevice(t, (char*)dest + run, &fill);
+}
+
+// Pipelined version of xomp_memGatherDeviceToHost(): the next chunk is copied from the device while the previous one is unpacked
+static void xomp_stagedGatherDeviceToHost(int devID, void* dest, void* src, int* vsize, int* voffset, int* vDimSize, int ndim, int typeSize)
+{
+  xomp_transfer_state* t = xomp_getTransferState(devID);
+  size_t rows = xomp_sectionRowCount(vsize, ndim);
+  size_t k = 0, row_done = 0; // next row to request, and bytes of it already requested
+  size_t pending_row[2], pending_done[2], pending_bytes[2]; // first row and offset in it of what each buffer holds
+  int b = 0, in_flight = 0;
+
+  while (k < rows || in_flight > 0)
+  {
+    // Request the next contiguous run of the device copy into the free buffer
+    if (k < rows && in_flight < 2)
+    {
+      size_t host, packed, length, run = 0, fill = 0;
+      int nb = (b + in_flight) % 2;
+      pending_row[nb] = k;
+      pending_done[nb] = row_done;
+      while (k < rows && fill < xomp_transfer_chunk)
+      {
+        xomp_sectionRow(k, vsize, voffset, vDimSize, ndim, &host, &packed, &length);
+        packed = packed * typeSize + row_done;
+        length = length * typeSize - row_done;
+        if (fill == 0)
+          run = packed;
+        else if (packed != run + fill)
+          break;
+        size_t n = xomp_transfer_chunk - fill < length ? xomp_transfer_chunk - fill : length;
+        fill += n;
+        if (n == length)
+        {
+          k++;
+          row_done = 0;
+        }
+        else
+          row_done += n;
+      }
+      pending_bytes[nb] = fill;
+      xomp_check (cudaMemcpyAsync(t->buffer[nb], (char*)src + run, fill, cudaMemcpyDeviceToHost, t->stream[nb]), "cudaMemcpyAsync()");
+      xomp_check (cudaEventRecord(t->done[nb], t->stream[nb]), "cudaEventRecord()");
+      in_flight++;
+      if (in_flight < 2 && k < rows)
+        continue;
+    }
+
+    // Unpack the oldest buffer
+    xomp_check (cudaEventSynchronize(t->done[b]), "cudaEventSynchronize()");
+    size_t r = pending_row[b], done = pending_done[b], used = 0;
+    while (used < pending_bytes[b])
+    {
+      size_t host, packed, length;
+      xomp_sectionRow(r, vsize, voffset, vDimSize, ndim, &host, &packed, &length);
+      size_t n = length * typeSize - done;
+      if (n > pending_bytes[b] - used)
+        n = pending_bytes[b] - used;
+      memcpy ((char*)dest + host * typeSize + done, t->buffer[b] + used, n);
+      used += n;
+      done += n;
+      if (done == length * typeSize)
+      {
+        r++;
+        done = 0;
+      }
+    }
+    b = 1 - b;
+    in_flight--;
+  }
+}
+
+// Whether the host section of a variable is equal to the host copy of its device contents
+static bool xomp_sectionEquals(const char* shadow, void* src, int* vsize, int* voffset, int* vDimSize, int ndim, int typeSize)
+{
+  size_t rows = xomp_sectionRowCount(vsize, ndim);
+  size_t k;
+  for (k = 0; k < rows; k++)
+  {
+    size_t host, packed, length;
+    xomp_sectionRow(k, vsize, voffset, vDimSize, ndim, &host, &packed, &length);
+    if (memcmp (shadow + packed * typeSize, (char*)src + host * typeSize, length * typeSize) != 0)
+      return false;
+  }
+  return true;
+}
+
+static void xomp_discardCachedVariable(xomp_cached_variable* v)
+{
+  xomp_freeDevice(v->dev_address);
+  free (v->shadow);
+  free (v);
+}
+
+// Free cached device memory, least recently used first, until at most keep bytes are left
+static void xomp_evictDeviceCache(int devID, size_t keep)
+{
+  while (xomp_device_cache_bytes[devID] > keep)
+  {
+    xomp_cached_variable** last = &(xomp_device_cache[devID]);
+    while ((*last)->next != NULL)
+      last = &((*last)->next);
+    xomp_device_cache_bytes[devID] -= (*last)->bytes;
+    xomp_discardCachedVariable(*last);
+    *last = NULL;
+  }
+}
+
+// Take the cached device memory of a variable section out of the cache, NULL if there is none
+static xomp_cached_variable* xomp_findCachedVariable(int devID, void* address, int nDim, int typeSize, int* vsize, int* voffset, int* vDimSize)
+{
+  if (xomp_device_cache_capacity == 0 || nDim > 3)
+    return NULL;
+  xomp_cached_variable** p;
+  for (p = &(xomp_device_cache[devID]); *p != NULL; p = &((*p)->next))
+  {
+    xomp_cached_variable* v = *p;
+    bool matched = v->address == address && v->nDim == nDim && v->typeSize == typeSize;
+    int i;
+    for (i = 0; matched && i < nDim; i++)
+      matched = v->size[i] == vsize[i] && v->offset[i] == voffset[i] && v->DimSize[i] == vDimSize[i];
+    if (matched)
+    {
+      *p = v->next;
+      xomp_device_cache_bytes[devID] -= v->bytes;
+      return v;
+    }
+  }
+  return NULL;
+}
+
+// Keep the device memory of a variable leaving its data environment. Returns false if it must be freed instead.
+// The host data is the device contents if the variable has just been copied back.
+static bool xomp_cacheVariable(int devID, struct XOMP_mapped_variable* var, size_t bytes, bool copiedBack)
+{
+  if (xomp_device_cache_capacity == 0 || var->nDim > 3 || bytes > xomp_device_cache_capacity)
+    return false;
+  xomp_cached_variable* v = (xomp_cached_variable*) malloc (sizeof(xomp_cached_variable));
+  assert (v != NULL);
+  v->address = var->address;
+  v->nDim = var->nDim;
+  v->typeSize = var->typeSize;
+  int i;
+  for (i = 0; i < var->nDim; i++)
+  {
+    v->size[i] = var->size[i];
+    v->offset[i] = var->offset[i];
+    v->DimSize[i] = var->DimSize[i];
+  }
+  v->dev_address = var->dev_address;
+  v->bytes = bytes;
+  v->shadow = NULL;
+  if (copiedBack)
+  {
+    v->shadow = (char*) malloc (bytes);
+    size_t rows = xomp_sectionRowCount(var->size, var->nDim);
+    size_t k;
+    for (k = 0; v->shadow != NULL && k < rows; k++)
+    {
+      size_t host, packed, length;
+      xomp_sectionRow(k, var->size, var->offset, var->DimSize, var->nDim, &host, &packed, &length);
+      if ((packed + length) * var->typeSize > bytes) // rows of the device copy that don't fit in it
+      {
+        free (v->shadow);
+        v->shadow = NULL;
+      }
+      else
+        memcpy (v->shadow + packed * var->typeSize, (char*)var->address + host * var->typeSize, length * var->typeSize);
+    }
+  }
+  xomp_evictDeviceCache(devID, xomp_device_cache_capacity - bytes);
+  v->next = xomp_device_cache[devID];
+  xomp_device_cache[devID] = v;
+  xomp_device_cache_bytes[devID] += bytes;
+  return true;
+}
+
+// Allocate device memory for a variable, freeing cached device memory if the device is full
+static void* xomp_allocateDevice(int devID, size_t size)
+{
+  void* devPtr = NULL;
+  if (xomp_device_cache_capacity > 0 && xomp_device_cache_bytes[devID] > 0)
+  {
+    if (cudaMalloc(&devPtr, size) == cudaSuccess)
+      return devPtr;
+    cudaGetLastError(); // clear the error
+    xomp_evictDeviceCache(devID, 0);
+  }
+  return xomp_deviceMalloc(size);
+}
+
 // create a new DDE-data node and 
 // append it to the end of the tracking list, and 
 // copy all variables from its parent node to be into the set of inherited variable set.
@@ -916,15 +1330,30 @@ void* xomp_deviceDataEnvironmentPrepareVariable(int devID, void* original_variab
     {
       devSize *= vsize[i];
     }
-    dev_var_address = xomp_deviceMalloc(devSize*typeSize);
+    // Reuse the device memory left by an earlier data environment if possible
+    xomp_cached_variable* cached = xomp_findCachedVariable (devID, original_variable_address, nDim, typeSize, vsize, voffset, vDimSize);
+    if (cached != NULL)
+      dev_var_address = cached->dev_address;
+    else
+      dev_var_address = xomp_allocateDevice(devID, devSize*typeSize);
     xomp_deviceDataEnvironmentAddVariable (devID, original_variable_address, vsize, voffset, vDimSize, nDim, typeSize, dev_var_address, copy_into, copy_back);
     // The spec says : reuse enclosing data and discard map-type rule.
     // So map-type only matters when no-reuse happens
-    if (copy_into)
+    // The copy is redundant if the device already has the host values
+    if (copy_into && (cached == NULL || cached->shadow == NULL
+                      || !xomp_sectionEquals(cached->shadow, original_variable_address, vsize, voffset, vDimSize, nDim, typeSize)))
     {
-      xomp_memScatterHostToDevice(dev_var_address, original_variable_address, vsize, voffset, vDimSize, nDim, typeSize);
+      if (xomp_async_transfer)
+        xomp_stagedScatterHostToDevice(devID, dev_var_address, original_variable_address, vsize, voffset, vDimSize, nDim, typeSize);
+      else
+        xomp_memScatterHostToDevice(dev_var_address, original_variable_address, vsize, voffset, vDimSize, nDim, typeSize);
     //  xomp_memcpyHostToDevice(dev_var_address, original_variable_address, vsize[0]);
     }
+    if (cached != NULL)
+    {
+      free (cached->shadow);
+      free (cached);
+    }
   }
   assert (dev_var_address != NULL);
   return dev_var_address;
@@ -934,6 +1363,7 @@ void* xomp_deviceDataEnvironmentPrepareVariable(int devID, void* original_variab
 void xomp_deviceDataEnvironmentExit(int devID)
 {
   assert ( DDE_tail[devID] != NULL );
+  xomp_transferSynchronize(devID);
 
   // Deallocate mapped device variables which are allocated by this current DDE
   // Optionally copy the value back to host if specified.
@@ -944,11 +1374,19 @@ void xomp_deviceDataEnvironmentExit(int devID)
     void * dev_address = mapped_var->dev_address;
     if (mapped_var->copyFrom)
     {
+      if (xomp_async_transfer)
+        xomp_stagedGatherDeviceToHost(devID, mapped_var->address, mapped_var->dev_address, mapped_var->size, mapped_var->offset, mapped_var->DimSize, mapped_var->nDim, mapped_var->typeSize);
+      else
        xomp_memGatherDeviceToHost(((void *)((char*)mapped_var->address)),((void *)((char *)mapped_var->dev_address)), mapped_var->size,mapped_var->offset,mapped_var->DimSize, mapped_var->nDim,mapped_var->typeSize);
        //xomp_memcpyDeviceToHost(((void *)((char*)mapped_var->address+mapped_var->offset[0])),((const void *)mapped_var->dev_address), mapped_var->size[0]);
     }
+    size_t bytes = mapped_var->typeSize;
+    int d;
+    for (d = 0; d < mapped_var->nDim; d++)
+      bytes *= mapped_var->size[d];
     // free after copy back!!
-    xomp_freeDevice (dev_address); //TODO Will this work without type info? Looks so!
+    if (!xomp_cacheVariable(devID, mapped_var, bytes, mapped_var->copyFrom))
+      xomp_freeDevice (dev_address); //TODO Will this work without type info? Looks so!
   }
 
   // Deallocate pre-allocated variable lists
@@ -47,7 +47,10 @@ void partialRedundancyEliminationOne(
     const myControlFlowGraph& cfg);
 
 //! Do partial redundancy for all expressions within a given function, whose
-//! definition is given in n.
+//! definition is given in n.  Expressions are numbered by hash-consing, and
+//! the dataflow equations are solved for a whole batch of expressions at once
+//! using bit vectors, so the CFG is only rebuilt once per level of expression
+//! nesting instead of once per expression.
 void partialRedundancyEliminationFunction(SgFunctionDefinition* n);
 
 //! Do partial redundancy elimination on all functions within the scope n.
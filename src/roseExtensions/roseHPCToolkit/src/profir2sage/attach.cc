@@ -70,21 +70,10 @@ bool doFilenamesMatch(const SgLocatedNode* node, const std::string& filename)
 #endif
 }
 
-//! Check if the code portions specified by Sage Node and PROF ir'S located node [b-start, b_end]
-// have any kind of overlap 
-// Note: Profiling results only contain a single line source information. 
-//      ROSE AST has both start and end line information.
+//! Get the file name and the lines [start, end] a Sage node is matched against profile data with.
 static
-bool doLinesOverlap(const SgLocatedNode* node, const RoseHPCT::Located * plnode)
-//                size_t b_start, size_t b_end)
+void getSourceRange(const SgLocatedNode* node, std::string& filename, size_t& a_start, size_t& a_end)
 {
-    ROSE_ASSERT(plnode);
-    if (node == NULL
-        )
-        return false;
-    size_t b_start = plnode->getFirstLine();
-    size_t b_end = plnode->getLastLine();
-
    // Liao 1/25/2013, Adjust SgFunctionDefinition to be its enclosing defining function declaration, which will 
    // have the right start end end file locations to match profiling data
    // SgFunctionDefinition starts from the "{" in ROSE using EDG 4.4, instead of starting from its function declaration line.
@@ -98,26 +87,10 @@ bool doLinesOverlap(const SgLocatedNode* node, const RoseHPCT::Located * plnode)
    }
     Sg_File_Info* info_start = node_copy->get_startOfConstruct();
     ROSE_ASSERT (info_start != NULL);
-    // check file name first if possible
-    // DXN: see DXN's comment in doFilenamesMatch.
-    if (plnode->getFileNode())
-    {
-#if 1
-        std::string plnodeFileName = plnode->getFileNode()->getName();
-        std::string info_startFileName = info_start->get_filenameString();
-        int suffixLength = info_startFileName.length() - plnodeFileName.length();
-        std::string suffix = suffixLength >= 0? info_startFileName.substr(suffixLength): "";
-        if (plnodeFileName != suffix)
-            return false;
-#else
-        if (plnode->getFileNode()->getName() != info_start->get_filename())
-            return false;
-#endif
-    }
-    // Then check for line numbers
-    size_t a_start = (size_t) info_start->get_line();
+    filename = info_start->get_filenameString();
+    a_start = (size_t) info_start->get_line();
     Sg_File_Info* info_end = node_copy->get_endOfConstruct();
-    size_t a_end = (info_end == NULL) ? a_start : info_end->get_line();
+    a_end = (info_end == NULL) ? a_start : info_end->get_line();
     // adjust for wrong line information, See Bugs-Internal 311
     // some non-scope statement's end line numbers are not correct from ROSE
     // especially for SgForInitStatement and loop condition statements
@@ -125,7 +98,6 @@ bool doLinesOverlap(const SgLocatedNode* node, const RoseHPCT::Located * plnode)
     // This is generally risky for ROSE, but should work for ROSE-HPCT
     // since the HPCToolkit generates metrics specified with beginning line only
     // Liao, 2/2/2009
-#if 1    //
     //if ((a_end < a_start) || (isSgStatement(node) && !(isSgScopeStatement(node))))
     //Liao 1/25/2013: we have better file info now, supposlly
     if (a_end < a_start) 
@@ -133,12 +105,46 @@ bool doLinesOverlap(const SgLocatedNode* node, const RoseHPCT::Located * plnode)
         a_end = a_start;
         ROSE_ASSERT(false); // should not happen for ROSE using EDG 4.4
     }
+}
+
+//! Tell if the name of a profile file node is a suffix of a Sage node's file name
+// DXN: see DXN's comment in doFilenamesMatch.
+static
+bool doFilenamesMatch(const std::string& sg_filename, const RoseHPCT::File* filenode)
+{
+    const std::string& plnodeFileName = filenode->getName();
+    int suffixLength = sg_filename.length() - plnodeFileName.length();
+    std::string suffix = suffixLength >= 0? sg_filename.substr(suffixLength): "";
+    return plnodeFileName == suffix;
+}
+
+//! Check if the code portions specified by Sage Node and PROF ir'S located node [b-start, b_end]
+// have any kind of overlap 
+// Note: Profiling results only contain a single line source information. 
+//      ROSE AST has both start and end line information.
+static
+bool doLinesOverlap(const SgLocatedNode* node, const RoseHPCT::Located * plnode)
+//                size_t b_start, size_t b_end)
+{
+    ROSE_ASSERT(plnode);
+    if (node == NULL
+        )
+        return false;
+    size_t b_start = plnode->getFirstLine();
+    size_t b_end = plnode->getLastLine();
+
+    std::string filename;
+    size_t a_start, a_end;
+    getSourceRange(node, filename, a_start, a_end);
+    // check file name first if possible
+    if (plnode->getFileNode() && !doFilenamesMatch(filename, plnode->getFileNode()))
+        return false;
+    // Then check for line numbers
     if (b_end < b_start)
     {
         b_end = b_start;
         //ROSE_ASSERT(false); // Some metrics location information from HPCToolkit are buggy
     }
-#endif
     return (b_start <= a_start && a_end <= b_end) // SgNode's file portion is a subset of Profile's information
     || (a_start <= b_start && b_end <= a_end); // Profile's info is a subset of SgNode's portion
 //    || (a_start <= b_start && b_end <= a_end)  // redundant condition? TODO should be partial overlap
@@ -149,6 +155,50 @@ bool doLinesOverlap(const SgLocatedNode* node, const RoseHPCT::Located * plnode)
 
 /* ---------------------------------------------------------------- */
 
+/*!
+ *  \brief Index over a RoseHPCTIR tree, built once, telling which
+ *  subtrees may contain a located node matching a given source range.
+ *
+ *  For every subtree it records the lines covered by its located
+ *  nodes and, if they all belong to the same profile file node, that
+ *  file. A subtree whose lines do not overlap the range of a Sage
+ *  node, or whose file does not match the Sage node's file, cannot
+ *  contain a match for it and is skipped by MetricFinder without
+ *  being walked.  Which profile files match a Sage file name is
+ *  computed once per Sage file.
+ */
+class ProfileIndex
+{
+public:
+    ProfileIndex(const RoseHPCT::IRTree_t* hpc_root);
+
+    /*! \brief Returns 'false' if no located node in 'tree' can match
+     *  lines [a_start, a_end] of file 'filename'. */
+    bool mayMatch(const RoseHPCT::IRTree_t* tree, const std::string& filename, size_t a_start, size_t a_end);
+
+private:
+    //! Located nodes of a subtree
+    struct Span
+    {
+        Span(void) : has_located(false), first(0), last(0), file(0), single_file(false) {}
+        bool has_located; //!< Subtree has a located node
+        size_t first; //!< First line of any located node
+        size_t last; //!< Last line of any located node
+        const RoseHPCT::File* file; //!< File of all located nodes, when single_file
+        bool single_file; //!< All located nodes have the same file node
+    };
+    typedef std::map<const RoseHPCT::IRTree_t*, Span> Spans_t;
+
+    const Span& build(const RoseHPCT::IRTree_t* tree);
+    bool fileMatches(const RoseHPCT::File* file, const std::string& filename);
+
+    Spans_t spans_; //!< Span of each subtree
+    std::string filename_; //!< Sage file name file_matches_ refers to
+    std::map<const RoseHPCT::File*, bool> file_matches_; //!< Profile files matching filename_
+};
+
+/* ---------------------------------------------------------------- */
+
 /*!
  *  \brief Implements a RoseHPCTIR tree walk which searches for a metric
  *  that matches the given Sage node.
@@ -159,8 +209,10 @@ class MetricFinder: public Trees::Traversal<RoseHPCT::IRTree_t, true>
 public:
     typedef std::set<const RoseHPCT::IRNode *> MatchSet_t;
 
-    /*! \brief Initialize, specifying the target node, and a pointer to a record for matched IRNode to  SgNode to avoid redundant attachment*/
-    MetricFinder(const SgLocatedNode* target, std::map<const RoseHPCT::IRNode *, std::set<SgLocatedNode *> > * historyRecord);
+    /*! \brief Initialize, specifying the target node, and a pointer to a record for matched IRNode to  SgNode to avoid redundant attachment.
+     *  If an index of the profile tree is given, subtrees which cannot match the target are not searched. */
+    MetricFinder(const SgLocatedNode* target, std::map<const RoseHPCT::IRNode *, std::set<SgLocatedNode *> > * historyRecord,
+                 ProfileIndex* index = 0);
     virtual ~MetricFinder(void)
     {
     }
@@ -177,6 +229,9 @@ public:
     /*! \brief Returns a set of matching nodes. */
     const MatchSet_t& getMatches(void) const;
 
+    /*! \brief Returns 'true' if any kind of profile node can match the target. */
+    bool isSearchable(void) const;
+
 protected:
 
     MetricFinder(void);
@@ -235,6 +290,10 @@ protected:
     bool isTargetSgLoop(void) const;
     bool isTargetSgStatementNonScope(void) const;
     std::map<const RoseHPCT::IRNode *, std::set<SgLocatedNode *> > * historyRecord_; //! A map between IRNode to matched SgNodes, used to avoid redundant attaching for code expanded from macro, Liao, 2/3/2009
+    ProfileIndex* index_; //!< Index used to skip subtrees, may be NULL
+    std::string target_file_; //!< File name of the target, when index_ is used
+    size_t target_first_; //!< First line of the target, when index_ is used
+    size_t target_last_; //!< Last line of the target, when index_ is used
 
     //@}
 };
@@ -275,6 +334,7 @@ protected:
 
 private:
     const RoseHPCT::IRTree_t* hpc_root_; //!< Root of profiling data tree
+    ProfileIndex index_; //!< Index of the profiling data tree
     AttachedNodes_t attached_; //!< Lists of attached nodes
 #if 0  
     std::set<const RoseHPCT::IRNode *> files_; //!< set of all profir file nodes
@@ -290,13 +350,84 @@ using namespace RoseHPCT;
 
 /* ---------------------------------------------------------------- */
 
+ProfileIndex::ProfileIndex(const IRTree_t* hpc_root)
+{
+    if (hpc_root != NULL)
+        build(hpc_root);
+}
+
+const ProfileIndex::Span&
+ProfileIndex::build(const IRTree_t* tree)
+{
+    Span span;
+    if (const Located* l = dynamic_cast<const Located *>(tree->value))
+    {
+        span.has_located = true;
+        span.first = l->getFirstLine();
+        // same adjustment of buggy line information as in doLinesOverlap()
+        span.last = std::max(l->getFirstLine(), l->getLastLine());
+        span.file = l->getFileNode();
+        span.single_file = span.file != NULL;
+    }
+    for (IRTree_t::const_iterator i = tree->beginChild(); i != tree->endChild(); ++i)
+    {
+        const Span& child = build(i->second);
+        if (!child.has_located)
+            continue;
+        if (!span.has_located)
+            span = child;
+        else
+        {
+            span.first = std::min(span.first, child.first);
+            span.last = std::max(span.last, child.last);
+            if (!child.single_file || child.file != span.file)
+                span.single_file = false;
+        }
+    }
+    return spans_[tree] = span;
+}
+
+bool ProfileIndex::fileMatches(const File* file, const std::string& filename)
+{
+    if (filename != filename_)
+    {
+        filename_ = filename;
+        file_matches_.clear();
+    }
+    std::map<const File*, bool>::iterator i = file_matches_.find(file);
+    if (i == file_matches_.end())
+        i = file_matches_.insert(std::make_pair(file, doFilenamesMatch(filename, file))).first;
+    return i->second;
+}
+
+bool ProfileIndex::mayMatch(const IRTree_t* tree, const std::string& filename, size_t a_start, size_t a_end)
+{
+    Spans_t::const_iterator i = spans_.find(tree);
+    if (i == spans_.end())
+        return true; // not indexed
+    const Span& span = i->second;
+    if (!span.has_located)
+        return false;
+    // a match requires one range to contain the other, see doLinesOverlap()
+    if (a_end < span.first || span.last < a_start)
+        return false;
+    if (span.single_file && !fileMatches(span.file, filename))
+        return false;
+    return true;
+}
+
+/* ---------------------------------------------------------------- */
+
 MetricFinder::MetricFinder(void) :
-        target_(0), verbose_(false), prune_branch_(false), nonscope_stmt_target_(0), historyRecord_(0)
+        target_(0), verbose_(false), prune_branch_(false), nonscope_stmt_target_(0), historyRecord_(0),
+        index_(0), target_first_(0), target_last_(0)
 {
 }
 
-MetricFinder::MetricFinder(const SgLocatedNode* target, std::map<const RoseHPCT::IRNode *, SgLocNodeSet_t> * historyRecord) :
-        target_(target), verbose_(false), prune_branch_(false), nonscope_stmt_target_(0), historyRecord_(historyRecord)
+MetricFinder::MetricFinder(const SgLocatedNode* target, std::map<const RoseHPCT::IRNode *, SgLocNodeSet_t> * historyRecord,
+                           ProfileIndex* index) :
+        target_(target), verbose_(false), prune_branch_(false), nonscope_stmt_target_(0), historyRecord_(historyRecord),
+        index_(index), target_first_(0), target_last_(0)
 {
 #if 0  // not in use since it messes up metrics normalization by leaving a metric gap in AST
     //! SgForInitStatement is special, it is not under scope statement but should be
@@ -325,6 +456,11 @@ MetricFinder::MetricFinder(const SgLocatedNode* target, std::map<const RoseHPCT:
             nonscope_stmt_target_ = NULL;
         }
     }
+    // File nodes are matched by name only, so the index is not used for SgGlobal targets
+    if (index_ != NULL && isSearchable() && !isTargetSgGlobal())
+        getSourceRange(target_, target_file_, target_first_, target_last_);
+    else
+        index_ = NULL;
 }
 
 void MetricFinder::setVerbose(bool enable)
@@ -344,6 +480,8 @@ void MetricFinder::traverse(TreeParamPtr_t tree)
     if (tree == NULL
         )
         return;
+    if (index_ != NULL && !index_->mayMatch(tree, target_file_, target_first_, target_last_))
+        return;
 
     visit(tree);
     if (!found())
@@ -370,6 +508,11 @@ MetricFinder::getMatches(void) const
 {
     return matches_;
 }
+
+bool MetricFinder::isSearchable(void) const
+{
+    return isTargetSgGlobal() || isTargetSgProcedure() || isTargetSgLoop() || isTargetSgStatementNonScope();
+}
 #if 0
 const MetricFinder::MatchSet_t&
 MetricFinder::getFiles(void) const
@@ -725,12 +868,12 @@ void attachPostScopeStatement(SgScopeStatement* loop, const MetricAttr* attr_sag
 /* ---------------------------------------------------------------- */
 
 MetricAttachTraversal::MetricAttachTraversal(void) :
-        hpc_root_(0), verbose_(false)
+        hpc_root_(0), index_(0), verbose_(false)
 {
 }
 
 MetricAttachTraversal::MetricAttachTraversal(const IRTree_t* hpc_root) :
-        hpc_root_(hpc_root), verbose_(false)
+        hpc_root_(hpc_root), index_(hpc_root), verbose_(false)
 {
 }
 
@@ -762,7 +905,9 @@ void MetricAttachTraversal::visit(SgNode* n)
     SgLocatedNode* n_loc = isSgLocatedNode(n);
     if (n_loc)
     {
-        MetricFinder finder(n_loc, &attached_);
+        MetricFinder finder(n_loc, &attached_, &index_);
+        if (!finder.isSearchable())
+            return; // e.g., expressions never match any profile node
         finder.setVerbose(verbose_);
         // for current SgNode, find matching prof ir nodes
         finder.traverse(hpc_root_);
@@ -141,6 +141,9 @@ namespace sqlite3x {
                 void bind(int index, size_t data) { bind(index, (long long)data); }
 #endif
 
+                // Number of parameters in the SQL, which is the largest parameter index.
+                int bind_parameter_count();
+
                 sqlite3_reader executereader();
                 void executenonquery();
                 int executeint();
@@ -8,6 +8,7 @@
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
 #include <stdexcept>
@@ -134,6 +135,7 @@ class Transaction;
 class TransactionImpl;
 class Statement;
 class StatementImpl;
+class BulkInsert;
 
 /** Shared-ownership pointer to a database connection.  Database connections are always referenced through their smart pointers
  *  and are automatically deleted when all references disappear. See @ref Connection::create and @ref
@@ -150,6 +152,9 @@ typedef boost::shared_ptr<Transaction> TransactionPtr;
  *  heap_object_shared_ownership.  */
 typedef boost::shared_ptr<Statement> StatementPtr;
 
+/** Shared-ownership pointer to a bulk insertion.  See @ref Transaction::bulk_insert and @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<BulkInsert> BulkInsertPtr;
+
 // Data type used in templates to indicate lack of a column
 class NoColumn {};
 
@@ -194,6 +199,7 @@ class Connection: public boost::enable_shared_from_this<Connection> {
     friend class TransactionImpl;
     friend class Transaction;
     friend class StatementImpl;
+    friend class BulkInsert;
 public:
     /** Create a new database connection.  All connection objects are bound to a database throughout their lifetime, although
      * depending on the driver, the actual low-level connection may open and close. The @p open_spec string describes how to
@@ -230,6 +236,28 @@ public:
     FILE *get_debug() const;
     /** @} */
 
+    /** Asynchronous commit property.  If set, then transactions begun after this property is changed don't wait for their
+     *  changes to reach durable storage when they commit, which makes short transactions much faster.  A crash of the
+     *  computer (PostgreSQL: the server) can lose the most recently committed transactions, although the database remains
+     *  consistent.  For SQLite3 this sets the connection's "synchronous" pragma to "off", which also stops syncing between
+     *  transactions; for PostgreSQL it sets "synchronous_commit" to "off" for each transaction.  The property can also be set
+     *  with the "async" parameter of a connection URL.
+     * @{ */
+    void set_async_commit(bool b);
+    bool get_async_commit() const;
+    /** @} */
+
+    /** Size of the prepared statement cache.  When a statement that has '?' placeholders is executed, the driver-level
+     *  prepared statement is saved after the statement is destroyed or re-executed, and is reused by later statements with
+     *  identical SQL instead of parsing the SQL again.  The values are bound directly to the prepared statement rather than
+     *  by pasting them into the SQL.  This property limits the number of prepared statements saved for each low-level
+     *  connection; setting it to zero disables the cache.  The default is 100. The cache is currently used only by the
+     *  SQLite3 driver.
+     * @{ */
+    void set_statement_cache_size(size_t n);
+    size_t get_statement_cache_size() const;
+    /** @} */
+
     /** Print some basic info about this connection. */
     void print(std::ostream&) const;
 
@@ -265,6 +293,7 @@ class Transaction: public boost::enable_shared_from_this<Transaction> {
     friend class ConnectionImpl;
     friend class Statement;
     friend class StatementImpl;
+    friend class BulkInsert;
 public:
     /** Create a new transaction.  Transactions can be created either by this class method or by calling
      *  Connection::transaction().  The transaction will exist until there are no references (user or statements).
@@ -295,9 +324,17 @@ public:
 
     /** Bulk load data into table.  The specified input stream contains comma-separated values which are inserted in bulk
      *  into the specified table.  The number of fields in each row of the input stream must match the number of columns
-     *  in the table. Some drivers require that a bulk load is the only operation performed in a transaction. */
+     *  in the table. Some drivers require that a bulk load is the only operation performed in a transaction. SQLite3 has no
+     *  native bulk load, so its rows are inserted in batches with a @ref BulkInsert. */
     void bulk_load(const std::string &tablename, std::istream&);
 
+    /** Begin a batched insertion of rows.  Returns an object to which values are added one row at a time for the specified
+     *  table columns, or for all @p ncolumns columns of the table in the order they were declared. See @ref BulkInsert.
+     * @{ */
+    BulkInsertPtr bulk_insert(const std::string &tablename, const std::vector<std::string> &columns);
+    BulkInsertPtr bulk_insert(const std::string &tablename, size_t ncolumns);
+    /** @} */
+
     /** Returns the low-level driver name for this transaction. */
     Driver driver() const;
 
@@ -452,6 +489,95 @@ template<> uint32_t Statement::iterator::get<uint32_t>(size_t idx);
 template<> float Statement::iterator::get<float>(size_t idx);
 template<> double Statement::iterator::get<double>(size_t idx);
 template<> std::string Statement::iterator::get<std::string>(size_t idx);
+
+/*******************************************************************************************************************************
+ *                                      Bulk insertion
+ *******************************************************************************************************************************/
+
+/** Batched insertion of rows into a table.  A bulk insertion is created by @ref Transaction::bulk_insert for a table and a list
+ *  of its columns, and values are then added in column order, one row after another.  Rows are held in memory until the
+ *  batch size is reached or @ref flush is called, and then all the buffered rows are sent to the database at once: with
+ *  "COPY" for PostgreSQL and with multi-row "INSERT ... VALUES" statements for SQLite3.  This is much faster than executing
+ *  an insert statement for each row.
+ *
+ *  No other statements should be executed in the transaction while rows are being flushed, but statements can be executed
+ *  between flushes.  Rows that are still buffered when the object is destroyed are flushed by the destructor, but since a
+ *  destructor can't throw, a failed flush is only reported on standard error; call @ref flush explicitly before committing
+ *  the transaction.  Destroying a bulk insertion that still has buffered rows after its transaction has been committed or
+ *  rolled back is a logic error and fails an assertion, since those rows can no longer be saved.
+ *
+ * @code
+ *  SqlDatabase::BulkInsertPtr ins = tx->bulk_insert("semantic_outputvalues", columns);
+ *  for (...)
+ *      ins->add(hashkey).add(vtype).add(pos).add(val);
+ *  ins->flush();
+ * @endcode */
+class BulkInsert {
+public:
+    /** Create a new bulk insertion.  Bulk insertions can be created either by this class method or by calling
+     *  Transaction::bulk_insert().  If a number of columns is given instead of a list of column names then each row has a
+     *  value for every column of the table in the order the columns were declared.
+     * @{ */
+    static BulkInsertPtr create(const TransactionPtr &tranx, const std::string &tablename,
+                                const std::vector<std::string> &columns) {
+        return BulkInsertPtr(new BulkInsert(tranx, tablename, columns, columns.size()));
+    }
+    static BulkInsertPtr create(const TransactionPtr &tranx, const std::string &tablename, size_t ncolumns) {
+        return BulkInsertPtr(new BulkInsert(tranx, tablename, std::vector<std::string>(), ncolumns));
+    }
+    /** @} */
+
+    /** Add the next value.  Values are added in column order and a row is complete when it has a value for each column.
+     *  Returns this object so that calls can be chained.  Adding a value to a complete row when the batch is full causes the
+     *  batch to be flushed.
+     * @{ */
+    BulkInsert& add(int32_t val);
+    BulkInsert& add(int64_t val);
+    BulkInsert& add(uint32_t val);
+    BulkInsert& add(uint64_t val);
+    BulkInsert& add(double val);
+    BulkInsert& add(const std::string &val);
+    /** @} */
+
+    /** Send all buffered rows to the database.  Throws an exception if the last row is incomplete. */
+    void flush();
+
+    /** Number of rows buffered before they are sent to the database.  The default is 1000.
+     * @{ */
+    void set_batch_size(size_t n) { batch_size = std::max(n, (size_t)1); }
+    size_t get_batch_size() const { return batch_size; }
+    /** @} */
+
+    /** Number of complete rows that have been added, including rows that are still buffered. */
+    size_t nrows() const { return nflushed + values.size() / ncolumns; }
+
+    /** Number of values in each row. */
+    size_t get_ncolumns() const { return ncolumns; }
+
+    /** Returns the transaction for this bulk insertion. */
+    TransactionPtr transaction() const { return tranx; }
+
+    // Called only by boost::shared_ptr
+    ~BulkInsert();
+
+protected:
+    BulkInsert(const TransactionPtr &tranx, const std::string &tablename, const std::vector<std::string> &columns,
+               size_t ncolumns);
+
+private:
+    BulkInsert& add_value(const std::string &literal, const std::string &raw);
+    void flush_sqlite3();
+    void flush_postgres();
+
+private:
+    TransactionPtr tranx;
+    std::string tablename;
+    std::vector<std::string> columns;                   // empty when inserting into all columns in declared order
+    size_t ncolumns;                                    // number of values per row
+    std::vector<std::string> values;                    // buffered values, row-major; SQL literals for SQLite3, else raw
+    size_t batch_size;                                  // rows to buffer before flushing
+    size_t nflushed;                                    // number of rows already sent to the database
+};
     
 /*******************************************************************************************************************************
  *                                      Miscellaneous functions
@@ -147,6 +147,64 @@ std::vector<Path> findNamesRecursively(const Path &root, Select select) {
 ROSE_UTIL_API std::vector<Path> findNamesRecursively(const Path &root);
 /** @} */
 
+/** Receives entries found by @ref scanRecursively.
+ *
+ *  The methods are called concurrently from multiple threads and must be thread-safe. */
+class ROSE_UTIL_API ScanVisitor {
+public:
+    virtual ~ScanVisitor() {}
+
+    /** Called once for each entry below the root.  The @p isDirectory argument is true if the entry is a directory; symbolic
+     *  links are never reported as directories.  Returns true if the scan should descend into the entry, which is only
+     *  possible for directories. */
+    virtual bool visit(const Path &path, bool isDirectory) = 0;
+};
+
+/** Scan a directory tree in parallel.
+ *
+ *  Reports every entry in @p root and all its subdirectories recursively to the @p visitor, without collecting them.  The
+ *  @p root itself is not reported.  Directories are read by @p nThreads threads (the number of hardware threads if zero),
+ *  each of which owns a queue of directories still to be read and takes work from the other threads' queues when its own
+ *  is empty.  On Linux the directory entries are read in large batches directly from the kernel and their types are taken
+ *  from the directory itself, so files are usually not examined individually.  Entries are reported in no particular order.
+ *  Symbolic links to directories are never followed, and subdirectories that cannot be read are skipped.
+ *
+ *  Throws a <code>boost::filesystem::filesystem_error</code> if @p root cannot be read as a directory. */
+ROSE_UTIL_API void scanRecursively(const Path &root, ScanVisitor &visitor, size_t nThreads = 0);
+
+/** Scan a directory tree in parallel with filters.
+ *
+ *  Calls @p action for each entry below @p root for which @p select returns true, and descends into each subdirectory for
+ *  which @p descend returns true. The predicates and the action are called with the entry's path, from multiple threads
+ *  concurrently.  See the other @ref scanRecursively for details.
+ *
+ *  For example, to count the C source files under a tree:
+ *
+ * @code
+ *  struct CountFiles {
+ *      boost::mutex *mutex;
+ *      size_t *n;
+ *      void operator()(const Path&) { boost::lock_guard<boost::mutex> lock(*mutex); ++*n; }
+ *  };
+ *  ...
+ *  scanRecursively(top, baseNameMatches(boost::regex(".*\\.c")), CountFiles(&mutex, &n), isNotSymbolicLink);
+ * @endcode */
+template<class Select, class Action, class Descend>
+void scanRecursively(const Path &root, Select select, Action action, Descend descend, size_t nThreads = 0) {
+    struct Visitor: ScanVisitor {
+        Select &select;
+        Action &action;
+        Descend &descend;
+        Visitor(Select &select, Action &action, Descend &descend): select(select), action(action), descend(descend) {}
+        bool visit(const Path &path, bool isDirectory) {
+            if (select(path))
+                action(path);
+            return isDirectory && descend(path);
+        }
+    } visitor(select, action, descend);
+    scanRecursively(root, visitor, nThreads);
+}
+
 /** Copy a file.
  *
  *  Copies the contents of the source file to the destination file, overwriting the destination file if it existed. */
@@ -0,0 +1,247 @@
+// Dominator trees and dominance frontiers for large graphs. See GraphUtility::immediateDominators().
+#ifndef ROSE_GraphDominance_H
+#define ROSE_GraphDominance_H
+
+#include <Sawyer/Assert.h>
+#include <utility>
+#include <vector>
+
+namespace rose {
+namespace GraphUtility {
+
+/** Compact adjacency lists for a directed graph.
+ *
+ *  The vertices are numbered densely from zero and the adjacent vertices of vertex @c v are stored in @ref targets at
+ *  indices <code>offsets[v]</code> (inclusive) through <code>offsets[v+1]</code> (exclusive).  This is the representation
+ *  used by the dominance algorithms in this namespace; the graph types used by ROSE's analyses are converted to it
+ *  once, after which the algorithms touch only arrays. */
+struct Adjacency {
+    std::vector<size_t> offsets;                        // nVertices+1 indices into targets
+    std::vector<size_t> targets;                        // adjacent vertex numbers
+
+    /** Construct adjacency lists for a graph with no vertices. */
+    Adjacency(): offsets(1, 0) {}
+
+    /** Construct adjacency lists from a list of edges.
+     *
+     *  Each pair is an edge from its first vertex to its second vertex, and both must be less than @p nVertices. If @p
+     *  reverse is true then the edges are reversed, which produces the predecessor lists for a list of forward edges. */
+    Adjacency(size_t nVertices, const std::vector<std::pair<size_t, size_t> > &edges, bool reverse = false)
+        : offsets(nVertices+1, 0), targets(edges.size()) {
+        for (size_t i=0; i<edges.size(); ++i) {
+            size_t from = reverse ? edges[i].second : edges[i].first;
+            ASSERT_require(from < nVertices);
+            ++offsets[from+1];
+        }
+        for (size_t v=0; v<nVertices; ++v)
+            offsets[v+1] += offsets[v];
+        std::vector<size_t> next(offsets.begin(), offsets.end()-1);
+        for (size_t i=0; i<edges.size(); ++i) {
+            size_t from = reverse ? edges[i].second : edges[i].first;
+            size_t to = reverse ? edges[i].first : edges[i].second;
+            ASSERT_require(to < nVertices);
+            targets[next[from]++] = to;
+        }
+    }
+
+    /** Number of vertices. */
+    size_t nVertices() const { return offsets.size() - 1; }
+
+    /** Number of edges. */
+    size_t nEdges() const { return targets.size(); }
+
+    /** Adjacency lists with all edges reversed. */
+    Adjacency reversed() const {
+        std::vector<std::pair<size_t, size_t> > edges;
+        edges.reserve(nEdges());
+        for (size_t v=0; v<nVertices(); ++v) {
+            for (size_t i=offsets[v]; i<offsets[v+1]; ++i)
+                edges.push_back(std::make_pair(v, targets[i]));
+        }
+        return Adjacency(nVertices(), edges, true);
+    }
+};
+
+/** Vertex number indicating no vertex. */
+static const size_t NO_VERTEX = (size_t)(-1);
+
+/** Immediate dominators.
+ *
+ *  Given the successor lists of a graph and a root vertex, returns a vector indexed by vertex number whose elements are
+ *  the immediate dominators of the vertices.  The root and the vertices not reachable from the root have no immediate
+ *  dominator, which is indicated by @ref NO_VERTEX.  Post dominators are computed by passing the predecessor lists (see
+ *  @ref Adjacency::reversed) and the exit vertex.
+ *
+ *  This is the semi-NCA algorithm from "Finding Dominators in Practice" by Georgiadis, Tarjan, and Werneck, which computes
+ *  semidominators like Lengauer-Tarjan and then finds each immediate dominator as the nearest common ancestor in the
+ *  partially built tree. All storage is in arrays indexed by depth-first preorder number, and the depth-first search and
+ *  path compression are iterative, so the run time is near linear and very deep graphs don't overflow the stack. */
+inline std::vector<size_t>
+immediateDominators(const Adjacency &successors, size_t root) {
+    const size_t n = successors.nVertices();
+    std::vector<size_t> retval(n, NO_VERTEX);
+    if (root >= n)
+        return retval;
+
+    // Depth-first preorder numbering of the vertices reachable from the root.
+    std::vector<size_t> preorder(n, NO_VERTEX);         // vertex number to preorder number
+    std::vector<size_t> vertex;                         // preorder number to vertex number
+    std::vector<size_t> parent;                         // preorder numbers of depth-first tree parents
+    vertex.reserve(n);
+    parent.reserve(n);
+    {
+        std::vector<std::pair<size_t, size_t> > stack;  // vertex number and index of its next successor
+        preorder[root] = 0;
+        vertex.push_back(root);
+        parent.push_back(NO_VERTEX);
+        stack.push_back(std::make_pair(root, successors.offsets[root]));
+        while (!stack.empty()) {
+            size_t v = stack.back().first;
+            size_t &next = stack.back().second;
+            if (next == successors.offsets[v+1]) {
+                stack.pop_back();
+            } else {
+                size_t w = successors.targets[next++];
+                if (NO_VERTEX == preorder[w]) {
+                    preorder[w] = vertex.size();
+                    vertex.push_back(w);
+                    parent.push_back(preorder[v]);
+                    stack.push_back(std::make_pair(w, successors.offsets[w]));
+                }
+            }
+        }
+    }
+    const size_t nReached = vertex.size();
+
+    // Predecessor lists in terms of preorder numbers, restricted to reachable vertices.
+    std::vector<std::pair<size_t, size_t> > edges;
+    edges.reserve(successors.nEdges());
+    for (size_t i=0; i<nReached; ++i) {
+        size_t v = vertex[i];
+        for (size_t j=successors.offsets[v]; j<successors.offsets[v+1]; ++j)
+            edges.push_back(std::make_pair(i, preorder[successors.targets[j]]));
+    }
+    Adjacency predecessors(nReached, edges, true);
+    edges.clear();
+
+    // Semidominators, processing vertices in reverse preorder. "ancestor" is the link-eval forest and "label" is the vertex
+    // with minimum semidominator on the compressed path.
+    std::vector<size_t> semi(nReached), label(nReached), ancestor(nReached, NO_VERTEX), idom(parent);
+    for (size_t i=0; i<nReached; ++i)
+        semi[i] = label[i] = i;
+    std::vector<size_t> path;
+    for (size_t w=nReached-1; w>0; --w) {
+        for (size_t j=predecessors.offsets[w]; j<predecessors.offsets[w+1]; ++j) {
+            size_t v = predecessors.targets[j];
+            size_t u = v;
+            if (ancestor[v] != NO_VERTEX) {
+                // Compress the path from v to the root of its tree in the forest
+                for (size_t x=v; ancestor[ancestor[x]] != NO_VERTEX; x=ancestor[x])
+                    path.push_back(x);
+                while (!path.empty()) {
+                    size_t x = path.back();
+                    path.pop_back();
+                    size_t a = ancestor[x];
+                    if (semi[label[a]] < semi[label[x]])
+                        label[x] = label[a];
+                    ancestor[x] = ancestor[a];
+                }
+                u = label[v];
+            }
+            if (semi[u] < semi[w])
+                semi[w] = semi[u];
+        }
+        ancestor[w] = parent[w];
+    }
+
+    // Immediate dominators are the nearest common ancestors of the parent and semidominator in the dominator tree.
+    for (size_t w=1; w<nReached; ++w) {
+        while (idom[w] > semi[w])
+            idom[w] = idom[idom[w]];
+    }
+
+    for (size_t w=1; w<nReached; ++w)
+        retval[vertex[w]] = vertex[idom[w]];
+    return retval;
+}
+
+/** Dominance frontiers.
+ *
+ *  Given the successor lists of a graph, the root vertex, and the immediate dominators computed by @ref
+ *  immediateDominators, returns the dominance frontier of each vertex.  The frontier of vertex @c x is the set of vertices
+ *  @c y such that @c x dominates a predecessor of @c y but does not strictly dominate @c y.  Each frontier is sorted by
+ *  vertex number, and vertices not reachable from the root neither have nor appear in frontiers.  Post dominance frontiers
+ *  are computed by passing the predecessor lists, the exit vertex, and the immediate post dominators.
+ *
+ *  The algorithm is by Cooper, Harvey, and Kennedy: for each join point, walk up the dominator tree from each predecessor
+ *  until reaching the join point's immediate dominator.  A walk stops early when it reaches a vertex whose frontier already
+ *  has the join point, since the rest of that path was walked already. */
+inline std::vector<std::vector<size_t> >
+dominanceFrontiers(const Adjacency &successors, size_t root, const std::vector<size_t> &idoms) {
+    const size_t n = successors.nVertices();
+    ASSERT_require(idoms.size() == n);
+    std::vector<std::vector<size_t> > retval(n);
+    if (root >= n)
+        return retval;
+    Adjacency predecessors = successors.reversed();
+    for (size_t y=0; y<n; ++y) {
+        if (y != root) {
+            if (NO_VERTEX == idoms[y])
+                continue;                               // not reachable
+            if (predecessors.offsets[y+1] - predecessors.offsets[y] < 2)
+                continue;                               // not a join point, so its only predecessor is its dominator
+        }
+        for (size_t i=predecessors.offsets[y]; i<predecessors.offsets[y+1]; ++i) {
+            size_t runner = predecessors.targets[i];
+            if (runner != root && NO_VERTEX == idoms[runner])
+                continue;                               // not reachable
+            while (runner != NO_VERTEX && runner != idoms[y]) {
+                if (!retval[runner].empty() && retval[runner].back() == y)
+                    break;
+                retval[runner].push_back(y);
+                runner = idoms[runner];
+            }
+        }
+    }
+    return retval;
+}
+
+/** Successor lists for a Sawyer graph.
+ *
+ *  Vertex numbers are the graph's vertex ID numbers. */
+template<class Graph>
+Adjacency
+successorAdjacency(const Graph &graph) {
+    std::vector<std::pair<size_t, size_t> > edges;
+    edges.reserve(graph.nEdges());
+    for (typename Graph::ConstEdgeIterator edge=graph.edges().begin(); edge!=graph.edges().end(); ++edge)
+        edges.push_back(std::make_pair(edge->source()->id(), edge->target()->id()));
+    return Adjacency(graph.nVertices(), edges);
+}
+
+/** Immediate dominators for a Sawyer graph.
+ *
+ *  Returns a vector indexed by vertex ID whose elements are the IDs of the immediate dominators. See @ref
+ *  immediateDominators(const Adjacency&, size_t). */
+template<class Graph>
+std::vector<size_t>
+graphImmediateDominators(const Graph &graph, typename Graph::ConstVertexIterator root) {
+    ASSERT_require(graph.isValidVertex(root));
+    return immediateDominators(successorAdjacency(graph), root->id());
+}
+
+/** Immediate post dominators for a Sawyer graph.
+ *
+ *  Returns a vector indexed by vertex ID whose elements are the IDs of the immediate post dominators with respect to the
+ *  specified exit vertex. */
+template<class Graph>
+std::vector<size_t>
+graphImmediatePostDominators(const Graph &graph, typename Graph::ConstVertexIterator exit) {
+    ASSERT_require(graph.isValidVertex(exit));
+    return immediateDominators(successorAdjacency(graph).reversed(), exit->id());
+}
+
+} // namespace
+} // namespace
+
+#endif
@@ -3,25 +3,38 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <vector>
 #include "rosedll.h"
 
-/** Linear congruential generator.  Generates a repeatable sequence of pseudo-random numbers. */
+/** Linear congruential generator.  Generates a repeatable sequence of pseudo-random numbers.
+ *
+ *  Independent, reproducible streams for parallel work are obtained by giving each thread its own substream of a common seed
+ *  (see the two-argument constructor): substream @e i is the part of the seed's sequence that starts @ref substreamLength
+ *  values times @e i into it. Substreams do not overlap as long as each is used for at most that many values and there are
+ *  fewer than 2^22 of them. */
 class ROSE_UTIL_API LinearCongruentialGenerator {
 public:
+    /** Number of values in each substream. */
+    static const uint64_t substreamLength = (uint64_t)1 << 40;
+
     /** Initialize the generator with a random seed. */
     LinearCongruentialGenerator() { init(); }
 
     /** Initialize the generator with a seed. The seed determines which sequence of numbers is returned. */
-    LinearCongruentialGenerator(int seed): seed_(seed), value_(seed) {}
+    LinearCongruentialGenerator(int seed): seed_(seed), value_(seed), start_(value_) {}
+
+    /** Initialize the generator with a substream of a seed.  The values are those of the sequence for @p seed after skipping
+     *  the first @p substream times @ref substreamLength values. Creating a substream takes logarithmic time. */
+    LinearCongruentialGenerator(int seed, uint64_t substream);
 
     /** Random initialization. This uses /dev/urandom or /dev/random to initailize the sequence. */
     void init();
 
     /** Reset the sequence back to the first value. */
-    void reset() { value_=seed_; }
+    void reset() { value_=start_; }
 
     /** Start a new sequence of random values. The seed identifies which sequence is returned. */
-    void reseed(int seed) { value_ = seed_ = seed; }
+    void reseed(int seed) { seed_ = seed; start_ = value_ = seed; }
 
     /** Return the seed for the current sequence. */
     int seed() const { return seed_; }
@@ -41,12 +54,31 @@ public:
     uint64_t operator()() { return next(); }
     /** @} */
 
+    /** Skip values.  Advances the sequence by @p n values, as if @ref next had been called @p n times, in logarithmic time. */
+    void discard(uint64_t n);
+
+    /** Return many values at once.  Stores the next @p n values of the sequence into @p values, the same values that @p n calls
+     *  of @ref next with the same @p nbits would return.  The values are computed several at a time from independent states so
+     *  the compiler can overlap or vectorize the arithmetic.
+     * @{ */
+    void fill(uint64_t *values, size_t n, size_t nbits=64);
+    void fill(std::vector<uint64_t> &values, size_t nbits=64) {
+        if (!values.empty())
+            fill(&values[0], values.size(), nbits);
+    }
+    /** @} */
+
     /** Return a random boolean value. */
     bool flip_coin();
 
 protected:
     int seed_;
     uint64_t value_;
+    uint64_t start_;                                    // state at the first value of the sequence or substream
+
+private:
+    // Multiplier and addend that advance the state by n steps at once.
+    static void jump(uint64_t nSteps, uint64_t &multiplier, uint64_t &addend);
 };
 
 typedef LinearCongruentialGenerator LCG;
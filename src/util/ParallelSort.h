@@ -1,8 +1,11 @@
-// Parallel sorting using multiple threads. See ParallelSort::quicksort() near the end of this file.
+// Parallel sorting using multiple threads. See ParallelSort::quicksort(), mergesort(), and radixSort() near the end of this file.
 #ifndef ROSE_ParallelSort_H
 #define ROSE_ParallelSort_H
 
+#include <algorithm>
+#include <boost/cstdint.hpp>
 #include <boost/thread.hpp>
+#include <iterator>
 #include <list>
 #include <vector>
 
@@ -16,7 +19,13 @@ namespace rose {
  *
  *  <ul>
  *   <li>quicksort()</li>
+ *   <li>mergesort(), which is stable</li>
+ *   <li>radixSort(), which is stable and sorts by unsigned integer keys such as addresses or hashes</li>
  *  </ul>
+ *
+ *  The quicksort distributes work through a shared work list.  The merge sort and radix sort instead give each thread a fixed,
+ *  equally sized part of the input in every phase, so the threads never contend for work and only synchronize between
+ *  phases.
  */
 namespace ParallelSort {
 
@@ -115,6 +124,148 @@ struct Worker {
     }
 };
 
+// Runs task.run(i) for each i in [0,nthreads), each in its own thread; index zero runs in the calling thread.  Returns after all
+// of them have finished.
+template<class Task>
+struct TaskRunner {
+    Task *task;
+    size_t id;
+    TaskRunner(Task *task, size_t id): task(task), id(id) {}
+    void operator()() { task->run(id); }
+};
+
+template<class Task>
+void runInParallel(Task &task, size_t nthreads) {
+    size_t nworkers = std::max(nthreads, (size_t)1) - 1;
+    boost::thread *workers = new boost::thread[nworkers];
+    for (size_t i=0; i<nworkers; ++i)
+        workers[i] = boost::thread(TaskRunner<Task>(&task, i+1));
+    task.run(0);
+    for (size_t i=0; i<nworkers; ++i)
+        workers[i].join();
+    delete[] workers;
+}
+
+// Beginning of the i'th of n nearly equal parts of a range of the specified size.
+inline size_t partBegin(size_t size, size_t i, size_t n) {
+    return (size_t)((boost::uint64_t)size * i / n);
+}
+
+// Merge sort: each thread stable-sorts one part, then pairs of adjacent sorted runs are merged in rounds, alternating between
+// the input and a buffer as the source, until one run remains.
+template<class RandomAccessIterator, class Compare>
+struct MergeSortJob {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type Value;
+    RandomAccessIterator begin;
+    Compare compare;
+    std::vector<Value> buffer;                          // same size as the input
+    std::vector<size_t> bounds;                         // run i is [bounds[i], bounds[i+1]), relative to begin
+    bool sorting;                                       // true for the first phase, false while merging
+    bool inBuffer;                                      // whether the runs are in the buffer rather than the input
+
+    MergeSortJob(RandomAccessIterator begin, RandomAccessIterator end, Compare compare)
+        : begin(begin), compare(compare), buffer(begin, end), sorting(true), inBuffer(false) {}
+
+    void run(size_t i) {
+        if (sorting) {
+            std::stable_sort(begin+bounds[i], begin+bounds[i+1], compare);
+        } else {
+            // merge runs 2i and 2i+1, or just copy run 2i if it has no partner
+            size_t lo = bounds[2*i], mid = bounds[std::min(2*i+1, bounds.size()-1)], hi = bounds[std::min(2*i+2, bounds.size()-1)];
+            if (inBuffer) {
+                std::merge(buffer.begin()+lo, buffer.begin()+mid, buffer.begin()+mid, buffer.begin()+hi, begin+lo, compare);
+            } else {
+                std::merge(begin+lo, begin+mid, begin+mid, begin+hi, buffer.begin()+lo, compare);
+            }
+        }
+    }
+};
+
+// LSD radix sort: one pass per 8-bit digit of the keys. In each pass every thread counts the digits of its part of the input,
+// the counts are turned into output positions, and every thread moves its part to those positions in order, which keeps the
+// sort stable.  The data alternates between the input and a buffer.
+template<class RandomAccessIterator, class Key>
+struct RadixSortJob {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type Value;
+    static const size_t radix = 256;
+    RandomAccessIterator begin;
+    Key key;
+    std::vector<Value> buffer;                          // same size as the input
+    size_t nthreads;
+    std::vector<size_t> counts;                         // radix counters per thread, then output positions per thread
+    std::vector<boost::uint64_t> keyBits;               // bitwise OR of all keys, per thread
+    enum Phase { ALL_KEY_BITS, COUNT, MOVE } phase;
+    unsigned shift;                                     // position of current digit in the keys
+    bool inBuffer;                                      // whether the data is in the buffer rather than the input
+
+    RadixSortJob(RandomAccessIterator begin, RandomAccessIterator end, Key key, size_t nthreads)
+        : begin(begin), key(key), buffer(begin, end), nthreads(nthreads), counts(nthreads * radix),
+          keyBits(nthreads, 0), phase(ALL_KEY_BITS), shift(0), inBuffer(false) {}
+
+    size_t digit(const Value &value) const {
+        return (size_t)(((boost::uint64_t)key(value) >> shift) & (radix-1));
+    }
+
+    template<class Source, class Target>
+    void run(size_t i, Source source, Target target) {
+        size_t lo = partBegin(buffer.size(), i, nthreads), hi = partBegin(buffer.size(), i+1, nthreads);
+        size_t *position = &counts[i * radix];
+        switch (phase) {
+            case ALL_KEY_BITS:
+                for (size_t j=lo; j<hi; ++j)
+                    keyBits[i] |= (boost::uint64_t)key(source[j]);
+                break;
+            case COUNT:
+                std::fill(position, position+radix, (size_t)0);
+                for (size_t j=lo; j<hi; ++j)
+                    ++position[digit(source[j])];
+                break;
+            case MOVE:
+                for (size_t j=lo; j<hi; ++j)
+                    target[position[digit(source[j])]++] = source[j];
+                break;
+        }
+    }
+
+    void run(size_t i) {
+        if (inBuffer) {
+            run(i, buffer.begin(), begin);
+        } else {
+            run(i, begin, buffer.begin());
+        }
+    }
+
+    // Converts the per-thread counts into the output position of each thread's first value of each digit.
+    void countsToPositions() {
+        size_t position = 0;
+        for (size_t d=0; d<radix; ++d) {
+            for (size_t i=0; i<nthreads; ++i) {
+                size_t n = counts[i * radix + d];
+                counts[i * radix + d] = position;
+                position += n;
+            }
+        }
+    }
+
+    // True if all values have the same current digit, in which case the pass would not change anything.
+    bool isDigitConstant() const {
+        for (size_t d=0; d<radix; ++d) {
+            size_t n = 0;
+            for (size_t i=0; i<nthreads; ++i)
+                n += counts[i * radix + d];
+            if (n != 0)
+                return n == buffer.size();
+        }
+        return true;
+    }
+};
+
+// Key for radixSort() when the values are the keys.
+template<class Value>
+struct IdentityKey {
+    boost::uint64_t operator()(const Value &value) const { return (boost::uint64_t)value; }
+};
+
 } // namespace
 
 
@@ -156,8 +307,87 @@ void quicksort(RandomAccessIterator begin, RandomAccessIterator end, Compare com
     // Wait for all the threads to finish
     for (size_t i=0; i<nworkers; ++i)
         workers[i].join();
+    delete[] workers;
 }
-    
+
+/** Stable sort of values in parallel.  Sorts the values between @p begin (inclusive) and @p end (exclusive) according to the
+ *  comparator @p compare using @p nthreads threads, keeping equal values in their original order like std::stable_sort.  The
+ *  range is split into one part per thread, the parts are sorted concurrently, and then adjacent sorted parts are merged in
+ *  pairs, also concurrently, until one remains.  This needs a temporary copy of the values.  Multi-threading is only used
+ *  if the size of the range of values exceeds a certain threshold.  See quicksort() for advice about iterators. */
+template<class RandomAccessIterator, class Compare>
+void mergesort(RandomAccessIterator begin, RandomAccessIterator end, Compare compare, size_t nthreads) {
+    using namespace Private;
+    size_t size = end - begin;
+    if (nthreads <= 1 || size < (size_t)Job<RandomAccessIterator, Compare>::multiThreshold) {
+        std::stable_sort(begin, end, compare);
+        return;
+    }
+
+    MergeSortJob<RandomAccessIterator, Compare> job(begin, end, compare);
+    for (size_t i=0; i<=nthreads; ++i)
+        job.bounds.push_back(partBegin(size, i, nthreads));
+    runInParallel(job, nthreads);
+
+    job.sorting = false;
+    while (job.bounds.size() > 2) {
+        size_t nruns = job.bounds.size() - 1;
+        runInParallel(job, (nruns + 1) / 2);
+        std::vector<size_t> merged;
+        for (size_t i=0; i<job.bounds.size(); i+=2)
+            merged.push_back(job.bounds[i]);
+        if (merged.back() != size)
+            merged.push_back(size);
+        job.bounds.swap(merged);
+        job.inBuffer = !job.inBuffer;
+    }
+    if (job.inBuffer)
+        std::copy(job.buffer.begin(), job.buffer.end(), begin);
+}
+
+/** Stable radix sort of values in parallel.  Sorts the values between @p begin (inclusive) and @p end (exclusive) in
+ *  ascending order of their keys using @p nthreads threads.  The @p key functor returns for a value an unsigned integer key of
+ *  at most 64 bits, such as an address or a hash; values with equal keys keep their original order.  The sort makes one pass
+ *  over the values for each 8-bit digit up to the most significant bit set in any key, and skips passes in which all keys
+ *  have the same digit, so it takes linear time.  This needs a temporary copy of the values.  Multi-threading is only used if
+ *  the size of the range of values exceeds a certain threshold.  See quicksort() for advice about iterators. */
+template<class RandomAccessIterator, class Key>
+void radixSort(RandomAccessIterator begin, RandomAccessIterator end, Key key, size_t nthreads) {
+    using namespace Private;
+    size_t size = end - begin;
+    if (size < 2)
+        return;
+    if (size < (size_t)Job<RandomAccessIterator, Key>::multiThreshold)
+        nthreads = 1;
+    nthreads = std::max(nthreads, (size_t)1);
+
+    typedef RadixSortJob<RandomAccessIterator, Key> RadixJob;
+    RadixJob job(begin, end, key, nthreads);
+    runInParallel(job, nthreads);
+    boost::uint64_t keyBits = 0;
+    for (size_t i=0; i<nthreads; ++i)
+        keyBits |= job.keyBits[i];
+
+    for (job.shift=0; job.shift<64 && (keyBits >> job.shift) != 0; job.shift+=8) {
+        job.phase = RadixJob::COUNT;
+        runInParallel(job, nthreads);
+        if (job.isDigitConstant())
+            continue;
+        job.countsToPositions();
+        job.phase = RadixJob::MOVE;
+        runInParallel(job, nthreads);
+        job.inBuffer = !job.inBuffer;
+    }
+    if (job.inBuffer)
+        std::copy(job.buffer.begin(), job.buffer.end(), begin);
+}
+
+/** Stable radix sort of unsigned integers in parallel.  Like the other radixSort() but the values themselves are the keys. */
+template<class RandomAccessIterator>
+void radixSort(RandomAccessIterator begin, RandomAccessIterator end, size_t nthreads) {
+    radixSort(begin, end, Private::IdentityKey<typename std::iterator_traits<RandomAccessIterator>::value_type>(), nthreads);
+}
+
 } // namespace
 } // namespace
 
@@ -0,0 +1,342 @@
+// WARNING: Changes to this file must be contributed back to Sawyer or else they will
+//          be clobbered by the next update from Sawyer.  The Sawyer repository is at
+//          https://github.com/matzke1/sawyer.
+
+
+
+
+#ifndef Sawyer_FrozenGraph_H
+#define Sawyer_FrozenGraph_H
+
+#include <Sawyer/Sawyer.h>
+#include <Sawyer/Assert.h>
+#include <Sawyer/GraphTraversal.h>
+
+#include <boost/foreach.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <vector>
+
+namespace Sawyer {
+namespace Container {
+
+/** Read-only snapshot of a graph's connectivity.
+ *
+ *  A frozen graph is built from a @ref Graph in O(|V|+|E|) time and stores the connectivity of that graph in compressed sparse
+ *  row form: the IDs of the outgoing (and incoming) edges of all vertices are in one contiguous array, sorted by vertex, so
+ *  that iterating over the edges of a vertex reads consecutive memory instead of following the links of the graph's edge
+ *  lists.  Vertex and edge IDs are the same as in the original graph (they are dense in a @ref Graph), and the vertex and
+ *  edge values are references to the values stored in the original graph; they are not copied.
+ *
+ *  The frozen graph is a snapshot: it does not follow modifications of the original graph and its value references become
+ *  invalid when the corresponding vertices or edges are erased or when the original graph is destroyed.  It is intended for
+ *  analyses that traverse a graph many times without changing it, such as data-flow, dominators and path searches.
+ *
+ *  @code
+ *   typedef Sawyer::Container::Graph<std::string, int> MyGraph;
+ *   MyGraph g = ...;
+ *   Sawyer::Container::FrozenGraph<MyGraph> fg(g);
+ *   for (size_t v=0; v<fg.nVertices(); ++v) {
+ *       BOOST_FOREACH (size_t e, fg.outEdges(v))
+ *           std::cout <<fg.vertexValue(v) <<" -> " <<fg.vertexValue(fg.edgeTarget(e)) <<"\n";
+ *   }
+ *  @endcode */
+template<class G>
+class FrozenGraph {
+public:
+    typedef G Graph;                                    /**< Type of the original graph. */
+    typedef typename G::VertexValue VertexValue;        /**< User-level data associated with vertices. */
+    typedef typename G::EdgeValue EdgeValue;            /**< User-level data associated with edges. */
+    typedef const size_t* EdgeIdIterator;               /**< Iterates over edge IDs. */
+    typedef boost::iterator_range<EdgeIdIterator> EdgeIdRange; /**< Edge IDs of one vertex. */
+
+private:
+    std::vector<const VertexValue*> vertexValues_;      // indexed by vertex ID
+    std::vector<const EdgeValue*> edgeValues_;          // indexed by edge ID
+    std::vector<size_t> sources_, targets_;             // indexed by edge ID
+    std::vector<size_t> outOffsets_, inOffsets_;        // nVertices+1 offsets into outEdges_ and inEdges_
+    std::vector<size_t> outEdges_, inEdges_;            // edge IDs grouped by source and target vertex
+
+public:
+    /** Construct an empty frozen graph. */
+    FrozenGraph(): outOffsets_(1, 0), inOffsets_(1, 0) {}
+
+    /** Freeze a graph.
+     *
+     *  The edges of each vertex are in the same order as in the original graph. */
+    explicit FrozenGraph(const Graph &g) {
+        freeze(g);
+    }
+
+    /** Replace this snapshot by one of @p g. */
+    void freeze(const Graph &g) {
+        const size_t nv = g.nVertices(), ne = g.nEdges();
+        vertexValues_.resize(nv);
+        edgeValues_.resize(ne);
+        sources_.resize(ne);
+        targets_.resize(ne);
+        outOffsets_.assign(nv+1, 0);
+        inOffsets_.assign(nv+1, 0);
+        outEdges_.resize(ne);
+        inEdges_.resize(ne);
+
+        BOOST_FOREACH (const typename Graph::Vertex &vertex, g.vertices()) {
+            vertexValues_[vertex.id()] = &vertex.value();
+            outOffsets_[vertex.id()+1] = vertex.nOutEdges();
+            inOffsets_[vertex.id()+1] = vertex.nInEdges();
+        }
+        for (size_t i=0; i<nv; ++i) {
+            outOffsets_[i+1] += outOffsets_[i];
+            inOffsets_[i+1] += inOffsets_[i];
+        }
+
+        BOOST_FOREACH (const typename Graph::Edge &edge, g.edges()) {
+            edgeValues_[edge.id()] = &edge.value();
+            sources_[edge.id()] = edge.source()->id();
+            targets_[edge.id()] = edge.target()->id();
+        }
+
+        // Per-vertex edge lists, in the order of the original graph's lists.
+        BOOST_FOREACH (const typename Graph::Vertex &vertex, g.vertices()) {
+            size_t out = outOffsets_[vertex.id()], in = inOffsets_[vertex.id()];
+            BOOST_FOREACH (const typename Graph::Edge &edge, vertex.outEdges())
+                outEdges_[out++] = edge.id();
+            BOOST_FOREACH (const typename Graph::Edge &edge, vertex.inEdges())
+                inEdges_[in++] = edge.id();
+        }
+    }
+
+    /** Number of vertices. */
+    size_t nVertices() const { return vertexValues_.size(); }
+
+    /** Number of edges. */
+    size_t nEdges() const { return edgeValues_.size(); }
+
+    /** True if the graph has no vertices. */
+    bool isEmpty() const { return vertexValues_.empty(); }
+
+    /** Value of a vertex of the original graph. */
+    const VertexValue& vertexValue(size_t vertexId) const {
+        ASSERT_require(vertexId < nVertices());
+        return *vertexValues_[vertexId];
+    }
+
+    /** Value of an edge of the original graph. */
+    const EdgeValue& edgeValue(size_t edgeId) const {
+        ASSERT_require(edgeId < nEdges());
+        return *edgeValues_[edgeId];
+    }
+
+    /** ID of the source vertex of an edge. */
+    size_t edgeSource(size_t edgeId) const {
+        ASSERT_require(edgeId < nEdges());
+        return sources_[edgeId];
+    }
+
+    /** ID of the target vertex of an edge. */
+    size_t edgeTarget(size_t edgeId) const {
+        ASSERT_require(edgeId < nEdges());
+        return targets_[edgeId];
+    }
+
+    /** IDs of the edges whose source is the specified vertex. */
+    EdgeIdRange outEdges(size_t vertexId) const {
+        ASSERT_require(vertexId < nVertices());
+        return edgeRange(outEdges_, outOffsets_[vertexId], outOffsets_[vertexId+1]);
+    }
+
+    /** IDs of the edges whose target is the specified vertex. */
+    EdgeIdRange inEdges(size_t vertexId) const {
+        ASSERT_require(vertexId < nVertices());
+        return edgeRange(inEdges_, inOffsets_[vertexId], inOffsets_[vertexId+1]);
+    }
+
+    /** Out-degree of a vertex. */
+    size_t nOutEdges(size_t vertexId) const {
+        ASSERT_require(vertexId < nVertices());
+        return outOffsets_[vertexId+1] - outOffsets_[vertexId];
+    }
+
+    /** In-degree of a vertex. */
+    size_t nInEdges(size_t vertexId) const {
+        ASSERT_require(vertexId < nVertices());
+        return inOffsets_[vertexId+1] - inOffsets_[vertexId];
+    }
+
+    /** Edges followed by a traversal in the specified direction.
+     *
+     *  These are the out-edges for @ref Algorithm::ForwardTraversalTag and the in-edges for @ref
+     *  Algorithm::ReverseTraversalTag. @{ */
+    EdgeIdRange nextEdges(size_t vertexId, Algorithm::ForwardTraversalTag) const { return outEdges(vertexId); }
+    EdgeIdRange nextEdges(size_t vertexId, Algorithm::ReverseTraversalTag) const { return inEdges(vertexId); }
+    /** @} */
+
+    /** Vertex at the far end of an edge in the specified direction. @{ */
+    size_t nextVertex(size_t edgeId, Algorithm::ForwardTraversalTag) const { return edgeTarget(edgeId); }
+    size_t nextVertex(size_t edgeId, Algorithm::ReverseTraversalTag) const { return edgeSource(edgeId); }
+    /** @} */
+
+private:
+    static EdgeIdRange edgeRange(const std::vector<size_t> &ids, size_t begin, size_t end) {
+        const size_t *base = ids.empty() ? NULL : &ids[0];
+        return EdgeIdRange(base + begin, base + end);
+    }
+};
+
+namespace Algorithm {
+
+/** Determines if the any edges of a frozen graph form a cycle.
+ *
+ *  Same as the @ref graphContainsCycle for @ref Graph, but without the traversal objects.  Time complexity is O(|V|+|E|). */
+template<class G>
+bool
+graphContainsCycle(const FrozenGraph<G> &g) {
+    enum { NOT_SEEN, ON_PATH, DONE };
+    std::vector<unsigned char> state(g.nVertices(), NOT_SEEN);
+    std::vector<std::pair<size_t, typename FrozenGraph<G>::EdgeIdIterator> > stack;
+    for (size_t rootId = 0; rootId < g.nVertices(); ++rootId) {
+        if (state[rootId] != NOT_SEEN)
+            continue;
+        state[rootId] = ON_PATH;
+        stack.push_back(std::make_pair(rootId, g.outEdges(rootId).begin()));
+        while (!stack.empty()) {
+            size_t vertexId = stack.back().first;
+            if (stack.back().second == g.outEdges(vertexId).end()) {
+                state[vertexId] = DONE;
+                stack.pop_back();
+                continue;
+            }
+            size_t targetId = g.edgeTarget(*stack.back().second++);
+            if (state[targetId] == ON_PATH)
+                return true;                            // a back edge forming a cycle
+            if (state[targetId] == NOT_SEEN) {
+                state[targetId] = ON_PATH;
+                stack.push_back(std::make_pair(targetId, g.outEdges(targetId).begin()));
+            }
+        }
+    }
+    return false;
+}
+
+/** Find all connected components of a frozen graph.
+ *
+ *  Same as the @ref graphFindConnectedComponents for @ref Graph: edges are followed in both directions and the components
+ *  are numbered in the order of their lowest vertex ID.  Returns the number of components.  Time complexity is O(|V|+|E|). */
+template<class G>
+size_t
+graphFindConnectedComponents(const FrozenGraph<G> &g, std::vector<size_t> &components /*out*/) {
+    static const size_t NOT_SEEN(-1);
+    size_t nComponents = 0;
+    components.clear();
+    components.resize(g.nVertices(), NOT_SEEN);
+    std::vector<size_t> worklist;
+    for (size_t rootId = 0; rootId < g.nVertices(); ++rootId) {
+        if (components[rootId] != NOT_SEEN)
+            continue;
+        components[rootId] = nComponents;
+        worklist.push_back(rootId);
+        while (!worklist.empty()) {
+            size_t id = worklist.back();
+            worklist.pop_back();
+            BOOST_FOREACH (size_t edgeId, g.outEdges(id)) {
+                size_t targetId = g.edgeTarget(edgeId);
+                if (components[targetId] == NOT_SEEN) {
+                    components[targetId] = nComponents;
+                    worklist.push_back(targetId);
+                }
+            }
+            BOOST_FOREACH (size_t edgeId, g.inEdges(id)) {
+                size_t sourceId = g.edgeSource(edgeId);
+                if (components[sourceId] == NOT_SEEN) {
+                    components[sourceId] = nComponents;
+                    worklist.push_back(sourceId);
+                }
+            }
+        }
+        ++nComponents;
+    }
+    return nComponents;
+}
+
+/** Test whether a frozen graph is connected.
+ *
+ *  Time complexity is O(|V|+|E|). */
+template<class G>
+bool
+graphIsConnected(const FrozenGraph<G> &g) {
+    std::vector<size_t> components;
+    return graphFindConnectedComponents(g, components) <= 1;
+}
+
+/** Vertices of a frozen graph in depth-first order.
+ *
+ *  Visits the vertices reachable from @p startId, following the edges forward or backward according to the @p direction tag
+ *  (@ref ForwardTraversalTag or @ref ReverseTraversalTag), in the same order as the depth-first vertex traversals of @ref
+ *  Graph.  The IDs of the vertices are appended to @p preorder when they are entered and to @p postorder when they are left;
+ *  the reverse of the postorder is the usual iteration order of forward data-flow. */
+template<class G, class Direction>
+void
+graphDepthFirstOrder(const FrozenGraph<G> &g, size_t startId, Direction direction,
+                     std::vector<size_t> &preorder /*out*/, std::vector<size_t> &postorder /*out*/) {
+    ASSERT_require(startId < g.nVertices());
+    std::vector<bool> seen(g.nVertices(), false);
+    std::vector<std::pair<size_t, typename FrozenGraph<G>::EdgeIdIterator> > stack;
+    seen[startId] = true;
+    preorder.push_back(startId);
+    stack.push_back(std::make_pair(startId, g.nextEdges(startId, direction).begin()));
+    while (!stack.empty()) {
+        size_t vertexId = stack.back().first;
+        if (stack.back().second == g.nextEdges(vertexId, direction).end()) {
+            postorder.push_back(vertexId);
+            stack.pop_back();
+            continue;
+        }
+        size_t neighborId = g.nextVertex(*stack.back().second++, direction);
+        if (!seen[neighborId]) {
+            seen[neighborId] = true;
+            preorder.push_back(neighborId);
+            stack.push_back(std::make_pair(neighborId, g.nextEdges(neighborId, direction).begin()));
+        }
+    }
+}
+
+/** Vertices of a frozen graph in breadth-first order.
+ *
+ *  Returns the IDs of the vertices reachable from @p startId in the order they are entered by a breadth-first traversal
+ *  following the edges forward or backward according to the @p direction tag. */
+template<class G, class Direction>
+std::vector<size_t>
+graphBreadthFirstOrder(const FrozenGraph<G> &g, size_t startId, Direction direction) {
+    ASSERT_require(startId < g.nVertices());
+    std::vector<bool> seen(g.nVertices(), false);
+    std::vector<size_t> order(1, startId);
+    seen[startId] = true;
+    for (size_t i = 0; i < order.size(); ++i) {
+        BOOST_FOREACH (size_t edgeId, g.nextEdges(order[i], direction)) {
+            size_t neighborId = g.nextVertex(edgeId, direction);
+            if (!seen[neighborId]) {
+                seen[neighborId] = true;
+                order.push_back(neighborId);
+            }
+        }
+    }
+    return order;
+}
+
+/** Vertices reachable from a vertex of a frozen graph.
+ *
+ *  Returns a vector indexed by vertex ID that is true for @p startId and for each vertex reachable from it following the
+ *  edges in the specified direction. */
+template<class G, class Direction>
+std::vector<bool>
+graphReachableVertices(const FrozenGraph<G> &g, size_t startId, Direction direction) {
+    std::vector<bool> reached(g.nVertices(), false);
+    BOOST_FOREACH (size_t id, graphBreadthFirstOrder(g, startId, direction))
+        reached[id] = true;
+    return reached;
+}
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -218,9 +218,9 @@ public:
      *  Initialize this container by copying all nodes from the @p other container.  This constructor has <em>O(n)</em>
      *  complexity, where <em>n</em> is the number of nodes in the container. */
     template<class Interval2, class T2, class Policy2>
-    IntervalMap(const IntervalMap<Interval2, T2, Policy2> &other) {
+    IntervalMap(const IntervalMap<Interval2, T2, Policy2> &other): size_(0) {
         typedef typename IntervalMap<Interval2, T2, Policy2>::ConstNodeIterator OtherIterator;
-        for (OtherIterator otherIter=other.nodes().begin(); other!=other.nodes().end(); ++other)
+        for (OtherIterator otherIter=other.nodes().begin(); otherIter!=other.nodes().end(); ++otherIter)
             insert(Interval(otherIter->key()), Value(otherIter->value()));
     }
 
@@ -232,7 +232,7 @@ public:
     IntervalMap& operator=(const IntervalMap<Interval2, T2, Policy2> &other) {
         clear();
         typedef typename IntervalMap<Interval2, T2, Policy2>::ConstNodeIterator OtherIterator;
-        for (OtherIterator otherIter=other.nodes().begin(); other!=other.nodes().end(); ++other)
+        for (OtherIterator otherIter=other.nodes().begin(); otherIter!=other.nodes().end(); ++otherIter)
             insert(Interval(otherIter->key()), Value(otherIter->value()));
         return *this;
     }
@@ -802,10 +802,32 @@ public:
     /** Insert a key/value pair.
      *
      *  If @p makeHole is true then the interval being inserted is first erased; otherwise the insertion happens only if none
-     *  of the interval being inserted already exists in the container.  */
+     *  of the interval being inserted already exists in the container.
+     *
+     *  Inserting an interval that lies above all the intervals already in the container takes amortized constant time, so
+     *  loading a container from sorted input (such as another container) takes linear time. */
     void insert(Interval key, Value value, bool makeHole=true) {
         if (key.isEmpty())
             return;
+
+        // Appending after all existing nodes: there is nothing to erase and no right neighbor, and only the last node can
+        // adjoin the new one.
+        if (isEmpty() || greatest() < key.least()) {
+            if (!isEmpty()) {
+                NodeIterator left = nodes().end(); --left;
+                if (left->key().greatest()+1==key.least() &&
+                    policy_.merge(left->key(), left->value(), key, value)) {
+                    key = Interval::hull(left->key().least(), key.greatest());
+                    std::swap(value, left->value());
+                    size_ -= left->key().size();
+                    map_.eraseAt(left);
+                }
+            }
+            map_.insertNear(nodes().end(), key, value);
+            size_ += key.size();
+            return;
+        }
+
         if (makeHole) {
             erase(key);
         } else {
@@ -524,6 +524,20 @@ public:
         return *this;
     }
 
+    /** Insert or update a key/value pair near a position.
+     *
+     *  Inserts the key/value pair into the container like @ref insert, but executes in amortized constant time if the key
+     *  belongs immediately before the @p hint position.  Otherwise this method executes in logarithmic time.  In particular,
+     *  inserting keys in ascending order with the end iterator as the hint appends each one in constant time.  The return value
+     *  points to the inserted or updated node.
+     *
+     *  @sa insert insertMultiple */
+    NodeIterator insertNear(const NodeIterator &hint, const Key &key, const Value &value) {
+        typename StlMap::iterator inserted = map_.insert(hint.base(), std::make_pair(key, value));
+        inserted->second = value;
+        return NodeIterator(inserted);
+    }
+
     /** Insert or update a key with a default value.
      *
      *  The value associated with @p key in the map is replaced with a default-constructed value.  If the key does not exist
@@ -554,8 +568,13 @@ public:
      * @{ */
     template<class OtherNodeIterator>
     Map& insertMultiple(const OtherNodeIterator &begin, const OtherNodeIterator &end) {
-        for (OtherNodeIterator otherIter=begin; otherIter!=end; ++otherIter)
-            insert(Key(otherIter->key()), Value(otherIter->value()));
+        // Using the position after the previous insertion as a hint makes each insertion of sorted input (such as the nodes of
+        // another map) take amortized constant time when the nodes end up adjacent in this container.
+        typename StlMap::iterator hint = map_.end();
+        for (OtherNodeIterator otherIter=begin; otherIter!=end; ++otherIter) {
+            hint = insertNear(NodeIterator(hint), Key(otherIter->key()), Value(otherIter->value())).base();
+            ++hint;
+        }
         return *this;
     }
     template<class OtherNodeIterator>
@@ -483,6 +483,7 @@ typedef SharedPointer<class FdSink> FdSinkPtr;
 typedef SharedPointer<class FileSink> FileSinkPtr;
 typedef SharedPointer<class StreamSink> StreamSinkPtr;
 typedef SharedPointer<class SyslogSink> SyslogSinkPtr;
+typedef SharedPointer<class AsyncSink> AsyncSinkPtr;
 /** @} */
 
 /** Baked properties for a destination.  Rather than recompute properties every time characters of a message are inserted into
@@ -1346,6 +1347,72 @@ private:
 };
 #endif
 
+/** Sends messages to another destination from a background thread.
+ *
+ *  Posting a message to this sink only copies the message into a bounded queue; rendering it (prefix, colors, etc.) and writing
+ *  it are done by a background thread that posts the queued messages, in order, to the wrapped destination.  This moves the
+ *  cost of formatting and I/O off the threads that produce diagnostics.  The sink is buffered, so only complete (or canceled)
+ *  messages are queued.  When the queue is full the message is discarded and counted instead of blocking the producer, so
+ *  output can be incomplete under heavy load (see @ref nDropped).  The prefix of a message is generated when the message is
+ *  written, so elapsed times shown in prefixes can be slightly later than when the message was completed.
+ *
+ *  The wrapped destination should be a final destination, such as an @ref FdSink.  It is posted the properties baked for this
+ *  sink merged with its own default and override properties.
+ *
+ *  When %Sawyer is configured without multi-thread support, messages are posted to the wrapped destination immediately.
+ *
+ *  Thread safety: This object is thread-safe. */
+class SAWYER_EXPORT AsyncSink: public Destination {
+    struct Entry {
+        Mesg mesg;
+        MesgProps props;
+        Entry(const Mesg &mesg, const MesgProps &props): mesg(mesg), props(props) {}
+    };
+
+#include <Sawyer/WarningsOff.h>
+    DestinationPtr sink_;                               // where messages are eventually posted
+    std::vector<Entry*> ring_;                          // queued messages, a circular buffer
+    size_t head_;                                       // index of oldest message in ring_
+    size_t nQueued_;                                    // number of messages in ring_
+    size_t nDropped_;                                   // number of messages discarded because ring_ was full
+    bool isPosting_;                                    // background thread is posting a message
+    bool stopping_;                                     // background thread should exit when ring_ is empty
+    mutable SAWYER_THREAD_TRAITS::Mutex queueMutex_;    // protects the queue, not held while posting
+#if SAWYER_MULTI_THREADED
+    SAWYER_THREAD_TRAITS::ConditionVariable queueChanged_; // signaled when a message is queued or posted
+    boost::thread worker_;                              // background thread that posts messages
+#endif
+#include <Sawyer/WarningsRestore.h>
+
+protected:
+    /** Constructor for derived classes. Non-subclass users should use @ref instance instead. */
+    AsyncSink(const DestinationPtr &sink, size_t capacity);
+public:
+    /** Allocating constructor.  Constructs a new message sink that posts messages to @p sink from a background thread. At
+     *  most @p capacity messages are queued; messages arriving while the queue is full are discarded. */
+    static AsyncSinkPtr instance(const DestinationPtr &sink, size_t capacity=4096) {
+        return AsyncSinkPtr(new AsyncSink(sink, capacity));
+    }
+
+    /** Destructor.  Posts the messages that are still queued before returning. */
+    ~AsyncSink();
+
+    /** Wait until all queued messages are posted.
+     *
+     *  Thread safety: This method is thread-safe. */
+    void flush();
+
+    /** Number of messages discarded because the queue was full.
+     *
+     *  Thread safety: This method is thread-safe. */
+    size_t nDropped() const;
+
+    virtual void post(const Mesg&, const MesgProps&) /*override*/;
+private:
+    void init();
+    void postQueued();                                  // main loop of the background thread
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Message streams
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
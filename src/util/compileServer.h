@@ -0,0 +1,30 @@
+#ifndef ROSE_COMPILE_SERVER_H
+#define ROSE_COMPILE_SERVER_H
+
+#include <string>
+#include <vector>
+
+namespace rose {
+    // Compile server (-rose:compile_server <socket>): a translator stays loaded and runs the compile requests it
+    // receives over a UNIX domain socket, each one in a forked child process that inherits everything the
+    // translator built before calling frontend() (diagnostics, loaded annotations, ...). A request holds the working
+    // directory and the command line of the client; the client receives the standard output and standard error of
+    // the child as they are written, followed by its exit status.
+
+    // Never returns in the server process. Returns in the child process running a request: the result is the command
+    // line of the server (commandLinePrefix, starting with argv0) followed by the arguments of the request, the working
+    // directory is the one of the client and the standard output and error are forwarded to the client. The exit
+    // status of the child is sent to the client, so the translator is expected to exit once the request has been
+    // processed (e.g. by returning from main()). At most maxConcurrentRequests requests run at the same time (the
+    // number of processors if zero).
+    std::vector<std::string> ServeCompileRequests(const std::string & socketName,
+                                                  const std::vector<std::string> & commandLinePrefix,
+                                                  unsigned maxConcurrentRequests = 0);
+
+    // Sends the command line arguments (without argv0) to the compile server listening on socketName, copies the
+    // output of the request to the standard output and error, and returns the exit status of the request (1 if the
+    // server cannot be reached).
+    int RunCompileRequest(const std::string & socketName, const std::vector<std::string> & arguments);
+}
+
+#endif
@@ -8,69 +8,247 @@
 #include <sys/file.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#include <pthread.h>
 
 
 
 #define ROSE_TRACE_DIR_ENV "ROSE_TRACE_DIR"
 #define ROSE_TRACE_FILE_PATH_ENV "ROSE_TRACE_FULL_FILE_PATH"
-static FILE * __roseTraceFilePtr;
+
+// Room for the suffix added to the trace file name of each thread, "-<thread number>.rosetrace" at most.
+#define ROSE_TRACE_SUFFIX_MAX 32
+
+// Trace file format: the 8 bytes ROSE_TRACE_MAGIC followed by the trace ids, each one encoded as the difference
+// with the previous id of the same thread (the first one with 0), zigzag mapped to an unsigned number and written
+// as a LEB128 varint (7 bits per byte, low bits first, high bit set on all bytes but the last).
+// The readers are in projects/RoseBlockLevelTracing/src/common.h.
+#define ROSE_TRACE_MAGIC "ROSETRC2"
+#define ROSE_TRACE_MAGIC_SIZE 8
+
+// Each thread has a ring of ROSE_TRACE_NUM_CHUNKS chunks. When a chunk is full it is handed to the writer thread
+// and the thread continues with the next chunk (it waits only when the writer is a whole ring behind).
+// A record never spans two chunks, it takes at most ROSE_TRACE_MAX_RECORD_SIZE bytes.
+#define ROSE_TRACE_CHUNK_SIZE (64 * 1024)
+#define ROSE_TRACE_NUM_CHUNKS 4
+#define ROSE_TRACE_MAX_RECORD_SIZE 10
+
+// The writer thread is only started when the program is linked with the pthread library, otherwise full chunks
+// are written by the traced thread itself.
+#pragma weak pthread_create
+#pragma weak pthread_join
+
+struct __ROSE_TraceChunk {
+    volatile int full;
+    size_t size;
+    unsigned char data[ROSE_TRACE_CHUNK_SIZE];
+};
+
+struct __ROSE_TraceBuffer {
+    int fd;
+    uint64_t lastId;
+    unsigned current;      // chunk being filled by the traced thread
+    unsigned drained;      // next chunk to be written by the writer thread
+    struct __ROSE_TraceBuffer * next;
+    struct __ROSE_TraceChunk chunks[ROSE_TRACE_NUM_CHUNKS];
+};
+
 static char __roseTraceFile[PATH_MAX];
+static int __roseTraceFullPath;
+static struct __ROSE_TraceBuffer * volatile __roseTraceBuffers;
+static volatile int __roseTraceNumThreads;
+static __thread struct __ROSE_TraceBuffer * __roseTraceBuffer;
 
-// __ROSE_TraceStartup() reads the ROSE_TRACE_FULL_FILE_PATH environment variable and use it if it is set. (DONT USE FOR MULTITHREADED CODES)
+static pthread_t __roseTraceWriterThread;
+static volatile int __roseTraceWriterRunning;
+static volatile int __roseTraceStop;
+
+// __ROSE_TraceStartup() reads the ROSE_TRACE_FULL_FILE_PATH environment variable and use it if it is set (the trace of
+// the first thread is written to that file, the ones of the next threads to that file name followed by .<thread number>).
 // Otherwise, it checks ROSE_TRACE_DIR environment variable and creates a rose trace file under it.
 // If ROSE_TRACE_DIR is also not set, it uses the current directory to log traces, in which case the trace files have hostname-pid-threadid.rosetrace file names.
 
+static void * __ROSE_TraceWriter(void * unused);
+
 static void  __attribute__((constructor)) __ROSE_TraceStartup(){
     // Get the environment variable ROSE_TRACE_DIR
-    
+
     char * roseTraceFilePath = getenv(ROSE_TRACE_FILE_PATH_ENV);
-    
+    int length;
+
     if(!roseTraceFilePath) {
-        
+
         char * roseTraceDir = getenv(ROSE_TRACE_DIR_ENV);
         if(!roseTraceDir){
             roseTraceDir = getcwd(roseTraceDir, PATH_MAX);
             fprintf(stderr, "\n ROSE_TRACE_DIR is not set, using current directory %s for logging traces", roseTraceDir);
         }
-        
-        char hostName[PATH_MAX];
-        if(gethostname(hostName,PATH_MAX)) {
+
+        char hostName[256];                                 // POSIX limits host names to 255 bytes
+        if(gethostname(hostName,sizeof hostName)) {
             fprintf(stderr, "\n Failed to  get gethostname() for trace file... exiting");
             exit(-1);
         }
-        
+
         pid_t pid = getpid();
-        snprintf(__roseTraceFile, PATH_MAX, "%s/%s-%lu-0.rosetrace", roseTraceDir, hostName, pid);
+        length = snprintf(__roseTraceFile, PATH_MAX, "%s/%s-%lu", roseTraceDir, hostName, (unsigned long) pid);
+        __roseTraceFullPath = 0;
     } else {
-        snprintf(__roseTraceFile, PATH_MAX, "%s", roseTraceFilePath);
+        length = snprintf(__roseTraceFile, PATH_MAX, "%s", roseTraceFilePath);
+        __roseTraceFullPath = 1;
     }
-    
-    if((__roseTraceFilePtr=fopen(__roseTraceFile, "wb")) == NULL){
-        fprintf(stderr, "\n Failed to open the trace file %s ... exiting", __roseTraceFile);
+    if(length < 0 || length >= PATH_MAX) {
+        fprintf(stderr, "\n Trace file name is too long ... exiting");
         exit(-1);
     }
+
+    if(pthread_create && pthread_create(&__roseTraceWriterThread, NULL, __ROSE_TraceWriter, NULL) == 0)
+        __roseTraceWriterRunning = 1;
     fprintf(stdout, "\n  Trace file name = %s", __roseTraceFile);
 }
 
-// __ROSE_TraceEnd() closes the trace file.
+// Writes a chunk to the trace file of its thread (nothing once the trace is closed).
+static void __ROSE_TraceWriteChunk(struct __ROSE_TraceBuffer * buffer, struct __ROSE_TraceChunk * chunk){
+    size_t written = 0;
+    while(buffer->fd >= 0 && written < chunk->size) {
+        ssize_t n = write(buffer->fd, chunk->data + written, chunk->size - written);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0) {
+            fprintf(stderr, "\n Failed to write to trace ... exiting");
+            exit(-1);
+        }
+        written += n;
+    }
+    chunk->size = 0;
+}
+
+// Writes the full chunks of all threads, in order. Returns 0 if there was nothing to write.
+static int __ROSE_TraceDrain(){
+    int wrote = 0;
+    struct __ROSE_TraceBuffer * buffer;
+    for(buffer = __roseTraceBuffers; buffer; buffer = buffer->next) {
+        struct __ROSE_TraceChunk * chunk;
+        while((chunk = &buffer->chunks[buffer->drained])->full) {
+            __sync_synchronize();
+            __ROSE_TraceWriteChunk(buffer, chunk);
+            __sync_synchronize();
+            chunk->full = 0;
+            buffer->drained = (buffer->drained + 1) % ROSE_TRACE_NUM_CHUNKS;
+            wrote = 1;
+        }
+    }
+    return wrote;
+}
+
+static void * __ROSE_TraceWriter(void * unused){
+    while(!__roseTraceStop) {
+        if(!__ROSE_TraceDrain()) {
+            struct timespec delay = {0, 1000000};
+            nanosleep(&delay, NULL);
+        }
+    }
+    return unused;
+}
+
+// Creates the buffer and the trace file of the calling thread.
+static struct __ROSE_TraceBuffer * __ROSE_TraceRegisterThread(){
+    struct __ROSE_TraceBuffer * buffer = (struct __ROSE_TraceBuffer *) calloc(1, sizeof(struct __ROSE_TraceBuffer));
+    if(!buffer) {
+        fprintf(stderr, "\n Failed to allocate the trace buffer ... exiting");
+        exit(-1);
+    }
+
+    int threadNo = __sync_fetch_and_add(&__roseTraceNumThreads, 1);
+    char fileName[PATH_MAX + ROSE_TRACE_SUFFIX_MAX];
+    int length;
+    if(__roseTraceFullPath)
+        length = snprintf(fileName, sizeof fileName, threadNo ? "%s.%d" : "%s", __roseTraceFile, threadNo);
+    else
+        length = snprintf(fileName, sizeof fileName, "%s-%d.rosetrace", __roseTraceFile, threadNo);
+    if(length < 0 || (size_t) length >= sizeof fileName) {
+        fprintf(stderr, "\n Trace file name for thread %d is too long ... exiting", threadNo);
+        exit(-1);
+    }
+
+    if((buffer->fd = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0){
+        fprintf(stderr, "\n Failed to open the trace file %s ... exiting", fileName);
+        exit(-1);
+    }
+    memcpy(buffer->chunks[0].data, ROSE_TRACE_MAGIC, ROSE_TRACE_MAGIC_SIZE);
+    buffer->chunks[0].size = ROSE_TRACE_MAGIC_SIZE;
+
+    // push on the list of buffers seen by the writer thread (and by __ROSE_TraceEnd)
+    do {
+        buffer->next = __roseTraceBuffers;
+    } while(!__sync_bool_compare_and_swap(&__roseTraceBuffers, buffer->next, buffer));
+
+    __roseTraceBuffer = buffer;
+    return buffer;
+}
+
+// Moves to the next chunk of the ring, the current one is full.
+static struct __ROSE_TraceChunk * __ROSE_TraceNextChunk(struct __ROSE_TraceBuffer * buffer){
+    struct __ROSE_TraceChunk * chunk = &buffer->chunks[buffer->current];
+    if(!__roseTraceWriterRunning) {
+        __ROSE_TraceWriteChunk(buffer, chunk);
+        return chunk;
+    }
+
+    __sync_synchronize();
+    chunk->full = 1;
+    buffer->current = (buffer->current + 1) % ROSE_TRACE_NUM_CHUNKS;
+    chunk = &buffer->chunks[buffer->current];
+    while(chunk->full)
+        sched_yield();
+    __sync_synchronize();
+    return chunk;
+}
+
+// __ROSE_TraceEnd() writes what is left in the buffers and closes the trace files.
 static void  __attribute__((destructor)) __ROSE_TraceEnd(){
-    if (__roseTraceFilePtr) {
-        if(fclose(__roseTraceFilePtr)) {
+    if(__roseTraceWriterRunning) {
+        __roseTraceStop = 1;
+        pthread_join(__roseTraceWriterThread, NULL);
+        __roseTraceWriterRunning = 0;
+    }
+    __ROSE_TraceDrain();
+
+    struct __ROSE_TraceBuffer * buffer;
+    for(buffer = __roseTraceBuffers; buffer; buffer = buffer->next) {
+        __ROSE_TraceWriteChunk(buffer, &buffer->chunks[buffer->current]);
+        if(close(buffer->fd)) {
             fprintf(stderr, "\n Trace file %s was not closed!", __roseTraceFile);
-        } else {
-            fprintf(stdout, "\n All traces written to file %s ", __roseTraceFile);
         }
+        buffer->fd = -1;
     }
+    fprintf(stdout, "\n All traces written to file %s ", __roseTraceFile);
 }
 
 // Each instrumented SgNode calls this function.
-// ROSE_Tracing_Instrumentor appedds the trace id to the trace file.
-// TODO: THIS IS NOT THREAD SAFE. WE SHOULD MAKE IT THREAD SAFE.
+// ROSE_Tracing_Instrumentor appends the trace id to the trace buffer of the calling thread.
 int ROSE_Tracing_Instrumentor(uint64_t id){
-    if(fwrite(&id, sizeof(uint64_t), 1, __roseTraceFilePtr) != 1){
-        fprintf(stderr, "\n Failed to write to trace ... exiting", __roseTraceFile);
-        fclose(__roseTraceFilePtr);
-        __roseTraceFilePtr = NULL;
-        exit(-1);
+    struct __ROSE_TraceBuffer * buffer = __roseTraceBuffer;
+    if(!buffer)
+        buffer = __ROSE_TraceRegisterThread();
+
+    struct __ROSE_TraceChunk * chunk = &buffer->chunks[buffer->current];
+    if(chunk->size + ROSE_TRACE_MAX_RECORD_SIZE > ROSE_TRACE_CHUNK_SIZE)
+        chunk = __ROSE_TraceNextChunk(buffer);
+
+    uint64_t delta = id - buffer->lastId;
+    uint64_t value = (delta << 1) ^ (uint64_t) ((int64_t) delta >> 63);
+    buffer->lastId = id;
+
+    unsigned char * out = chunk->data + chunk->size;
+    while(value >= 0x80) {
+        *out++ = (unsigned char) (value | 0x80);
+        value >>= 7;
     }
-}
\ No newline at end of file
+    *out++ = (unsigned char) value;
+    chunk->size = out - chunk->data;
+    return 0;
+}
@@ -8,20 +8,23 @@
 #include <assert.h>
 #include <map>
 #include <sstream>
+#include <stdint.h>
 #include "rosedll.h"
 
+// The set is stored as an array of 64-bit words, bit i of the set being bit i%64 of word i/64. The operations on whole
+// sets are plain loops over the word arrays, which the compiler turns into vector instructions where the target has them.
 class BitVectorReprImpl {
-  unsigned* impl;
+  uint64_t* impl;
   unsigned  num;
   
+  static const unsigned wordsize = 64;
   void operator = ( const BitVectorReprImpl& that)
   {}
  public:
   BitVectorReprImpl( unsigned size)
     { 
-      unsigned intsize = sizeof(unsigned);
-      num = (size + intsize-1) / intsize ;
-      impl = new unsigned[num];
+      num = (size + wordsize-1) / wordsize ;
+      impl = new uint64_t[num];
       for (unsigned i = 0; i < num; ++i) { 
         impl[i] = 0;
       }
@@ -29,7 +32,7 @@ class BitVectorReprImpl {
   BitVectorReprImpl( const BitVectorReprImpl& that)
     : num(that.num)
     {
-      impl = new unsigned[that.num];
+      impl = new uint64_t[that.num];
       for (unsigned i = 0; i < num; ++i) {
         impl[i] = that.impl[i];
       }
@@ -83,27 +86,33 @@ class BitVectorReprImpl {
   
   bool has_member( unsigned index)  const
     {
-      unsigned intsize = sizeof(unsigned);
-      int i1 = index / intsize;
-      int i2 = index % intsize;
-      unsigned mask = 1 << i2;
-      return impl[i1] & mask;
+      return (impl[index / wordsize] >> (index % wordsize)) & 1;
     }
   void add_member( unsigned index)  
     {
-      unsigned intsize = sizeof(unsigned);
-      int i1 = index / intsize;
-      int i2 = index % intsize;
-      unsigned mask = 1 << i2;
-      impl[i1] |= mask;
+      impl[index / wordsize] |= (uint64_t)1 << (index % wordsize);
     }
   void delete_member( unsigned index)
     {
-      unsigned intsize = sizeof(unsigned);
-      int i1 = index / intsize;
-      int i2 = index % intsize;
-      unsigned mask = ~(1 << i2);
-      impl[i1] &= mask;
+      impl[index / wordsize] &= ~((uint64_t)1 << (index % wordsize));
+    }
+  // The smallest member that is at least index, or a number beyond the capacity of the set if there is none.
+  // Skips whole words of non-members at a time.
+  unsigned next_member( unsigned index) const
+    {
+      unsigned i = index / wordsize;
+      if (i >= num)
+        return num * wordsize;
+      uint64_t word = impl[i] & (~(uint64_t)0 << (index % wordsize));
+      while (word == 0) {
+        if (++i == num)
+          return num * wordsize;
+        word = impl[i];
+      }
+      unsigned bit = 0;
+      while (!((word >> bit) & 1))
+        ++bit;
+      return i * wordsize + bit;
     }
 };
 
@@ -132,6 +141,8 @@ class ROSE_UTIL_API BitVectorRepr : public CountRefHandle<BitVectorReprImpl>
   { return !operator==(that); }
   bool has_member( unsigned index)  const
     { return ConstPtr() != 0 && ConstRef().has_member(index); }
+  unsigned next_member( unsigned index) const
+    { return ConstPtr() == 0 ? (unsigned)-1 : ConstRef().next_member(index); }
   void add_member( unsigned index)  
     { UpdateRef().add_member(index); }
   void delete_member( unsigned index)  
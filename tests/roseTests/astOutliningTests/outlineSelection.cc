@@ -37,6 +37,11 @@
  *    outlined, rather than just the combined outlining result at the
  *    end), specify "-rose:outline:emit-stages".
  *
+ *    - To outline all the selected statements with one call to the
+ *    batch Outliner::outline() instead of one call per statement,
+ *    specify "-rose:outline:batch". Selected statements enclosed by
+ *    other selected statements are not outlined in this mode.
+ *
  *  \note This utility duplicates functionality (and code!) in
  *  liaoutline.cc and injectOutlinePragmas.cc. This program enables
  *  testing of the outliner independent of whether '#pragmas' are
@@ -75,6 +80,7 @@ struct ProgramOptions_t
     : preproc_only_ (false),
       make_pdfs_ (false),
       emit_stages_ (false),
+      batch_ (false),
       max_rand_ (0)
   {
   }
@@ -82,6 +88,7 @@ struct ProgramOptions_t
   bool preproc_only_; //!< True if only preprocessing should be performed.
   bool make_pdfs_; //!< True if PDFs should be emitted.
   bool emit_stages_; //!< Emit outlining results in stages.
+  bool batch_; //!< Outline all the statements with one call.
 
   // Options relevant to random statement collection.
   size_t max_rand_; //!< Maximum number of statements to select randomly.
@@ -405,6 +412,7 @@ usage (const string& prog_name)
        << " [-rose:outline:line <n>]"
        << " [-rose:outline:preproc-only]"
        << " [-rose:outline:emit-stages]"
+       << " [-rose:outline:batch]"
        << " ..." << endl
        << endl;
 }
@@ -448,6 +456,15 @@ getOptions (vector<string>& argvList, ProgramOptions_t& opts)
       opts.emit_stages_ = true;
     }
 
+  if (CommandlineProcessing::isOption (argvList,
+                                       "-rose:outline:", "batch",
+                                       true))
+    {
+      if (SgProject::get_verbose() > 0)
+           cerr << "==> Outlining all the selected statements at once." << endl;
+      opts.batch_ = true;
+    }
+
   int max_rand = 0;
   while (CommandlineProcessing::isOptionWithParameter (argvList,
 						       "-rose:outline:",
@@ -721,6 +738,32 @@ preprocessSelection (SgProject* proj, const ProgramOptions_t& opts)
   return targets.size ();
 }
 
+//! Outlines the statements with one call, skipping those enclosed by others.
+static
+size_t
+outlineBatch (const StmtList_t& targets)
+{
+  StmtSet_t selected (targets.begin (), targets.end ());
+  vector<SgStatement *> stmts;
+  for (StmtList_t::const_iterator i = targets.begin (); i != targets.end (); ++i)
+  {
+    bool enclosed = false;
+    for (SgNode* p = (*i)->get_parent (); p != NULL && !enclosed; p = p->get_parent ())
+      enclosed = selected.find (isSgStatement (p)) != selected.end ();
+    if (!enclosed)
+      stmts.push_back (*i);
+  }
+
+  if (SgProject::get_verbose() > 0)
+       cerr << "=== OUTLINING " << stmts.size () << " statements at once ===" << endl;
+
+  vector<Outliner::Result> results = Outliner::outline (stmts);
+  ROSE_ASSERT (results.size () == stmts.size ());
+  for (size_t i = 0; i < results.size (); ++i)
+    ROSE_ASSERT (results[i].isValid ());
+  return stmts.size ();
+}
+
 static
 size_t
 outlineSelection (SgProject* proj, const ProgramOptions_t& opts)
@@ -731,6 +774,9 @@ outlineSelection (SgProject* proj, const ProgramOptions_t& opts)
   if (SgProject::get_verbose() > 0)
        dump (targets.begin (), targets.end ());
 
+  if (opts.batch_)
+    return outlineBatch (targets);
+
   for_each (targets.begin (), targets.end (),
             bind2nd (ptr_fun (outline), opts.emit_stages_));
 
@@ -0,0 +1,98 @@
+#ifndef ROSE_BENCHMARK_REPORT_H
+#define ROSE_BENCHMARK_REPORT_H
+
+// Results of the corpus benchmarks (roseSourceBenchmark and roseBinaryBenchmark), written as a JSON document.
+//
+// The output is meant to be compared between ROSE versions, so its layout is fixed: the results are written in the
+// order they were added, every result has the same members in the same order, and numbers are always written with
+// the same precision.  A result is the time taken for some amount of work; both rates (work per second and seconds
+// per unit of work) are included so that a script does not need to compute them.  When the number of memory allocations
+// was counted for the work it is reported per unit of work as well (null otherwise).
+
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iomanip>
+
+class BenchmarkReport
+   {
+     public:
+          BenchmarkReport ( const std::string & s, const std::string & v ) : suite(s), version(v) {}
+
+       // Record that some amount of work (count in the given unit, e.g. "KLOC" or "instructions") on the named input
+       // took the given time (and the given number of memory allocations, if they were counted).
+          void add ( const std::string & name, const std::string & input, double seconds, double count, const std::string & unit,
+                     double allocations = -1.0 )
+             {
+               Result result = { name, input, seconds, count, unit, allocations };
+               results.push_back(result);
+             }
+
+          void addInput ( const std::string & input ) { inputs.push_back(input); }
+
+          void write ( std::ostream & output ) const
+             {
+               output << "{\n";
+               output << "  \"suite\": " << quote(suite) << ",\n";
+               output << "  \"rose_version\": " << quote(version) << ",\n";
+               output << "  \"inputs\": [";
+               for (size_t i = 0; i < inputs.size(); i++)
+                    output << (i > 0 ? ", " : "") << quote(inputs[i]);
+               output << "],\n";
+               output << "  \"results\": [\n";
+               for (size_t i = 0; i < results.size(); i++)
+                  {
+                    const Result & r = results[i];
+                    output << "    { \"name\": " << quote(r.name)
+                           << ", \"input\": " << quote(r.input)
+                           << ", \"seconds\": " << number(r.seconds)
+                           << ", \"count\": " << number(r.count)
+                           << ", \"unit\": " << quote(r.unit)
+                           << ", \"per_second\": " << number(r.seconds > 0 ? r.count / r.seconds : 0.0)
+                           << ", \"seconds_per_unit\": " << number(r.count > 0 ? r.seconds / r.count : 0.0)
+                           << ", \"allocations_per_unit\": "
+                           << (r.allocations < 0 ? std::string("null") : number(r.count > 0 ? r.allocations / r.count : 0.0))
+                           << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+                  }
+               output << "  ]\n";
+               output << "}\n";
+             }
+
+     private:
+          struct Result
+             {
+               std::string name;
+               std::string input;
+               double seconds;
+               double count;
+               std::string unit;
+               double allocations;
+             };
+
+          static std::string quote ( const std::string & s )
+             {
+               std::string result = "\"";
+               for (size_t i = 0; i < s.size(); i++)
+                  {
+                    if (s[i] == '"' || s[i] == '\\')
+                         result += '\\';
+                    result += s[i];
+                  }
+               return result + "\"";
+             }
+
+          static std::string number ( double value )
+             {
+               std::ostringstream s;
+               s << std::setprecision(6) << std::fixed << value;
+               return s.str();
+             }
+
+          std::string suite;
+          std::string version;
+          std::vector<std::string> inputs;
+          std::vector<Result> results;
+   };
+
+#endif